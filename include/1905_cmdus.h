@@ -134,6 +134,43 @@ struct CMDU
                                       // in this list.
 };
 
+// A "CMDU view" is a read-only index over the (reassembled) streams of a
+// received CMDU. It only contains the header fields and, for each TLV, its
+// type, its length and where its value is in the streams. Nothing is decoded
+// (or allocated) until a TLV is explicitly parsed with
+// "parse_1905_CMDU_view_TLV()".
+//
+// This is useful for consumers that only need the header or one or two TLVs
+// (e.g. duplicate detection), so that they don't need to materialize the whole
+// CMDU.
+//
+// The view points into the streams it was built from, so they must be kept
+// around as long as the view is used.
+//
+#define CMDU_VIEW_INLINE_TLVS 16
+
+struct CMDU_view_tlv
+{
+    uint8_t        type;                 // One of "TLV_TYPE_*" values
+    uint16_t       length;               // Length of 'value'
+    const uint8_t *value;                // Points into the packet stream
+};
+
+struct CMDU_view
+{
+    uint8_t   message_version;
+    uint16_t  message_type;
+    uint16_t  message_id;
+    uint8_t   relay_indicator;
+
+    unsigned               tlvs_nr;      // Excluding the "end of message" TLVs
+    unsigned               tlvs_max;
+    struct CMDU_view_tlv  *tlvs;         // Either 'inline_tlvs' (so a view can't
+                                         // be copied) or dynamically allocated
+                                         // for CMDUs with many TLVs.
+    struct CMDU_view_tlv   inline_tlvs[CMDU_VIEW_INLINE_TLVS];
+};
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -249,6 +286,64 @@ struct CMDU
 //
 struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams);
 
+// Builds a "CMDU view" (see "struct CMDU_view") over 'packet_streams', which
+// have the same format as in "parse_1905_CMDU_from_packets()".
+//
+// The same checks on the fragment headers are done, but the TLV contents are
+// not checked: "parse_1905_CMDU_from_view()" (which is what
+// "parse_1905_CMDU_from_packets()" does internally) might still fail.
+//
+// 'streams_lens' (same format as the one returned by
+// "forge_1905_CMDU_from_structure()") holds the length of each stream. When
+// given, a TLV whose length goes past the end of its stream is rejected. It can
+// be NULL if the lengths are not known, in which case the streams are trusted
+// to be well formed.
+//
+// Returns 'false' if the fragments are not consistent. Otherwise, 'view' must
+// later be freed with "free_1905_CMDU_view()".
+//
+bool parse_1905_CMDU_view_from_packets(uint8_t **packet_streams, const uint16_t *streams_lens, struct CMDU_view *view);
+
+// Returns the first TLV of type 'type' in 'view' or NULL if there is none.
+//
+const struct CMDU_view_tlv *get_1905_CMDU_view_TLV(const struct CMDU_view *view, uint8_t type);
+
+// Decodes one TLV of a view. The returned structure must be freed with
+// "free_1905_TLV_structure()".
+//
+struct tlv *parse_1905_CMDU_view_TLV(const struct CMDU_view_tlv *view_tlv);
+
+// Fully decodes a view into a CMDU structure, exactly like
+// "parse_1905_CMDU_from_packets()" does.
+//
+struct CMDU *parse_1905_CMDU_from_view(const struct CMDU_view *view);
+
+// Same as "parse_1905_CMDU_from_view()" but allocates from a new arena, like
+// "parse_1905_CMDU_from_packets_in_arena()".
+//
+struct CMDU *parse_1905_CMDU_from_view_in_arena(const struct CMDU_view *view);
+
+// Frees the memory used by the TLV index of 'view' (not the view itself nor
+// the streams it points into).
+//
+void free_1905_CMDU_view(struct CMDU_view *view);
+
+// Same as "parse_1905_CMDU_from_packets()", but the returned CMDU, its list of
+// TLVs and everything the TLVs point to are allocated from a new arena (see
+// arena.h) instead of one malloc() per object.
+//
+// The returned structure is still freed with "free_1905_CMDU_structure()" and
+// single TLVs can still be taken out of it and freed (much later) with
+// "free_1905_TLV_structure()": each of them holds a reference to the arena,
+// which is released at once when the CMDU and all its TLVs have been freed.
+// Since a single kept TLV keeps the whole arena alive, CMDUs whose TLVs are
+// stored for a long time should be parsed with "parse_1905_CMDU_from_packets()"
+// instead.
+//
+// The returned structure must only be used from the calling thread.
+//
+struct CMDU *parse_1905_CMDU_from_packets_in_arena(uint8_t **packet_streams);
+
 
 // This is the opposite of "parse_1905_CMDU_from_packets()": it receives a
 // pointer to a TLV structure and then returns a list of pointers to fragmented
@@ -295,6 +390,14 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams);
 //
 uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, uint16_t **lens);
 
+// Same as "forge_1905_CMDU_from_structure()", but the streams, the array that
+// contains them and the 'lens' array are allocated from 'arena'. They are
+// released together with it (with "arena_unref()") and must not be freed
+// individually.
+//
+uint8_t **forge_1905_CMDU_from_structure_in_arena(const struct CMDU *memory_structure, uint16_t **lens,
+                                                  struct arena *arena);
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
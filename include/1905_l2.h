@@ -73,5 +73,12 @@
 //
 #define MCAST_LLDP  "\x01\x80\xC2\x00\x00\x0E"
 
+
+// The same addresses, to be passed to functions expecting a "uint8_t *" (the
+// strings above are only meant to initialize "uint8_t" arrays)
+//
+#define MCAST_1905_ADDR ((const uint8_t *)MCAST_1905)
+#define MCAST_LLDP_ADDR ((const uint8_t *)MCAST_LLDP)
+
 #endif
 
@@ -257,6 +257,8 @@ struct macAddressTypeTLV
 ////////////////////////////////////////////////////////////////////////////////
 struct _localInterfaceEntries
 {
+    struct tlv_struct s;
+
     uint8_t   mac_address[6];       // MAC address of the local interface
 
     uint16_t  media_type;           // One of the MEDIA_TYPE_* values
@@ -286,48 +288,58 @@ struct deviceInformationTypeTLV
 
     uint8_t   al_mac_address[6];    // 1905 AL MAC address of the device
 
-    uint8_t   local_interfaces_nr;  // Number of local interfaces
-
-    struct _localInterfaceEntries  *local_interfaces;
-
+                                  // The local interfaces are the children
+                                  // ("struct _localInterfaceEntries") of
+                                  // 'tlv.s.h'
 };
 
+// Add a local interface of type 'media_type' to 'a'. The
+// 'media_specific_data_size' of the new entry is set according to
+// 'media_type', but its 'media_specific_data' must be filled by the caller.
+//
+struct _localInterfaceEntries *deviceInformationTypeTLVAddInterface(struct deviceInformationTypeTLV *a,
+                                                                    mac_address mac_address, uint16_t media_type);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Device bridging capability TLV associated structures ("Section 6.4.6")
 ////////////////////////////////////////////////////////////////////////////////
 struct _bridgingTupleMacEntries
 {
+    struct tlv_struct s;
+
     uint8_t   mac_address[6];       // MAC address of a 1905 device's network
                                   // interface that belongs to a bridging tuple
 };
 struct _bridgingTupleEntries
 {
-    uint8_t   bridging_tuple_macs_nr; // Number of MAC addresses in this bridging
-                                    // tuple
-
-    struct  _bridgingTupleMacEntries  *bridging_tuple_macs;
-                                   // List of 'mac_nr' elements, each one
-                                   // representing a MAC. All these MACs are
-                                   // bridged together.
+    struct tlv_struct s;
+                                  // The MACs of this bridging tuple are the
+                                  // children ("struct
+                                  // _bridgingTupleMacEntries") of 's.h'. All
+                                  // these MACs are bridged together.
 };
 struct deviceBridgingCapabilityTLV
 {
     struct tlv   tlv; /**< @brief TLV type, must always be set to TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES. */
 
-    uint8_t   bridging_tuples_nr;   // Number of MAC addresses in this bridging
-                                  // tuple
-
-    struct _bridgingTupleEntries  *bridging_tuples;
-
+                                  // The bridging tuples are the children
+                                  // ("struct _bridgingTupleEntries") of
+                                  // 'tlv.s.h'
 };
 
+struct _bridgingTupleEntries *deviceBridgingCapabilityTLVAddTuple(struct deviceBridgingCapabilityTLV *a);
+struct _bridgingTupleMacEntries *deviceBridgingCapabilityTupleAddMac(struct _bridgingTupleEntries *a,
+                                                                     mac_address mac_address);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Non-1905 neighbor device list TLV associated structures ("Section 6.4.8")
 ////////////////////////////////////////////////////////////////////////////////
 struct _non1905neighborEntries
 {
+    struct tlv_struct s;
+
     uint8_t   mac_address[6];       // MAC address of the non-1905 device
 };
 struct non1905NeighborDeviceListTLV
@@ -336,18 +348,22 @@ struct non1905NeighborDeviceListTLV
 
     uint8_t   local_mac_address[6]; // MAC address of the local interface
 
-    uint8_t                           non_1905_neighbors_nr;
-    struct _non1905neighborEntries *non_1905_neighbors;
-                                  // One entry for each non-1905 detected
-                                  // neighbor
+                                  // One child ("struct
+                                  // _non1905neighborEntries") of 'tlv.s.h'
+                                  // for each non-1905 detected neighbor
 };
 
+struct _non1905neighborEntries *non1905NeighborDeviceListTLVAddNeighbor(struct non1905NeighborDeviceListTLV *a,
+                                                                        mac_address mac_address);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Neighbor device TLV associated structures ("Section 6.4.9")
 ////////////////////////////////////////////////////////////////////////////////
 struct _neighborEntries
 {
+    struct tlv_struct s;
+
     uint8_t   mac_address[6];       // AL MAC address of the 1905 neighbor
 
     uint8_t   bridge_flag;          // "0" --> no IEEE 802.1 bridge exists
@@ -361,11 +377,13 @@ struct neighborDeviceListTLV
 
     uint8_t   local_mac_address[6]; // MAC address of the local interface
 
-    uint8_t                     neighbors_nr;
-    struct _neighborEntries  *neighbors;
-                                  // One entry for each 1905 detected neighbor
+                                  // One child ("struct _neighborEntries") of
+                                  // 'tlv.s.h' for each 1905 detected neighbor
 };
 
+struct _neighborEntries *neighborDeviceListTLVAddNeighbor(struct neighborDeviceListTLV *a,
+                                                          mac_address mac_address, uint8_t bridge_flag);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Link metric query TLV associated structures ("Section 6.4.10")
@@ -842,6 +860,8 @@ struct x1905ProfileVersionTLV
 ////////////////////////////////////////////////////////////////////////////////
 struct _powerOffInterfaceEntries
 {
+    struct tlv_struct s;
+
     uint8_t   interface_address[6];     // MAC address of an interface in the
                                       // "power off" state
 
@@ -854,17 +874,25 @@ struct _powerOffInterfaceEntries
                                       // variant index and media specific
                                       // information of the interface
                                       // Otherwise, it is set to all zeros
+                                      // The 'media_specific_bytes' are
+                                      // stored right after this structure,
+                                      // in the same allocation
 };
 struct powerOffInterfaceTLV
 {
     struct tlv   tlv; /**< @brief TLV type, must always be set to TLV_TYPE_POWER_OFF_INTERFACE. */
 
-    uint8_t                              power_off_interfaces_nr;
-    struct _powerOffInterfaceEntries  *power_off_interfaces;
-                                   // List of local interfaces in the "power
-                                   // off" state.
+                                   // The local interfaces in the "power off"
+                                   // state are the children ("struct
+                                   // _powerOffInterfaceEntries") of 'tlv.s.h'
 };
 
+struct _powerOffInterfaceEntries *powerOffInterfaceTLVAddInterface(struct powerOffInterfaceTLV *a,
+                                                                   mac_address interface_address, uint16_t media_type,
+                                                                   const uint8_t *oui, uint8_t variant_index,
+                                                                   uint8_t media_specific_bytes_nr,
+                                                                   const uint8_t *media_specific_bytes);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Interface power change information TLV associated structures ("Section
@@ -1111,6 +1139,24 @@ struct tlv *parse_1905_TLV_from_packet(const uint8_t *packet_stream);
 //
 uint8_t *forge_1905_TLV_from_structure(const struct tlv *memory_structure, uint16_t *len);
 
+// Returns the number of bytes "forge_1905_TLV_from_structure()" would produce
+// for "memory_structure", without actually forging it (nothing is allocated or
+// serialized).
+//
+// Returns '0' if the TLV can not be forged.
+//
+size_t forge_1905_TLV_length(const struct tlv *memory_structure);
+
+// Same as "forge_1905_TLV_from_structure()", but the TLV is written into the
+// caller provided "buffer" (of "buffer_size" bytes) instead of into a newly
+// allocated one. Use "forge_1905_TLV_length()" to find out how much space is
+// needed.
+//
+// Returns the number of bytes written, or '0' if there was a problem (which
+// includes "buffer" being too small).
+//
+size_t forge_1905_TLV_into_buffer(const struct tlv *memory_structure, uint8_t *buffer, size_t buffer_size);
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1126,6 +1172,12 @@ struct tlv *x1905TLVAlloc(dlist_head *parent, uint8_t type);
 #define X1905_TLV_ALLOC(tlv_name, tlv_type, parent) \
     container_of(x1905TLVAlloc(parent, tlv_type), struct tlv_name ## TLV, tlv);
 
+/** @brief Get the definition of the given TLV type.
+ *
+ * tlv_def::desc.name is NULL for TLV types that are not handled through the generic TLV functions of tlv.h.
+ */
+const struct tlv_def *x1905TLVFindDef(uint8_t type);
+
 // This function receives a pointer to a TLV structure and then traverses it
 // and all nested structures, calling "free()" on each one of them
 //
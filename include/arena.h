@@ -0,0 +1,157 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+#ifndef ARENA_H
+#define ARENA_H
+
+/** @file
+ *  @brief Arena (bump) allocator.
+ *
+ * An arena owns a set of large memory chunks from which small objects are carved out by bumping a pointer. Objects are
+ * never freed individually: the whole arena is released at once when its last reference is dropped.
+ *
+ * Arenas are used to hold the complete object graph of a single CMDU (the ::CMDU structure, its list of TLVs and every
+ * nested array), so that parsing a CMDU costs a handful of chunk allocations instead of one malloc() per object.
+ *
+ * The arena is not passed explicitly to the allocation functions. Instead, while an arena is "entered" with
+ * arena_enter(), memalloc(), zmemalloc() and memrealloc() (see utils.h) allocate from it. This way the existing parse
+ * and forge code needs no changes to allocate from an arena. memfree() must be used instead of free() on anything that
+ * may live in an arena; it ignores arena memory.
+ *
+ * Since the redirection is implicit, anything that calls memalloc() while an arena is entered gets arena memory, and
+ * passing that memory to a plain free() crashes. Therefore arena_enter() must only be used around the CMDU codec entry
+ * points (parse_1905_CMDU_from_view_in_arena() and friends in 1905_cmdus.c), whose allocations are all released with
+ * free_1905_CMDU_structure() and memfree(). Never call into code that uses free(), or that keeps what it allocates,
+ * while an arena is entered.
+ *
+ * Arenas are reference counted. arena_new() returns an arena with one reference; arena_unref() releases the arena when
+ * the count drops to 0. Owners of objects allocated in an arena (e.g. a TLV that is taken out of its CMDU and outlives
+ * it) hold a reference, which they drop with arena_drop().
+ *
+ * An arena and all memory allocated from it must only be used from the thread that created it.
+ */
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+
+/** @brief Size (and alignment) of an arena chunk. Larger objects get a dedicated chunk. */
+#define ARENA_CHUNK_SIZE (32 * 1024)
+
+struct arena;
+
+/** @brief The arena that memalloc() and friends currently allocate from, or NULL to use the heap. */
+extern __thread struct arena *arena_current;
+
+/** @brief Number of arena chunks alive in this thread. Used to short-cut arena_of() when no arena is in use. */
+extern __thread size_t arena_chunks_nr;
+
+/** @brief Create a new, empty arena with a reference count of 1. */
+struct arena *arena_new(void);
+
+/** @brief Take an additional reference to @a arena. */
+void arena_ref(struct arena *arena);
+
+/** @brief Drop a reference to @a arena. When the last reference is dropped, all its memory is released. */
+void arena_unref(struct arena *arena);
+
+/** @brief Make @a arena the current arena for memalloc() and friends.
+ *
+ * @return The previously current arena, which must be passed to arena_leave().
+ */
+struct arena *arena_enter(struct arena *arena);
+
+/** @brief Restore the current arena to @a previous (as returned by arena_enter()). */
+void arena_leave(struct arena *previous);
+
+/** @brief Allocate @a size bytes from @a arena.
+ *
+ * The memory is aligned like malloc() memory. If no memory can be allocated, this function exits immediately.
+ */
+void *arena_alloc(struct arena *arena, size_t size);
+
+/** @brief Redimension @a ptr, which may be heap or arena memory.
+ *
+ * Arena memory is grown in place if it is the last object of its chunk, otherwise it is copied into the current arena
+ * (or the heap if there is no current arena). Heap memory stays on the heap. If no memory can be allocated, this
+ * function exits immediately.
+ */
+void *arena_realloc(void *ptr, size_t size);
+
+/** @brief Get the arena that owns @a ptr, or NULL if @a ptr is not arena memory (of this thread).
+ *
+ * @a ptr must point to the start of an object returned by arena_alloc() (or to any other memory).
+ */
+struct arena *arena_of(const void *ptr);
+
+/** @brief Check if @a ptr was allocated from an arena. */
+static inline bool arena_owns(const void *ptr)
+{
+    return 0 != arena_chunks_nr && NULL != ptr && NULL != arena_of(ptr);
+}
+
+/** @brief Release an object that may have been allocated from an arena.
+ *
+ * If @a object lives in an arena, the reference it holds to that arena is dropped and true is returned; the caller must
+ * then not free it (or anything it points to) any further. Objects that are released while their arena is still the
+ * current one (i.e. during parsing) don't hold a reference, so nothing is dropped for them.
+ *
+ * @return false if @a object is heap memory and must be freed normally.
+ */
+bool arena_drop(const void *object);
+
+#endif // ARENA_H
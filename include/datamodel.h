@@ -60,6 +60,7 @@
 
 #include "tlv.h" // ssid
 #include "ptrarray.h"
+#include "ptrset.h"
 
 #include <stdbool.h> // bool
 #include <stddef.h>  // size_t
@@ -178,7 +179,7 @@ struct interface
     struct wscDeviceData *device_data;
 
     /** @brief Neighbour interfaces. */
-    PTRARRAY(struct interface *) neighbors;
+    PTRSET(struct interface *) neighbors;
 
     /** @brief Operations on the interface.
      *
@@ -234,7 +235,7 @@ struct interfaceWifi {
      *
      * These are also included in interface::neighbors.
      */
-    PTRARRAY(struct interfaceWifi *) clients;
+    PTRSET(struct interfaceWifi *) clients;
 };
 
 /** @brief Wi-Fi radio supported channels.
@@ -292,13 +293,13 @@ struct radio {
     bool        monitor;                /**< Is monitor mode supported on this radio ? */
 
     /** @brief List of bands and their attributes/channels */
-    PTRARRAY(struct radioBand *) bands;
+    PTRSET(struct radioBand *) bands;
 
     /** @brief List of BSSes configured for this radio.
      *
      * Their interfaceWifi::radio pointer points to this object.
      */
-    PTRARRAY(struct interfaceWifi *) configured_bsses;
+    PTRSET(struct interfaceWifi *) configured_bsses;
 
     /** @brief Information used during WSC.
      *
@@ -363,6 +364,8 @@ struct radio {
  *
  * Representation of a 1905.1 device in the network, discovered through topology discovery.
  */
+struct networkDevice;
+
 struct alDevice {
     dlist_item l; /**< @brief Membership of ::network */
 
@@ -385,6 +388,12 @@ struct alDevice {
      * startup.
      */
     void (*setConfigured) (bool configured);
+
+    /** @brief Information reported by this device in its last responses, or NULL if none was received yet.
+     *
+     * It is owned by the AL datamodel (al_datamodel.c), which must release it before the device is deleted.
+     */
+    struct networkDevice *network_device;
 };
 
 /** @brief The local AL device.
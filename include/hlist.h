@@ -135,7 +135,8 @@ extern void     asciiToMac(
  * It is advisable to wrap the allocation macros in a type-specific allocation function (which can also initialize the
  * other struct members).
  *
- * A single item (that has not been added to a list and has no children) can be freed with the normal free() function.
+ * A single item (that has not been added to a list and has no children) can be freed with memfree() (not free(), it may
+ * come from a pool, see pool.h).
  * An entire list, including children, can be freed with hlist_delete(), or a single item with hlist_delete_item().
  */
 typedef struct hlist_item {
@@ -114,10 +114,10 @@ void PLATFORM_PRINTF(const char *format, ...) __attribute__((format (printf, 1,
 // Same as 'PLATFORM_PRINTF', but the message will only be processed if the
 // platform has the pertaining debug level enabled
 //
-void PLATFORM_PRINTF_DEBUG_ERROR(const char *format, ...) __attribute__((format (printf, 1, 2)));
-void PLATFORM_PRINTF_DEBUG_WARNING(const char *format, ...) __attribute__((format (printf, 1, 2)));
-void PLATFORM_PRINTF_DEBUG_INFO(const char *format, ...) __attribute__((format (printf, 1, 2)));
-void PLATFORM_PRINTF_DEBUG_DETAIL(const char *format, ...) __attribute__((format (printf, 1, 2)));
+void (PLATFORM_PRINTF_DEBUG_ERROR)(const char *format, ...) __attribute__((format (printf, 1, 2)));
+void (PLATFORM_PRINTF_DEBUG_WARNING)(const char *format, ...) __attribute__((format (printf, 1, 2)));
+void (PLATFORM_PRINTF_DEBUG_INFO)(const char *format, ...) __attribute__((format (printf, 1, 2)));
+void (PLATFORM_PRINTF_DEBUG_DETAIL)(const char *format, ...) __attribute__((format (printf, 1, 2)));
 
 // Used to set the verbosity of the previous functions:
 //
@@ -126,8 +126,36 @@ void PLATFORM_PRINTF_DEBUG_DETAIL(const char *format, ...) __attribute__((format
 //   2 => Print ERROR, WARNING and INFO messages
 //   3 => Print ERROR, WARNING, INFO and DETAIL messages
 //
+#define PLATFORM_DEBUG_LEVEL_ERROR    (0)
+#define PLATFORM_DEBUG_LEVEL_WARNING  (1)
+#define PLATFORM_DEBUG_LEVEL_INFO     (2)
+#define PLATFORM_DEBUG_LEVEL_DETAIL   (3)
 void PLATFORM_PRINTF_DEBUG_SET_VERBOSITY_LEVEL(int level);
 
+// Returns "1" if messages of the given level ("PLATFORM_DEBUG_LEVEL_*") are
+// currently being printed, "0" otherwise.
+//
+// Use it to skip building debug output that is expensive to prepare (hex
+// dumps, "visit_*()" calls, ...) when it would be discarded anyway.
+//
+static inline int PLATFORM_PRINTF_DEBUG_ENABLED(int level)
+{
+    extern int platform_verbosity_level;
+
+    return level <= platform_verbosity_level;
+}
+
+// The level check is done inline, so that a disabled message costs a single
+// comparison and its arguments are not even evaluated.
+//
+// (The functions can still be called directly, for example when passed as the
+// 'write_function' of the "visit_*()" functions)
+//
+#define PLATFORM_PRINTF_DEBUG_ERROR(...)   do { if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_ERROR))   (PLATFORM_PRINTF_DEBUG_ERROR)(__VA_ARGS__);   } while (0)
+#define PLATFORM_PRINTF_DEBUG_WARNING(...) do { if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_WARNING)) (PLATFORM_PRINTF_DEBUG_WARNING)(__VA_ARGS__); } while (0)
+#define PLATFORM_PRINTF_DEBUG_INFO(...)    do { if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_INFO))    (PLATFORM_PRINTF_DEBUG_INFO)(__VA_ARGS__);    } while (0)
+#define PLATFORM_PRINTF_DEBUG_DETAIL(...)  do { if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))  (PLATFORM_PRINTF_DEBUG_DETAIL)(__VA_ARGS__);  } while (0)
+
 // Return the number of milliseconds ellapsed since the program started
 //
 uint32_t PLATFORM_GET_TIMESTAMP(void);
@@ -0,0 +1,132 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+/** @file
+ *  @brief Slab pools for small, long-lived objects.
+ *
+ * The datamodel objects (::alDevice, ::interface, ::radio, ...) and the hlist items (TLVs built with HLIST_ALLOC) are
+ * small and come and go all the time, e.g. when neighbors appear and disappear. Allocating each of them with malloc()
+ * fragments the heap over time. Instead, they are carved out of slabs: each size class (multiples of POOL_ALIGN bytes,
+ * up to POOL_MAX_OBJECT) has its own slabs and its own free list, and freed objects are only reused for objects of the
+ * same class. Slabs are never given back to the system.
+ *
+ * memfree() (see utils.h) recognizes pool memory, so objects that may come from a pool can be released with either
+ * pool_free() or memfree(), but never with free().
+ *
+ * Like arenas, pools are per thread: pool memory must only be used and freed in the thread that allocated it.
+ */
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+
+/** @brief Size (and alignment) of a slab. */
+#define POOL_SLAB_SIZE (8 * 1024)
+
+/** @brief Granularity of the size classes. Pool objects are aligned like malloc() memory. */
+#define POOL_ALIGN _Alignof(max_align_t)
+
+/** @brief Largest object that is allocated from a pool. Larger ones come from the heap. */
+#define POOL_MAX_OBJECT 512
+
+/** @brief Number of pool slabs alive in this thread. Used to short-cut pool_owns() when no pool is in use. */
+extern __thread size_t pool_slabs_nr;
+
+/** @brief Pool usage statistics. */
+struct poolStats {
+    size_t live;   /**< @brief Objects currently allocated. */
+    size_t peak;   /**< @brief Highest value of @a live so far. */
+    size_t bytes;  /**< @brief Memory taken by the slabs (used or not). */
+    size_t allocs; /**< @brief Objects handed out from the slabs so far (not counting those that come from the heap). */
+};
+
+/** @brief Allocate a zero-initialised object of @a size bytes.
+ *
+ * While an arena is entered (see arena.h), the memory is allocated from that arena, like with zmemalloc(). Objects
+ * larger than POOL_MAX_OBJECT are allocated from the heap. If no memory can be allocated, this function exits
+ * immediately.
+ */
+void *pool_zalloc(size_t size);
+
+/** @brief Release an object obtained with pool_zalloc().
+ *
+ * Objects that are not pool memory are released with memfree().
+ */
+void pool_free(void *ptr);
+
+/** @brief Check if @a ptr lies in a slab of this thread.
+ * @internal
+ */
+bool pool_slab_of(const void *ptr);
+
+/** @brief Check if @a ptr was allocated from a pool. */
+static inline bool pool_owns(const void *ptr)
+{
+    return 0 != pool_slabs_nr && NULL != ptr && pool_slab_of(ptr);
+}
+
+/** @brief Get the statistics of the size class that objects of @a size bytes belong to, or of all pools together if
+ * @a size is 0.
+ */
+void pool_stats(size_t size, struct poolStats *stats);
+
+/** @brief Print the statistics of all size classes in use using the provided printf-like function. */
+void pool_dump(void (*write_function)(const char *fmt, ...));
+
+#endif // POOL_H
@@ -0,0 +1,218 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#ifndef PTRSET_H
+#define PTRSET_H
+
+/** @file
+ *  @brief Pointer set structure.
+ *
+ * This file implements an unordered container of distinct pointers. Compared to a PTRARRAY(), its storage grows
+ * geometrically, an element is removed by moving the last one in its place, and once the set is larger than
+ * PTRSET_INDEX_MIN a hash index makes membership tests constant time.
+ *
+ * Like the pointer array, this functionality is defined by macros to be type-safe. Only the hash index is implemented
+ * by (untyped) functions.
+ */
+
+#include "utils.h" /* memrealloc() */
+#include <limits.h> /* UINT_MAX */
+
+/** @brief Sets with more elements than this get a hash index. */
+#define PTRSET_INDEX_MIN 8
+
+/** @brief Hash index of a pointer set: maps each element to its position in the set. */
+struct ptrsetIndex {
+    struct ptrsetIndexSlot {
+        const void *key;  /**< @brief Element, NULL if the slot is empty. */
+        unsigned    pos;  /**< @brief Position of @a key in the set. */
+    } *slots;
+    unsigned size;        /**< @brief Number of slots (a power of two), 0 if there is no index. */
+    unsigned used;        /**< @brief Number of slots that are not empty (including removed elements). */
+};
+
+/** @brief Set the position of @a key in @a index, adding it if needed. */
+void ptrsetIndexSet(struct ptrsetIndex *index, const void *key, unsigned pos);
+
+/** @brief Get the position of @a key in @a index.
+ *
+ * @return The position, UINT_MAX if @a key is not in the index.
+ */
+unsigned ptrsetIndexGet(const struct ptrsetIndex *index, const void *key);
+
+/** @brief Remove @a key from @a index. */
+void ptrsetIndexRemove(struct ptrsetIndex *index, const void *key);
+
+/** @brief Remove all keys from @a index and free it. */
+void ptrsetIndexClear(struct ptrsetIndex *index);
+
+/** @brief Declare a set of @a type.
+ *
+ * This is typically added as a struct member. It cannot be used directly as a function parameter, but it can be used
+ * in a typedef.
+ *
+ * The pointer set must be initialised to 0 before using it, either with memset or by implicit initialisation of
+ * static variables.
+ *
+ * To get the number of elements, access the length member directly. To iterate, use the same loop as for a
+ * PTRARRAY(). The order of the elements is not preserved when elements are removed.
+ *
+ * @a type must be a pointer type, and NULL cannot be added to the set.
+ */
+#define PTRSET(type) \
+    struct { \
+        unsigned length; \
+        unsigned capacity; \
+        type *data; \
+        struct ptrsetIndex index; \
+    }
+
+/** @brief Find a pointer in the pointer set.
+ *
+ * @return The index if found, @a ptrset.length if not found.
+ */
+#define PTRSET_FIND(ptrset, item) ({ \
+        __typeof__(*(ptrset).data) ptrset_find_item = (item); \
+        unsigned ptrset_find_i; \
+        if ((ptrset).index.size != 0) \
+        { \
+            ptrset_find_i = ptrsetIndexGet(&(ptrset).index, ptrset_find_item); \
+            if (ptrset_find_i == UINT_MAX) \
+                ptrset_find_i = (ptrset).length; \
+        } \
+        else \
+        { \
+            for (ptrset_find_i = 0; ptrset_find_i < (ptrset).length; ptrset_find_i++) \
+            { \
+                if ((ptrset).data[ptrset_find_i] == ptrset_find_item) \
+                    break; \
+            } \
+        } \
+        ptrset_find_i; \
+    })
+
+/** @brief Add an element to a pointer set.
+ *
+ * The element is added at the end, unless it is already in the set (then nothing changes).
+ *
+ * @param ptrset A pointer set declared with PTRSET().
+ * @param item The element to be added. Must be of the same type as in the PTRSET declaration.
+ */
+#define PTRSET_ADD(ptrset, item) \
+    do { \
+        __typeof__(*(ptrset).data) ptrset_add_item = (item); \
+        unsigned ptrset_add_i; \
+        if (PTRSET_FIND(ptrset, ptrset_add_item) < (ptrset).length) \
+            break; \
+        if ((ptrset).length == (ptrset).capacity) \
+        { \
+            (ptrset).capacity = (ptrset).capacity == 0 ? 4 : (ptrset).capacity * 2; \
+            (ptrset).data = memrealloc((ptrset).data, (ptrset).capacity * sizeof(*(ptrset).data)); \
+        } \
+        (ptrset).data[(ptrset).length] = ptrset_add_item; \
+        if ((ptrset).index.size != 0) \
+            ptrsetIndexSet(&(ptrset).index, ptrset_add_item, (ptrset).length); \
+        (ptrset).length++; \
+        if ((ptrset).index.size == 0 && (ptrset).length > PTRSET_INDEX_MIN) \
+        { \
+            for (ptrset_add_i = 0; ptrset_add_i < (ptrset).length; ptrset_add_i++) \
+                ptrsetIndexSet(&(ptrset).index, (ptrset).data[ptrset_add_i], ptrset_add_i); \
+        } \
+    } while (0)
+
+/** @brief Remove all elements from the pointer set. */
+#define PTRSET_CLEAR(ptrset) \
+    do { \
+        memfree((ptrset).data); \
+        (ptrset).data = NULL; \
+        (ptrset).length = 0; \
+        (ptrset).capacity = 0; \
+        ptrsetIndexClear(&(ptrset).index); \
+    } while(0)
+
+/** @brief Remove the item at position @a pos from a pointer set.
+ *
+ * The last element is moved to @a pos.
+ *
+ * For convenience when used in combination with PTRSET_FIND, if @a pos is equal to the length of the set, nothing
+ * is removed.
+ */
+#define PTRSET_REMOVE(ptrset, pos) \
+    do { \
+        unsigned ptrset_remove_i = (pos); \
+        if (ptrset_remove_i >= (ptrset).length) \
+            break; \
+        if ((ptrset).index.size != 0) \
+            ptrsetIndexRemove(&(ptrset).index, (ptrset).data[ptrset_remove_i]); \
+        (ptrset).length--; \
+        if ((ptrset).length == 0) \
+        { \
+            PTRSET_CLEAR(ptrset); \
+        } \
+        else if (ptrset_remove_i < (ptrset).length) \
+        { \
+            (ptrset).data[ptrset_remove_i] = (ptrset).data[(ptrset).length]; \
+            if ((ptrset).index.size != 0) \
+                ptrsetIndexSet(&(ptrset).index, (ptrset).data[ptrset_remove_i], ptrset_remove_i); \
+        } \
+    } while (0)
+
+/** @brief Remove an item from a pointer set. */
+#define PTRSET_REMOVE_ELEMENT(ptrset, item) \
+    PTRSET_REMOVE(ptrset, PTRSET_FIND(ptrset, item))
+
+#endif // PTRSET_H
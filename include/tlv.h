@@ -106,6 +106,7 @@ enum tlv_struct_print_format {
     tlv_struct_print_format_mac, /**< MAC address, i.e. colon-separated hex. Size must be 6. */
     tlv_struct_print_format_ipv4, /**< IPv4 address, i.e. dot-separated unsigned decimal. Size must be 4. */
     tlv_struct_print_format_ipv6, /**< IPv6 address, i.e. colon-separated hex. Size must be 16. */
+    tlv_struct_print_format_string, /**< Fixed-size character array, printed up to the first NUL byte. */
 };
 
 /** @brief Description of a TLV field, used to drive the parse, forge and print functionality. */
@@ -116,6 +117,17 @@ struct tlv_struct_field_description {
     enum tlv_struct_print_format format; /**< How to format the field when printing. */
 };
 
+/** @brief Virtual functions of a tlv_struct_description that were generated rather than written by hand.
+ *
+ * See src/tlv_codegen.cmake.
+ */
+enum tlv_struct_codegen {
+    tlv_struct_codegen_parse = 1 << 0,
+    tlv_struct_codegen_length = 1 << 1,
+    tlv_struct_codegen_forge = 1 << 2,
+    tlv_struct_codegen_compare = 1 << 3,
+};
+
 /** @brief Description of a TLV (sub)structure, used to drive the parse, forge and print functionality. */
 struct tlv_struct_description {
     const char *name; /**< Struct name, used for printing. */
@@ -216,8 +228,27 @@ struct tlv_struct_description {
      * If NULL, a default compare function is used based on the field and children descriptions.
      */
     int (*compare)(const struct tlv_struct *item1, const struct tlv_struct *item2);
+
+    /** @brief Which of the virtual functions were generated from this description (enum tlv_struct_codegen flags).
+     *
+     * The generated functions do exactly what the default ones do, but without interpreting the description at run
+     * time. They can be bypassed with ::tlv_codegen_disabled.
+     */
+    unsigned codegen;
 };
 
+/** @brief Plug the generated virtual functions of description @a name into its initializer.
+ *
+ * Expands to nothing unless the file including tlv.h also includes the header generated by src/tlv_codegen.cmake.
+ */
+#define TLV_STRUCT_CODEGEN(name)
+
+/** @brief Use the default virtual functions instead of the generated ones.
+ *
+ * This is only meant for testing the generated functions against the default ones.
+ */
+extern bool tlv_codegen_disabled;
+
 #define TLV_STRUCT_FIELD_DESCRIPTION(structtype, field, fmt) \
     { \
         .name = #field, \
@@ -393,6 +424,7 @@ struct tlv_def
             .name = #tlv_name,     \
             .size = sizeof(struct tlv_name ## TLV), \
             .children = { child, NULL }, \
+            TLV_STRUCT_CODEGEN(tlv_name) \
             __VA_ARGS__ \
         },                         \
     }
@@ -456,6 +488,18 @@ struct tlv_def
         __VA_ARGS__ \
     )
 
+#define TLV_DEF_ENTRY_4FIELDS(tlv_name, tlv_type, child, field1, fmt1, field2, fmt2, field3, fmt3, field4, fmt4, ...) \
+    TLV_DEF_ENTRY_INTERNAL(tlv_name, tlv_type, child, \
+        .fields = { \
+            TLV_STRUCT_FIELD_DESCRIPTION(struct tlv_name##TLV, field1, fmt1), \
+            TLV_STRUCT_FIELD_DESCRIPTION(struct tlv_name##TLV, field2, fmt2), \
+            TLV_STRUCT_FIELD_DESCRIPTION(struct tlv_name##TLV, field3, fmt3), \
+            TLV_STRUCT_FIELD_DESCRIPTION(struct tlv_name##TLV, field4, fmt4), \
+            TLV_STRUCT_FIELD_SENTINEL, \
+        }, \
+        __VA_ARGS__ \
+    )
+
 /** @} */
 
 /** @brief Definition of TLV metadata.
@@ -502,6 +546,28 @@ bool tlv_add(tlv_defs_t defs, dlist_head *tlvs, struct tlv *tlv);
  */
 bool tlv_parse(tlv_defs_t defs, dlist_head *tlvs, const uint8_t *buffer, size_t length);
 
+/** @brief Calculate the length of a forged TLV.
+ *
+ * @param tlv The TLV.
+ *
+ * @return The number of bytes tlv_forge_into() writes for @a tlv, including the type and length fields.
+ *
+ * Nothing is forged or allocated, only the tlv_struct_description::length virtual functions are called.
+ */
+size_t tlv_forged_length(const struct tlv *tlv);
+
+/** @brief Forge a single TLV into an existing buffer.
+ *
+ * @param tlv The TLV to forge.
+ *
+ * @param[in,out] buffer The position in the buffer where to forge. It is advanced past the forged TLV.
+ *
+ * @param[in,out] length The remaining length of @a buffer. It is decremented with the forged length.
+ *
+ * @return true if successful, false if @a tlv doesn't fit in @a length or can't be forged.
+ */
+bool tlv_forge_into(const struct tlv *tlv, uint8_t **buffer, size_t *length);
+
 /** @brief Forge a list of TLVs.
  *
  * @param defs The TLV metadata.
@@ -64,6 +64,9 @@
 #include <string.h> // memset()
 #include <stdio.h> // fprintf
 
+#include "arena.h"
+#include "pool.h"
+
 /** @brief Get the number of elements in an array.
  *
  * Note that this simple macro may evaluate its argument 0, 1 or 2 times, and that it doesn't check at all if the
@@ -93,6 +96,8 @@
 
 
 /** @ brief Allocate a chunk of 'n' bytes and return a pointer to it.
+ *
+ * While an arena is entered (see arena.h), the memory is allocated from that arena and must not be passed to free().
  *
  * If no memory can be allocated, this function exits immediately.
  */
@@ -100,6 +105,11 @@ static inline void *memalloc(size_t size)
 {
     void *p;
 
+    if (NULL != arena_current)
+    {
+        return arena_alloc(arena_current, size);
+    }
+
     p = malloc(size);
 
     if (NULL == p)
@@ -123,6 +133,11 @@ static inline void *memrealloc(void *ptr, size_t size)
 {
     void *p;
 
+    if (NULL != arena_current || 0 != arena_chunks_nr)
+    {
+        return arena_realloc(ptr, size);
+    }
+
     p = realloc(ptr, size);
 
     if (NULL == p)
@@ -134,6 +149,23 @@ static inline void *memrealloc(void *ptr, size_t size)
     return p;
 }
 
+/** @brief Free memory obtained with memalloc(), zmemalloc(), memrealloc() or pool_zalloc().
+ *
+ * Memory that was allocated from an arena is left alone: it is released together with its arena. Pool memory goes back
+ * to its pool.
+ */
+static inline void memfree(void *ptr)
+{
+    if (pool_owns(ptr))
+    {
+        pool_free(ptr);
+    }
+    else if (!arena_owns(ptr))
+    {
+        free(ptr);
+    }
+}
+
 /** @brief Copy a 0-terminated string to a max-sized string.
  *
  * Some strings are represented by a length and value field in the internal model, but are initialized from 0-terminated
@@ -1231,15 +1231,14 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
             *len = 2;  // alme_type + metrics_nr
             for (i=0; i<m->metrics_nr; i++)
             {
-                uint8_t  *metric_stream;
-                uint16_t  metric_stream_len;
+                size_t  metric_stream_len;
 
                 *len += 6; // neighbor_dev_address
                 *len += 6; // local_intf_address
                 *len += 1; // bridge_flag
 
-                metric_stream = forge_1905_TLV_from_structure(&m->metrics[i].tx_metric->tlv, &metric_stream_len);
-                if (NULL == metric_stream || 0 == metric_stream_len)
+                metric_stream_len = forge_1905_TLV_length(&m->metrics[i].tx_metric->tlv);
+                if (0 == metric_stream_len)
                 {
                     // Forging error
                     //
@@ -1248,10 +1247,9 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                 }
 
                 *len += metric_stream_len;
-                free_1905_TLV_packet(metric_stream);
 
-                metric_stream = forge_1905_TLV_from_structure(&m->metrics[i].rx_metric->tlv, &metric_stream_len);
-                if (NULL == metric_stream || 0 == metric_stream_len)
+                metric_stream_len = forge_1905_TLV_length(&m->metrics[i].rx_metric->tlv);
+                if (0 == metric_stream_len)
                 {
                     // Forging error
                     //
@@ -1260,7 +1258,6 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                 }
 
                 *len += metric_stream_len;
-                free_1905_TLV_packet(metric_stream);
             }
             *len += 1;  // reason_code
 
@@ -1271,8 +1268,7 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
 
             for (i=0; i<m->metrics_nr; i++)
             {
-                uint8_t  *metric_stream;
-                uint16_t  metric_stream_len;
+                size_t  metric_stream_len;
 
                 struct transmitterLinkMetricTLV *tx;
                 struct receiverLinkMetricTLV    *rx;
@@ -1303,8 +1299,10 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                     return NULL;
                 }
 
-                metric_stream = forge_1905_TLV_from_structure(&tx->tlv, &metric_stream_len);
-                if (NULL == metric_stream || 0 == metric_stream_len)
+                // The TLVs are forged directly into their final position
+                //
+                metric_stream_len = forge_1905_TLV_into_buffer(&tx->tlv, p, ret + *len - p);
+                if (0 == metric_stream_len)
                 {
                     // Forging error
                     //
@@ -1312,11 +1310,10 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                     free(ret);
                     return NULL;
                 }
-                _InB( metric_stream,  &p, metric_stream_len);
-                free_1905_TLV_packet(metric_stream);
+                p += metric_stream_len;
 
-                metric_stream = forge_1905_TLV_from_structure(&rx->tlv, &metric_stream_len);
-                if (NULL == metric_stream || 0 == metric_stream_len)
+                metric_stream_len = forge_1905_TLV_into_buffer(&rx->tlv, p, ret + *len - p);
+                if (0 == metric_stream_len)
                 {
                     // Forging error
                     //
@@ -1324,8 +1321,7 @@ uint8_t *forge_1905_ALME_from_structure(uint8_t *memory_structure, uint16_t *len
                     free(ret);
                     return NULL;
                 }
-                _InB( metric_stream,  &p, metric_stream_len);
-                free_1905_TLV_packet(metric_stream);
+                p += metric_stream_len;
             }
 
             _I1B(&m->reason_code,  &p);
@@ -518,59 +518,45 @@ static uint8_t _check_CMDU_rules(const struct CMDU *p, uint8_t rules_type)
 
 
 
-////////////////////////////////////////////////////////////////////////////////
-// Actual API functions
-////////////////////////////////////////////////////////////////////////////////
-
-struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
+// Adds one entry to the TLV index of 'view', growing it if needed
+//
+static void _add_CMDU_view_TLV(struct CMDU_view *view, uint8_t type, uint16_t length, const uint8_t *value)
 {
-    struct CMDU *ret;
-
-    uint8_t  fragments_nr;
-    uint8_t  current_fragment;
-
-    uint8_t  tlvs_nr;
-
-    uint8_t  error;
-
-    if (NULL == packet_streams)
+    if (view->tlvs_nr == view->tlvs_max)
     {
-        // Invalid arguments
-        //
-        PLATFORM_PRINTF_DEBUG_ERROR("NULL packet_streams\n");
-        return NULL;
-    }
+        struct CMDU_view_tlv *tlvs;
 
-    // Find out how many streams/fragments we have received
-    //
-    fragments_nr = 0;
-    while (*(packet_streams+fragments_nr))
-    {
-        fragments_nr++;
-    }
-    if (0 == fragments_nr)
-    {
-        // No streams supplied!
-        //
-        PLATFORM_PRINTF_DEBUG_ERROR("No fragments supplied\n");
-        return NULL;
+        tlvs = (struct CMDU_view_tlv *)memalloc(sizeof(struct CMDU_view_tlv) * view->tlvs_max * 2);
+        memcpy(tlvs, view->tlvs, sizeof(struct CMDU_view_tlv) * view->tlvs_nr);
+        if (view->tlvs != view->inline_tlvs)
+        {
+            memfree(view->tlvs);
+        }
+        view->tlvs      = tlvs;
+        view->tlvs_max *= 2;
     }
 
-    // Allocate the return structure.
-    // Initially it will contain an empty list of TLVs that we will later
-    // re-allocate and fill.
-    //
-    ret = (struct CMDU *)memalloc(sizeof(struct CMDU) * 1);
-    ret->list_of_TLVs = (struct tlv **)memalloc(sizeof(struct tlv *) * 1);
-    ret->list_of_TLVs[0] = NULL;
-    tlvs_nr = 0;
+    view->tlvs[view->tlvs_nr].type   = type;
+    view->tlvs[view->tlvs_nr].length = length;
+    view->tlvs[view->tlvs_nr].value  = value;
+    view->tlvs_nr++;
+}
+
+// Checks the headers of all fragments and fills the TLV index of 'view'.
+// Returns '0' on success or an error code (the same ones that
+// "parse_1905_CMDU_from_packets()" reports in its "Parsing error" message).
+//
+// If 'streams_lens' is not NULL, no TLV is allowed to extend past the end of
+// the fragment that contains it.
+//
+static uint8_t _index_1905_CMDU_view(uint8_t **packet_streams, const uint16_t *streams_lens, uint8_t fragments_nr, struct CMDU_view *view)
+{
+    uint8_t  current_fragment;
 
-    // Next, parse each fragment
-    //
-    error = 0;
     for (current_fragment = 0; current_fragment<fragments_nr; current_fragment++)
     {
         const uint8_t *p;
+        const uint8_t *end;
         uint8_t i;
 
         uint8_t   message_version;
@@ -583,8 +569,6 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
         uint8_t   relay_indicator;
         uint8_t   last_fragment_indicator;
 
-        struct tlv *parsed;
-
         // We want to traverse fragments in order, thus lets search for the
         // fragment whose 'fragment_id' matches 'current_fragment' (which will
         // monotonically increase starting at '0')
@@ -593,6 +577,13 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
         {
             p = *(packet_streams+i);
 
+            if (NULL != streams_lens && streams_lens[i] < 8)
+            {
+                // Not even the header fits in this fragment
+                //
+                return 9;
+            }
+
             // The 'fragment_id' field is the 7th byte (offset 6)
             //
             if (current_fragment == *(p+6))
@@ -604,9 +595,9 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
         {
             // One of the fragments is missing!
             //
-            error = 1;
-            break;
+            return 1;
         }
+        end = NULL == streams_lens ? NULL : p + streams_lens[i];
 
         // At this point 'p' points to the stream whose 'fragment_id' is
         // 'current_fragment'
@@ -631,26 +622,25 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
             // We will later (in later fragments) check that their values always
             // remain the same
             //
-            ret->message_version = message_version;
-            ret->message_type    = message_type;
-            ret->message_id      = message_id;
-            ret->relay_indicator = relay_indicator;
+            view->message_version = message_version;
+            view->message_type    = message_type;
+            view->message_id      = message_id;
+            view->relay_indicator = relay_indicator;
         }
         else
         {
             // Check for consistency in all 'common' values
             //
            if (
-                (ret->message_version != message_version) ||
-                (ret->message_type    != message_type)    ||
-                (ret->message_id      != message_id)      ||
-                (ret->relay_indicator != relay_indicator)
+                (view->message_version != message_version) ||
+                (view->message_type    != message_type)    ||
+                (view->message_id      != message_id)      ||
+                (view->relay_indicator != relay_indicator)
               )
            {
                // Fragments with different common fields were detected!
                //
-               error = 2;
-               break;
+               return 2;
            }
         }
 
@@ -669,8 +659,7 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
             {
                 // Malformed packet
                 //
-                error = 3;
-                break;
+                return 3;
             }
         }
 
@@ -682,80 +671,191 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
         {
             // 'last_fragment_indicator' appeared *before* the last fragment
             //
-            error = 4;
-            break;
+            return 4;
         }
         if ((0 == last_fragment_indicator) && (current_fragment == fragments_nr-1))
         {
             // 'last_fragment_indicator' did not appear in the last fragment
             //
-            error = 5;
-            break;
+            return 5;
         }
 
-        // We can now parse the TLVs. 'p' is pointing to the first one at this
-        // moment
+        // We can now index the TLVs. 'p' is pointing to the first one at this
+        // moment. Their contents are not looked at (yet).
         //
         while (1)
         {
-            parsed = parse_1905_TLV_from_packet(p);
-            if (NULL == parsed)
-            {
-                // Error while parsing a TLV
-                // Dump TLV for visual inspection
-
-                const uint8_t *p2 = p;
-                uint16_t len;
-                uint8_t  aux;
-
-                _E1B(&p2, &aux);
-                _E2B(&p2, &len);
-
-                PLATFORM_PRINTF_DEBUG_WARNING("Parsing error TLV type %u. Dumping bytes: \n", aux);
+            uint8_t  tlv_type;
+            uint16_t tlv_len;
 
-                // Limit dump length
+            if (NULL != end && end - p < 3)
+            {
+                // The fragment ends here, with or without an "end of message"
+                // TLV
                 //
-                if (len > 200)
-                {
-                    len = 200;
-                }
-
-                print_callback(PLATFORM_PRINTF_DEBUG_WARNING, "", len, "Payload", "%02x", p2);
-                error = 6;
                 break;
             }
 
-            if (TLV_TYPE_END_OF_MESSAGE == parsed->type)
+            _E1B(&p, &tlv_type);
+            _E2B(&p, &tlv_len);
+
+            if (TLV_TYPE_END_OF_MESSAGE == tlv_type)
             {
                 // No more TLVs
                 //
-                free_1905_TLV_structure(parsed);
                 break;
             }
 
-            // Advance 'p' to the next TLV.
-            //
-            uint8_t  tlv_type;
-            uint16_t tlv_len;
+            if (NULL != end && end - p < tlv_len)
+            {
+                // The TLV length points past the end of the fragment
+                //
+                return 10;
+            }
 
-            _E1B(&p, &tlv_type);
-            _E2B(&p, &tlv_len);
+            _add_CMDU_view_TLV(view, tlv_type, tlv_len, p);
 
             p += tlv_len;
+        }
+    }
 
-            // Add this new TLV to the list (the list needs to be re-allocated
-            // with more space first)
-            //
-            tlvs_nr++;
-            ret->list_of_TLVs = (struct tlv **)memrealloc(ret->list_of_TLVs, sizeof(struct tlv *) * (tlvs_nr+1));
-            ret->list_of_TLVs[tlvs_nr-1] = parsed;
-            ret->list_of_TLVs[tlvs_nr]   = NULL;
+    return 0;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Actual API functions
+////////////////////////////////////////////////////////////////////////////////
+
+bool parse_1905_CMDU_view_from_packets(uint8_t **packet_streams, const uint16_t *streams_lens, struct CMDU_view *view)
+{
+    uint8_t  fragments_nr;
+    uint8_t  error;
+
+    view->tlvs     = view->inline_tlvs;
+    view->tlvs_nr  = 0;
+    view->tlvs_max = CMDU_VIEW_INLINE_TLVS;
+
+    if (NULL == packet_streams)
+    {
+        // Invalid arguments
+        //
+        PLATFORM_PRINTF_DEBUG_ERROR("NULL packet_streams\n");
+        return false;
+    }
+
+    // Find out how many streams/fragments we have received
+    //
+    fragments_nr = 0;
+    while (*(packet_streams+fragments_nr))
+    {
+        fragments_nr++;
+    }
+    if (0 == fragments_nr)
+    {
+        // No streams supplied!
+        //
+        PLATFORM_PRINTF_DEBUG_ERROR("No fragments supplied\n");
+        return false;
+    }
+
+    error = _index_1905_CMDU_view(packet_streams, streams_lens, fragments_nr, view);
+    if (0 != error)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Parsing error %d\n", error);
+        free_1905_CMDU_view(view);
+        return false;
+    }
+
+    return true;
+}
+
+const struct CMDU_view_tlv *get_1905_CMDU_view_TLV(const struct CMDU_view *view, uint8_t type)
+{
+    unsigned i;
+
+    for (i = 0; i < view->tlvs_nr; i++)
+    {
+        if (type == view->tlvs[i].type)
+        {
+            return &view->tlvs[i];
         }
-        if (0 != error)
+    }
+
+    return NULL;
+}
+
+struct tlv *parse_1905_CMDU_view_TLV(const struct CMDU_view_tlv *view_tlv)
+{
+    // The TLV header (type and length) precedes the value
+    //
+    return parse_1905_TLV_from_packet(view_tlv->value - 3);
+}
+
+void free_1905_CMDU_view(struct CMDU_view *view)
+{
+    if (view->tlvs != view->inline_tlvs)
+    {
+        memfree(view->tlvs);
+    }
+    view->tlvs     = view->inline_tlvs;
+    view->tlvs_nr  = 0;
+    view->tlvs_max = CMDU_VIEW_INLINE_TLVS;
+}
+
+struct CMDU *parse_1905_CMDU_from_view(const struct CMDU_view *view)
+{
+    struct CMDU *ret;
+
+    unsigned  tlvs_nr;
+    unsigned  i;
+
+    uint8_t  error;
+
+    // Allocate the return structure, with room for all the indexed TLVs (some
+    // of them might later be removed by the CMDU rules).
+    //
+    ret = (struct CMDU *)memalloc(sizeof(struct CMDU) * 1);
+    ret->message_version = view->message_version;
+    ret->message_type    = view->message_type;
+    ret->message_id      = view->message_id;
+    ret->relay_indicator = view->relay_indicator;
+    ret->list_of_TLVs    = (struct tlv **)memalloc(sizeof(struct tlv *) * (view->tlvs_nr + 1));
+    tlvs_nr = 0;
+
+    // Next, parse each TLV
+    //
+    error = 0;
+    for (i = 0; i < view->tlvs_nr; i++)
+    {
+        struct tlv *parsed;
+
+        parsed = parse_1905_CMDU_view_TLV(&view->tlvs[i]);
+        if (NULL == parsed)
         {
+            // Error while parsing a TLV
+            // Dump TLV for visual inspection
+
+            uint16_t len = view->tlvs[i].length;
+
+            PLATFORM_PRINTF_DEBUG_WARNING("Parsing error TLV type %u. Dumping bytes: \n", view->tlvs[i].type);
+
+            // Limit dump length
+            //
+            if (len > 200)
+            {
+                len = 200;
+            }
+
+            print_callback(PLATFORM_PRINTF_DEBUG_WARNING, "", len, "Payload", "%02x", view->tlvs[i].value);
+            error = 6;
             break;
         }
+
+        ret->list_of_TLVs[tlvs_nr++] = parsed;
     }
+    ret->list_of_TLVs[tlvs_nr] = NULL;
 
     if (0 == error)
     {
@@ -851,16 +951,86 @@ struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
 }
 
 
+struct CMDU *parse_1905_CMDU_from_packets(uint8_t **packet_streams)
+{
+    struct CMDU_view  view;
+    struct CMDU      *ret;
+
+    if (!parse_1905_CMDU_view_from_packets(packet_streams, NULL, &view))
+    {
+        return NULL;
+    }
+
+    ret = parse_1905_CMDU_from_view(&view);
+    free_1905_CMDU_view(&view);
+
+    return ret;
+}
+
+
+struct CMDU *parse_1905_CMDU_from_view_in_arena(const struct CMDU_view *view)
+{
+    struct arena *arena;
+    struct arena *previous;
+    struct CMDU  *ret;
+    unsigned      i;
+
+    arena = arena_new();
+
+    // Anything freed during parsing (e.g. TLVs discarded by the CMDU rules) is
+    // simply left in the arena.
+    //
+    previous = arena_enter(arena);
+    ret = parse_1905_CMDU_from_view(view);
+    arena_leave(previous);
+
+    if (NULL == ret)
+    {
+        arena_unref(arena);
+        return NULL;
+    }
+
+    // The initial reference belongs to the CMDU structure itself. Each TLV gets
+    // its own, so that it can outlive the CMDU.
+    //
+    for (i = 0; NULL != ret->list_of_TLVs && NULL != ret->list_of_TLVs[i]; i++)
+    {
+        arena_ref(arena);
+    }
+
+    return ret;
+}
+
+
+struct CMDU *parse_1905_CMDU_from_packets_in_arena(uint8_t **packet_streams)
+{
+    struct CMDU_view  view;
+    struct CMDU      *ret;
+
+    if (!parse_1905_CMDU_view_from_packets(packet_streams, NULL, &view))
+    {
+        return NULL;
+    }
+
+    ret = parse_1905_CMDU_from_view_in_arena(&view);
+    free_1905_CMDU_view(&view);
+
+    return ret;
+}
+
+
 uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, uint16_t **lens)
 {
     uint8_t **ret;
 
-    uint8_t tlv_start;
-    uint8_t tlv_stop;
+    uint8_t  *s;
+    uint8_t  *indicators;
+    uint8_t   i;
 
     uint8_t fragments_nr;
 
     uint32_t max_tlvs_block_size;
+    uint32_t current_X_size;
 
     uint8_t error;
 
@@ -922,149 +1092,128 @@ uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, ui
     // this fragmen) can not be greater than MAX_NETWORK_SEGMENT_SIZE - 6 - 6 -
     // 2 - 1 - 1 - 2 - 2 - 1 - 1 - 3 = MAX_NETWORK_SEGMENT_SIZE - 25 bytes.
     //
+    // The TLVs are visited only once: the (cheap) length of each one decides
+    // whether it goes into the current fragment or a new one has to be
+    // started, and then it is forged directly at its final position.
+    //
     max_tlvs_block_size = MAX_NETWORK_SEGMENT_SIZE - 25;
-    tlv_start           = 0;
-    tlv_stop            = 0;
-    do
-    {
-        uint8_t *s;
-        uint8_t  i;
+    current_X_size      = 0;
+    s                   = NULL;
+    indicators          = NULL;
 
-        uint16_t current_X_size;
+    for (i = 0; ; i++)
+    {
+        struct tlv *p;
+        size_t      tlv_stream_size = 0;
 
-        uint8_t reserved_field;
-        uint8_t fragment_id;
-        uint8_t indicators;
+        p = memory_structure->list_of_TLVs[i];
 
-        uint8_t no_space;
+        if (NULL != p)
+        {
+            tlv_stream_size = forge_1905_TLV_length(p);
+            if (0 == tlv_stream_size)
+            {
+                // This TLV can not be forged
+                //
+                error = 1;
+                break;
+            }
+        }
 
-        current_X_size = 0;
-        no_space       = 0;
-        while(memory_structure->list_of_TLVs[tlv_stop])
+        if (0 == fragments_nr || (NULL != p && current_X_size + tlv_stream_size >= max_tlvs_block_size))
         {
-            struct tlv  *p;
-            uint8_t  *tlv_stream;
-            uint16_t  tlv_stream_size;
+            uint8_t reserved_field;
+            uint8_t fragment_id;
+            uint8_t flags;
+
+            if (0 != fragments_nr)
+            {
+                if (0 == current_X_size)
+                {
+                    // One *single* TLV does not fit in a fragment!
+                    // This is an error... there is no way to split one single
+                    // TLV into several fragments according to the standard.
+                    //
+                    error = 1;
+                    break;
+                }
+
+                // Don't forget to add the last three octects representing the
+                // TLV_TYPE_END_OF_MESSAGE message
+                //
+                *s = 0x0; s++;
+                *s = 0x0; s++;
+                *s = 0x0; s++;
+
+                (*lens)[fragments_nr-1] = s - ret[fragments_nr-1];
+            }
+
+            // Start a new fragment
+            //
+            fragments_nr++;
 
-            p = memory_structure->list_of_TLVs[tlv_stop];
+            ret = (uint8_t **)memrealloc(ret, sizeof(uint8_t *) * (fragments_nr + 1));
+            ret[fragments_nr-1] = (uint8_t *)memalloc(MAX_NETWORK_SEGMENT_SIZE);
+            ret[fragments_nr]   = NULL;
 
-            tlv_stream = forge_1905_TLV_from_structure(p, &tlv_stream_size);
-            free(tlv_stream);
+            *lens = (uint16_t *)memrealloc(*lens, sizeof(uint16_t *) * (fragments_nr + 1));
+            (*lens)[fragments_nr-1] = 0; // To be updated when the fragment is complete
+            (*lens)[fragments_nr]   = 0;
 
-            if (current_X_size + tlv_stream_size < max_tlvs_block_size)
+            s = ret[fragments_nr-1];
+
+            reserved_field = 0;
+            fragment_id    = fragments_nr-1;
+            flags          = 0;
+
+            // Set 'relay_indicator' flag (bit #6)
+            //
+            if (0xff == _relayed_CMDU[memory_structure->message_type])
             {
-                tlv_stop++;
+                // Special, case. Respect what the caller told us
+                //
+                flags |= memory_structure->relay_indicator << 6;
             }
             else
             {
-                // There is no space for more TLVs
+                // Use the fixed value for this type of message according to
+                // the standard
                 //
-                no_space = 1;
-                break;
+                flags |= _relayed_CMDU[memory_structure->message_type] << 6;
             }
 
-            current_X_size += tlv_stream_size;
-        }
-        if (tlv_start == tlv_stop)
-        {
-            if (1 == no_space)
+            _I1B(&memory_structure->message_version, &s);
+            _I1B(&reserved_field,                    &s);
+            _I2B(&memory_structure->message_type,    &s);
+            _I2B(&memory_structure->message_id,      &s);
+            _I1B(&fragment_id,                       &s);
+            indicators = s;  // 'last_fragment_indicator' is set at the end
+            _I1B(&flags,                             &s);
+
+            current_X_size = 0;
+
+            if (NULL != p && tlv_stream_size >= max_tlvs_block_size)
             {
-                // One *single* TLV does not fit in a fragment!
-                // This is an error... there is no way to split one single TLV into
-                // several fragments according to the standard.
+                // See above: a single TLV that does not fit in a fragment
                 //
                 error = 1;
                 break;
             }
-            else
-            {
-                // If we end up here, it means tlv_start = tlv_stop = 0 --> this
-                // CMDU contains no TLVs (which is something that can happen...
-                // for example, in the "topology query" CMDU).
-                // Just keep executing...
-            }
-        }
-
-        // Now that we know how many TLVs are going to be embedded inside this
-        // fragment (from 'tlv_start' up to -and not including- 'tlv_stop'),
-        // let's build it
-        //
-        fragments_nr++;
-
-        ret = (uint8_t **)memrealloc(ret, sizeof(uint8_t *) * (fragments_nr + 1));
-        ret[fragments_nr-1] = (uint8_t *)memalloc(MAX_NETWORK_SEGMENT_SIZE);
-        ret[fragments_nr]   = NULL;
-
-        *lens = (uint16_t *)memrealloc(*lens, sizeof(uint16_t *) * (fragments_nr + 1));
-        (*lens)[fragments_nr-1] = 0; // To be updated a few lines later
-        (*lens)[fragments_nr]   = 0;
-
-        s = ret[fragments_nr-1];
-
-        reserved_field = 0;
-        fragment_id    = fragments_nr-1;
-        indicators     = 0;
-
-        // Set 'last_fragment_indicator' flag (bit #7)
-        //
-        if (NULL == memory_structure->list_of_TLVs[tlv_stop])
-        {
-            indicators |= 1 << 7;
         }
 
-        // Set 'relay_indicator' flag (bit #6)
-        //
-        if (0xff == _relayed_CMDU[memory_structure->message_type])
+        if (NULL == p)
         {
-            // Special, case. Respect what the caller told us
-            //
-            indicators |= memory_structure->relay_indicator << 6;
-        }
-        else
-        {
-            // Use the fixed value for this type of message according to the
-            // standard
-            //
-            indicators |= _relayed_CMDU[memory_structure->message_type] << 6;
+            break;
         }
 
-        _I1B(&memory_structure->message_version, &s);
-        _I1B(&reserved_field,                    &s);
-        _I2B(&memory_structure->message_type,    &s);
-        _I2B(&memory_structure->message_id,      &s);
-        _I1B(&fragment_id,                       &s);
-        _I1B(&indicators,                        &s);
-
-        for (i=tlv_start; i<tlv_stop; i++)
+        if (tlv_stream_size != forge_1905_TLV_into_buffer(p, s, tlv_stream_size))
         {
-            uint8_t  *tlv_stream;
-            uint16_t  tlv_stream_size;
-
-            tlv_stream = forge_1905_TLV_from_structure(memory_structure->list_of_TLVs[i], &tlv_stream_size);
-
-            memcpy(s, tlv_stream, tlv_stream_size);
-            free(tlv_stream);
-
-            s += tlv_stream_size;
+            error = 1;
+            break;
         }
-
-        // Don't forget to add the last three octects representing the
-        // TLV_TYPE_END_OF_MESSAGE message
-        //
-        *s = 0x0; s++;
-        *s = 0x0; s++;
-        *s = 0x0; s++;
-
-        // Update the length return value
-        //
-        (*lens)[fragments_nr-1] = s - ret[fragments_nr-1];
-
-        // And advance the TLV pointer so that, if more fragments are needed,
-        // the next one starts where we have stopped.
-        //
-        tlv_start = tlv_stop;
-
-    } while(memory_structure->list_of_TLVs[tlv_start]);
+        s              += tlv_stream_size;
+        current_X_size += tlv_stream_size;
+    }
 
     // Finally! If we get this far without errors we are already done, otherwise
     // free everything and return NULL
@@ -1072,10 +1221,35 @@ uint8_t **forge_1905_CMDU_from_structure(const struct CMDU *memory_structure, ui
     if (0 != error)
     {
         free_1905_CMDU_packets(ret);
-        free(*lens);
+        memfree(*lens);
         return NULL;
     }
 
+    // Close the last fragment: set its 'last_fragment_indicator' flag (bit #7)
+    // and add the TLV_TYPE_END_OF_MESSAGE TLV
+    //
+    *indicators |= 1 << 7;
+
+    *s = 0x0; s++;
+    *s = 0x0; s++;
+    *s = 0x0; s++;
+
+    (*lens)[fragments_nr-1] = s - ret[fragments_nr-1];
+
+    return ret;
+}
+
+
+uint8_t **forge_1905_CMDU_from_structure_in_arena(const struct CMDU *memory_structure, uint16_t **lens,
+                                                  struct arena *arena)
+{
+    struct arena *previous;
+    uint8_t     **ret;
+
+    previous = arena_enter(arena);
+    ret = forge_1905_CMDU_from_structure(memory_structure, lens);
+    arena_leave(previous);
+
     return ret;
 }
 
@@ -1137,10 +1311,16 @@ void free_1905_CMDU_structure(struct CMDU *memory_structure)
             free_1905_TLV_structure(memory_structure->list_of_TLVs[i]);
             i++;
         }
-        free(memory_structure->list_of_TLVs);
+        memfree(memory_structure->list_of_TLVs);
     }
 
-    free(memory_structure);
+    // A CMDU parsed into an arena holds a reference to it. The arena is
+    // released (in one go) once the CMDU and all TLVs taken from it are freed.
+    //
+    if (!arena_drop(memory_structure))
+    {
+        free(memory_structure);
+    }
 
     return;
 }
@@ -1158,10 +1338,10 @@ void free_1905_CMDU_packets(uint8_t **packet_streams)
     i = 0;
     while (packet_streams[i])
     {
-        free(packet_streams[i]);
+        memfree(packet_streams[i]);
         i++;
     }
-    free(packet_streams);
+    memfree(packet_streams);
 
     return;
 }
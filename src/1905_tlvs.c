@@ -67,6 +67,10 @@
 #include <stdio.h>  // snprintf
 #include <ctype.h>  // isprint(), isascii()
 
+#ifdef TLV_CODEGEN
+#include "1905_tlvs_codegen.h"
+#endif
+
 
 // Buffer size to store a prefix string that will be used to show each
 // element of a structure on screen
@@ -89,10 +93,416 @@ static struct tlv_struct_description _supportedServiceDesc = {
         TLV_STRUCT_FIELD_SENTINEL,
     },
     .children = {NULL,},
+    TLV_STRUCT_CODEGEN(_supportedServiceDesc)
+};
+
+/** @} */
+
+
+/** @brief Support functions for deviceInformationType TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.5
+ *
+ * @{
+ */
+
+static const struct tlv_struct_description _localInterfaceEntriesDesc;
+
+/* The size of the media specific data is implied by the media type. */
+static uint8_t _localInterfaceMediaSpecificDataSize(uint16_t media_type)
+{
+    switch (media_type)
+    {
+        case MEDIA_TYPE_IEEE_802_11B_2_4_GHZ:
+        case MEDIA_TYPE_IEEE_802_11G_2_4_GHZ:
+        case MEDIA_TYPE_IEEE_802_11A_5_GHZ:
+        case MEDIA_TYPE_IEEE_802_11N_2_4_GHZ:
+        case MEDIA_TYPE_IEEE_802_11N_5_GHZ:
+        case MEDIA_TYPE_IEEE_802_11AC_5_GHZ:
+        case MEDIA_TYPE_IEEE_802_11AD_60_GHZ:
+        case MEDIA_TYPE_IEEE_802_11AF_GHZ:
+            return 10;
+        case MEDIA_TYPE_IEEE_1901_WAVELET:
+        case MEDIA_TYPE_IEEE_1901_FFT:
+            return 7;
+        default:
+            return 0;
+    }
+}
+
+static struct tlv_struct *_localInterfaceEntriesParse(const struct tlv_struct_description *desc, dlist_head *parent,
+                                                      const uint8_t **buffer, size_t *length)
+{
+    struct _localInterfaceEntries *self =
+            TLV_STRUCT_ALLOC(&_localInterfaceEntriesDesc, struct _localInterfaceEntries, s, parent);
+    uint8_t aux;
+
+    if (!tlv_struct_parse_field(&self->s, &desc->fields[0], buffer, length))
+        goto err_out;
+    if (!tlv_struct_parse_field(&self->s, &desc->fields[1], buffer, length))
+        goto err_out;
+    if (!tlv_struct_parse_field(&self->s, &desc->fields[2], buffer, length))
+        goto err_out;
+
+    if (self->media_specific_data_size != _localInterfaceMediaSpecificDataSize(self->media_type))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Malformed %s: %u bytes of media specific data for media type 0x%04x\n",
+                                      desc->name, self->media_specific_data_size, self->media_type);
+        goto err_out;
+    }
+
+    switch (self->media_specific_data_size)
+    {
+        case 10: /* IEEE 802.11 */
+            if (!_EnBL(buffer, self->media_specific_data.ieee80211.network_membership, 6, length))
+                goto err_out;
+            if (!_E1BL(buffer, &aux, length))
+                goto err_out;
+            self->media_specific_data.ieee80211.role = aux >> 4;
+            if (!_E1BL(buffer, &self->media_specific_data.ieee80211.ap_channel_band, length))
+                goto err_out;
+            if (!_E1BL(buffer, &self->media_specific_data.ieee80211.ap_channel_center_frequency_index_1, length))
+                goto err_out;
+            if (!_E1BL(buffer, &self->media_specific_data.ieee80211.ap_channel_center_frequency_index_2, length))
+                goto err_out;
+            break;
+
+        case 7: /* IEEE 1901 */
+            if (!_EnBL(buffer, self->media_specific_data.ieee1901.network_identifier, 7, length))
+                goto err_out;
+            break;
+
+        default:
+            break;
+    }
+
+    return &self->s;
+
+err_out:
+    dlist_remove(&self->s.h.l);
+    hlist_delete_item(&self->s.h);
+    return NULL;
+}
+
+static size_t _localInterfaceEntriesLength(const struct tlv_struct *item)
+{
+    const struct _localInterfaceEntries *self = container_of(item, const struct _localInterfaceEntries, s);
+    return 6 + 2 + 1 + self->media_specific_data_size;
+}
+
+static bool _localInterfaceEntriesForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    const struct _localInterfaceEntries *self = container_of(item, const struct _localInterfaceEntries, s);
+    uint8_t aux;
+
+    if (self->media_specific_data_size != _localInterfaceMediaSpecificDataSize(self->media_type))
+        return false;
+
+    if (!tlv_struct_forge_field(item, &item->desc->fields[0], buffer, length))
+        return false;
+    if (!tlv_struct_forge_field(item, &item->desc->fields[1], buffer, length))
+        return false;
+    if (!tlv_struct_forge_field(item, &item->desc->fields[2], buffer, length))
+        return false;
+
+    switch (self->media_specific_data_size)
+    {
+        case 10: /* IEEE 802.11 */
+            aux = self->media_specific_data.ieee80211.role << 4;
+            if (!_InBL(self->media_specific_data.ieee80211.network_membership, buffer, 6, length))
+                return false;
+            if (!_I1BL(&aux, buffer, length))
+                return false;
+            if (!_I1BL(&self->media_specific_data.ieee80211.ap_channel_band, buffer, length))
+                return false;
+            if (!_I1BL(&self->media_specific_data.ieee80211.ap_channel_center_frequency_index_1, buffer, length))
+                return false;
+            if (!_I1BL(&self->media_specific_data.ieee80211.ap_channel_center_frequency_index_2, buffer, length))
+                return false;
+            break;
+
+        case 7: /* IEEE 1901 */
+            if (!_InBL(self->media_specific_data.ieee1901.network_identifier, buffer, 7, length))
+                return false;
+            break;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+static void _localInterfaceEntriesPrint(const struct tlv_struct *item,
+                                        void (*write_function)(const char *fmt, ...),
+                                        const char *prefix)
+{
+    const struct _localInterfaceEntries *self = container_of(item, const struct _localInterfaceEntries, s);
+    const struct _ieee80211SpecificInformation *ieee80211 = &self->media_specific_data.ieee80211;
+    char new_prefix[MAX_PREFIX];
+    size_t i;
+
+    snprintf(new_prefix, sizeof(new_prefix)-1, "%s->", prefix);
+    new_prefix[MAX_PREFIX-1] = 0x0;
+
+    for (i = 0; i < 3; i++)
+    {
+        tlv_struct_print_field(item, &item->desc->fields[i], write_function, new_prefix);
+    }
+
+    switch (self->media_specific_data_size)
+    {
+        case 10: /* IEEE 802.11 */
+            tlv_struct_print_hex_field("network_membership", ieee80211->network_membership, 6,
+                                       write_function, new_prefix);
+            write_function("%srole: %u\n", new_prefix, ieee80211->role);
+            write_function("%sap_channel_band: %u\n", new_prefix, ieee80211->ap_channel_band);
+            write_function("%sap_channel_center_frequency_index_1: %u\n", new_prefix,
+                           ieee80211->ap_channel_center_frequency_index_1);
+            write_function("%sap_channel_center_frequency_index_2: %u\n", new_prefix,
+                           ieee80211->ap_channel_center_frequency_index_2);
+            break;
+
+        case 7: /* IEEE 1901 */
+            tlv_struct_print_hex_field("network_identifier", self->media_specific_data.ieee1901.network_identifier, 7,
+                                       write_function, new_prefix);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static const struct tlv_struct_description _localInterfaceEntriesDesc = {
+    .name = "local_interfaces",
+    .size = sizeof(struct _localInterfaceEntries),
+    .fields = {
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _localInterfaceEntries, mac_address, tlv_struct_print_format_mac),
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _localInterfaceEntries, media_type, tlv_struct_print_format_hex),
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _localInterfaceEntries, media_specific_data_size, tlv_struct_print_format_dec),
+        /* media_specific_data depends on media_type, so it is handled by the overridden functions. */
+        TLV_STRUCT_FIELD_SENTINEL,
+    },
+    .children = {NULL,},
+    .parse = _localInterfaceEntriesParse,
+    .length = _localInterfaceEntriesLength,
+    .forge = _localInterfaceEntriesForge,
+    .print = _localInterfaceEntriesPrint,
+    TLV_STRUCT_CODEGEN(_localInterfaceEntriesDesc)
+};
+
+struct _localInterfaceEntries *deviceInformationTypeTLVAddInterface(struct deviceInformationTypeTLV *a,
+                                                                    mac_address mac_address, uint16_t media_type)
+{
+    TLV_STRUCT_DECLARE_DEFAULT(ret, _localInterfaceEntries, &a->tlv);
+    memcpy(ret->mac_address, mac_address, 6);
+    ret->media_type = media_type;
+    ret->media_specific_data_size = _localInterfaceMediaSpecificDataSize(media_type);
+    return ret;
+}
+
+/** @} */
+
+/** @brief Support functions for deviceBridgingCapability TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.6
+ *
+ * @{
+ */
+
+static const struct tlv_struct_description _bridgingTupleMacEntriesDesc = {
+    .name = "bridging_tuple_macs",
+    .size = sizeof(struct _bridgingTupleMacEntries),
+    .fields = {
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _bridgingTupleMacEntries, mac_address, tlv_struct_print_format_mac),
+        TLV_STRUCT_FIELD_SENTINEL,
+    },
+    .children = {NULL,},
+    TLV_STRUCT_CODEGEN(_bridgingTupleMacEntriesDesc)
+};
+
+static const struct tlv_struct_description _bridgingTupleEntriesDesc = {
+    .name = "bridging_tuples",
+    .size = sizeof(struct _bridgingTupleEntries),
+    .fields = {
+        TLV_STRUCT_FIELD_SENTINEL,
+    },
+    .children = { &_bridgingTupleMacEntriesDesc, NULL, },
+    TLV_STRUCT_CODEGEN(_bridgingTupleEntriesDesc)
+};
+
+struct _bridgingTupleEntries *deviceBridgingCapabilityTLVAddTuple(struct deviceBridgingCapabilityTLV *a)
+{
+    TLV_STRUCT_DECLARE_DEFAULT(ret, _bridgingTupleEntries, &a->tlv);
+    return ret;
+}
+
+struct _bridgingTupleMacEntries *deviceBridgingCapabilityTupleAddMac(struct _bridgingTupleEntries *a,
+                                                                     mac_address mac_address)
+{
+    TLV_STRUCT_DECLARE_DEFAULT(ret, _bridgingTupleMacEntries, a);
+    memcpy(ret->mac_address, mac_address, 6);
+    return ret;
+}
+
+/** @} */
+
+/** @brief Support functions for non1905NeighborDeviceList TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.8
+ *
+ * There is no neighbor count: the neighbors fill the rest of the TLV.
+ *
+ * @{
+ */
+
+static const struct tlv_struct_description _non1905neighborEntriesDesc = {
+    .name = "non_1905_neighbors",
+    .size = sizeof(struct _non1905neighborEntries),
+    .fields = {
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _non1905neighborEntries, mac_address, tlv_struct_print_format_mac),
+        TLV_STRUCT_FIELD_SENTINEL,
+    },
+    .children = {NULL,},
+    TLV_STRUCT_CODEGEN(_non1905neighborEntriesDesc)
 };
 
+static struct tlv_struct *non1905NeighborDeviceListTLVParse(const struct tlv_struct_description *desc,
+                                                            dlist_head *parent,
+                                                            const uint8_t **buffer, size_t *length)
+{
+    struct non1905NeighborDeviceListTLV *self =
+            X1905_TLV_ALLOC(non1905NeighborDeviceList, TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST, parent);
+
+    if (!tlv_struct_parse_field(&self->tlv.s, &desc->fields[0], buffer, length))
+        goto err_out;
+    while (*length > 0)
+    {
+        mac_address neighbor;
+
+        if (!_EmBL(buffer, neighbor, length))
+            goto err_out;
+        non1905NeighborDeviceListTLVAddNeighbor(self, neighbor);
+    }
+
+    return &self->tlv.s;
+
+err_out:
+    hlist_delete_item(&self->tlv.s.h);
+    return NULL;
+}
+
+static size_t non1905NeighborDeviceListTLVLength(const struct tlv_struct *item)
+{
+    return 6 + 6 * dlist_count(&item->h.children[0]);
+}
+
+static bool non1905NeighborDeviceListTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    const struct _non1905neighborEntries *neighbor;
+
+    if (!tlv_struct_forge_field(item, &item->desc->fields[0], buffer, length))
+        return false;
+    hlist_for_each(neighbor, item->h.children[0], const struct _non1905neighborEntries, s.h)
+    {
+        if (!_ImBL(neighbor->mac_address, buffer, length))
+            return false;
+    }
+    return true;
+}
+
+struct _non1905neighborEntries *non1905NeighborDeviceListTLVAddNeighbor(struct non1905NeighborDeviceListTLV *a,
+                                                                        mac_address mac_address)
+{
+    TLV_STRUCT_DECLARE_DEFAULT(ret, _non1905neighborEntries, &a->tlv);
+    memcpy(ret->mac_address, mac_address, 6);
+    return ret;
+}
+
 /** @} */
 
+/** @brief Support functions for neighborDeviceList TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.9
+ *
+ * There is no neighbor count: the neighbors fill the rest of the TLV. The bridge flag is the most significant bit of
+ * the byte that follows each neighbor.
+ *
+ * @{
+ */
+
+static const struct tlv_struct_description _neighborEntriesDesc = {
+    .name = "neighbors",
+    .size = sizeof(struct _neighborEntries),
+    .fields = {
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _neighborEntries, mac_address, tlv_struct_print_format_mac),
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _neighborEntries, bridge_flag, tlv_struct_print_format_dec),
+        TLV_STRUCT_FIELD_SENTINEL,
+    },
+    .children = {NULL,},
+    TLV_STRUCT_CODEGEN(_neighborEntriesDesc)
+};
+
+static struct tlv_struct *neighborDeviceListTLVParse(const struct tlv_struct_description *desc, dlist_head *parent,
+                                                     const uint8_t **buffer, size_t *length)
+{
+    struct neighborDeviceListTLV *self =
+            X1905_TLV_ALLOC(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, parent);
+
+    if (!tlv_struct_parse_field(&self->tlv.s, &desc->fields[0], buffer, length))
+        goto err_out;
+    while (*length > 0)
+    {
+        mac_address neighbor;
+        uint8_t aux;
+
+        if (!_EmBL(buffer, neighbor, length))
+            goto err_out;
+        if (!_E1BL(buffer, &aux, length))
+            goto err_out;
+        neighborDeviceListTLVAddNeighbor(self, neighbor, (aux & 0x80) ? 1 : 0);
+    }
+
+    return &self->tlv.s;
+
+err_out:
+    hlist_delete_item(&self->tlv.s.h);
+    return NULL;
+}
+
+static size_t neighborDeviceListTLVLength(const struct tlv_struct *item)
+{
+    return 6 + 7 * dlist_count(&item->h.children[0]);
+}
+
+static bool neighborDeviceListTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    const struct _neighborEntries *neighbor;
+
+    if (!tlv_struct_forge_field(item, &item->desc->fields[0], buffer, length))
+        return false;
+    hlist_for_each(neighbor, item->h.children[0], const struct _neighborEntries, s.h)
+    {
+        uint8_t aux = (1 == neighbor->bridge_flag) ? 0x80 : 0;
+
+        if (!_ImBL(neighbor->mac_address, buffer, length))
+            return false;
+        if (!_I1BL(&aux, buffer, length))
+            return false;
+    }
+    return true;
+}
+
+struct _neighborEntries *neighborDeviceListTLVAddNeighbor(struct neighborDeviceListTLV *a,
+                                                          mac_address mac_address, uint8_t bridge_flag)
+{
+    TLV_STRUCT_DECLARE_DEFAULT(ret, _neighborEntries, &a->tlv);
+    memcpy(ret->mac_address, mac_address, 6);
+    ret->bridge_flag = bridge_flag;
+    return ret;
+}
+
+/** @} */
 
 /** @brief Support functions for linkMetricQuery TLV.
  *
@@ -238,70 +648,243 @@ static bool linkMetricQueryTLVForge(const struct tlv_struct *item, uint8_t **buf
 
 /** @} */
 
-/** @brief Support functions for vendorSpecific TLV.
+/** @brief Support functions for powerOffInterface TLV.
  *
- * See "IEEE Std 1905.1-2013" Section 6.4.2
+ * See "IEEE Std 1905.1-2013" Section 6.4.28
+ *
+ * The media specific bytes of an interface are stored right after its _powerOffInterfaceEntries, in the same
+ * allocation, so that deleting the TLV releases them too.
  *
  * @{
  */
 
-static struct tlv_struct *vendorSpecificTLVParse(const struct tlv_struct_description *desc, dlist_head *parent,
-                                                 const uint8_t **buffer, size_t *length)
+static const struct tlv_struct_description _powerOffInterfaceEntriesDesc;
+
+static struct _powerOffInterfaceEntries *_powerOffInterfaceEntriesAlloc(dlist_head *parent,
+                                                                        mac_address interface_address,
+                                                                        uint16_t media_type,
+                                                                        const uint8_t *oui, uint8_t variant_index,
+                                                                        uint8_t media_specific_bytes_nr,
+                                                                        const uint8_t *media_specific_bytes)
 {
-    struct vendorSpecificTLV *self = X1905_TLV_ALLOC(vendorSpecific, TLV_TYPE_VENDOR_SPECIFIC, parent);
+    struct _powerOffInterfaceEntries *ret =
+            container_of(hlist_alloc(sizeof(struct _powerOffInterfaceEntries) + media_specific_bytes_nr, parent),
+                         struct _powerOffInterfaceEntries, s.h);
+
+    ret->s.desc = &_powerOffInterfaceEntriesDesc;
+    memcpy(ret->interface_address, interface_address, 6);
+    ret->media_type = media_type;
+    memcpy(ret->generic_phy_common_data.oui, oui, 3);
+    ret->generic_phy_common_data.variant_index = variant_index;
+    ret->generic_phy_common_data.media_specific_bytes_nr = media_specific_bytes_nr;
+    if (media_specific_bytes_nr > 0)
+    {
+        ret->generic_phy_common_data.media_specific_bytes = (uint8_t *)(ret + 1);
+        memcpy(ret->generic_phy_common_data.media_specific_bytes, media_specific_bytes, media_specific_bytes_nr);
+    }
+    return ret;
+}
 
-    if (!_EnBL(buffer, self->vendorOUI, 3, length))
-        goto error_out;
-    /* m_nr is purely based in TLV length */
-    self->m_nr = (uint16_t) *length;
-    self->m = memalloc(self->m_nr);
-    if (!_EnBL(buffer, self->m, self->m_nr, length))
-        goto error_out;
+static struct tlv_struct *_powerOffInterfaceEntriesParse(const struct tlv_struct_description *desc,
+                                                         dlist_head *parent,
+                                                         const uint8_t **buffer, size_t *length)
+{
+    struct _powerOffInterfaceEntries *self;
+    mac_address interface_address;
+    uint16_t    media_type;
+    uint8_t     oui[3];
+    uint8_t     variant_index;
+    uint8_t     media_specific_bytes_nr;
+
+    /* The entry can only be allocated once the number of media specific bytes is known. */
+    if (!_EmBL(buffer, interface_address, length))
+        return NULL;
+    if (!_E2BL(buffer, &media_type, length))
+        return NULL;
+    if (!_EnBL(buffer, oui, 3, length))
+        return NULL;
+    if (!_E1BL(buffer, &variant_index, length))
+        return NULL;
+    if (!_E1BL(buffer, &media_specific_bytes_nr, length))
+        return NULL;
+    if (*length < media_specific_bytes_nr)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Malformed %s: %u media specific bytes but only %u left\n", desc->name,
+                                      media_specific_bytes_nr, (unsigned)*length);
+        return NULL;
+    }
 
-    return &self->tlv.s;
+    self = _powerOffInterfaceEntriesAlloc(parent, interface_address, media_type, oui, variant_index,
+                                          media_specific_bytes_nr, *buffer);
+    *buffer += media_specific_bytes_nr;
+    *length -= media_specific_bytes_nr;
 
-error_out:
-    hlist_delete_item(&self->tlv.s.h);
-    return NULL;
+    return &self->s;
 }
 
-static size_t vendorSpecificTLVLength(const struct tlv_struct *item)
+static size_t _powerOffInterfaceEntriesLength(const struct tlv_struct *item)
 {
-    const struct vendorSpecificTLV *self = container_of(item, const struct vendorSpecificTLV, tlv.s);
-    return 3 + self->m_nr;
+    const struct _powerOffInterfaceEntries *self = container_of(item, const struct _powerOffInterfaceEntries, s);
+    return 6 + 2 + 3 + 1 + 1 + self->generic_phy_common_data.media_specific_bytes_nr;
 }
 
-static bool vendorSpecificTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+static bool _powerOffInterfaceEntriesForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
 {
-    const struct vendorSpecificTLV *self = container_of(item, const struct vendorSpecificTLV, tlv.s);
+    const struct _powerOffInterfaceEntries *self = container_of(item, const struct _powerOffInterfaceEntries, s);
 
-    if (!_InBL(self->vendorOUI, buffer, 3, length))
+    if (!_ImBL(self->interface_address, buffer, length))
         return false;
-    if (!_InBL(self->m, buffer, self->m_nr, length))
+    if (!_I2BL(&self->media_type, buffer, length))
+        return false;
+    if (!_InBL(self->generic_phy_common_data.oui, buffer, 3, length))
+        return false;
+    if (!_I1BL(&self->generic_phy_common_data.variant_index, buffer, length))
+        return false;
+    if (!_I1BL(&self->generic_phy_common_data.media_specific_bytes_nr, buffer, length))
+        return false;
+    if (!_InBL(self->generic_phy_common_data.media_specific_bytes, buffer,
+               self->generic_phy_common_data.media_specific_bytes_nr, length))
         return false;
     return true;
 }
 
-static void vendorSpecificTLVFree(struct tlv_struct *item)
+static void _powerOffInterfaceEntriesPrint(const struct tlv_struct *item,
+                                           void (*write_function)(const char *fmt, ...),
+                                           const char *prefix)
 {
-    struct vendorSpecificTLV *self = container_of(item, struct vendorSpecificTLV, tlv.s);
-    free(self->m);
-    hlist_delete_item(&item->h);
+    const struct _powerOffInterfaceEntries *self = container_of(item, const struct _powerOffInterfaceEntries, s);
+    char new_prefix[MAX_PREFIX];
+
+    snprintf(new_prefix, sizeof(new_prefix)-1, "%s->", prefix);
+    new_prefix[MAX_PREFIX-1] = 0x0;
+
+    tlv_struct_print_field(item, &item->desc->fields[0], write_function, new_prefix);
+    tlv_struct_print_field(item, &item->desc->fields[1], write_function, new_prefix);
+    tlv_struct_print_hex_field("oui", self->generic_phy_common_data.oui, 3, write_function, new_prefix);
+    write_function("%svariant_index: %u\n", new_prefix, self->generic_phy_common_data.variant_index);
+    tlv_struct_print_hex_field("media_specific_bytes", self->generic_phy_common_data.media_specific_bytes,
+                               self->generic_phy_common_data.media_specific_bytes_nr, write_function, new_prefix);
 }
 
-static void vendorSpecificTLVPrint(const struct tlv_struct *item,
-                                   void (*write_function)(const char *fmt, ...),
-                                   const char *prefix)
+static int _powerOffInterfaceEntriesCompare(const struct tlv_struct *item1, const struct tlv_struct *item2)
 {
-    const struct vendorSpecificTLV *self = container_of(item, const struct vendorSpecificTLV, tlv.s);
-    tlv_struct_print_field(item, &item->desc->fields[0], write_function, prefix);
-    tlv_struct_print_field(item, &item->desc->fields[1], write_function, prefix);
-    tlv_struct_print_hex_field("m", self->m, self->m_nr, write_function, prefix);
-}
+    const struct _powerOffInterfaceEntries *self1 = container_of(item1, const struct _powerOffInterfaceEntries, s);
+    const struct _powerOffInterfaceEntries *self2 = container_of(item2, const struct _powerOffInterfaceEntries, s);
+    int ret;
 
-static int vendorSpecificTLVCompare(const struct tlv_struct *item1, const struct tlv_struct *item2)
-{
-    int ret = 0;
+    ret = memcmp(self1->interface_address, self2->interface_address, 6);
+    if (ret != 0)
+        return ret;
+    if (self1->media_type != self2->media_type)
+        return self1->media_type < self2->media_type ? -1 : 1;
+    ret = memcmp(self1->generic_phy_common_data.oui, self2->generic_phy_common_data.oui, 3);
+    if (ret != 0)
+        return ret;
+    if (self1->generic_phy_common_data.variant_index != self2->generic_phy_common_data.variant_index)
+        return self1->generic_phy_common_data.variant_index < self2->generic_phy_common_data.variant_index ? -1 : 1;
+    if (self1->generic_phy_common_data.media_specific_bytes_nr != self2->generic_phy_common_data.media_specific_bytes_nr)
+        return self1->generic_phy_common_data.media_specific_bytes_nr <
+               self2->generic_phy_common_data.media_specific_bytes_nr ? -1 : 1;
+    return memcmp(self1->generic_phy_common_data.media_specific_bytes,
+                  self2->generic_phy_common_data.media_specific_bytes,
+                  self1->generic_phy_common_data.media_specific_bytes_nr);
+}
+
+static const struct tlv_struct_description _powerOffInterfaceEntriesDesc = {
+    .name = "power_off_interfaces",
+    .size = sizeof(struct _powerOffInterfaceEntries),
+    .fields = {
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _powerOffInterfaceEntries, interface_address, tlv_struct_print_format_mac),
+        TLV_STRUCT_FIELD_DESCRIPTION(struct _powerOffInterfaceEntries, media_type, tlv_struct_print_format_hex),
+        /* generic_phy_common_data points to the extra bytes of the allocation, so it is handled by the overridden
+         * functions. */
+        TLV_STRUCT_FIELD_SENTINEL,
+    },
+    .children = {NULL,},
+    .parse = _powerOffInterfaceEntriesParse,
+    .length = _powerOffInterfaceEntriesLength,
+    .forge = _powerOffInterfaceEntriesForge,
+    .print = _powerOffInterfaceEntriesPrint,
+    .compare = _powerOffInterfaceEntriesCompare,
+    TLV_STRUCT_CODEGEN(_powerOffInterfaceEntriesDesc)
+};
+
+struct _powerOffInterfaceEntries *powerOffInterfaceTLVAddInterface(struct powerOffInterfaceTLV *a,
+                                                                   mac_address interface_address, uint16_t media_type,
+                                                                   const uint8_t *oui, uint8_t variant_index,
+                                                                   uint8_t media_specific_bytes_nr,
+                                                                   const uint8_t *media_specific_bytes)
+{
+    return _powerOffInterfaceEntriesAlloc(&a->tlv.s.h.children[0], interface_address, media_type, oui, variant_index,
+                                          media_specific_bytes_nr, media_specific_bytes);
+}
+
+/** @} */
+
+/** @brief Support functions for vendorSpecific TLV.
+ *
+ * See "IEEE Std 1905.1-2013" Section 6.4.2
+ *
+ * @{
+ */
+
+static struct tlv_struct *vendorSpecificTLVParse(const struct tlv_struct_description *desc, dlist_head *parent,
+                                                 const uint8_t **buffer, size_t *length)
+{
+    struct vendorSpecificTLV *self = X1905_TLV_ALLOC(vendorSpecific, TLV_TYPE_VENDOR_SPECIFIC, parent);
+
+    if (!_EnBL(buffer, self->vendorOUI, 3, length))
+        goto error_out;
+    /* m_nr is purely based in TLV length */
+    self->m_nr = (uint16_t) *length;
+    self->m = memalloc(self->m_nr);
+    if (!_EnBL(buffer, self->m, self->m_nr, length))
+        goto error_out;
+
+    return &self->tlv.s;
+
+error_out:
+    hlist_delete_item(&self->tlv.s.h);
+    return NULL;
+}
+
+static size_t vendorSpecificTLVLength(const struct tlv_struct *item)
+{
+    const struct vendorSpecificTLV *self = container_of(item, const struct vendorSpecificTLV, tlv.s);
+    return 3 + self->m_nr;
+}
+
+static bool vendorSpecificTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    const struct vendorSpecificTLV *self = container_of(item, const struct vendorSpecificTLV, tlv.s);
+
+    if (!_InBL(self->vendorOUI, buffer, 3, length))
+        return false;
+    if (!_InBL(self->m, buffer, self->m_nr, length))
+        return false;
+    return true;
+}
+
+static void vendorSpecificTLVFree(struct tlv_struct *item)
+{
+    struct vendorSpecificTLV *self = container_of(item, struct vendorSpecificTLV, tlv.s);
+    memfree(self->m);
+    hlist_delete_item(&item->h);
+}
+
+static void vendorSpecificTLVPrint(const struct tlv_struct *item,
+                                   void (*write_function)(const char *fmt, ...),
+                                   const char *prefix)
+{
+    const struct vendorSpecificTLV *self = container_of(item, const struct vendorSpecificTLV, tlv.s);
+    tlv_struct_print_field(item, &item->desc->fields[0], write_function, prefix);
+    tlv_struct_print_field(item, &item->desc->fields[1], write_function, prefix);
+    tlv_struct_print_hex_field("m", self->m, self->m_nr, write_function, prefix);
+}
+
+static int vendorSpecificTLVCompare(const struct tlv_struct *item1, const struct tlv_struct *item2)
+{
+    int ret = 0;
     const struct vendorSpecificTLV *self1 = container_of(item1, const struct vendorSpecificTLV, tlv.s);
     const struct vendorSpecificTLV *self2 = container_of(item2, const struct vendorSpecificTLV, tlv.s);
 
@@ -318,6 +901,62 @@ static int vendorSpecificTLVCompare(const struct tlv_struct *item1, const struct
 
 /** @} */
 
+/** @brief Support functions for the single-value 1905 TLVs.
+ *
+ * These TLVs are parsed, printed and compared generically, but the standard only allows a few values for them, so
+ * forging a structure with any other value fails.
+ *
+ * See "IEEE Std 1905.1-2013" Sections 6.4.13 to 6.4.17 and 6.4.27
+ *
+ * @{
+ */
+
+static bool _forgeEnumField(const struct tlv_struct *item, const uint8_t *allowed, size_t allowed_nr,
+                            uint8_t **buffer, size_t *length)
+{
+    const struct tlv_struct_field_description *field = &item->desc->fields[0];
+    uint8_t value = *((const uint8_t *)item + field->offset);
+    size_t i;
+
+    for (i = 0; i < allowed_nr; i++)
+    {
+        if (value == allowed[i])
+        {
+            return tlv_struct_forge_field(item, field, buffer, length);
+        }
+    }
+    PLATFORM_PRINTF_DEBUG_WARNING("Malformed %s TLV: invalid %s %u\n", item->desc->name, field->name, value);
+    return false;
+}
+
+static bool linkMetricResultCodeTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    static const uint8_t allowed[] = {LINK_METRIC_RESULT_CODE_TLV_INVALID_NEIGHBOR};
+    return _forgeEnumField(item, allowed, ARRAY_SIZE(allowed), buffer, length);
+}
+
+static bool roleTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    static const uint8_t allowed[] = {IEEE80211_ROLE_REGISTRAR};
+    return _forgeEnumField(item, allowed, ARRAY_SIZE(allowed), buffer, length);
+}
+
+static bool freqBandTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    static const uint8_t allowed[] = {
+        IEEE80211_FREQUENCY_BAND_2_4_GHZ, IEEE80211_FREQUENCY_BAND_5_GHZ, IEEE80211_FREQUENCY_BAND_60_GHZ,
+    };
+    return _forgeEnumField(item, allowed, ARRAY_SIZE(allowed), buffer, length);
+}
+
+static bool x1905ProfileVersionTLVForge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
+{
+    static const uint8_t allowed[] = {PROFILE_1905_1, PROFILE_1905_1A};
+    return _forgeEnumField(item, allowed, ARRAY_SIZE(allowed), buffer, length);
+}
+
+/** @} */
+
 /** @brief Support functions for apOperationalBss TLV.
  *
  * See "Multi-AP Specification Version 1.0" Section 17.2.1
@@ -348,6 +987,7 @@ static struct tlv_struct *_apOperationalBssInfoParse(const struct tlv_struct_des
     return &bss_info->s;
 
 error_out:
+    dlist_remove(&bss_info->s.h.l);
     hlist_delete_item(&bss_info->s.h);
     return NULL;
 
@@ -411,6 +1051,7 @@ static const struct tlv_struct_description _apOperationalBssInfoDesc = {
     .length = _apOperationalBssInfoLength,
     .forge = _apOperationalBssInfoForge,
     .print = _apOperationalBssInfoPrint,
+    TLV_STRUCT_CODEGEN(_apOperationalBssInfoDesc)
 };
 
 static const struct tlv_struct_description _apOperationalBssRadioDesc = {
@@ -421,6 +1062,7 @@ static const struct tlv_struct_description _apOperationalBssRadioDesc = {
         TLV_STRUCT_FIELD_SENTINEL,
     },
     .children = { &_apOperationalBssInfoDesc, NULL, },
+    TLV_STRUCT_CODEGEN(_apOperationalBssRadioDesc)
 };
 
 struct _apOperationalBssRadio *apOperationalBssTLVAddRadio(struct apOperationalBssTLV* a, mac_address radio_uid)
@@ -460,6 +1102,7 @@ static const struct tlv_struct_description _associatedClientInfoDesc = {
         TLV_STRUCT_FIELD_SENTINEL,
     },
     .children = {NULL,},
+    TLV_STRUCT_CODEGEN(_associatedClientInfoDesc)
 };
 
 static const struct tlv_struct_description _associatedClientsBssInfoDesc = {
@@ -472,7 +1115,8 @@ static const struct tlv_struct_description _associatedClientsBssInfoDesc = {
     .children = {
         &_associatedClientInfoDesc,
         NULL
-    }
+    },
+    TLV_STRUCT_CODEGEN(_associatedClientsBssInfoDesc)
 };
 
 
@@ -517,6 +1161,7 @@ static const struct tlv_struct_description _apRadioBasicCapabilitiesChannelDesc
         TLV_STRUCT_FIELD_SENTINEL,
     },
     .children = {NULL,},
+    TLV_STRUCT_CODEGEN(_apRadioBasicCapabilitiesChannelDesc)
 };
 
 static const struct tlv_struct_description _apRadioBasicCapabilitiesClassDesc = {
@@ -528,6 +1173,7 @@ static const struct tlv_struct_description _apRadioBasicCapabilitiesClassDesc =
         TLV_STRUCT_FIELD_SENTINEL,
     },
     .children = { &_apRadioBasicCapabilitiesChannelDesc, NULL, },
+    TLV_STRUCT_CODEGEN(_apRadioBasicCapabilitiesClassDesc)
 };
 
 struct _apRadioBasicCapabilitiesChannel* apRadioBasicCapabilitiesTLVAddChannel(
@@ -578,6 +1224,22 @@ static tlv_defs_t tlv_1905_defs = {
     TLV_DEF_ENTRY_1FIELDS(macAddressType,TLV_TYPE_MAC_ADDRESS_TYPE, NULL,
         mac_address, tlv_struct_print_format_mac,
     ),
+    TLV_DEF_ENTRY_1FIELDS(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, &_localInterfaceEntriesDesc,
+        al_mac_address, tlv_struct_print_format_mac,
+    ),
+    TLV_DEF_ENTRY_0FIELDS(deviceBridgingCapability, TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES, &_bridgingTupleEntriesDesc, ),
+    TLV_DEF_ENTRY_1FIELDS(non1905NeighborDeviceList, TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST, &_non1905neighborEntriesDesc,
+        local_mac_address, tlv_struct_print_format_mac,
+        .parse = non1905NeighborDeviceListTLVParse,
+        .length = non1905NeighborDeviceListTLVLength,
+        .forge = non1905NeighborDeviceListTLVForge,
+    ),
+    TLV_DEF_ENTRY_1FIELDS(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, &_neighborEntriesDesc,
+        local_mac_address, tlv_struct_print_format_mac,
+        .parse = neighborDeviceListTLVParse,
+        .length = neighborDeviceListTLVLength,
+        .forge = neighborDeviceListTLVForge,
+    ),
     TLV_DEF_ENTRY_3FIELDS(linkMetricQuery,TLV_TYPE_LINK_METRIC_QUERY, NULL,
         destination, tlv_struct_print_format_hex,
         specific_neighbor, tlv_struct_print_format_mac,
@@ -585,6 +1247,42 @@ static tlv_defs_t tlv_1905_defs = {
         .parse = linkMetricQueryTLVParse,
         .forge = linkMetricQueryTLVForge,
     ),
+    TLV_DEF_ENTRY_1FIELDS(linkMetricResultCode, TLV_TYPE_LINK_METRIC_RESULT_CODE, NULL,
+        result_code, tlv_struct_print_format_dec,
+        .forge = linkMetricResultCodeTLVForge,
+    ),
+    TLV_DEF_ENTRY_1FIELDS(searchedRole, TLV_TYPE_SEARCHED_ROLE, NULL,
+        role, tlv_struct_print_format_dec,
+        .forge = roleTLVForge,
+    ),
+    TLV_DEF_ENTRY_1FIELDS(autoconfigFreqBand, TLV_TYPE_AUTOCONFIG_FREQ_BAND, NULL,
+        freq_band, tlv_struct_print_format_dec,
+        .forge = freqBandTLVForge,
+    ),
+    TLV_DEF_ENTRY_1FIELDS(supportedRole, TLV_TYPE_SUPPORTED_ROLE, NULL,
+        role, tlv_struct_print_format_dec,
+        .forge = roleTLVForge,
+    ),
+    TLV_DEF_ENTRY_1FIELDS(supportedFreqBand, TLV_TYPE_SUPPORTED_FREQ_BAND, NULL,
+        freq_band, tlv_struct_print_format_dec,
+        .forge = freqBandTLVForge,
+    ),
+    TLV_DEF_ENTRY_4FIELDS(pushButtonJoinNotification, TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION, NULL,
+        al_mac_address,     tlv_struct_print_format_mac,
+        message_identifier, tlv_struct_print_format_unsigned,
+        mac_address,        tlv_struct_print_format_mac,
+        new_mac_address,    tlv_struct_print_format_mac,
+    ),
+    TLV_DEF_ENTRY_3FIELDS(deviceIdentificationType, TLV_TYPE_DEVICE_IDENTIFICATION, NULL,
+        friendly_name,      tlv_struct_print_format_string,
+        manufacturer_name,  tlv_struct_print_format_string,
+        manufacturer_model, tlv_struct_print_format_string,
+    ),
+    TLV_DEF_ENTRY_1FIELDS(x1905ProfileVersion, TLV_TYPE_1905_PROFILE_VERSION, NULL,
+        profile, tlv_struct_print_format_dec,
+        .forge = x1905ProfileVersionTLVForge,
+    ),
+    TLV_DEF_ENTRY_0FIELDS(powerOffInterface, TLV_TYPE_POWER_OFF_INTERFACE, &_powerOffInterfaceEntriesDesc, ),
     TLV_DEF_ENTRY_0FIELDS(supportedService, TLV_TYPE_SUPPORTED_SERVICE, &_supportedServiceDesc, ),
     /* Searched service is exactly the same as supported service, so reuse the functions. Will be printed with the
      * wrong name, but who cares. */
@@ -608,6 +1306,11 @@ struct tlv *x1905TLVAlloc(dlist_head *parent, uint8_t type)
     return ret;
 }
 
+const struct tlv_def *x1905TLVFindDef(uint8_t type)
+{
+    return tlv_find_def(tlv_1905_defs, type);
+}
+
 struct linkMetricQueryTLV *linkMetricQueryTLVAllocAll(dlist_head *parent, uint8_t link_metrics_type)
 {
     TLV_DECLARE(ret, tlv_1905_defs, linkMetricQuery, TLV_TYPE_LINK_METRIC_QUERY, parent);
@@ -672,685 +1375,601 @@ struct tlv *parse_1905_TLV_from_packet(const uint8_t *packet_stream)
     //
     switch (*packet_stream)
     {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
+        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.5"
+            // "IEEE Std 1905.1-2013 Section 6.4.11"
 
-            struct deviceInformationTypeTLV  *ret;
+            struct transmitterLinkMetricTLV  *ret;
 
             uint16_t len;
             uint8_t  i;
 
-            ret = (struct deviceInformationTypeTLV *)memalloc(sizeof(struct deviceInformationTypeTLV));
+            ret = (struct transmitterLinkMetricTLV *)memalloc(sizeof(struct transmitterLinkMetricTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            ret->tlv.type = TLV_TYPE_DEVICE_INFORMATION_TYPE;
-
-            _EnB(&p,  ret->al_mac_address, 6);
-            _E1B(&p, &ret->local_interfaces_nr);
+            // According to the standard, the length *must* be "12+29*n" where
+            // "n" is "1" or greater
+            //
+            if ((12+29*1) > len)
+            {
+                // Malformed packet
+                //
+                memfree(ret);
+                return NULL;
+            }
+            if (0 != (len-12)%29)
+            {
+                // Malformed packet
+                //
+                memfree(ret);
+                return NULL;
+            }
 
-            ret->local_interfaces = (struct _localInterfaceEntries *)memalloc(sizeof(struct _localInterfaceEntries) * ret->local_interfaces_nr);
+            ret->tlv.type = TLV_TYPE_TRANSMITTER_LINK_METRIC;
 
-            for (i=0; i < ret->local_interfaces_nr; i++)
-            {
-                _EnB(&p,  ret->local_interfaces[i].mac_address, 6);
-                _E2B(&p, &ret->local_interfaces[i].media_type);
-                _E1B(&p, &ret->local_interfaces[i].media_specific_data_size);
+            _EnB(&p, ret->local_al_address,    6);
+            _EnB(&p, ret->neighbor_al_address, 6);
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == ret->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == ret->local_interfaces[i].media_type)
-                   )
-                {
-                    uint8_t aux;
+            ret->transmitter_link_metrics_nr = (len-12)/29;
 
-                    if (10 != ret->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->local_interfaces);
-                        free(ret);
-                        return NULL;
-                    }
+            ret->transmitter_link_metrics = (struct _transmitterLinkMetricEntries *)memalloc(sizeof(struct _transmitterLinkMetricEntries) * ret->transmitter_link_metrics_nr);
 
-                    _EnB(&p, ret->local_interfaces[i].media_specific_data.ieee80211.network_membership, 6);
-                    _E1B(&p, &aux);
-                    ret->local_interfaces[i].media_specific_data.ieee80211.role = aux >> 4;
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band);
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
+            for (i=0; i < ret->transmitter_link_metrics_nr; i++)
+            {
+                _EnB(&p,  ret->transmitter_link_metrics[i].local_interface_address,    6);
+                _EnB(&p,  ret->transmitter_link_metrics[i].neighbor_interface_address, 6);
 
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == ret->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == ret->local_interfaces[i].media_type)
-                        )
-                {
-                    if (7 != ret->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->local_interfaces);
-                        free(ret);
-                        return NULL;
-                    }
-                    _EnB(&p, ret->local_interfaces[i].media_specific_data.ieee1901.network_identifier, 7);
-                }
-                else
-                {
-                    if (0 != ret->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->local_interfaces);
-                        free(ret);
-                        return NULL;
-                    }
-                }
+                _E2B(&p, &ret->transmitter_link_metrics[i].intf_type);
+                _E1B(&p, &ret->transmitter_link_metrics[i].bridge_flag);
+                _E4B(&p, &ret->transmitter_link_metrics[i].packet_errors);
+                _E4B(&p, &ret->transmitter_link_metrics[i].transmitted_packets);
+                _E2B(&p, &ret->transmitter_link_metrics[i].mac_throughput_capacity);
+                _E2B(&p, &ret->transmitter_link_metrics[i].link_availability);
+                _E2B(&p, &ret->transmitter_link_metrics[i].phy_rate);
             }
 
             if (p - (packet_stream+3) != len)
             {
                 // Malformed packet
                 //
-                free(ret->local_interfaces);
-                free(ret);
+                memfree(ret->transmitter_link_metrics);
+                memfree(ret);
                 return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
+        case TLV_TYPE_RECEIVER_LINK_METRIC:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.6"
+            // "IEEE Std 1905.1-2013 Section 6.4.12"
 
-            struct deviceBridgingCapabilityTLV  *ret;
+            struct receiverLinkMetricTLV  *ret;
 
             uint16_t len;
-            uint8_t  i, j;
+            uint8_t  i;
 
-            ret = (struct deviceBridgingCapabilityTLV *)memalloc(sizeof(struct deviceBridgingCapabilityTLV));
+            ret = (struct receiverLinkMetricTLV *)memalloc(sizeof(struct receiverLinkMetricTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            ret->tlv.type = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES;
-
-            if (0 == len)
+            // According to the standard, the length *must* be "12+23*n" where
+            // "n" is "1" or greater
+            //
+            if ((12+23*1) > len)
             {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // length should be "1" (which is the length of the next field,
-                // that would containing a "zero", indicating the number of
-                // bridging tuples).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no bridging tuples", we
-                // will also accept this type of "malformed" packet.
+                // Malformed packet
                 //
-                ret->bridging_tuples_nr = 0;
-                return &ret->tlv;
-#else
-                free(ret);
+                memfree(ret);
+                return NULL;
+            }
+            if (0 != (len-12)%23)
+            {
+                // Malformed packet
+                //
+                memfree(ret);
                 return NULL;
-#endif
             }
 
-            _E1B(&p, &ret->bridging_tuples_nr);
+            ret->tlv.type = TLV_TYPE_RECEIVER_LINK_METRIC;
 
-            if (ret->bridging_tuples_nr > 0)
-            {
-                ret->bridging_tuples = (struct _bridgingTupleEntries *)memalloc(sizeof(struct _bridgingTupleEntries) * ret->bridging_tuples_nr);
+            _EnB(&p, ret->local_al_address,    6);
+            _EnB(&p, ret->neighbor_al_address, 6);
 
-                for (i=0; i < ret->bridging_tuples_nr; i++)
-                {
-                    _E1B(&p, &ret->bridging_tuples[i].bridging_tuple_macs_nr);
+            ret->receiver_link_metrics_nr = (len-12)/23;
 
-                    if (ret->bridging_tuples[i].bridging_tuple_macs_nr > 0)
-                    {
-                        ret->bridging_tuples[i].bridging_tuple_macs = (struct _bridgingTupleMacEntries *)memalloc(sizeof(struct _bridgingTupleMacEntries) * ret->bridging_tuples[i].bridging_tuple_macs_nr);
+            ret->receiver_link_metrics = (struct _receiverLinkMetricEntries *)memalloc(sizeof(struct _receiverLinkMetricEntries) * ret->receiver_link_metrics_nr);
 
-                        for (j=0; j < ret->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                        {
-                            _EnB(&p, ret->bridging_tuples[i].bridging_tuple_macs[j].mac_address, 6);
-                        }
-                    }
-                }
+            for (i=0; i < ret->receiver_link_metrics_nr; i++)
+            {
+                _EnB(&p,  ret->receiver_link_metrics[i].local_interface_address,    6);
+                _EnB(&p,  ret->receiver_link_metrics[i].neighbor_interface_address, 6);
+
+                _E2B(&p, &ret->receiver_link_metrics[i].intf_type);
+                _E4B(&p, &ret->receiver_link_metrics[i].packet_errors);
+                _E4B(&p, &ret->receiver_link_metrics[i].packets_received);
+                _E1B(&p, &ret->receiver_link_metrics[i].rssi);
             }
 
             if (p - (packet_stream+3) != len)
             {
                 // Malformed packet
                 //
-                for (i=0; i < ret->bridging_tuples_nr; i++)
-                {
-                    free(ret->bridging_tuples[i].bridging_tuple_macs);
-                }
-                free(ret->bridging_tuples);
-                free(ret);
+                memfree(ret->receiver_link_metrics);
+                memfree(ret);
                 return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
+        case TLV_TYPE_WSC:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.8"
+            // "IEEE Std 1905.1-2013 Section 6.4.18"
 
-            struct non1905NeighborDeviceListTLV  *ret;
+            struct wscTLV  *ret;
 
             uint16_t len;
-            uint8_t  i;
 
-            ret = (struct non1905NeighborDeviceListTLV *)memalloc(sizeof(struct non1905NeighborDeviceListTLV));
+            ret = (struct wscTLV *)memalloc(sizeof(struct wscTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            // According to the standard, the length *must* be "6 + 6*n"
-            //
-            if (0 != ((len-6)%6))
+            ret->tlv.type       = TLV_TYPE_WSC;
+            ret->wsc_frame_size = len;
+
+            if (len>0)
             {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-            ret->tlv.type = TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST;
-
-            _EnB(&p,  ret->local_mac_address, 6);
-
-            ret->non_1905_neighbors_nr = (len-6)/6;
-
-            ret->non_1905_neighbors = (struct _non1905neighborEntries *)memalloc(sizeof(struct _non1905neighborEntries) * ret->non_1905_neighbors_nr);
-
-            for (i=0; i < ret->non_1905_neighbors_nr; i++)
-            {
-                _EnB(&p,  ret->non_1905_neighbors[i].mac_address, 6);
+                ret->wsc_frame      = (uint8_t *)memalloc(len);
+                _EnB(&p, ret->wsc_frame, len);
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
+        case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.9"
+            // "IEEE Std 1905.1-2013 Section 6.4.19"
 
-            struct neighborDeviceListTLV  *ret;
+            struct pushButtonEventNotificationTLV  *ret;
 
             uint16_t len;
-            uint8_t  i;
+            uint8_t i;
 
-            ret = (struct neighborDeviceListTLV *)memalloc(sizeof(struct neighborDeviceListTLV));
+            ret = (struct pushButtonEventNotificationTLV *)memalloc(sizeof(struct pushButtonEventNotificationTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            // According to the standard, the length *must* be "6 + 7*n"
-            // "6+1"
-            //
-            if (0 != ((len-6)%7))
+            ret->tlv.type = TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION;
+
+            if (0 == len)
             {
-                // Malformed packet
+#ifdef FIX_BROKEN_TLVS
+                // Malformed packet. Even if there are NO bridging tuples, the
+                // Malformed packet. Even if there are NO media types, the
+                // length should be "1" (which is the length of the next field,
+                // that would containing a "zero", indicating the number of
+                // media types).
+                // *However*, because at least one other implementation sets
+                // the 'length' to zero to indicate "no media types", we will
+                // also accept this type of "malformed" packet.
                 //
-                free(ret);
+                ret->media_types_nr = 0;
+                return &ret->tlv;
+#else
+                memfree(ret);
                 return NULL;
+#endif
             }
-            ret->tlv.type = TLV_TYPE_NEIGHBOR_DEVICE_LIST;
-
-            _EnB(&p,  ret->local_mac_address, 6);
 
-            ret->neighbors_nr = (len-6)/7;
+            _E1B(&p, &ret->media_types_nr);
 
-            ret->neighbors = (struct _neighborEntries *)memalloc(sizeof(struct _neighborEntries) * ret->neighbors_nr);
+            ret->media_types = (struct _mediaTypeEntries *)memalloc(sizeof(struct _mediaTypeEntries) * ret->media_types_nr);
 
-            for (i=0; i < ret->neighbors_nr; i++)
+            for (i=0; i < ret->media_types_nr; i++)
             {
-                uint8_t aux;
+                _E2B(&p, &ret->media_types[i].media_type);
+                _E1B(&p, &ret->media_types[i].media_specific_data_size);
+
+                if (
+                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == ret->media_types[i].media_type) ||
+                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == ret->media_types[i].media_type) ||
+                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == ret->media_types[i].media_type) ||
+                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == ret->media_types[i].media_type) ||
+                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == ret->media_types[i].media_type) ||
+                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == ret->media_types[i].media_type) ||
+                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == ret->media_types[i].media_type) ||
+                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == ret->media_types[i].media_type)
+                   )
+                {
+                    uint8_t aux;
+
+                    if (10 != ret->media_types[i].media_specific_data_size)
+                    {
+                        // Malformed packet
+                        //
+                        memfree(ret->media_types);
+                        memfree(ret);
+                        return NULL;
+                    }
 
-                _EnB(&p,  ret->neighbors[i].mac_address, 6);
-                _E1B(&p, &aux);
+                    _EnB(&p, ret->media_types[i].media_specific_data.ieee80211.network_membership, 6);
+                    _E1B(&p, &aux);
+                    ret->media_types[i].media_specific_data.ieee80211.role = aux >> 4;
+                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_band);
+                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
+                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
 
-                if (aux & 0x80)
+                }
+                else if (
+                          (MEDIA_TYPE_IEEE_1901_WAVELET == ret->media_types[i].media_type) ||
+                          (MEDIA_TYPE_IEEE_1901_FFT     == ret->media_types[i].media_type)
+                        )
                 {
-                    ret->neighbors[i].bridge_flag = 1;
+                    if (7 != ret->media_types[i].media_specific_data_size)
+                    {
+                        // Malformed packet
+                        //
+                        memfree(ret->media_types);
+                        memfree(ret);
+                        return NULL;
+                    }
+                    _EnB(&p, ret->media_types[i].media_specific_data.ieee1901.network_identifier, 7);
                 }
                 else
                 {
-                    ret->neighbors[i].bridge_flag = 0;
+                    if (0 != ret->media_types[i].media_specific_data_size)
+                    {
+                        // Malformed packet
+                        //
+                        memfree(ret->media_types);
+                        memfree(ret);
+                        return NULL;
+                    }
                 }
             }
 
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.11"
-
-            struct transmitterLinkMetricTLV  *ret;
-
-            uint16_t len;
-            uint8_t  i;
-
-            ret = (struct transmitterLinkMetricTLV *)memalloc(sizeof(struct transmitterLinkMetricTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            // According to the standard, the length *must* be "12+29*n" where
-            // "n" is "1" or greater
-            //
-            if ((12+29*1) > len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-            if (0 != (len-12)%29)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-
-            ret->tlv.type = TLV_TYPE_TRANSMITTER_LINK_METRIC;
-
-            _EnB(&p, ret->local_al_address,    6);
-            _EnB(&p, ret->neighbor_al_address, 6);
-
-            ret->transmitter_link_metrics_nr = (len-12)/29;
-
-            ret->transmitter_link_metrics = (struct _transmitterLinkMetricEntries *)memalloc(sizeof(struct _transmitterLinkMetricEntries) * ret->transmitter_link_metrics_nr);
-
-            for (i=0; i < ret->transmitter_link_metrics_nr; i++)
-            {
-                _EnB(&p,  ret->transmitter_link_metrics[i].local_interface_address,    6);
-                _EnB(&p,  ret->transmitter_link_metrics[i].neighbor_interface_address, 6);
-
-                _E2B(&p, &ret->transmitter_link_metrics[i].intf_type);
-                _E1B(&p, &ret->transmitter_link_metrics[i].bridge_flag);
-                _E4B(&p, &ret->transmitter_link_metrics[i].packet_errors);
-                _E4B(&p, &ret->transmitter_link_metrics[i].transmitted_packets);
-                _E2B(&p, &ret->transmitter_link_metrics[i].mac_throughput_capacity);
-                _E2B(&p, &ret->transmitter_link_metrics[i].link_availability);
-                _E2B(&p, &ret->transmitter_link_metrics[i].phy_rate);
-            }
-
             if (p - (packet_stream+3) != len)
             {
                 // Malformed packet
                 //
-                free(ret->transmitter_link_metrics);
-                free(ret);
+                memfree(ret->media_types);
+                memfree(ret);
                 return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_RECEIVER_LINK_METRIC:
+        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.12"
+            // "IEEE Std 1905.1-2013 Section 6.4.21"
 
-            struct receiverLinkMetricTLV  *ret;
+            struct genericPhyDeviceInformationTypeTLV  *ret;
 
             uint16_t len;
             uint8_t  i;
 
-            ret = (struct receiverLinkMetricTLV *)memalloc(sizeof(struct receiverLinkMetricTLV));
+            ret = (struct genericPhyDeviceInformationTypeTLV *)memalloc(sizeof(struct genericPhyDeviceInformationTypeTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            // According to the standard, the length *must* be "12+23*n" where
-            // "n" is "1" or greater
-            //
-            if ((12+23*1) > len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-            if (0 != (len-12)%23)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-
-            ret->tlv.type = TLV_TYPE_RECEIVER_LINK_METRIC;
+            ret->tlv.type = TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION;
 
-            _EnB(&p, ret->local_al_address,    6);
-            _EnB(&p, ret->neighbor_al_address, 6);
+            _EnB(&p,  ret->al_mac_address, 6);
+            _E1B(&p, &ret->local_interfaces_nr);
 
-            ret->receiver_link_metrics_nr = (len-12)/23;
+            if (ret->local_interfaces_nr > 0)
+            {
+                ret->local_interfaces = (struct _genericPhyDeviceEntries *)memalloc(sizeof(struct _genericPhyDeviceEntries) * ret->local_interfaces_nr);
 
-            ret->receiver_link_metrics = (struct _receiverLinkMetricEntries *)memalloc(sizeof(struct _receiverLinkMetricEntries) * ret->receiver_link_metrics_nr);
+                for (i=0; i < ret->local_interfaces_nr; i++)
+                {
+                    _EnB(&p,  ret->local_interfaces[i].local_interface_address,                 6);
+                    _EnB(&p,  ret->local_interfaces[i].generic_phy_common_data.oui,             3);
+                    _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.variant_index);
+                    _EnB(&p,  ret->local_interfaces[i].variant_name,                           32);
+                    _E1B(&p, &ret->local_interfaces[i].generic_phy_description_xml_url_len);
+                    _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
 
-            for (i=0; i < ret->receiver_link_metrics_nr; i++)
-            {
-                _EnB(&p,  ret->receiver_link_metrics[i].local_interface_address,    6);
-                _EnB(&p,  ret->receiver_link_metrics[i].neighbor_interface_address, 6);
+                    if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
+                    {
+                        ret->local_interfaces[i].generic_phy_description_xml_url = (char *)memalloc(ret->local_interfaces[i].generic_phy_description_xml_url_len);
+                        _EnB(&p, ret->local_interfaces[i].generic_phy_description_xml_url, ret->local_interfaces[i].generic_phy_description_xml_url_len);
+                    }
+                    else
+                    {
+                        ret->local_interfaces[i].generic_phy_description_xml_url = NULL;
+                    }
 
-                _E2B(&p, &ret->receiver_link_metrics[i].intf_type);
-                _E4B(&p, &ret->receiver_link_metrics[i].packet_errors);
-                _E4B(&p, &ret->receiver_link_metrics[i].packets_received);
-                _E1B(&p, &ret->receiver_link_metrics[i].rssi);
+                    if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
+                    {
+                        ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+                        _EnB(&p, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
+                    }
+                    else
+                    {
+                        ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes = NULL;
+                    }
+                }
             }
 
             if (p - (packet_stream+3) != len)
             {
                 // Malformed packet
                 //
-                free(ret->receiver_link_metrics);
-                free(ret);
+                for (i=0; i < ret->local_interfaces_nr; i++)
+                {
+                    if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
+                    {
+                        memfree(ret->local_interfaces[i].generic_phy_description_xml_url);
+                    }
+
+                    if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
+                    {
+                        memfree(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
+                    }
+                }
+                memfree(ret->local_interfaces);
+                memfree(ret);
                 return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
+        case TLV_TYPE_CONTROL_URL:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.13"
+            // "IEEE Std 1905.1-2013 Section 6.4.23"
 
-            struct linkMetricResultCodeTLV  *ret;
+            struct controlUrlTypeTLV  *ret;
 
             uint16_t len;
 
-            ret = (struct linkMetricResultCodeTLV *)memalloc(sizeof(struct linkMetricResultCodeTLV));
+            ret = (struct controlUrlTypeTLV *)memalloc(sizeof(struct controlUrlTypeTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
+            ret->tlv.type       = TLV_TYPE_CONTROL_URL;
+
+            if (len>0)
             {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
+                ret->url            = (char *)memalloc(len);
+                _EnB(&p, ret->url, len);
             }
 
-            ret->tlv.type = TLV_TYPE_LINK_METRIC_RESULT_CODE;
-
-            _E1B(&p, &ret->result_code);
-
             return &ret->tlv;
         }
 
-        case TLV_TYPE_SEARCHED_ROLE:
+        case TLV_TYPE_IPV4:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.14"
+            // "IEEE Std 1905.1-2013 Section 6.4.24"
 
-            struct searchedRoleTLV  *ret;
+            struct ipv4TypeTLV  *ret;
 
             uint16_t len;
+            uint8_t  i, j;
 
-            ret = (struct searchedRoleTLV *)memalloc(sizeof(struct searchedRoleTLV));
+            ret = (struct ipv4TypeTLV *)memalloc(sizeof(struct ipv4TypeTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-
-            ret->tlv.type = TLV_TYPE_SEARCHED_ROLE;
-
-            _E1B(&p, &ret->role);
-
-            return &ret->tlv;
-        }
+            ret->tlv.type = TLV_TYPE_IPV4;
 
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.15"
-
-            struct autoconfigFreqBandTLV  *ret;
-
-            uint16_t len;
-
-            ret = (struct autoconfigFreqBandTLV *)memalloc(sizeof(struct autoconfigFreqBandTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
+            if (0 == len)
             {
-                // Malformed packet
+#ifdef FIX_BROKEN_TLVS
+                // Malformed packet. Even if there are NO bridging tuples, the
+                // Malformed packet. Even if there are NO entris, the length
+                // should be "1" (which is the length of the next field, that
+                // would containing a "zero", indicating the number of
+                // entries).
+                // *However*, because at least one other implementation sets
+                // the 'length' to zero to indicate "no entries", we will also
+                // accept this type of "malformed" packet.
                 //
-                free(ret);
+                ret->ipv4_interfaces_nr = 0;
+                return &ret->tlv;
+#else
+                memfree(ret);
                 return NULL;
+#endif
             }
 
-            ret->tlv.type = TLV_TYPE_AUTOCONFIG_FREQ_BAND;
-
-            _E1B(&p, &ret->freq_band);
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_SUPPORTED_ROLE:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.16"
+            _E1B(&p, &ret->ipv4_interfaces_nr);
 
-            struct supportedRoleTLV  *ret;
+            if (ret->ipv4_interfaces_nr > 0)
+            {
+                ret->ipv4_interfaces = (struct _ipv4InterfaceEntries *)memalloc(sizeof(struct _ipv4InterfaceEntries) * ret->ipv4_interfaces_nr);
 
-            uint16_t len;
+                for (i=0; i < ret->ipv4_interfaces_nr; i++)
+                {
+                    _EnB(&p,  ret->ipv4_interfaces[i].mac_address, 6);
+                    _E1B(&p, &ret->ipv4_interfaces[i].ipv4_nr);
 
-            ret = (struct supportedRoleTLV *)memalloc(sizeof(struct supportedRoleTLV));
+                    if (ret->ipv4_interfaces[i].ipv4_nr > 0)
+                    {
+                        ret->ipv4_interfaces[i].ipv4 = (struct _ipv4Entries *)memalloc(sizeof(struct _ipv4Entries) * ret->ipv4_interfaces[i].ipv4_nr);
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+                        for (j=0; j < ret->ipv4_interfaces[i].ipv4_nr; j++)
+                        {
+                            _E1B(&p, &ret->ipv4_interfaces[i].ipv4[j].type);
+                            _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_address,     4);
+                            _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, 4);
+                        }
+                    }
+                }
+            }
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
+            if (p - (packet_stream+3) != len)
             {
                 // Malformed packet
                 //
-                free(ret);
+                for (i=0; i < ret->ipv4_interfaces_nr; i++)
+                {
+                    if (ret->ipv4_interfaces[i].ipv4_nr > 0)
+                    {
+                        memfree(ret->ipv4_interfaces[i].ipv4);
+                    }
+                }
+                memfree(ret->ipv4_interfaces);
+                memfree(ret);
                 return NULL;
             }
 
-            ret->tlv.type = TLV_TYPE_SUPPORTED_ROLE;
-
-            _E1B(&p, &ret->role);
-
             return &ret->tlv;
         }
 
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
+        case TLV_TYPE_IPV6:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.17"
+            // "IEEE Std 1905.1-2013 Section 6.4.25"
 
-            struct supportedFreqBandTLV  *ret;
+            struct ipv6TypeTLV  *ret;
 
             uint16_t len;
+            uint8_t  i, j;
 
-            ret = (struct supportedFreqBandTLV *)memalloc(sizeof(struct supportedFreqBandTLV));
+            ret = (struct ipv6TypeTLV *)memalloc(sizeof(struct ipv6TypeTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
+            ret->tlv.type = TLV_TYPE_IPV6;
+
+            if (0 == len)
             {
-                // Malformed packet
+#ifdef FIX_BROKEN_TLVS
+                // Malformed packet. Even if there are NO bridging tuples, the
+                // Malformed packet. Even if there are NO entris, the length
+                // should be "1" (which is the length of the next field, that
+                // would containing a "zero", indicating the number of
+                // entries).
+                // *However*, because at least one other implementation sets
+                // the 'length' to zero to indicate "no entries", we will also
+                // accept this type of "malformed" packet.
                 //
-                free(ret);
+                ret->ipv6_interfaces_nr = 0;
+                return &ret->tlv;
+#else
+                memfree(ret);
                 return NULL;
+#endif
             }
 
-            ret->tlv.type = TLV_TYPE_SUPPORTED_FREQ_BAND;
-
-            _E1B(&p, &ret->freq_band);
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_WSC:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.18"
-
-            struct wscTLV  *ret;
+            _E1B(&p, &ret->ipv6_interfaces_nr);
 
-            uint16_t len;
+            if (ret->ipv6_interfaces_nr > 0)
+            {
+                ret->ipv6_interfaces = (struct _ipv6InterfaceEntries *)memalloc(sizeof(struct _ipv6InterfaceEntries) * ret->ipv6_interfaces_nr);
 
-            ret = (struct wscTLV *)memalloc(sizeof(struct wscTLV));
+                for (i=0; i < ret->ipv6_interfaces_nr; i++)
+                {
+                    _EnB(&p,  ret->ipv6_interfaces[i].mac_address,              6);
+                    _EnB(&p,  ret->ipv6_interfaces[i].ipv6_link_local_address, 16);
+                    _E1B(&p, &ret->ipv6_interfaces[i].ipv6_nr);
 
-            p = packet_stream + 1;
-            _E2B(&p, &len);
+                    if (ret->ipv6_interfaces[i].ipv6_nr > 0)
+                    {
+                        ret->ipv6_interfaces[i].ipv6 = (struct _ipv6Entries *)memalloc(sizeof(struct _ipv6Entries) * ret->ipv6_interfaces[i].ipv6_nr);
 
-            ret->tlv.type       = TLV_TYPE_WSC;
-            ret->wsc_frame_size = len;
+                        for (j=0; j < ret->ipv6_interfaces[i].ipv6_nr; j++)
+                        {
+                            _E1B(&p, &ret->ipv6_interfaces[i].ipv6[j].type);
+                            _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address,        16);
+                            _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, 16);
+                        }
+                    }
+                }
+            }
 
-            if (len>0)
+            if (p - (packet_stream+3) != len)
             {
-                ret->wsc_frame      = (uint8_t *)memalloc(len);
-                _EnB(&p, ret->wsc_frame, len);
+                // Malformed packet
+                //
+                for (i=0; i < ret->ipv6_interfaces_nr; i++)
+                {
+                    if (ret->ipv6_interfaces[i].ipv6_nr > 0)
+                    {
+                        memfree(ret->ipv6_interfaces[i].ipv6);
+                    }
+                }
+                memfree(ret->ipv6_interfaces);
+                memfree(ret);
+                return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
+        case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.19"
+            // "IEEE Std 1905.1-2013 Section 6.4.26"
 
-            struct pushButtonEventNotificationTLV  *ret;
+            struct pushButtonGenericPhyEventNotificationTLV  *ret;
 
             uint16_t len;
-            uint8_t i;
+            uint8_t  i;
 
-            ret = (struct pushButtonEventNotificationTLV *)memalloc(sizeof(struct pushButtonEventNotificationTLV));
+            ret = (struct pushButtonGenericPhyEventNotificationTLV *)memalloc(sizeof(struct pushButtonGenericPhyEventNotificationTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            ret->tlv.type = TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION;
+            ret->tlv.type = TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION;
 
             if (0 == len)
             {
 #ifdef FIX_BROKEN_TLVS
                 // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO media types, the
-                // length should be "1" (which is the length of the next field,
-                // that would containing a "zero", indicating the number of
-                // media types).
+                // Malformed packet. Even if there are NO interfaces, the length
+                // should be "1" (which is the length of the next field, that
+                // would containing a "zero", indicating the number of
+                // interfaces).
                 // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no media types", we will
+                // the 'length' to zero to indicate "no interfaces", we will
                 // also accept this type of "malformed" packet.
                 //
-                ret->media_types_nr = 0;
+                ret->local_interfaces_nr = 0;
                 return &ret->tlv;
 #else
-                free(ret);
+                memfree(ret);
                 return NULL;
 #endif
             }
 
-            _E1B(&p, &ret->media_types_nr);
-
-            ret->media_types = (struct _mediaTypeEntries *)memalloc(sizeof(struct _mediaTypeEntries) * ret->media_types_nr);
+            _E1B(&p, &ret->local_interfaces_nr);
 
-            for (i=0; i < ret->media_types_nr; i++)
+            if (ret->local_interfaces_nr > 0)
             {
-                _E2B(&p, &ret->media_types[i].media_type);
-                _E1B(&p, &ret->media_types[i].media_specific_data_size);
+                ret->local_interfaces = (struct _genericPhyCommonData *)memalloc(sizeof(struct _genericPhyCommonData) * ret->local_interfaces_nr);
 
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == ret->media_types[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == ret->media_types[i].media_type)
-                   )
+                for (i=0; i < ret->local_interfaces_nr; i++)
                 {
-                    uint8_t aux;
-
-                    if (10 != ret->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->media_types);
-                        free(ret);
-                        return NULL;
-                    }
-
-                    _EnB(&p, ret->media_types[i].media_specific_data.ieee80211.network_membership, 6);
-                    _E1B(&p, &aux);
-                    ret->media_types[i].media_specific_data.ieee80211.role = aux >> 4;
-                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_band);
-                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
-                    _E1B(&p, &ret->media_types[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
+                    _EnB(&p,  ret->local_interfaces[i].oui, 3);
+                    _E1B(&p, &ret->local_interfaces[i].variant_index);
+                    _E1B(&p, &ret->local_interfaces[i].media_specific_bytes_nr);
 
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == ret->media_types[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == ret->media_types[i].media_type)
-                        )
-                {
-                    if (7 != ret->media_types[i].media_specific_data_size)
-                    {
-                        // Malformed packet
-                        //
-                        free(ret->media_types);
-                        free(ret);
-                        return NULL;
-                    }
-                    _EnB(&p, ret->media_types[i].media_specific_data.ieee1901.network_identifier, 7);
-                }
-                else
-                {
-                    if (0 != ret->media_types[i].media_specific_data_size)
+                    if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
                     {
-                        // Malformed packet
-                        //
-                        free(ret->media_types);
-                        free(ret);
-                        return NULL;
+                        ret->local_interfaces[i].media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].media_specific_bytes_nr);
+                        _EnB(&p, ret->local_interfaces[i].media_specific_bytes, ret->local_interfaces[i].media_specific_bytes_nr);
                     }
                 }
             }
@@ -1359,100 +1978,68 @@ struct tlv *parse_1905_TLV_from_packet(const uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                free(ret->media_types);
-                free(ret);
+                for (i=0; i < ret->local_interfaces_nr; i++)
+                {
+                    if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
+                    {
+                        memfree(ret->local_interfaces[i].media_specific_bytes);
+                    }
+                }
+                memfree(ret->local_interfaces);
+                memfree(ret);
                 return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
+        case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.20"
+            // "IEEE Std 1905.1-2013 Section 6.4.29"
 
-            struct pushButtonJoinNotificationTLV  *ret;
+            struct interfacePowerChangeInformationTLV  *ret;
 
             uint16_t len;
+            uint8_t  i;
 
-            ret = (struct pushButtonJoinNotificationTLV *)memalloc(sizeof(struct pushButtonJoinNotificationTLV));
+            ret = (struct interfacePowerChangeInformationTLV *)memalloc(sizeof(struct interfacePowerChangeInformationTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            // According to the standard, the length *must* be 20
-            //
-            if (20 != len)
+            ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION;
+
+            if (0 == len)
             {
-                // Malformed packet
+#ifdef FIX_BROKEN_TLVS
+                // Malformed packet. Even if there are NO bridging tuples, the
+                // Malformed packet. Even if there are NO interfaces, the length
+                // should be "1" (which is the length of the next field, that
+                // would containing a "zero", indicating the number of
+                // interfaces).
+                // *However*, because at least one other implementation sets
+                // the 'length' to zero to indicate "no interfaces", we will
+                // also accept this type of "malformed" packet.
                 //
-                free(ret);
-                return NULL;
-            }
-
-            ret->tlv.type = TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION;
-
-            _EnB(&p,  ret->al_mac_address, 6);
-            _E2B(&p, &ret->message_identifier);
-            _EnB(&p,  ret->mac_address, 6);
-            _EnB(&p,  ret->new_mac_address, 6);
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.21"
-
-            struct genericPhyDeviceInformationTypeTLV  *ret;
-
-            uint16_t len;
-            uint8_t  i;
-
-            ret = (struct genericPhyDeviceInformationTypeTLV *)memalloc(sizeof(struct genericPhyDeviceInformationTypeTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            ret->tlv.type = TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION;
+                ret->power_change_interfaces_nr = 0;
+                return &ret->tlv;
+#else
+                memfree(ret);
+                return NULL;
+#endif
+            }
 
-            _EnB(&p,  ret->al_mac_address, 6);
-            _E1B(&p, &ret->local_interfaces_nr);
+            _E1B(&p, &ret->power_change_interfaces_nr);
 
-            if (ret->local_interfaces_nr > 0)
+            if (ret->power_change_interfaces_nr > 0)
             {
-                ret->local_interfaces = (struct _genericPhyDeviceEntries *)memalloc(sizeof(struct _genericPhyDeviceEntries) * ret->local_interfaces_nr);
+                ret->power_change_interfaces = (struct _powerChangeInformationEntries *)memalloc(sizeof(struct _powerChangeInformationEntries) * ret->power_change_interfaces_nr);
 
-                for (i=0; i < ret->local_interfaces_nr; i++)
+                for (i=0; i < ret->power_change_interfaces_nr; i++)
                 {
-                    _EnB(&p,  ret->local_interfaces[i].local_interface_address,                 6);
-                    _EnB(&p,  ret->local_interfaces[i].generic_phy_common_data.oui,             3);
-                    _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.variant_index);
-                    _EnB(&p,  ret->local_interfaces[i].variant_name,                           32);
-                    _E1B(&p, &ret->local_interfaces[i].generic_phy_description_xml_url_len);
-                    _E1B(&p, &ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-
-                    if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
-                    {
-                        ret->local_interfaces[i].generic_phy_description_xml_url = (char *)memalloc(ret->local_interfaces[i].generic_phy_description_xml_url_len);
-                        _EnB(&p, ret->local_interfaces[i].generic_phy_description_xml_url, ret->local_interfaces[i].generic_phy_description_xml_url_len);
-                    }
-                    else
-                    {
-                        ret->local_interfaces[i].generic_phy_description_xml_url = NULL;
-                    }
-
-                    if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                        _EnB(&p, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes, ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                    }
-                    else
-                    {
-                        ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes = NULL;
-                    }
+                    _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
+                    _E1B(&p, &ret->power_change_interfaces[i].requested_power_state);
                 }
             }
 
@@ -1460,143 +2047,61 @@ struct tlv *parse_1905_TLV_from_packet(const uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    if (ret->local_interfaces[i].generic_phy_description_xml_url_len > 0)
-                    {
-                        free(ret->local_interfaces[i].generic_phy_description_xml_url);
-                    }
-
-                    if (ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        free(ret->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                    }
-                }
-                free(ret->local_interfaces);
-                free(ret);
-                return NULL;
-            }
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.22"
-
-            struct deviceIdentificationTypeTLV  *ret;
-
-            uint16_t len;
-
-            ret = (struct deviceIdentificationTypeTLV *)memalloc(sizeof(struct deviceIdentificationTypeTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            // According to the standard, the length *must* be 20
-            //
-            if (192 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
+                memfree(ret->power_change_interfaces);
+                memfree(ret);
                 return NULL;
             }
 
-            ret->tlv.type = TLV_TYPE_DEVICE_IDENTIFICATION;
-
-            _EnB(&p,  ret->friendly_name,      64);
-            _EnB(&p,  ret->manufacturer_name,  64);
-            _EnB(&p,  ret->manufacturer_model, 64);
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_CONTROL_URL:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.23"
-
-            struct controlUrlTypeTLV  *ret;
-
-            uint16_t len;
-
-            ret = (struct controlUrlTypeTLV *)memalloc(sizeof(struct controlUrlTypeTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            ret->tlv.type       = TLV_TYPE_CONTROL_URL;
-
-            if (len>0)
-            {
-                ret->url            = (char *)memalloc(len);
-                _EnB(&p, ret->url, len);
-            }
-
             return &ret->tlv;
         }
 
-        case TLV_TYPE_IPV4:
+        case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.24"
+            // "IEEE Std 1905.1-2013 Section 6.4.30"
 
-            struct ipv4TypeTLV  *ret;
+            struct interfacePowerChangeStatusTLV  *ret;
 
             uint16_t len;
-            uint8_t  i, j;
+            uint8_t  i;
 
-            ret = (struct ipv4TypeTLV *)memalloc(sizeof(struct ipv4TypeTLV));
+            ret = (struct interfacePowerChangeStatusTLV *)memalloc(sizeof(struct interfacePowerChangeStatusTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            ret->tlv.type = TLV_TYPE_IPV4;
+            ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS;
 
             if (0 == len)
             {
 #ifdef FIX_BROKEN_TLVS
                 // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO entris, the length
+                // Malformed packet. Even if there are NO interfaces, the length
                 // should be "1" (which is the length of the next field, that
                 // would containing a "zero", indicating the number of
-                // entries).
+                // interfaces).
                 // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no entries", we will also
-                // accept this type of "malformed" packet.
+                // the 'length' to zero to indicate "no interfaces", we will
+                // also accept this type of "malformed" packet.
                 //
-                ret->ipv4_interfaces_nr = 0;
+                ret->power_change_interfaces_nr = 0;
                 return &ret->tlv;
 #else
-                free(ret);
+                memfree(ret);
                 return NULL;
 #endif
             }
 
-            _E1B(&p, &ret->ipv4_interfaces_nr);
+            _E1B(&p, &ret->power_change_interfaces_nr);
 
-            if (ret->ipv4_interfaces_nr > 0)
+            if (ret->power_change_interfaces_nr > 0)
             {
-                ret->ipv4_interfaces = (struct _ipv4InterfaceEntries *)memalloc(sizeof(struct _ipv4InterfaceEntries) * ret->ipv4_interfaces_nr);
+                ret->power_change_interfaces = (struct _powerChangeStatusEntries *)memalloc(sizeof(struct _powerChangeStatusEntries) * ret->power_change_interfaces_nr);
 
-                for (i=0; i < ret->ipv4_interfaces_nr; i++)
+                for (i=0; i < ret->power_change_interfaces_nr; i++)
                 {
-                    _EnB(&p,  ret->ipv4_interfaces[i].mac_address, 6);
-                    _E1B(&p, &ret->ipv4_interfaces[i].ipv4_nr);
-
-                    if (ret->ipv4_interfaces[i].ipv4_nr > 0)
-                    {
-                        ret->ipv4_interfaces[i].ipv4 = (struct _ipv4Entries *)memalloc(sizeof(struct _ipv4Entries) * ret->ipv4_interfaces[i].ipv4_nr);
-
-                        for (j=0; j < ret->ipv4_interfaces[i].ipv4_nr; j++)
-                        {
-                            _E1B(&p, &ret->ipv4_interfaces[i].ipv4[j].type);
-                            _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_address,     4);
-                            _EnB(&p,  ret->ipv4_interfaces[i].ipv4[j].ipv4_dhcp_server, 4);
-                        }
-                    }
+                    _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
+                    _E1B(&p, &ret->power_change_interfaces[i].result);
                 }
             }
 
@@ -1604,79 +2109,83 @@ struct tlv *parse_1905_TLV_from_packet(const uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                for (i=0; i < ret->ipv4_interfaces_nr; i++)
+                if (ret->power_change_interfaces_nr > 0)
                 {
-                    if (ret->ipv4_interfaces[i].ipv4_nr > 0)
-                    {
-                        free(ret->ipv4_interfaces[i].ipv4);
-                    }
+                    memfree(ret->power_change_interfaces);
                 }
-                free(ret->ipv4_interfaces);
-                free(ret);
+                memfree(ret);
                 return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_IPV6:
+        case TLV_TYPE_L2_NEIGHBOR_DEVICE:
         {
             // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.25"
+            // "IEEE Std 1905.1-2013 Section 6.4.31"
 
-            struct ipv6TypeTLV  *ret;
+            struct l2NeighborDeviceTLV  *ret;
 
             uint16_t len;
-            uint8_t  i, j;
+            uint8_t  i, j, k;
 
-            ret = (struct ipv6TypeTLV *)memalloc(sizeof(struct ipv6TypeTLV));
+            ret = (struct l2NeighborDeviceTLV *)memalloc(sizeof(struct l2NeighborDeviceTLV));
 
             p = packet_stream + 1;
             _E2B(&p, &len);
 
-            ret->tlv.type = TLV_TYPE_IPV6;
+            ret->tlv.type = TLV_TYPE_L2_NEIGHBOR_DEVICE;
 
             if (0 == len)
             {
 #ifdef FIX_BROKEN_TLVS
                 // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO entris, the length
+                // Malformed packet. Even if there are NO interfaces, the length
                 // should be "1" (which is the length of the next field, that
                 // would containing a "zero", indicating the number of
-                // entries).
+                // interfaces).
                 // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no entries", we will also
-                // accept this type of "malformed" packet.
+                // the 'length' to zero to indicate "no interfaces", we will
+                // also accept this type of "malformed" packet.
                 //
-                ret->ipv6_interfaces_nr = 0;
+                ret->local_interfaces_nr = 0;
                 return &ret->tlv;
 #else
-                free(ret);
+                memfree(ret);
                 return NULL;
 #endif
             }
 
-            _E1B(&p, &ret->ipv6_interfaces_nr);
+            _E1B(&p, &ret->local_interfaces_nr);
 
-            if (ret->ipv6_interfaces_nr > 0)
+            if (ret->local_interfaces_nr > 0)
             {
-                ret->ipv6_interfaces = (struct _ipv6InterfaceEntries *)memalloc(sizeof(struct _ipv6InterfaceEntries) * ret->ipv6_interfaces_nr);
+                ret->local_interfaces = (struct _l2InterfacesEntries *)memalloc(sizeof(struct _l2InterfacesEntries) * ret->local_interfaces_nr);
 
-                for (i=0; i < ret->ipv6_interfaces_nr; i++)
+                for (i=0; i < ret->local_interfaces_nr; i++)
                 {
-                    _EnB(&p,  ret->ipv6_interfaces[i].mac_address,              6);
-                    _EnB(&p,  ret->ipv6_interfaces[i].ipv6_link_local_address, 16);
-                    _E1B(&p, &ret->ipv6_interfaces[i].ipv6_nr);
+                    _EnB(&p,  ret->local_interfaces[i].local_mac_address, 6);
+                    _E2B(&p, &ret->local_interfaces[i].l2_neighbors_nr);
 
-                    if (ret->ipv6_interfaces[i].ipv6_nr > 0)
+                    if (ret->local_interfaces[i].l2_neighbors_nr > 0)
                     {
-                        ret->ipv6_interfaces[i].ipv6 = (struct _ipv6Entries *)memalloc(sizeof(struct _ipv6Entries) * ret->ipv6_interfaces[i].ipv6_nr);
+                        ret->local_interfaces[i].l2_neighbors = (struct _l2NeighborsEntries *)memalloc(sizeof(struct _l2NeighborsEntries) * ret->local_interfaces[i].l2_neighbors_nr);
 
-                        for (j=0; j < ret->ipv6_interfaces[i].ipv6_nr; j++)
+                        for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
                         {
-                            _E1B(&p, &ret->ipv6_interfaces[i].ipv6[j].type);
-                            _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address,        16);
-                            _EnB(&p,  ret->ipv6_interfaces[i].ipv6[j].ipv6_address_origin, 16);
+                            _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address, 6);
+                            _E2B(&p, &ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
+
+                            if (ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0)
+                            {
+                                ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses = (uint8_t (*)[6])memalloc(sizeof(uint8_t[6]) * ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
+
+                                for (k=0; k < ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
+                                {
+                                    _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], 6);
+                                }
+                            }
                         }
                     }
                 }
@@ -1686,923 +2195,168 @@ struct tlv *parse_1905_TLV_from_packet(const uint8_t *packet_stream)
             {
                 // Malformed packet
                 //
-                for (i=0; i < ret->ipv6_interfaces_nr; i++)
+                for (i=0; i < ret->local_interfaces_nr; i++)
                 {
-                    if (ret->ipv6_interfaces[i].ipv6_nr > 0)
+                    for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
                     {
-                        free(ret->ipv6_interfaces[i].ipv6);
+                        memfree(ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
                     }
+                    memfree(ret->local_interfaces[i].l2_neighbors);
                 }
-                free(ret->ipv6_interfaces);
-                free(ret);
+                memfree(ret->local_interfaces);
+                memfree(ret);
                 return NULL;
             }
 
             return &ret->tlv;
         }
 
-        case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
+        default:
         {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.26"
-
-            struct pushButtonGenericPhyEventNotificationTLV  *ret;
-
             uint16_t len;
-            uint8_t  i;
-
-            ret = (struct pushButtonGenericPhyEventNotificationTLV *)memalloc(sizeof(struct pushButtonGenericPhyEventNotificationTLV));
-
+            DEFINE_DLIST_HEAD(dummy);
+            bool parsed;
             p = packet_stream + 1;
             _E2B(&p, &len);
-
-            ret->tlv.type = TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION;
-
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->local_interfaces_nr = 0;
-                return &ret->tlv;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
-
-            _E1B(&p, &ret->local_interfaces_nr);
-
-            if (ret->local_interfaces_nr > 0)
-            {
-                ret->local_interfaces = (struct _genericPhyCommonData *)memalloc(sizeof(struct _genericPhyCommonData) * ret->local_interfaces_nr);
-
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->local_interfaces[i].oui, 3);
-                    _E1B(&p, &ret->local_interfaces[i].variant_index);
-                    _E1B(&p, &ret->local_interfaces[i].media_specific_bytes_nr);
-
-                    if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
-                    {
-                        ret->local_interfaces[i].media_specific_bytes = (uint8_t *)memalloc(ret->local_interfaces[i].media_specific_bytes_nr);
-                        _EnB(&p, ret->local_interfaces[i].media_specific_bytes, ret->local_interfaces[i].media_specific_bytes_nr);
-                    }
-                }
-            }
-
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    if (ret->local_interfaces[i].media_specific_bytes_nr > 0)
-                    {
-                        free(ret->local_interfaces[i].media_specific_bytes);
-                    }
-                }
-                free(ret->local_interfaces);
-                free(ret);
-                return NULL;
-            }
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_1905_PROFILE_VERSION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.27"
-
-            struct x1905ProfileVersionTLV  *ret;
-
-            uint16_t len;
-
-            ret = (struct x1905ProfileVersionTLV *)memalloc(sizeof(struct x1905ProfileVersionTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            // According to the standard, the length *must* be 1
-            //
-            if (1 != len)
-            {
-                // Malformed packet
-                //
-                free(ret);
-                return NULL;
-            }
-
-            ret->tlv.type = TLV_TYPE_1905_PROFILE_VERSION;
-
-            _E1B(&p, &ret->profile);
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.28"
-
-            struct powerOffInterfaceTLV  *ret;
-
-            uint16_t len;
-            uint8_t  i;
-
-            ret = (struct powerOffInterfaceTLV *)memalloc(sizeof(struct powerOffInterfaceTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            ret->tlv.type = TLV_TYPE_POWER_OFF_INTERFACE;
-
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would contain a "zero", indicating the number of interfaces)
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->power_off_interfaces_nr = 0;
-                return &ret->tlv;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
-
-            _E1B(&p, &ret->power_off_interfaces_nr);
-
-            if (ret->power_off_interfaces_nr > 0)
-            {
-                ret->power_off_interfaces = (struct _powerOffInterfaceEntries *)memalloc(sizeof(struct _powerOffInterfaceEntries) * ret->power_off_interfaces_nr);
-
-                for (i=0; i < ret->power_off_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->power_off_interfaces[i].interface_address, 6);
-                    _E2B(&p, &ret->power_off_interfaces[i].media_type);
-                    _EnB(&p,  ret->power_off_interfaces[i].generic_phy_common_data.oui, 3);
-                    _E1B(&p, &ret->power_off_interfaces[i].generic_phy_common_data.variant_index);
-                    _E1B(&p, &ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-
-                    if (ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes = (uint8_t *)memalloc(ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                        _EnB(&p, ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                    }
-                }
-            }
-
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->power_off_interfaces_nr; i++)
-                {
-                    if (ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                    {
-                        free(ret->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                    }
-                }
-                free(ret->power_off_interfaces);
-                free(ret);
-                return NULL;
-            }
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.29"
-
-            struct interfacePowerChangeInformationTLV  *ret;
-
-            uint16_t len;
-            uint8_t  i;
-
-            ret = (struct interfacePowerChangeInformationTLV *)memalloc(sizeof(struct interfacePowerChangeInformationTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION;
-
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->power_change_interfaces_nr = 0;
-                return &ret->tlv;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
-
-            _E1B(&p, &ret->power_change_interfaces_nr);
-
-            if (ret->power_change_interfaces_nr > 0)
-            {
-                ret->power_change_interfaces = (struct _powerChangeInformationEntries *)memalloc(sizeof(struct _powerChangeInformationEntries) * ret->power_change_interfaces_nr);
-
-                for (i=0; i < ret->power_change_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
-                    _E1B(&p, &ret->power_change_interfaces[i].requested_power_state);
-                }
-            }
-
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                free(ret->power_change_interfaces);
-                free(ret);
-                return NULL;
-            }
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.30"
-
-            struct interfacePowerChangeStatusTLV  *ret;
-
-            uint16_t len;
-            uint8_t  i;
-
-            ret = (struct interfacePowerChangeStatusTLV *)memalloc(sizeof(struct interfacePowerChangeStatusTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            ret->tlv.type = TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS;
-
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->power_change_interfaces_nr = 0;
-                return &ret->tlv;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
-
-            _E1B(&p, &ret->power_change_interfaces_nr);
-
-            if (ret->power_change_interfaces_nr > 0)
-            {
-                ret->power_change_interfaces = (struct _powerChangeStatusEntries *)memalloc(sizeof(struct _powerChangeStatusEntries) * ret->power_change_interfaces_nr);
-
-                for (i=0; i < ret->power_change_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->power_change_interfaces[i].interface_address, 6);
-                    _E1B(&p, &ret->power_change_interfaces[i].result);
-                }
-            }
-
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                if (ret->power_change_interfaces_nr > 0)
-                {
-                    free(ret->power_change_interfaces);
-                }
-                free(ret);
-                return NULL;
-            }
-
-            return &ret->tlv;
-        }
-
-        case TLV_TYPE_L2_NEIGHBOR_DEVICE:
-        {
-            // This parsing is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.31"
-
-            struct l2NeighborDeviceTLV  *ret;
-
-            uint16_t len;
-            uint8_t  i, j, k;
-
-            ret = (struct l2NeighborDeviceTLV *)memalloc(sizeof(struct l2NeighborDeviceTLV));
-
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-
-            ret->tlv.type = TLV_TYPE_L2_NEIGHBOR_DEVICE;
-
-            if (0 == len)
-            {
-#ifdef FIX_BROKEN_TLVS
-                // Malformed packet. Even if there are NO bridging tuples, the
-                // Malformed packet. Even if there are NO interfaces, the length
-                // should be "1" (which is the length of the next field, that
-                // would containing a "zero", indicating the number of
-                // interfaces).
-                // *However*, because at least one other implementation sets
-                // the 'length' to zero to indicate "no interfaces", we will
-                // also accept this type of "malformed" packet.
-                //
-                ret->local_interfaces_nr = 0;
-                return &ret->tlv;
-#else
-                free(ret);
-                return NULL;
-#endif
-            }
-
-            _E1B(&p, &ret->local_interfaces_nr);
-
-            if (ret->local_interfaces_nr > 0)
-            {
-                ret->local_interfaces = (struct _l2InterfacesEntries *)memalloc(sizeof(struct _l2InterfacesEntries) * ret->local_interfaces_nr);
-
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    _EnB(&p,  ret->local_interfaces[i].local_mac_address, 6);
-                    _E2B(&p, &ret->local_interfaces[i].l2_neighbors_nr);
-
-                    if (ret->local_interfaces[i].l2_neighbors_nr > 0)
-                    {
-                        ret->local_interfaces[i].l2_neighbors = (struct _l2NeighborsEntries *)memalloc(sizeof(struct _l2NeighborsEntries) * ret->local_interfaces[i].l2_neighbors_nr);
-
-                        for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
-                        {
-                            _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].l2_neighbor_mac_address, 6);
-                            _E2B(&p, &ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
-
-                            if (ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0)
-                            {
-                                ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses = (uint8_t (*)[6])memalloc(sizeof(uint8_t[6]) * ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr);
-
-                                for (k=0; k < ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr; k++)
-                                {
-                                    _EnB(&p,  ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses[k], 6);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-
-            if (p - (packet_stream+3) != len)
-            {
-                // Malformed packet
-                //
-                for (i=0; i < ret->local_interfaces_nr; i++)
-                {
-                    for (j=0; j < ret->local_interfaces[i].l2_neighbors_nr; j++)
-                    {
-                        free(ret->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
-                    }
-                    free(ret->local_interfaces[i].l2_neighbors);
-                }
-                free(ret->local_interfaces);
-                free(ret);
-                return NULL;
-            }
-
-            return &ret->tlv;
-        }
-
-        default:
-        {
-            uint16_t len;
-            DEFINE_DLIST_HEAD(dummy);
-            bool parsed;
-            p = packet_stream + 1;
-            _E2B(&p, &len);
-            parsed = tlv_parse(tlv_1905_defs, &dummy, packet_stream, len + 3);
-            if (!parsed)
-            {
-                // Ignore
-                //
-                return NULL;
-            }
-            else
-            {
-                struct tlv *tlv = container_of(dummy.next, struct tlv, s.h.l);
-                dlist_head_init(&tlv->s.h.l);
-                return tlv;
-            }
-        }
-
-    }
-
-    // This code cannot be reached
-    //
-    return NULL;
-}
-
-
-uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
-{
-    if (NULL == tlv)
-    {
-        return NULL;
-    }
-
-    // The first byte of any of the valid structures is always the "tlv.type"
-    // field.
-    //
-    switch (tlv->type)
-    {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.5"
-
-            uint8_t *ret, *p;
-            struct deviceInformationTypeTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
-
-            m = (struct deviceInformationTypeTLV *)tlv;
-
-            tlv_length = 7;  // AL MAC (6 bytes) + number of ifaces (1 bytes)
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                tlv_length += 6 + 2 + 1;  // MAC (6 bytes) + media type (2
-                                          // bytes) + number of octets (1 byte)
-
-                tlv_length += m->local_interfaces[i].media_specific_data_size;
-            }
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->al_mac_address,      &p, 6);
-            _I1B(&m->local_interfaces_nr, &p);
-
-            for (i=0; i<m->local_interfaces_nr; i++)
-            {
-                _InB( m->local_interfaces[i].mac_address,              &p, 6);
-                _I2B(&m->local_interfaces[i].media_type,               &p);
-                _I1B(&m->local_interfaces[i].media_specific_data_size, &p);
-
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == m->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == m->local_interfaces[i].media_type)
-                   )
-                {
-                    uint8_t aux;
-
-                    if (10 != m->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
-
-                    _InB(m->local_interfaces[i].media_specific_data.ieee80211.network_membership,                   &p, 6);
-                    aux = m->local_interfaces[i].media_specific_data.ieee80211.role << 4;
-                    _I1B(&aux,                                                                                      &p);
-                    _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band,                     &p);
-                    _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1, &p);
-                    _I1B(&m->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2, &p);
-
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == m->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == m->local_interfaces[i].media_type)
-                        )
-                {
-                    if (7 != m->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
-                    _InB(m->local_interfaces[i].media_specific_data.ieee1901.network_identifier, &p, 7);
-                }
-                else
-                {
-                    if (0 != m->local_interfaces[i].media_specific_data_size)
-                    {
-                        // Malformed structure
-                        //
-                        free(ret);
-                        return NULL;
-                    }
-                }
-            }
-
-            return ret;
-        }
-
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.6"
-
-            uint8_t *ret, *p;
-            struct deviceBridgingCapabilityTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i, j;
-
-            m = (struct deviceBridgingCapabilityTLV *)tlv;
-
-            tlv_length = 1;  // number of bridging tuples (1 bytes)
-            for (i=0; i<m->bridging_tuples_nr; i++)
-            {
-                tlv_length += 1;  // number of MAC addresses (1 bytes)
-                tlv_length += 6 * m->bridging_tuples[i].bridging_tuple_macs_nr;
-            }
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,           &p);
-            _I2B(&tlv_length,            &p);
-            _I1B(&m->bridging_tuples_nr, &p);
-
-            for (i=0; i<m->bridging_tuples_nr; i++)
-            {
-                _I1B(&m->bridging_tuples[i].bridging_tuple_macs_nr, &p);
-
-                for (j=0; j<m->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                {
-                    _InB(m->bridging_tuples[i].bridging_tuple_macs[j].mac_address,  &p, 6);
-                }
-            }
-
-            return ret;
-        }
-
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.8"
-
-            uint8_t *ret, *p;
-            struct non1905NeighborDeviceListTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
-
-            m = (struct non1905NeighborDeviceListTLV *)tlv;
-
-            tlv_length = 6 + 6*m->non_1905_neighbors_nr;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_mac_address,   &p, 6);
-
-            for (i=0; i<m->non_1905_neighbors_nr; i++)
-            {
-                _InB(m->non_1905_neighbors[i].mac_address, &p, 6);
-            }
-
-            return ret;
-        }
-
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.9"
-
-            uint8_t *ret, *p;
-            struct neighborDeviceListTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
-
-            m = (struct neighborDeviceListTLV *)tlv;
-
-            tlv_length = 6 + 7*m->neighbors_nr;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_mac_address,   &p, 6);
-
-            for (i=0; i<m->neighbors_nr; i++)
-            {
-                uint8_t aux;
-
-                _InB(m->neighbors[i].mac_address, &p, 6);
-
-                if (1 == m->neighbors[i].bridge_flag)
-                {
-                    aux = 1 << 7;
-                    _I1B(&aux, &p);
-                }
-                else
-                {
-                    aux = 0;
-                    _I1B(&aux, &p);
-                }
-            }
-
-            return ret;
-        }
-
-        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.11"
-
-            uint8_t *ret, *p;
-            struct transmitterLinkMetricTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
-
-            m = (struct transmitterLinkMetricTLV *)tlv;
-
-            tlv_length = 12 + 29*m->transmitter_link_metrics_nr;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_al_address,    &p, 6);
-            _InB( m->neighbor_al_address, &p, 6);
-
-            for (i=0; i<m->transmitter_link_metrics_nr; i++)
-            {
-                _InB( m->transmitter_link_metrics[i].local_interface_address,    &p, 6);
-                _InB( m->transmitter_link_metrics[i].neighbor_interface_address, &p, 6);
-                _I2B(&m->transmitter_link_metrics[i].intf_type,                  &p);
-                _I1B(&m->transmitter_link_metrics[i].bridge_flag,                &p);
-                _I4B(&m->transmitter_link_metrics[i].packet_errors,              &p);
-                _I4B(&m->transmitter_link_metrics[i].transmitted_packets,        &p);
-                _I2B(&m->transmitter_link_metrics[i].mac_throughput_capacity,    &p);
-                _I2B(&m->transmitter_link_metrics[i].link_availability,          &p);
-                _I2B(&m->transmitter_link_metrics[i].phy_rate,                   &p);
-            }
-
-            return ret;
-        }
-
-        case TLV_TYPE_RECEIVER_LINK_METRIC:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.12"
-
-            uint8_t *ret, *p;
-            struct receiverLinkMetricTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
-
-            m = (struct receiverLinkMetricTLV *)tlv;
-
-            tlv_length = 12 + 23*m->receiver_link_metrics_nr;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->local_al_address,    &p, 6);
-            _InB( m->neighbor_al_address, &p, 6);
-
-            for (i=0; i<m->receiver_link_metrics_nr; i++)
-            {
-                _InB( m->receiver_link_metrics[i].local_interface_address,    &p, 6);
-                _InB( m->receiver_link_metrics[i].neighbor_interface_address, &p, 6);
-                _I2B(&m->receiver_link_metrics[i].intf_type,                  &p);
-                _I4B(&m->receiver_link_metrics[i].packet_errors,              &p);
-                _I4B(&m->receiver_link_metrics[i].packets_received,           &p);
-                _I1B(&m->receiver_link_metrics[i].rssi,                       &p);
-            }
-
-            return ret;
-        }
-
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.13"
-
-            uint8_t *ret, *p;
-            struct linkMetricResultCodeTLV *m;
-
-            uint16_t tlv_length;
-
-            m = (struct linkMetricResultCodeTLV *)tlv;
-
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
-
-            if (m->result_code != LINK_METRIC_RESULT_CODE_TLV_INVALID_NEIGHBOR)
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
-
-            _I1B(&m->result_code,  &p);
-
-            return ret;
-        }
-
-        case TLV_TYPE_SEARCHED_ROLE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.14"
-
-            uint8_t *ret, *p;
-            struct searchedRoleTLV *m;
-
-            uint16_t tlv_length;
-
-            m = (struct searchedRoleTLV *)tlv;
-
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
-
-            if (m->role != IEEE80211_ROLE_REGISTRAR)
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
-
-            _I1B(&m->role,  &p);
-
-            return ret;
-        }
-
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.14"
-
-            uint8_t *ret, *p;
-            struct autoconfigFreqBandTLV *m;
-
-            uint16_t tlv_length;
-
-            m = (struct autoconfigFreqBandTLV *)tlv;
-
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
-
-            if (
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_2_4_GHZ) &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_5_GHZ)   &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_60_GHZ)
-               )
+            parsed = tlv_parse(tlv_1905_defs, &dummy, packet_stream, len + 3);
+            if (!parsed)
             {
-                // Malformed structure
+                // Ignore
                 //
-                free(ret);
                 return NULL;
             }
+            else
+            {
+                struct tlv *tlv = container_of(dummy.next, struct tlv, s.h.l);
+                dlist_head_init(&tlv->s.h.l);
+                return tlv;
+            }
+        }
 
-            _I1B(&m->freq_band,  &p);
+    }
 
-            return ret;
-        }
+    // This code cannot be reached
+    //
+    return NULL;
+}
 
-        case TLV_TYPE_SUPPORTED_ROLE:
+
+// Common implementation of "forge_1905_TLV_length()" and
+// "forge_1905_TLV_into_buffer()".
+//
+// The length of the forged TLV (type and length fields included) is always
+// returned in 'len'. If 'buffer' is NULL, that is all this function does.
+// Otherwise the TLV is also written into 'buffer', which must be at least that
+// long ('buffer_size').
+//
+// Returns "false" if the TLV can not be forged (or does not fit).
+//
+// Note that the structure is only validated when it is actually written.
+//
+static bool _forge_1905_TLV(const struct tlv *tlv, uint8_t *buffer, size_t buffer_size, size_t *len)
+{
+    // Once the length of the TLV is known, stop if only the length was
+    // requested and otherwise start writing at the beginning of 'buffer'.
+    //
+    #define _FORGE_TLV_START(p)         \
+        do                              \
+        {                               \
+            if (NULL == buffer)         \
+            {                           \
+                return true;            \
+            }                           \
+            if (buffer_size < *len)     \
+            {                           \
+                return false;           \
+            }                           \
+            (p) = buffer;               \
+        } while (0)
+
+    if (NULL == tlv)
+    {
+        return false;
+    }
+
+    // The first byte of any of the valid structures is always the "tlv.type"
+    // field.
+    //
+    switch (tlv->type)
+    {
+        case TLV_TYPE_TRANSMITTER_LINK_METRIC:
         {
             // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.16"
+            // "IEEE Std 1905.1-2013 Section 6.4.11"
 
-            uint8_t *ret, *p;
-            struct supportedRoleTLV *m;
+            uint8_t *p;
+            struct transmitterLinkMetricTLV *m;
 
             uint16_t tlv_length;
 
-            m = (struct supportedRoleTLV *)tlv;
+            uint8_t i;
+
+            m = (struct transmitterLinkMetricTLV *)tlv;
 
-            tlv_length = 1;
+            tlv_length = 12 + 29*m->transmitter_link_metrics_nr;
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+            _I1B(&m->tlv.type,            &p);
+            _I2B(&tlv_length,             &p);
+            _InB( m->local_al_address,    &p, 6);
+            _InB( m->neighbor_al_address, &p, 6);
 
-            if (m->role != IEEE80211_ROLE_REGISTRAR)
+            for (i=0; i<m->transmitter_link_metrics_nr; i++)
             {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
+                _InB( m->transmitter_link_metrics[i].local_interface_address,    &p, 6);
+                _InB( m->transmitter_link_metrics[i].neighbor_interface_address, &p, 6);
+                _I2B(&m->transmitter_link_metrics[i].intf_type,                  &p);
+                _I1B(&m->transmitter_link_metrics[i].bridge_flag,                &p);
+                _I4B(&m->transmitter_link_metrics[i].packet_errors,              &p);
+                _I4B(&m->transmitter_link_metrics[i].transmitted_packets,        &p);
+                _I2B(&m->transmitter_link_metrics[i].mac_throughput_capacity,    &p);
+                _I2B(&m->transmitter_link_metrics[i].link_availability,          &p);
+                _I2B(&m->transmitter_link_metrics[i].phy_rate,                   &p);
             }
 
-            _I1B(&m->role,  &p);
-
-            return ret;
+            return true;
         }
 
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
+        case TLV_TYPE_RECEIVER_LINK_METRIC:
         {
             // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.17"
+            // "IEEE Std 1905.1-2013 Section 6.4.12"
 
-            uint8_t *ret, *p;
-            struct supportedFreqBandTLV *m;
+            uint8_t *p;
+            struct receiverLinkMetricTLV *m;
 
             uint16_t tlv_length;
 
-            m = (struct supportedFreqBandTLV *)tlv;
+            uint8_t i;
+
+            m = (struct receiverLinkMetricTLV *)tlv;
 
-            tlv_length = 1;
+            tlv_length = 12 + 23*m->receiver_link_metrics_nr;
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
+            _I1B(&m->tlv.type,            &p);
+            _I2B(&tlv_length,             &p);
+            _InB( m->local_al_address,    &p, 6);
+            _InB( m->neighbor_al_address, &p, 6);
 
-            if (
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_2_4_GHZ) &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_5_GHZ)   &&
-                 (m->freq_band != IEEE80211_FREQUENCY_BAND_60_GHZ)
-               )
+            for (i=0; i<m->receiver_link_metrics_nr; i++)
             {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
+                _InB( m->receiver_link_metrics[i].local_interface_address,    &p, 6);
+                _InB( m->receiver_link_metrics[i].neighbor_interface_address, &p, 6);
+                _I2B(&m->receiver_link_metrics[i].intf_type,                  &p);
+                _I4B(&m->receiver_link_metrics[i].packet_errors,              &p);
+                _I4B(&m->receiver_link_metrics[i].packets_received,           &p);
+                _I1B(&m->receiver_link_metrics[i].rssi,                       &p);
             }
 
-            _I1B(&m->freq_band,  &p);
-
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_WSC:
@@ -2610,7 +2364,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.18"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct wscTLV *m;
 
             uint16_t tlv_length;
@@ -2620,13 +2374,13 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             tlv_length = m->wsc_frame_size;
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,     &p);
             _I2B(&tlv_length,      &p);
             _InB( m->wsc_frame,    &p, m->wsc_frame_size);
 
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
@@ -2634,7 +2388,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.19"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct pushButtonEventNotificationTLV *m;
 
             uint16_t tlv_length;
@@ -2653,7 +2407,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             }
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,        &p);
             _I2B(&tlv_length,         &p);
@@ -2681,8 +2435,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                     {
                         // Malformed structure
                         //
-                        free(ret);
-                        return NULL;
+                        return false;
                     }
 
                     _InB(m->media_types[i].media_specific_data.ieee80211.network_membership,                   &p, 6);
@@ -2702,8 +2455,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                     {
                         // Malformed structure
                         //
-                        free(ret);
-                        return NULL;
+                        return false;
                     }
                     _InB(m->media_types[i].media_specific_data.ieee1901.network_identifier, &p, 7);
                 }
@@ -2713,40 +2465,12 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                     {
                         // Malformed structure
                         //
-                        free(ret);
-                        return NULL;
+                        return false;
                     }
                 }
             }
 
-            return ret;
-        }
-
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.20"
-
-            uint8_t *ret, *p;
-            struct pushButtonJoinNotificationTLV *m;
-
-            uint16_t tlv_length;
-
-            m = (struct pushButtonJoinNotificationTLV *)tlv;
-
-            tlv_length = 20;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,            &p);
-            _I2B(&tlv_length,             &p);
-            _InB( m->al_mac_address,      &p, 6);
-            _I2B(&m->message_identifier,  &p);
-            _InB( m->mac_address,         &p, 6);
-            _InB( m->new_mac_address,     &p, 6);
-
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
@@ -2754,7 +2478,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.21"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct genericPhyDeviceInformationTypeTLV *m;
 
             uint16_t tlv_length;
@@ -2780,7 +2504,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             }
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,            &p);
             _I2B(&tlv_length,             &p);
@@ -2805,33 +2529,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                 }
             }
 
-            return ret;
-        }
-
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.21"
-
-            uint8_t *ret, *p;
-            struct deviceIdentificationTypeTLV *m;
-
-            uint16_t tlv_length;
-
-            m = (struct deviceIdentificationTypeTLV *)tlv;
-
-            tlv_length = 192;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,           &p);
-            _I2B(&tlv_length,            &p);
-            _InB( m->friendly_name,      &p, 64);
-            _InB( m->manufacturer_name,  &p, 64);
-            _InB( m->manufacturer_model, &p, 64);
-
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_CONTROL_URL:
@@ -2839,7 +2537,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.23"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct controlUrlTypeTLV *m;
 
             uint16_t tlv_length;
@@ -2849,13 +2547,13 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             tlv_length = strlen(m->url)+1;
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,     &p);
             _I2B(&tlv_length,      &p);
             _InB( m->url,          &p, tlv_length);
 
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_IPV4:
@@ -2863,7 +2561,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.24"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct ipv4TypeTLV *m;
 
             uint16_t tlv_length;
@@ -2881,7 +2579,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             }
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,           &p);
             _I2B(&tlv_length,            &p);
@@ -2900,7 +2598,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                 }
             }
 
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_IPV6:
@@ -2908,7 +2606,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.25"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct ipv6TypeTLV *m;
 
             uint16_t tlv_length;
@@ -2927,7 +2625,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             }
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,           &p);
             _I2B(&tlv_length,            &p);
@@ -2947,7 +2645,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                 }
             }
 
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_GENERIC_PHY_EVENT_NOTIFICATION:
@@ -2955,7 +2653,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.26"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct pushButtonGenericPhyEventNotificationTLV *m;
 
             uint16_t tlv_length;
@@ -2975,7 +2673,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             }
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,                &p);
             _I2B(&tlv_length,                 &p);
@@ -2992,92 +2690,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                 }
             }
 
-            return ret;
-        }
-
-        case TLV_TYPE_1905_PROFILE_VERSION:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.27"
-
-            uint8_t *ret, *p;
-            struct x1905ProfileVersionTLV *m;
-
-            uint16_t tlv_length;
-
-            m = (struct x1905ProfileVersionTLV *)tlv;
-
-            tlv_length = 1;
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,     &p);
-            _I2B(&tlv_length,      &p);
-
-            if (
-                 m->profile != PROFILE_1905_1 &&
-                 m->profile != PROFILE_1905_1A
-               )
-            {
-                // Malformed structure
-                //
-                free(ret);
-                return NULL;
-            }
-
-            _I1B(&m->profile,  &p);
-
-            return ret;
-        }
-
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            // This forging is done according to the information detailed in
-            // "IEEE Std 1905.1-2013 Section 6.4.28"
-
-            uint8_t *ret, *p;
-            struct powerOffInterfaceTLV *m;
-
-            uint16_t tlv_length;
-
-            uint8_t i;
-
-            m = (struct powerOffInterfaceTLV *)tlv;
-
-            tlv_length = 1;  // number of power off interfaces (1 bytes)
-            for (i=0; i<m->power_off_interfaces_nr; i++)
-            {
-                tlv_length += 6;  // interface MAC address (6 bytes)
-                tlv_length += 2;  // media type (2 bytes)
-                tlv_length += 3;  // OUI (2 bytes)
-                tlv_length += 1;  // variant_index (1 byte)
-                tlv_length += 1;  // media specific bytes number (1 bytes)
-                tlv_length += m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr;
-                                  // media specific bytes
-            }
-            *len = 1 + 2 + tlv_length;
-
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
-
-            _I1B(&m->tlv.type,                &p);
-            _I2B(&tlv_length,                 &p);
-            _I1B(&m->power_off_interfaces_nr, &p);
-
-            for (i=0; i<m->power_off_interfaces_nr; i++)
-            {
-                _InB( m->power_off_interfaces[i].interface_address,                               &p, 6);
-                _I2B(&m->power_off_interfaces[i].media_type,                                      &p);
-                _InB( m->power_off_interfaces[i].generic_phy_common_data.oui,                     &p, 3);
-                _I1B(&m->power_off_interfaces[i].generic_phy_common_data.variant_index,           &p);
-                _I1B(&m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr, &p);
-                if (m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0)
-                {
-                    _InB( m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, &p, m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                }
-            }
-
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
@@ -3085,7 +2698,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.29"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct interfacePowerChangeInformationTLV *m;
 
             uint16_t tlv_length;
@@ -3099,7 +2712,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
 
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,                   &p);
             _I2B(&tlv_length,                    &p);
@@ -3111,7 +2724,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                 _I1B(&m->power_change_interfaces[i].requested_power_state, &p);
             }
 
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_INTERFACE_POWER_CHANGE_STATUS:
@@ -3119,7 +2732,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.30"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct interfacePowerChangeStatusTLV *m;
 
             uint16_t tlv_length;
@@ -3133,7 +2746,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
 
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,                   &p);
             _I2B(&tlv_length,                    &p);
@@ -3145,7 +2758,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                 _I1B(&m->power_change_interfaces[i].result,            &p);
             }
 
-            return ret;
+            return true;
         }
 
         case TLV_TYPE_L2_NEIGHBOR_DEVICE:
@@ -3153,7 +2766,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             // This forging is done according to the information detailed in
             // "IEEE Std 1905.1-2013 Section 6.4.31"
 
-            uint8_t *ret, *p;
+            uint8_t *p;
             struct l2NeighborDeviceTLV *m;
 
             uint16_t tlv_length;
@@ -3177,7 +2790,7 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
             }
             *len = 1 + 2 + tlv_length;
 
-            p = ret = (uint8_t *)memalloc(1 + 2  + tlv_length);
+            _FORGE_TLV_START(p);
 
             _I1B(&m->tlv.type,            &p);
             _I2B(&tlv_length,             &p);
@@ -3200,115 +2813,108 @@ uint8_t *forge_1905_TLV_from_structure(const struct tlv *tlv, uint16_t *len)
                 }
             }
 
-            return ret;
+            return true;
         }
 
         default:
         {
-            uint8_t *ret = NULL;
-            size_t length;
-            DEFINE_DLIST_HEAD(dummy);
-            tlv_add(tlv_1905_defs, &dummy, (struct tlv*)tlv);
-            if (!tlv_forge(tlv_1905_defs, &dummy, MAX_NETWORK_SEGMENT_SIZE, &ret, &length))
+            const struct tlv_def *tlv_def = tlv_find_def(tlv_1905_defs, tlv->type);
+            uint8_t *p;
+            size_t remaining;
+
+            if (NULL == tlv_def->desc.name)
+            {
+                PLATFORM_PRINTF_DEBUG_ERROR("Failed to forge unknown TLV %u\n", tlv->type);
+                return false;
+            }
+
+            *len = tlv_forged_length(tlv);
+            _FORGE_TLV_START(p);
+
+            remaining = *len;
+            if (!tlv_forge_into(tlv, &p, &remaining))
             {
                 PLATFORM_PRINTF_DEBUG_ERROR("Failed to forge TLV %s\n",
                                             convert_1905_TLV_type_to_string(tlv->type));
-                ret = NULL;
+                return false;
             }
-            *len = length;
-            dlist_head_init((dlist_head*)&tlv->s.h.l);
-            return ret;
+            return true;
         }
 
     }
 
+    #undef _FORGE_TLV_START
+
     // This code cannot be reached
     //
-    return NULL;
+    return false;
 }
 
-
-void free_1905_TLV_structure(struct tlv *tlv)
+size_t forge_1905_TLV_length(const struct tlv *memory_structure)
 {
-    if (NULL == tlv)
-    {
-        return;
-    }
+    size_t len;
 
-    // The first byte of any of the valid structures is always the "tlv_type"
-    // field.
-    //
-    switch (tlv->type)
+    if (!_forge_1905_TLV(memory_structure, NULL, 0, &len))
     {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            struct deviceInformationTypeTLV *m;
-
-            m = (struct deviceInformationTypeTLV *)tlv;
-
-            if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
-            {
-                free(m->local_interfaces);
-            }
-            free(m);
-
-            return;
-        }
-
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            struct deviceBridgingCapabilityTLV *m;
-            uint8_t i;
-
-            m = (struct deviceBridgingCapabilityTLV *)tlv;
-
-            for (i=0; i < m->bridging_tuples_nr; i++)
-            {
-                if (m->bridging_tuples[i].bridging_tuple_macs_nr > 0 && NULL != m->bridging_tuples[i].bridging_tuple_macs)
-                {
-                    free(m->bridging_tuples[i].bridging_tuple_macs);
-                }
-            }
-            if (m->bridging_tuples_nr > 0 && NULL != m->bridging_tuples)
-            {
-                free(m->bridging_tuples);
-            }
-            free(m);
-
-            return;
-        }
+        return 0;
+    }
+    return len;
+}
 
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
-        {
-            struct non1905NeighborDeviceListTLV *m;
+size_t forge_1905_TLV_into_buffer(const struct tlv *memory_structure, uint8_t *buffer, size_t buffer_size)
+{
+    size_t len;
 
-            m = (struct non1905NeighborDeviceListTLV *)tlv;
+    if (NULL == buffer || !_forge_1905_TLV(memory_structure, buffer, buffer_size, &len))
+    {
+        return 0;
+    }
+    return len;
+}
 
-            if (m->non_1905_neighbors_nr > 0 && NULL != m->non_1905_neighbors)
-            {
-                free(m->non_1905_neighbors);
-            }
-            free(m);
+uint8_t *forge_1905_TLV_from_structure(const struct tlv *memory_structure, uint16_t *len)
+{
+    uint8_t *ret;
+    size_t   ret_len;
 
-            return;
-        }
+    ret_len = forge_1905_TLV_length(memory_structure);
+    if (0 == ret_len || ret_len > UINT16_MAX)
+    {
+        return NULL;
+    }
 
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
-        {
-            struct neighborDeviceListTLV *m;
+    ret = (uint8_t *)memalloc(ret_len);
+    if (0 == forge_1905_TLV_into_buffer(memory_structure, ret, ret_len))
+    {
+        memfree(ret);
+        return NULL;
+    }
 
-            m = (struct neighborDeviceListTLV *)tlv;
+    *len = (uint16_t)ret_len;
+    return ret;
+}
 
-            if (m->neighbors_nr > 0 && NULL != m->neighbors)
-            {
-                free(m->neighbors);
-            }
-            free(m);
 
-            return;
-        }
+void free_1905_TLV_structure(struct tlv *tlv)
+{
+    if (NULL == tlv)
+    {
+        return;
+    }
 
+    // A TLV parsed into an arena only holds a reference to it: everything it
+    // points to is released together with the arena.
+    //
+    if (arena_drop(tlv))
+    {
+        return;
+    }
 
+    // The first byte of any of the valid structures is always the "tlv_type"
+    // field.
+    //
+    switch (tlv->type)
+    {
         case TLV_TYPE_TRANSMITTER_LINK_METRIC:
         {
             struct transmitterLinkMetricTLV *m;
@@ -3317,9 +2923,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (m->transmitter_link_metrics_nr > 0 && NULL != m->transmitter_link_metrics)
             {
-                free(m->transmitter_link_metrics);
+                memfree(m->transmitter_link_metrics);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3332,9 +2938,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (m->receiver_link_metrics_nr > 0 && NULL != m->receiver_link_metrics)
             {
-                free(m->receiver_link_metrics);
+                memfree(m->receiver_link_metrics);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3347,9 +2953,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (m->wsc_frame_size >0 && NULL != m->wsc_frame)
             {
-                free(m->wsc_frame);
+                memfree(m->wsc_frame);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3362,9 +2968,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (m->media_types_nr > 0 && NULL != m->media_types)
             {
-                free(m->media_types);
+                memfree(m->media_types);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3380,19 +2986,19 @@ void free_1905_TLV_structure(struct tlv *tlv)
             {
                 if (m->local_interfaces[i].generic_phy_description_xml_url_len > 0 && NULL != m->local_interfaces[i].generic_phy_description_xml_url)
                 {
-                    free(m->local_interfaces[i].generic_phy_description_xml_url);
+                    memfree(m->local_interfaces[i].generic_phy_description_xml_url);
                 }
 
                 if (m->local_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0 && NULL != m->local_interfaces[i].generic_phy_common_data.media_specific_bytes)
                 {
-                    free(m->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
+                    memfree(m->local_interfaces[i].generic_phy_common_data.media_specific_bytes);
                 }
             }
             if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
             {
-                free(m->local_interfaces);
+                memfree(m->local_interfaces);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3405,9 +3011,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (NULL != m->url)
             {
-                free(m->url);
+                memfree(m->url);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3423,14 +3029,14 @@ void free_1905_TLV_structure(struct tlv *tlv)
             {
                 if (m->ipv4_interfaces[i].ipv4_nr > 0 && NULL != m->ipv4_interfaces[i].ipv4)
                 {
-                    free(m->ipv4_interfaces[i].ipv4);
+                    memfree(m->ipv4_interfaces[i].ipv4);
                 }
             }
             if (m->ipv4_interfaces_nr > 0 && NULL != m->ipv4_interfaces)
             {
-                free(m->ipv4_interfaces);
+                memfree(m->ipv4_interfaces);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3446,14 +3052,14 @@ void free_1905_TLV_structure(struct tlv *tlv)
             {
                 if (m->ipv6_interfaces[i].ipv6_nr > 0 && NULL != m->ipv6_interfaces[i].ipv6)
                 {
-                    free(m->ipv6_interfaces[i].ipv6);
+                    memfree(m->ipv6_interfaces[i].ipv6);
                 }
             }
             if (m->ipv6_interfaces_nr > 0 && NULL != m->ipv6_interfaces)
             {
-                free(m->ipv6_interfaces);
+                memfree(m->ipv6_interfaces);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3466,32 +3072,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
             {
-                free(m->local_interfaces);
-            }
-            free(m);
-
-            return;
-        }
-
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            struct powerOffInterfaceTLV *m;
-            uint8_t i;
-
-            m = (struct powerOffInterfaceTLV *)tlv;
-
-            for (i=0; i < m->power_off_interfaces_nr; i++)
-            {
-                if (m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr > 0 && NULL != m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes)
-                {
-                    free(m->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                }
-            }
-            if (m->power_off_interfaces_nr > 0 && NULL != m->power_off_interfaces)
-            {
-                free(m->power_off_interfaces);
+                memfree(m->local_interfaces);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3504,9 +3087,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (m->power_change_interfaces_nr > 0 && NULL != m->power_change_interfaces)
             {
-                free(m->power_change_interfaces);
+                memfree(m->power_change_interfaces);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3519,9 +3102,9 @@ void free_1905_TLV_structure(struct tlv *tlv)
 
             if (m->power_change_interfaces_nr > 0 && NULL != m->power_change_interfaces)
             {
-                free(m->power_change_interfaces);
+                memfree(m->power_change_interfaces);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3541,17 +3124,17 @@ void free_1905_TLV_structure(struct tlv *tlv)
                     {
                         if (m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses_nr > 0 && NULL != m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses)
                         {
-                            free(m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
+                            memfree(m->local_interfaces[i].l2_neighbors[j].behind_mac_addresses);
                         }
                     }
-                    free(m->local_interfaces[i].l2_neighbors);
+                    memfree(m->local_interfaces[i].l2_neighbors);
                 }
             }
             if (m->local_interfaces_nr > 0 && NULL != m->local_interfaces)
             {
-                free(m->local_interfaces);
+                memfree(m->local_interfaces);
             }
-            free(m);
+            memfree(m);
 
             return;
         }
@@ -3560,8 +3143,6 @@ void free_1905_TLV_structure(struct tlv *tlv)
         default:
         {
             DEFINE_DLIST_HEAD(dummy);
-            dlist_head_init(&tlv->s.h.children[0]);
-            dlist_head_init(&tlv->s.h.children[1]);
             tlv_add(tlv_1905_defs, &dummy, tlv);
             hlist_delete(&dummy);
             return;
@@ -3590,197 +3171,6 @@ uint8_t compare_1905_TLV_structures(struct tlv *tlv_1, struct tlv *tlv_2)
     }
     switch (tlv_1->type)
     {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            struct deviceInformationTypeTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct deviceInformationTypeTLV *)tlv_1;
-            p2 = (struct deviceInformationTypeTLV *)tlv_2;
-
-            if (
-                 memcmp(p1->al_mac_address,         p2->al_mac_address, 6) !=0  ||
-                                 p1->local_interfaces_nr !=  p2->local_interfaces_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->local_interfaces_nr > 0 && (NULL == p1->local_interfaces || NULL == p2->local_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->local_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->local_interfaces[i].mac_address,                 p2->local_interfaces[i].mac_address, 6) !=0      ||
-                                     p1->local_interfaces[i].media_type               !=  p2->local_interfaces[i].media_type               ||
-                                     p1->local_interfaces[i].media_specific_data_size !=  p2->local_interfaces[i].media_specific_data_size
-                   )
-                {
-                    return 1;
-                }
-
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p1->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p1->local_interfaces[i].media_type)
-                   )
-                {
-                    if (
-                         memcmp(p1->local_interfaces[i].media_specific_data.ieee80211.network_membership,                     p2->local_interfaces[i].media_specific_data.ieee80211.network_membership,  6) !=0          ||
-                                         p1->local_interfaces[i].media_specific_data.ieee80211.role                                !=  p2->local_interfaces[i].media_specific_data.ieee80211.role                                 ||
-                                         p1->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band                     !=  p2->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band                      ||
-                                         p1->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1 !=  p2->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1
-                       )
-                    {
-                        return 1;
-                    }
-
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == p1->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == p1->local_interfaces[i].media_type)
-                        )
-                {
-                    if (
-                         memcmp(p1->local_interfaces[i].media_specific_data.ieee1901.network_identifier,  p2->local_interfaces[i].media_specific_data.ieee1901.network_identifier,  6) !=0
-                       )
-                    {
-                        return 1;
-                    }
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            struct deviceBridgingCapabilityTLV *p1, *p2;
-            uint8_t i, j;
-
-            p1 = (struct deviceBridgingCapabilityTLV *)tlv_1;
-            p2 = (struct deviceBridgingCapabilityTLV *)tlv_2;
-
-            if (
-                 p1->bridging_tuples_nr != p2->bridging_tuples_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->bridging_tuples_nr > 0 && (NULL == p1->bridging_tuples || NULL == p2->bridging_tuples))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->bridging_tuples_nr; i++)
-            {
-                if (
-                     p1->bridging_tuples[i].bridging_tuple_macs_nr  !=  p2->bridging_tuples[i].bridging_tuple_macs_nr
-                   )
-                {
-                    return 1;
-                }
-
-                for (j=0; j<p1->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                {
-                    if (
-                         memcmp(p1->bridging_tuples[i].bridging_tuple_macs[j].mac_address,  p2->bridging_tuples[i].bridging_tuple_macs[j].mac_address, 6) !=0
-                       )
-                    {
-                        return 1;
-                    }
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
-        {
-            struct non1905NeighborDeviceListTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct non1905NeighborDeviceListTLV *)tlv_1;
-            p2 = (struct non1905NeighborDeviceListTLV *)tlv_2;
-
-            if (
-                 memcmp(p1->local_mac_address,        p2->local_mac_address, 6) !=0  ||
-                                 p1->non_1905_neighbors_nr !=  p2->non_1905_neighbors_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->non_1905_neighbors_nr > 0 && (NULL == p1->non_1905_neighbors || NULL == p2->non_1905_neighbors))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->non_1905_neighbors_nr; i++)
-            {
-                if (
-                     memcmp(p1->non_1905_neighbors[i].mac_address,     p2->non_1905_neighbors[i].mac_address, 6) !=0
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
-        {
-            struct neighborDeviceListTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct neighborDeviceListTLV *)tlv_1;
-            p2 = (struct neighborDeviceListTLV *)tlv_2;
-
-            if (
-                 memcmp(p1->local_mac_address,     p2->local_mac_address, 6) !=0  ||
-                                 p1->neighbors_nr       !=  p2->neighbors_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->neighbors_nr > 0 && (NULL == p1->neighbors || NULL == p2->neighbors))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->neighbors_nr; i++)
-            {
-                if (
-                     memcmp(p1->neighbors[i].mac_address,     p2->neighbors[i].mac_address, 6) !=0  ||
-                                     p1->neighbors[i].bridge_flag  !=  p2->neighbors[i].bridge_flag
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
         case TLV_TYPE_TRANSMITTER_LINK_METRIC:
         {
             struct transmitterLinkMetricTLV *p1, *p2;
@@ -3845,122 +3235,27 @@ uint8_t compare_1905_TLV_structures(struct tlv *tlv_1, struct tlv *tlv_2)
 
             if (p1->receiver_link_metrics_nr > 0 && (NULL == p1->receiver_link_metrics || NULL == p2->receiver_link_metrics))
             {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->receiver_link_metrics_nr; i++)
-            {
-                if (
-                     memcmp(p1->receiver_link_metrics[i].local_interface_address,       p2->receiver_link_metrics[i].local_interface_address,    6) !=0  ||
-                     memcmp(p1->receiver_link_metrics[i].neighbor_interface_address,    p2->receiver_link_metrics[i].neighbor_interface_address, 6) !=0  ||
-                                     p1->receiver_link_metrics[i].intf_type                  !=  p2->receiver_link_metrics[i].intf_type                           ||
-                                     p1->receiver_link_metrics[i].packet_errors              !=  p2->receiver_link_metrics[i].packet_errors                       ||
-                                     p1->receiver_link_metrics[i].packets_received           !=  p2->receiver_link_metrics[i].packets_received                    ||
-                                     p1->receiver_link_metrics[i].rssi                       !=  p2->receiver_link_metrics[i].rssi
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
-        {
-            struct linkMetricResultCodeTLV *p1, *p2;
-
-            p1 = (struct linkMetricResultCodeTLV *)tlv_1;
-            p2 = (struct linkMetricResultCodeTLV *)tlv_2;
-
-            if (
-                 p1->result_code != p2->result_code
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_SEARCHED_ROLE:
-        {
-            struct searchedRoleTLV *p1, *p2;
-
-            p1 = (struct searchedRoleTLV *)tlv_1;
-            p2 = (struct searchedRoleTLV *)tlv_2;
-
-            if (
-                 p1->role != p2->role
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
-        {
-            struct autoconfigFreqBandTLV *p1, *p2;
-
-            p1 = (struct autoconfigFreqBandTLV *)tlv_1;
-            p2 = (struct autoconfigFreqBandTLV *)tlv_2;
-
-            if (
-                 p1->freq_band != p2->freq_band
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_SUPPORTED_ROLE:
-        {
-            struct supportedRoleTLV *p1, *p2;
-
-            p1 = (struct supportedRoleTLV *)tlv_1;
-            p2 = (struct supportedRoleTLV *)tlv_2;
-
-            if (
-                 p1->role != p2->role
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
-        {
-            struct supportedFreqBandTLV *p1, *p2;
-
-            p1 = (struct supportedFreqBandTLV *)tlv_1;
-            p2 = (struct supportedFreqBandTLV *)tlv_2;
-
-            if (
-                 p1->freq_band != p2->freq_band
-               )
-            {
+                // Malformed structure
+                //
                 return 1;
             }
-            else
+
+            for (i=0; i<p1->receiver_link_metrics_nr; i++)
             {
-                return 0;
+                if (
+                     memcmp(p1->receiver_link_metrics[i].local_interface_address,       p2->receiver_link_metrics[i].local_interface_address,    6) !=0  ||
+                     memcmp(p1->receiver_link_metrics[i].neighbor_interface_address,    p2->receiver_link_metrics[i].neighbor_interface_address, 6) !=0  ||
+                                     p1->receiver_link_metrics[i].intf_type                  !=  p2->receiver_link_metrics[i].intf_type                           ||
+                                     p1->receiver_link_metrics[i].packet_errors              !=  p2->receiver_link_metrics[i].packet_errors                       ||
+                                     p1->receiver_link_metrics[i].packets_received           !=  p2->receiver_link_metrics[i].packets_received                    ||
+                                     p1->receiver_link_metrics[i].rssi                       !=  p2->receiver_link_metrics[i].rssi
+                   )
+                {
+                    return 1;
+                }
             }
+
+            return 0;
         }
 
         case TLV_TYPE_WSC:
@@ -4050,49 +3345,6 @@ uint8_t compare_1905_TLV_structures(struct tlv *tlv_1, struct tlv *tlv_2)
             return 0;
         }
 
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
-        {
-            struct pushButtonJoinNotificationTLV *p1, *p2;
-
-            p1 = (struct pushButtonJoinNotificationTLV *)tlv_1;
-            p2 = (struct pushButtonJoinNotificationTLV *)tlv_2;
-
-            if (
-                 memcmp(p1->al_mac_address,       p2->al_mac_address, 6) !=0  ||
-                                 p1->message_identifier != p2->message_identifier      ||
-                 memcmp(p1->mac_address,          p2->al_mac_address, 6) !=0  ||
-                 memcmp(p1->new_mac_address,      p2->al_mac_address, 6) !=0
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
-        {
-            struct deviceIdentificationTypeTLV *p1, *p2;
-
-            p1 = (struct deviceIdentificationTypeTLV *)tlv_1;
-            p2 = (struct deviceIdentificationTypeTLV *)tlv_2;
-
-            if (
-                 memcmp(p1->friendly_name,       p2->friendly_name,      64) !=0  ||
-                 memcmp(p1->manufacturer_name,   p2->manufacturer_name,  64) !=0  ||
-                 memcmp(p1->manufacturer_model,  p2->manufacturer_model, 64) !=0
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
         case TLV_TYPE_CONTROL_URL:
         {
             struct controlUrlTypeTLV *p1, *p2;
@@ -4289,65 +3541,6 @@ uint8_t compare_1905_TLV_structures(struct tlv *tlv_1, struct tlv *tlv_2)
             return 0;
         }
 
-        case TLV_TYPE_1905_PROFILE_VERSION:
-        {
-            struct x1905ProfileVersionTLV *p1, *p2;
-
-            p1 = (struct x1905ProfileVersionTLV *)tlv_1;
-            p2 = (struct x1905ProfileVersionTLV *)tlv_2;
-
-            if (
-                 p1->profile != p2->profile
-               )
-            {
-                return 1;
-            }
-            else
-            {
-                return 0;
-            }
-        }
-
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            struct powerOffInterfaceTLV *p1, *p2;
-            uint8_t i;
-
-            p1 = (struct powerOffInterfaceTLV *)tlv_1;
-            p2 = (struct powerOffInterfaceTLV *)tlv_2;
-
-            if (
-                 p1->power_off_interfaces_nr != p2->power_off_interfaces_nr
-               )
-            {
-                return 1;
-            }
-
-            if (p1->power_off_interfaces_nr > 0 && (NULL == p1->power_off_interfaces || NULL == p2->power_off_interfaces))
-            {
-                // Malformed structure
-                //
-                return 1;
-            }
-
-            for (i=0; i<p1->power_off_interfaces_nr; i++)
-            {
-                if (
-                     memcmp(p1->power_off_interfaces[i].interface_address,                                   p2->power_off_interfaces[i].interface_address,                            6) !=0  ||
-                                     p1->power_off_interfaces[i].media_type                                       !=  p2->power_off_interfaces[i].media_type                                            ||
-                     memcmp(p1->power_off_interfaces[i].generic_phy_common_data.oui,                         p2->power_off_interfaces[i].generic_phy_common_data.oui,                  3) !=0  ||
-                                     p1->power_off_interfaces[i].generic_phy_common_data.variant_index            !=  p2->power_off_interfaces[i].generic_phy_common_data.variant_index                 ||
-                                     p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr  !=  p2->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr       ||
-                     memcmp(p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes,        p2->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes, p1->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr) !=0
-                   )
-                {
-                    return 1;
-                }
-            }
-
-            return 0;
-        }
-
         case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
         {
             struct interfacePowerChangeInformationTLV *p1, *p2;
@@ -4532,142 +3725,6 @@ void visit_1905_TLV_structure(struct tlv *tlv, visitor_callback callback, void (
     //
     switch (tlv->type)
     {
-        case TLV_TYPE_DEVICE_INFORMATION_TYPE:
-        {
-            struct deviceInformationTypeTLV *p;
-            uint8_t i;
-
-            p = (struct deviceInformationTypeTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->al_mac_address),      "al_mac_address",       "0x%02x",   p->al_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->local_interfaces_nr), "local_interfaces_nr",  "%d",       &p->local_interfaces_nr);
-            for (i=0; i < p->local_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%slocal_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
-
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].mac_address),              "mac_address",              "0x%02x",   p->local_interfaces[i].mac_address);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_type),               "media_type",               "0x%04x",  &p->local_interfaces[i].media_type);
-                callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data_size), "media_specific_data_size", "%d",      &p->local_interfaces[i].media_specific_data_size);
-
-                if (
-                     (MEDIA_TYPE_IEEE_802_11B_2_4_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11G_2_4_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11A_5_GHZ   == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_2_4_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11N_5_GHZ   == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AC_5_GHZ  == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AD_60_GHZ == p->local_interfaces[i].media_type) ||
-                     (MEDIA_TYPE_IEEE_802_11AF_GHZ    == p->local_interfaces[i].media_type)
-                   )
-                {
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.network_membership),                  "network_membership",                   "0x%02x",   p->local_interfaces[i].media_specific_data.ieee80211.network_membership);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.role),                                "role",                                 "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.role);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band),                     "ap_channel_band",                      "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_band);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1), "ap_channel_center_frequency_index_1",  "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_1);
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2), "ap_channel_center_frequency_index_2",  "%d",      &p->local_interfaces[i].media_specific_data.ieee80211.ap_channel_center_frequency_index_2);
-                }
-                else if (
-                          (MEDIA_TYPE_IEEE_1901_WAVELET == p->local_interfaces[i].media_type) ||
-                          (MEDIA_TYPE_IEEE_1901_FFT     == p->local_interfaces[i].media_type)
-                        )
-                {
-                    callback(write_function, new_prefix, sizeof(p->local_interfaces[i].media_specific_data.ieee1901.network_identifier), "network_identifier", "0x%02x", p->local_interfaces[i].media_specific_data.ieee1901.network_identifier);
-                }
-
-            }
-
-            return;
-        }
-
-        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:
-        {
-            struct deviceBridgingCapabilityTLV *p;
-            uint8_t i, j;
-
-            p = (struct deviceBridgingCapabilityTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->bridging_tuples_nr), "bridging_tuples_nr", "%d",  &p->bridging_tuples_nr);
-            for (i=0; i < p->bridging_tuples_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%sbridging_tuples[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
-
-                callback(write_function, new_prefix, sizeof(p->bridging_tuples[i].bridging_tuple_macs_nr), "bridging_tuple_macs_nr", "%d",  &p->bridging_tuples[i].bridging_tuple_macs_nr);
-
-                for (j=0; j < p->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                {
-                    snprintf(new_prefix, MAX_PREFIX-1, "%sbridging_tuples[%d]->bridging_tuple_macs[%d]->", tlv_prefix, i, j);
-                    new_prefix[MAX_PREFIX-1] = 0x0;
-
-                    callback(write_function, new_prefix, sizeof(p->bridging_tuples[i].bridging_tuple_macs[j].mac_address), "mac_address", "0x%02x",  p->bridging_tuples[i].bridging_tuple_macs[j].mac_address);
-                }
-            }
-
-            return;
-        }
-
-        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:
-        {
-            struct non1905NeighborDeviceListTLV *p;
-            uint8_t i;
-
-            p = (struct non1905NeighborDeviceListTLV *)tlv;
-
-            if (p->non_1905_neighbors_nr > 0 && NULL == p->non_1905_neighbors)
-            {
-                // Malformed structure
-                return;
-            }
-
-            callback(write_function, tlv_prefix, sizeof(p->local_mac_address),     "local_mac_address",     "0x%02x",   p->local_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->non_1905_neighbors_nr), "non_1905_neighbors_nr", "%d",      &p->non_1905_neighbors_nr);
-            for (i=0; i < p->non_1905_neighbors_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%snon_1905_neighbors[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
-
-                callback(write_function, new_prefix, sizeof(p->non_1905_neighbors[i].mac_address), "mac_address", "0x%02x", p->non_1905_neighbors[i].mac_address);
-            }
-
-            return;
-        }
-
-        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:
-        {
-            struct neighborDeviceListTLV *p;
-            uint8_t i;
-
-            p = (struct neighborDeviceListTLV *)tlv;
-
-            if (p->neighbors_nr > 0 && NULL == p->neighbors)
-            {
-                // Malformed structure
-                return;
-            }
-
-            callback(write_function, tlv_prefix, sizeof(p->local_mac_address), "local_mac_address",  "0x%02x",   p->local_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->neighbors_nr),      "neighbors_nr",       "%d",      &p->neighbors_nr);
-            for (i=0; i < p->neighbors_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%sneighbors[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
-
-                callback(write_function, new_prefix, sizeof(p->neighbors[i].mac_address), "mac_address", "0x%02x",  p->neighbors[i].mac_address);
-                callback(write_function, new_prefix, sizeof(p->neighbors[i].bridge_flag), "bridge_flag", "%d",     &p->neighbors[i].bridge_flag);
-            }
-
-            return;
-        }
-
         case TLV_TYPE_TRANSMITTER_LINK_METRIC:
         {
             struct transmitterLinkMetricTLV *p;
@@ -4739,61 +3796,6 @@ void visit_1905_TLV_structure(struct tlv *tlv, visitor_callback callback, void (
             return;
         }
 
-        case TLV_TYPE_LINK_METRIC_RESULT_CODE:
-        {
-            struct linkMetricResultCodeTLV *p;
-
-            p = (struct linkMetricResultCodeTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->result_code), "result_code",  "%d",  &p->result_code);
-
-            return;
-        }
-
-        case TLV_TYPE_SEARCHED_ROLE:
-        {
-            struct searchedRoleTLV *p;
-
-            p = (struct searchedRoleTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->role), "role",  "%d",  &p->role);
-
-            return;
-        }
-
-        case TLV_TYPE_AUTOCONFIG_FREQ_BAND:
-        {
-            struct autoconfigFreqBandTLV *p;
-
-            p = (struct autoconfigFreqBandTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->freq_band), "freq_band",  "%d",  &p->freq_band);
-
-            return;
-        }
-
-        case TLV_TYPE_SUPPORTED_ROLE:
-        {
-            struct supportedRoleTLV *p;
-
-            p = (struct supportedRoleTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->role), "role",  "%d",  &p->role);
-
-            return;
-        }
-
-        case TLV_TYPE_SUPPORTED_FREQ_BAND:
-        {
-            struct supportedFreqBandTLV *p;
-
-            p = (struct supportedFreqBandTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->freq_band), "freq_band",  "%d",  &p->freq_band);
-
-            return;
-        }
-
         case TLV_TYPE_WSC:
         {
             struct wscTLV *p;
@@ -4854,19 +3856,6 @@ void visit_1905_TLV_structure(struct tlv *tlv, visitor_callback callback, void (
             return;
         }
 
-        case TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
-        {
-            struct pushButtonJoinNotificationTLV *p;
-
-            p = (struct pushButtonJoinNotificationTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->al_mac_address),     "al_mac_address",      "0x%02x",   p->al_mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->message_identifier), "message_identifier",  "%d",      &p->message_identifier);
-            callback(write_function, tlv_prefix, sizeof(p->mac_address),        "mac_address",         "0x%02x",   p->mac_address);
-            callback(write_function, tlv_prefix, sizeof(p->new_mac_address),    "new_mac_address",     "0x%02x",   p->new_mac_address);
-            return;
-        }
-
         case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:
         {
             struct genericPhyDeviceInformationTypeTLV *p;
@@ -4896,18 +3885,6 @@ void visit_1905_TLV_structure(struct tlv *tlv, visitor_callback callback, void (
             return;
         }
 
-        case TLV_TYPE_DEVICE_IDENTIFICATION:
-        {
-            struct deviceIdentificationTypeTLV *p;
-
-            p = (struct deviceIdentificationTypeTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->friendly_name),      "friendly_name",       "%s",   p->friendly_name);
-            callback(write_function, tlv_prefix, sizeof(p->manufacturer_name),  "manufacturer_name",   "%s",   p->manufacturer_name);
-            callback(write_function, tlv_prefix, sizeof(p->manufacturer_model), "manufacturer_model",  "%s",   p->manufacturer_model);
-            return;
-        }
-
         case TLV_TYPE_CONTROL_URL:
         {
             struct controlUrlTypeTLV *p;
@@ -5007,43 +3984,6 @@ void visit_1905_TLV_structure(struct tlv *tlv, visitor_callback callback, void (
             return;
         }
 
-        case TLV_TYPE_1905_PROFILE_VERSION:
-        {
-            struct x1905ProfileVersionTLV *p;
-
-            p = (struct x1905ProfileVersionTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->profile), "profile",  "%d",  &p->profile);
-
-            return;
-        }
-
-        case TLV_TYPE_POWER_OFF_INTERFACE:
-        {
-            struct powerOffInterfaceTLV *p;
-            uint8_t i;
-
-            p = (struct powerOffInterfaceTLV *)tlv;
-
-            callback(write_function, tlv_prefix, sizeof(p->power_off_interfaces_nr), "power_off_interfaces_nr", "%d",  &p->power_off_interfaces_nr);
-            for (i=0; i < p->power_off_interfaces_nr; i++)
-            {
-                char new_prefix[MAX_PREFIX];
-
-                snprintf(new_prefix, MAX_PREFIX-1, "%spower_off_interfaces[%d]->", tlv_prefix, i);
-                new_prefix[MAX_PREFIX-1] = 0x0;
-
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].interface_address),                               "interface_address",       "0x%02x",   p->power_off_interfaces[i].interface_address);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].media_type),                                      "media_type",              "0x%04x",  &p->power_off_interfaces[i].media_type);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.oui),                     "oui",                     "0x%02x",   p->power_off_interfaces[i].generic_phy_common_data.oui);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.variant_index),           "variant_index",           "%d",      &p->power_off_interfaces[i].generic_phy_common_data.variant_index);
-                callback(write_function, new_prefix, sizeof(p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr), "media_specific_bytes_nr", "%d",      &p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr);
-                callback(write_function, new_prefix, p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr,         "media_specific_bytes",    "0x%02x",   p->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
-            }
-
-            return;
-        }
-
         case TLV_TYPE_INTERFACE_POWER_CHANGE_INFORMATION:
         {
             struct interfacePowerChangeInformationTLV *p;
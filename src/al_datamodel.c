@@ -70,75 +70,577 @@
 
 #include <string.h> // memcmp(), memcpy(), ...
 #include <stdio.h>    // snprintf
+#include <stdint.h>   // SIZE_MAX
+#include <limits.h>   // UINT_MAX
 #include <assert.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Private stuff
 ////////////////////////////////////////////////////////////////////////////////
 
+// The TLVs stored for each network device are grouped in "families" (one per
+// TLV type). Each family is summarized with a hash of its raw TLV bytes, so
+// that a response carrying exactly the same information as the previous one
+// can be detected before it is even decoded (see
+// "DMnetworkDeviceInfoUnchanged()").
+//
+enum _tlvFamily
+{
+    FAMILY_INFO = 0,
+    FAMILY_BRIDGES,
+    FAMILY_NON1905_NEIGHBORS,
+    FAMILY_X1905_NEIGHBORS,
+    FAMILY_POWER_OFF,
+    FAMILY_L2_NEIGHBORS,
+    FAMILY_SUPPORTED_SERVICE,
+    FAMILY_GENERIC_PHY,
+    FAMILY_PROFILE,
+    FAMILY_IDENTIFICATION,
+    FAMILY_CONTROL_URL,
+    FAMILY_IPV4,
+    FAMILY_IPV6,
+
+    FAMILIES_NR
+};
+
+#define FAMILY_BIT(f)  ((uint16_t)(1U << (f)))
+
+// Everything that is known about one network device (ie. the TLVs it reported
+// in its last responses).
+//
+// It hangs from the "struct alDevice" with the same AL MAC address (see
+// "alDevice::network_device"), which is how it is found, and it is also kept
+// in the "data_model.network_devices" table so that all of them can be
+// visited in a stable order.
+//
+struct networkDevice
+{
+    struct alDevice                              *device;
+    size_t                                        index;
+                                                    // Position in
+                                                    // "network_devices"
+
+    uint32_t                                      update_timestamp;
+    size_t                                        expiry;
+                                                    // Position in
+                                                    // "expiries" (or
+                                                    // EXPIRY_NONE)
+
+    struct deviceInformationTypeTLV            *info;
+
+    unsigned                                      bridges_nr;
+    struct deviceBridgingCapabilityTLV        **bridges;
+
+    unsigned                                      non1905_neighbors_nr;
+    struct non1905NeighborDeviceListTLV       **non1905_neighbors;
+
+    unsigned                                      x1905_neighbors_nr;
+    struct neighborDeviceListTLV              **x1905_neighbors;
+
+    unsigned                                      power_off_nr;
+    struct powerOffInterfaceTLV               **power_off;
+
+    unsigned                                      l2_neighbors_nr;
+    struct l2NeighborDeviceTLV                **l2_neighbors;
+
+    struct supportedServiceTLV                 *supported_service;
+
+    struct genericPhyDeviceInformationTypeTLV  *generic_phy;
+
+    struct x1905ProfileVersionTLV              *profile;
+
+    struct deviceIdentificationTypeTLV         *identification;
+
+    struct controlUrlTypeTLV                   *control_url;
+
+    struct ipv4TypeTLV                         *ipv4;
+
+    struct ipv6TypeTLV                         *ipv6;
+
+    unsigned                                      metrics_with_neighbors_nr;
+    struct _metricsWithNeighbor
+    {
+        uint8_t                                       neighbor_al_mac_address[6];
+
+        uint32_t                                      tx_metrics_timestamp;
+        struct transmitterLinkMetricTLV            *tx_metrics;
+
+        uint32_t                                      rx_metrics_timestamp;
+        struct receiverLinkMetricTLV               *rx_metrics;
+
+        size_t                                        expiry;
+                                                        // Position in
+                                                        // "expiries"
+
+    }                                          *metrics_with_neighbors;
+
+    uint8_t                                       extensions_nr;
+    struct vendorSpecificTLV                  **extensions;
+
+    uint16_t                                      hashes_known;
+                                                    // FAMILY_BIT() of
+                                                    // each valid hash
+    uint64_t                                      hashes[FAMILIES_NR];
+
+    uint8_t                                       changed;
+                                                    // Set if the last
+                                                    // update modified
+                                                    // any TLV
+};
+
 static struct _dataModel
 {
     uint8_t              map_whole_network_flag;
 
-    uint8_t              network_devices_nr;
+    // Hashes computed by the last call to "DMnetworkDeviceInfoUnchanged()"
+    // that found a difference. They are committed to the device by the
+    // "DMupdateNetworkDeviceInfo()" call that stores the decoded TLVs, or
+    // dropped by "DMnetworkDeviceInfoDone()" if that never happens.
+    //
+    struct
+    {
+        uint8_t   al_mac_address[6];
+        uint16_t  families;              // FAMILY_BIT() of each valid hash
+        uint64_t  hashes[FAMILIES_NR];
+    }                    pending;
 
-    struct _networkDevice
+    // All network devices. Entries never move: when a device is removed its
+    // slot is set to NULL and later reused for a new device. The table
+    // doubles its size when it is full.
+    //
+    // The local device (once its AL MAC address is known) is always the first
+    // one.
+    //
+    struct networkDevice **network_devices;
+    size_t                 network_devices_nr;    // Used slots (some may be NULL)
+    size_t                 network_devices_max;   // Allocated slots
+    size_t                 network_devices_free;  // No NULL slot below this one
+    size_t                 network_devices_count; // Non-NULL slots
+
+    // Deadlines of all network devices (except the local one) and of all the
+    // links they have reported metrics for, kept as a binary min-heap, so that
+    // the garbage collector only needs to look at the entries that have
+    // actually expired.
+    //
+    // Each device and link knows its position in the heap ("expiry" field),
+    // so that its deadline can be moved when it is refreshed.
+    //
+    struct _expiry
     {
-            uint32_t                                      update_timestamp;
+        uint32_t              deadline;  // PLATFORM_GET_TIMESTAMP() units
+        struct networkDevice *device;
+        unsigned              link;      // Index in "metrics_with_neighbors",
+                                         // or EXPIRY_DEVICE for the device
+                                         // itself
+    }                     *expiries;
+    size_t                 expiries_nr;
+    size_t                 expiries_max;
+
+} data_model;
+
+#define EXPIRY_DEVICE  (UINT_MAX)
+#define EXPIRY_NONE    (SIZE_MAX)
+
+static mac_address empty_mac_address = {0, 0, 0, 0, 0, 0};
+
+// Return the "_tlvFamily" a TLV of type 'tlv_type' belongs to, or FAMILIES_NR
+// if TLVs of this type are not stored in the data model.
+//
+static enum _tlvFamily _tlvTypeToFamily(uint8_t tlv_type)
+{
+    switch (tlv_type)
+    {
+        case TLV_TYPE_DEVICE_INFORMATION_TYPE:         return FAMILY_INFO;
+        case TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES:    return FAMILY_BRIDGES;
+        case TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST:   return FAMILY_NON1905_NEIGHBORS;
+        case TLV_TYPE_NEIGHBOR_DEVICE_LIST:            return FAMILY_X1905_NEIGHBORS;
+        case TLV_TYPE_POWER_OFF_INTERFACE:             return FAMILY_POWER_OFF;
+        case TLV_TYPE_L2_NEIGHBOR_DEVICE:              return FAMILY_L2_NEIGHBORS;
+        case TLV_TYPE_SUPPORTED_SERVICE:               return FAMILY_SUPPORTED_SERVICE;
+        case TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION:  return FAMILY_GENERIC_PHY;
+        case TLV_TYPE_1905_PROFILE_VERSION:            return FAMILY_PROFILE;
+        case TLV_TYPE_DEVICE_IDENTIFICATION:           return FAMILY_IDENTIFICATION;
+        case TLV_TYPE_CONTROL_URL:                     return FAMILY_CONTROL_URL;
+        case TLV_TYPE_IPV4:                            return FAMILY_IPV4;
+        case TLV_TYPE_IPV6:                            return FAMILY_IPV6;
+        default:                                       return FAMILIES_NR;
+    }
+}
 
-            struct deviceInformationTypeTLV            *info;
+// Return the TLV families that a CMDU of type 'message_type' replaces when it
+// is processed (see the calls to "DMupdateNetworkDeviceInfo()" in
+// "process1905Cmdu()"), and the type of the TLV that carries the AL MAC address
+// of the reporting device.
+//
+static uint16_t _messageTypeToFamilies(uint16_t message_type, uint8_t *al_mac_tlv_type)
+{
+    switch (message_type)
+    {
+        case CMDU_TYPE_TOPOLOGY_RESPONSE:
+        {
+            *al_mac_tlv_type = TLV_TYPE_DEVICE_INFORMATION_TYPE;
+            return FAMILY_BIT(FAMILY_INFO)              | FAMILY_BIT(FAMILY_BRIDGES)     |
+                   FAMILY_BIT(FAMILY_NON1905_NEIGHBORS) | FAMILY_BIT(FAMILY_X1905_NEIGHBORS) |
+                   FAMILY_BIT(FAMILY_POWER_OFF)         | FAMILY_BIT(FAMILY_L2_NEIGHBORS) |
+                   FAMILY_BIT(FAMILY_SUPPORTED_SERVICE);
+        }
+        case CMDU_TYPE_GENERIC_PHY_RESPONSE:
+        {
+            *al_mac_tlv_type = TLV_TYPE_GENERIC_PHY_DEVICE_INFORMATION;
+            return FAMILY_BIT(FAMILY_GENERIC_PHY);
+        }
+        case CMDU_TYPE_HIGHER_LAYER_RESPONSE:
+        {
+            *al_mac_tlv_type = TLV_TYPE_AL_MAC_ADDRESS_TYPE;
+            return FAMILY_BIT(FAMILY_PROFILE)     | FAMILY_BIT(FAMILY_IDENTIFICATION) |
+                   FAMILY_BIT(FAMILY_CONTROL_URL) | FAMILY_BIT(FAMILY_IPV4)           |
+                   FAMILY_BIT(FAMILY_IPV6);
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
 
-            uint8_t                                       bridges_nr;
-            struct deviceBridgingCapabilityTLV        **bridges;
+// 64 bit FNV-1a
+//
+#define HASH_INIT  (0xcbf29ce484222325ULL)
 
-            uint8_t                                       non1905_neighbors_nr;
-            struct non1905NeighborDeviceListTLV       **non1905_neighbors;
+static uint64_t _hashUpdate(uint64_t h, const uint8_t *p, size_t len)
+{
+    size_t i;
 
-            uint8_t                                       x1905_neighbors_nr;
-            struct neighborDeviceListTLV              **x1905_neighbors;
+    for (i = 0; i < len; i++)
+    {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
 
-            uint8_t                                       power_off_nr;
-            struct powerOffInterfaceTLV               **power_off;
+// Return the entry of the device whose AL MAC address is 'al_mac_address', or
+// NULL if there is none.
+//
+static struct networkDevice *_findNetworkDevice(const uint8_t *al_mac_address)
+{
+    struct alDevice *device = alDeviceFind(al_mac_address);
 
-            uint8_t                                       l2_neighbors_nr;
-            struct l2NeighborDeviceTLV                **l2_neighbors;
+    return NULL == device ? NULL : device->network_device;
+}
 
-            struct supportedServiceTLV                 *supported_service;
+// Return the position field (in the "expiries" heap) of the device or link
+// 'e' refers to.
+//
+static size_t *_expiryPosition(const struct _expiry *e)
+{
+    if (EXPIRY_DEVICE == e->link)
+    {
+        return &e->device->expiry;
+    }
+    return &e->device->metrics_with_neighbors[e->link].expiry;
+}
 
-            struct genericPhyDeviceInformationTypeTLV  *generic_phy;
+// Timestamps wrap around, so they can only be compared through their
+// difference.
+//
+static int _expiryBefore(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
 
-            struct x1905ProfileVersionTLV              *profile;
+static void _expiryPlace(size_t pos, struct _expiry e)
+{
+    data_model.expiries[pos] = e;
+    *_expiryPosition(&e) = pos;
+}
 
-            struct deviceIdentificationTypeTLV         *identification;
+// Restore the heap property for the entry at 'pos', whose deadline has
+// just been set.
+//
+static void _expirySift(size_t pos)
+{
+    struct _expiry e = data_model.expiries[pos];
+    size_t         child;
 
-            struct controlUrlTypeTLV                   *control_url;
+    while (pos > 0 && _expiryBefore(e.deadline, data_model.expiries[(pos - 1) / 2].deadline))
+    {
+        _expiryPlace(pos, data_model.expiries[(pos - 1) / 2]);
+        pos = (pos - 1) / 2;
+    }
 
-            struct ipv4TypeTLV                         *ipv4;
+    while ((child = 2 * pos + 1) < data_model.expiries_nr)
+    {
+        if (child + 1 < data_model.expiries_nr &&
+            _expiryBefore(data_model.expiries[child + 1].deadline, data_model.expiries[child].deadline))
+        {
+            child++;
+        }
+        if (!_expiryBefore(data_model.expiries[child].deadline, e.deadline))
+        {
+            break;
+        }
+        _expiryPlace(pos, data_model.expiries[child]);
+        pos = child;
+    }
 
-            struct ipv6TypeTLV                         *ipv6;
+    _expiryPlace(pos, e);
+}
 
-            uint8_t                                       metrics_with_neighbors_nr;
-            struct _metricsWithNeighbor
-            {
-                uint8_t                                       neighbor_al_mac_address[6];
+// Schedule the expiration of device 'x' (when 'link' is EXPIRY_DEVICE) or of
+// its 'link'-th metrics entry "GC_MAX_AGE" seconds from now.
+//
+static void _expiryAdd(struct networkDevice *x, unsigned link)
+{
+    struct _expiry e;
 
-                uint32_t                                      tx_metrics_timestamp;
-                struct transmitterLinkMetricTLV            *tx_metrics;
+    if (data_model.expiries_nr == data_model.expiries_max)
+    {
+        data_model.expiries_max = 0 == data_model.expiries_max ? 16 : data_model.expiries_max * 2;
+        data_model.expiries     = (struct _expiry *)memrealloc(data_model.expiries, sizeof(struct _expiry) * data_model.expiries_max);
+    }
 
-                uint32_t                                      rx_metrics_timestamp;
-                struct receiverLinkMetricTLV               *rx_metrics;
+    e.deadline = PLATFORM_GET_TIMESTAMP() + GC_MAX_AGE * 1000;
+    e.device   = x;
+    e.link     = link;
 
-            }                                          *metrics_with_neighbors;
+    _expiryPlace(data_model.expiries_nr++, e);
+    _expirySift(data_model.expiries_nr - 1);
+}
 
-            uint8_t                                       extensions_nr;
-            struct vendorSpecificTLV                  **extensions;
+// Move the deadline of the entry at 'pos' to "GC_MAX_AGE" seconds from now.
+//
+static void _expiryRefresh(size_t pos)
+{
+    if (EXPIRY_NONE == pos)
+    {
+        return;
+    }
+    data_model.expiries[pos].deadline = PLATFORM_GET_TIMESTAMP() + GC_MAX_AGE * 1000;
+    _expirySift(pos);
+}
 
-    }                 *network_devices;
-                         // This list will always contain at least ONE entry,
-                         // containing the info of the *local* device.
-} data_model;
+// Unschedule the entry at 'pos'.
+//
+static void _expiryRemove(size_t pos)
+{
+    if (EXPIRY_NONE == pos)
+    {
+        return;
+    }
+    *_expiryPosition(&data_model.expiries[pos]) = EXPIRY_NONE;
 
-static mac_address empty_mac_address = {0, 0, 0, 0, 0, 0};
+    data_model.expiries_nr--;
+    if (pos < data_model.expiries_nr)
+    {
+        _expiryPlace(pos, data_model.expiries[data_model.expiries_nr]);
+        _expirySift(pos);
+    }
+}
+
+// Mark device 'x' as just updated.
+//
+static void _networkDeviceRefresh(struct networkDevice *x)
+{
+    x->update_timestamp = PLATFORM_GET_TIMESTAMP();
+    _expiryRefresh(x->expiry);
+}
+
+// Free the 'link'-th metrics entry of device 'x'. The last entry takes its
+// place.
+//
+static void _metricsLinkFree(struct networkDevice *x, unsigned link)
+{
+    free_1905_TLV_structure(&x->metrics_with_neighbors[link].tx_metrics->tlv);
+    free_1905_TLV_structure(&x->metrics_with_neighbors[link].rx_metrics->tlv);
+    _expiryRemove(x->metrics_with_neighbors[link].expiry);
+
+    x->metrics_with_neighbors_nr--;
+    if (link < x->metrics_with_neighbors_nr)
+    {
+        x->metrics_with_neighbors[link] = x->metrics_with_neighbors[x->metrics_with_neighbors_nr];
+        data_model.expiries[x->metrics_with_neighbors[link].expiry].link = link;
+    }
+}
+
+// Create an (empty) entry for 'device' and add it to the table, in the first
+// free slot.
+//
+static struct networkDevice *_networkDeviceAlloc(struct alDevice *device)
+{
+    struct networkDevice *x;
+
+    x = (struct networkDevice *)zmemalloc(sizeof(struct networkDevice));
+    x->device           = device;
+    x->update_timestamp = PLATFORM_GET_TIMESTAMP();
+    x->expiry           = EXPIRY_NONE;
+
+    while (data_model.network_devices_free < data_model.network_devices_nr &&
+           NULL != data_model.network_devices[data_model.network_devices_free])
+    {
+        data_model.network_devices_free++;
+    }
+    if (data_model.network_devices_free == data_model.network_devices_nr)
+    {
+        if (data_model.network_devices_nr == data_model.network_devices_max)
+        {
+            data_model.network_devices_max = 0 == data_model.network_devices_max ? 16 : data_model.network_devices_max * 2;
+            data_model.network_devices     = (struct networkDevice **)memrealloc(data_model.network_devices, sizeof(struct networkDevice *) * data_model.network_devices_max);
+        }
+        data_model.network_devices_nr++;
+    }
+
+    x->index = data_model.network_devices_free++;
+    data_model.network_devices[x->index] = x;
+    data_model.network_devices_count++;
+
+    device->network_device = x;
+
+    // The local device is updated on demand, so it never expires
+    //
+    if (device != local_device)
+    {
+        _expiryAdd(x, EXPIRY_DEVICE);
+    }
+
+    return x;
+}
+
+// Free all the TLVs of entry 'x', remove it from the table and free it.
+//
+static void _networkDeviceFree(struct networkDevice *x)
+{
+    unsigned j;
+
+    if (NULL != x->info)
+    {
+        free_1905_TLV_structure(&x->info->tlv);
+    }
+
+    for (j=0; j<x->bridges_nr; j++)
+    {
+        free_1905_TLV_structure(&x->bridges[j]->tlv);
+    }
+    memfree(x->bridges);
+
+    for (j=0; j<x->non1905_neighbors_nr; j++)
+    {
+        free_1905_TLV_structure(&x->non1905_neighbors[j]->tlv);
+    }
+    memfree(x->non1905_neighbors);
+
+    for (j=0; j<x->x1905_neighbors_nr; j++)
+    {
+        free_1905_TLV_structure(&x->x1905_neighbors[j]->tlv);
+    }
+    memfree(x->x1905_neighbors);
+
+    for (j=0; j<x->power_off_nr; j++)
+    {
+        free_1905_TLV_structure(&x->power_off[j]->tlv);
+    }
+    memfree(x->power_off);
+
+    for (j=0; j<x->l2_neighbors_nr; j++)
+    {
+        free_1905_TLV_structure(&x->l2_neighbors[j]->tlv);
+    }
+    memfree(x->l2_neighbors);
+
+    if (NULL != x->supported_service)
+    {
+        free_1905_TLV_structure(&x->supported_service->tlv);
+    }
+    if (NULL != x->generic_phy)
+    {
+        free_1905_TLV_structure(&x->generic_phy->tlv);
+    }
+    if (NULL != x->profile)
+    {
+        free_1905_TLV_structure(&x->profile->tlv);
+    }
+    if (NULL != x->identification)
+    {
+        free_1905_TLV_structure(&x->identification->tlv);
+    }
+    if (NULL != x->control_url)
+    {
+        free_1905_TLV_structure(&x->control_url->tlv);
+    }
+    if (NULL != x->ipv4)
+    {
+        free_1905_TLV_structure(&x->ipv4->tlv);
+    }
+    if (NULL != x->ipv6)
+    {
+        free_1905_TLV_structure(&x->ipv6->tlv);
+    }
+
+    while (x->metrics_with_neighbors_nr > 0)
+    {
+        _metricsLinkFree(x, x->metrics_with_neighbors_nr - 1);
+    }
+    memfree(x->metrics_with_neighbors);
+
+    _expiryRemove(x->expiry);
+
+    data_model.network_devices[x->index] = NULL;
+    data_model.network_devices_count--;
+    if (x->index < data_model.network_devices_free)
+    {
+        data_model.network_devices_free = x->index;
+    }
+
+    x->device->network_device = NULL;
+    memfree(x);
+}
+
+// Record that the families in 'updated' of device 'x' have just been replaced
+// and update its "changed" flag accordingly.
+//
+// If the new content came from the CMDU last seen by
+// "DMnetworkDeviceInfoUnchanged()", its hashes are kept so that the next
+// identical CMDU can be detected. Otherwise the content is unknown and is
+// considered to have changed.
+//
+static void _commitHashes(struct networkDevice *x, const uint8_t *al_mac_address, uint16_t updated)
+{
+    uint8_t f;
+
+    x->changed = 0;
+
+    if (0 != data_model.pending.families && 0 == memcmp(data_model.pending.al_mac_address, al_mac_address, 6))
+    {
+        for (f = 0; f < FAMILIES_NR; f++)
+        {
+            if (0 == (updated & FAMILY_BIT(f)))
+            {
+                continue;
+            }
+            if (0 == (data_model.pending.families & FAMILY_BIT(f)))
+            {
+                x->hashes_known &= ~FAMILY_BIT(f);
+                x->changed       = 1;
+            }
+            else
+            {
+                if (0 == (x->hashes_known & FAMILY_BIT(f)) || x->hashes[f] != data_model.pending.hashes[f])
+                {
+                    x->changed = 1;
+                }
+                x->hashes[f]     = data_model.pending.hashes[f];
+                x->hashes_known |= FAMILY_BIT(f);
+            }
+        }
+    }
+    else if (0 != updated)
+    {
+        x->hashes_known &= ~updated;
+        x->changed       = 1;
+    }
+
+    data_model.pending.families = 0;
+}
 
 // Given an 'al_mac_address', return a pointer to the neighbor's "struct alDevice" that
 // represents a 1905 neighbor with that 'al_mac_address' visible from the
@@ -191,35 +693,17 @@ void DMinit()
     datamodelInit();
 
     data_model.map_whole_network_flag   = 0;
+    data_model.pending.families         = 0;
 
-    // Regarding the "network_devices" list, we will init it with one element,
-    // representing the local node
-    //
-    data_model.network_devices_nr       = 1;
-    data_model.network_devices          = (struct _networkDevice *)memalloc(sizeof(struct _networkDevice));
-
-    data_model.network_devices[0].update_timestamp          = PLATFORM_GET_TIMESTAMP();
-    data_model.network_devices[0].info                      = NULL;
-    data_model.network_devices[0].bridges_nr                = 0;
-    data_model.network_devices[0].bridges                   = NULL;
-    data_model.network_devices[0].non1905_neighbors_nr      = 0;
-    data_model.network_devices[0].non1905_neighbors         = NULL;
-    data_model.network_devices[0].x1905_neighbors_nr        = 0;
-    data_model.network_devices[0].x1905_neighbors           = NULL;
-    data_model.network_devices[0].power_off_nr              = 0;
-    data_model.network_devices[0].power_off                 = NULL;
-    data_model.network_devices[0].l2_neighbors_nr           = 0;
-    data_model.network_devices[0].l2_neighbors              = NULL;
-    data_model.network_devices[0].generic_phy               = NULL;
-    data_model.network_devices[0].profile                   = NULL;
-    data_model.network_devices[0].identification            = NULL;
-    data_model.network_devices[0].control_url               = NULL;
-    data_model.network_devices[0].ipv4                      = NULL;
-    data_model.network_devices[0].ipv6                      = NULL;
-    data_model.network_devices[0].metrics_with_neighbors_nr = 0;
-    data_model.network_devices[0].metrics_with_neighbors    = NULL;
-    data_model.network_devices[0].extensions                = NULL;
-    data_model.network_devices[0].extensions_nr             = 0;
+    data_model.network_devices          = NULL;
+    data_model.network_devices_nr       = 0;
+    data_model.network_devices_max      = 0;
+    data_model.network_devices_free     = 0;
+    data_model.network_devices_count    = 0;
+
+    data_model.expiries                 = NULL;
+    data_model.expiries_nr              = 0;
+    data_model.expiries_max             = 0;
 
     return;
 }
@@ -230,6 +714,10 @@ void DMalMacSet(uint8_t *al_mac_address)
     local_device = alDeviceAlloc(al_mac_address);
     local_device->configured = false;
 
+    // The local device is the first entry of the network devices table
+    //
+    _networkDeviceAlloc(local_device);
+
     return;
 }
 
@@ -729,11 +1217,11 @@ uint8_t *DMmacToAlMac(uint8_t *mac_address)
 
 uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
                                 uint8_t in_update,  struct deviceInformationTypeTLV             *info,
-                                uint8_t br_update,  struct deviceBridgingCapabilityTLV         **bridges,           uint8_t bridges_nr,
-                                uint8_t no_update,  struct non1905NeighborDeviceListTLV        **non1905_neighbors, uint8_t non1905_neighbors_nr,
-                                uint8_t x1_update,  struct neighborDeviceListTLV               **x1905_neighbors,   uint8_t x1905_neighbors_nr,
-                                uint8_t po_update,  struct powerOffInterfaceTLV                **power_off,         uint8_t power_off_nr,
-                                uint8_t l2_update,  struct l2NeighborDeviceTLV                 **l2_neighbors,      uint8_t l2_neighbors_nr,
+                                uint8_t br_update,  struct deviceBridgingCapabilityTLV         **bridges,           unsigned bridges_nr,
+                                uint8_t no_update,  struct non1905NeighborDeviceListTLV        **non1905_neighbors, unsigned non1905_neighbors_nr,
+                                uint8_t x1_update,  struct neighborDeviceListTLV               **x1905_neighbors,   unsigned x1905_neighbors_nr,
+                                uint8_t po_update,  struct powerOffInterfaceTLV                **power_off,         unsigned power_off_nr,
+                                uint8_t l2_update,  struct l2NeighborDeviceTLV                 **l2_neighbors,      unsigned l2_neighbors_nr,
                                 uint8_t ss_update,  struct supportedServiceTLV                  *supported_service,
                                 uint8_t ge_update,  struct genericPhyDeviceInformationTypeTLV   *generic_phy,
                                 uint8_t pr_update,  struct x1905ProfileVersionTLV               *profile,
@@ -742,7 +1230,9 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
                                 uint8_t v4_update,  struct ipv4TypeTLV                          *ipv4,
                                 uint8_t v6_update,  struct ipv6TypeTLV                          *ipv6)
 {
-    uint8_t i,j;
+    struct networkDevice *x;
+    unsigned j;
+    uint16_t updated;
 
     if (
          (NULL == al_mac_address)                                                     ||
@@ -756,28 +1246,25 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
         return 0;
     }
 
+    updated = (NULL != info      ? FAMILY_BIT(FAMILY_INFO)              : 0) |
+              (1 == br_update    ? FAMILY_BIT(FAMILY_BRIDGES)           : 0) |
+              (1 == no_update    ? FAMILY_BIT(FAMILY_NON1905_NEIGHBORS) : 0) |
+              (1 == x1_update    ? FAMILY_BIT(FAMILY_X1905_NEIGHBORS)   : 0) |
+              (1 == po_update    ? FAMILY_BIT(FAMILY_POWER_OFF)         : 0) |
+              (1 == l2_update    ? FAMILY_BIT(FAMILY_L2_NEIGHBORS)      : 0) |
+              (1 == ss_update    ? FAMILY_BIT(FAMILY_SUPPORTED_SERVICE) : 0) |
+              (1 == ge_update    ? FAMILY_BIT(FAMILY_GENERIC_PHY)       : 0) |
+              (1 == pr_update    ? FAMILY_BIT(FAMILY_PROFILE)           : 0) |
+              (1 == id_update    ? FAMILY_BIT(FAMILY_IDENTIFICATION)    : 0) |
+              (1 == co_update    ? FAMILY_BIT(FAMILY_CONTROL_URL)       : 0) |
+              (1 == v4_update    ? FAMILY_BIT(FAMILY_IPV4)              : 0) |
+              (1 == v6_update    ? FAMILY_BIT(FAMILY_IPV6)              : 0);
+
     // First, search for an existing entry with the same AL MAC address
-    // Remember that the first entry holds a reference to the *local* node.
     //
-    if (0 == memcmp(DMalMacGet(), al_mac_address, 6))
-    {
-        i=0;
-    }
-    else
-    {
-        for (i=1; i<data_model.network_devices_nr; i++)
-        {
-            if (NULL != data_model.network_devices[i].info)
-            {
-                if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, al_mac_address, 6))
-                {
-                    break;
-                }
-            }
-        }
-    }
+    x = _findNetworkDevice(al_mac_address);
 
-    if (i == data_model.network_devices_nr)
+    if (NULL == x)
     {
         // A matching entry was *not* found. Create a new one, but only if this
         // new information contains the "info" TLV (otherwise don't do anything
@@ -785,42 +1272,38 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
         //
         if (1 == in_update && NULL != info)
         {
-            if (0 == data_model.network_devices_nr)
-            {
-                data_model.network_devices = (struct _networkDevice *)memalloc(sizeof(struct _networkDevice));
-            }
-            else
+            struct alDevice *device;
+
+            // Devices that are not direct neighbors (ie. when mapping the
+            // whole network) are only known through this information
+            //
+            device = alDeviceFind(al_mac_address);
+            if (NULL == device)
             {
-                data_model.network_devices = (struct _networkDevice *)memrealloc(data_model.network_devices, sizeof(struct _networkDevice)*(data_model.network_devices_nr+1));
+                device = alDeviceAlloc(al_mac_address);
             }
-
-            data_model.network_devices[data_model.network_devices_nr].update_timestamp          = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[data_model.network_devices_nr].info                      = 1 == in_update ? info                 : NULL;
-            data_model.network_devices[data_model.network_devices_nr].bridges_nr                = 1 == br_update ? bridges_nr           : 0;
-            data_model.network_devices[data_model.network_devices_nr].bridges                   = 1 == br_update ? bridges              : NULL;
-            data_model.network_devices[data_model.network_devices_nr].non1905_neighbors_nr      = 1 == no_update ? non1905_neighbors_nr : 0;
-            data_model.network_devices[data_model.network_devices_nr].non1905_neighbors         = 1 == no_update ? non1905_neighbors    : NULL;
-            data_model.network_devices[data_model.network_devices_nr].x1905_neighbors_nr        = 1 == x1_update ? x1905_neighbors_nr   : 0;
-            data_model.network_devices[data_model.network_devices_nr].x1905_neighbors           = 1 == x1_update ? x1905_neighbors      : NULL;
-            data_model.network_devices[data_model.network_devices_nr].power_off_nr              = 1 == po_update ? power_off_nr         : 0;
-            data_model.network_devices[data_model.network_devices_nr].power_off                 = 1 == po_update ? power_off            : NULL;
-            data_model.network_devices[data_model.network_devices_nr].l2_neighbors_nr           = 1 == l2_update ? l2_neighbors_nr      : 0;
-            data_model.network_devices[data_model.network_devices_nr].l2_neighbors              = 1 == l2_update ? l2_neighbors         : NULL;
-            data_model.network_devices[data_model.network_devices_nr].supported_service         = 1 == ss_update ? supported_service    : NULL;
-            data_model.network_devices[data_model.network_devices_nr].generic_phy               = 1 == ge_update ? generic_phy          : NULL;
-            data_model.network_devices[data_model.network_devices_nr].profile                   = 1 == pr_update ? profile              : NULL;
-            data_model.network_devices[data_model.network_devices_nr].identification            = 1 == id_update ? identification       : NULL;
-            data_model.network_devices[data_model.network_devices_nr].control_url               = 1 == co_update ? control_url          : NULL;
-            data_model.network_devices[data_model.network_devices_nr].ipv4                      = 1 == v4_update ? ipv4                 : NULL;
-            data_model.network_devices[data_model.network_devices_nr].ipv6                      = 1 == v6_update ? ipv6                 : NULL;
-
-            data_model.network_devices[data_model.network_devices_nr].metrics_with_neighbors_nr = 0;
-            data_model.network_devices[data_model.network_devices_nr].metrics_with_neighbors    = NULL;
-
-            data_model.network_devices[data_model.network_devices_nr].extensions                = NULL;
-            data_model.network_devices[data_model.network_devices_nr].extensions_nr             = 0;
-
-            data_model.network_devices_nr++;
+            x = _networkDeviceAlloc(device);
+
+            x->info                      = 1 == in_update ? info                 : NULL;
+            x->bridges_nr                = 1 == br_update ? bridges_nr           : 0;
+            x->bridges                   = 1 == br_update ? bridges              : NULL;
+            x->non1905_neighbors_nr      = 1 == no_update ? non1905_neighbors_nr : 0;
+            x->non1905_neighbors         = 1 == no_update ? non1905_neighbors    : NULL;
+            x->x1905_neighbors_nr        = 1 == x1_update ? x1905_neighbors_nr   : 0;
+            x->x1905_neighbors           = 1 == x1_update ? x1905_neighbors      : NULL;
+            x->power_off_nr              = 1 == po_update ? power_off_nr         : 0;
+            x->power_off                 = 1 == po_update ? power_off            : NULL;
+            x->l2_neighbors_nr           = 1 == l2_update ? l2_neighbors_nr      : 0;
+            x->l2_neighbors              = 1 == l2_update ? l2_neighbors         : NULL;
+            x->supported_service         = 1 == ss_update ? supported_service    : NULL;
+            x->generic_phy               = 1 == ge_update ? generic_phy          : NULL;
+            x->profile                   = 1 == pr_update ? profile              : NULL;
+            x->identification            = 1 == id_update ? identification       : NULL;
+            x->control_url               = 1 == co_update ? control_url          : NULL;
+            x->ipv4                      = 1 == v4_update ? ipv4                 : NULL;
+            x->ipv6                      = 1 == v6_update ? ipv6                 : NULL;
+
+            _commitHashes(x, al_mac_address, updated);
         }
     }
     else
@@ -829,152 +1312,248 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
         // structures (but only if a new value was provided!... otherwise retain
         // the old item)
         //
-        data_model.network_devices[i].update_timestamp = PLATFORM_GET_TIMESTAMP();
+        _networkDeviceRefresh(x);
 
         if (NULL != info)
         {
-            if (NULL != data_model.network_devices[i].info)
+            if (NULL != x->info)
             {
-                free_1905_TLV_structure(&data_model.network_devices[i].info->tlv);
+                free_1905_TLV_structure(&x->info->tlv);
             }
-            data_model.network_devices[i].info = info;
+            x->info = info;
         }
 
         if (1 == br_update)
         {
-            for (j=0; j<data_model.network_devices[i].bridges_nr; j++)
+            for (j=0; j<x->bridges_nr; j++)
             {
-                free_1905_TLV_structure(&data_model.network_devices[i].bridges[j]->tlv);
+                free_1905_TLV_structure(&x->bridges[j]->tlv);
             }
-            if (data_model.network_devices[i].bridges_nr > 0 && NULL != data_model.network_devices[i].bridges)
+            if (x->bridges_nr > 0 && NULL != x->bridges)
             {
-                free(data_model.network_devices[i].bridges);
+                memfree(x->bridges);
             }
-            data_model.network_devices[i].bridges_nr = bridges_nr;
-            data_model.network_devices[i].bridges    = bridges;
+            x->bridges_nr = bridges_nr;
+            x->bridges    = bridges;
         }
 
         if (1 == no_update)
         {
-            for (j=0; j<data_model.network_devices[i].non1905_neighbors_nr; j++)
+            for (j=0; j<x->non1905_neighbors_nr; j++)
             {
-                free_1905_TLV_structure(&data_model.network_devices[i].non1905_neighbors[j]->tlv);
+                free_1905_TLV_structure(&x->non1905_neighbors[j]->tlv);
             }
-            if (data_model.network_devices[i].non1905_neighbors_nr > 0 && NULL != data_model.network_devices[i].non1905_neighbors)
+            if (x->non1905_neighbors_nr > 0 && NULL != x->non1905_neighbors)
             {
-                free(data_model.network_devices[i].non1905_neighbors);
+                memfree(x->non1905_neighbors);
             }
-            data_model.network_devices[i].non1905_neighbors_nr = non1905_neighbors_nr;
-            data_model.network_devices[i].non1905_neighbors    = non1905_neighbors;
+            x->non1905_neighbors_nr = non1905_neighbors_nr;
+            x->non1905_neighbors    = non1905_neighbors;
         }
 
         if (1 == x1_update)
         {
-            for (j=0; j<data_model.network_devices[i].x1905_neighbors_nr; j++)
+            for (j=0; j<x->x1905_neighbors_nr; j++)
             {
-                free_1905_TLV_structure(&data_model.network_devices[i].x1905_neighbors[j]->tlv);
+                free_1905_TLV_structure(&x->x1905_neighbors[j]->tlv);
             }
-            if (data_model.network_devices[i].x1905_neighbors_nr > 0 && NULL != data_model.network_devices[i].x1905_neighbors)
+            if (x->x1905_neighbors_nr > 0 && NULL != x->x1905_neighbors)
             {
-                free(data_model.network_devices[i].x1905_neighbors);
+                memfree(x->x1905_neighbors);
             }
-            data_model.network_devices[i].x1905_neighbors_nr = x1905_neighbors_nr;
-            data_model.network_devices[i].x1905_neighbors    = x1905_neighbors;
+            x->x1905_neighbors_nr = x1905_neighbors_nr;
+            x->x1905_neighbors    = x1905_neighbors;
         }
 
         if (1 == po_update)
         {
-            for (j=0; j<data_model.network_devices[i].power_off_nr; j++)
+            for (j=0; j<x->power_off_nr; j++)
             {
-                free_1905_TLV_structure(&data_model.network_devices[i].power_off[j]->tlv);
+                free_1905_TLV_structure(&x->power_off[j]->tlv);
             }
-            if (data_model.network_devices[i].power_off_nr > 0 && NULL != data_model.network_devices[i].power_off)
+            if (x->power_off_nr > 0 && NULL != x->power_off)
             {
-                free(data_model.network_devices[i].power_off);
+                memfree(x->power_off);
             }
-            data_model.network_devices[i].power_off_nr = power_off_nr;
-            data_model.network_devices[i].power_off    = power_off;
+            x->power_off_nr = power_off_nr;
+            x->power_off    = power_off;
         }
 
         if (1 == l2_update)
         {
-            for (j=0; j<data_model.network_devices[i].l2_neighbors_nr; j++)
+            for (j=0; j<x->l2_neighbors_nr; j++)
             {
-                free_1905_TLV_structure(&data_model.network_devices[i].l2_neighbors[j]->tlv);
+                free_1905_TLV_structure(&x->l2_neighbors[j]->tlv);
             }
-            if (data_model.network_devices[i].l2_neighbors_nr > 0 && NULL != data_model.network_devices[i].l2_neighbors)
+            if (x->l2_neighbors_nr > 0 && NULL != x->l2_neighbors)
             {
-                free(data_model.network_devices[i].l2_neighbors);
+                memfree(x->l2_neighbors);
             }
-            data_model.network_devices[i].l2_neighbors_nr = l2_neighbors_nr;
-            data_model.network_devices[i].l2_neighbors    = l2_neighbors;
+            x->l2_neighbors_nr = l2_neighbors_nr;
+            x->l2_neighbors    = l2_neighbors;
         }
 
         if (1 == ss_update)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].supported_service->tlv);
-            data_model.network_devices[i].supported_service = supported_service;
+            free_1905_TLV_structure(&x->supported_service->tlv);
+            x->supported_service = supported_service;
         }
 
         if (1 == ge_update)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].generic_phy->tlv);
-            data_model.network_devices[i].generic_phy = generic_phy;
+            free_1905_TLV_structure(&x->generic_phy->tlv);
+            x->generic_phy = generic_phy;
         }
 
         if (1 == pr_update)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].profile->tlv);
-            data_model.network_devices[i].profile = profile;
+            free_1905_TLV_structure(&x->profile->tlv);
+            x->profile = profile;
         }
 
         if (1 == id_update)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].identification->tlv);
-            data_model.network_devices[i].identification = identification;
+            free_1905_TLV_structure(&x->identification->tlv);
+            x->identification = identification;
         }
 
         if (1 == co_update)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].control_url->tlv);
-            data_model.network_devices[i].control_url = control_url;
+            free_1905_TLV_structure(&x->control_url->tlv);
+            x->control_url = control_url;
         }
 
         if (1 == v4_update)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].ipv4->tlv);
-            data_model.network_devices[i].ipv4 = ipv4;
+            free_1905_TLV_structure(&x->ipv4->tlv);
+            x->ipv4 = ipv4;
         }
 
         if (1 == v6_update)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].ipv6->tlv);
-            data_model.network_devices[i].ipv6 = ipv6;
+            free_1905_TLV_structure(&x->ipv6->tlv);
+            x->ipv6 = ipv6;
         }
 
+        _commitHashes(x, al_mac_address, updated);
     }
 
     return 1;
 }
 
-uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address)
+uint8_t DMnetworkDeviceInfoUnchanged(const struct CMDU_view *view)
 {
-    uint8_t i;
+    const struct CMDU_view_tlv *al_mac_tlv;
+    struct networkDevice       *x;
 
-    // First, search for an existing entry with the same AL MAC address
+    uint16_t  families;
+    uint8_t   al_mac_tlv_type;
+    uint64_t  hashes[FAMILIES_NR];
+    unsigned  i;
+
+    data_model.pending.families = 0;
+
+    families = _messageTypeToFamilies(view->message_type, &al_mac_tlv_type);
+    if (0 == families)
+    {
+        return 0;
+    }
+
+    // All the AL MAC carrying TLVs start with the AL MAC address
     //
-    for (i=0; i<data_model.network_devices_nr; i++)
+    al_mac_tlv = get_1905_CMDU_view_TLV(view, al_mac_tlv_type);
+    if (NULL == al_mac_tlv || al_mac_tlv->length < 6)
+    {
+        return 0;
+    }
+
+    // Hash the raw bytes (header included) of the TLVs of each family, in the
+    // order in which they were received.
+    //
+    for (i = 0; i < FAMILIES_NR; i++)
+    {
+        hashes[i] = HASH_INIT;
+    }
+    for (i = 0; i < view->tlvs_nr; i++)
+    {
+        enum _tlvFamily f = _tlvTypeToFamily(view->tlvs[i].type);
+
+        if (FAMILIES_NR == f || 0 == (families & FAMILY_BIT(f)))
+        {
+            continue;
+        }
+        hashes[f] = _hashUpdate(hashes[f], view->tlvs[i].value - 3, view->tlvs[i].length + 3);
+    }
+
+    x = _findNetworkDevice(al_mac_tlv->value);
+    if (NULL != x && families == (x->hashes_known & families))
     {
-        if (NULL != data_model.network_devices[i].info)
+        for (i = 0; i < FAMILIES_NR; i++)
         {
-            if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, al_mac_address, 6))
+            if ((families & FAMILY_BIT(i)) && x->hashes[i] != hashes[i])
             {
                 break;
             }
         }
+        if (FAMILIES_NR == i)
+        {
+            _networkDeviceRefresh(x);
+            x->changed = 0;
+            return 1;
+        }
     }
 
-    if (i == data_model.network_devices_nr)
+    // Something is different (or unknown). Keep the hashes until the decoded
+    // TLVs are stored.
+    //
+    memcpy(data_model.pending.al_mac_address, al_mac_tlv->value, 6);
+    memcpy(data_model.pending.hashes, hashes, sizeof(hashes));
+    data_model.pending.families = families;
+
+    return 0;
+}
+
+void DMnetworkDeviceInfoDone(void)
+{
+    data_model.pending.families = 0;
+}
+
+uint8_t DMnetworkDeviceChanged(uint8_t *al_mac_address)
+{
+    struct networkDevice *x;
+
+    x = _findNetworkDevice(al_mac_address);
+
+    return NULL == x ? 0 : x->changed;
+}
+
+uint8_t DMnetworkDeviceTopologyGet(uint8_t *al_mac_address, struct deviceInformationTypeTLV **info,
+                                   struct neighborDeviceListTLV ***x1905_neighbors, unsigned *x1905_neighbors_nr)
+{
+    struct networkDevice *x;
+
+    x = _findNetworkDevice(al_mac_address);
+    if (NULL == x || NULL == x->info)
+    {
+        return 0;
+    }
+
+    *info               = x->info;
+    *x1905_neighbors    = x->x1905_neighbors;
+    *x1905_neighbors_nr = x->x1905_neighbors_nr;
+
+    return 1;
+}
+
+uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address)
+{
+    struct networkDevice *x;
+
+    // First, search for an existing entry with the same AL MAC address
+    //
+    x = _findNetworkDevice(al_mac_address);
+
+    if (NULL == x || NULL == x->info)
     {
         // A matching entry was *not* found. Thus a refresh of the information
         // is needed.
@@ -985,7 +1564,7 @@ uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address)
     {
         // A matching entry was found. Check its timestamp.
         //
-        if (PLATFORM_GET_TIMESTAMP() - data_model.network_devices[i].update_timestamp > MAX_AGE * 1000)
+        if (PLATFORM_GET_TIMESTAMP() - x->update_timestamp > MAX_AGE * 1000)
         {
             return 1;
         }
@@ -1001,7 +1580,8 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics)
     uint8_t *FROM_al_mac_address;  // Metrics are reported FROM this AL entity...
     uint8_t *TO_al_mac_address;    // ... TO this other one.
 
-    uint8_t i, j;
+    struct networkDevice *x;
+    unsigned j;
 
     if (NULL == metrics)
     {
@@ -1040,23 +1620,13 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics)
 
     // Next, search for an existing entry with the same AL MAC address
     //
-    for (i=0; i<data_model.network_devices_nr; i++)
-    {
-        if (NULL == data_model.network_devices[i].info)
-        {
-            // We haven't received general info about this device yet.
-            // This can happen, for example, when only metrics have been
-            // received so far.
-            //
-            continue;
-        }
-        if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, FROM_al_mac_address, 6))
-        {
-            break;
-        }
-    }
+    // If we haven't received general info about this device yet (this can
+    // happen, for example, when only metrics have been received so far) it is
+    // treated as unknown.
+    //
+    x = _findNetworkDevice(FROM_al_mac_address);
 
-    if (i == data_model.network_devices_nr)
+    if (NULL == x || NULL == x->info)
     {
         // A matching entry was *not* found.
         //
@@ -1075,47 +1645,41 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics)
     // new one) search for a sub-entry that matches the AL MAC of the node the
     // metrics are being reported against.
     //
-    for (j=0; j<data_model.network_devices[i].metrics_with_neighbors_nr; j++)
+    for (j=0; j<x->metrics_with_neighbors_nr; j++)
     {
-        if (0 == memcmp(data_model.network_devices[i].metrics_with_neighbors[j].neighbor_al_mac_address, TO_al_mac_address, 6))
+        if (0 == memcmp(x->metrics_with_neighbors[j].neighbor_al_mac_address, TO_al_mac_address, 6))
         {
             break;
         }
     }
 
-    if (j == data_model.network_devices[i].metrics_with_neighbors_nr)
+    if (j == x->metrics_with_neighbors_nr)
     {
         // A matching entry was *not* found. Create a new one
         //
-        if (0 == data_model.network_devices[i].metrics_with_neighbors_nr)
-        {
-            data_model.network_devices[i].metrics_with_neighbors = (struct _metricsWithNeighbor *)memalloc(sizeof(struct _metricsWithNeighbor));
-        }
-        else
-        {
-            data_model.network_devices[i].metrics_with_neighbors = (struct _metricsWithNeighbor *)memrealloc(data_model.network_devices[i].metrics_with_neighbors, sizeof(struct _metricsWithNeighbor)*(data_model.network_devices[i].metrics_with_neighbors_nr+1));
-        }
+        x->metrics_with_neighbors = (struct _metricsWithNeighbor *)memrealloc(x->metrics_with_neighbors, sizeof(struct _metricsWithNeighbor)*(x->metrics_with_neighbors_nr+1));
 
-        memcpy(data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].neighbor_al_mac_address, TO_al_mac_address, 6);
+        memcpy(x->metrics_with_neighbors[x->metrics_with_neighbors_nr].neighbor_al_mac_address, TO_al_mac_address, 6);
 
         if (TLV_TYPE_TRANSMITTER_LINK_METRIC == *metrics)
         {
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics           = (struct transmitterLinkMetricTLV*)metrics;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics           = (struct transmitterLinkMetricTLV*)metrics;
 
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics_timestamp = 0;
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics           = NULL;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics_timestamp = 0;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics           = NULL;
         }
         else
         {
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics_timestamp = 0;
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].tx_metrics           = NULL;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics_timestamp = 0;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].tx_metrics           = NULL;
 
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[data_model.network_devices[i].metrics_with_neighbors_nr].rx_metrics           = (struct receiverLinkMetricTLV*)metrics;
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
+            x->metrics_with_neighbors[x->metrics_with_neighbors_nr].rx_metrics           = (struct receiverLinkMetricTLV*)metrics;
         }
 
-        data_model.network_devices[i].metrics_with_neighbors_nr++;
+        _expiryAdd(x, x->metrics_with_neighbors_nr);
+        x->metrics_with_neighbors_nr++;
     }
     else
     {
@@ -1124,18 +1688,20 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics)
         //
         if (TLV_TYPE_TRANSMITTER_LINK_METRIC == *metrics)
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics->tlv);
+            free_1905_TLV_structure(&x->metrics_with_neighbors[j].tx_metrics->tlv);
 
-            data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics           = (struct transmitterLinkMetricTLV*)metrics;
+            x->metrics_with_neighbors[j].tx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
+            x->metrics_with_neighbors[j].tx_metrics           = (struct transmitterLinkMetricTLV*)metrics;
         }
         else
         {
-            free_1905_TLV_structure(&data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics->tlv);
+            free_1905_TLV_structure(&x->metrics_with_neighbors[j].rx_metrics->tlv);
 
-            data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
-            data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics           = (struct receiverLinkMetricTLV*)metrics;
+            x->metrics_with_neighbors[j].rx_metrics_timestamp = PLATFORM_GET_TIMESTAMP();
+            x->metrics_with_neighbors[j].rx_metrics           = (struct receiverLinkMetricTLV*)metrics;
         }
+
+        _expiryRefresh(x->metrics_with_neighbors[j].expiry);
     }
 
     return 1;
@@ -1148,116 +1714,123 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...))
     //
     #define MAX_PREFIX  100
 
-    uint8_t  i, j;
+    size_t    i;
+    unsigned  j;
 
     write_function("\n");
 
-    write_function("  device_nr: %d\n", data_model.network_devices_nr);
+    write_function("  device_nr: %zu\n", data_model.network_devices_count);
 
     for (i=0; i<data_model.network_devices_nr; i++)
     {
+        struct networkDevice *x = data_model.network_devices[i];
         char new_prefix[MAX_PREFIX];
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->", i);
+        if (NULL == x)
+        {
+            continue;
+        }
+
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        write_function("%supdate timestamp: %d\n", new_prefix, data_model.network_devices[i].update_timestamp);
+        write_function("%supdate timestamp: %u\n", new_prefix, x->update_timestamp);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->general_info->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->general_info->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure(&data_model.network_devices[i].info->tlv, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure(&x->info->tlv, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->bridging_capabilities_nr: %d", i, data_model.network_devices[i].bridges_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->bridging_capabilities_nr: %u", i, x->bridges_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].bridges_nr; j++)
+        for (j=0; j<x->bridges_nr; j++)
         {
-            snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->bridging_capabilities[%d]->", i, j);
+            snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->bridging_capabilities[%u]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure(&data_model.network_devices[i].bridges[j]->tlv, print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure(&x->bridges[j]->tlv, print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->non_1905_neighbors_nr: %d", i, data_model.network_devices[i].non1905_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->non_1905_neighbors_nr: %u", i, x->non1905_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].non1905_neighbors_nr; j++)
+        for (j=0; j<x->non1905_neighbors_nr; j++)
         {
-            snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->non_1905_neighbors[%d]->", i, j);
+            snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->non_1905_neighbors[%u]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure(&data_model.network_devices[i].non1905_neighbors[j]->tlv, print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure(&x->non1905_neighbors[j]->tlv, print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->x1905_neighbors_nr: %d", i, data_model.network_devices[i].x1905_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->x1905_neighbors_nr: %u", i, x->x1905_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].x1905_neighbors_nr; j++)
+        for (j=0; j<x->x1905_neighbors_nr; j++)
         {
-            snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->x1905_neighbors[%d]->", i, j);
+            snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->x1905_neighbors[%u]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure(&data_model.network_devices[i].x1905_neighbors[j]->tlv, print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure(&x->x1905_neighbors[j]->tlv, print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->power_off_interfaces_nr: %d", i, data_model.network_devices[i].power_off_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->power_off_interfaces_nr: %u", i, x->power_off_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].power_off_nr; j++)
+        for (j=0; j<x->power_off_nr; j++)
         {
-            snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->power_off_interfaces[%d]->", i, j);
+            snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->power_off_interfaces[%u]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure(&data_model.network_devices[i].power_off[j]->tlv, print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure(&x->power_off[j]->tlv, print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->l2_neighbors_nr: %d", i, data_model.network_devices[i].l2_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->l2_neighbors_nr: %u", i, x->l2_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].l2_neighbors_nr; j++)
+        for (j=0; j<x->l2_neighbors_nr; j++)
         {
-            snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->l2_neighbors[%d]->", i, j);
+            snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->l2_neighbors[%u]->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            visit_1905_TLV_structure(&data_model.network_devices[i].l2_neighbors[j]->tlv, print_callback, write_function, new_prefix);
+            visit_1905_TLV_structure(&x->l2_neighbors[j]->tlv, print_callback, write_function, new_prefix);
         }
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->generic_phys->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->generic_phys->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure(&data_model.network_devices[i].generic_phy->tlv, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure(&x->generic_phy->tlv, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->profile->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->profile->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure(&data_model.network_devices[i].profile->tlv, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure(&x->profile->tlv, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->identification->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->identification->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure(&data_model.network_devices[i].identification->tlv, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure(&x->identification->tlv, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->control_url->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->control_url->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure(&data_model.network_devices[i].control_url->tlv, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure(&x->control_url->tlv, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->ipv4->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->ipv4->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure(&data_model.network_devices[i].ipv4->tlv, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure(&x->ipv4->tlv, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->ipv6->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->ipv6->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        visit_1905_TLV_structure(&data_model.network_devices[i].ipv6->tlv, print_callback, write_function, new_prefix);
+        visit_1905_TLV_structure(&x->ipv6->tlv, print_callback, write_function, new_prefix);
 
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->metrics_nr: %d", i, data_model.network_devices[i].metrics_with_neighbors_nr);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->metrics_nr: %u", i, x->metrics_with_neighbors_nr);
         new_prefix[MAX_PREFIX-1] = 0x0;
         write_function("%s\n", new_prefix);
-        for (j=0; j<data_model.network_devices[i].metrics_with_neighbors_nr; j++)
+        for (j=0; j<x->metrics_with_neighbors_nr; j++)
         {
-            snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->metrics[%d]->tx->", i, j);
+            snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->metrics[%u]->tx->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            if (NULL != data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics)
+            if (NULL != x->metrics_with_neighbors[j].tx_metrics)
             {
-                write_function("%slast_updated: %d\n", new_prefix, data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics_timestamp);
-                visit_1905_TLV_structure(&data_model.network_devices[i].metrics_with_neighbors[j].tx_metrics->tlv, print_callback, write_function, new_prefix);
+                write_function("%slast_updated: %d\n", new_prefix, x->metrics_with_neighbors[j].tx_metrics_timestamp);
+                visit_1905_TLV_structure(&x->metrics_with_neighbors[j].tx_metrics->tlv, print_callback, write_function, new_prefix);
             }
-            snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->metrics[%d]->rx->", i, j);
+            snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->metrics[%u]->rx->", i, j);
             new_prefix[MAX_PREFIX-1] = 0x0;
-            if (NULL != data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics)
+            if (NULL != x->metrics_with_neighbors[j].rx_metrics)
             {
-                write_function("%slast updated: %d\n", new_prefix, data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics_timestamp);
-                visit_1905_TLV_structure(&data_model.network_devices[i].metrics_with_neighbors[j].rx_metrics->tlv, print_callback, write_function, new_prefix);
+                write_function("%slast updated: %d\n", new_prefix, x->metrics_with_neighbors[j].rx_metrics_timestamp);
+                visit_1905_TLV_structure(&x->metrics_with_neighbors[j].rx_metrics->tlv, print_callback, write_function, new_prefix);
             }
         }
 
@@ -1265,9 +1838,9 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...))
         // Allow registered third-party developers to extend the neighbor info
         // (ex. BBF adds non-1905 link metrics)
         //
-        snprintf(new_prefix, MAX_PREFIX-1, "  device[%d]->", i);
+        snprintf(new_prefix, MAX_PREFIX-1, "  device[%zu]->", i);
         new_prefix[MAX_PREFIX-1] = 0x0;
-        dumpExtendedInfo((uint8_t **)data_model.network_devices[i].extensions, data_model.network_devices[i].extensions_nr, print_callback, write_function, new_prefix);
+        dumpExtendedInfo((uint8_t **)x->extensions, x->extensions_nr, print_callback, write_function, new_prefix);
     }
 
     return;
@@ -1275,248 +1848,75 @@ void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...))
 
 uint8_t DMrunGarbageCollector(void)
 {
-    uint8_t i, j, k;
-    uint8_t removed_entries;
-    uint8_t original_devices_nr;
+    uint32_t now;
+    unsigned work;
+    unsigned removed_entries;
 
-    removed_entries     = 0;
+    now             = PLATFORM_GET_TIMESTAMP();
+    work            = 0;
+    removed_entries = 0;
 
-    // Visit all existing devices, searching for those with a timestamp older
-    // than GC_MAX_AGE
+    // Devices and metrics links whose deadline has passed (ie. that have not
+    // been updated in the last GC_MAX_AGE seconds) are at the top of the
+    // heap. Nothing else is visited.
     //
-    // Note that we skip element "0", which is always the local device. We don't
-    // care when it was last updated as it is always updated "on demand", just
-    // before someone requests its data (right now the only place where this
-    // happens is when using an ALME custom command)
+    // Note that the local device is never scheduled. We don't care when it was
+    // last updated as it is always updated "on demand", just before someone
+    // requests its data (right now the only place where this happens is when
+    // using an ALME custom command)
     //
-    original_devices_nr = data_model.network_devices_nr;
-    for (i=1; i<data_model.network_devices_nr; i++)
+    // Metrics links towards a removed device are not looked for either: as
+    // they are no longer refreshed they expire on their own.
+    //
+    while (data_model.expiries_nr > 0 && work < GC_MAX_WORK &&
+           _expiryBefore(data_model.expiries[0].deadline, now))
     {
-        uint8_t *p = NULL;
-
-        if (
-             (PLATFORM_GET_TIMESTAMP() - data_model.network_devices[i].update_timestamp > (GC_MAX_AGE*1000)) ||
-             (NULL != data_model.network_devices[i].info && NULL == (p = DMmacToAlMac(data_model.network_devices[i].info->al_mac_address)))
-           )
-        {
-            // Entry too old or with a MAC address no longer registered in the
-            // "topology discovery" database. Remove it.
-            //
-            uint8_t  al_mac_address[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-            struct _networkDevice *x;
-
-            removed_entries++;
-
-            x = &data_model.network_devices[i];
-
-            // First, free all child structures
-            //
-            if (NULL != x->info)
-            {
-                // Save the MAC of the node that is going to be removed for
-                // later use
-                //
-                memcpy(al_mac_address, x->info->al_mac_address, 6);
-
-                PLATFORM_PRINTF_DEBUG_DETAIL("Removing old device entry (%02x:%02x:%02x:%02x:%02x:%02x)\n", x->info->al_mac_address[0], x->info->al_mac_address[1], x->info->al_mac_address[2], x->info->al_mac_address[3], x->info->al_mac_address[4], x->info->al_mac_address[5]);
-                free_1905_TLV_structure(&x->info->tlv);
-                x->info = NULL;
-            }
-            else
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("Removing old device entry (Unknown AL MAC)\n");
-            }
-
-            for (j=0; j<x->bridges_nr; j++)
-            {
-                free_1905_TLV_structure(&x->bridges[j]->tlv);
-            }
-            if (0 != x->bridges_nr && NULL != x->bridges)
-            {
-                free(x->bridges);
-                x->bridges_nr = 0;
-                x->bridges    = NULL;
-            }
-
-            for (j=0; j<x->non1905_neighbors_nr; j++)
-            {
-                free_1905_TLV_structure(&x->non1905_neighbors[j]->tlv);
-            }
-            if (0 != x->non1905_neighbors_nr && NULL != x->non1905_neighbors)
-            {
-                free(x->non1905_neighbors);
-                x->non1905_neighbors_nr = 0;
-                x->non1905_neighbors    = NULL;
-            }
-
-            for (j=0; j<x->x1905_neighbors_nr; j++)
-            {
-                free_1905_TLV_structure(&x->x1905_neighbors[j]->tlv);
-            }
-            if (0 != x->x1905_neighbors_nr && NULL != x->x1905_neighbors)
-            {
-                free(x->x1905_neighbors);
-                x->x1905_neighbors_nr = 0;
-                x->x1905_neighbors    = NULL;
-            }
+        struct networkDevice *x = data_model.expiries[0].device;
 
-            for (j=0; j<x->power_off_nr; j++)
-            {
-                free_1905_TLV_structure(&x->power_off[j]->tlv);
-            }
-            if (0 != x->power_off_nr && NULL != x->power_off)
-            {
-                free(x->power_off);
-                x->power_off_nr = 0;
-                x->power_off    = NULL;
-            }
-
-            for (j=0; j<x->l2_neighbors_nr; j++)
-            {
-                free_1905_TLV_structure(&x->l2_neighbors[j]->tlv);
-            }
-            if (0 != x->l2_neighbors_nr && NULL != x->l2_neighbors)
-            {
-                free(x->l2_neighbors);
-                x->l2_neighbors_nr = 0;
-                x->l2_neighbors    = NULL;
-            }
-
-            if (NULL != x->generic_phy)
-            {
-                free_1905_TLV_structure(&x->generic_phy->tlv);
-                x->generic_phy = NULL;
-            }
-
-            if (NULL != x->profile)
-            {
-                free_1905_TLV_structure(&x->profile->tlv);
-                x->profile = NULL;
-            }
-
-            if (NULL != x->identification)
-            {
-                free_1905_TLV_structure(&x->identification->tlv);
-                x->identification = NULL;
-            }
-
-            if (NULL != x->control_url)
-            {
-                free_1905_TLV_structure(&x->control_url->tlv);
-                x->control_url = NULL;
-            }
-
-            if (NULL != x->ipv4)
-            {
-                free_1905_TLV_structure(&x->ipv4->tlv);
-                x->ipv4 = NULL;
-            }
+        work++;
 
-            if (NULL != x->ipv6)
-            {
-                free_1905_TLV_structure(&x->ipv6->tlv);
-                x->ipv6 = NULL;
-            }
-
-            for (j=0; j<x->metrics_with_neighbors_nr; j++)
-            {
-                free_1905_TLV_structure(&x->metrics_with_neighbors[j].tx_metrics->tlv);
-                free_1905_TLV_structure(&x->metrics_with_neighbors[j].rx_metrics->tlv);
-            }
-            if (0 != x->metrics_with_neighbors_nr && NULL != x->metrics_with_neighbors)
-            {
-                free(x->metrics_with_neighbors);
-                x->metrics_with_neighbors = NULL;
-            }
-
-            // Next, remove the _networkDevice entry
-            //
-            if (i == (data_model.network_devices_nr-1))
-            {
-                // Last element. It will automatically be removed below (keep
-                // reading)
-            }
-            else
-            {
-                // Place the last element here (we don't care about preserving
-                // order)
-                //
-                data_model.network_devices[i] = data_model.network_devices[data_model.network_devices_nr-1];
-                i--;
-            }
-            data_model.network_devices_nr--;
-
-            // Next, Remove all references to this node from other node's
-            // metrics information entries
+        if (EXPIRY_DEVICE == data_model.expiries[0].link)
+        {
+            // Device too old. Remove it, together with its entry in the local
+            // interfaces database
             //
-            for (j=0; j<data_model.network_devices_nr; j++)
-            {
-                uint8_t original_neighbors_nr;
+            struct alDevice *device = x->device;
 
-                original_neighbors_nr = data_model.network_devices[j].metrics_with_neighbors_nr;
-
-                for (k=0; k<data_model.network_devices[j].metrics_with_neighbors_nr; k++)
-                {
-                    if (0 == memcmp(al_mac_address, data_model.network_devices[j].metrics_with_neighbors[k].neighbor_al_mac_address, 6))
-                    {
-                        free_1905_TLV_structure(&data_model.network_devices[j].metrics_with_neighbors[k].tx_metrics->tlv);
-                        free_1905_TLV_structure(&data_model.network_devices[j].metrics_with_neighbors[k].rx_metrics->tlv);
-
-                        // Place last element here (we don't care about
-                        // preserving order)
-                        //
-                        if (k == (data_model.network_devices[j].metrics_with_neighbors_nr-1))
-                        {
-                            // Last element. It will automatically be removed
-                            // below (keep reading)
-                        }
-                        else
-                        {
-                            data_model.network_devices[j].metrics_with_neighbors[k] = data_model.network_devices[j].metrics_with_neighbors[data_model.network_devices[j].metrics_with_neighbors_nr-1];
-                            k--;
-                        }
-                        data_model.network_devices[j].metrics_with_neighbors_nr--;
-                    }
-                }
+            PLATFORM_PRINTF_DEBUG_DETAIL("Removing old device entry (%02x:%02x:%02x:%02x:%02x:%02x)\n", device->al_mac_addr[0], device->al_mac_addr[1], device->al_mac_addr[2], device->al_mac_addr[3], device->al_mac_addr[4], device->al_mac_addr[5]);
 
-                if (original_neighbors_nr != data_model.network_devices[j].metrics_with_neighbors_nr)
-                {
-                    if (0 == data_model.network_devices[j].metrics_with_neighbors_nr)
-                    {
-                        free(data_model.network_devices[j].metrics_with_neighbors);
-                    }
-                    else
-                    {
-                        data_model.network_devices[j].metrics_with_neighbors = (struct _metricsWithNeighbor *)memrealloc(data_model.network_devices[j].metrics_with_neighbors, sizeof(struct _metricsWithNeighbor)*(data_model.network_devices[j].metrics_with_neighbors_nr));
-                    }
-                }
-            }
+            _networkDeviceFree(x);
+            alDeviceDelete(device);
 
-            // And also from the local interfaces database
-            alDeviceDelete(alDeviceFind(al_mac_address));
+            removed_entries++;
         }
-
-        if (NULL != p)
+        else
         {
-            free(p);
+            _metricsLinkFree(x, data_model.expiries[0].link);
         }
     }
 
-    // If at least one element was removed, we need to realloc
+    // Trailing empty slots don't need to be visited any longer
     //
-    if (original_devices_nr != data_model.network_devices_nr)
+    while (data_model.network_devices_nr > 0 && NULL == data_model.network_devices[data_model.network_devices_nr-1])
     {
-        if (0 == data_model.network_devices_nr)
-        {
-            free(data_model.network_devices);
-        }
-        else
-        {
-            data_model.network_devices = (struct _networkDevice *)memrealloc(data_model.network_devices, sizeof(struct _networkDevice)*(data_model.network_devices_nr));
-        }
+        data_model.network_devices_nr--;
+    }
+    if (data_model.network_devices_free > data_model.network_devices_nr)
+    {
+        data_model.network_devices_free = data_model.network_devices_nr;
+    }
+
+    return removed_entries > 0xff ? 0xff : removed_entries;
+}
+
+uint8_t DMgarbageCollectorPending(void)
+{
+    if (data_model.expiries_nr > 0 && _expiryBefore(data_model.expiries[0].deadline, PLATFORM_GET_TIMESTAMP()))
+    {
+        return 1;
     }
 
-    return removed_entries;
+    return 0;
 }
 
 void DMremoveALNeighborFromInterface(uint8_t *al_mac_address, char *interface_name)
@@ -1532,7 +1932,9 @@ void DMremoveALNeighborFromInterface(uint8_t *al_mac_address, char *interface_na
     }
     else
     {
-        for (i = 0; i < interface->neighbors.length; i++)
+        // Go backwards: removing a neighbor moves the last one in its place
+        //
+        for (i = interface->neighbors.length; i-- > 0; )
         {
             neighbor = interface->neighbors.data[i]->owner;
             if (neighbor != NULL && memcmp(neighbor->al_mac_addr, al_mac_address, 6) == 0)
@@ -1546,7 +1948,7 @@ void DMremoveALNeighborFromInterface(uint8_t *al_mac_address, char *interface_na
 
 struct vendorSpecificTLV ***DMextensionsGet(uint8_t *al_mac_address, uint8_t **nr)
 {
-    uint8_t                         i;
+    struct networkDevice         *x;
     struct vendorSpecificTLV   ***extensions;
 
     // Find device
@@ -1558,23 +1960,12 @@ struct vendorSpecificTLV ***DMextensionsGet(uint8_t *al_mac_address, uint8_t **n
 
     // Search for an existing entry with the same AL MAC address
     //
-    for (i=0; i<data_model.network_devices_nr; i++)
-    {
-        if (NULL == data_model.network_devices[i].info)
-        {
-            // We haven't received general info about this device yet.
-            //
-            continue;
-        }
-        if (0 == memcmp(data_model.network_devices[i].info->al_mac_address, al_mac_address, 6))
-        {
-            break;
-        }
-    }
+    x = _findNetworkDevice(al_mac_address);
 
-    if (i == data_model.network_devices_nr)
+    if (NULL == x || NULL == x->info)
     {
-        // A matching entry was *not* found.
+        // A matching entry was *not* found (or we haven't received general
+        // info about this device yet).
         //
         PLATFORM_PRINTF_DEBUG_DETAIL("Extension received from an unknown 1905 node (%02x:%02x:%02x:%02x:%02x:%02x). Ignoring data...\n", al_mac_address[0], al_mac_address[1], al_mac_address[2], al_mac_address[3], al_mac_address[4], al_mac_address[5]);
         extensions = NULL;
@@ -1583,8 +1974,8 @@ struct vendorSpecificTLV ***DMextensionsGet(uint8_t *al_mac_address, uint8_t **n
     {
         // Point to the datamodel extensions section
         //
-        extensions = &data_model.network_devices[i].extensions;
-        *nr        = &data_model.network_devices[i].extensions_nr;
+        extensions = &x->extensions;
+        *nr        = &x->extensions_nr;
     }
 
     return extensions;
@@ -59,6 +59,7 @@
 #define _AL_DATAMODEL_H_
 
 #include "1905_tlvs.h"
+#include "1905_cmdus.h"
 #include "datamodel.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -328,11 +329,11 @@ uint8_t *DMmacToAlMac(uint8_t *mac_addresses);
 //
 uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
                                 uint8_t in_update,  struct deviceInformationTypeTLV             *info,
-                                uint8_t br_update,  struct deviceBridgingCapabilityTLV         **bridges,           uint8_t bridges_nr,
-                                uint8_t no_update,  struct non1905NeighborDeviceListTLV        **non1905_neighbors, uint8_t non1905_neighbors_nr,
-                                uint8_t x1_update,  struct neighborDeviceListTLV               **x1905_neighbors,   uint8_t x1905_neighbors_nr,
-                                uint8_t po_update,  struct powerOffInterfaceTLV                **power_off,         uint8_t power_off_nr,
-                                uint8_t l2_update,  struct l2NeighborDeviceTLV                 **l2_neighbors,      uint8_t l2_neighbors_nr,
+                                uint8_t br_update,  struct deviceBridgingCapabilityTLV         **bridges,           unsigned bridges_nr,
+                                uint8_t no_update,  struct non1905NeighborDeviceListTLV        **non1905_neighbors, unsigned non1905_neighbors_nr,
+                                uint8_t x1_update,  struct neighborDeviceListTLV               **x1905_neighbors,   unsigned x1905_neighbors_nr,
+                                uint8_t po_update,  struct powerOffInterfaceTLV                **power_off,         unsigned power_off_nr,
+                                uint8_t l2_update,  struct l2NeighborDeviceTLV                 **l2_neighbors,      unsigned l2_neighbors_nr,
                                 uint8_t ss_update,  struct supportedServiceTLV                  *supported_service,
                                 uint8_t ge_update,  struct genericPhyDeviceInformationTypeTLV   *generic_phy,
                                 uint8_t pr_update,  struct x1905ProfileVersionTLV               *profile,
@@ -354,6 +355,52 @@ uint8_t DMupdateNetworkDeviceInfo(uint8_t *al_mac_address,
                    // (which is 60 seconds)
 uint8_t DMnetworkDeviceInfoNeedsUpdate(uint8_t *al_mac_address);
 
+// Given a received (not yet decoded) CMDU, returns "1" if it carries exactly
+// the same TLVs as the ones already stored in the data model for the device
+// that sent it, and "0" otherwise (or if this type of CMDU does not update the
+// data model).
+//
+// The comparison is done with a hash of the raw bytes of each "family" of TLVs
+// (ie. all the TLVs of one type) the CMDU replaces when it is processed. Only
+// "topology response", "generic phy response" and "higher layer response"
+// CMDUs are considered.
+//
+// When "1" is returned the device is refreshed (as if
+// "DMupdateNetworkDeviceInfo()" had been called with the same data again) and
+// the CMDU does not need to be decoded.
+// When "0" is returned the hashes are remembered and associated to the device
+// if "DMupdateNetworkDeviceInfo()" is called for it while the CMDU is being
+// processed. "DMnetworkDeviceInfoDone()" must be called once it has been.
+//
+uint8_t DMnetworkDeviceInfoUnchanged(const struct CMDU_view *view);
+
+// Must be called when the processing of a CMDU given to
+// "DMnetworkDeviceInfoUnchanged()" is over, whether it succeeded or not.
+//
+// If the CMDU could not be decoded or applied, its hashes are forgotten.
+// Otherwise they would be associated to whatever the next update of the device
+// stores, and the next copy of the CMDU would be wrongly taken as unchanged.
+//
+void DMnetworkDeviceInfoDone(void);
+
+// Returns "1" if the last update of the device with AL MAC address
+// 'al_mac_address' (ie. the last call to "DMupdateNetworkDeviceInfo()" or
+// "DMnetworkDeviceInfoUnchanged()" for it) modified any of its TLVs, "0"
+// otherwise.
+//
+uint8_t DMnetworkDeviceChanged(uint8_t *al_mac_address);
+
+// Retrieve the "device information type" TLV and the list of 1905 neighbors
+// TLVs stored for the device with AL MAC address 'al_mac_address'.
+//
+// The returned pointers belong to the data model and are only valid until the
+// next time it is updated.
+//
+// Returns "0" if the device is not known, "1" otherwise.
+//
+uint8_t DMnetworkDeviceTopologyGet(uint8_t *al_mac_address, struct deviceInformationTypeTLV **info,
+                                   struct neighborDeviceListTLV ***x1905_neighbors, unsigned *x1905_neighbors_nr);
+
 // Update the "metrics" information of a neighbor node
 //
 // 'metrics' is a pointer to either a "struct transmitterLinkMetricTLV" or a
@@ -378,21 +425,30 @@ uint8_t DMupdateNetworkDeviceMetrics(uint8_t *metrics);
 //
 void DMdumpNetworkDevices(void (*write_function)(const char *fmt, ...));
 
-// This function must be called from time to time (every "x" seconds, where "x"
-// should be a number slightly greate than "GC_MAX_AGE") to remove device
-// entries from the database.
+// This function must be called from time to time to remove device entries
+// (and the metrics they reported) from the database.
 //
 // If an entry is older than "GC_MAX_AGE" seconds, this function removes it.
+// Only expired entries are visited, but no more than "GC_MAX_WORK" of them
+// per call, so that a lot of devices leaving at once does not stall the
+// caller: call this function often (ex: every second) so that the rest are
+// removed on the following calls.
 //
 // "GC_MAX_AGE" must be higher than 60 seconds, which is the network rediscovery
 // period defined in the IEEE1905 standard.
 //
-// The return value is the number of entries deleted from the database (that
-// means it will return "0" if no entry eas removed)
+// The return value is the number of devices deleted from the database (that
+// means it will return "0" if no device was removed)
 //
-#define GC_MAX_AGE (90)
+#define GC_MAX_AGE  (90)
+#define GC_MAX_WORK (32)
 uint8_t DMrunGarbageCollector(void);
 
+// Returns "1" if there are expired entries that "DMrunGarbageCollector()" has
+// not removed yet (ie. because of the "GC_MAX_WORK" limit), "0" otherwise.
+//
+uint8_t DMgarbageCollectorPending(void);
+
 // Remove a neighbor from a particular local interface.
 //
 // 'al_mac_address' is the 1905 neighbour MAC address that you want to remove.
@@ -0,0 +1,349 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+#include "platform.h"
+#include "utils.h"
+#include "dlist.h"
+
+#include "al_duplicates.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+////////////////////////////////////////////////////////////////////////////////
+// Private data and functions
+////////////////////////////////////////////////////////////////////////////////
+
+#define WINDOW_WORDS  (DUPLICATES_WINDOW / 64)
+
+// Message ids recently received from one source
+//
+struct _source
+{
+    dlist_item       l;                     // Position in 'lru' (the least
+                                            // recently heard source is the
+                                            // first one)
+
+    struct _source  *hash_next;             // Next entry in the same bucket
+
+    uint8_t          mac_address[6];
+
+    uint16_t         highest_mid;           // Highest message id received
+    uint64_t         window[WINDOW_WORDS];  // Bit "mid % DUPLICATES_WINDOW" is
+                                            // set if 'mid' has been received
+                                            // (for the DUPLICATES_WINDOW ids
+                                            // up to 'highest_mid')
+
+    uint32_t         suppressed;            // Duplicates received
+};
+
+static struct
+{
+    struct _source   **hash;
+    uint32_t           hash_size;           // Always a power of 2
+
+    dlist_head         lru;
+
+    uint32_t           max_sources;
+
+    struct duplicatesStats stats;
+
+} duplicates = {
+    .lru         = {&duplicates.lru, &duplicates.lru},
+    .max_sources = DUPLICATES_DEFAULT_MAX_SOURCES,
+};
+
+static uint32_t _hashKey(const uint8_t *mac_address)
+{
+    // FNV-1a
+    //
+    uint32_t h = 2166136261u;
+    unsigned i;
+
+    for (i = 0; i < 6; i++)
+    {
+        h = (h ^ mac_address[i]) * 16777619u;
+    }
+
+    return h & (duplicates.hash_size - 1);
+}
+
+static void _hashInsert(struct _source *s)
+{
+    uint32_t b = _hashKey(s->mac_address);
+
+    s->hash_next        = duplicates.hash[b];
+    duplicates.hash[b]  = s;
+}
+
+static void _hashRemove(struct _source *s)
+{
+    struct _source **ps = &duplicates.hash[_hashKey(s->mac_address)];
+
+    while (*ps != s)
+    {
+        ps = &(*ps)->hash_next;
+    }
+    *ps = s->hash_next;
+}
+
+// Size the hash table for 'max_sources' entries (ie. a load factor of at most
+// one)
+//
+static void _hashResize(uint32_t max_sources)
+{
+    struct _source *s;
+    uint32_t        hash_size = 16;
+
+    while (hash_size < max_sources)
+    {
+        hash_size *= 2;
+    }
+    if (hash_size == duplicates.hash_size)
+    {
+        return;
+    }
+
+    memfree(duplicates.hash);
+    duplicates.hash      = (struct _source **)zmemalloc(hash_size * sizeof(struct _source *));
+    duplicates.hash_size = hash_size;
+
+    dlist_for_each(s, duplicates.lru, l)
+    {
+        _hashInsert(s);
+    }
+}
+
+static struct _source *_find(const uint8_t *mac_address)
+{
+    struct _source *s;
+
+    if (0 == duplicates.hash_size)
+    {
+        return NULL;
+    }
+
+    for (s = duplicates.hash[_hashKey(mac_address)]; NULL != s; s = s->hash_next)
+    {
+        if (0 == memcmp(s->mac_address, mac_address, 6))
+        {
+            return s;
+        }
+    }
+
+    return NULL;
+}
+
+static void _evictOldest(void)
+{
+    struct _source *s = container_of(dlist_get_first(&duplicates.lru), struct _source, l);
+
+    _hashRemove(s);
+    dlist_remove(&s->l);
+    memfree(s);
+
+    duplicates.stats.sources--;
+}
+
+static inline uint8_t _windowTest(const struct _source *s, uint16_t mid)
+{
+    unsigned bit = mid % DUPLICATES_WINDOW;
+
+    return (s->window[bit / 64] >> (bit % 64)) & 1;
+}
+
+static inline void _windowSet(struct _source *s, uint16_t mid)
+{
+    unsigned bit = mid % DUPLICATES_WINDOW;
+
+    s->window[bit / 64] |= (uint64_t)1 << (bit % 64);
+}
+
+static inline void _windowClear(struct _source *s, uint16_t mid)
+{
+    unsigned bit = mid % DUPLICATES_WINDOW;
+
+    s->window[bit / 64] &= ~((uint64_t)1 << (bit % 64));
+}
+
+// Make 'mid' the highest message id of the window, forgetting the ones that
+// fall out of it
+//
+static void _windowSlide(struct _source *s, uint16_t mid)
+{
+    uint16_t distance = mid - s->highest_mid;
+
+    if (distance >= DUPLICATES_WINDOW)
+    {
+        memset(s->window, 0, sizeof(s->window));
+    }
+    else
+    {
+        uint16_t m;
+
+        for (m = s->highest_mid + 1; m != (uint16_t)(mid + 1); m++)
+        {
+            _windowClear(s, m);
+        }
+    }
+    s->highest_mid = mid;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public API
+////////////////////////////////////////////////////////////////////////////////
+
+void duplicatesSetLimits(uint32_t max_sources)
+{
+    if (0 == max_sources)
+    {
+        max_sources = 1;
+    }
+    duplicates.max_sources = max_sources;
+
+    while (duplicates.stats.sources > max_sources)
+    {
+        _evictOldest();
+        duplicates.stats.evictions++;
+    }
+    _hashResize(max_sources);
+}
+
+uint8_t duplicatesCheck(const uint8_t *mac_address, uint16_t mid)
+{
+    struct _source *s;
+    int16_t         distance;
+
+    if (0 == duplicates.hash_size)
+    {
+        _hashResize(duplicates.max_sources);
+    }
+
+    s = _find(mac_address);
+    if (NULL == s)
+    {
+        if (duplicates.stats.sources >= duplicates.max_sources)
+        {
+            _evictOldest();
+            duplicates.stats.evictions++;
+        }
+
+        s = (struct _source *)zmemalloc(sizeof(struct _source));
+        memcpy(s->mac_address, mac_address, 6);
+        s->highest_mid = mid;
+        _windowSet(s, mid);
+
+        _hashInsert(s);
+        dlist_add_tail(&duplicates.lru, &s->l);
+        duplicates.stats.sources++;
+
+        return 0;
+    }
+
+    // Most recently heard source goes to the end of the LRU list
+    //
+    dlist_remove(&s->l);
+    dlist_add_tail(&duplicates.lru, &s->l);
+
+    // Message ids wrap around, so "ahead" and "behind" are relative to the
+    // highest one received (using 16 bits modular arithmetic)
+    //
+    distance = (int16_t)(uint16_t)(mid - s->highest_mid);
+
+    if (distance > 0 || distance <= -DUPLICATES_WINDOW)
+    {
+        // Either a newer message or one so old that the source must have
+        // restarted its message ids
+        //
+        _windowSlide(s, mid);
+        _windowSet(s, mid);
+        return 0;
+    }
+
+    if (_windowTest(s, mid))
+    {
+        s->suppressed++;
+        duplicates.stats.suppressed++;
+        return 1;
+    }
+
+    // An older message that arrived out of order
+    //
+    _windowSet(s, mid);
+    return 0;
+}
+
+uint32_t duplicatesGetSuppressed(const uint8_t *mac_address)
+{
+    struct _source *s = _find(mac_address);
+
+    return NULL == s ? 0 : s->suppressed;
+}
+
+void duplicatesGetStats(struct duplicatesStats *stats)
+{
+    *stats = duplicates.stats;
+}
+
+void duplicatesFlush(void)
+{
+    while (!dlist_empty(&duplicates.lru))
+    {
+        _evictOldest();
+    }
+}
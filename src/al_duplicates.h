@@ -0,0 +1,126 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+#ifndef _AL_DUPLICATES_H_
+#define _AL_DUPLICATES_H_
+
+#include <stdint.h>
+
+// Relayed multicast CMDUs can reach us several times, through different
+// neighbors. According to "Sections 7.5, 7.6 and 7.7", a CMDU whose (AL MAC,
+// message id) tuple has already been seen must be discarded.
+//
+// This module remembers, for each source MAC address, which message ids were
+// received recently:
+//
+//   - Sources are kept in a hash table, so the cost of a lookup does not depend
+//     on how many nodes are talking.
+//
+//   - For each source, a window of the last DUPLICATES_WINDOW message ids
+//     (counting back from the highest one received) is tracked with a bitmap.
+//     Message ids are expected to increase, so the window slides forward as
+//     new ones arrive. A message id older than the window is considered a
+//     restart of the source: the window is moved back to it.
+//
+//   - The number of sources is capped. When the cap is reached, the least
+//     recently heard source is forgotten.
+//
+
+// Number of message ids tracked per source. Must be a multiple of 64.
+//
+#define DUPLICATES_WINDOW                256
+
+// Default value for "duplicatesSetLimits()"
+//
+#define DUPLICATES_DEFAULT_MAX_SOURCES   256
+
+// Counters, as returned by "duplicatesGetStats()"
+//
+struct duplicatesStats
+{
+    uint32_t suppressed;       // Duplicates detected (from all sources)
+    uint32_t evictions;        // Sources forgotten because of the cap
+    uint32_t sources;          // Sources currently tracked
+};
+
+// Configure the maximum number of sources to track. Sources above the new
+// limit are forgotten.
+//
+void duplicatesSetLimits(uint32_t max_sources);
+
+// Record that a message with id 'mid' was received from 'mac_address'.
+//
+// Returns '1' if it had already been received (ie. it is a duplicate and must
+// be discarded) or '0' otherwise.
+//
+uint8_t duplicatesCheck(const uint8_t *mac_address, uint16_t mid);
+
+// Returns the number of duplicates received from 'mac_address' since it
+// started being tracked (or '0' if it is not tracked)
+//
+uint32_t duplicatesGetSuppressed(const uint8_t *mac_address);
+
+// Retrieve the global counters
+//
+void duplicatesGetStats(struct duplicatesStats *stats);
+
+// Forget all sources (the global counters are kept)
+//
+void duplicatesFlush(void);
+
+#endif
@@ -77,7 +77,9 @@
 #include "al_send.h"
 #include "al_recv.h"
 #include "al_utils.h"
+#include "al_duplicates.h"
 #include "al_extension.h"
+#include "al_reassembly.h"
 
 #include <datamodel.h>
 
@@ -97,323 +99,6 @@
 // Private functions and data
 ////////////////////////////////////////////////////////////////////////////////
 
-// CMDUs can be received in multiple fragments/packets when they are too big to
-// fit in a single "network transmission unit" (which is never bigger than
-// MAX_NETWORK_SEGMENT_SIZE).
-//
-// Fragments that belong to one same CMDU contain the same 'mid' and different
-// 'fragment id' values. In addition, the last fragment is the only one to
-// contain the 'last fragment indicator' field set.
-//
-//   NOTE: This is all also explained in "Sections 7.1.1 and 7.1.2"
-//
-// This function will "buffer" fragments until either all pieces arrive or a
-// timer expires (in which case all previous fragments are discarded/ignored)
-//
-//   NOTE: Instead of a timer, we will use a buffer that holds up to
-//         MAX_MIDS_IN_FLIGHT CMDUs.
-//         If we are still waiting for MAX_MIDS_IN_FLIGHT CMDUs to be completed
-//         (ie. we haven't received all their fragments yet), and a new fragment
-//         for a new CMDU arrives, we will discard all fragments from the
-//         oldest one.
-//
-// Every time this function is called, two things can happen:
-//
-//   1. The just received fragment was the last one needed to complete a CMDU.
-//      In this case, the CMDU structure result of all those fragments being
-//      parsed is returned.
-//
-//   2. The just received fragment is not yet the last one needed to complete a
-//      CMDU. In this case the fragment is internally buffered (ie. the caller
-//      does not need to keep the passed buffer around in memory) and this
-//      function returns NULL.
-//
-// This function received two arguments:
-//
-//   - 'packet_buffer' is a pointer to the received stream containing a
-//     fragment (or a whole) CMDU
-//
-//   - 'len' is the length of this 'packet_buffer' in bytes
-//
-struct CMDU *_reAssembleFragmentedCMDUs(const uint8_t *packet_buffer, uint16_t len)
-{
-    #define MAX_MIDS_IN_FLIGHT     5
-    #define MAX_FRAGMENTS_PER_MID  3
-
-    // This is a static structure used to store the fragments belonging to up to
-    // 'MAX_MIDS_IN_FLIGHT' CMDU messages.
-    // Initially all entries are marked as "empty" by setting the 'in_use' field
-    // to "0"
-    //
-    static struct _midsInFlight
-    {
-        uint8_t in_use;  // Is this entry free?
-
-        uint8_t mid;     // 'mid' associated to this CMDU
-
-        uint8_t src_addr[6];
-        uint8_t dst_addr[6];
-                       // These two (together with the 'mid' field) will be used
-                       // to identify fragments belonging to one same CMDU.
-
-        uint8_t fragments[MAX_FRAGMENTS_PER_MID];
-                       // Each entry represents a fragment number.
-                       //   - "1" means that fragment has been received
-                       //   - "0" means no fragment with that number has been
-                       //     received.
-
-        uint8_t last_fragment;
-                       // Number of the fragment carrying the
-                       // 'last_fragment_indicator' flag.
-                       // This is always a number between 0 and
-                       // MAX_FRAGMENTS_PER_MID-1.
-                       // Iniitally it is set to "MAX_FRAGMENTS_PER_MID",
-                       // meaning that no fragment with the
-                       // 'last_fragment_indicator' flag has been received yet.
-
-        uint8_t *streams[MAX_FRAGMENTS_PER_MID+1];
-                       // Each of the bit streams associated to each fragment
-                       //
-                       // The size is "MAX_FRAGMENTS_PER_MID+1" instead of
-                       // "MAX_FRAGMENTS_PER_MID" to store a final NULL entry
-                       // (this makes it easier to later call
-                       // "parse_1905_CMDU_header_from_packet()"
-
-        uint32_t age;    // Used to keep track of which is the oldest CMDU for
-                       // which a fragment was received (so that we can free
-                       // it when the CMDUs buffer is full)
-
-    } mids_in_flight[MAX_MIDS_IN_FLIGHT] = \
-    {[ 0 ... MAX_MIDS_IN_FLIGHT-1 ] = (struct _midsInFlight) { .in_use = 0 }};
-
-    static uint32_t current_age = 0;
-
-    uint8_t  i, j;
-    const uint8_t *p;
-    struct CMDU_header cmdu_header;
-
-    if (!parse_1905_CMDU_header_from_packet(packet_buffer, len, &cmdu_header))
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("Could not retrieve CMDU header from bit stream\n");
-        return NULL;
-    }
-    PLATFORM_PRINTF_DEBUG_DETAIL("mid = %d, fragment_id = %d, last_fragment_indicator = %d\n",
-                                 cmdu_header.mid, cmdu_header.fragment_id, cmdu_header.last_fragment_indicator);
-
-    // Skip over ethernet header
-    p = packet_buffer + (6+6+2);
-    len -= (6+6+2);
-
-    // Find the set of streams associated to this 'mid' and add the just
-    // received stream to its set of streams
-    //
-    for (i = 0; i<MAX_MIDS_IN_FLIGHT; i++)
-    {
-        if (
-                                              1        ==  mids_in_flight[i].in_use          &&
-                                  cmdu_header.mid      ==  mids_in_flight[i].mid             &&
-             0 == memcmp(cmdu_header.dst_addr,    mids_in_flight[i].dst_addr, 6)    &&
-             0 == memcmp(cmdu_header.src_addr,    mids_in_flight[i].src_addr, 6)
-           )
-        {
-            // Fragments for this 'mid' have previously been received. Add this
-            // new one to the set.
-
-            // ...but first check for errors
-            //
-            if (cmdu_header.fragment_id > MAX_FRAGMENTS_PER_MID)
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("Too many fragments (%d) for one same CMDU (max supported is %d)\n",
-                                            cmdu_header.fragment_id, MAX_FRAGMENTS_PER_MID);
-                PLATFORM_PRINTF_DEBUG_ERROR("  mid      = %d\n", cmdu_header.mid);
-                PLATFORM_PRINTF_DEBUG_ERROR("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                            cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
-                                            cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
-                PLATFORM_PRINTF_DEBUG_ERROR("  dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                            cmdu_header.dst_addr[0], cmdu_header.dst_addr[1], cmdu_header.dst_addr[2],
-                                            cmdu_header.dst_addr[3], cmdu_header.dst_addr[4], cmdu_header.dst_addr[5]);
-                return NULL;
-            }
-
-            if (1 == mids_in_flight[i].fragments[cmdu_header.fragment_id])
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("Ignoring duplicated fragment #%d\n", cmdu_header.fragment_id);
-                PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", cmdu_header.mid);
-                PLATFORM_PRINTF_DEBUG_WARNING("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
-                                              cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
-                PLATFORM_PRINTF_DEBUG_WARNING("  dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.dst_addr[0], cmdu_header.dst_addr[1], cmdu_header.dst_addr[2],
-                                              cmdu_header.dst_addr[3], cmdu_header.dst_addr[4], cmdu_header.dst_addr[5]);
-                return NULL;
-            }
-
-            if (1 == cmdu_header.last_fragment_indicator && MAX_FRAGMENTS_PER_MID != mids_in_flight[i].last_fragment)
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("This fragment (#%d) and a previously received one (#%d) both contain the 'last_fragment_indicator' flag set. Ignoring...\n",
-                                              cmdu_header.fragment_id, mids_in_flight[i].last_fragment);
-                PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", cmdu_header.mid);
-                PLATFORM_PRINTF_DEBUG_WARNING("  src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.src_addr[0], cmdu_header.src_addr[1], cmdu_header.src_addr[2],
-                                              cmdu_header.src_addr[3], cmdu_header.src_addr[4], cmdu_header.src_addr[5]);
-                PLATFORM_PRINTF_DEBUG_WARNING("  dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                              cmdu_header.dst_addr[0], cmdu_header.dst_addr[1], cmdu_header.dst_addr[2],
-                                              cmdu_header.dst_addr[3], cmdu_header.dst_addr[4], cmdu_header.dst_addr[5]);
-                return NULL;
-            }
-
-            // ...and now actually save the stream for later
-            //
-            mids_in_flight[i].fragments[cmdu_header.fragment_id] = 1;
-
-            if (1 == cmdu_header.last_fragment_indicator)
-            {
-                mids_in_flight[i].last_fragment = cmdu_header.fragment_id;
-            }
-
-            mids_in_flight[i].streams[cmdu_header.fragment_id] = (uint8_t *)memalloc((sizeof(uint8_t) * len));
-            memcpy(mids_in_flight[i].streams[cmdu_header.fragment_id], p, len);
-
-            mids_in_flight[i].age = current_age++;
-
-            break;
-        }
-    }
-
-    // If we get inside the next "if()", that means no previous entry matches
-    // this 'mid' + 'src_addr' + 'dst_addr' tuple.
-    // What we have to do then is to search for an empty slot and add this as
-    // the first stream associated to this new tuple.
-    //
-    if (MAX_MIDS_IN_FLIGHT == i)
-    {
-        for (i = 0; i<MAX_MIDS_IN_FLIGHT; i++)
-        {
-            if (0 == mids_in_flight[i].in_use)
-            {
-                break;
-            }
-        }
-
-        if (MAX_MIDS_IN_FLIGHT == i)
-        {
-            // All slots are in use!!
-            //
-            // We need to discard the oldest one (ie. the one with the lowest
-            // 'age')
-            //
-            uint32_t lowest_age;
-
-            lowest_age = mids_in_flight[0].age;
-            j          = 0;
-
-            for (i=1; i<MAX_MIDS_IN_FLIGHT; i++)
-            {
-                if (mids_in_flight[i].age < lowest_age)
-                {
-                    lowest_age = mids_in_flight[i].age;
-                    j          = i;
-                }
-            }
-
-            PLATFORM_PRINTF_DEBUG_WARNING("Discarding old CMDU fragments to make room for the just received one. CMDU being discarded:\n");
-            PLATFORM_PRINTF_DEBUG_WARNING("  mid      = %d\n", mids_in_flight[j].mid);
-            PLATFORM_PRINTF_DEBUG_WARNING("  mids_in_flight[j].src_addr = %02x:%02x:%02x:%02x:%02x:%02x\n", mids_in_flight[j].src_addr[0], mids_in_flight[j].src_addr[1], mids_in_flight[j].src_addr[2], mids_in_flight[j].src_addr[3], mids_in_flight[j].src_addr[4], mids_in_flight[j].src_addr[5]);
-            PLATFORM_PRINTF_DEBUG_WARNING("  mids_in_flight[j].dst_addr = %02x:%02x:%02x:%02x:%02x:%02x\n", mids_in_flight[j].dst_addr[0], mids_in_flight[j].dst_addr[1], mids_in_flight[j].dst_addr[2], mids_in_flight[j].dst_addr[3], mids_in_flight[j].dst_addr[4], mids_in_flight[j].dst_addr[5]);
-
-            for (i=0; i<MAX_FRAGMENTS_PER_MID; i++)
-            {
-                if (1 == mids_in_flight[j].fragments[i] && NULL != mids_in_flight[j].streams[i])
-                {
-                    free(mids_in_flight[j].streams[i]);
-                }
-            }
-
-            mids_in_flight[j].in_use = 0;
-
-            i = j;
-        }
-
-        // Now that we have our empty slot, initialize it and fill it with the
-        // just received stream:
-        //
-        mids_in_flight[i].in_use = 1;
-        mids_in_flight[i].mid    = cmdu_header.mid;
-
-        memcpy(mids_in_flight[i].src_addr, cmdu_header.src_addr, 6);
-        memcpy(mids_in_flight[i].dst_addr, cmdu_header.dst_addr, 6);
-
-        for (j=0; j<MAX_FRAGMENTS_PER_MID; j++)
-        {
-            mids_in_flight[i].fragments[j] = 0;
-            mids_in_flight[i].streams[j]   = NULL;
-        }
-        mids_in_flight[i].streams[MAX_FRAGMENTS_PER_MID] = NULL;
-
-        mids_in_flight[i].fragments[cmdu_header.fragment_id]  = 1;
-        mids_in_flight[i].streams[cmdu_header.fragment_id]    = (uint8_t *)memalloc((sizeof(uint8_t) * len));
-        memcpy(mids_in_flight[i].streams[cmdu_header.fragment_id], p, len);
-
-        if (1 == cmdu_header.last_fragment_indicator)
-        {
-            mids_in_flight[i].last_fragment = cmdu_header.fragment_id;
-        }
-        else
-        {
-            mids_in_flight[i].last_fragment = MAX_FRAGMENTS_PER_MID;
-              // NOTE: This means "no 'last_fragment_indicator' flag has been
-              //       received yet.
-        }
-
-        mids_in_flight[i].age = current_age++;
-    }
-
-    // At this point we have an entry in the 'mids_in_flight' array (entry 'i')
-    // where a new stream/fragment has been added.
-    //
-    // We now have to check if we have received all fragments for this 'mid'
-    // and, if so, process them and obtain a CMDU structure that will be
-    // returned to the caller of the function.
-    //
-    // Otherwise, return NULL.
-    //
-    if (MAX_FRAGMENTS_PER_MID != mids_in_flight[i].last_fragment)
-    {
-        struct CMDU *c;
-
-        for (j=0; j<=mids_in_flight[i].last_fragment; j++)
-        {
-            if (0 == mids_in_flight[i].fragments[j])
-            {
-                PLATFORM_PRINTF_DEBUG_DETAIL("We still have to wait for more fragments to complete the CMDU message\n");
-                return NULL;
-            }
-        }
-
-        c = parse_1905_CMDU_from_packets(mids_in_flight[i].streams);
-
-        if (NULL == c)
-        {
-            PLATFORM_PRINTF_DEBUG_WARNING("parse_1905_CMDU_header_from_packet() failed\n");
-        }
-        else
-        {
-            PLATFORM_PRINTF_DEBUG_DETAIL("All fragments belonging to this CMDU have already been received and the CMDU structure is ready\n");
-        }
-
-        for (j=0; j<=mids_in_flight[i].last_fragment; j++)
-        {
-            free(mids_in_flight[i].streams[j]);
-        }
-        mids_in_flight[i].in_use = 0;
-
-        return c;
-    }
-
-    PLATFORM_PRINTF_DEBUG_DETAIL("The last fragment has not yet been received\n");
-    return NULL;
-}
-
 // Returns '1' if the packet has already been processed in the past and thus,
 // should be discarded (to avoid network storms). '0' otherwise.
 //
@@ -436,29 +121,14 @@ struct CMDU *_reAssembleFragmentedCMDUs(const uint8_t *packet_buffer, uint16_t l
 //   2. If the CMDU is *not* a relayed one, check against the ethernet source
 //      address
 //
-// This function keeps track of the latest MAX_DUPLICATES_LOG_ENTRIES tuples
-// of ("mac_address", "message_id") and:
+// The ("mac_address", "message_id") tuples are tracked by "duplicatesCheck()"
+// (see "al_duplicates.h"). This function returns '1' if the tuple had already
+// been received or '0' otherwise.
 //
-//   1. If the provided tuple matches an already existing one, this function
-//      returns '1'
-//
-//   2. Otherwise, the entry is added (discarding, if needed, the oldest entry)
-//      and this function returns '0'
-//
-uint8_t _checkDuplicates(uint8_t *src_mac_address, struct CMDU *c)
+uint8_t _checkDuplicates(uint8_t *src_mac_address, const struct CMDU_view *c)
 {
-    #define MAX_DUPLICATES_LOG_ENTRIES 10
-
-    static uint8_t  mac_addresses[MAX_DUPLICATES_LOG_ENTRIES][6];
-    static uint16_t message_ids  [MAX_DUPLICATES_LOG_ENTRIES];
-
-    static uint8_t start = 0;
-    static uint8_t total = 0;
-
     uint8_t mac_address[6];
 
-    uint8_t i;
-
     if(
         CMDU_TYPE_TOPOLOGY_RESPONSE               == c->message_type ||
         CMDU_TYPE_LINK_METRIC_RESPONSE            == c->message_type ||
@@ -510,20 +180,15 @@ uint8_t _checkDuplicates(uint8_t *src_mac_address, struct CMDU *c)
     memcpy(mac_address, src_mac_address, 6);
     if (1 == c->relay_indicator)
     {
-        uint8_t i;
-        struct tlv *p;
+        const struct CMDU_view_tlv *p;
 
-        i = 0;
-        while (NULL != (p = c->list_of_TLVs[i]))
+        // The value of the "AL MAC address TLV" is just the MAC address, so
+        // there is no need to decode it
+        //
+        p = get_1905_CMDU_view_TLV(c, TLV_TYPE_AL_MAC_ADDRESS_TYPE);
+        if (NULL != p && p->length >= 6)
         {
-            if (TLV_TYPE_AL_MAC_ADDRESS_TYPE == p->type)
-            {
-                struct alMacAddressTypeTLV *t = (struct alMacAddressTypeTLV *)p;
-
-                memcpy(mac_address, t->al_mac_address, 6);
-                break;
-            }
-            i++;
+            memcpy(mac_address, p->value, 6);
         }
     }
 
@@ -538,67 +203,25 @@ uint8_t _checkDuplicates(uint8_t *src_mac_address, struct CMDU *c)
         }
     }
 
-    // Find if the ("mac_address", "message_id") tuple is already present in the
-    // database
-    //
-    for (i=0; i<total; i++)
-    {
-        uint8_t index;
-
-        index = (start + i) % MAX_DUPLICATES_LOG_ENTRIES;
-
-        if (
-             0 == memcmp(mac_addresses[index],    mac_address, 6) &&
-                                  message_ids[index]    == c->message_id
-           )
-        {
-            // The entry already exists!
-            //
-            return 1;
-        }
-    }
-
-    // This is a new entry, insert it into the cache and return "0"
-    //
-    if (total < MAX_DUPLICATES_LOG_ENTRIES)
-    {
-        // There is space for new entries
-        //
-        uint8_t index;
-
-        index = (start + total) % MAX_DUPLICATES_LOG_ENTRIES;
-
-        memcpy(mac_addresses[index], mac_address, 6);
-        message_ids[index] = c->message_id;
-
-        total++;
-    }
-    else
-    {
-        // We need to replace the oldest entry
-        //
-        memcpy(mac_addresses[start], mac_address, 6);
-        message_ids[start] = c->message_id;
-
-        start++;
-
-        start = start % MAX_DUPLICATES_LOG_ENTRIES;
-    }
-
-    return 0;
+    return duplicatesCheck(mac_address, c->message_id);
 }
 
 // According to "Section 7.6", if a received packet has the "relayed multicast"
 // bit set, after processing, we must forward it on all authenticated 1905
 // interfaces (except on the one where it was received).
 //
-// This function checks if the provided 'c' structure has that "relayed
-// multicast" flag set and, if so, retransmits it on all local interfaces
-// (except for the one whose MAC address matches 'receiving_interface_addr') to
-// 'destination_mac_addr' and the same "message id" (MID) as the one contained
-// in the originally received 'c' structure.
+// This function checks if the provided 'c' view has that "relayed multicast"
+// flag set and, if so, retransmits it on all local interfaces (except for the
+// one whose MAC address matches 'receiving_interface_addr') to
+// 'destination_mac_addr'.
 //
-void _checkForwarding(uint8_t *receiving_interface_addr, uint8_t *destination_mac_addr, struct CMDU *c)
+// The message is not forged again: the originally received 'streams' (whose
+// lengths are in 'streams_lens') are sent as they are, so the "message id"
+// (MID) and the fragmentation are preserved and the cost does not depend on
+// the contents of the message.
+//
+void _checkForwarding(uint8_t *receiving_interface_addr, uint8_t *destination_mac_addr, const struct CMDU_view *c,
+                      uint8_t **streams, const uint16_t *streams_lens)
 {
     uint8_t i;
 
@@ -607,133 +230,131 @@ void _checkForwarding(uint8_t *receiving_interface_addr, uint8_t *destination_ma
         char **ifs_names;
         uint8_t  ifs_nr;
 
+        const char  *fwd_names[UINT8_MAX];
+        unsigned     fwd_nr;
+
         char *aux;
 
         PLATFORM_PRINTF_DEBUG_DETAIL("Relay multicast flag set. Forwarding...\n");
 
+        switch (c->message_type)
+        {
+            case CMDU_TYPE_TOPOLOGY_DISCOVERY:
+            {
+                aux = "CMDU_TYPE_TOPOLOGY_DISCOVERY";
+                break;
+            }
+            case CMDU_TYPE_TOPOLOGY_NOTIFICATION:
+            {
+                aux = "CMDU_TYPE_TOPOLOGY_NOTIFICATION";
+                break;
+            }
+            case CMDU_TYPE_TOPOLOGY_QUERY:
+            {
+                aux = "CMDU_TYPE_TOPOLOGY_QUERY";
+                break;
+            }
+            case CMDU_TYPE_TOPOLOGY_RESPONSE:
+            {
+                aux = "CMDU_TYPE_TOPOLOGY_RESPONSE";
+                break;
+            }
+            case CMDU_TYPE_VENDOR_SPECIFIC:
+            {
+                aux = "CMDU_TYPE_VENDOR_SPECIFIC";
+                break;
+            }
+            case CMDU_TYPE_LINK_METRIC_QUERY:
+            {
+                aux = "CMDU_TYPE_LINK_METRIC_QUERY";
+                break;
+            }
+            case CMDU_TYPE_LINK_METRIC_RESPONSE:
+            {
+                aux = "CMDU_TYPE_LINK_METRIC_RESPONSE";
+                break;
+            }
+            case CMDU_TYPE_AP_AUTOCONFIGURATION_SEARCH:
+            {
+                aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_SEARCH";
+                break;
+            }
+            case CMDU_TYPE_AP_AUTOCONFIGURATION_RESPONSE:
+            {
+                aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_RESPONSE";
+                break;
+            }
+            case CMDU_TYPE_AP_AUTOCONFIGURATION_WSC:
+            {
+                aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_WSC";
+                break;
+            }
+            case CMDU_TYPE_AP_AUTOCONFIGURATION_RENEW:
+            {
+                aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_RENEW";
+                break;
+            }
+            case CMDU_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
+            {
+                aux = "CMDU_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION";
+                break;
+            }
+            case CMDU_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
+            {
+                aux = "CMDU_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION";
+                break;
+            }
+            default:
+            {
+                aux = "UNKNOWN";
+                break;
+            }
+        }
+
         ifs_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&ifs_nr);
+        fwd_nr    = 0;
+
         for (i=0; i<ifs_nr; i++)
         {
             uint8_t authenticated;
             uint8_t power_state;
+            uint8_t is_receiving_interface;
+            uint8_t mac_address[6];
 
-            struct interfaceInfo *x;
-
-            x = PLATFORM_GET_1905_INTERFACE_INFO(ifs_names[i]);
-            if (NULL == x)
+            if (0 == PLATFORM_GET_1905_INTERFACE_STATE(ifs_names[i], mac_address, &authenticated, &power_state))
             {
                 PLATFORM_PRINTF_DEBUG_WARNING("Could not retrieve info of interface %s\n", ifs_names[i]);
-                authenticated = 0;
-                power_state   = INTERFACE_POWER_STATE_OFF;
+                authenticated          = 0;
+                power_state            = INTERFACE_POWER_STATE_OFF;
+                is_receiving_interface = 0;
             }
             else
             {
-                authenticated = x->is_secured;
-                power_state   = x->power_state;
+                is_receiving_interface = 0 == memcmp(mac_address, receiving_interface_addr, 6);
             }
 
             if (
                 (0 == authenticated                                                                     ) ||
                 ((power_state != INTERFACE_POWER_STATE_ON) && (power_state!= INTERFACE_POWER_STATE_SAVE)) ||
-                (0 == memcmp(x->mac_address, receiving_interface_addr, 6))
+                (is_receiving_interface)
                )
             {
                 // Do not forward the message on this interface
                 //
-                if (NULL != x)
-                {
-                    free_1905_INTERFACE_INFO(x);
-                }
                 continue;
             }
 
-            if (NULL != x)
-            {
-                free_1905_INTERFACE_INFO(x);
-            }
-
-            // Retransmit message
-            //
-            switch (c->message_type)
-            {
-                case CMDU_TYPE_TOPOLOGY_DISCOVERY:
-                {
-                    aux = "CMDU_TYPE_TOPOLOGY_DISCOVERY";
-                    break;
-                }
-                case CMDU_TYPE_TOPOLOGY_NOTIFICATION:
-                {
-                    aux = "CMDU_TYPE_TOPOLOGY_NOTIFICATION";
-                    break;
-                }
-                case CMDU_TYPE_TOPOLOGY_QUERY:
-                {
-                    aux = "CMDU_TYPE_TOPOLOGY_QUERY";
-                    break;
-                }
-                case CMDU_TYPE_TOPOLOGY_RESPONSE:
-                {
-                    aux = "CMDU_TYPE_TOPOLOGY_RESPONSE";
-                    break;
-                }
-                case CMDU_TYPE_VENDOR_SPECIFIC:
-                {
-                    aux = "CMDU_TYPE_VENDOR_SPECIFIC";
-                    break;
-                }
-                case CMDU_TYPE_LINK_METRIC_QUERY:
-                {
-                    aux = "CMDU_TYPE_LINK_METRIC_QUERY";
-                    break;
-                }
-                case CMDU_TYPE_LINK_METRIC_RESPONSE:
-                {
-                    aux = "CMDU_TYPE_LINK_METRIC_RESPONSE";
-                    break;
-                }
-                case CMDU_TYPE_AP_AUTOCONFIGURATION_SEARCH:
-                {
-                    aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_SEARCH";
-                    break;
-                }
-                case CMDU_TYPE_AP_AUTOCONFIGURATION_RESPONSE:
-                {
-                    aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_RESPONSE";
-                    break;
-                }
-                case CMDU_TYPE_AP_AUTOCONFIGURATION_WSC:
-                {
-                    aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_WSC";
-                    break;
-                }
-                case CMDU_TYPE_AP_AUTOCONFIGURATION_RENEW:
-                {
-                    aux = "CMDU_TYPE_AP_AUTOCONFIGURATION_RENEW";
-                    break;
-                }
-                case CMDU_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION:
-                {
-                    aux = "CMDU_TYPE_PUSH_BUTTON_EVENT_NOTIFICATION";
-                    break;
-                }
-                case CMDU_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION:
-                {
-                    aux = "CMDU_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION";
-                    break;
-                }
-                default:
-                {
-                    aux = "UNKNOWN";
-                    break;
-                }
-            }
             PLATFORM_PRINTF_DEBUG_INFO("--> %s (forwarding from %s to %s)\n", aux, DMmacToInterfaceName(receiving_interface_addr), ifs_names[i]);
+            fwd_names[fwd_nr++] = ifs_names[i];
+        }
 
-            if (0 == send1905RawPacket(ifs_names[i], c->message_id, destination_mac_addr, c))
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("Could not retransmit 1905 message on interface %s\n", x->name);
-            }
+        // Retransmit the received fragments on all selected interfaces at once
+        //
+        if (fwd_nr > 0 && 0 == send1905RawStreamsBatch(fwd_names, fwd_nr, destination_mac_addr, streams, streams_lens))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Could not retransmit 1905 message\n");
         }
+
         free_LIST_OF_1905_INTERFACES(ifs_names, ifs_nr);
     }
 
@@ -807,6 +428,28 @@ void _triggerAPSearchProcess(void)
 }
 
 
+// Returns "1" if the TLVs of a CMDU of type "message_type" are stored in the
+// data model by "process1905Cmdu()" (and thus outlive the CMDU), "0" otherwise.
+//
+// Those CMDUs are parsed to the heap: parsed into an arena, each stored TLV
+// would keep the whole arena alive for as long as the device is known.
+//
+uint8_t _cmduKeepsTLVs(uint16_t message_type)
+{
+    switch (message_type)
+    {
+        case CMDU_TYPE_TOPOLOGY_RESPONSE:
+        case CMDU_TYPE_LINK_METRIC_RESPONSE:
+        case CMDU_TYPE_HIGHER_LAYER_RESPONSE:
+        case CMDU_TYPE_GENERIC_PHY_RESPONSE:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Public functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -814,11 +457,14 @@ void _triggerAPSearchProcess(void)
 uint8_t start1905AL()
 {
     uint8_t   queue_id;
-    uint8_t  *queue_message;
+    const uint8_t  *queue_message;
 
     uint8_t i;
     struct interface *interface;
 
+    uint8_t   gc_removed = 0;  // Devices were removed since the last topology
+                               // notification
+
     // Create a queue that will later be used by the platform code to notify us
     // when certain types of "events" take place
     //
@@ -864,14 +510,16 @@ uint8_t start1905AL()
         }
     }
 
-    // ...and a slighlty higher timeout to "clean" the database from nodes that
-    // have left the network without notice
+    // ...and a shorter one to "clean" the database from nodes that have left
+    // the network without notice (each run only removes a few of the expired
+    // ones, see "DMrunGarbageCollector()") and to discard the fragments of
+    // CMDUs that will never be complete
     //
     PLATFORM_PRINTF_DEBUG_DETAIL("Registering GARBAGE COLLECTOR time out event (periodic)...\n");
     {
         struct eventTimeOut aux;
 
-        aux.timeout_ms = 70000;  // 70 seconds
+        aux.timeout_ms = 1000;  // 1 second
         aux.token      = TIMER_TOKEN_GARBAGE_COLLECTOR;
 
         if (0 == PLATFORM_REGISTER_QUEUE_EVENT(queue_id, PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC, &aux))
@@ -954,21 +602,23 @@ uint8_t start1905AL()
         return AL_ERROR_PROTOCOL_EXTENSION;
     }
 
-    // Prepare the message queue
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("Allocating memory to hold a queue message...\n");
-    queue_message = (uint8_t *)memalloc(MAX_NETWORK_SEGMENT_SIZE+3);
-
     PLATFORM_PRINTF_DEBUG_DETAIL("Entering read-process loop...\n");
+    queue_message = NULL;
     while(1)
     {
         const uint8_t  *p;
         uint8_t   message_type;
         uint16_t  message_len;
 
+        // Messages are processed in place, in a buffer owned by the platform.
+        // Give back the previous one before waiting for the next.
+        //
+        PLATFORM_RELEASE_QUEUE_MESSAGE(queue_message);
+
         PLATFORM_PRINTF_DEBUG_DETAIL("\n");
         PLATFORM_PRINTF_DEBUG_DETAIL("Waiting for new queue message...\n");
-        if (0 == PLATFORM_READ_QUEUE(queue_id, queue_message))
+        queue_message = PLATFORM_READ_QUEUE_MESSAGE(queue_id);
+        if (NULL == queue_message)
         {
             PLATFORM_PRINTF_DEBUG_WARNING("Something went wrong while trying to retrieve a new message from the queue. Ignoring...\n");
             continue;
@@ -1044,8 +694,11 @@ uint8_t start1905AL()
                         }
                         else
                         {
-                            PLATFORM_PRINTF_DEBUG_DETAIL("LLDP message contents:\n");
-                            visit_lldp_PAYLOAD_structure(payload, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                            if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+                            {
+                                PLATFORM_PRINTF_DEBUG_DETAIL("LLDP message contents:\n");
+                                visit_lldp_PAYLOAD_structure(payload, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                            }
 
                             processLlpdPayload(payload, receiving_interface);
 
@@ -1057,33 +710,63 @@ uint8_t start1905AL()
 
                     case ETHERTYPE_1905:
                     {
-                        struct CMDU *c;
+                        struct reassembledCMDU  *r;
+                        struct CMDU_view         view;
+                        struct CMDU             *c;
 
                         PLATFORM_PRINTF_DEBUG_DETAIL("CMDU message received. Reassembling...\n");
 
-                        c = _reAssembleFragmentedCMDUs(p, message_len);
+                        r = reassemblyAddFragment(p, message_len, PLATFORM_GET_TIMESTAMP());
 
-                        if (NULL == c)
+                        if (NULL == r)
                         {
                             // This was just a fragment part of a big CMDU.
                             // The data has been internally cached, waiting for
                             // the rest of pieces.
                         }
+                        else if (!parse_1905_CMDU_view_from_packets(r->streams, r->streams_lens, &view))
+                        {
+                            PLATFORM_PRINTF_DEBUG_WARNING("parse_1905_CMDU_view_from_packets() failed\n");
+                            reassemblyFree(r);
+                        }
                         else
                         {
+                            // Duplicates are detected on the view, before
+                            // anything is decoded.
+                            //
                             if (
-                                 1 == _checkDuplicates(src_addr, c)
+                                 1 == _checkDuplicates(src_addr, &view)
                                )
                             {
                                PLATFORM_PRINTF_DEBUG_WARNING("Receiving on %s a CMDU which is a duplicate of a previous one (mid = %d). Discarding...\n",
-                                                             receiving_interface->name, c->message_id);
+                                                             receiving_interface->name, view.message_id);
+                            }
+                            else if (1 == DMnetworkDeviceInfoUnchanged(&view))
+                            {
+                                // Same information as the last time this
+                                // device sent it: there is no need to decode
+                                // it (nor to replace what the data model
+                                // already contains).
+                                //
+                                process1905UnchangedCmdu(&view, receiving_interface);
+
+                                _checkForwarding(receiving_interface->addr, dst_addr, &view, r->streams, r->streams_lens);
+                            }
+                            else if (NULL == (c = _cmduKeepsTLVs(view.message_type) ?
+                                                      parse_1905_CMDU_from_view(&view) :
+                                                      parse_1905_CMDU_from_view_in_arena(&view)))
+                            {
+                                PLATFORM_PRINTF_DEBUG_WARNING("parse_1905_CMDU_from_view() failed\n");
                             }
                             else
                             {
                                 uint8_t res;
 
-                                PLATFORM_PRINTF_DEBUG_DETAIL("CMDU message contents:\n");
-                                visit_1905_CMDU_structure(c, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                                if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+                                {
+                                    PLATFORM_PRINTF_DEBUG_DETAIL("CMDU message contents:\n");
+                                    visit_1905_CMDU_structure(c, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                                }
 
                                 // Process the message on the local node
                                 //
@@ -1097,10 +780,19 @@ uint8_t start1905AL()
                                 // message on the rest of interfaces (depending
                                 // on the "relayed multicast" flag
                                 //
-                                _checkForwarding(receiving_interface->addr, dst_addr, c);
+                                _checkForwarding(receiving_interface->addr, dst_addr, &view, r->streams, r->streams_lens);
+
+                                free_1905_CMDU_structure(c);
                             }
 
-                            free_1905_CMDU_structure(c);
+                            // If the CMDU was not stored in the data model
+                            // (e.g. it could not be decoded), its hashes must
+                            // not be used for anything else
+                            //
+                            DMnetworkDeviceInfoDone();
+
+                            free_1905_CMDU_view(&view);
+                            reassemblyFree(r);
                         }
 
                         break;
@@ -1140,8 +832,11 @@ uint8_t start1905AL()
                     PLATFORM_PRINTF_DEBUG_WARNING("Invalid ALME message. Ignoring...\n");
                 }
 
-                PLATFORM_PRINTF_DEBUG_DETAIL("ALME message contents:\n");
-                visit_1905_ALME_structure((uint8_t *)alme_tlv, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+                {
+                    PLATFORM_PRINTF_DEBUG_DETAIL("ALME message contents:\n");
+                    visit_1905_ALME_structure((uint8_t *)alme_tlv, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+                }
 
                 process1905Alme(alme_tlv, alme_client_id);
 
@@ -1272,15 +967,30 @@ uint8_t start1905AL()
 
                     case TIMER_TOKEN_GARBAGE_COLLECTOR:
                     {
-                        PLATFORM_PRINTF_DEBUG_DETAIL("Running garbage collector...\n");
+                        // Otherwise, the fragments of an incomplete CMDU
+                        // would only be released when the next fragment (of
+                        // any CMDU) is received
+                        //
+                        reassemblyExpire(PLATFORM_GET_TIMESTAMP());
 
                         if (DMrunGarbageCollector() > 0)
+                        {
+                            gc_removed = 1;
+                        }
+
+                        // When many devices leave at once they are removed
+                        // over several runs. Only notify the network once all
+                        // of them are gone.
+                        //
+                        if (1 == gc_removed && 0 == DMgarbageCollectorPending())
                         {
                             uint16_t mid;
 
                             char **ifs_names;
                             uint8_t  ifs_nr;
 
+                            gc_removed = 0;
+
                             PLATFORM_PRINTF_DEBUG_DETAIL("Some elements were removed. Sending a topology change notification...");
 
                             // According to "Section 8.2.2.3" and "Section
@@ -0,0 +1,566 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+#include "platform.h"
+#include "utils.h"
+#include "dlist.h"
+#include "hlist.h" // MACSTR
+
+#include "1905_cmdus.h"
+
+#include "al_reassembly.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+////////////////////////////////////////////////////////////////////////////////
+// Private data and functions
+////////////////////////////////////////////////////////////////////////////////
+
+#define ETH_HEADER_LEN            (6+6+2)
+#define MAX_FRAGMENTS             256    // 'fragment_id' is 8 bits long
+#define LAST_FRAGMENT_UNKNOWN     MAX_FRAGMENTS
+#define INITIAL_HASH_SIZE         64     // Always a power of 2
+
+// Where a fragment is located in the buffer of its CMDU
+//
+struct _fragment
+{
+    uint32_t offset;
+    uint16_t len;
+    uint8_t  fragment_id;
+};
+
+// One CMDU being reassembled
+//
+struct _inFlight
+{
+    dlist_item         l;               // Position in 'in_flight_list' (the
+                                        // oldest CMDU is the first one)
+
+    struct _inFlight  *hash_next;       // Next entry in the same hash bucket
+
+    uint8_t   src_addr[6];
+    uint8_t   dst_addr[6];
+    uint16_t  mid;
+                                        // These three fields identify the
+                                        // fragments belonging to this CMDU
+
+    uint32_t  deadline;                 // Time (in ms) after which this CMDU
+                                        // is discarded
+
+    uint8_t   received[MAX_FRAGMENTS/8];// Bitmap of received 'fragment_id's
+    uint16_t  last_fragment;            // 'fragment_id' of the fragment with
+                                        // the 'last_fragment_indicator' flag
+                                        // set or LAST_FRAGMENT_UNKNOWN
+    uint16_t  max_fragment;             // Highest received 'fragment_id'
+
+    struct _fragment *fragments;        // In reception order
+    unsigned          fragments_nr;
+    unsigned          fragments_max;
+
+    uint8_t  *buffer;                   // Contents of all received fragments,
+    size_t    buffer_len;               // in reception order
+    size_t    buffer_size;
+};
+
+static struct
+{
+    struct _inFlight **hash;
+    unsigned           hash_size;
+
+    dlist_head         in_flight_list;
+
+    uint32_t           timeout;
+    size_t             max_bytes;
+
+    struct reassemblyStats stats;
+
+} reassembly = {
+    .in_flight_list = {&reassembly.in_flight_list, &reassembly.in_flight_list},
+    .timeout        = REASSEMBLY_DEFAULT_TIMEOUT_MS,
+    .max_bytes      = REASSEMBLY_DEFAULT_MAX_BYTES,
+};
+
+static size_t _entrySize(const struct _inFlight *e)
+{
+    return sizeof(*e) + e->buffer_size + e->fragments_max * sizeof(struct _fragment);
+}
+
+static unsigned _hashKey(const uint8_t *src_addr, const uint8_t *dst_addr, uint16_t mid)
+{
+    // FNV-1a over the (src, dst, mid) tuple
+    //
+    uint32_t h = 2166136261u;
+    unsigned i;
+
+    for (i = 0; i < 6; i++)
+    {
+        h = (h ^ src_addr[i]) * 16777619u;
+        h = (h ^ dst_addr[i]) * 16777619u;
+    }
+    h = (h ^ (mid & 0xff)) * 16777619u;
+    h = (h ^ (mid >> 8))   * 16777619u;
+
+    return h & (reassembly.hash_size - 1);
+}
+
+static void _hashInsert(struct _inFlight *e)
+{
+    unsigned b = _hashKey(e->src_addr, e->dst_addr, e->mid);
+
+    e->hash_next        = reassembly.hash[b];
+    reassembly.hash[b]  = e;
+}
+
+static void _hashResize(unsigned hash_size)
+{
+    struct _inFlight *e;
+
+    memfree(reassembly.hash);
+    reassembly.hash      = (struct _inFlight **)zmemalloc(hash_size * sizeof(struct _inFlight *));
+    reassembly.hash_size = hash_size;
+
+    dlist_for_each(e, reassembly.in_flight_list, l)
+    {
+        _hashInsert(e);
+    }
+}
+
+static struct _inFlight *_find(const struct CMDU_header *h)
+{
+    struct _inFlight *e;
+
+    if (0 == reassembly.hash_size)
+    {
+        return NULL;
+    }
+
+    for (e = reassembly.hash[_hashKey(h->src_addr, h->dst_addr, h->mid)]; NULL != e; e = e->hash_next)
+    {
+        if (e->mid == h->mid && 0 == memcmp(e->src_addr, h->src_addr, 6) && 0 == memcmp(e->dst_addr, h->dst_addr, 6))
+        {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+
+static struct _inFlight *_create(const struct CMDU_header *h, uint32_t now)
+{
+    struct _inFlight *e;
+
+    if (2 * (reassembly.stats.in_flight + 1) > reassembly.hash_size)
+    {
+        _hashResize(reassembly.hash_size ? 2 * reassembly.hash_size : INITIAL_HASH_SIZE);
+    }
+
+    e = (struct _inFlight *)zmemalloc(sizeof(struct _inFlight));
+    memcpy(e->src_addr, h->src_addr, 6);
+    memcpy(e->dst_addr, h->dst_addr, 6);
+    e->mid           = h->mid;
+    e->deadline      = now + reassembly.timeout;
+    e->last_fragment = LAST_FRAGMENT_UNKNOWN;
+
+    dlist_add_tail(&reassembly.in_flight_list, &e->l);
+    _hashInsert(e);
+
+    reassembly.stats.in_flight++;
+    reassembly.stats.bytes += _entrySize(e);
+
+    return e;
+}
+
+// Remove the entry from all data structures. If 'keep_buffer' is set, the
+// fragments buffer is not freed (it has been handed over to a
+// "struct reassembledCMDU").
+//
+static void _destroy(struct _inFlight *e, int keep_buffer)
+{
+    struct _inFlight **pe;
+
+    pe = &reassembly.hash[_hashKey(e->src_addr, e->dst_addr, e->mid)];
+    while (*pe != e)
+    {
+        pe = &(*pe)->hash_next;
+    }
+    *pe = e->hash_next;
+
+    dlist_remove(&e->l);
+
+    reassembly.stats.in_flight--;
+    reassembly.stats.bytes -= _entrySize(e);
+
+    if (!keep_buffer)
+    {
+        memfree(e->buffer);
+    }
+    memfree(e->fragments);
+    memfree(e);
+}
+
+static void _logDiscarded(const char *reason, const struct _inFlight *e)
+{
+    PLATFORM_PRINTF_DEBUG_WARNING("Discarding CMDU fragments (%s): mid = %d, src_addr = " MACSTR ", dst_addr = " MACSTR ", %u fragment(s) received\n",
+                                  reason, e->mid, MAC2STR(e->src_addr), MAC2STR(e->dst_addr), e->fragments_nr);
+}
+
+// Compute the sizes the buffer and the fragments array of 'e' grow to when a
+// fragment of 'len' bytes is appended
+//
+static void _grownSizes(const struct _inFlight *e, uint16_t len, size_t *buffer_size, unsigned *fragments_max)
+{
+    *buffer_size = e->buffer_size;
+    if (e->buffer_len + len > e->buffer_size)
+    {
+        *buffer_size = 2 * e->buffer_size;
+        if (*buffer_size < e->buffer_len + len)
+        {
+            *buffer_size = e->buffer_len + len;
+        }
+    }
+
+    *fragments_max = e->fragments_max;
+    if (e->fragments_nr == e->fragments_max)
+    {
+        *fragments_max = e->fragments_max ? 2 * e->fragments_max : 4;
+    }
+}
+
+// Number of bytes '_entrySize(e)' grows by when a fragment of 'len' bytes is
+// appended
+//
+static size_t _appendGrowth(const struct _inFlight *e, uint16_t len)
+{
+    size_t   buffer_size;
+    unsigned fragments_max;
+
+    _grownSizes(e, len, &buffer_size, &fragments_max);
+
+    return (buffer_size - e->buffer_size) + (fragments_max - e->fragments_max) * sizeof(struct _fragment);
+}
+
+// Append the fragment payload ('p', 'len' bytes) to the buffer of 'e'
+//
+static void _append(struct _inFlight *e, uint8_t fragment_id, const uint8_t *p, uint16_t len)
+{
+    size_t   old_size = _entrySize(e);
+    size_t   buffer_size;
+    unsigned fragments_max;
+
+    _grownSizes(e, len, &buffer_size, &fragments_max);
+    if (buffer_size != e->buffer_size)
+    {
+        e->buffer_size = buffer_size;
+        e->buffer      = (uint8_t *)memrealloc(e->buffer, e->buffer_size);
+    }
+    if (fragments_max != e->fragments_max)
+    {
+        e->fragments_max = fragments_max;
+        e->fragments     = (struct _fragment *)memrealloc(e->fragments, e->fragments_max * sizeof(struct _fragment));
+    }
+
+    e->fragments[e->fragments_nr].offset      = e->buffer_len;
+    e->fragments[e->fragments_nr].len         = len;
+    e->fragments[e->fragments_nr].fragment_id = fragment_id;
+    e->fragments_nr++;
+
+    memcpy(e->buffer + e->buffer_len, p, len);
+    e->buffer_len += len;
+
+    e->received[fragment_id / 8] |= 1 << (fragment_id % 8);
+    if (fragment_id > e->max_fragment)
+    {
+        e->max_fragment = fragment_id;
+    }
+
+    reassembly.stats.bytes += _entrySize(e) - old_size;
+}
+
+// Build the structure returned to the caller for 'fragments_nr' fragments.
+// The streams still need to be filled in.
+//
+static struct reassembledCMDU *_newResult(unsigned fragments_nr, size_t extra)
+{
+    struct reassembledCMDU *r;
+
+    r = (struct reassembledCMDU *)memalloc(sizeof(struct reassembledCMDU) +
+                                           (fragments_nr + 1) * (sizeof(uint8_t *) + sizeof(uint16_t)) + extra);
+    r->streams      = (uint8_t **)(r + 1);
+    r->streams_lens = (uint16_t *)(r->streams + fragments_nr + 1);
+    r->buffer       = NULL;
+
+    r->streams[fragments_nr]      = NULL;
+    r->streams_lens[fragments_nr] = 0;
+
+    return r;
+}
+
+static struct reassembledCMDU *_complete(struct _inFlight *e)
+{
+    struct reassembledCMDU *r;
+    unsigned i;
+
+    r = _newResult(e->fragments_nr, 0);
+    for (i = 0; i < e->fragments_nr; i++)
+    {
+        r->streams[e->fragments[i].fragment_id]      = e->buffer + e->fragments[i].offset;
+        r->streams_lens[e->fragments[i].fragment_id] = e->fragments[i].len;
+    }
+    r->buffer = e->buffer;
+
+    _destroy(e, 1);
+    reassembly.stats.completions++;
+
+    return r;
+}
+
+// Make room for 'len' more bytes of 'current' (i.e. for what its buffers grow
+// by, see "_appendGrowth()") by evicting *other* in-flight
+// CMDUs, in the order their first fragment was received. 'current' itself is
+// never evicted here, even if it is the oldest one: e.g. the last fragment of
+// CMDU #10 evicts CMDU #9 (although it started earlier) so that #10 can be
+// completed. Returns '0' if there is no way to make room.
+//
+static uint8_t _makeRoom(size_t len, const struct _inFlight *current)
+{
+    while (reassembly.stats.bytes + len > reassembly.max_bytes)
+    {
+        struct _inFlight *oldest = container_of(dlist_get_first(&reassembly.in_flight_list), struct _inFlight, l);
+
+        if (oldest == current)
+        {
+            // Skip 'current' and evict the next oldest one instead
+            //
+            if (oldest->l.next == &reassembly.in_flight_list)
+            {
+                return 0;
+            }
+            oldest = container_of(oldest->l.next, struct _inFlight, l);
+        }
+
+        _logDiscarded("out of memory", oldest);
+        _destroy(oldest, 0);
+        reassembly.stats.evictions++;
+    }
+
+    return 1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public API
+////////////////////////////////////////////////////////////////////////////////
+
+void reassemblySetLimits(uint32_t timeout_ms, size_t max_bytes)
+{
+    reassembly.timeout   = timeout_ms;
+    reassembly.max_bytes = max_bytes;
+}
+
+struct reassembledCMDU *reassemblyAddFragment(const uint8_t *packet_buffer, uint16_t len, uint32_t now)
+{
+    struct CMDU_header      cmdu_header;
+    struct _inFlight       *e;
+    const uint8_t          *p;
+
+    reassemblyExpire(now);
+
+    if (!parse_1905_CMDU_header_from_packet(packet_buffer, len, &cmdu_header))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("Could not retrieve CMDU header from bit stream\n");
+        reassembly.stats.errors++;
+        return NULL;
+    }
+    PLATFORM_PRINTF_DEBUG_DETAIL("mid = %d, fragment_id = %d, last_fragment_indicator = %d\n",
+                                 cmdu_header.mid, cmdu_header.fragment_id, cmdu_header.last_fragment_indicator);
+
+    // Skip over ethernet header
+    //
+    p    = packet_buffer + ETH_HEADER_LEN;
+    len -= ETH_HEADER_LEN;
+
+    e = _find(&cmdu_header);
+
+    if (NULL == e)
+    {
+        if (0 == cmdu_header.fragment_id && cmdu_header.last_fragment_indicator)
+        {
+            // Not fragmented at all (the most common case): there is no need
+            // to keep any state.
+            //
+            struct reassembledCMDU *r = _newResult(1, len);
+
+            r->streams[0]      = (uint8_t *)(r->streams_lens + 2);
+            r->streams_lens[0] = len;
+            memcpy(r->streams[0], p, len);
+
+            reassembly.stats.completions++;
+            return r;
+        }
+
+        e = _create(&cmdu_header, now);
+    }
+    else
+    {
+        // Fragments for this CMDU have previously been received. Check that
+        // this new one is consistent with them.
+        //
+        if (e->received[cmdu_header.fragment_id / 8] & (1 << (cmdu_header.fragment_id % 8)))
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Ignoring duplicated fragment #%d (mid = %d, src_addr = " MACSTR ")\n",
+                                          cmdu_header.fragment_id, cmdu_header.mid, MAC2STR(cmdu_header.src_addr));
+            reassembly.stats.duplicates++;
+            return NULL;
+        }
+
+        if (cmdu_header.last_fragment_indicator && LAST_FRAGMENT_UNKNOWN != e->last_fragment)
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("This fragment (#%d) and a previously received one (#%d) both contain the 'last_fragment_indicator' flag set. Ignoring...\n",
+                                          cmdu_header.fragment_id, e->last_fragment);
+            reassembly.stats.errors++;
+            return NULL;
+        }
+    }
+
+    if ((LAST_FRAGMENT_UNKNOWN != e->last_fragment && cmdu_header.fragment_id > e->last_fragment) ||
+        (cmdu_header.last_fragment_indicator && e->fragments_nr > 0 && cmdu_header.fragment_id < e->max_fragment))
+    {
+        // A fragment beyond the last one
+        //
+        _logDiscarded("fragment after the last one", e);
+        _destroy(e, 0);
+        reassembly.stats.errors++;
+        return NULL;
+    }
+
+    if (!_makeRoom(_appendGrowth(e, len), e))
+    {
+        _logDiscarded("CMDU too big", e);
+        _destroy(e, 0);
+        reassembly.stats.evictions++;
+        return NULL;
+    }
+
+    _append(e, cmdu_header.fragment_id, p, len);
+
+    if (cmdu_header.last_fragment_indicator)
+    {
+        e->last_fragment = cmdu_header.fragment_id;
+    }
+
+    // Since duplicates and fragments beyond the last one are rejected, the
+    // CMDU is complete as soon as we have as many fragments as the number of
+    // the last one.
+    //
+    if (LAST_FRAGMENT_UNKNOWN != e->last_fragment && e->fragments_nr == (unsigned)e->last_fragment + 1)
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("All fragments belonging to this CMDU have already been received\n");
+        return _complete(e);
+    }
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("We still have to wait for more fragments to complete the CMDU message\n");
+    return NULL;
+}
+
+void reassemblyFree(struct reassembledCMDU *cmdu)
+{
+    if (NULL == cmdu)
+    {
+        return;
+    }
+    memfree(cmdu->buffer);
+    memfree(cmdu);
+}
+
+void reassemblyExpire(uint32_t now)
+{
+    dlist_item *item;
+
+    // Entries are sorted by creation time, thus also by deadline (as long as
+    // the timeout is not changed)
+    //
+    while (NULL != (item = dlist_get_first(&reassembly.in_flight_list)))
+    {
+        struct _inFlight *e = container_of(item, struct _inFlight, l);
+
+        if ((int32_t)(now - e->deadline) < 0)
+        {
+            break;
+        }
+
+        _logDiscarded("timeout", e);
+        _destroy(e, 0);
+        reassembly.stats.timeouts++;
+    }
+}
+
+void reassemblyFlush(void)
+{
+    dlist_item *item;
+
+    while (NULL != (item = dlist_get_first(&reassembly.in_flight_list)))
+    {
+        _destroy(container_of(item, struct _inFlight, l), 0);
+    }
+}
+
+void reassemblyGetStats(struct reassemblyStats *stats)
+{
+    *stats = reassembly.stats;
+}
@@ -0,0 +1,161 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+#ifndef _AL_REASSEMBLY_H_
+#define _AL_REASSEMBLY_H_
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+
+// CMDUs larger than one ETH frame are sent as several fragments ("IEEE Std
+// 1905.1-2013, Section 7.1.1"). Fragments belonging to the same CMDU share the
+// same source address, destination address and MID.
+//
+// This module buffers the fragments of all the CMDUs being received until
+// either:
+//
+//   - All of them are available. The complete CMDU is then handed back to the
+//     caller.
+//
+//   - The CMDU reassembly deadline expires (i.e. some fragment got lost). The
+//     fragments are then discarded.
+//
+//   - The total memory used by buffered fragments exceeds a limit. Other
+//     CMDUs than the one the new fragment belongs to are then discarded
+//     ("evicted") to make room, those that started being received first going
+//     first.
+//
+// In-flight CMDUs are kept in a hash table indexed by (src, dst, mid), so
+// the cost of adding a fragment does not depend on how many CMDUs are being
+// reassembled. The fragments of each CMDU are appended to one contiguous
+// buffer, in the order they are received. There is no limit on the number of
+// fragments other than the one imposed by the 8 bits 'fragment_id' field.
+//
+
+// Default values for "reassemblySetLimits()"
+//
+#define REASSEMBLY_DEFAULT_TIMEOUT_MS  5000
+#define REASSEMBLY_DEFAULT_MAX_BYTES   (512 * 1024)
+
+// A completely received CMDU, as returned by "reassemblyAddFragment()"
+//
+struct reassembledCMDU
+{
+    uint8_t   **streams;       // NULL-terminated list of fragments (starting at
+                               // the 1905 header, ie. offset +14 of the ETH
+                               // frame) sorted by 'fragment_id'. This is the
+                               // format expected by
+                               // "parse_1905_CMDU_view_from_packets()".
+
+    uint16_t   *streams_lens;  // Length of each fragment, '0' terminated
+
+    uint8_t    *buffer;        // Memory the streams point into
+};
+
+// Counters, as returned by "reassemblyGetStats()"
+//
+struct reassemblyStats
+{
+    uint32_t completions;      // CMDUs completely reassembled
+    uint32_t timeouts;         // CMDUs discarded because of the deadline
+    uint32_t evictions;        // CMDUs discarded because of the memory limit
+    uint32_t duplicates;       // Fragments discarded because already received
+    uint32_t errors;           // Malformed or inconsistent fragments
+
+    uint32_t in_flight;        // CMDUs currently being reassembled
+    size_t   bytes;            // Memory currently used by their fragments
+};
+
+// Configure how long (since its first fragment is received) a CMDU may take
+// to be complete and how much memory all buffered fragments may use.
+//
+void reassemblySetLimits(uint32_t timeout_ms, size_t max_bytes);
+
+// Add one received ETH frame ('packet_buffer', 'len' bytes long, including the
+// ETH header) containing a CMDU fragment, received at time 'now' (in
+// milliseconds, as returned by "PLATFORM_GET_TIMESTAMP()").
+//
+// The frame is copied, so the caller does not need to keep it.
+//
+// Returns NULL if the CMDU is not complete yet (or the fragment had to be
+// discarded). Otherwise, returns the complete CMDU, which must be freed with
+// "reassemblyFree()".
+//
+// In-flight CMDUs whose deadline has expired are discarded on every call (the
+// caller should also call "reassemblyExpire()" periodically, so that they are
+// discarded even if no more fragments are received).
+//
+struct reassembledCMDU *reassemblyAddFragment(const uint8_t *packet_buffer, uint16_t len, uint32_t now);
+
+// Free a structure returned by "reassemblyAddFragment()"
+//
+void reassemblyFree(struct reassembledCMDU *cmdu);
+
+// Discard all in-flight CMDUs whose deadline has expired at time 'now'
+//
+void reassemblyExpire(uint32_t now);
+
+// Discard all in-flight CMDUs (the counters are kept)
+//
+void reassemblyFlush(void);
+
+// Retrieve the counters
+//
+void reassemblyGetStats(struct reassemblyStats *stats);
+
+#endif
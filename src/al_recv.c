@@ -125,6 +125,112 @@ static bool handleSupportedServiceTLV(struct alDevice *sender_device, struct tlv
     return sender_is_map_controller;
 }
 
+// Send, through 'receiving_interface', the queries that follow the reception
+// of a "topology response" from the device described by 'info' (whose 1905
+// neighbors are listed in the 'z_nr' entries of 'z'), so that the rest of its
+// information keeps being updated.
+//
+static void _queryNetworkDeviceDetails(struct interface *receiving_interface, struct deviceInformationTypeTLV *info,
+                                       struct neighborDeviceListTLV **z, unsigned z_nr)
+{
+    unsigned i;
+    struct _localInterfaceEntries *local_interface;
+
+    // Send other queries to the device so that we can keep updating the
+    // database once the responses are received
+    //
+    if ( 0 == send1905MetricsQueryPacket(receiving_interface->name, getNextMid(), info->al_mac_address))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'metrics query' message\n");
+    }
+    if ( 0 == send1905HighLayerQueryPacket(receiving_interface->name, getNextMid(), info->al_mac_address))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'high layer query' message\n");
+    }
+    dlist_for_each(local_interface, info->tlv.s.h.children[0], s.h.l)
+    {
+        if (MEDIA_TYPE_UNKNOWN == local_interface->media_type)
+        {
+            // There is *at least* one generic inteface in the response,
+            // thus query for more information
+            //
+            if ( 0 == send1905GenericPhyQueryPacket(receiving_interface->name, getNextMid(), info->al_mac_address))
+            {
+                PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'generic phy query' message\n");
+            }
+            break;
+        }
+    }
+
+    // There is one extra thing that needs to be done: send topology
+    // query to neighbor's neighbors.
+    //
+    // This is not strictly necessary for 1905 to work. In fact, as I
+    // think the protocol was designed, every node should only be aware
+    // of its *direct* neighbors; and it is the HLE responsability to
+    // query each node and build the network topology map.
+    //
+    // However, the 1905 datamodel standard document, interestingly
+    // (and, I think, erroneously) includes information from all the
+    // nodes (even those that are not direct neighbors).
+    //
+    // Here we are going to retrieve that information but, because this
+    // requires much more memory in the AL node, we will only do this
+    // if the user actually expressed his desire to do so when starting
+    // the AL entity.
+    //
+    if (1 == DMmapWholeNetworkGet())
+    {
+        // For each neighbor interface
+        //
+        for (i=0; i<z_nr; i++)
+        {
+            struct _neighborEntries *neighbor;
+
+            // For each neighbor's neighbor on that interface
+            //
+            dlist_for_each(neighbor, z[i]->tlv.s.h.children[0], s.h.l)
+            {
+                uint8_t ii;
+                struct _neighborEntries *other_neighbor;
+
+                // Discard the current node (obviously)
+                //
+                if (0 == memcmp(DMalMacGet(), neighbor->mac_address, 6))
+                {
+                    continue;
+                }
+
+                // Discard nodes I have just asked for
+                //
+                for (ii=0; ii<i; ii++)
+                {
+                    dlist_for_each(other_neighbor, z[ii]->tlv.s.h.children[0], s.h.l)
+                    {
+                        if (0 == memcmp(other_neighbor->mac_address, neighbor->mac_address, 6))
+                        {
+                            continue;
+                        }
+                    }
+                }
+
+                // Discard neighbors whose information was updated
+                // recently (ie. no need to flood the network)
+                //
+                if (0 == DMnetworkDeviceInfoNeedsUpdate(neighbor->mac_address))
+                {
+                    continue;
+                }
+
+                if ( 0 == send1905TopologyQueryPacket(receiving_interface->name, getNextMid(), neighbor->mac_address))
+                {
+                    PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'topology query' message\n");
+                }
+            }
+        }
+    }
+}
+
 static struct wscRegistrarInfo *findWscInfoForBand(uint8_t freq_band)
 {
     struct wscRegistrarInfo *wsc_info;
@@ -441,13 +547,13 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
             struct l2NeighborDeviceTLV          **r    = NULL;
             struct supportedServiceTLV           *s    = NULL;
 
-            uint8_t bridges_nr;
-            uint8_t non1905_neighbors_nr;
-            uint8_t x1905_neighbors_nr;
-            uint8_t power_off_nr;
-            uint8_t l2_neighbors_nr;
+            unsigned bridges_nr;
+            unsigned non1905_neighbors_nr;
+            unsigned x1905_neighbors_nr;
+            unsigned power_off_nr;
+            unsigned l2_neighbors_nr;
 
-            uint8_t xi, yi, zi, qi, ri;
+            unsigned xi, yi, zi, qi, ri;
 
             PLATFORM_PRINTF_DEBUG_INFO("<-- CMDU_TYPE_TOPOLOGY_RESPONSE (%s)\n", receiving_interface->name);
 
@@ -629,7 +735,7 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
             //   3. Setting "C->list_of_TLVs" to NULL will cause
             //      "free_1905_CMDU_structure()" to ignore this list.
             //
-            free(c->list_of_TLVs);
+            memfree(c->list_of_TLVs);
             c->list_of_TLVs = NULL;
 
             // Next, update the database. This will take care of duplicate
@@ -652,102 +758,17 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
                                       0, NULL);
 
             // Show all network devices (ie. print them through the logging
-            // system)
-            //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
-
-            // And finally, send other queries to the device so that we can
-            // keep updating the database once the responses are received
+            // system), unless nothing changed
             //
-            if ( 0 == send1905MetricsQueryPacket(receiving_interface->name, getNextMid(), info->al_mac_address))
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'metrics query' message\n");
-            }
-            if ( 0 == send1905HighLayerQueryPacket(receiving_interface->name, getNextMid(), info->al_mac_address))
-            {
-                PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'high layer query' message\n");
-            }
-            for (i=0; i<info->local_interfaces_nr; i++)
+            if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL) && 1 == DMnetworkDeviceChanged(info->al_mac_address))
             {
-                if (MEDIA_TYPE_UNKNOWN == info->local_interfaces[i].media_type)
-                {
-                    // There is *at least* one generic inteface in the response,
-                    // thus query for more information
-                    //
-                    if ( 0 == send1905GenericPhyQueryPacket(receiving_interface->name, getNextMid(), info->al_mac_address))
-                    {
-                        PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'generic phy query' message\n");
-                    }
-                    break;
-                }
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
             }
 
-            // There is one extra thing that needs to be done: send topology
-            // query to neighbor's neighbors.
-            //
-            // This is not strictly necessary for 1905 to work. In fact, as I
-            // think the protocol was designed, every node should only be aware
-            // of its *direct* neighbors; and it is the HLE responsability to
-            // query each node and build the network topology map.
-            //
-            // However, the 1905 datamodel standard document, interestingly
-            // (and, I think, erroneously) includes information from all the
-            // nodes (even those that are not direct neighbors).
-            //
-            // Here we are going to retrieve that information but, because this
-            // requires much more memory in the AL node, we will only do this
-            // if the user actually expressed his desire to do so when starting
-            // the AL entity.
+            // And finally, send other queries to the device (and maybe to its
+            // neighbors)
             //
-            if (1 == DMmapWholeNetworkGet())
-            {
-                // For each neighbor interface
-                //
-                for (i=0; i<zi; i++)
-                {
-                    uint8_t j;
-
-                    // For each neighbor's neighbor on that interface
-                    //
-                    for (j=0; j<z[i]->neighbors_nr; j++)
-                    {
-                        uint8_t ii, jj;
-
-                        // Discard the current node (obviously)
-                        //
-                        if (0 == memcmp(DMalMacGet(), z[i]->neighbors[j].mac_address, 6))
-                        {
-                            continue;
-                        }
-
-                        // Discard nodes I have just asked for
-                        //
-                        for (ii=0; ii<i; ii++)
-                        {
-                            for (jj=0; jj<z[ii]->neighbors_nr; jj++)
-                            {
-                                if (0 == memcmp(z[ii]->neighbors[jj].mac_address, z[i]->neighbors[j].mac_address, 6))
-                                {
-                                    continue;
-                                }
-                            }
-                        }
-
-                        // Discard neighbors whose information was updated
-                        // recently (ie. no need to flood the network)
-                        //
-                        if (0 == DMnetworkDeviceInfoNeedsUpdate(z[i]->neighbors[j].mac_address))
-                        {
-                            continue;
-                        }
-
-                        if ( 0 == send1905TopologyQueryPacket(receiving_interface->name, getNextMid(), z[i]->neighbors[j].mac_address))
-                        {
-                            PLATFORM_PRINTF_DEBUG_WARNING("Could not send 'topology query' message\n");
-                        }
-                    }
-                }
-            }
+            _queryNetworkDeviceDetails(receiving_interface, info, z, zi);
 
             break;
         }
@@ -936,13 +957,16 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
             // comment in "case CMDU_TYPE_TOPOLOGY_RESPONSE:" to understand the
             // following two lines).
             //
-            free(c->list_of_TLVs);
+            memfree(c->list_of_TLVs);
             c->list_of_TLVs = NULL;
 
             // Show all network devices (ie. print them through the logging
             // system)
             //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+            {
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            }
 
             break;
         }
@@ -1399,12 +1423,14 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
 
                 // The WSC M2s give us all the BSSes that need to be configured on this radio. So first tear down
                 // all existing ones; wscProcessM2() will create the new ones.
-                for (i = 0; i < radio->configured_bsses.length; i++)
+                // Tearing down a BSS may remove it from configured_bsses
+                // (moving the last one in its place), so go backwards.
+                for (i = radio->configured_bsses.length; i-- > 0; )
                 {
                     struct interfaceWifi *iface = radio->configured_bsses.data[i];
                     if (iface->role == interface_wifi_role_ap)
                     {
-                        interfaceTearDown(&radio->configured_bsses.data[i]->i);
+                        interfaceTearDown(&iface->i);
                     }
                 }
 
@@ -1814,13 +1840,16 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
             // comment in "case CMDU_TYPE_TOPOLOGY_RESPONSE:" to understand the
             // following two lines).
             //
-            free(c->list_of_TLVs);
+            memfree(c->list_of_TLVs);
             c->list_of_TLVs = NULL;
 
             // Show all network devices (ie. print them through the logging
-            // system)
+            // system), unless nothing changed
             //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL) && 1 == DMnetworkDeviceChanged(t->al_mac_address))
+            {
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            }
 
             break;
         }
@@ -1981,13 +2010,16 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
             // comment in "case CMDU_TYPE_TOPOLOGY_RESPONSE:" to understand the
             // following two lines).
             //
-            free(c->list_of_TLVs);
+            memfree(c->list_of_TLVs);
             c->list_of_TLVs = NULL;
 
             // Show all network devices (ie. print them through the logging
-            // system)
+            // system), unless nothing changed
             //
-            DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL) && 1 == DMnetworkDeviceChanged(al_mac_address))
+            {
+                DMdumpNetworkDevices(PLATFORM_PRINTF_DEBUG_DETAIL);
+            }
 
             break;
         }
@@ -2167,6 +2199,37 @@ uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, u
     return PROCESS_CMDU_OK;
 }
 
+uint8_t process1905UnchangedCmdu(const struct CMDU_view *view, struct interface *receiving_interface)
+{
+    const struct CMDU_view_tlv  *p;
+
+    struct deviceInformationTypeTLV  *info;
+    struct neighborDeviceListTLV    **z;
+    unsigned                          zi;
+
+    PLATFORM_PRINTF_DEBUG_INFO("<-- %s (%s) (unchanged)\n", convert_1905_CMDU_type_to_string(view->message_type), receiving_interface->name);
+
+    if (CMDU_TYPE_TOPOLOGY_RESPONSE != view->message_type)
+    {
+        // Nothing else to do
+        //
+        return PROCESS_CMDU_OK;
+    }
+
+    // The stored TLVs are the same ones that were received, so use them to
+    // send the same queries as if the CMDU had been processed.
+    //
+    p = get_1905_CMDU_view_TLV(view, TLV_TYPE_DEVICE_INFORMATION_TYPE);
+    if (NULL == p || 0 == DMnetworkDeviceTopologyGet((uint8_t *)p->value, &info, &z, &zi))
+    {
+        return PROCESS_CMDU_KO;
+    }
+
+    _queryNetworkDeviceDetails(receiving_interface, info, z, zi);
+
+    return PROCESS_CMDU_OK;
+}
+
 uint8_t processLlpdPayload(struct PAYLOAD *payload, struct interface *receiving_interface)
 {
     struct tlv *p;
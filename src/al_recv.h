@@ -95,6 +95,15 @@
 #define PROCESS_CMDU_OK_TRIGGER_AP_SEARCH   (2)
 uint8_t process1905Cmdu(struct CMDU *c, struct interface *receiving_interface, uint8_t *src_addr, uint8_t queue_id);
 
+// Same as "process1905Cmdu()", but for a CMDU that (according to
+// "DMnetworkDeviceInfoUnchanged()") carries exactly the same information the
+// data model already contains, and thus was not decoded.
+//
+// Only the actions that don't depend on the data model being updated are
+// taken (ie. the follow-up queries that a "topology response" triggers).
+//
+uint8_t process1905UnchangedCmdu(const struct CMDU_view *view, struct interface *receiving_interface);
+
 // Call this function when receiving an LLPD "bridge discovery" message so that
 // the topology database is properly updated.
 //
@@ -57,6 +57,7 @@
 
 #include "platform.h"
 #include "utils.h"
+#include "pool.h"
 
 #include <stdarg.h>   // va_list
 #include <stdio.h>    // vsnprintf
@@ -100,28 +101,19 @@
 // LLDP TLVS, etc... These will be manually "filled" and "freed" in the specific
 // "send*()" function that makes use of them.
 
-// Given a pointer to a preallocated "deviceInformationTypeTLV" structure, fill
-// it with all the pertaining information retrieved from the local device.
+// Return a "deviceInformationTypeTLV" structure filled with all the pertaining
+// information retrieved from the local device.
 //
-void _obtainLocalDeviceInfoTLV(struct deviceInformationTypeTLV *device_info)
+static struct deviceInformationTypeTLV *_obtainLocalDeviceInfoTLV(dlist_head *parent)
 {
-    uint8_t  al_mac_address[6];
+    struct deviceInformationTypeTLV *device_info =
+            X1905_TLV_ALLOC(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, parent);
 
     char   **interfaces_names;
     uint8_t    interfaces_names_nr;
     uint8_t    i;
 
-    memcpy(al_mac_address, DMalMacGet(), 6);
-
-    device_info->tlv.type            = TLV_TYPE_DEVICE_INFORMATION_TYPE;
-    device_info->al_mac_address[0]   = al_mac_address[0];
-    device_info->al_mac_address[1]   = al_mac_address[1];
-    device_info->al_mac_address[2]   = al_mac_address[2];
-    device_info->al_mac_address[3]   = al_mac_address[3];
-    device_info->al_mac_address[4]   = al_mac_address[4];
-    device_info->al_mac_address[5]   = al_mac_address[5];
-    device_info->local_interfaces_nr = 0;
-    device_info->local_interfaces    = NULL;
+    memcpy(device_info->al_mac_address, DMalMacGet(), 6);
 
     interfaces_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&interfaces_names_nr);
 
@@ -129,7 +121,8 @@ void _obtainLocalDeviceInfoTLV(struct deviceInformationTypeTLV *device_info)
     //
     for (i=0; i<interfaces_names_nr; i++)
     {
-        struct interfaceInfo *x;
+        struct interfaceInfo          *x;
+        struct _localInterfaceEntries *local_interface;
 
         if (NULL == (x = PLATFORM_GET_1905_INTERFACE_INFO(interfaces_names[i])))
         {
@@ -149,156 +142,63 @@ void _obtainLocalDeviceInfoTLV(struct deviceInformationTypeTLV *device_info)
             continue;
         }
 
-        if (0 == device_info->local_interfaces_nr)
-        {
-            device_info->local_interfaces = (struct _localInterfaceEntries *)memalloc(sizeof(struct _localInterfaceEntries));
-        }
-        else
-        {
-            device_info->local_interfaces = (struct _localInterfaceEntries *)memrealloc(device_info->local_interfaces, sizeof(struct _localInterfaceEntries) *(device_info->local_interfaces_nr + 1));
-        }
-
-        device_info->local_interfaces[device_info->local_interfaces_nr].mac_address[0] = x->mac_address[0];
-        device_info->local_interfaces[device_info->local_interfaces_nr].mac_address[1] = x->mac_address[1];
-        device_info->local_interfaces[device_info->local_interfaces_nr].mac_address[2] = x->mac_address[2];
-        device_info->local_interfaces[device_info->local_interfaces_nr].mac_address[3] = x->mac_address[3];
-        device_info->local_interfaces[device_info->local_interfaces_nr].mac_address[4] = x->mac_address[4];
-        device_info->local_interfaces[device_info->local_interfaces_nr].mac_address[5] = x->mac_address[5];
-        device_info->local_interfaces[device_info->local_interfaces_nr].media_type     = x->interface_type;
-        switch (x->interface_type)
+        local_interface = deviceInformationTypeTLVAddInterface(device_info, x->mac_address, x->interface_type);
+        switch (local_interface->media_specific_data_size)
         {
-            case INTERFACE_TYPE_IEEE_802_11B_2_4_GHZ:
-            case INTERFACE_TYPE_IEEE_802_11G_2_4_GHZ:
-            case INTERFACE_TYPE_IEEE_802_11A_5_GHZ:
-            case INTERFACE_TYPE_IEEE_802_11N_2_4_GHZ:
-            case INTERFACE_TYPE_IEEE_802_11N_5_GHZ:
-            case INTERFACE_TYPE_IEEE_802_11AC_5_GHZ:
-            case INTERFACE_TYPE_IEEE_802_11AD_60_GHZ:
-            case INTERFACE_TYPE_IEEE_802_11AF_GHZ:
+            case 10: // IEEE 802.11
             {
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data_size                                          = 10;
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.network_membership[0]               = x->interface_type_data.ieee80211.bssid[0];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.network_membership[1]               = x->interface_type_data.ieee80211.bssid[1];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.network_membership[2]               = x->interface_type_data.ieee80211.bssid[2];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.network_membership[3]               = x->interface_type_data.ieee80211.bssid[3];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.network_membership[4]               = x->interface_type_data.ieee80211.bssid[4];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.network_membership[5]               = x->interface_type_data.ieee80211.bssid[5];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.role                                = x->interface_type_data.ieee80211.role;
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.ap_channel_band                     = x->interface_type_data.ieee80211.ap_channel_band;
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.ap_channel_center_frequency_index_1 = x->interface_type_data.ieee80211.ap_channel_center_frequency_index_1;
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee80211.ap_channel_center_frequency_index_2 = x->interface_type_data.ieee80211.ap_channel_center_frequency_index_2;
+                memcpy(local_interface->media_specific_data.ieee80211.network_membership, x->interface_type_data.ieee80211.bssid, 6);
+                local_interface->media_specific_data.ieee80211.role                                = x->interface_type_data.ieee80211.role;
+                local_interface->media_specific_data.ieee80211.ap_channel_band                     = x->interface_type_data.ieee80211.ap_channel_band;
+                local_interface->media_specific_data.ieee80211.ap_channel_center_frequency_index_1 = x->interface_type_data.ieee80211.ap_channel_center_frequency_index_1;
+                local_interface->media_specific_data.ieee80211.ap_channel_center_frequency_index_2 = x->interface_type_data.ieee80211.ap_channel_center_frequency_index_2;
                 break;
             }
-            case INTERFACE_TYPE_IEEE_1901_FFT:
+            case 7: // IEEE 1901
             {
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data_size                           = 7;
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee1901.network_identifier[0] = x->interface_type_data.ieee1901.network_identifier[0];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee1901.network_identifier[1] = x->interface_type_data.ieee1901.network_identifier[1];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee1901.network_identifier[2] = x->interface_type_data.ieee1901.network_identifier[2];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee1901.network_identifier[3] = x->interface_type_data.ieee1901.network_identifier[3];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee1901.network_identifier[4] = x->interface_type_data.ieee1901.network_identifier[4];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee1901.network_identifier[5] = x->interface_type_data.ieee1901.network_identifier[5];
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.ieee1901.network_identifier[6] = x->interface_type_data.ieee1901.network_identifier[6];
+                memcpy(local_interface->media_specific_data.ieee1901.network_identifier, x->interface_type_data.ieee1901.network_identifier, 7);
                 break;
             }
             default:
             {
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data_size  = 0;
-                device_info->local_interfaces[device_info->local_interfaces_nr].media_specific_data.dummy = 0;
                 break;
             }
         }
-        device_info->local_interfaces_nr++;
 
         free_1905_INTERFACE_INFO(x);
     }
 
     free_LIST_OF_1905_INTERFACES(interfaces_names, interfaces_names_nr);
-}
 
-// Free the contents of the provided "deviceInformationTypeTLV" structure (ie.
-// only what was allocated by "_obtainLocalDeviceInfoTLV()", and not the
-// "deviceInformationTypeTLV" structure itself, which is the caller's
-// responsability)
-//
-void _freeLocalDeviceInfoTLV(struct deviceInformationTypeTLV *device_info)
-{
-    free(device_info->local_interfaces);
+    return device_info;
 }
 
-// Given a pointer to a preallocated "deviceBridgingCapabilityTLV" structure,
-// fill it with all the pertaining information retrieved from the local device.
+// Return a "deviceBridgingCapabilityTLV" structure filled with all the
+// pertaining information retrieved from the local device.
 //
-void _obtainLocalBridgingCapabilitiesTLV(struct deviceBridgingCapabilityTLV *bridge_info)
+static struct deviceBridgingCapabilityTLV *_obtainLocalBridgingCapabilitiesTLV(dlist_head *parent)
 {
+    struct deviceBridgingCapabilityTLV *bridge_info =
+            X1905_TLV_ALLOC(deviceBridgingCapability, TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES, parent);
     struct bridge *br;
     uint8_t          br_nr;
     uint8_t          i, j;
 
-    bridge_info->tlv.type = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES;
-
-    if ((NULL == (br = PLATFORM_GET_LIST_OF_BRIDGES(&br_nr))) || 0 == br_nr)
-    {
-        // No bridge info
-        //
-        bridge_info->bridging_tuples_nr = 0;
-        bridge_info->bridging_tuples    = NULL;
-    }
-    else
+    if ((NULL != (br = PLATFORM_GET_LIST_OF_BRIDGES(&br_nr))) && 0 != br_nr)
     {
-        bridge_info->bridging_tuples_nr = br_nr;
-        bridge_info->bridging_tuples    = (struct _bridgingTupleEntries *)memalloc(sizeof(struct _bridgingTupleEntries) * br_nr);
-
         for (i=0; i<br_nr; i++)
         {
-            bridge_info->bridging_tuples[i].bridging_tuple_macs_nr = br[i].bridged_interfaces_nr;
+            struct _bridgingTupleEntries *tuple = deviceBridgingCapabilityTLVAddTuple(bridge_info);
 
-            if (0 == br[i].bridged_interfaces_nr)
+            for (j=0; j<br[i].bridged_interfaces_nr; j++)
             {
-                bridge_info->bridging_tuples[i].bridging_tuple_macs = NULL;
-            }
-            else
-            {
-                bridge_info->bridging_tuples[i].bridging_tuple_macs = (struct _bridgingTupleMacEntries *)memalloc(sizeof(struct _bridgingTupleMacEntries) * br[i].bridged_interfaces_nr);
-
-                for (j=0; j<bridge_info->bridging_tuples[i].bridging_tuple_macs_nr; j++)
-                {
-                    uint8_t mac_address[6];
-
-                    memcpy(mac_address, DMinterfaceNameToMac(br[i].bridged_interfaces[j]), 6);
-                    bridge_info->bridging_tuples[i].bridging_tuple_macs[j].mac_address[0] = mac_address[0];
-                    bridge_info->bridging_tuples[i].bridging_tuple_macs[j].mac_address[1] = mac_address[1];
-                    bridge_info->bridging_tuples[i].bridging_tuple_macs[j].mac_address[2] = mac_address[2];
-                    bridge_info->bridging_tuples[i].bridging_tuple_macs[j].mac_address[3] = mac_address[3];
-                    bridge_info->bridging_tuples[i].bridging_tuple_macs[j].mac_address[4] = mac_address[4];
-                    bridge_info->bridging_tuples[i].bridging_tuple_macs[j].mac_address[5] = mac_address[5];
-                }
+                deviceBridgingCapabilityTupleAddMac(tuple, DMinterfaceNameToMac(br[i].bridged_interfaces[j]));
             }
         }
         free_LIST_OF_BRIDGES(br, br_nr);
     }
-}
-
-// Free the contents of the provided "deviceBridgingCapabilityTLV" structure
-// (ie.  only what was allocated by "_obtainLocalBridgingCapabilitiesTLV()",
-// and not the "deviceBridgingCapabilityTLV" structure itself, which is the
-// caller's responsability)
-//
-void _freeLocalBridgingCapabilitiesTLV(struct deviceBridgingCapabilityTLV *bridge_info)
-{
-    uint8_t i;
 
-    if (bridge_info->bridging_tuples_nr > 0)
-    {
-        for (i=0; i<bridge_info->bridging_tuples_nr; i++)
-        {
-            if ( bridge_info->bridging_tuples[i].bridging_tuple_macs_nr > 0)
-            {
-                free(bridge_info->bridging_tuples[i].bridging_tuple_macs);
-            }
-        }
-        free(bridge_info->bridging_tuples);
-    }
+    return bridge_info;
 }
 
 // Modify the provided pointers so that they now point to a list of pointers to
@@ -322,11 +222,11 @@ void _freeLocalBridgingCapabilitiesTLV(struct deviceBridgingCapabilityTLV *bridg
 //   // ...
 //   // b[b_nr-1] --> ptr to the last "neighborDeviceListTLV" structure
 //
-void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_neighbors, uint8_t *non_1905_neighbors_nr, struct neighborDeviceListTLV ***neighbors, uint8_t *neighbors_nr)
+static void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_neighbors, uint8_t *non_1905_neighbors_nr, struct neighborDeviceListTLV ***neighbors, uint8_t *neighbors_nr)
 {
     char                  **interfaces_names;
     uint8_t                   interfaces_names_nr;
-    uint8_t                   i, j, k;
+    uint8_t                   i, j;
 
     *non_1905_neighbors    = NULL;
     *neighbors             = NULL;
@@ -354,28 +254,11 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
 
         al_mac_addresses = DMgetListOfInterfaceNeighbors(interfaces_names[i], &al_mac_addresses_nr);
 
-        no  = (struct non1905NeighborDeviceListTLV *)memalloc(sizeof(struct non1905NeighborDeviceListTLV));
-        yes = (struct neighborDeviceListTLV *)       memalloc(sizeof(struct neighborDeviceListTLV));
-
-        no->tlv.type              = TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST;
-        no->local_mac_address[0]  = x->mac_address[0];
-        no->local_mac_address[1]  = x->mac_address[1];
-        no->local_mac_address[2]  = x->mac_address[2];
-        no->local_mac_address[3]  = x->mac_address[3];
-        no->local_mac_address[4]  = x->mac_address[4];
-        no->local_mac_address[5]  = x->mac_address[5];
-        no->non_1905_neighbors_nr = 0;
-        no->non_1905_neighbors    = NULL;
-
-        yes->tlv.type              = TLV_TYPE_NEIGHBOR_DEVICE_LIST;
-        yes->local_mac_address[0]  = x->mac_address[0];
-        yes->local_mac_address[1]  = x->mac_address[1];
-        yes->local_mac_address[2]  = x->mac_address[2];
-        yes->local_mac_address[3]  = x->mac_address[3];
-        yes->local_mac_address[4]  = x->mac_address[4];
-        yes->local_mac_address[5]  = x->mac_address[5];
-        yes->neighbors_nr          = 0;
-        yes->neighbors             = NULL;
+        no  = X1905_TLV_ALLOC(non1905NeighborDeviceList, TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST, NULL);
+        yes = X1905_TLV_ALLOC(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, NULL);
+
+        memcpy(no->local_mac_address, x->mac_address, 6);
+        memcpy(yes->local_mac_address, x->mac_address, 6);
 
         // Decide if each neighbor is a 1905 or a non-1905 neighbor
         //
@@ -406,14 +289,15 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
                 {
                     // Non-1905 neighbor
 
+                    struct _non1905neighborEntries *non_1905_neighbor;
                     uint8_t already_added;
 
                     // Make sure it has not already been added
                     //
                     already_added = 0;
-                    for (k=0; k<no->non_1905_neighbors_nr; k++)
+                    dlist_for_each(non_1905_neighbor, no->tlv.s.h.children[0], s.h.l)
                     {
-                        if (0 == memcmp(x->neighbor_mac_addresses[j], no->non_1905_neighbors[k].mac_address, 6))
+                        if (0 == memcmp(x->neighbor_mac_addresses[j], non_1905_neighbor->mac_address, 6))
                         {
                             already_added = 1;
                             break;
@@ -424,29 +308,14 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
                     {
                         // This is a new neighbor
                         //
-                        if (0 == no->non_1905_neighbors_nr)
-                        {
-                            no->non_1905_neighbors = (struct _non1905neighborEntries *)memalloc(sizeof(struct _non1905neighborEntries));
-                        }
-                        else
-                        {
-                            no->non_1905_neighbors = (struct _non1905neighborEntries *)memrealloc(no->non_1905_neighbors, sizeof(struct _non1905neighborEntries)*(no->non_1905_neighbors_nr+1));
-                        }
-
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[0] = x->neighbor_mac_addresses[j][0];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[1] = x->neighbor_mac_addresses[j][1];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[2] = x->neighbor_mac_addresses[j][2];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[3] = x->neighbor_mac_addresses[j][3];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[4] = x->neighbor_mac_addresses[j][4];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[5] = x->neighbor_mac_addresses[j][5];
-
-                        no->non_1905_neighbors_nr++;
+                        non1905NeighborDeviceListTLVAddNeighbor(no, x->neighbor_mac_addresses[j]);
                     }
                 }
                 else
                 {
                     // 1905 neighbor
 
+                    struct _neighborEntries *neighbor;
                     uint8_t already_added;
 
                     // Mark this AL MAC as reported
@@ -463,9 +332,9 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
                     // Make sure it has not already been added
                     //
                     already_added = 0;
-                    for (k=0; k<yes->neighbors_nr; k++)
+                    dlist_for_each(neighbor, yes->tlv.s.h.children[0], s.h.l)
                     {
-                        if (0 == memcmp(al_mac, yes->neighbors[k].mac_address, 6))
+                        if (0 == memcmp(al_mac, neighbor->mac_address, 6))
                         {
                             already_added = 1;
                             break;
@@ -476,24 +345,7 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
                     {
                         // This is a new neighbor
                         //
-                        if (0 == yes->neighbors_nr)
-                        {
-                            yes->neighbors = (struct _neighborEntries *)memalloc(sizeof(struct _neighborEntries));
-                        }
-                        else
-                        {
-                            yes->neighbors = (struct _neighborEntries *)memrealloc(yes->neighbors, sizeof(struct _neighborEntries)*(yes->neighbors_nr+1));
-                        }
-
-                        yes->neighbors[yes->neighbors_nr].mac_address[0] = al_mac[0];
-                        yes->neighbors[yes->neighbors_nr].mac_address[1] = al_mac[1];
-                        yes->neighbors[yes->neighbors_nr].mac_address[2] = al_mac[2];
-                        yes->neighbors[yes->neighbors_nr].mac_address[3] = al_mac[3];
-                        yes->neighbors[yes->neighbors_nr].mac_address[4] = al_mac[4];
-                        yes->neighbors[yes->neighbors_nr].mac_address[5] = al_mac[5];
-                        yes->neighbors[yes->neighbors_nr].bridge_flag    = DMisNeighborBridged(interfaces_names[i], al_mac);
-
-                        yes->neighbors_nr++;
+                        neighborDeviceListTLVAddNeighbor(yes, al_mac, DMisNeighborBridged(interfaces_names[i], al_mac));
                     }
 
                     free(al_mac);
@@ -528,14 +380,15 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
 
             for (j=0; j<al_mac_addresses_nr; j++)
             {
+                struct _neighborEntries *neighbor;
                 uint8_t already_added;
 
                 // Make sure it has not already been added
                 //
                 already_added = 0;
-                for (k=0; k<yes->neighbors_nr; k++)
+                dlist_for_each(neighbor, yes->tlv.s.h.children[0], s.h.l)
                 {
-                    if (0 == memcmp(al_mac_addresses[j], yes->neighbors[k].mac_address, 6))
+                    if (0 == memcmp(al_mac_addresses[j], neighbor->mac_address, 6))
                     {
                         already_added = 1;
                         break;
@@ -546,25 +399,8 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
                 {
                     // This is a new neighbor
                     //
-                    if (0 == yes->neighbors_nr)
-                    {
-                        yes->neighbors = (struct _neighborEntries *)memalloc(sizeof(struct _neighborEntries));
-                    }
-                    else
-                    {
-                        yes->neighbors = (struct _neighborEntries *)memrealloc(yes->neighbors, sizeof(struct _neighborEntries)*(yes->neighbors_nr+1));
-                    }
-
-                    yes->neighbors[yes->neighbors_nr].mac_address[0] = al_mac_addresses[j][0];
-                    yes->neighbors[yes->neighbors_nr].mac_address[1] = al_mac_addresses[j][1];
-                    yes->neighbors[yes->neighbors_nr].mac_address[2] = al_mac_addresses[j][2];
-                    yes->neighbors[yes->neighbors_nr].mac_address[3] = al_mac_addresses[j][3];
-                    yes->neighbors[yes->neighbors_nr].mac_address[4] = al_mac_addresses[j][4];
-                    yes->neighbors[yes->neighbors_nr].mac_address[5] = al_mac_addresses[j][5];
-                    yes->neighbors[yes->neighbors_nr].bridge_flag    = DMisNeighborBridged(interfaces_names[i], al_mac_addresses[j]);
-
-                    yes->neighbors_nr++;
-
+                    neighborDeviceListTLVAddNeighbor(yes, al_mac_addresses[j],
+                                                     DMisNeighborBridged(interfaces_names[i], al_mac_addresses[j]));
                 }
             }
         }
@@ -575,7 +411,7 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
         // We just need to add "no" and "yes" to the "non_1905_neighbors"
         // and "neighbors" lists and proceed to the next interface.
         //
-        if (no->non_1905_neighbors_nr > 0)
+        if (!dlist_empty(&no->tlv.s.h.children[0]))
         {
             // Add this to the list of non-1905 neighbor TLVs
             //
@@ -593,10 +429,10 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
         }
         else
         {
-            free(no);
+            free_1905_TLV_structure(&no->tlv);
         }
 
-        if (yes->neighbors_nr > 0)
+        if (!dlist_empty(&yes->tlv.s.h.children[0]))
         {
             // Add this to the list of non-1905 neighbor TLVs
             //
@@ -614,7 +450,7 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
         }
         else
         {
-            free(yes);
+            free_1905_TLV_structure(&yes->tlv);
         }
     }
 
@@ -627,7 +463,7 @@ void _obtainLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_ne
 // This function is called with the same arguments as
 // "_obtainLocalNeighborsTLV()"
 //
-void _freeLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_neighbors, uint8_t *non_1905_neighbors_nr, struct neighborDeviceListTLV ***neighbors, uint8_t *neighbors_nr)
+static void _freeLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_neighbors, uint8_t *non_1905_neighbors_nr, struct neighborDeviceListTLV ***neighbors, uint8_t *neighbors_nr)
 {
     uint8_t i;
 
@@ -635,11 +471,7 @@ void _freeLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_neig
     {
         for (i=0; i<*non_1905_neighbors_nr; i++)
         {
-            if ((*non_1905_neighbors)[i]->non_1905_neighbors_nr > 0)
-            {
-                free((*non_1905_neighbors)[i]->non_1905_neighbors);
-            }
-            free((*non_1905_neighbors)[i]);
+            free_1905_TLV_structure(&(*non_1905_neighbors)[i]->tlv);
         }
         free(*non_1905_neighbors);
     }
@@ -647,29 +479,24 @@ void _freeLocalNeighborsTLV(struct non1905NeighborDeviceListTLV ***non_1905_neig
     {
         for (i=0; i<*neighbors_nr; i++)
         {
-            if ((*neighbors)[i]->neighbors_nr > 0)
-            {
-                free((*neighbors)[i]->neighbors);
-            }
-            free((*neighbors)[i]);
+            free_1905_TLV_structure(&(*neighbors)[i]->tlv);
         }
         free(*neighbors);
     }
 }
 
-// Given a pointer to a preallocated "powerOffInterfaceTLV" structure, fill
-// it with all the pertaining information retrieved from the local device.
+// Return a "powerOffInterfaceTLV" structure filled with all the pertaining
+// information retrieved from the local device.
 //
-void _obtainLocalPowerOffInterfacesTLV(struct powerOffInterfaceTLV *power_off)
+static struct powerOffInterfaceTLV *_obtainLocalPowerOffInterfacesTLV(dlist_head *parent)
 {
+    struct powerOffInterfaceTLV *power_off =
+            X1905_TLV_ALLOC(powerOffInterface, TLV_TYPE_POWER_OFF_INTERFACE, parent);
+
     char                  **interfaces_names;
     uint8_t                   interfaces_names_nr;
     uint8_t                   i;
 
-    power_off->tlv.type                = TLV_TYPE_POWER_OFF_INTERFACE;
-    power_off->power_off_interfaces_nr = 0;
-    power_off->power_off_interfaces    = NULL;
-
     interfaces_names = PLATFORM_GET_LIST_OF_1905_INTERFACES(&interfaces_names_nr);
 
     // Search for interfaces in "POWER OFF" mode
@@ -677,6 +504,7 @@ void _obtainLocalPowerOffInterfacesTLV(struct powerOffInterfaceTLV *power_off)
     for (i=0; i<interfaces_names_nr; i++)
     {
         struct interfaceInfo *x;
+        uint16_t              media_type = MEDIA_TYPE_UNKNOWN;
 
         if (NULL == (x = PLATFORM_GET_1905_INTERFACE_INFO(interfaces_names[i])))
         {
@@ -694,90 +522,78 @@ void _obtainLocalPowerOffInterfacesTLV(struct powerOffInterfaceTLV *power_off)
             continue;
         }
 
-        if (0 == power_off->power_off_interfaces_nr)
-        {
-            power_off->power_off_interfaces = (struct _powerOffInterfaceEntries *)memalloc(sizeof(struct _powerOffInterfaceEntries));
-        }
-        else
-        {
-            power_off->power_off_interfaces = (struct _powerOffInterfaceEntries *)memrealloc(power_off->power_off_interfaces, sizeof(struct _powerOffInterfaceEntries) * (power_off->power_off_interfaces_nr + 1));
-        }
-
-        memcpy(power_off->power_off_interfaces[power_off->power_off_interfaces_nr].interface_address,   x->mac_address, 6);
-
-
         // "Translate" from "INTERFACE_TYPE_*" to "MEDIA_TYPE_*"
         //
         switch(x->interface_type)
         {
             case INTERFACE_TYPE_IEEE_802_3U_FAST_ETHERNET:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_3U_FAST_ETHERNET;
+                media_type = MEDIA_TYPE_IEEE_802_3U_FAST_ETHERNET;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_3AB_GIGABIT_ETHERNET:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_3AB_GIGABIT_ETHERNET;
+                media_type = MEDIA_TYPE_IEEE_802_3AB_GIGABIT_ETHERNET;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11B_2_4_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11B_2_4_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11B_2_4_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11G_2_4_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11G_2_4_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11G_2_4_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11A_5_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11A_5_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11A_5_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11N_2_4_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11N_2_4_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11N_2_4_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11N_5_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11N_5_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11N_5_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11AC_5_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11AC_5_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11AC_5_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11AD_60_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11AD_60_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11AD_60_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_802_11AF_GHZ:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_802_11AF_GHZ;
+                media_type = MEDIA_TYPE_IEEE_802_11AF_GHZ;
                 break;
             }
             case INTERFACE_TYPE_IEEE_1901_WAVELET:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_1901_WAVELET;
+                media_type = MEDIA_TYPE_IEEE_1901_WAVELET;
                 break;
             }
             case INTERFACE_TYPE_IEEE_1901_FFT:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_IEEE_1901_FFT;
+                media_type = MEDIA_TYPE_IEEE_1901_FFT;
                 break;
             }
             case INTERFACE_TYPE_MOCA_V1_1:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_MOCA_V1_1;
+                media_type = MEDIA_TYPE_MOCA_V1_1;
                 break;
             }
             case INTERFACE_TYPE_UNKNOWN:
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type = MEDIA_TYPE_UNKNOWN;
+                media_type = MEDIA_TYPE_UNKNOWN;
                 break;
             }
         }
@@ -785,76 +601,45 @@ void _obtainLocalPowerOffInterfacesTLV(struct powerOffInterfaceTLV *power_off)
         // Only when the media type is "MEDIA_TYPE_UNKNOWN", fill the
         // rest of fields
         //
-        if (MEDIA_TYPE_UNKNOWN != power_off->power_off_interfaces[power_off->power_off_interfaces_nr].media_type)
+        if (MEDIA_TYPE_UNKNOWN != media_type)
         {
-            // Set everything to "zero"
-            //
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.oui[0]                  = 0x00;
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.oui[1]                  = 0x00;
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.oui[2]                  = 0x00;
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.variant_index           = 0;
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.media_specific_bytes_nr = 0;
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.media_specific_bytes    = NULL;
+            static const uint8_t no_oui[3] = {0x00, 0x00, 0x00};
+
+            powerOffInterfaceTLVAddInterface(power_off, x->mac_address, media_type, no_oui, 0, 0, NULL);
         }
         else
         {
             uint16_t  len;
             uint8_t  *m;
 
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.oui[0]                  = x->interface_type_data.other.oui[0];
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.oui[1]                  = x->interface_type_data.other.oui[1];
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.oui[2]                  = x->interface_type_data.other.oui[2];
-            power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.variant_index           = x->interface_type_data.other.variant_index;
-
             m = forge_media_specific_blob(&x->interface_type_data.other, &len);
 
-            if (NULL != m)
+            if (NULL != m && len <= UINT8_MAX)
             {
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.media_specific_bytes_nr = len;
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.media_specific_bytes    = m;
+                powerOffInterfaceTLVAddInterface(power_off, x->mac_address, media_type,
+                                                 x->interface_type_data.other.oui,
+                                                 x->interface_type_data.other.variant_index, (uint8_t)len, m);
             }
             else
             {
                 // Ignore media specific data
                 //
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.media_specific_bytes_nr = 0;
-                power_off->power_off_interfaces[power_off->power_off_interfaces_nr].generic_phy_common_data.media_specific_bytes    = NULL;
+                powerOffInterfaceTLVAddInterface(power_off, x->mac_address, media_type,
+                                                 x->interface_type_data.other.oui,
+                                                 x->interface_type_data.other.variant_index, 0, NULL);
+            }
+            if (NULL != m)
+            {
+                free_media_specific_blob(m);
             }
         }
-        power_off->power_off_interfaces_nr++;
 
         free_1905_INTERFACE_INFO(x);
     }
 
     free_LIST_OF_1905_INTERFACES(interfaces_names, interfaces_names_nr);
-}
-
-// Free the contents of the provided "powerOffInterfaceTLV" structure (ie.
-// only what was allocated by "_obtainLocalPowerOffInterfacesTLV()", and not
-// the "powerOffInterfaceTLV" structure itself, which is the caller's
-// responsability)
-//
-void _freeLocalPowerOffInterfacesTLV(struct powerOffInterfaceTLV *power_off)
-{
-    uint8_t i;
 
-    if (power_off->power_off_interfaces_nr > 0)
-    {
-        for (i=0; i<power_off->power_off_interfaces_nr; i++)
-        {
-            if (MEDIA_TYPE_UNKNOWN != power_off->power_off_interfaces[i].media_type)
-            {
-                if (
-                     0    != power_off->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes_nr  &&
-                     NULL != power_off->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes
-                   )
-                {
-                    free_media_specific_blob(power_off->power_off_interfaces[i].generic_phy_common_data.media_specific_bytes);
-                }
-            }
-        }
-        free(power_off->power_off_interfaces);
-    }
+    return power_off;
 }
 
 // Given a pointer to a preallocated "l2NeighborDeviceTLV" structure, fill it
@@ -1737,56 +1522,37 @@ void _freeLocalGenericPhyTLV(struct genericPhyDeviceInformationTypeTLV *generic_
     }
 }
 
-// Given a pointer to a preallocated "x1905ProfileVersionTLV" structure, fill
-// it with all the pertaining information retrieved from the local device.
+// Allocate a "x1905ProfileVersionTLV" structure and fill it with all the
+// pertaining information retrieved from the local device.
 //
-void _obtainLocalProfileTLV(struct x1905ProfileVersionTLV *profile)
+static struct x1905ProfileVersionTLV *_obtainLocalProfileTLV(dlist_head *parent)
 {
-    profile->tlv.type = TLV_TYPE_1905_PROFILE_VERSION;
-    profile->profile  = PROFILE_1905_1A;
+    struct x1905ProfileVersionTLV *profile =
+            X1905_TLV_ALLOC(x1905ProfileVersion, TLV_TYPE_1905_PROFILE_VERSION, parent);
+    profile->profile = PROFILE_1905_1A;
+    return profile;
 }
 
-// Free the contents of the provided "x1905ProfileVersionTLV" structure (ie.
-// only what was allocated by "_obtainLocalProfileTLV()", and not the
-// "x1905ProfileVersionTLV" structure itself, which is the caller's
-// responsability)
+// Allocate a "deviceIdentificationTypeTLV" structure and fill it with all the
+// pertaining information retrieved from the local device.
 //
-void _freeLocalProfileTLV(__attribute__((unused)) struct x1905ProfileVersionTLV *profile)
-{
-    // Nothing needs to be freed
-}
-
-// Given a pointer to a preallocated "deviceIdentificationTypeTLV" structure,
-// fill it with all the pertaining information retrieved from the local device.
-//
-void _obtainLocalDeviceIdentificationTLV(struct deviceIdentificationTypeTLV *identification)
+static struct deviceIdentificationTypeTLV *_obtainLocalDeviceIdentificationTLV(dlist_head *parent)
 {
+    struct deviceIdentificationTypeTLV *identification =
+            X1905_TLV_ALLOC(deviceIdentificationType, TLV_TYPE_DEVICE_IDENTIFICATION, parent);
     struct deviceInfo    *x;
 
     x = PLATFORM_GET_DEVICE_INFO();
     if (NULL == x)
     {
         PLATFORM_PRINTF_DEBUG_ERROR("Could not retrieve device info\n");
-        return;
+        return identification;
     }
 
-    memset(identification, 0x0, sizeof(struct deviceIdentificationTypeTLV));
-
-    identification->tlv.type = TLV_TYPE_DEVICE_IDENTIFICATION;
-
     memcpy(identification->friendly_name,      x->friendly_name,      strlen(x->friendly_name)+1);
     memcpy(identification->manufacturer_name,  x->manufacturer_name,  strlen(x->manufacturer_name)+1);
     memcpy(identification->manufacturer_model, x->manufacturer_model, strlen(x->manufacturer_model)+1);
-}
-
-// Free the contents of the provided "deviceIdentificationTypeTLV" structure
-// (ie.  only what was allocated by "_obtainLocalDeviceIdentificationTLV()",
-// and not the "deviceIdentificationTypeTLV" structure itself, which is the
-// caller's responsability)
-//
-void _freeLocalDeviceIdentificationTLV(__attribute__((unused)) struct deviceIdentificationTypeTLV *identification)
-{
-    // Nothing needs to be freed
+    return identification;
 }
 
 // Given a pointer to a preallocated "controlUrlTypeTLV" structure, fill
@@ -2106,29 +1872,24 @@ void _updateLocalDeviceData()
     // declaring variables in the stack) because they are going to be "saved"
     // in the database when calling "DMupdate*()"
     //
-    info            = (struct deviceInformationTypeTLV*)          memalloc(sizeof(struct deviceInformationTypeTLV));
     bridges         = (struct deviceBridgingCapabilityTLV**)      memalloc(sizeof(struct deviceBridgingCapabilityTLV*));
-    bridges[0]      = (struct deviceBridgingCapabilityTLV*)       memalloc(sizeof(struct deviceBridgingCapabilityTLV));
     power_off       = (struct powerOffInterfaceTLV**)             memalloc(sizeof(struct powerOffInterfaceTLV*));
-    power_off[0]    = (struct powerOffInterfaceTLV*)              memalloc(sizeof(struct powerOffInterfaceTLV));
     l2_neighbors    = (struct l2NeighborDeviceTLV**)              memalloc(sizeof(struct l2NeighborDeviceTLV*));
     l2_neighbors[0] = (struct l2NeighborDeviceTLV*)               memalloc(sizeof(struct l2NeighborDeviceTLV));
     generic_phy     = (struct genericPhyDeviceInformationTypeTLV*)memalloc(sizeof(struct genericPhyDeviceInformationTypeTLV));
-    profile         = (struct x1905ProfileVersionTLV*)            memalloc(sizeof(struct x1905ProfileVersionTLV));
-    identification  = (struct deviceIdentificationTypeTLV*)       memalloc(sizeof(struct deviceIdentificationTypeTLV));
     control_url     = (struct controlUrlTypeTLV*)                 memalloc(sizeof(struct controlUrlTypeTLV));
     ipv4            = (struct ipv4TypeTLV*)                       memalloc(sizeof(struct ipv4TypeTLV));
     ipv6            = (struct ipv6TypeTLV*)                       memalloc(sizeof(struct ipv6TypeTLV));
 
-    _obtainLocalDeviceInfoTLV           (info);
-    _obtainLocalBridgingCapabilitiesTLV (bridges[0]);
+    info         = _obtainLocalDeviceInfoTLV           (NULL);
+    bridges[0]   = _obtainLocalBridgingCapabilitiesTLV (NULL);
     _obtainLocalNeighborsTLV            (&non1905_neighbors, &non1905_neighbors_nr, &x1905_neighbors, &x1905_neighbors_nr);
-    _obtainLocalPowerOffInterfacesTLV   (power_off[0]);
+    power_off[0] = _obtainLocalPowerOffInterfacesTLV   (NULL);
     _obtainLocalL2NeighborsTLV          (l2_neighbors[0]);
     supported_service_tlv = _obtainLocalSupportedServicesTLV    (NULL);
     _obtainLocalGenericPhyTLV           (generic_phy);
-    _obtainLocalProfileTLV              (profile);
-    _obtainLocalDeviceIdentificationTLV (identification);
+    profile        = _obtainLocalProfileTLV              (NULL);
+    identification = _obtainLocalDeviceIdentificationTLV (NULL);
     _obtainLocalControlUrlTLV           (control_url);
     _obtainLocalIpsTLVs                 (ipv4, ipv6);
 
@@ -2197,33 +1958,13 @@ void _updateLocalDeviceData()
 // Public functions (exported only to files in this same folder)
 ////////////////////////////////////////////////////////////////////////////////
 
-uint8_t send1905RawPacket(const char *interface_name, uint16_t mid, const uint8_t *dst_mac_address, struct CMDU *cmdu)
+uint8_t send1905RawStreamsBatch(const char * const *interface_names, unsigned interface_names_nr,
+                                const uint8_t *dst_mac_address, uint8_t **streams, const uint16_t *streams_lens)
 {
-    uint8_t  **streams;
-    uint16_t  *streams_lens;
-
-    uint8_t total_streams, x;
-
-    // Insert protocol extensions to the CMDU, which has been already built at
-    // this point.
-    //
-    send1905CmduExtensions(cmdu);
-
-    PLATFORM_PRINTF_DEBUG_DETAIL("Contents of CMDU to send:\n");
-    visit_1905_CMDU_structure(cmdu, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
-
-    streams = forge_1905_CMDU_from_structure(cmdu, &streams_lens);
-    if (NULL == streams)
-    {
-        // Could not forge the packet. Error?
-        //
-        PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() failed!\n");
-        return 0;
-    }
+    struct rawPacket *packets;
+    unsigned          packets_nr;
 
-    // Free previously allocated CMDU extensions (no longer needed)
-    //
-    free1905CmduExtensions(cmdu);
+    unsigned total_streams, i, x;
 
     total_streams = 0;
     while(streams[total_streams])
@@ -2233,60 +1974,77 @@ uint8_t send1905RawPacket(const char *interface_name, uint16_t mid, const uint8_
 
     if (0 == total_streams)
     {
-        // Could not forge the packet. Error?
-        //
-        PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() returned 0 streams!\n");
-
-        free_1905_CMDU_packets(streams);
-        free(streams_lens);
+        PLATFORM_PRINTF_DEBUG_WARNING("No streams to send!\n");
         return 0;
     }
 
-    x = 0;
-    while(streams[x])
+    // Build a single batch with all fragments on all interfaces. Fragments of
+    // the same interface are kept together (and in order) so that the
+    // platform can send them with a single system call.
+    //
+    packets_nr = 0;
+    if (interface_names_nr > 0)
     {
-        PLATFORM_PRINTF_DEBUG_DETAIL("Sending 1905 message on interface %s, MID %d, fragment %d/%d\n", interface_name, mid, x+1, total_streams);
-        if (0 == PLATFORM_SEND_RAW_PACKET(interface_name,
-                                          dst_mac_address,
-                                          DMalMacGet(),
-                                          ETHERTYPE_1905,
-                                          streams[x],
-                                          streams_lens[x]))
+        packets = (struct rawPacket *)memalloc(interface_names_nr * total_streams * sizeof(struct rawPacket));
+
+        for (i = 0; i < interface_names_nr; i++)
+        {
+            for (x = 0; x < total_streams; x++)
+            {
+                PLATFORM_PRINTF_DEBUG_DETAIL("Sending 1905 message on interface %s, fragment %d/%d\n", interface_names[i], x+1, total_streams);
+
+                packets[packets_nr].interface_name = interface_names[i];
+                packets[packets_nr].dst_mac        = dst_mac_address;
+                packets[packets_nr].src_mac        = DMalMacGet();
+                packets[packets_nr].eth_type       = ETHERTYPE_1905;
+                packets[packets_nr].payload        = streams[x];
+                packets[packets_nr].payload_len    = streams_lens[x];
+                packets_nr++;
+            }
+        }
+
+        if (0 == PLATFORM_SEND_RAW_PACKETS(packets, packets_nr))
         {
             PLATFORM_PRINTF_DEBUG_ERROR("Packet could not be sent!\n");
         }
 
-        x++;
+        free(packets);
     }
 
-    free_1905_CMDU_packets(streams);
-    free(streams_lens);
-
     return 1;
 }
 
-uint8_t send1905Multicast(uint16_t mid, struct CMDU *cmdu)
+uint8_t send1905RawPacketBatch(const char * const *interface_names, unsigned interface_names_nr, uint16_t mid,
+                               const uint8_t *dst_mac_address, struct CMDU *cmdu)
 {
     uint8_t  **streams;
     uint16_t  *streams_lens;
-    struct interface *interface;
-
-    unsigned x;
+    struct arena *arena;
+    uint8_t    ret;
 
     // Insert protocol extensions to the CMDU, which has been already built at
     // this point.
     //
     send1905CmduExtensions(cmdu);
 
-    PLATFORM_PRINTF_DEBUG_DETAIL("Contents of CMDU to send:\n");
-    visit_1905_CMDU_structure(cmdu, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+    if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("Contents of CMDU to send (MID %d):\n", mid);
+        visit_1905_CMDU_structure(cmdu, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+    }
 
-    streams = forge_1905_CMDU_from_structure(cmdu, &streams_lens);
+    // The CMDU is forged only once, no matter on how many interfaces it is
+    // going to be sent. All fragments (and their lengths) are allocated from a
+    // single arena which is released at once when they have been sent.
+    //
+    arena   = arena_new();
+    streams = forge_1905_CMDU_from_structure_in_arena(cmdu, &streams_lens, arena);
     if (NULL == streams)
     {
         // Could not forge the packet. Error?
         //
         PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() failed!\n");
+        arena_unref(arena);
         return 0;
     }
 
@@ -2294,43 +2052,42 @@ uint8_t send1905Multicast(uint16_t mid, struct CMDU *cmdu)
     //
     free1905CmduExtensions(cmdu);
 
-    if (NULL == streams[0])
-    {
-        // Could not forge the packet. Error?
-        //
-        PLATFORM_PRINTF_DEBUG_WARNING("forge_1905_CMDU_from_structure() returned 0 streams!\n");
+    ret = send1905RawStreamsBatch(interface_names, interface_names_nr, dst_mac_address, streams, streams_lens);
 
-        free_1905_CMDU_packets(streams);
-        free(streams_lens);
-        return 0;
-    }
+    arena_unref(arena);
+
+    return ret;
+}
+
+uint8_t send1905RawPacket(const char *interface_name, uint16_t mid, const uint8_t *dst_mac_address, struct CMDU *cmdu)
+{
+    return send1905RawPacketBatch(&interface_name, 1, mid, dst_mac_address, cmdu);
+}
+
+uint8_t send1905Multicast(uint16_t mid, struct CMDU *cmdu)
+{
+    const char       **interface_names;
+    unsigned           interface_names_nr;
+    struct interface  *interface;
+    uint8_t            ret;
+
+    interface_names    = (const char **)memalloc((dlist_count(&local_device->interfaces) + 1) * sizeof(const char *));
+    interface_names_nr = 0;
 
     dlist_for_each(interface, local_device->interfaces, l)
     {
         /* @todo check if interface is secured */
         if (interface->power_state != interface_power_state_off)
         {
-            for (x = 0; streams[x] != NULL; x++)
-            {
-                PLATFORM_PRINTF_DEBUG_DETAIL("Sending 1905 message on interface %s, MID %d, fragment %d\n",
-                                             interface->name, mid, x+1);
-                if (0 == PLATFORM_SEND_RAW_PACKET(interface->name,
-                                                  MCAST_1905,
-                                                  DMalMacGet(),
-                                                  ETHERTYPE_1905,
-                                                  streams[x],
-                                                  streams_lens[x]))
-                {
-                    PLATFORM_PRINTF_DEBUG_ERROR("Packet could not be sent!\n");
-                }
-            }
+            interface_names[interface_names_nr++] = interface->name;
         }
     }
 
-    free_1905_CMDU_packets(streams);
-    free(streams_lens);
+    ret = send1905RawPacketBatch(interface_names, interface_names_nr, mid, MCAST_1905_ADDR, cmdu);
 
-    return 1;
+    free(interface_names);
+
+    return ret;
 }
 
 
@@ -2339,8 +2096,11 @@ uint8_t send1905RawALME(uint8_t alme_client_id, uint8_t *alme)
     uint8_t    *packet_out;
     uint16_t    packet_out_len;
 
-    PLATFORM_PRINTF_DEBUG_DETAIL("Contents of ALME reply to send:\n");
-    visit_1905_ALME_structure((uint8_t *)alme, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+    if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("Contents of ALME reply to send:\n");
+        visit_1905_ALME_structure((uint8_t *)alme, print_callback, PLATFORM_PRINTF_DEBUG_DETAIL, "");
+    }
 
     // Use the getIntfListResponseALME structure to forge the packet
     // bit stream
@@ -2484,11 +2244,11 @@ uint8_t send1905TopologyResponsePacket(const char *interface_name, uint16_t mid,
     uint8_t  ret;
 
     struct CMDU                            response_message;
-    struct deviceInformationTypeTLV        device_info;
-    struct deviceBridgingCapabilityTLV     bridge_info;
+    struct deviceInformationTypeTLV       *device_info;
+    struct deviceBridgingCapabilityTLV    *bridge_info;
     struct non1905NeighborDeviceListTLV  **non_1905_neighbors;
     struct neighborDeviceListTLV         **neighbors;
-    struct powerOffInterfaceTLV            power_off;
+    struct powerOffInterfaceTLV           *power_off;
     struct l2NeighborDeviceTLV             l2_neighbors;
     struct supportedServiceTLV            *supported_service_tlv;
     struct apOperationalBssTLV            *ap_operational_bss_tlv;
@@ -2504,10 +2264,10 @@ uint8_t send1905TopologyResponsePacket(const char *interface_name, uint16_t mid,
 
     // Fill all the needed TLVs
     //
-    _obtainLocalDeviceInfoTLV          (&device_info);
-    _obtainLocalBridgingCapabilitiesTLV(&bridge_info);
+    device_info = _obtainLocalDeviceInfoTLV          (NULL);
+    bridge_info = _obtainLocalBridgingCapabilitiesTLV(NULL);
     _obtainLocalNeighborsTLV           (&non_1905_neighbors, &non_1905_neighbors_nr, &neighbors, &neighbors_nr);
-    _obtainLocalPowerOffInterfacesTLV  (&power_off);
+    power_off   = _obtainLocalPowerOffInterfacesTLV  (NULL);
     _obtainLocalL2NeighborsTLV         (&l2_neighbors);
 
     // Build the CMDU
@@ -2515,7 +2275,7 @@ uint8_t send1905TopologyResponsePacket(const char *interface_name, uint16_t mid,
     total_tlvs = 1;                      // Device information type TLV
 
 #ifndef SEND_EMPTY_TLVS
-    if (bridge_info.bridging_tuples_nr != 0)
+    if (!dlist_empty(&bridge_info->tlv.s.h.children[0]))
 #endif
     {
         total_tlvs++;                    // Device bridging capability TLV
@@ -2525,7 +2285,7 @@ uint8_t send1905TopologyResponsePacket(const char *interface_name, uint16_t mid,
     total_tlvs += non_1905_neighbors_nr; // 1905 Neighbor device list TLVs
 
 #ifndef SEND_EMPTY_TLVS
-    if (power_off.power_off_interfaces_nr != 0)
+    if (!dlist_empty(&power_off->tlv.s.h.children[0]))
 #endif
     {
         total_tlvs++;                    // Power off interface TLV
@@ -2548,14 +2308,14 @@ uint8_t send1905TopologyResponsePacket(const char *interface_name, uint16_t mid,
     response_message.message_id      = mid;
     response_message.relay_indicator = 0;
     response_message.list_of_TLVs    = (struct tlv **)memalloc(sizeof(struct tlv *)*(total_tlvs+1));
-    response_message.list_of_TLVs[0] = &device_info.tlv;
+    response_message.list_of_TLVs[0] = &device_info->tlv;
 
     i = 1;
 #ifndef SEND_EMPTY_TLVS
-    if (bridge_info.bridging_tuples_nr != 0)
+    if (!dlist_empty(&bridge_info->tlv.s.h.children[0]))
 #endif
     {
-        response_message.list_of_TLVs[i++] = &bridge_info.tlv;
+        response_message.list_of_TLVs[i++] = &bridge_info->tlv;
     }
 
     for (j=0; j<non_1905_neighbors_nr; j++)
@@ -2569,10 +2329,10 @@ uint8_t send1905TopologyResponsePacket(const char *interface_name, uint16_t mid,
     }
 
 #ifndef SEND_EMPTY_TLVS
-    if (power_off.power_off_interfaces_nr != 0)
+    if (!dlist_empty(&power_off->tlv.s.h.children[0]))
 #endif
     {
-        response_message.list_of_TLVs[i++] = &power_off.tlv;
+        response_message.list_of_TLVs[i++] = &power_off->tlv;
     }
 
 #ifndef SEND_EMPTY_TLVS
@@ -2601,10 +2361,10 @@ uint8_t send1905TopologyResponsePacket(const char *interface_name, uint16_t mid,
 
     // Free all allocated (and no longer needed) memory
     //
-    _freeLocalDeviceInfoTLV          (&device_info);
-    _freeLocalBridgingCapabilitiesTLV(&bridge_info);
+    free_1905_TLV_structure          (&device_info->tlv);
+    free_1905_TLV_structure          (&bridge_info->tlv);
     _freeLocalNeighborsTLV           (&non_1905_neighbors, &non_1905_neighbors_nr, &neighbors, &neighbors_nr);
-    _freeLocalPowerOffInterfacesTLV  (&power_off);
+    free_1905_TLV_structure          (&power_off->tlv);
     _freeLocalL2NeighborsTLV         (&l2_neighbors);
     /** @todo free supported services */
     /** @todo free ap_operational_bss_tlv */
@@ -3138,7 +2898,7 @@ uint8_t send1905PushButtonJoinNotificationPacket(const char *interface_name, uin
     uint8_t  mcast_address[] = MCAST_1905;
 
     struct CMDU                             notification_message;
-    struct pushButtonJoinNotificationTLV    pb_join_tlv;
+    struct pushButtonJoinNotificationTLV   *pb_join_tlv;
 
     PLATFORM_PRINTF_DEBUG_INFO("--> CMDU_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION (%s)\n", interface_name);
 
@@ -3146,26 +2906,26 @@ uint8_t send1905PushButtonJoinNotificationPacket(const char *interface_name, uin
 
     // Fill the push button join notification TLV
     //
-    pb_join_tlv.tlv.type           = TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION;
-    pb_join_tlv.al_mac_address[0]  = original_al_mac_address[0];
-    pb_join_tlv.al_mac_address[1]  = original_al_mac_address[1];
-    pb_join_tlv.al_mac_address[2]  = original_al_mac_address[2];
-    pb_join_tlv.al_mac_address[3]  = original_al_mac_address[3];
-    pb_join_tlv.al_mac_address[4]  = original_al_mac_address[4];
-    pb_join_tlv.al_mac_address[5]  = original_al_mac_address[5];
-    pb_join_tlv.message_identifier = original_mid;
-    pb_join_tlv.mac_address[0]     = local_mac_address[0];
-    pb_join_tlv.mac_address[1]     = local_mac_address[1];
-    pb_join_tlv.mac_address[2]     = local_mac_address[2];
-    pb_join_tlv.mac_address[3]     = local_mac_address[3];
-    pb_join_tlv.mac_address[4]     = local_mac_address[4];
-    pb_join_tlv.mac_address[5]     = local_mac_address[5];
-    pb_join_tlv.new_mac_address[0] = local_mac_address[0];
-    pb_join_tlv.new_mac_address[1] = new_mac_address[1];
-    pb_join_tlv.new_mac_address[2] = new_mac_address[2];
-    pb_join_tlv.new_mac_address[3] = new_mac_address[3];
-    pb_join_tlv.new_mac_address[4] = new_mac_address[4];
-    pb_join_tlv.new_mac_address[5] = new_mac_address[5];
+    pb_join_tlv = X1905_TLV_ALLOC(pushButtonJoinNotification, TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION, NULL);
+    pb_join_tlv->al_mac_address[0]  = original_al_mac_address[0];
+    pb_join_tlv->al_mac_address[1]  = original_al_mac_address[1];
+    pb_join_tlv->al_mac_address[2]  = original_al_mac_address[2];
+    pb_join_tlv->al_mac_address[3]  = original_al_mac_address[3];
+    pb_join_tlv->al_mac_address[4]  = original_al_mac_address[4];
+    pb_join_tlv->al_mac_address[5]  = original_al_mac_address[5];
+    pb_join_tlv->message_identifier = original_mid;
+    pb_join_tlv->mac_address[0]     = local_mac_address[0];
+    pb_join_tlv->mac_address[1]     = local_mac_address[1];
+    pb_join_tlv->mac_address[2]     = local_mac_address[2];
+    pb_join_tlv->mac_address[3]     = local_mac_address[3];
+    pb_join_tlv->mac_address[4]     = local_mac_address[4];
+    pb_join_tlv->mac_address[5]     = local_mac_address[5];
+    pb_join_tlv->new_mac_address[0] = local_mac_address[0];
+    pb_join_tlv->new_mac_address[1] = new_mac_address[1];
+    pb_join_tlv->new_mac_address[2] = new_mac_address[2];
+    pb_join_tlv->new_mac_address[3] = new_mac_address[3];
+    pb_join_tlv->new_mac_address[4] = new_mac_address[4];
+    pb_join_tlv->new_mac_address[5] = new_mac_address[5];
 
     // Build the CMDU
     //
@@ -3175,7 +2935,7 @@ uint8_t send1905PushButtonJoinNotificationPacket(const char *interface_name, uin
     notification_message.relay_indicator = 1;
     notification_message.list_of_TLVs    = (struct tlv **)memalloc(sizeof(struct tlv *)*3);
     notification_message.list_of_TLVs[0] = &_obtainLocalAlMacAddressTLV(NULL)->tlv;
-    notification_message.list_of_TLVs[1] = &pb_join_tlv.tlv;
+    notification_message.list_of_TLVs[1] = &pb_join_tlv->tlv;
     notification_message.list_of_TLVs[2] = NULL;
 
     // Send the packet
@@ -3190,6 +2950,7 @@ uint8_t send1905PushButtonJoinNotificationPacket(const char *interface_name, uin
         ret = 1;
     }
 
+    free_1905_TLV_structure(&pb_join_tlv->tlv);
     free(notification_message.list_of_TLVs);
 
     return ret;
@@ -3207,8 +2968,8 @@ uint8_t send1905APAutoconfigurationSearchPacket(uint16_t mid, uint8_t freq_band)
     uint8_t  mcast_address[] = MCAST_1905;
 
     struct CMDU                   search_message;
-    struct searchedRoleTLV        searched_role_tlv;
-    struct autoconfigFreqBandTLV  ac_freq_band_tlv;
+    struct searchedRoleTLV       *searched_role_tlv;
+    struct autoconfigFreqBandTLV *ac_freq_band_tlv;
     struct supportedServiceTLV    *supported_service_tlv;
     struct supportedServiceTLV    *searched_service_tlv;
 
@@ -3216,13 +2977,13 @@ uint8_t send1905APAutoconfigurationSearchPacket(uint16_t mid, uint8_t freq_band)
 
     // Fill the searched role TLV
     //
-    searched_role_tlv.tlv.type = TLV_TYPE_SEARCHED_ROLE;
-    searched_role_tlv.role     = IEEE80211_ROLE_AP;
+    searched_role_tlv       = X1905_TLV_ALLOC(searchedRole, TLV_TYPE_SEARCHED_ROLE, NULL);
+    searched_role_tlv->role = IEEE80211_ROLE_AP;
 
     // Fill the autoconfig freq band TLV
     //
-    ac_freq_band_tlv.tlv.type  = TLV_TYPE_AUTOCONFIG_FREQ_BAND;
-    ac_freq_band_tlv.freq_band = freq_band;
+    ac_freq_band_tlv            = X1905_TLV_ALLOC(autoconfigFreqBand, TLV_TYPE_AUTOCONFIG_FREQ_BAND, NULL);
+    ac_freq_band_tlv->freq_band = freq_band;
 
     supported_service_tlv = _obtainLocalSupportedServicesTLV(NULL);
 
@@ -3238,8 +2999,8 @@ uint8_t send1905APAutoconfigurationSearchPacket(uint16_t mid, uint8_t freq_band)
     search_message.relay_indicator = 1;
     search_message.list_of_TLVs    = (struct tlv **)memalloc(sizeof(struct tlv *)*6);
     search_message.list_of_TLVs[0] = &_obtainLocalAlMacAddressTLV(NULL)->tlv;
-    search_message.list_of_TLVs[1] = &searched_role_tlv.tlv;
-    search_message.list_of_TLVs[2] = &ac_freq_band_tlv.tlv;
+    search_message.list_of_TLVs[1] = &searched_role_tlv->tlv;
+    search_message.list_of_TLVs[2] = &ac_freq_band_tlv->tlv;
     search_message.list_of_TLVs[3] = &supported_service_tlv->tlv;
     search_message.list_of_TLVs[4] = &searched_service_tlv->tlv;
     search_message.list_of_TLVs[5] = NULL;
@@ -3257,6 +3018,8 @@ uint8_t send1905APAutoconfigurationSearchPacket(uint16_t mid, uint8_t freq_band)
     // Free memory
     //
     /** @todo free supported services */
+    free_1905_TLV_structure(&searched_role_tlv->tlv);
+    free_1905_TLV_structure(&ac_freq_band_tlv->tlv);
 
     free(search_message.list_of_TLVs);
 
@@ -3273,21 +3036,21 @@ uint8_t send1905APAutoconfigurationResponsePacket(const char *interface_name, ui
     uint8_t ret;
 
     struct CMDU                  response_message;
-    struct supportedRoleTLV      supported_role_tlv;
-    struct supportedFreqBandTLV  supported_freq_band_tlv;
+    struct supportedRoleTLV     *supported_role_tlv;
+    struct supportedFreqBandTLV *supported_freq_band_tlv;
     struct supportedServiceTLV   *supported_service_tlv;
 
     PLATFORM_PRINTF_DEBUG_INFO("--> CMDU_TYPE_AP_AUTOCONFIGURATION_RESPONSE (%s)\n", interface_name);
 
     // Fill the supported role TLV
     //
-    supported_role_tlv.tlv.type = TLV_TYPE_SUPPORTED_ROLE;
-    supported_role_tlv.role     = IEEE80211_ROLE_AP;
+    supported_role_tlv       = X1905_TLV_ALLOC(supportedRole, TLV_TYPE_SUPPORTED_ROLE, NULL);
+    supported_role_tlv->role = IEEE80211_ROLE_AP;
 
     // Fill the supported freq band TLV
     //
-    supported_freq_band_tlv.tlv.type  = TLV_TYPE_SUPPORTED_FREQ_BAND;
-    supported_freq_band_tlv.freq_band = freq_band;
+    supported_freq_band_tlv            = X1905_TLV_ALLOC(supportedFreqBand, TLV_TYPE_SUPPORTED_FREQ_BAND, NULL);
+    supported_freq_band_tlv->freq_band = freq_band;
 
     supported_service_tlv = _obtainLocalSupportedServicesTLV(NULL);
 
@@ -3298,8 +3061,8 @@ uint8_t send1905APAutoconfigurationResponsePacket(const char *interface_name, ui
     response_message.message_id      = mid;
     response_message.relay_indicator = 0;
     response_message.list_of_TLVs    = (struct tlv **)memalloc(sizeof(struct tlv *)*4);
-    response_message.list_of_TLVs[0] = &supported_role_tlv.tlv;
-    response_message.list_of_TLVs[1] = &supported_freq_band_tlv.tlv;
+    response_message.list_of_TLVs[0] = &supported_role_tlv->tlv;
+    response_message.list_of_TLVs[1] = &supported_freq_band_tlv->tlv;
     if (include_easymesh)
     {
         response_message.list_of_TLVs[2] = &supported_service_tlv->tlv;
@@ -3323,6 +3086,8 @@ uint8_t send1905APAutoconfigurationResponsePacket(const char *interface_name, ui
     // Free memory
     //
     /** @todo free supported services */
+    free_1905_TLV_structure(&supported_role_tlv->tlv);
+    free_1905_TLV_structure(&supported_freq_band_tlv->tlv);
     free(response_message.list_of_TLVs);
 
     return ret;
@@ -3603,16 +3368,16 @@ uint8_t send1905HighLayerResponsePacket(const char *interface_name, uint16_t mid
     uint8_t i;
 
     struct CMDU                         response_message;
-    struct x1905ProfileVersionTLV       profile_tlv;
-    struct deviceIdentificationTypeTLV  identification_tlv;
+    struct x1905ProfileVersionTLV      *profile_tlv;
+    struct deviceIdentificationTypeTLV *identification_tlv;
     struct controlUrlTypeTLV            control_tlv;
     struct ipv4TypeTLV                  ipv4_tlv;
     struct ipv6TypeTLV                  ipv6_tlv;
 
     PLATFORM_PRINTF_DEBUG_INFO("--> CMDU_TYPE_HIGHER_LAYER_RESPONSE (%s)\n", interface_name);
 
-    _obtainLocalProfileTLV              (&profile_tlv);
-    _obtainLocalDeviceIdentificationTLV (&identification_tlv);
+    profile_tlv        = _obtainLocalProfileTLV              (NULL);
+    identification_tlv = _obtainLocalDeviceIdentificationTLV (NULL);
     _obtainLocalControlUrlTLV           (&control_tlv);
     _obtainLocalIpsTLVs                 (&ipv4_tlv, &ipv6_tlv);
 
@@ -3643,8 +3408,8 @@ uint8_t send1905HighLayerResponsePacket(const char *interface_name, uint16_t mid
     response_message.relay_indicator = 0;
     response_message.list_of_TLVs    = (struct tlv **)memalloc(sizeof(struct tlv *)*(total_tlvs+1));
     response_message.list_of_TLVs[0] = &_obtainLocalAlMacAddressTLV(NULL)->tlv;
-    response_message.list_of_TLVs[1] = &profile_tlv.tlv;
-    response_message.list_of_TLVs[2] = &identification_tlv.tlv;
+    response_message.list_of_TLVs[1] = &profile_tlv->tlv;
+    response_message.list_of_TLVs[2] = &identification_tlv->tlv;
 
     i = 3;
     if (NULL != control_tlv.url)
@@ -3671,12 +3436,14 @@ uint8_t send1905HighLayerResponsePacket(const char *interface_name, uint16_t mid
     if (0 == send1905RawPacket(interface_name, mid, destination_al_mac_address, &response_message))
     {
         PLATFORM_PRINTF_DEBUG_ERROR("Could not send packet\n");
+        free_1905_TLV_structure(&profile_tlv->tlv);
+        free_1905_TLV_structure(&identification_tlv->tlv);
         free(response_message.list_of_TLVs);
         return 0;
     }
 
-    _freeLocalProfileTLV              (&profile_tlv);
-    _freeLocalDeviceIdentificationTLV (&identification_tlv);
+    free_1905_TLV_structure(&profile_tlv->tlv);
+    free_1905_TLV_structure(&identification_tlv->tlv);
     _freeLocalControlUrlTLV           (&control_tlv);
     _freeLocalIpsTLVs                 (&ipv4_tlv, &ipv6_tlv);
 
@@ -4158,6 +3925,9 @@ uint8_t send1905CustomCommandResponseALME(uint8_t alme_client_id, uint8_t comman
             _memoryBufferWriterInit();
 
             DMdumpNetworkDevices(_memoryBufferWriter);
+            pool_dump(_memoryBufferWriter);
+            PLATFORM_DUMP_QUEUE_STATS(_memoryBufferWriter);
+            PLATFORM_DUMP_TX_SOCKET_CACHE_STATS(_memoryBufferWriter);
 
             memory_buffer[memory_buffer_i] = 0x0;
 
@@ -85,6 +85,31 @@
 //
 uint8_t send1905RawPacket(const char *interface_name, uint16_t mid, const uint8_t *dst_mac_address, struct CMDU *cmdu);
 
+// Same as "send1905RawPacket()" but sending the packet on each of the
+// 'interface_names_nr' interfaces contained in 'interface_names'.
+//
+// The CMDU is forged only once and all the resulting frames (every fragment on
+// every interface) are handed to the platform in a single batch.
+//
+// Return '0' if there was a problem, '1' otherwise.
+//
+uint8_t send1905RawPacketBatch(const char * const *interface_names, unsigned interface_names_nr, uint16_t mid,
+                               const uint8_t *dst_mac_address, struct CMDU *cmdu);
+
+// Send already forged 1905 frames (a NULL-terminated list of 'streams', in the
+// format returned by "forge_1905_CMDU_from_structure()", and their lengths)
+// on each of the 'interface_names_nr' interfaces contained in
+// 'interface_names', in a single batch.
+//
+// This is used to relay received multicast CMDUs as they are, with their
+// original MID and fragmentation: the same bytes are shared by all
+// interfaces.
+//
+// Return '0' if there was a problem, '1' otherwise.
+//
+uint8_t send1905RawStreamsBatch(const char * const *interface_names, unsigned interface_names_nr,
+                                const uint8_t *dst_mac_address, uint8_t **streams, const uint16_t *streams_lens);
+
 // This function sends a "1905 packet" (the one represented by the provided
 // 'cmdu' structure) on all interfaces that are secured and not off.
 //
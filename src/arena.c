@@ -0,0 +1,424 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+#include "arena.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>  // fprintf()
+#include <stdlib.h> // aligned_alloc(), free()
+#include <string.h> // memcpy()
+
+////////////////////////////////////////////////////////////////////////////////
+// Private data and functions
+////////////////////////////////////////////////////////////////////////////////
+
+// Every object is preceded by its size (needed by arena_realloc()) and is
+// aligned like malloc() memory.
+//
+#define ARENA_ALIGN   _Alignof(max_align_t)
+#define ARENA_ALIGN_UP(x, a) (((x) + (a) - 1) & ~((uintptr_t)(a) - 1))
+
+// Each chunk starts with this header. Chunks are aligned to ARENA_CHUNK_SIZE,
+// so the chunk containing an object is found by masking the object address
+// (dedicated chunks for large objects are multiples of ARENA_CHUNK_SIZE, but
+// the object always starts in their first ARENA_CHUNK_SIZE bytes).
+//
+struct _arenaChunk
+{
+    struct _arenaChunk *next;
+    struct arena       *arena;
+};
+
+struct arena
+{
+    unsigned            refs;
+    struct _arenaChunk *chunks;  // The bump chunk is always the first one
+    uintptr_t           next;    // Bump pointer in the first chunk
+    uintptr_t           end;
+    void               *last;    // Last object allocated from the bump chunk
+};
+
+__thread struct arena *arena_current;
+__thread size_t        arena_chunks_nr;
+
+// Open addressing (linear probing) table of the live chunks of this thread,
+// indexed by chunk number (i.e. address / ARENA_CHUNK_SIZE), used by
+// arena_of() to tell arena memory from heap memory.
+//
+static __thread struct _arenaChunk **chunk_table;
+static __thread size_t               chunk_table_size; // Always a power of 2
+
+static void _outOfMemory(void)
+{
+    fprintf(stderr, "ERROR: Out of memory!\n");
+    exit(1);
+}
+
+static size_t _chunkSlot(uintptr_t address)
+{
+    return (address / ARENA_CHUNK_SIZE) & (chunk_table_size - 1);
+}
+
+static void _chunkTableInsert(struct _arenaChunk *chunk)
+{
+    size_t i;
+
+    if (2 * (arena_chunks_nr + 1) > chunk_table_size)
+    {
+        struct _arenaChunk **old_table = chunk_table;
+        size_t               old_size  = chunk_table_size;
+
+        chunk_table_size = old_size ? 2 * old_size : 64;
+        chunk_table      = calloc(chunk_table_size, sizeof(*chunk_table));
+        if (NULL == chunk_table)
+        {
+            _outOfMemory();
+        }
+        for (i = 0; i < old_size; i++)
+        {
+            if (NULL != old_table[i])
+            {
+                size_t j = _chunkSlot((uintptr_t)old_table[i]);
+
+                while (NULL != chunk_table[j])
+                {
+                    j = (j + 1) & (chunk_table_size - 1);
+                }
+                chunk_table[j] = old_table[i];
+            }
+        }
+        free(old_table);
+    }
+
+    i = _chunkSlot((uintptr_t)chunk);
+    while (NULL != chunk_table[i])
+    {
+        i = (i + 1) & (chunk_table_size - 1);
+    }
+    chunk_table[i] = chunk;
+    arena_chunks_nr++;
+}
+
+static void _chunkTableRemove(struct _arenaChunk *chunk)
+{
+    size_t mask = chunk_table_size - 1;
+    size_t i, j;
+
+    i = _chunkSlot((uintptr_t)chunk);
+    while (chunk_table[i] != chunk)
+    {
+        assert(NULL != chunk_table[i]);
+        i = (i + 1) & mask;
+    }
+
+    // Backward shift deletion: move up any entry of the same cluster that
+    // would no longer be reachable from its home slot.
+    //
+    j = i;
+    while (1)
+    {
+        size_t home;
+
+        chunk_table[i] = NULL;
+        do
+        {
+            j = (j + 1) & mask;
+            if (NULL == chunk_table[j])
+            {
+                arena_chunks_nr--;
+                return;
+            }
+            home = _chunkSlot((uintptr_t)chunk_table[j]);
+        }
+        while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+
+        chunk_table[i] = chunk_table[j];
+        i = j;
+    }
+}
+
+static struct _arenaChunk *_chunkNew(struct arena *arena, size_t size)
+{
+    struct _arenaChunk *chunk;
+
+    chunk = aligned_alloc(ARENA_CHUNK_SIZE, size);
+    if (NULL == chunk)
+    {
+        _outOfMemory();
+    }
+    chunk->arena = arena;
+    _chunkTableInsert(chunk);
+
+    return chunk;
+}
+
+static void *_placeObject(uintptr_t start, size_t size)
+{
+    uintptr_t object = ARENA_ALIGN_UP(start + sizeof(size_t), ARENA_ALIGN);
+
+    ((size_t *)object)[-1] = size;
+    return (void *)object;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Public API
+////////////////////////////////////////////////////////////////////////////////
+
+struct arena *arena_new(void)
+{
+    struct _arenaChunk *chunk;
+    struct arena       *arena;
+
+    // The arena itself lives in its first chunk
+    //
+    chunk = _chunkNew(NULL, ARENA_CHUNK_SIZE);
+    arena = (struct arena *)ARENA_ALIGN_UP((uintptr_t)(chunk + 1), ARENA_ALIGN);
+
+    chunk->arena = arena;
+    chunk->next  = NULL;
+
+    arena->refs   = 1;
+    arena->chunks = chunk;
+    arena->next   = (uintptr_t)(arena + 1);
+    arena->end    = (uintptr_t)chunk + ARENA_CHUNK_SIZE;
+    arena->last   = NULL;
+
+    return arena;
+}
+
+void arena_ref(struct arena *arena)
+{
+    arena->refs++;
+}
+
+void arena_unref(struct arena *arena)
+{
+    struct _arenaChunk *chunk;
+
+    assert(arena->refs > 0);
+    if (--arena->refs > 0)
+    {
+        return;
+    }
+    assert(arena != arena_current);
+
+    // The arena structure is in one of the chunks, so don't touch it anymore
+    // once the first chunk has been freed.
+    //
+    chunk = arena->chunks;
+    while (NULL != chunk)
+    {
+        struct _arenaChunk *next = chunk->next;
+
+        _chunkTableRemove(chunk);
+        free(chunk);
+        chunk = next;
+    }
+}
+
+struct arena *arena_enter(struct arena *arena)
+{
+    struct arena *previous = arena_current;
+
+    arena_current = arena;
+    return previous;
+}
+
+void arena_leave(struct arena *previous)
+{
+    arena_current = previous;
+}
+
+void *arena_alloc(struct arena *arena, size_t size)
+{
+    struct _arenaChunk *chunk;
+    uintptr_t           object;
+
+    // Never return an empty object at the very end of a chunk: its address
+    // would belong to the next chunk.
+    //
+    if (0 == size)
+    {
+        size = 1;
+    }
+
+    object = ARENA_ALIGN_UP(arena->next + sizeof(size_t), ARENA_ALIGN);
+    if (object + size <= arena->end)
+    {
+        arena->next = object + size;
+        arena->last = (void *)object;
+        return _placeObject(object - sizeof(size_t), size);
+    }
+
+    if (size > ARENA_CHUNK_SIZE / 4)
+    {
+        // Large object: it gets a dedicated chunk, which is linked after the
+        // bump chunk so that the remainder of that one is not wasted.
+        //
+        size_t chunk_size = ARENA_ALIGN_UP(sizeof(*chunk) + ARENA_ALIGN + sizeof(size_t) + size, ARENA_CHUNK_SIZE);
+
+        chunk              = _chunkNew(arena, chunk_size);
+        chunk->next        = arena->chunks->next;
+        arena->chunks->next = chunk;
+
+        return _placeObject((uintptr_t)(chunk + 1), size);
+    }
+
+    chunk         = _chunkNew(arena, ARENA_CHUNK_SIZE);
+    chunk->next   = arena->chunks;
+    arena->chunks = chunk;
+    arena->end    = (uintptr_t)chunk + ARENA_CHUNK_SIZE;
+
+    object      = ARENA_ALIGN_UP((uintptr_t)(chunk + 1) + sizeof(size_t), ARENA_ALIGN);
+    arena->next = object + size;
+    arena->last = (void *)object;
+
+    return _placeObject(object - sizeof(size_t), size);
+}
+
+void *arena_realloc(void *ptr, size_t size)
+{
+    struct arena *arena;
+    void         *p;
+    size_t        old_size;
+
+    arena = NULL == ptr ? NULL : arena_of(ptr);
+
+    if (NULL == arena)
+    {
+        // Heap memory stays on the heap, new memory goes to the current arena
+        //
+        if (NULL == ptr && NULL != arena_current)
+        {
+            return arena_alloc(arena_current, size);
+        }
+        p = realloc(ptr, size);
+        if (NULL == p)
+        {
+            _outOfMemory();
+        }
+        return p;
+    }
+
+    old_size = ((size_t *)ptr)[-1];
+
+    if (arena == arena_current && ptr == arena->last && (uintptr_t)ptr + size <= arena->end && size > 0)
+    {
+        ((size_t *)ptr)[-1] = size;
+        arena->next         = (uintptr_t)ptr + size;
+        return ptr;
+    }
+
+    if (NULL != arena_current)
+    {
+        p = arena_alloc(arena_current, size);
+    }
+    else
+    {
+        p = malloc(size);
+        if (NULL == p)
+        {
+            _outOfMemory();
+        }
+    }
+    memcpy(p, ptr, old_size < size ? old_size : size);
+
+    return p;
+}
+
+struct arena *arena_of(const void *ptr)
+{
+    uintptr_t base = (uintptr_t)ptr & ~((uintptr_t)ARENA_CHUNK_SIZE - 1);
+    size_t    i;
+
+    if (0 == arena_chunks_nr)
+    {
+        return NULL;
+    }
+
+    i = _chunkSlot(base);
+    while (NULL != chunk_table[i])
+    {
+        if ((uintptr_t)chunk_table[i] == base)
+        {
+            return chunk_table[i]->arena;
+        }
+        i = (i + 1) & (chunk_table_size - 1);
+    }
+
+    return NULL;
+}
+
+bool arena_drop(const void *object)
+{
+    struct arena *arena;
+
+    if (!arena_owns(object))
+    {
+        return false;
+    }
+
+    arena = arena_of(object);
+    if (arena != arena_current)
+    {
+        arena_unref(arena);
+    }
+
+    return true;
+}
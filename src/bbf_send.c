@@ -130,17 +130,8 @@ static void _obtainLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV
 
         al_mac_addresses = DMgetListOfInterfaceNeighbors(interfaces_names[i], &al_mac_addresses_nr);
 
-        no  = (struct non1905NeighborDeviceListTLV *)memalloc(sizeof(struct non1905NeighborDeviceListTLV));
-
-        no->tlv.type              = TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST;
-        no->local_mac_address[0]  = x->mac_address[0];
-        no->local_mac_address[1]  = x->mac_address[1];
-        no->local_mac_address[2]  = x->mac_address[2];
-        no->local_mac_address[3]  = x->mac_address[3];
-        no->local_mac_address[4]  = x->mac_address[4];
-        no->local_mac_address[5]  = x->mac_address[5];
-        no->non_1905_neighbors_nr = 0;
-        no->non_1905_neighbors    = NULL;
+        no  = X1905_TLV_ALLOC(non1905NeighborDeviceList, TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST, NULL);
+        memcpy(no->local_mac_address, x->mac_address, 6);
 
         // Decide if each neighbor is a 1905 or a non-1905 neighbor
         //
@@ -163,7 +154,6 @@ static void _obtainLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV
             for (j=0; j<x->neighbor_mac_addresses_nr; j++)
             {
                 uint8_t *al_mac;
-                uint8_t k;
 
                 al_mac = DMmacToAlMac(x->neighbor_mac_addresses[j]);
 
@@ -171,14 +161,15 @@ static void _obtainLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV
                 {
                     // Non-1905 neighbor
 
+                    struct _non1905neighborEntries *non_1905_neighbor;
                     uint8_t already_added;
 
                     // Make sure it has not already been added
                     //
                     already_added = 0;
-                    for (k=0; k<no->non_1905_neighbors_nr; k++)
+                    dlist_for_each(non_1905_neighbor, no->tlv.s.h.children[0], s.h.l)
                     {
-                        if (0 == memcmp(x->neighbor_mac_addresses[j], no->non_1905_neighbors[k].mac_address, 6))
+                        if (0 == memcmp(x->neighbor_mac_addresses[j], non_1905_neighbor->mac_address, 6))
                         {
                             already_added = 1;
                             break;
@@ -189,23 +180,7 @@ static void _obtainLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV
                     {
                         // This is a new neighbor
                         //
-                        if (0 == no->non_1905_neighbors_nr)
-                        {
-                            no->non_1905_neighbors = (struct _non1905neighborEntries *)memalloc(sizeof(struct _non1905neighborEntries));
-                        }
-                        else
-                        {
-                            no->non_1905_neighbors = (struct _non1905neighborEntries *)memrealloc(no->non_1905_neighbors, sizeof(struct _non1905neighborEntries)*(no->non_1905_neighbors_nr+1));
-                        }
-
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[0] = x->neighbor_mac_addresses[j][0];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[1] = x->neighbor_mac_addresses[j][1];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[2] = x->neighbor_mac_addresses[j][2];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[3] = x->neighbor_mac_addresses[j][3];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[4] = x->neighbor_mac_addresses[j][4];
-                        no->non_1905_neighbors[no->non_1905_neighbors_nr].mac_address[5] = x->neighbor_mac_addresses[j][5];
-
-                        no->non_1905_neighbors_nr++;
+                        non1905NeighborDeviceListTLVAddNeighbor(no, x->neighbor_mac_addresses[j]);
                     }
                 }
                 else
@@ -230,7 +205,7 @@ static void _obtainLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV
         // We just need to add "no" and "yes" to the "non_1905_neighbors" and
         // "neighbors" lists and proceed to the next interface.
         //
-        if (no->non_1905_neighbors_nr > 0)
+        if (!dlist_empty(&no->tlv.s.h.children[0]))
         {
             // Add this to the list of non-1905 neighbor TLVs
             //
@@ -248,7 +223,7 @@ static void _obtainLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV
         }
         else
         {
-            free(no);
+            free_1905_TLV_structure(&no->tlv);
         }
     }
 
@@ -279,7 +254,7 @@ static uint8_t (*_getListOfNon1905Neighbors(struct non1905NeighborDeviceListTLV
                                           uint8_t                                  non1905_neighbors_nr,
                                           uint8_t                                 *mac_addresses_nr))[6]
 {
-    uint8_t i, j, k;
+    uint8_t i, k;
 
     uint8_t total;
     uint8_t (*ret)[6];
@@ -294,7 +269,9 @@ static uint8_t (*_getListOfNon1905Neighbors(struct non1905NeighborDeviceListTLV
 
     for (i=0; i<non1905_neighbors_nr; i++)
     {
-        for (j=0; j<non1905_neighbors[i]->non_1905_neighbors_nr; j++)
+        struct _non1905neighborEntries *non_1905_neighbor;
+
+        dlist_for_each(non_1905_neighbor, non1905_neighbors[i]->tlv.s.h.children[0], s.h.l)
         {
             // Check for duplicates
             //
@@ -303,7 +280,7 @@ static uint8_t (*_getListOfNon1905Neighbors(struct non1905NeighborDeviceListTLV
             already_present = 0;
             for (k=0; k<total; k++)
             {
-                if (0 == memcmp(&ret[k], non1905_neighbors[i]->non_1905_neighbors[j].mac_address, 6))
+                if (0 == memcmp(&ret[k], non_1905_neighbor->mac_address, 6))
                 {
                     already_present = 1;
                     break;
@@ -326,7 +303,7 @@ static uint8_t (*_getListOfNon1905Neighbors(struct non1905NeighborDeviceListTLV
             {
                 ret = (uint8_t (*)[6])memrealloc(ret, sizeof(uint8_t[6])*(total + 1));
             }
-            memcpy(&ret[total], non1905_neighbors[i]->non_1905_neighbors[j].mac_address, 6);
+            memcpy(&ret[total], non_1905_neighbor->mac_address, 6);
 
             total++;
         }
@@ -364,7 +341,7 @@ static uint8_t (*_getListOfNon1905Neighbors(struct non1905NeighborDeviceListTLV
 uint8_t (*_getListOfLinksWithNon1905Neighbor(struct non1905NeighborDeviceListTLV  **non1905_neighbors, uint8_t non1905_neighbors_nr,
                                            uint8_t *neighbor_mac_address, char ***interfaces, uint8_t *links_nr))[6]
 {
-    uint8_t i, j;
+    uint8_t i;
     uint8_t total;
 
     uint8_t (*ret)[6];
@@ -383,12 +360,14 @@ uint8_t (*_getListOfLinksWithNon1905Neighbor(struct non1905NeighborDeviceListTLV
     {
         if (NULL != non1905_neighbors[i])
         {
-            for (j=0; j<non1905_neighbors[i]->non_1905_neighbors_nr; j++)
+            struct _non1905neighborEntries *non_1905_neighbor;
+
+            dlist_for_each(non_1905_neighbor, non1905_neighbors[i]->tlv.s.h.children[0], s.h.l)
             {
                 // Filter neighbor (we are just interested in
                 // 'neighbor_mac_address')
                 //
-                if (0 != memcmp(neighbor_mac_address, non1905_neighbors[i]->non_1905_neighbors[j].mac_address, 6))
+                if (0 != memcmp(neighbor_mac_address, non_1905_neighbor->mac_address, 6))
                 {
                     continue;
                 }
@@ -403,7 +382,7 @@ uint8_t (*_getListOfLinksWithNon1905Neighbor(struct non1905NeighborDeviceListTLV
                     ret   = (uint8_t (*)[6])memrealloc(ret, sizeof(uint8_t[6])*(total + 1));
                     intfs = (char **)memrealloc(intfs, sizeof(char *)*(total + 1));
                 }
-                memcpy(&ret[total], non1905_neighbors[i]->non_1905_neighbors[j].mac_address, 6);
+                memcpy(&ret[total], non_1905_neighbor->mac_address, 6);
                 intfs[total] = DMmacToInterfaceName(non1905_neighbors[i]->local_mac_address);
 
                 total++;
@@ -437,11 +416,7 @@ static void _freeLocalNon1905NeighborsTLV(struct non1905NeighborDeviceListTLV **
         {
             if (NULL != (*non_1905_neighbors)[i])
             {
-                if ((*non_1905_neighbors)[i]->non_1905_neighbors_nr > 0)
-                {
-                    free((*non_1905_neighbors)[i]->non_1905_neighbors);
-                }
-                free((*non_1905_neighbors)[i]);
+                free_1905_TLV_structure(&(*non_1905_neighbors)[i]->tlv);
             }
         }
         free(*non_1905_neighbors);
@@ -57,8 +57,10 @@
 
 #include <datamodel.h>
 #include <platform.h>
+#include <pool.h> // pool_zalloc()
 
 #include <assert.h>
+#include <stddef.h> // offsetof
 #include <string.h> // memcpy
 
 #define EMPTY_MAC_ADDRESS {0, 0, 0, 0, 0, 0}
@@ -73,6 +75,153 @@ struct registrar registrar = {
 
 DEFINE_DLIST_HEAD(network);
 
+/* MAC address indexes
+ *
+ * Open addressing hash tables (with linear probing) of objects keyed by a MAC address stored inside them. Several
+ * objects may have the same key: they are all found by iterating with macIndexNext().
+ */
+struct macIndex {
+    void   **slots;     /**< NULL (never used), MAC_INDEX_DELETED or an indexed object. */
+    size_t   size;      /**< Number of slots. Always a power of 2 (or 0). */
+    size_t   used;      /**< Number of slots that are not NULL (ie. objects and deleted markers). */
+    size_t   key_offset;/**< Offset of the ::mac_address key in the indexed objects. */
+};
+
+/* Marks a slot whose object was removed. The probe sequence continues past it. */
+#define MAC_INDEX_DELETED ((void *)&macIndexDeleted)
+static char macIndexDeleted;
+
+#define MAC_INDEX_MIN_SIZE 16
+
+/* AL MAC address -> alDevice. */
+static struct macIndex devices_index = { .key_offset = offsetof(struct alDevice, al_mac_addr) };
+
+/* Interface address -> interface. Only interfaces owned by an alDevice are indexed. */
+static struct macIndex interfaces_index = { .key_offset = offsetof(struct interface, addr) };
+
+static const uint8_t *macIndexKey(const struct macIndex *index, const void *object)
+{
+    return (const uint8_t *)object + index->key_offset;
+}
+
+static size_t macIndexHash(const struct macIndex *index, const uint8_t *mac)
+{
+    /* FNV-1a */
+    uint32_t h = 2166136261u;
+    unsigned i;
+
+    for (i = 0; i < 6; i++)
+    {
+        h ^= mac[i];
+        h *= 16777619u;
+    }
+    return h & (index->size - 1);
+}
+
+static void macIndexInsert(struct macIndex *index, void *object);
+
+/* Rebuild the table with @a size slots, dropping the deleted markers. */
+static void macIndexResize(struct macIndex *index, size_t size)
+{
+    void   **old_slots = index->slots;
+    size_t   old_size  = index->size;
+    size_t   i;
+
+    index->slots = zmemalloc(size * sizeof(void *));
+    index->size  = size;
+    index->used  = 0;
+
+    for (i = 0; i < old_size; i++)
+    {
+        if (old_slots[i] != NULL && old_slots[i] != MAC_INDEX_DELETED)
+        {
+            macIndexInsert(index, old_slots[i]);
+        }
+    }
+    free(old_slots);
+}
+
+static void macIndexInsert(struct macIndex *index, void *object)
+{
+    size_t pos;
+
+    /* Keep the load factor (including deleted markers) below 1/2 so that probe sequences stay short. */
+    if ((index->used + 1) * 2 > index->size)
+    {
+        size_t size = index->size ? index->size : MAC_INDEX_MIN_SIZE;
+        size_t objects = 0;
+
+        for (pos = 0; pos < index->size; pos++)
+        {
+            if (index->slots[pos] != NULL && index->slots[pos] != MAC_INDEX_DELETED)
+            {
+                objects++;
+            }
+        }
+        /* If it is mostly deleted markers, rehashing at the same size is enough. */
+        while ((objects + 1) * 4 > size)
+        {
+            size *= 2;
+        }
+        macIndexResize(index, size);
+    }
+
+    pos = macIndexHash(index, macIndexKey(index, object));
+    while (index->slots[pos] != NULL && index->slots[pos] != MAC_INDEX_DELETED)
+    {
+        pos = (pos + 1) & (index->size - 1);
+    }
+    if (index->slots[pos] == NULL)
+    {
+        index->used++;
+    }
+    index->slots[pos] = object;
+}
+
+static void macIndexRemove(struct macIndex *index, void *object)
+{
+    size_t pos;
+
+    if (index->size == 0)
+    {
+        return;
+    }
+    pos = macIndexHash(index, macIndexKey(index, object));
+    while (index->slots[pos] != NULL)
+    {
+        if (index->slots[pos] == object)
+        {
+            index->slots[pos] = MAC_INDEX_DELETED;
+            return;
+        }
+        pos = (pos + 1) & (index->size - 1);
+    }
+}
+
+/** @brief Iterate over the objects of @a index with key @a mac.
+ *
+ * @a pos must be set to SIZE_MAX before the first call. Returns NULL when there are no more matching objects.
+ */
+static void *macIndexNext(const struct macIndex *index, const uint8_t *mac, size_t *pos)
+{
+    if (index->size == 0)
+    {
+        return NULL;
+    }
+    *pos = *pos == SIZE_MAX ? macIndexHash(index, mac) : ((*pos + 1) & (index->size - 1));
+    while (index->slots[*pos] != NULL)
+    {
+        void *object = index->slots[*pos];
+
+        if (object != MAC_INDEX_DELETED && memcmp(macIndexKey(index, object), mac, 6) == 0)
+        {
+            return object;
+        }
+        *pos = (*pos + 1) & (index->size - 1);
+    }
+    return NULL;
+}
+
 void datamodelInit(void)
 {
 }
@@ -81,9 +230,10 @@ void datamodelInit(void)
  */
 struct alDevice *alDeviceAlloc(const mac_address al_mac_addr)
 {
-    struct alDevice *ret = zmemalloc(sizeof(struct alDevice));
+    struct alDevice *ret = pool_zalloc(sizeof(struct alDevice));
     dlist_add_tail(&network, &ret->l);
     memcpy(ret->al_mac_addr, al_mac_addr, sizeof(mac_address));
+    macIndexInsert(&devices_index, ret);
     dlist_head_init(&ret->interfaces);
     dlist_head_init(&ret->radios);
     ret->is_map_agent = false;
@@ -101,15 +251,16 @@ void alDeviceDelete(struct alDevice *alDevice)
         struct radio *radio = container_of(dlist_get_first(&alDevice->radios), struct radio, l);
         radioDelete(radio);
     }
+    macIndexRemove(&devices_index, alDevice);
     dlist_remove(&alDevice->l);
-    free(alDevice);
+    pool_free(alDevice);
 }
 
 /* 'radio' related functions
  */
 struct radio*   radioAlloc(struct alDevice *dev, const mac_address mac)
 {
-    struct radio *r = zmemalloc(sizeof(struct radio));
+    struct radio *r = pool_zalloc(sizeof(struct radio));
     memcpy(&r->uid, &mac, sizeof(mac_address));
     r->index = -1;
     dlist_add_tail(&dev->radios, &r->l);
@@ -134,13 +285,13 @@ void    radioDelete(struct radio *radio)
         /* The interfaceWifi is deleted automatically when we delete the interface itself. */
         interfaceDelete(&radio->configured_bsses.data[i]->i);
     }
-    PTRARRAY_CLEAR(radio->configured_bsses);
+    PTRSET_CLEAR(radio->configured_bsses);
     for ( i=0 ; i < radio->bands.length ; i++ ) {
         PTRARRAY_CLEAR(radio->bands.data[i]->channels);
         free(radio->bands.data[i]);
     }
-    PTRARRAY_CLEAR(radio->bands);
-    free(radio);
+    PTRSET_CLEAR(radio->bands);
+    pool_free(radio);
 }
 
 struct radio *findDeviceRadio(const struct alDevice *device, const mac_address uid)
@@ -171,7 +322,7 @@ struct radio *findLocalRadio(const char *name)
 
 int radioAddInterfaceWifi(struct radio *radio, struct interfaceWifi *ifw)
 {
-    PTRARRAY_ADD(radio->configured_bsses, ifw);
+    PTRSET_ADD(radio->configured_bsses, ifw);
     ifw->radio = radio;
     return 0;
 }
@@ -232,35 +383,39 @@ static struct interface * interfaceInit(struct interface *i, const mac_address a
 
 struct interface *interfaceAlloc(const mac_address addr, struct alDevice *owner)
 {
-    return interfaceInit(zmemalloc(sizeof(struct interface)), addr, owner);
+    return interfaceInit(pool_zalloc(sizeof(struct interface)), addr, owner);
 }
 
 void interfaceDelete(struct interface *interface)
 {
-    unsigned i;
-    for (i = 0; i < interface->neighbors.length; i++)
+    /* interfaceRemoveNeighbor() moves the last neighbor in place of the removed one, so always remove the last one. */
+    while (interface->neighbors.length > 0)
     {
-        interfaceRemoveNeighbor(interface, interface->neighbors.data[i]);
+        interfaceRemoveNeighbor(interface, interface->neighbors.data[interface->neighbors.length - 1]);
     }
     /* Even if the interface doesn't have an owner, removing it from the empty list doesn't hurt. */
     dlist_remove(&interface->l);
-    free(interface);
+    if (interface->owner != NULL)
+    {
+        macIndexRemove(&interfaces_index, interface);
+    }
+    pool_free(interface);
 }
 
 void interfaceAddNeighbor(struct interface *interface, struct interface *neighbor)
 {
-    PTRARRAY_ADD(interface->neighbors, neighbor);
-    PTRARRAY_ADD(neighbor->neighbors, interface);
+    PTRSET_ADD(interface->neighbors, neighbor);
+    PTRSET_ADD(neighbor->neighbors, interface);
 }
 
 void interfaceRemoveNeighbor(struct interface *interface, struct interface *neighbor)
 {
-    PTRARRAY_REMOVE_ELEMENT(interface->neighbors, neighbor);
-    PTRARRAY_REMOVE_ELEMENT(neighbor->neighbors, interface);
+    PTRSET_REMOVE_ELEMENT(interface->neighbors, neighbor);
+    PTRSET_REMOVE_ELEMENT(neighbor->neighbors, interface);
     if (neighbor->owner == NULL && neighbor->neighbors.length == 0)
     {
         /* No more references to the neighbor interface. */
-        free(neighbor);
+        pool_free(neighbor);
     }
 }
 
@@ -268,7 +423,7 @@ void interfaceRemoveNeighbor(struct interface *interface, struct interface *neig
  */
 struct interfaceWifi *interfaceWifiAlloc(const mac_address addr, struct alDevice *owner)
 {
-    struct interfaceWifi *ifw = zmemalloc(sizeof(*ifw));
+    struct interfaceWifi *ifw = pool_zalloc(sizeof(*ifw));
     interfaceInit(&ifw->i, addr, owner);
     ifw->i.type = interface_type_wifi;
     return ifw;
@@ -276,7 +431,7 @@ struct interfaceWifi *interfaceWifiAlloc(const mac_address addr, struct alDevice
 
 void    interfaceWifiRemove(struct interfaceWifi *ifw)
 {
-    PTRARRAY_REMOVE_ELEMENT(ifw->radio->configured_bsses, ifw);
+    PTRSET_REMOVE_ELEMENT(ifw->radio->configured_bsses, ifw);
     /* Clients don't need to be deleted; they are also in the interface neighbour list, so they will be deleted or unlinked
      * together with the interface. */
     interfaceDelete(&ifw->i); /* This also frees interfaceWifi itself. */
@@ -289,17 +444,13 @@ void alDeviceAddInterface(struct alDevice *device, struct interface *interface)
     assert(interface->owner == NULL);
     dlist_add_tail(&device->interfaces, &interface->l);
     interface->owner = device;
+    macIndexInsert(&interfaces_index, interface);
 }
 
 struct alDevice *alDeviceFind(const mac_address al_mac_addr)
 {
-    struct alDevice *ret;
-    dlist_for_each(ret, network, l)
-    {
-        if (memcmp(ret->al_mac_addr, al_mac_addr, 6) == 0)
-            return ret;
-    }
-    return NULL;
+    size_t pos = SIZE_MAX;
+    return macIndexNext(&devices_index, al_mac_addr, &pos);
 }
 
 struct alDevice *alDeviceFindFromAnyAddress(const mac_address sender_addr)
@@ -319,9 +470,10 @@ struct alDevice *alDeviceFindFromAnyAddress(const mac_address sender_addr)
 struct interface *alDeviceFindInterface(const struct alDevice *device, const mac_address addr)
 {
     struct interface *ret;
-    dlist_for_each(ret, device->interfaces, l)
+    size_t pos = SIZE_MAX;
+    while ((ret = macIndexNext(&interfaces_index, addr, &pos)) != NULL)
     {
-        if (memcmp(ret->addr, addr, 6) == 0)
+        if (ret->owner == device)
         {
             return ret;
         }
@@ -386,18 +538,8 @@ void localDeviceSetConfigured(bool configured)
 
 struct interface *findDeviceInterface(const mac_address addr)
 {
-    struct alDevice *alDevice;
-    struct interface *ret = NULL;
-
-    dlist_for_each(alDevice, network, l)
-    {
-        ret = alDeviceFindInterface(alDevice, addr);
-        if (ret != NULL)
-        {
-            return ret;
-        }
-    }
-    return NULL;
+    size_t pos = SIZE_MAX;
+    return macIndexNext(&interfaces_index, addr, &pos);
 }
 
 struct interface *findLocalInterface(const char *name)
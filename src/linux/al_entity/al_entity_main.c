@@ -58,7 +58,7 @@
 #include <hlist.h>
 
 #include <platform.h>
-#include "../platform_interfaces_priv.h"            // addInterface
+#include "../platform_interfaces_priv.h"            // addInterface, interfaceStatsSetMaxAge
 #include "../platform_interfaces_ghnspirit_priv.h"  // registerGhnSpiritInterfaceType
 #include "../platform_interfaces_simulated_priv.h"  // registerSimulatedInterfaceType
 #include "../platform_alme_server_priv.h"           // almeServerPortSet()
@@ -118,7 +118,7 @@ static void _printUsage(char *program_name)
 {
     printf("AL entity (build %s)\n", _BUILD_NUMBER_);
     printf("\n");
-    printf("Usage: %s -m <al_mac_address> -i <interfaces_list> [-w] [-r <registrar_interface>] [-v] [-p <alme_port_number>]\n", program_name);
+    printf("Usage: %s -m <al_mac_address> -i <interfaces_list> [-w] [-r <registrar_interface>] [-v] [-p <alme_port_number>] [-s <stats_max_age>]\n", program_name);
     printf("\n");
     printf("  ...where:\n");
     printf("       '<al_mac_address>' is the AL MAC address that this AL entity will receive\n");
@@ -140,6 +140,10 @@ static void _printUsage(char *program_name)
     printf("       '<alme_port_number>', is the port number where a TCP socket will be opened to receive\n");
     printf("       ALME messages. If this argument is not given, a default value of '8888' is used.\n");
     printf("\n");
+    printf("       '<stats_max_age>', is the number of milliseconds during which the interface packet\n");
+    printf("       counters read from the kernel are reused when reporting link metrics. If this\n");
+    printf("       argument is not given, a default value of '1000' is used.\n");
+    printf("\n");
 
     return;
 }
@@ -165,7 +169,7 @@ int main(int argc, char *argv[])
     registerGhnSpiritInterfaceType();
     registerSimulatedInterfaceType();
 
-    while ((c = getopt (argc, argv, "m:i:wr:vh:p:")) != -1)
+    while ((c = getopt (argc, argv, "m:i:wr:vh:p:s:")) != -1)
     {
         switch (c)
         {
@@ -223,6 +227,14 @@ int main(int argc, char *argv[])
                 break;
             }
 
+            case 's':
+            {
+                // Freshness window of the interface statistics cache
+                //
+                interfaceStatsSetMaxAge((uint32_t)atoi(optarg));
+                break;
+            }
+
             case 'h':
             {
                 _printUsage(argv[0]);
@@ -60,6 +60,7 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <errno.h>
+#include <net/if.h>             // if_nametoindex()
 
 #include <netlink/attr.h>       // nla_parse()
 #include <netlink/genl/genl.h>  // genlmsg_attr*()
@@ -68,6 +69,7 @@
 #include "datamodel.h"
 #include "nl80211.h"
 #include "platform.h"
+#include "utils.h"              // memrealloc()
 
 static int collect_protocol_features(struct nl_msg *msg, bool *splitWiphy)
 {
@@ -187,7 +189,7 @@ static int collect_radio_datas(struct nl_msg *msg, struct radio *radio)
 
             if ( ! band || band->id != nl_band->nla_type ) {
                 band = zmemalloc(sizeof(struct radioBand));
-                PTRARRAY_ADD(radio->bands, band);
+                PTRSET_ADD(radio->bands, band);
                 band->id = nl_band->nla_type;
             }
             nla_parse(tb_band, NL80211_BAND_ATTR_MAX, nla_data(nl_band), nla_len(nl_band), NULL);
@@ -336,3 +338,79 @@ int netlink_collect_local_infos(void) /* populate 'local_device' */
     netlink_close(&nlstate);
     return ret;
 }
+
+/** @brief  callback to collect the statistics of one station
+ *
+ *  This function is called once per station from the netlink interface while
+ *  processing a NL80211_CMD_GET_STATION dump.
+ */
+static int collect_station_datas(struct nl_msg *msg, struct netlink_stations *stations)
+{
+    struct nlattr           *tb_msg[NL80211_ATTR_MAX + 1];
+    struct nlattr           *tb_sta[NL80211_STA_INFO_MAX + 1];
+    struct nlattr           *tb_rate[NL80211_RATE_INFO_MAX + 1];
+    struct genlmsghdr       *gnlh = nlmsg_data(nlmsg_hdr(msg));
+    struct netlink_station  *sta;
+
+    nla_parse(tb_msg, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL);
+
+    if ( ! tb_msg[NL80211_ATTR_MAC] || ! tb_msg[NL80211_ATTR_STA_INFO]
+    ||   nla_parse_nested(tb_sta, NL80211_STA_INFO_MAX, tb_msg[NL80211_ATTR_STA_INFO], NULL) )
+        return NL_SKIP;
+
+    stations->list = memrealloc(stations->list, (stations->nr + 1) * sizeof(*stations->list));
+    sta = &stations->list[stations->nr++];
+    memset(sta, 0, sizeof(*sta));
+    memcpy(sta->mac, nla_data(tb_msg[NL80211_ATTR_MAC]), sizeof(sta->mac));
+
+    if ( tb_sta[NL80211_STA_INFO_RX_PACKETS] )
+        sta->rx_packets = nla_get_u32(tb_sta[NL80211_STA_INFO_RX_PACKETS]);
+    if ( tb_sta[NL80211_STA_INFO_TX_PACKETS] )
+        sta->tx_packets = nla_get_u32(tb_sta[NL80211_STA_INFO_TX_PACKETS]);
+    if ( tb_sta[NL80211_STA_INFO_TX_FAILED] )
+        sta->tx_failed  = nla_get_u32(tb_sta[NL80211_STA_INFO_TX_FAILED]);
+    if ( tb_sta[NL80211_STA_INFO_SIGNAL] )
+        sta->signal     = (int8_t)nla_get_u8(tb_sta[NL80211_STA_INFO_SIGNAL]);
+
+    if ( tb_sta[NL80211_STA_INFO_TX_BITRATE]
+    &&   ! nla_parse_nested(tb_rate, NL80211_RATE_INFO_MAX, tb_sta[NL80211_STA_INFO_TX_BITRATE], NULL) ) {
+        uint32_t rate = 0; /* In units of 100 kbit/s */
+
+        if ( tb_rate[NL80211_RATE_INFO_BITRATE32] )
+            rate = nla_get_u32(tb_rate[NL80211_RATE_INFO_BITRATE32]);
+        else if ( tb_rate[NL80211_RATE_INFO_BITRATE] )
+            rate = nla_get_u16(tb_rate[NL80211_RATE_INFO_BITRATE]);
+        sta->tx_bitrate = rate / 10;
+    }
+    return NL_SKIP;
+}
+
+int netlink_get_stations(const char *ifname, struct netlink_stations *stations)
+{
+    struct nl80211_state  nlstate;
+    struct nl_msg        *m;
+    uint32_t              ifindex;
+    int                   ret = 0;
+
+    stations->list = NULL;
+    stations->nr   = 0;
+
+    if ( ! (ifindex = if_nametoindex(ifname)) )
+        return -1;
+    if ( netlink_open(&nlstate) < 0 )
+        return -1;
+
+    if ( ! (m = netlink_prepare(&nlstate, NL80211_CMD_GET_STATION, NLM_F_DUMP)) ) {
+        ret = -1;
+    }
+    else if ( nla_put_u32(m, NL80211_ATTR_IFINDEX, ifindex) < 0 ) {
+        nlmsg_free(m);
+        ret = -1;
+    }
+    else if ( netlink_do(&nlstate, m, (void *)collect_station_datas, stations) < 0 ) {
+        ret = -1;
+    }
+    netlink_close(&nlstate);
+
+    return ret < 0 ? -1 : (int)stations->nr;
+}
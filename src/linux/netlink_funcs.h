@@ -92,6 +92,33 @@ extern int  phy_lookup(const char *basedir, char *name, mac_address mac, int *in
  */
 extern int  netlink_collect_local_infos(void);
 
+/** @brief  Statistics of one station, as reported by NL80211_CMD_GET_STATION
+ */
+struct netlink_station {
+    mac_address mac;
+    uint32_t    rx_packets;
+    uint32_t    tx_packets;
+    uint32_t    tx_failed;
+    uint16_t    tx_bitrate; /**< Mbit/s */
+    int8_t      signal;     /**< dBm */
+};
+
+/** @brief  All the stations of an interface
+ */
+struct netlink_stations {
+    struct netlink_station *list;
+    unsigned                nr;
+};
+
+/** @brief  Dump the statistics of all the stations of interface @a ifname
+ *
+ *  A single NL80211_CMD_GET_STATION dump request is sent. @a stations->list
+ *  must be freed by the caller (also when there are no stations).
+ *
+ *  @return the number of stations, or -1 on error.
+ */
+extern int  netlink_get_stations(const char *ifname, struct netlink_stations *stations);
+
 /** @brief  Open the netlink socket and prepare for commands
  *
  *  @param  out_nlstate Output structure
@@ -65,6 +65,8 @@
 #include <stdarg.h>      // va_list
 #include <sys/time.h>    // gettimeofday()
 #include <errno.h>       // errno
+#include <stdbool.h>     // bool
+#include <time.h>        // clock_gettime()
 
 #include <arpa/inet.h>        // htons()
 #include <linux/if_packet.h>  // sockaddr_ll
@@ -100,158 +102,491 @@ static struct timeval tv_begin;
 //   2 => Print ERROR, WARNING and INFO messages
 //   3 => Print ERROR, WARNING, INFO and DETAIL messages
 //
-static int verbosity_level = 2;
+// It is not static because "PLATFORM_PRINTF_DEBUG_ENABLED()" (in "platform.h")
+// checks it inline.
+//
+int platform_verbosity_level = 2;
 
-// Mutex to avoid STDOUT "overlaping" due to different threads writing at the
-// same time.
+// Header printed in front of each debug message (after the timestamp),
+// indexed by debug level.
+//
+static const char *level_headers[] =
+{
+    [PLATFORM_DEBUG_LEVEL_ERROR]   = "ERROR   : ",
+    [PLATFORM_DEBUG_LEVEL_WARNING] = "WARNING : ",
+    [PLATFORM_DEBUG_LEVEL_INFO]    = "INFO    : ",
+    [PLATFORM_DEBUG_LEVEL_DETAIL]  = "DETAIL  : ",
+};
+
+// Level used for messages printed with "PLATFORM_PRINTF()", which have no
+// timestamp nor header.
 //
+#define LOG_LEVEL_RAW (-1)
+
 #ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-pthread_mutex_t printf_mutex = PTHREAD_MUTEX_INITIALIZER;
-#endif
 
+// Asynchronous log backend.
+//
+// Formatting and writing to STDOUT used to be done by the calling thread while
+// holding a global mutex. Now each thread formats its messages into its own
+// single-producer/single-consumer ring of fixed size records (no locks, no
+// system calls) and a background writer thread drains all the rings, in the
+// same order the messages were produced, into STDOUT.
+//
+// If a ring is full the message is dropped and counted. The writer reports
+// how many messages were lost the next time it prints something from that
+// ring.
+//
+// Messages longer than LOG_RECORD_SIZE are truncated.
+//
+#define LOG_RING_SIZE        (128)   // Records per thread. Must be a power of 2.
+#define LOG_RECORD_SIZE      (480)
+#define LOG_WRITER_PERIOD_MS (100)   // Max time the writer sleeps without
+                                     // checking the rings
 
-////////////////////////////////////////////////////////////////////////////////
-// Platform API: libc stuff
-////////////////////////////////////////////////////////////////////////////////
+struct _logRecord
+{
+    uint64_t  seq;     // Global order of the message
+    uint32_t  ts;      // PLATFORM_GET_TIMESTAMP() when it was produced
+    int16_t   level;   // PLATFORM_DEBUG_LEVEL_* or LOG_LEVEL_RAW
+    uint16_t  len;
+    char      text[LOG_RECORD_SIZE];
+};
+
+struct _logRing
+{
+    struct _logRing   *next;      // List of all rings ('log_rings')
+    uint32_t           head;      // Next record to write (producer)
+    uint32_t           tail;      // Next record to read (writer)
+    uint32_t           dropped;   // Messages lost because the ring was full
+    bool               orphan;    // The owner thread has exited
+    struct _logRecord  records[LOG_RING_SIZE];
+};
+
+static __thread struct _logRing *log_ring;  // Ring of the calling thread
+
+static struct _logRing *log_rings;          // All the rings
+static pthread_mutex_t  log_rings_mutex   = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t    log_ring_key;       // Used to detect thread exit
+static pthread_once_t   log_writer_once   = PTHREAD_ONCE_INIT;
+static pthread_t        log_writer;
+static bool             log_writer_running;
+static bool             log_writer_stop;
+static uint64_t         log_seq;
+
+// The writer sleeps on 'log_writer_cond' (with 'log_writer_mutex' held) when
+// all rings are empty and sets 'log_writer_sleeping' so that producers know
+// they have to wake it up.
+//
+static pthread_mutex_t  log_writer_mutex  = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   log_writer_cond   = PTHREAD_COND_INITIALIZER;
+static bool             log_writer_sleeping;
 
+// Mutex to avoid STDOUT "overlaping" when the writer thread is not running
+// (before it is started, if it could not be started and while the program
+// exits)
+//
+static pthread_mutex_t printf_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-void PLATFORM_PRINTF(const char *format, ...)
+// Write one record to STDOUT
+//
+static void _logRecordPrint(const struct _logRecord *r)
 {
-    va_list arglist;
+    if (LOG_LEVEL_RAW != r->level)
+    {
+        printf("[%03d.%03d] %s", r->ts/1000, r->ts%1000, level_headers[r->level]);
+    }
+    fwrite(r->text, 1, r->len, stdout);
+}
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
+// Write to STDOUT all the pending records of all rings, in order. Must be
+// called with 'log_rings_mutex' held.
+//
+// Returns the number of records written.
+//
+static unsigned _logRingsDrain(void)
+{
+    unsigned written = 0;
 
-    va_start( arglist, format );
-    vprintf( format, arglist );
-    va_end( arglist );
+    for (;;)
+    {
+        struct _logRing   *ring;
+        struct _logRing   *oldest      = NULL;
+        struct _logRecord *oldest_rec  = NULL;
+
+        // Take the oldest record found at the tail of any ring
+        //
+        for (ring = log_rings; NULL != ring; ring = ring->next)
+        {
+            struct _logRecord *rec;
+
+            if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == ring->tail)
+            {
+                continue;
+            }
+            rec = &ring->records[ring->tail & (LOG_RING_SIZE - 1)];
+            if (NULL == oldest_rec || rec->seq < oldest_rec->seq)
+            {
+                oldest     = ring;
+                oldest_rec = rec;
+            }
+        }
+        if (NULL == oldest)
+        {
+            break;
+        }
+
+        _logRecordPrint(oldest_rec);
+        __atomic_store_n(&oldest->tail, oldest->tail + 1, __ATOMIC_RELEASE);
+        written++;
+    }
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
+    // Report lost messages and get rid of the rings of threads that no longer
+    // exist
+    //
+    {
+        struct _logRing **pring = &log_rings;
+
+        while (NULL != *pring)
+        {
+            struct _logRing *ring = *pring;
+            uint32_t         dropped;
+
+            dropped = __atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+            if (0 != dropped)
+            {
+                uint32_t ts = PLATFORM_GET_TIMESTAMP();
+
+                printf("[%03d.%03d] %s[PLATFORM] %u log messages lost\n", ts/1000, ts%1000,
+                       level_headers[PLATFORM_DEBUG_LEVEL_WARNING], dropped);
+                written++;
+            }
+
+            if (__atomic_load_n(&ring->orphan, __ATOMIC_ACQUIRE) &&
+                __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == ring->tail)
+            {
+                *pring = ring->next;
+                free(ring);
+            }
+            else
+            {
+                pring = &ring->next;
+            }
+        }
+    }
 
-    return;
+    if (0 != written)
+    {
+        fflush(stdout);
+    }
+
+    return written;
 }
 
-void PLATFORM_PRINTF_DEBUG_SET_VERBOSITY_LEVEL(int level)
+static void *_logWriterThread(void *p)
 {
-    verbosity_level = level;
+    (void) p;
+
+    for (;;)
+    {
+        struct timespec deadline;
+        bool            stop;
+        unsigned        written;
+
+        pthread_mutex_lock(&log_rings_mutex);
+        written = _logRingsDrain();
+        pthread_mutex_unlock(&log_rings_mutex);
+
+        if (0 != written)
+        {
+            continue;
+        }
+
+        // Nothing left. Sleep until a producer wakes us up (or the period
+        // expires, just in case).
+        //
+        pthread_mutex_lock(&log_writer_mutex);
+        __atomic_store_n(&log_writer_sleeping, true, __ATOMIC_SEQ_CST);
+
+        // Check again, now that producers will see the flag
+        //
+        pthread_mutex_lock(&log_rings_mutex);
+        written = _logRingsDrain();
+        pthread_mutex_unlock(&log_rings_mutex);
+
+        stop = __atomic_load_n(&log_writer_stop, __ATOMIC_ACQUIRE);
+        if (0 == written && !stop)
+        {
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += LOG_WRITER_PERIOD_MS * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L)
+            {
+                deadline.tv_sec  += 1;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&log_writer_cond, &log_writer_mutex, &deadline);
+        }
+
+        __atomic_store_n(&log_writer_sleeping, false, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&log_writer_mutex);
+
+        if (stop)
+        {
+            break;
+        }
+    }
+
+    return NULL;
 }
 
-void PLATFORM_PRINTF_DEBUG_ERROR(const char *format, ...)
+// Called when a thread that has a log ring exits
+//
+static void _logRingRelease(void *p)
 {
-    va_list arglist;
-    uint32_t ts;
+    struct _logRing *ring = (struct _logRing *)p;
 
-    if (verbosity_level < 0)
+    // The writer frees it once it is empty
+    //
+    __atomic_store_n(&ring->orphan, true, __ATOMIC_RELEASE);
+}
+
+// Called when the program exits: stop the writer and print whatever is still
+// pending.
+//
+static void _logWriterStop(void)
+{
+    if (!__atomic_load_n(&log_writer_running, __ATOMIC_ACQUIRE))
     {
         return;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
+    __atomic_store_n(&log_writer_stop, true, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&log_writer_mutex);
+    pthread_cond_signal(&log_writer_cond);
+    pthread_mutex_unlock(&log_writer_mutex);
+    pthread_join(log_writer, NULL);
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
-
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("ERROR   : ");
-    va_start( arglist, format );
-    vprintf( format, arglist );
-    va_end( arglist );
+    // From now on messages are printed synchronously
+    //
+    __atomic_store_n(&log_writer_running, false, __ATOMIC_RELEASE);
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
+    pthread_mutex_lock(&printf_mutex);
+    pthread_mutex_lock(&log_rings_mutex);
+    _logRingsDrain();
+    pthread_mutex_unlock(&log_rings_mutex);
     pthread_mutex_unlock(&printf_mutex);
-#endif
+}
 
-    return;
+static void _logWriterStart(void)
+{
+    if (0 != pthread_key_create(&log_ring_key, _logRingRelease))
+    {
+        return;
+    }
+    if (0 != pthread_create(&log_writer, NULL, _logWriterThread, NULL))
+    {
+        return;
+    }
+    __atomic_store_n(&log_writer_running, true, __ATOMIC_RELEASE);
+    atexit(_logWriterStop);
 }
 
-void PLATFORM_PRINTF_DEBUG_WARNING(const char *format, ...)
+// Return the ring of the calling thread (creating it if needed), or NULL if
+// messages must be printed synchronously.
+//
+static struct _logRing *_logRingGet(void)
 {
-    va_list arglist;
-    uint32_t ts;
+    pthread_once(&log_writer_once, _logWriterStart);
 
-    if (verbosity_level < 1)
+    if (!__atomic_load_n(&log_writer_running, __ATOMIC_ACQUIRE))
     {
-        return;
+        return NULL;
+    }
+
+    if (NULL == log_ring)
+    {
+        struct _logRing *ring;
+
+        ring = (struct _logRing *)calloc(1, sizeof(*ring));
+        if (NULL == ring)
+        {
+            return NULL;
+        }
+        pthread_setspecific(log_ring_key, ring);
+
+        pthread_mutex_lock(&log_rings_mutex);
+        ring->next = log_rings;
+        log_rings  = ring;
+        pthread_mutex_unlock(&log_rings_mutex);
+
+        log_ring = ring;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
+    return log_ring;
+}
+
+#endif
+
+// Common part of all the "PLATFORM_PRINTF*()" functions. 'level' is one of
+// PLATFORM_DEBUG_LEVEL_* or LOG_LEVEL_RAW.
+//
+static void _logMessage(int level, const char *format, va_list arglist)
+{
+    uint32_t ts = 0;
+
+#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
+    struct _logRing *ring;
+#endif
+
+    if (LOG_LEVEL_RAW != level)
+    {
+        ts = PLATFORM_GET_TIMESTAMP();
+    }
 
 #ifndef _FLAVOUR_X86_WINDOWS_MINGW_
+    ring = _logRingGet();
+    if (NULL != ring)
+    {
+        struct _logRecord *rec;
+        uint32_t           head;
+        int                len;
+
+        head = ring->head;
+        if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= LOG_RING_SIZE)
+        {
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+
+        rec        = &ring->records[head & (LOG_RING_SIZE - 1)];
+        rec->seq   = __atomic_fetch_add(&log_seq, 1, __ATOMIC_RELAXED);
+        rec->ts    = ts;
+        rec->level = level;
+
+        len = vsnprintf(rec->text, sizeof(rec->text), format, arglist);
+        if (len < 0)
+        {
+            len = 0;
+        }
+        else if ((size_t)len >= sizeof(rec->text))
+        {
+            // Truncated. Make it visible.
+            //
+            len = sizeof(rec->text) - 1;
+            memcpy(&rec->text[len - 4], "...\n", 4);
+        }
+        rec->len = len;
+
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&log_writer_sleeping, __ATOMIC_SEQ_CST))
+        {
+            pthread_mutex_lock(&log_writer_mutex);
+            pthread_cond_signal(&log_writer_cond);
+            pthread_mutex_unlock(&log_writer_mutex);
+        }
+        return;
+    }
+
     pthread_mutex_lock(&printf_mutex);
 #endif
 
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("WARNING : ");
-    va_start( arglist, format );
-    vprintf( format, arglist );
-    va_end( arglist );
+    if (LOG_LEVEL_RAW != level)
+    {
+        printf("[%03d.%03d] %s", ts/1000, ts%1000, level_headers[level]);
+    }
+    vprintf(format, arglist);
 
 #ifndef _FLAVOUR_X86_WINDOWS_MINGW_
     pthread_mutex_unlock(&printf_mutex);
 #endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Platform API: libc stuff
+////////////////////////////////////////////////////////////////////////////////
+
+// NOTE: The "PLATFORM_PRINTF_DEBUG_*()" names are parenthesized so that they
+// are not expanded by the macros with the same name in "platform.h".
+
+void PLATFORM_PRINTF(const char *format, ...)
+{
+    va_list arglist;
+
+    va_start( arglist, format );
+    _logMessage(LOG_LEVEL_RAW, format, arglist);
+    va_end( arglist );
 
     return;
 }
 
-void PLATFORM_PRINTF_DEBUG_INFO(const char *format, ...)
+void PLATFORM_PRINTF_DEBUG_SET_VERBOSITY_LEVEL(int level)
+{
+    platform_verbosity_level = level;
+}
+
+void (PLATFORM_PRINTF_DEBUG_ERROR)(const char *format, ...)
 {
     va_list arglist;
-    uint32_t ts;
 
-    if (verbosity_level < 2)
+    if (!PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_ERROR))
     {
         return;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
+    va_start( arglist, format );
+    _logMessage(PLATFORM_DEBUG_LEVEL_ERROR, format, arglist);
+    va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
+    return;
+}
+
+void (PLATFORM_PRINTF_DEBUG_WARNING)(const char *format, ...)
+{
+    va_list arglist;
+
+    if (!PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_WARNING))
+    {
+        return;
+    }
 
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("INFO    : ");
     va_start( arglist, format );
-    vprintf( format, arglist );
+    _logMessage(PLATFORM_DEBUG_LEVEL_WARNING, format, arglist);
     va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
-
     return;
 }
 
-void PLATFORM_PRINTF_DEBUG_DETAIL(const char *format, ...)
+void (PLATFORM_PRINTF_DEBUG_INFO)(const char *format, ...)
 {
     va_list arglist;
-    uint32_t ts;
 
-    if (verbosity_level < 3)
+    if (!PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_INFO))
     {
         return;
     }
 
-    ts = PLATFORM_GET_TIMESTAMP();
+    va_start( arglist, format );
+    _logMessage(PLATFORM_DEBUG_LEVEL_INFO, format, arglist);
+    va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_lock(&printf_mutex);
-#endif
+    return;
+}
+
+void (PLATFORM_PRINTF_DEBUG_DETAIL)(const char *format, ...)
+{
+    va_list arglist;
+
+    if (!PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+    {
+        return;
+    }
 
-    printf("[%03d.%03d] ", ts/1000, ts%1000);
-    printf("DETAIL  : ");
     va_start( arglist, format );
-    vprintf( format, arglist );
+    _logMessage(PLATFORM_DEBUG_LEVEL_DETAIL, format, arglist);
     va_end( arglist );
 
-#ifndef _FLAVOUR_X86_WINDOWS_MINGW_
-    pthread_mutex_unlock(&printf_mutex);
-#endif
-
     return;
 }
 
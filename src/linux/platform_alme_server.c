@@ -60,11 +60,11 @@
 #include "platform_alme_server_priv.h"
 #include "../platform_os.h"
 #include "platform_os_priv.h"
+#include "platform_event_loop_priv.h"
 
 #include <arpa/inet.h>  // socket(), AF_INET, htons(), ...
 #include <errno.h>      // errno
-#include <pthread.h>    // threads and mutex functions
-#include <mqueue.h>     // mq_*() functions
+#include <fcntl.h>      // fcntl(), O_NONBLOCK
 #include <string.h>     // strerror()
 #include <stdio.h>      // snprintf(), ...
 #include <stdlib.h>     // free(), malloc(), ...
@@ -91,9 +91,15 @@
 // The ALME TCP server will then forward the data to the system queue that the
 // main 1905 thread uses to receive events.
 //
-// The following structure is passed to the thread in charge of running the TCP
-// server. It contains the "queue id" needed to be able to later forward all the
-// ALME messages from the TCP socket to the 1905 main thread.
+// Both the listening socket and the client socket are monitored by the event
+// loop. Only one client is served at a time: while a request is being received
+// (or the AL has not replied to it yet) no new connection is accepted.
+//
+// The client socket is non-blocking, so a slow HLE never stalls the loop: the
+// part of the reply that cannot be sent right away is kept until the socket
+// becomes writable. A client that makes no progress for
+// "ALME_CLIENT_TIMEOUT_MS" is dropped, so that it does not prevent others from
+// being served forever.
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -103,71 +109,299 @@
 #define ALME_CLIENT_ID_TCP_SOCKET                   0x1
 #define ALME_CLIENT_ID_1905_VENDOR_SPECIFIC_TUNNEL  0x2
 
-// These global variables and mutex are used to send information from the AL
-// main thread (the one running "start1905AL()") to the ALME TCP server thread
-//
-static pthread_mutex_t tcp_server_mutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_cond_t  tcp_server_cond  = PTHREAD_COND_INITIALIZER;
-static int             tcp_server_flag  = 0;
+#define ALME_TCP_SERVER_MAX_MESSAGE_SIZE (3*MAX_NETWORK_SEGMENT_SIZE)
 
-static uint8_t  *alme_response;
-static uint16_t  alme_response_len;
+#define ALME_CLIENT_TIMEOUT_MS 10000
 
 // This variable holds the number of the port number the server will use
 //
 static int alme_server_port = 0;
 
+// Queue where ALME requests are forwarded to
+//
+static uint8_t alme_server_queue_id;
+
+// Event loop source of the listening socket
+//
+static struct eventLoopSource *alme_server_source;
+
+// Socket of the client currently being served (or -1) and its event loop
+// source (NULL once the whole request has been received and we are only
+// waiting for the AL to reply)
+//
+static int                     alme_client_fd = -1;
+static struct eventLoopSource *alme_client_source;
+
+// Closes the current client when it has been idle for too long
+//
+static struct eventLoopTimer   alme_client_timer;
+
+// Part of the reply that could not be sent yet (NULL if none)
+//
+static uint8_t                *alme_reply;
+static uint16_t                alme_reply_len;
+
+// The first bytes of the message that is inserted into the AL queue every
+// time a new ALME message arrives look like this:
+//
+//    byte 0x00 - PLATFORM_QUEUE_EVENT_NEW_ALME_MESSAGE
+//    byte 0x01 - Message length MSB
+//    byte 0x02 - Message length LSB
+//    byte 0x03 - ALME client ID
+//    byte 0x04... ALME payload
+//
+// The request is received directly at offset 4 of this buffer.
+//
+static uint8_t  alme_queue_message[4+ALME_TCP_SERVER_MAX_MESSAGE_SIZE];
+static uint32_t alme_total_size;
+
+// Stop serving the current client and start accepting new ones again
+//
+static void _almeClientClose(void)
+{
+    eventLoopRemove(alme_client_source);
+    alme_client_source = NULL;
+
+    eventLoopTimerStop(&alme_client_timer);
+
+    free(alme_reply);
+    alme_reply     = NULL;
+    alme_reply_len = 0;
+
+    if (-1 != alme_client_fd)
+    {
+        close(alme_client_fd);
+        alme_client_fd = -1;
+    }
+
+    eventLoopModifyFd(alme_server_source, EPOLLIN);
+}
+
+static void _almeClientTimeoutCallback(void *data)
+{
+    (void) data;
+
+    PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server* Client idle for too long. Closing connection.\n");
+    _almeClientClose();
+}
+
+// Send as much of 'buf' as possible without blocking.
+//
+// Return the number of bytes sent or "-1" if the connection is broken.
+//
+static ssize_t _almeClientWrite(const uint8_t *buf, uint16_t len)
+{
+    uint16_t total_sent = 0;
+
+    while (total_sent < len)
+    {
+        ssize_t sent;
+
+        sent = send(alme_client_fd, buf + total_sent, len - total_sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (-1 == sent)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            if (EAGAIN == errno || EWOULDBLOCK == errno)
+            {
+                break;
+            }
+            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* send() failed with errno=%d (%s)\n", errno, strerror(errno));
+            return -1;
+        }
+
+        total_sent += sent;
+    }
+
+    return total_sent;
+}
+
+static void _almeClientWriteCallback(int fd, uint32_t events, void *data)
+{
+    ssize_t sent;
+
+    (void) fd;
+    (void) events;
+    (void) data;
+
+    sent = _almeClientWrite(alme_reply, alme_reply_len);
+    if (-1 == sent || sent == alme_reply_len)
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* ALME reply %s\n", -1 == sent ? "not sent" : "sent");
+        _almeClientClose();
+        return;
+    }
+
+    if (sent > 0)
+    {
+        memmove(alme_reply, alme_reply + sent, alme_reply_len - sent);
+        alme_reply_len -= sent;
+        eventLoopTimerStart(&alme_client_timer, ALME_CLIENT_TIMEOUT_MS, 0);
+    }
+}
+
+static void _almeClientReadCallback(int fd, uint32_t events, void *data)
+{
+    ssize_t read_size;
+
+    (void) events;
+    (void) data;
+
+    read_size = recv(fd, alme_queue_message + 4 + alme_total_size, ALME_TCP_SERVER_MAX_MESSAGE_SIZE - alme_total_size, MSG_DONTWAIT);
+
+    if (read_size > 0)
+    {
+        // Keep reading until the client closes the connection
+        //
+        alme_total_size += read_size;
+        eventLoopTimerStart(&alme_client_timer, ALME_CLIENT_TIMEOUT_MS, 0);
+
+        if (alme_total_size >= ALME_TCP_SERVER_MAX_MESSAGE_SIZE)
+        {
+            // This message is too big. If this is not an error from the
+            // client, then "ALME_TCP_SERVER_MAX_MESSAGE_SIZE" needs to be
+            // increased.
+            //
+            PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server* Received message is too big.\n");
+            _almeClientClose();
+        }
+    }
+    else if (0 == read_size)
+    {
+        // Connection closed, forward ALME message to the AL entity
+        //
+        uint16_t  message_len = alme_total_size + 1;
+        uint8_t   message_len_msb;
+        uint8_t   message_len_lsb;
+
+#if _HOST_IS_LITTLE_ENDIAN_ == 1
+        message_len_msb = *(((uint8_t *)&message_len)+1);
+        message_len_lsb = *(((uint8_t *)&message_len)+0);
+#else
+        message_len_msb = *(((uint8_t *)&message_len)+0);
+        message_len_lsb = *(((uint8_t *)&message_len)+1);
+#endif
+
+        alme_queue_message[0] = PLATFORM_QUEUE_EVENT_NEW_ALME_MESSAGE;
+        alme_queue_message[1] = message_len_msb;
+        alme_queue_message[2] = message_len_lsb;
+        alme_queue_message[3] = ALME_CLIENT_ID_TCP_SOCKET;
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* Sending %d bytes to queue (%02x, %02x, %02x, ...)\n", 3+message_len, alme_queue_message[0], alme_queue_message[1], alme_queue_message[2]);
+
+        if (0 == sendMessageToAlQueue(alme_server_queue_id, alme_queue_message, 3+message_len))
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server* Error sending message to queue from _almeClientReadCallback()\n");
+            _almeClientClose();
+            return;
+        }
+
+        // Nothing else to read: the socket is kept open (but not monitored)
+        // until "PLATFORM_SEND_ALME_REPLY()" is called (or the client timer
+        // expires, if the AL never replies).
+        //
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* Waiting for the AL response...\n");
+        eventLoopRemove(alme_client_source);
+        alme_client_source = NULL;
+    }
+    else if (EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server* recv() failed.\n");
+        _almeClientClose();
+    }
+}
+
+static void _almeServerAcceptCallback(int fd, uint32_t events, void *data)
+{
+    struct sockaddr_in client_addr;
+    socklen_t          addrlen;
+
+    (void) events;
+    (void) data;
+
+    memset(&client_addr, 0, sizeof(client_addr));
+    addrlen = sizeof(client_addr);
+
+    // Accept an incoming connection
+    //
+    alme_client_fd = accept(fd, (struct sockaddr *)&client_addr, &addrlen);
+    if (alme_client_fd < 0)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server* accept() failed with errno=%d (%s)\n", errno, strerror(errno));
+        alme_client_fd = -1;
+        return;
+    }
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* New connection established from HLE.\n");
+
+    // Sockets returned by "accept()" don't inherit O_NONBLOCK
+    //
+    if (-1 == fcntl(alme_client_fd, F_SETFL, fcntl(alme_client_fd, F_GETFL) | O_NONBLOCK))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server* fcntl() failed with errno=%d (%s)\n", errno, strerror(errno));
+        close(alme_client_fd);
+        alme_client_fd = -1;
+        return;
+    }
+
+    alme_total_size    = 0;
+    alme_client_source = eventLoopAddFd(alme_client_fd, EPOLLIN, _almeClientReadCallback, NULL);
+    if (NULL == alme_client_source)
+    {
+        close(alme_client_fd);
+        alme_client_fd = -1;
+        return;
+    }
+
+    // Don't accept more connections until this one has been served (or has
+    // timed out)
+    //
+    eventLoopModifyFd(alme_server_source, 0);
+    eventLoopTimerStart(&alme_client_timer, ALME_CLIENT_TIMEOUT_MS, 0);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Internal API: to be used by other platform-specific files (functions
 // declaration is found in "./platform_alme_server_priv.h")
 ////////////////////////////////////////////////////////////////////////////////
 
-void *almeServerThread(void *p)
+uint8_t almeServerStart(uint8_t queue_id)
 {
     int socketfd;
 
     struct sockaddr_in server_addr;
 
-    #define ALME_TCP_SERVER_MAX_MESSAGE_SIZE (3*MAX_NETWORK_SEGMENT_SIZE)
-    uint8_t  queue_message[4+ALME_TCP_SERVER_MAX_MESSAGE_SIZE];
-    uint8_t *alme_message;
+    alme_server_queue_id = queue_id;
 
-    // The first three bytes of the message that this thread is going to insert
-    // into the AL queue every time a new ALME message arrives looks like this:
-    //
-    //    byte 0x00 - PLATFORM_QUEUE_EVENT_NEW_ALME_MESSAGE
-    //    byte 0x01 - Message length MSB
-    //    byte 0x02 - Message length LSB
-    //    byte 0x03 - ALME client ID
-    //    byte 0x04... ALME payload
-    //
-    // Thus, the actual ALME payload starts at byte #5
-    //
-    alme_message = &queue_message[4];
+    eventLoopTimerInit(&alme_client_timer, _almeClientTimeoutCallback, NULL);
 
     // Create socket and configure it with "SO_REUSEADDR" (this is needed so
     // that every time we exit the program we don't have to wait for the OS to
     // "destroy" server sockets -up to 2 minutes- before restarting it again)
     //
-    socketfd = socket(AF_INET, SOCK_STREAM, 0);
+    socketfd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (-1 == socketfd)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server thread* socket() failed with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server* socket() failed with errno=%d (%s)\n", errno, strerror(errno));
+        return 0;
     }
     if (setsockopt(socketfd, SOL_SOCKET, SO_REUSEADDR, &(int){ 1 }, sizeof(int)) < 0)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server thread* setsockopt() failed with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server* setsockopt() failed with errno=%d (%s)\n", errno, strerror(errno));
+        close(socketfd);
+        return 0;
     }
 
     // Prepare the sockaddr_in structure
     //
     if (0 == alme_server_port)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server thread* server port has not been set!\n");
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server* server port has not been set!\n");
+        close(socketfd);
+        return 0;
     }
     memset(&server_addr, 0, sizeof(server_addr));
     server_addr.sin_family      = AF_INET;
@@ -178,151 +412,32 @@ void *almeServerThread(void *p)
     //
     if(bind(socketfd,(struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server thread* bind() failed\n");
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server* bind() failed\n");
+        close(socketfd);
+        return 0;
     }
 
     // Listen
     //
     if (-1 == listen(socketfd, 3))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server thread* listen() failed with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server* listen() failed with errno=%d (%s)\n", errno, strerror(errno));
+        close(socketfd);
+        return 0;
     }
 
-    // Accept connections from an incoming clients
+    // Accept connections from incoming clients from the event loop
     //
-    while (1)
+    alme_server_source = eventLoopAddFd(socketfd, EPOLLIN, _almeServerAcceptCallback, NULL);
+    if (NULL == alme_server_source)
     {
-        struct sockaddr_in client_addr;
-        int addrlen;
-
-        int new_socketfd;
-        int read_size;
-        int total_size;
-
-        memset(&client_addr, 0, sizeof(client_addr));
-        addrlen = sizeof(client_addr);
-
-        // Accept an incoming connection
-        //
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server thread* Waiting for incoming connections...\n");
-
-        new_socketfd = accept(socketfd, (struct sockaddr *)&client_addr, (socklen_t*)&addrlen);
-        if (new_socketfd < 0)
-        {
-            PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server thread* accept() failed with errno=%d (%s)\n", errno, strerror(errno));
-            continue;
-        }
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server thread* New connection established from HLE.\n");
-
-        // Receive a message from client
-        //
-        total_size = 0;
-        while( (read_size = recv(new_socketfd, alme_message + total_size, ALME_TCP_SERVER_MAX_MESSAGE_SIZE - total_size, 0)) > 0 )
-        {
-            // Keep reading until the client closes the connection
-            //
-            total_size += read_size;
-
-            if (total_size >= ALME_TCP_SERVER_MAX_MESSAGE_SIZE)
-            {
-                // This message is too big. If this is not an error from the
-                // client, then "ALME_TCP_SERVER_MAX_MESSAGE_SIZE" needs to be
-                // increased.
-                //
-                PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server thread* Received message is too big.\n");
-
-                read_size = -1;
-                break;
-            }
-        }
-
-        if(0 == read_size)
-        {
-            // Connection closed, forward ALME message to the AL entity
-            //
-            uint16_t  message_len = total_size + 1;
-            uint8_t   message_len_msb;
-            uint8_t   message_len_lsb;
-
-#if _HOST_IS_LITTLE_ENDIAN_ == 1
-            message_len_msb = *(((uint8_t *)&message_len)+1);
-            message_len_lsb = *(((uint8_t *)&message_len)+0);
-#else
-            message_len_msb = *(((uint8_t *)&message_len)+0);
-            message_len_lsb = *(((uint8_t *)&message_len)+1);
-#endif
-
-            queue_message[0] = PLATFORM_QUEUE_EVENT_NEW_ALME_MESSAGE;
-            queue_message[1] = message_len_msb;
-            queue_message[2] = message_len_lsb;
-            queue_message[3] = ALME_CLIENT_ID_TCP_SOCKET;
-
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server thread* Sending %d bytes to queue (%02x, %02x, %02x, ...)\n", 3+message_len, queue_message[0], queue_message[1], queue_message[2]);
-
-            pthread_mutex_lock(&tcp_server_mutex);
-            tcp_server_flag = 0;
-            pthread_mutex_unlock(&tcp_server_mutex);
-
-            if (0 == sendMessageToAlQueue(((struct almeServerThreadData *)p)->queue_id, queue_message, 3+message_len))
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server thread* Error sending message to queue from _alme_server_thread()\n");
-            }
-            else
-            {
-                uint32_t total_sent;
-
-                // Wait for response
-                //
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server thread* Waiting for the AL response...\n");
-
-                pthread_mutex_lock(&tcp_server_mutex);
-                while (0 == tcp_server_flag)
-                {
-                    pthread_cond_wait(&tcp_server_cond, &tcp_server_mutex);
-                }
-                pthread_mutex_unlock(&tcp_server_mutex);
-
-                // Once the mutex is unlocked it means the ALME response is
-                // contained in global var "alme_response" (which is
-                // "alme_response_len" bytes long)
-                //
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server thread* Sending ALME reply to HLE...\n");
-
-                total_sent = 0;
-                if (NULL != alme_response && 0 != alme_response_len)
-                {
-                    do
-                    {
-                        ssize_t sent;
-
-                        sent = send(new_socketfd, alme_response, alme_response_len, MSG_NOSIGNAL);
-
-                        if (-1 == sent)
-                        {
-                            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server thread* send() failed with errno=%d (%s)\n", errno, strerror(errno));
-                            break;
-                        }
-
-                        total_sent += sent;
-                    } while (total_sent < alme_response_len);
-
-                    free(alme_response);
-                    alme_response     = NULL;
-                    alme_response_len = 0;
-                }
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server thread* ALME reply sent (total %d bytes)\n", total_sent);
-            }
-            close(new_socketfd);
-        }
-        else if(-1 == read_size)
-        {
-            PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *ALME server thread* recv() failed.\n");
-        }
+        close(socketfd);
+        return 0;
     }
 
-    return NULL;
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* Waiting for incoming connections...\n");
+
+    return 1;
 }
 
 void almeServerPortSet(int port_number)
@@ -381,33 +496,50 @@ uint8_t PLATFORM_SEND_ALME_REPLY(uint8_t alme_client_id, uint8_t *alme_message,
             // Send the ALME RESPONSE/CONFIRMATION through the same socket where
             // the REQUEST was originally received
             //
+            if (-1 == alme_client_fd)
+            {
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] No HLE is waiting for an ALME reply\n");
+                break;
+            }
+
             if (0 == alme_message_len || NULL == alme_message)
             {
                 PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Refuse to send an *invalid* ALME reply\n");
-                alme_response     = NULL;
-                alme_response_len = 0;
             }
             else
             {
-                alme_response = (uint8_t *)malloc(alme_message_len);
-                if (NULL == alme_response)
-                {
-                    PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Cannot allocate memory for the ALME RESPONSE/CONFIRMATION message\n");
+                ssize_t sent;
 
-                    alme_response     = NULL;
-                    alme_response_len = 0;
+                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* Sending ALME reply to HLE...\n");
+
+                sent = _almeClientWrite(alme_message, alme_message_len);
+
+                if (sent >= 0 && sent < alme_message_len)
+                {
+                    // The HLE is not reading fast enough. Keep the rest of
+                    // the reply and send it from the event loop.
+                    //
+                    alme_reply_len = alme_message_len - sent;
+                    alme_reply     = malloc(alme_reply_len);
+                    if (NULL != alme_reply)
+                    {
+                        memcpy(alme_reply, alme_message + sent, alme_reply_len);
+                        alme_client_source = eventLoopAddFd(alme_client_fd, EPOLLOUT, _almeClientWriteCallback, NULL);
+                    }
+                    if (NULL != alme_client_source)
+                    {
+                        eventLoopTimerStart(&alme_client_timer, ALME_CLIENT_TIMEOUT_MS, 0);
+                        break;
+                    }
+                    PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *ALME server* Could not queue the rest of the ALME reply\n");
                 }
-                else
+                else if (sent >= 0)
                 {
-                    memcpy(alme_response, alme_message, alme_message_len);
-                    alme_response_len = alme_message_len;
+                    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *ALME server* ALME reply sent (total %d bytes)\n", (int)sent);
                 }
             }
 
-            pthread_mutex_lock(&tcp_server_mutex);
-            tcp_server_flag = 1;
-            pthread_cond_signal(&tcp_server_cond);
-            pthread_mutex_unlock(&tcp_server_mutex);
+            _almeClientClose();
 
             break;
         }
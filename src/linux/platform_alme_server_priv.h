@@ -61,24 +61,21 @@
 #include <platform.h>
 
 // When the AL calls "PLATFORM_REGISTER_QUEUE_EVENT()" with 'event_type' set to
-// "PLATFORM_QUEUE_EVENT_NEW_ALME_MESSAGE", a thread that runs the following
-// function must be started.
+// "PLATFORM_QUEUE_EVENT_NEW_ALME_MESSAGE", the following function must be
+// called.
 //
-// This will take care of receiving (in a platform-specific way) ALME messages
-// and then forward them to the queue whose ID is contained in the "struct
-// _almeServerThreadData" structure that is passed in the "void *p" argument.
+// It starts a TCP server (run from the event loop) that will take care of
+// receiving (in a platform-specific way) ALME messages and then forward them
+// to the queue whose ID is 'queue_id'.
 //
-struct almeServerThreadData
-{
-    uint8_t  queue_id;
-};
-
-void *almeServerThread(void *p);
+// Return "0" if there was a problem, "1" otherwise
+//
+uint8_t almeServerStart(uint8_t queue_id);
 
 
 // This function is used to set the port number where the ALME server will
 // listen to, waiting for ALME requests.
-// It must be called *before* starting the 'almeServerThread()' thread.
+// It must be called *before* calling 'almeServerStart()'.
 //
 void almeServerPortSet(int port_number);
 
@@ -0,0 +1,616 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#include <platform.h>
+#include "platform_event_loop_priv.h"
+
+#include <dlist.h>
+#include <utils.h>
+
+#include <errno.h>        // errno
+#include <string.h>       // strerror(), memset()
+#include <time.h>         // clock_gettime()
+#include <stdbool.h>      // bool
+#include <unistd.h>       // close(), read()
+#include <sys/epoll.h>    // epoll_*()
+#include <sys/timerfd.h>  // timerfd_*()
+
+////////////////////////////////////////////////////////////////////////////////
+// Private functions, structures and macros
+////////////////////////////////////////////////////////////////////////////////
+
+// Maximum number of events retrieved with a single call to "epoll_wait()"
+//
+#define EVENT_LOOP_MAX_EVENTS  (32)
+
+struct eventLoopSource
+{
+    dlist_item           l;        // Used to link removed sources in 'zombies'
+
+    int                  fd;
+    bool                 removed;  // Set by "eventLoopRemove()"
+
+    eventLoopFdCallback  cb;
+    void                *data;
+};
+
+static int epoll_fd = -1;
+
+// Sources removed while dispatching cannot be freed right away, because a
+// pointer to them may still be pending in the array returned by
+// "epoll_wait()". They are kept here until the dispatch round finishes.
+//
+static DEFINE_DLIST_HEAD(zombies);
+
+static bool _eventLoopInit(void)
+{
+    if (-1 != epoll_fd)
+    {
+        return true;
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (-1 == epoll_fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] epoll_create1() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+// *********** Timers **********************************************************
+//
+// Timers live in a hierarchical timing wheel:
+//
+//   - Time is measured in ticks of "TIMER_TICK_MS" milliseconds.
+//
+//   - Level 0 has one slot per tick for the next "TIMER_WHEEL_SLOTS" ticks.
+//     Each slot of level 1 covers "TIMER_WHEEL_SLOTS" ticks, each slot of
+//     level 2 "TIMER_WHEEL_SLOTS" times more, and so on.
+//
+//   - A timer is linked to the slot of the lowest level whose range covers its
+//     expiration time, so starting and stopping it is O(1).
+//
+//   - Every time the index of a level wraps around, the next slot of the level
+//     above is emptied and its timers are moved ("cascaded") down, closer to
+//     their final level 0 slot.
+//
+// A single timerfd is armed (with an absolute time) for the next tick in which
+// there is something to do: either a level 0 slot with timers or a cascade of
+// a non-empty upper level slot.
+
+#define TIMER_TICK_MS        (10)
+#define TIMER_WHEEL_BITS     (6)
+#define TIMER_WHEEL_SLOTS    (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK     (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS   (4)     // Range: 2^24 ticks (~46 hours)
+#define TIMER_WHEEL_RANGE    (1ULL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+static struct
+{
+    int                     fd;        // The timerfd (-1 until first used)
+    struct eventLoopSource *source;
+
+    uint64_t                current;   // Next tick to be processed
+    uint64_t                armed;     // Tick 'fd' is armed for ("0" if none)
+    unsigned                running;   // Number of timers in the wheel
+
+    uint64_t                occupied[TIMER_WHEEL_LEVELS];  // Non-empty slots
+    dlist_head              slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+} wheel = { .fd = -1 };
+
+static uint64_t _timerNowMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Link 'timer' to the wheel slot that corresponds to its expiration time
+//
+static void _timerWheelLink(struct eventLoopTimer *timer)
+{
+    uint64_t expires;
+    uint64_t delta;
+    unsigned level;
+
+    // Timers that should already have expired go to the next slot to be
+    // processed. Those beyond the wheel range are parked in the farthest slot
+    // and will be re-linked from there when it is cascaded.
+    //
+    expires = timer->expires < wheel.current ? wheel.current : timer->expires;
+    delta   = expires - wheel.current;
+    if (delta >= TIMER_WHEEL_RANGE)
+    {
+        delta   = TIMER_WHEEL_RANGE - 1;
+        expires = wheel.current + delta;
+    }
+
+    for (level = 0; level < TIMER_WHEEL_LEVELS - 1; level++)
+    {
+        if (delta < (1ULL << (TIMER_WHEEL_BITS * (level + 1))))
+        {
+            break;
+        }
+    }
+
+    timer->level = level;
+    timer->slot  = (expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+
+    dlist_add_tail(&wheel.slots[level][timer->slot], &timer->l);
+    wheel.occupied[level] |= 1ULL << timer->slot;
+    wheel.running++;
+}
+
+static void _timerWheelUnlink(struct eventLoopTimer *timer)
+{
+    dlist_remove(&timer->l);
+    if (dlist_empty(&wheel.slots[timer->level][timer->slot]))
+    {
+        wheel.occupied[timer->level] &= ~(1ULL << timer->slot);
+    }
+    wheel.running--;
+}
+
+// Move all the timers of a slot to 'list'. They are still accounted as
+// running (and can be stopped) until they are removed from 'list'.
+//
+static void _timerWheelTakeSlot(unsigned level, unsigned slot, dlist_head *list)
+{
+    dlist_item *item;
+
+    while (NULL != (item = dlist_get_first(&wheel.slots[level][slot])))
+    {
+        dlist_remove(item);
+        dlist_add_tail(list, item);
+    }
+    wheel.occupied[level] &= ~(1ULL << slot);
+}
+
+// Return the next tick in which there is something to do (see the comment at
+// the beginning of this section). There must be at least one running timer.
+//
+static uint64_t _timerWheelNext(void)
+{
+    uint64_t next = UINT64_MAX;
+    unsigned level;
+
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        unsigned shift = TIMER_WHEEL_BITS * level;
+        unsigned from;
+        uint64_t lap;
+        uint64_t candidates;
+        uint64_t tick;
+
+        if (0 == wheel.occupied[level])
+        {
+            continue;
+        }
+
+        // Level 0 slots expire when the wheel gets to them. Upper level slots
+        // are cascaded when the lower levels wrap around, so the one the wheel
+        // is currently in has already been processed in this lap... unless
+        // the wrap around is precisely the next tick to be processed.
+        //
+        from = (wheel.current >> shift) & TIMER_WHEEL_MASK;
+        if (0 != level && 0 != (wheel.current & ((1ULL << shift) - 1)))
+        {
+            from++;
+        }
+        lap  = (wheel.current >> (shift + TIMER_WHEEL_BITS)) << (shift + TIMER_WHEEL_BITS);
+
+        candidates = from < TIMER_WHEEL_SLOTS ? wheel.occupied[level] & (~0ULL << from) : 0;
+        if (0 != candidates)
+        {
+            tick = lap + ((uint64_t)__builtin_ctzll(candidates) << shift);
+        }
+        else
+        {
+            // Only slots of the next lap are used: wake up when it starts
+            //
+            tick = lap + (1ULL << (shift + TIMER_WHEEL_BITS));
+        }
+
+        if (tick < next)
+        {
+            next = tick;
+        }
+    }
+
+    return next;
+}
+
+// Arm the timerfd for the next tick in which there is something to do (or
+// disarm it if there are no timers).
+//
+static void _timerWheelArm(void)
+{
+    struct itimerspec its;
+    uint64_t          next;
+
+    next = 0 == wheel.running ? 0 : _timerWheelNext();
+    if (next == wheel.armed)
+    {
+        return;
+    }
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec  = (next * TIMER_TICK_MS) / 1000;
+    its.it_value.tv_nsec = ((next * TIMER_TICK_MS) % 1000) * 1000000;
+
+    if (-1 == timerfd_settime(wheel.fd, TFD_TIMER_ABSTIME, &its, NULL))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] timerfd_settime() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return;
+    }
+    wheel.armed = next;
+}
+
+// Process all ticks up to (and including) 'now', calling the callbacks of the
+// timers that expire
+//
+static void _timerWheelRun(uint64_t now)
+{
+    DEFINE_DLIST_HEAD(expired);
+
+    while (wheel.current <= now)
+    {
+        unsigned index = wheel.current & TIMER_WHEEL_MASK;
+        unsigned level;
+
+        if (0 == wheel.running)
+        {
+            wheel.current = now + 1;
+            break;
+        }
+
+        if (0 == index)
+        {
+            for (level = 1; level < TIMER_WHEEL_LEVELS; level++)
+            {
+                DEFINE_DLIST_HEAD(cascade);
+                unsigned          slot = (wheel.current >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+                dlist_item       *item;
+
+                _timerWheelTakeSlot(level, slot, &cascade);
+                while (NULL != (item = dlist_get_first(&cascade)))
+                {
+                    dlist_remove(item);
+                    wheel.running--;
+                    _timerWheelLink(container_of(item, struct eventLoopTimer, l));
+                }
+
+                if (0 != slot)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Advance before calling the callbacks, so that timers (re)started
+        // from them never end up in the slot being processed.
+        //
+        _timerWheelTakeSlot(0, index, &expired);
+        wheel.current++;
+
+        while (!dlist_empty(&expired))
+        {
+            struct eventLoopTimer *timer;
+
+            timer = container_of(dlist_get_first(&expired), struct eventLoopTimer, l);
+            dlist_remove(&timer->l);
+            wheel.running--;
+
+            if (0 != timer->period)
+            {
+                // Keep the original schedule, but don't try to catch up with
+                // missed periods.
+                //
+                timer->expires += timer->period;
+                _timerWheelLink(timer);
+            }
+
+            timer->cb(timer->data);
+        }
+
+        // Skip the ticks in which there is nothing to do, up to the next wrap
+        // of level 0 (where upper levels must be cascaded).
+        //
+        index = wheel.current & TIMER_WHEEL_MASK;
+        if (0 != index)
+        {
+            uint64_t later = wheel.occupied[0] >> index;
+            uint64_t skip  = 0 != later ? (uint64_t)__builtin_ctzll(later) : (uint64_t)(TIMER_WHEEL_SLOTS - index);
+
+            wheel.current = wheel.current + skip > now + 1 ? now + 1 : wheel.current + skip;
+        }
+    }
+}
+
+static void _timerWheelCallback(int fd, uint32_t events, void *data)
+{
+    uint64_t expirations;
+
+    (void) events;
+    (void) data;
+
+    // Consume the expiration count, or else the timerfd stays readable
+    //
+    if (-1 == read(fd, &expirations, sizeof(expirations)) && EAGAIN != errno)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] read(timerfd) returned with errno=%d (%s)\n", errno, strerror(errno));
+    }
+
+    wheel.armed = 0;
+    _timerWheelRun(_timerNowMs() / TIMER_TICK_MS);
+    _timerWheelArm();
+}
+
+static bool _timerWheelInit(void)
+{
+    unsigned level;
+    unsigned slot;
+
+    if (-1 != wheel.fd)
+    {
+        return true;
+    }
+
+    wheel.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (-1 == wheel.fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] timerfd_create() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return false;
+    }
+
+    wheel.source = eventLoopAddFd(wheel.fd, EPOLLIN, _timerWheelCallback, NULL);
+    if (NULL == wheel.source)
+    {
+        close(wheel.fd);
+        wheel.fd = -1;
+        return false;
+    }
+
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        for (slot = 0; slot < TIMER_WHEEL_SLOTS; slot++)
+        {
+            dlist_head_init(&wheel.slots[level][slot]);
+        }
+    }
+    wheel.current = _timerNowMs() / TIMER_TICK_MS;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal API: to be used by other platform-specific files (functions
+// declaration is found in "./platform_event_loop_priv.h")
+////////////////////////////////////////////////////////////////////////////////
+
+struct eventLoopSource *eventLoopAddFd(int fd, uint32_t events, eventLoopFdCallback cb, void *data)
+{
+    struct eventLoopSource *source;
+    struct epoll_event      ev;
+
+    if (!_eventLoopInit())
+    {
+        return NULL;
+    }
+
+    source       = zmemalloc(sizeof(*source));
+    source->fd   = fd;
+    source->cb   = cb;
+    source->data = data;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = events;
+    ev.data.ptr = source;
+
+    if (-1 == epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] epoll_ctl(ADD, %d) returned with errno=%d (%s)\n", fd, errno, strerror(errno));
+        free(source);
+        return NULL;
+    }
+
+    return source;
+}
+
+uint8_t eventLoopModifyFd(struct eventLoopSource *source, uint32_t events)
+{
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = events;
+    ev.data.ptr = source;
+
+    if (-1 == epoll_ctl(epoll_fd, EPOLL_CTL_MOD, source->fd, &ev))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] epoll_ctl(MOD, %d) returned with errno=%d (%s)\n", source->fd, errno, strerror(errno));
+        return 0;
+    }
+
+    return 1;
+}
+
+void eventLoopRemove(struct eventLoopSource *source)
+{
+    if (NULL == source || source->removed)
+    {
+        return;
+    }
+
+    if (-1 == epoll_ctl(epoll_fd, EPOLL_CTL_DEL, source->fd, NULL))
+    {
+        // This happens when the caller already closed the file descriptor. Not
+        // a problem: the kernel has already forgotten about it.
+        //
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] epoll_ctl(DEL, %d) returned with errno=%d (%s)\n", source->fd, errno, strerror(errno));
+    }
+
+    source->removed = true;
+    dlist_add_tail(&zombies, &source->l);
+}
+
+void eventLoopTimerInit(struct eventLoopTimer *timer, eventLoopTimerCallback cb, void *data)
+{
+    memset(timer, 0, sizeof(*timer));
+    dlist_head_init(&timer->l);
+    timer->cb   = cb;
+    timer->data = data;
+}
+
+uint8_t eventLoopTimerStart(struct eventLoopTimer *timer, uint32_t timeout_ms, uint32_t period_ms)
+{
+    uint64_t now_ms;
+
+    if (!_timerWheelInit())
+    {
+        return 0;
+    }
+
+    eventLoopTimerStop(timer);
+
+    // Round up, so that timers never expire early
+    //
+    now_ms = _timerNowMs();
+    if (0 == wheel.running && now_ms / TIMER_TICK_MS > wheel.current)
+    {
+        // Nothing to process in between: don't make "_timerWheelRun()" walk
+        // through all the ticks elapsed since the wheel was last used
+        //
+        wheel.current = now_ms / TIMER_TICK_MS;
+    }
+    timer->expires = (now_ms + timeout_ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    timer->period  = (period_ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    if (0 != period_ms && 0 == timer->period)
+    {
+        timer->period = 1;
+    }
+
+    _timerWheelLink(timer);
+    _timerWheelArm();
+
+    return 1;
+}
+
+void eventLoopTimerStop(struct eventLoopTimer *timer)
+{
+    if (eventLoopTimerIsRunning(timer))
+    {
+        _timerWheelUnlink(timer);
+
+        // The timerfd is left armed: if this was the next timer to expire, the
+        // event loop just wakes up for nothing once.
+    }
+}
+
+bool eventLoopTimerIsRunning(const struct eventLoopTimer *timer)
+{
+    return !dlist_empty(&timer->l);
+}
+
+int eventLoopRun(int timeout_ms)
+{
+    struct epoll_event      events[EVENT_LOOP_MAX_EVENTS];
+    struct eventLoopSource *source;
+    int                     nfds;
+    int                     i;
+
+    if (!_eventLoopInit())
+    {
+        return -1;
+    }
+
+    nfds = epoll_wait(epoll_fd, events, EVENT_LOOP_MAX_EVENTS, timeout_ms);
+    if (-1 == nfds)
+    {
+        if (EINTR == errno)
+        {
+            return 0;
+        }
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] epoll_wait() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return -1;
+    }
+
+    for (i = 0; i < nfds; i++)
+    {
+        source = (struct eventLoopSource *)events[i].data.ptr;
+
+        if (source->removed)
+        {
+            continue;
+        }
+
+        source->cb(source->fd, events[i].events, source->data);
+    }
+
+    while (!dlist_empty(&zombies))
+    {
+        source = container_of(dlist_get_first(&zombies), struct eventLoopSource, l);
+        dlist_remove(&source->l);
+        free(source);
+    }
+
+    return nfds;
+}
@@ -0,0 +1,170 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#ifndef _PLATFORM_EVENT_LOOP_PRIV_H_
+#define _PLATFORM_EVENT_LOOP_PRIV_H_
+
+#include <platform.h>
+#include <dlist.h>
+
+#include <stdbool.h>   // bool
+#include <sys/epoll.h> // EPOLLIN, EPOLLPRI, ...
+
+// The Linux platform runs all of its I/O (packet sockets, timers, inotify
+// watches, the ALME TCP server, ...) from a single epoll based event loop.
+//
+// Timers don't use a file descriptor of their own: all of them are kept in a
+// timing wheel driven by a single timerfd, so that starting or stopping one
+// is O(1) and thousands of them (eg. one per neighbor) can be running at the
+// same time.
+//
+// The loop is not a thread of its own: it is driven by the AL main thread
+// every time it calls "PLATFORM_READ_QUEUE()" and the queue is empty.
+// Callbacks are thus always executed in the context of the AL main thread and
+// must never block.
+//
+// None of these functions is thread safe: they must only be called from the
+// AL main thread (ie. from "PLATFORM_*()" functions or from event loop
+// callbacks). Other threads must use "sendMessageToAlQueue()" instead.
+
+struct eventLoopSource;
+
+// Callback executed when file descriptor 'fd' is ready. 'events' is a mask of
+// "EPOLL*" flags and 'data' is the pointer given at registration time.
+//
+typedef void (*eventLoopFdCallback)(int fd, uint32_t events, void *data);
+
+// Callback executed when a timer expires. 'data' is the pointer given at
+// registration time.
+//
+typedef void (*eventLoopTimerCallback)(void *data);
+
+// Start monitoring file descriptor 'fd' for 'events' (a mask of "EPOLL*"
+// flags). 'cb' will be called every time any of them is reported.
+//
+// The file descriptor is *not* owned by the event loop: it must be closed by
+// the caller *after* calling "eventLoopRemove()".
+//
+// Return NULL if there was a problem, the new event source otherwise.
+//
+struct eventLoopSource *eventLoopAddFd(int fd, uint32_t events, eventLoopFdCallback cb, void *data);
+
+// Change the set of events being monitored on a source previously returned by
+// "eventLoopAddFd()". Use "0" to temporarily stop monitoring it.
+//
+// Return "0" if there was a problem, "1" otherwise
+//
+uint8_t eventLoopModifyFd(struct eventLoopSource *source, uint32_t events);
+
+// Stop monitoring an event source. It is safe to call this function from any
+// callback, including the callback of 'source' itself.
+//
+void eventLoopRemove(struct eventLoopSource *source);
+
+// Timer to be embedded in the structure it refers to, so that starting it
+// never allocates memory. All fields are private to the event loop.
+//
+struct eventLoopTimer
+{
+    dlist_item              l;        // Link in a wheel slot, empty if stopped
+    uint64_t                expires;  // Expiration time (in wheel ticks)
+    uint32_t                period;   // In wheel ticks, "0" if one-shot
+    uint8_t                 level;    // Wheel slot 'l' is linked to
+    uint8_t                 slot;
+    eventLoopTimerCallback  cb;
+    void                   *data;
+};
+
+// Initialize a (stopped) timer that will call 'cb' with 'data' when it
+// expires. This must be done once before any of the functions below is used.
+//
+void eventLoopTimerInit(struct eventLoopTimer *timer, eventLoopTimerCallback cb, void *data);
+
+// Start a timer so that it expires 'timeout_ms' milliseconds from now and then
+// (if 'period_ms' is not "0") every 'period_ms' milliseconds. If the timer was
+// already running, it is restarted.
+//
+// Timers are never early, but they can be up to one wheel tick (a few
+// milliseconds) late.
+//
+// One-shot timers (ie. 'period_ms' == 0) are stopped before their callback is
+// called, so they can be restarted from it. Periodic timers run until
+// "eventLoopTimerStop()" is called. Both can be stopped (or even freed) from
+// any callback, including their own.
+//
+// Return "0" if there was a problem, "1" otherwise
+//
+uint8_t eventLoopTimerStart(struct eventLoopTimer *timer, uint32_t timeout_ms, uint32_t period_ms);
+
+// Stop a timer. Nothing is done if it is not running.
+//
+void eventLoopTimerStop(struct eventLoopTimer *timer);
+
+// Return "true" if the timer has been started and has not expired (or, if it
+// is periodic, has not been stopped) yet.
+//
+bool eventLoopTimerIsRunning(const struct eventLoopTimer *timer);
+
+// Wait (up to 'timeout_ms' milliseconds, or forever if it is "-1") for events
+// and dispatch them to their callbacks.
+//
+// Return "-1" if there was a problem, the number of dispatched events
+// otherwise.
+//
+int eventLoopRun(int timeout_ms);
+
+#endif
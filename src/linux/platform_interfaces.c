@@ -55,19 +55,23 @@
  *  DAMAGE.
  */
 
+#define _GNU_SOURCE           // sendmmsg()
+
 #include <platform.h>
 #include "../platform_interfaces.h"
 #include "platform_interfaces_priv.h"
 #include "../platform_os.h"
 #include "platform_os_priv.h"
+#include "netlink_funcs.h"
 
 #ifdef OPENWRT
 #include "platform_interfaces_openwrt_priv.h"
 #endif
 
 #include <datamodel.h>
+#include <dlist.h>
 
-#include <stdio.h>            // printf(), popen()
+#include <stdio.h>            // printf(), fopen()
 #include <stdlib.h>           // malloc(), ssize_t
 #include <stdarg.h>           // va_*
 #include <string.h>           // strdup()
@@ -81,6 +85,12 @@
 #include <netinet/ether.h>    // ETH_P_ALL, ETH_A_LEN
 #include <unistd.h>           // close()
 #include <pthread.h>          // pthread_create(), mutex functions
+#include <stdbool.h>          // bool
+#include <sys/socket.h>       // sendmmsg()
+#include <sys/uio.h>          // struct iovec
+#include <linux/netlink.h>    // sockaddr_nl, NLMSG_*
+#include <linux/rtnetlink.h>  // RTM_GETLINK, IFLA_*
+#include <linux/if_link.h>    // struct rtnl_link_stats64
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -103,6 +113,106 @@ static char **interfaces_list_extended_params  = NULL;
 //
 pthread_mutex_t interface_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// TX socket cache.
+//
+// Sending a frame needs an AF_PACKET socket and the index of the egress
+// interface. Instead of opening a socket and issuing a SIOCGIFINDEX ioctl()
+// for every single frame, one socket (bound to the interface) and its ifindex
+// are kept per interface name.
+//
+// Entries are created lazily the first time a frame is sent on an interface.
+// They are invalidated when the kernel reports that the interface is gone
+// (which also covers the case where the interface was re-created with a new
+// ifindex) or when someone calls "txSocketCacheInvalidate()".
+//
+// Interfaces that do not exist (yet) are also cached ('ifindex' == -1), so
+// that frames sent to them are dropped without any syscall. They are looked
+// up again after TX_SOCKET_CACHE_RETRY_MS milliseconds.
+//
+#define TX_SOCKET_CACHE_RETRY_MS  (1000)
+
+// Maximum number of frames sent with a single "sendmmsg()" call
+//
+#define TX_BATCH_MAX  (32)
+
+struct _txSocketCacheEntry
+{
+    dlist_item  l;
+
+    char        name[IFNAMSIZ];
+    int         ifindex;    // -1 if the interface does not exist
+    int         fd;         // -1 if the interface does not exist
+    uint32_t    retry_ts;   // When to look up a non-existing interface again
+};
+
+// Counters of the cache, printed every time a socket is opened and by
+// "PLATFORM_DUMP_TX_SOCKET_CACHE_STATS()"
+//
+struct _txSocketCacheStats
+{
+    uint32_t hits;          // Packets sent with an already open socket
+    uint32_t misses;        // Lookups that had to open a socket and query the
+                            // interface index
+    uint32_t invalidations; // Open sockets closed because the interface
+                            // disappeared or changed its index
+};
+
+static DEFINE_DLIST_HEAD(tx_socket_cache);
+static pthread_mutex_t            tx_socket_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct _txSocketCacheStats tx_socket_cache_stats;
+
+// Wi-Fi station statistics.
+//
+// The link metrics of Wi-Fi neighbors are read from a snapshot of the
+// statistics of all the stations of the local interface, obtained with a single
+// nl80211 dump. Snapshots are reused for WIFI_STATIONS_SNAPSHOT_MS
+// milliseconds, so that a link metrics query covering all the neighbors of an
+// interface only talks to the kernel once.
+//
+#define WIFI_STATIONS_SNAPSHOT_MS  (1000)
+
+struct _wifiStationsSnapshot
+{
+    dlist_item               l;
+
+    char                     name[IFNAMSIZ];
+    uint32_t                 timestamp;  // When the snapshot was taken
+    struct netlink_stations  stations;
+};
+
+static DEFINE_DLIST_HEAD(wifi_stations_snapshots);
+static pthread_mutex_t wifi_stations_snapshots_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Interface statistics.
+//
+// The packet counters of all the interfaces are obtained at once with a single
+// rtnetlink RTM_GETLINK dump (IFLA_STATS64 attribute) and kept in this cache,
+// which is considered fresh for 'interface_stats_max_age' milliseconds (see
+// "interfaceStatsSetMaxAge()").
+//
+#define INTERFACE_STATS_MAX_AGE_MS  (1000)
+#define INTERFACE_STATS_BUFFER_SIZE (32768)
+
+struct _interfaceStatsEntry
+{
+    char                     name[IFNAMSIZ];
+    struct rtnl_link_stats64 stats;
+};
+
+static struct
+{
+    int                          fd;         // rtnetlink socket, -1 if not open
+    uint32_t                     seq;        // Sequence number of the last dump
+    bool                         valid;      // 'timestamp' is meaningful
+    uint32_t                     timestamp;  // When the last dump was done
+    struct _interfaceStatsEntry *entries;
+    unsigned                     entries_nr;
+    unsigned                     entries_max;
+} interface_stats = { -1, 0, false, 0, NULL, 0, 0 };
+
+static uint32_t        interface_stats_max_age = INTERFACE_STATS_MAX_AGE_MS;
+static pthread_mutex_t interface_stats_mutex   = PTHREAD_MUTEX_INITIALIZER;
+
 // Special interfaces stubs.
 //
 // "Regular" interfaces will be handled using standard Linux procedures (for
@@ -494,76 +604,552 @@ static int32_t _readInterfaceParameter(char *interface_name, char *parameter_nam
     return ret;
 }
 
-// Returns an int32_t obtained by reading the output of
-// "iw dev $INTERFACE station get $MAC | grep $PARAMETER_NAME"
+// Parse one RTM_NEWLINK message of a dump and append the interface counters it
+// contains to the cache. Must be called with 'interface_stats_mutex' held.
 //
-static int32_t _readWifiNeighborParameter(char *interface_name, uint8_t *neighbor_interface_address, char *parameter_name)
+static void _interfaceStatsParseLink(const struct nlmsghdr *h)
 {
-    int32_t   ret;
-    FILE    *pipe;
-    char    *line;
-    size_t   len;
+    const struct ifinfomsg         *ifi = (const struct ifinfomsg *)NLMSG_DATA(h);
+    const struct rtattr            *rta;
+    int                             rta_len;
+    const char                     *name  = NULL;
+    const struct rtnl_link_stats64 *stats = NULL;
+    struct _interfaceStatsEntry    *e;
+
+    if (h->nlmsg_len < NLMSG_LENGTH(sizeof(*ifi)))
+    {
+        return;
+    }
 
-    char     command[200];
+    rta_len = IFLA_PAYLOAD(h);
+    for (rta = IFLA_RTA(ifi); RTA_OK(rta, rta_len); rta = RTA_NEXT(rta, rta_len))
+    {
+        switch (rta->rta_type)
+        {
+            case IFLA_IFNAME:
+                name = (const char *)RTA_DATA(rta);
+                break;
+            case IFLA_STATS64:
+                if (RTA_PAYLOAD(rta) >= sizeof(*stats))
+                {
+                    stats = (const struct rtnl_link_stats64 *)RTA_DATA(rta);
+                }
+                break;
+            default:
+                break;
+        }
+    }
 
-    ret = 0;
+    if (NULL == name || NULL == stats)
+    {
+        return;
+    }
 
-    if ((NULL == interface_name) || (NULL == neighbor_interface_address) || (NULL == parameter_name))
+    if (interface_stats.entries_nr == interface_stats.entries_max)
     {
-        return 0;
+        interface_stats.entries_max = interface_stats.entries_max ? 2 * interface_stats.entries_max : 8;
+        interface_stats.entries     = memrealloc(interface_stats.entries,
+                                                 interface_stats.entries_max * sizeof(*interface_stats.entries));
     }
+    e = &interface_stats.entries[interface_stats.entries_nr++];
 
-    sprintf(command, "iw dev %s station get %02x:%02x:%02x:%02x:%02x:%02x | grep %s",
-            interface_name,
-            neighbor_interface_address[0], neighbor_interface_address[1], neighbor_interface_address[2],
-            neighbor_interface_address[3], neighbor_interface_address[4], neighbor_interface_address[5],
-            parameter_name);
+    memset(e->name, 0, sizeof(e->name));
+    strncpy(e->name, name, sizeof(e->name) - 1);
+    memcpy(&e->stats, stats, sizeof(e->stats));
+}
 
-    // Execute the IW query command
-    //
-    pipe = popen(command, "r");
+// Replace the contents of the cache with the counters of all the interfaces,
+// obtained with a single RTM_GETLINK dump. Must be called with
+// 'interface_stats_mutex' held.
+//
+// Returns "0" if there was a problem (the cache is left empty), "1" otherwise.
+//
+static uint8_t _interfaceStatsRefresh(void)
+{
+    static uint8_t buffer[INTERFACE_STATS_BUFFER_SIZE] __attribute__((aligned(NLMSG_ALIGNTO)));
+
+    struct
+    {
+        struct nlmsghdr  h;
+        struct ifinfomsg ifi;
+    } req;
+
+    bool done = false;
+
+    interface_stats.entries_nr = 0;
+
+    if (-1 == interface_stats.fd)
+    {
+        interface_stats.fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+        if (-1 == interface_stats.fd)
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket(NETLINK_ROUTE) returned with errno=%d (%s)\n", errno, strerror(errno));
+            return 0;
+        }
+    }
+
+    memset(&req, 0, sizeof(req));
+    req.h.nlmsg_len    = NLMSG_LENGTH(sizeof(req.ifi));
+    req.h.nlmsg_type   = RTM_GETLINK;
+    req.h.nlmsg_flags  = NLM_F_REQUEST | NLM_F_DUMP;
+    req.h.nlmsg_seq    = ++interface_stats.seq;
+    req.ifi.ifi_family = AF_UNSPEC;
 
-    if (!pipe)
+    if (-1 == send(interface_stats.fd, &req, req.h.nlmsg_len, 0))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] popen() returned with errno=%d (%s)\n", errno, strerror(errno));
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] send(RTM_GETLINK) returned with errno=%d (%s)\n", errno, strerror(errno));
+        close(interface_stats.fd);
+        interface_stats.fd = -1;
         return 0;
     }
 
-    // Next read the parameter
-    //
-    line = NULL;
-    if (-1 != getline(&line, &len, pipe))
+    while (!done)
     {
-        char    *value;
+        const struct nlmsghdr *h;
+        ssize_t                len;
+
+        len = recv(interface_stats.fd, buffer, sizeof(buffer), 0);
+        if (len < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] recv(RTM_GETLINK) returned with errno=%d (%s)\n", errno, strerror(errno));
 
-        // Remove the last "\n"
+            // Whatever is left of this dump would be mistaken for the answer
+            // to the next one. Start again with a new socket.
+            //
+            close(interface_stats.fd);
+            interface_stats.fd         = -1;
+            interface_stats.entries_nr = 0;
+            return 0;
+        }
+
+        for (h = (const struct nlmsghdr *)buffer; NLMSG_OK(h, (size_t)len); h = NLMSG_NEXT(h, len))
+        {
+            if (h->nlmsg_seq != interface_stats.seq)
+            {
+                // Left over from a previous (failed) dump
+                //
+                continue;
+            }
+
+            if (NLMSG_DONE == h->nlmsg_type)
+            {
+                done = true;
+                break;
+            }
+            else if (NLMSG_ERROR == h->nlmsg_type)
+            {
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] RTM_GETLINK dump failed\n");
+                interface_stats.entries_nr = 0;
+                return 0;
+            }
+            else if (RTM_NEWLINK == h->nlmsg_type)
+            {
+                _interfaceStatsParseLink(h);
+            }
+        }
+    }
+
+    return 1;
+}
+
+// Copy into 'stats' the counters of 'interface_name' from the cache (refreshing
+// it first if it is older than 'interface_stats_max_age').
+//
+// Returns "0" if the interface was not found, "1" otherwise.
+//
+static uint8_t _readInterfaceStats(const char *interface_name, struct rtnl_link_stats64 *stats)
+{
+    unsigned i;
+    uint8_t  ret = 0;
+
+    pthread_mutex_lock(&interface_stats_mutex);
+
+    if (!interface_stats.valid || PLATFORM_GET_TIMESTAMP() - interface_stats.timestamp >= interface_stats_max_age)
+    {
+        _interfaceStatsRefresh();
+
+        // Even if the dump failed, do not try again until the cache expires
         //
-        line[strlen(line)-1] = 0x00;
+        interface_stats.timestamp = PLATFORM_GET_TIMESTAMP();
+        interface_stats.valid     = true;
+    }
+
+    for (i = 0; i < interface_stats.entries_nr; i++)
+    {
+        if (0 == strncmp(interface_stats.entries[i].name, interface_name, sizeof(interface_stats.entries[i].name)))
+        {
+            *stats = interface_stats.entries[i].stats;
+            ret = 1;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&interface_stats_mutex);
+
+    if (0 == ret)
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] No statistics found for interface %s\n", interface_name);
+    }
+
+    return ret;
+}
+
+// Copy into 'station' the statistics of the station whose MAC address is
+// 'neighbor_interface_address' from the latest snapshot of 'interface_name'
+// (taking a new one if it is too old).
+//
+// Returns "0" if the station was not found, "1" otherwise.
+//
+static uint8_t _readWifiNeighborStation(const char *interface_name, const uint8_t *neighbor_interface_address, struct netlink_station *station)
+{
+    struct _wifiStationsSnapshot *snapshot;
+    unsigned                      i;
+    uint8_t                       ret = 0;
+
+    pthread_mutex_lock(&wifi_stations_snapshots_mutex);
 
-        value = strstr(line, ":");
-        if ((NULL != value) && (1 == sscanf(value+1, "%d", &ret)))
+    dlist_for_each(snapshot, wifi_stations_snapshots, l)
+    {
+        if (0 == strncmp(snapshot->name, interface_name, sizeof(snapshot->name)))
         {
-             PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Neighbor %02x:%02x:%02x:%02x:%02x:%02x (%s) %s = %d\n",
-                 neighbor_interface_address[0], neighbor_interface_address[1], neighbor_interface_address[2],
-                 neighbor_interface_address[3], neighbor_interface_address[4], neighbor_interface_address[5],
-                 interface_name, parameter_name, ret);
+            break;
         }
-        else
+    }
+    if (NULL == snapshot)
+    {
+        snapshot = (struct _wifiStationsSnapshot *)zmemalloc(sizeof(*snapshot));
+        strncpy(snapshot->name, interface_name, sizeof(snapshot->name) - 1);
+        snapshot->timestamp = PLATFORM_GET_TIMESTAMP() - WIFI_STATIONS_SNAPSHOT_MS;
+        dlist_add_tail(&wifi_stations_snapshots, &snapshot->l);
+    }
+
+    if (PLATFORM_GET_TIMESTAMP() - snapshot->timestamp >= WIFI_STATIONS_SNAPSHOT_MS)
+    {
+        free(snapshot->stations.list);
+        if (netlink_get_stations(interface_name, &snapshot->stations) < 0)
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Could not get the list of stations of %s\n", interface_name);
+        }
+        snapshot->timestamp = PLATFORM_GET_TIMESTAMP();
+    }
+
+    for (i = 0; i < snapshot->stations.nr; i++)
+    {
+        if (0 == memcmp(snapshot->stations.list[i].mac, neighbor_interface_address, 6))
         {
-             PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Parameter not found\n");
+            *station = snapshot->stations.list[i];
+            ret = 1;
+            break;
         }
     }
 
-    free(line);
-    pclose(pipe);
+    pthread_mutex_unlock(&wifi_stations_snapshots_mutex);
+
+    if (0 == ret)
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Neighbor %02x:%02x:%02x:%02x:%02x:%02x not found in %s\n",
+                                     neighbor_interface_address[0], neighbor_interface_address[1], neighbor_interface_address[2],
+                                     neighbor_interface_address[3], neighbor_interface_address[4], neighbor_interface_address[5],
+                                     interface_name);
+    }
 
     return ret;
 }
 
+// (Re)open the TX socket of a cache entry and (re)read its ifindex.
+//
+// On failure the entry is left in the "interface does not exist" state. Must
+// be called with 'tx_socket_cache_mutex' held.
+//
+static void _txSocketCacheOpen(struct _txSocketCacheEntry *e)
+{
+    struct ifreq        ifr;
+    struct sockaddr_ll  socket_address;
+
+    tx_socket_cache_stats.misses++;
+
+    e->ifindex  = -1;
+    e->retry_ts = PLATFORM_GET_TIMESTAMP() + TX_SOCKET_CACHE_RETRY_MS;
+
+    // Protocol "0" means that this socket never receives anything: it is only
+    // used to transmit.
+    //
+    e->fd = socket(AF_PACKET, SOCK_RAW, 0);
+    if (-1 == e->fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s') returned with errno=%d (%s) while opening a RAW socket\n", e->name, errno, strerror(errno));
+        return;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, e->name, IFNAMSIZ - 1);
+    if (ioctl(e->fd, SIOCGIFINDEX, &ifr) == -1)
+    {
+        /* The "fake" interfaces may not exist, so this will fail. Don't print an error message, it is too verbose. */
+        close(e->fd);
+        e->fd = -1;
+        return;
+    }
+
+    memset(&socket_address, 0, sizeof(socket_address));
+    socket_address.sll_family  = AF_PACKET;
+    socket_address.sll_ifindex = ifr.ifr_ifindex;
+
+    if (-1 == bind(e->fd, (struct sockaddr *)&socket_address, sizeof(socket_address)))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] bind('%s') returned with errno=%d (%s) while opening a RAW socket\n", e->name, errno, strerror(errno));
+        close(e->fd);
+        e->fd = -1;
+        return;
+    }
+
+    e->ifindex = ifr.ifr_ifindex;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] TX socket cache: interface %s has index %d (hits=%u, misses=%u, invalidations=%u)\n",
+                                 e->name, e->ifindex, tx_socket_cache_stats.hits, tx_socket_cache_stats.misses, tx_socket_cache_stats.invalidations);
+}
+
+// Close the TX socket of a cache entry. The next lookup will open it again.
+//
+// Must be called with 'tx_socket_cache_mutex' held.
+//
+static void _txSocketCacheClose(struct _txSocketCacheEntry *e)
+{
+    if (-1 != e->fd)
+    {
+        close(e->fd);
+        tx_socket_cache_stats.invalidations++;
+    }
+    e->fd       = -1;
+    e->ifindex  = -1;
+    e->retry_ts = PLATFORM_GET_TIMESTAMP();
+}
+
+// Return the TX socket cache entry associated to 'interface_name', creating
+// it if needed. The returned entry has 'fd' set to "-1" if the interface does
+// not exist.
+//
+// Must be called with 'tx_socket_cache_mutex' held.
+//
+static struct _txSocketCacheEntry *_txSocketCacheLookup(const char *interface_name)
+{
+    struct _txSocketCacheEntry *e;
+
+    dlist_for_each(e, tx_socket_cache, l)
+    {
+        if (0 == strncmp(e->name, interface_name, IFNAMSIZ))
+        {
+            break;
+        }
+    }
+
+    if (NULL == e)
+    {
+        e = (struct _txSocketCacheEntry *)zmemalloc(sizeof(struct _txSocketCacheEntry));
+        strncpy(e->name, interface_name, IFNAMSIZ - 1);
+        e->fd      = -1;
+        e->ifindex = -1;
+        dlist_add_tail(&tx_socket_cache, &e->l);
+
+        _txSocketCacheOpen(e);
+    }
+    else if (-1 != e->fd || (int32_t)(PLATFORM_GET_TIMESTAMP() - e->retry_ts) < 0)
+    {
+        tx_socket_cache_stats.hits++;
+    }
+    else
+    {
+        _txSocketCacheOpen(e);
+    }
+
+    return e;
+}
+
+// Print the contents of a RAW packet (used for debug purposes)
+//
+static void _printRawPacket(const struct rawPacket *p)
+{
+    int i, first_time;
+    char aux1[200];
+    char aux2[10];
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Preparing to send RAW packet:\n");
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Interface name = %s\n", p->interface_name);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - DST  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", p->dst_mac[0], p->dst_mac[1], p->dst_mac[2], p->dst_mac[3], p->dst_mac[4], p->dst_mac[5]);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - SRC  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", p->src_mac[0], p->src_mac[1], p->src_mac[2], p->src_mac[3], p->src_mac[4], p->src_mac[5]);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Ether type     = 0x%04x\n", p->eth_type);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload length = %d\n", p->payload_len);
+
+    aux1[0]    = 0x0;
+    aux2[0]    = 0x0;
+    first_time = 1;
+    for (i=0; i<p->payload_len; i++)
+    {
+        snprintf(aux2, 6, "0x%02x ", p->payload[i]);
+        strncat(aux1, aux2, 200-strlen(aux1)-1);
+
+        if (0 != i && 0 == (i+1)%8)
+        {
+            if (1 == first_time)
+            {
+                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
+                first_time = 0;
+            }
+            else
+            {
+                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
+            }
+            aux1[0] = 0x0;
+        }
+    }
+    if (1 == first_time)
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
+    }
+    else
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
+    }
+}
+
+// Send 'packets_nr' (at most TX_BATCH_MAX) frames through the cached socket
+// 'e' with as few "sendmmsg()" calls as possible. All of them must be sent on
+// the interface of 'e'.
+//
+// The ethernet header and the padding are gathered with the payload (which is
+// never copied) using one iovec each.
+//
+// Must be called with 'tx_socket_cache_mutex' held.
+//
+// Returns the number of frames that could not be sent.
+//
+static unsigned _sendRawPacketsBatch(struct _txSocketCacheEntry *e, const struct rawPacket *packets, unsigned packets_nr)
+{
+    // 60 is the minimum ethernet frame length
+    //
+    static const uint8_t padding[60];
+
+    struct ether_header  headers[TX_BATCH_MAX];
+    struct sockaddr_ll   addresses[TX_BATCH_MAX];
+    struct iovec         iov[TX_BATCH_MAX][3];
+    struct mmsghdr       msgs[TX_BATCH_MAX];
+
+    unsigned  i;
+    unsigned  sent     = 0;
+    unsigned  failed   = 0;
+    bool      retried  = false;
+
+    memset(msgs,      0, packets_nr * sizeof(msgs[0]));
+    memset(addresses, 0, packets_nr * sizeof(addresses[0]));
+
+    for (i = 0; i < packets_nr; i++)
+    {
+        const struct rawPacket *p = &packets[i];
+        size_t                  frame_len;
+
+        memcpy(headers[i].ether_dhost, p->dst_mac, ETH_ALEN);
+        memcpy(headers[i].ether_shost, p->src_mac, ETH_ALEN);
+        headers[i].ether_type = htons(p->eth_type);
+
+        iov[i][0].iov_base = &headers[i];
+        iov[i][0].iov_len  = sizeof(headers[i]);
+        iov[i][1].iov_base = (void *)p->payload;
+        iov[i][1].iov_len  = p->payload_len;
+        iov[i][2].iov_base = (void *)padding;
+        iov[i][2].iov_len  = 0;
+
+        frame_len = sizeof(headers[i]) + p->payload_len;
+        if (frame_len < sizeof(padding))
+        {
+            iov[i][2].iov_len = sizeof(padding) - frame_len;
+        }
+
+        addresses[i].sll_family = AF_PACKET;
+        addresses[i].sll_halen  = ETH_ALEN;
+        memcpy(addresses[i].sll_addr, p->dst_mac, ETH_ALEN);
+
+        msgs[i].msg_hdr.msg_name    = &addresses[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+        msgs[i].msg_hdr.msg_iov     = iov[i];
+        msgs[i].msg_hdr.msg_iovlen  = 0 == iov[i][2].iov_len ? 2 : 3;
+    }
+
+    while (sent < packets_nr)
+    {
+        int ret;
+
+        for (i = sent; i < packets_nr; i++)
+        {
+            addresses[i].sll_ifindex = e->ifindex;
+        }
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Sending %u frames to RAW socket (ifindex %d)\n", packets_nr - sent, e->ifindex);
+        ret = sendmmsg(e->fd, &msgs[sent], packets_nr - sent, 0);
+        if (ret > 0)
+        {
+            sent += ret;
+            continue;
+        }
+
+        if (-1 == ret && (ENXIO == errno || ENODEV == errno) && !retried)
+        {
+            // The interface disappeared (or was re-created with a different
+            // index): look it up again and retry once.
+            //
+            retried = true;
+            _txSocketCacheClose(e);
+            _txSocketCacheOpen(e);
+            if (-1 == e->fd)
+            {
+                /* The interface no longer exists. Drop the rest of the packets. */
+                break;
+            }
+            continue;
+        }
+
+        // The first pending frame could not be sent. Skip it and go on with
+        // the rest.
+        //
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] sendmmsg('%s') returned with errno=%d (%s)\n", e->name, errno, strerror(errno));
+        failed++;
+        sent++;
+    }
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Data sent!\n");
+
+    return failed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Internal API: to be used by other platform-specific files (functions
 // declaration is found in "./platform_interfaces_priv.h")
 ////////////////////////////////////////////////////////////////////////////////
+void txSocketCacheInvalidate(const char *interface_name)
+{
+    struct _txSocketCacheEntry *e;
+
+    pthread_mutex_lock(&tx_socket_cache_mutex);
+    dlist_for_each(e, tx_socket_cache, l)
+    {
+        if (NULL == interface_name || 0 == strncmp(e->name, interface_name, IFNAMSIZ))
+        {
+            _txSocketCacheClose(e);
+        }
+    }
+    pthread_mutex_unlock(&tx_socket_cache_mutex);
+}
+
+void interfaceStatsSetMaxAge(uint32_t max_age_ms)
+{
+    pthread_mutex_lock(&interface_stats_mutex);
+    interface_stats_max_age = max_age_ms;
+    pthread_mutex_unlock(&interface_stats_mutex);
+}
+
 uint8_t registerInterfaceStub(char *interface_type, uint8_t stub_type, void *f)
 {
     uint8_t                i;
@@ -680,6 +1266,25 @@ void free_LIST_OF_1905_INTERFACES(__attribute__((unused)) char **x, __attribute_
     return;
 }
 
+// Security state of a "regular" interface (i.e. one without stubs)
+//
+static uint8_t _interfaceIsSecured(struct interface *interface)
+{
+    if (interface->type == interface_type_ethernet)
+    {
+        return 1;
+    }
+    if (interface->type == interface_type_wifi)
+    {
+        struct interfaceWifi *interface_wifi = container_of(interface, struct interfaceWifi, i);
+        if (interface_wifi->bssInfo.auth_mode != auth_mode_open)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 struct interfaceInfo *PLATFORM_GET_1905_INTERFACE_INFO(const char *interface_name)
 {
     struct interfaceInfo *m;
@@ -752,18 +1357,7 @@ struct interfaceInfo *PLATFORM_GET_1905_INTERFACE_INFO(const char *interface_nam
     // Check extensions
     if (0 == _executeInterfaceStub(interface_name, STUB_TYPE_GET_INFO, m))
     {
-        if (interface->type == interface_type_ethernet)
-        {
-            m->is_secured = 1;
-        }
-        if (interface->type == interface_type_wifi)
-        {
-            struct interfaceWifi *interface_wifi = container_of(interface, struct interfaceWifi, i);
-            if (interface_wifi->bssInfo.auth_mode != auth_mode_open)
-            {
-                m->is_secured = 1;
-            }
-        }
+        m->is_secured = _interfaceIsSecured(interface);
     }
 
     PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   mac_address                 : %02x:%02x:%02x:%02x:%02x:%02x\n", m->mac_address[0], m->mac_address[1], m->mac_address[2], m->mac_address[3], m->mac_address[4], m->mac_address[5]);
@@ -1002,6 +1596,52 @@ void createLocalInterfaces(void)
     }
 }
 
+uint8_t PLATFORM_GET_1905_INTERFACE_STATE(const char *interface_name, uint8_t *mac_address, uint8_t *is_secured,
+                                          uint8_t *power_state)
+{
+    struct interface *interface;
+    uint8_t i;
+
+    for (i=0; i<interfaces_nr; i++)
+    {
+        if (0 == strcmp(interfaces_list[i], interface_name))
+        {
+            break;
+        }
+    }
+    if (i < interfaces_nr && NULL != interfaces_list_extended_params[i])
+    {
+        // "Special" interfaces get their state from a stub, which needs the
+        // full structure.
+        //
+        struct interfaceInfo *x;
+
+        x = PLATFORM_GET_1905_INTERFACE_INFO(interface_name);
+        if (NULL == x)
+        {
+            return 0;
+        }
+        memcpy(mac_address, x->mac_address, 6);
+        *is_secured  = x->is_secured;
+        *power_state = x->power_state;
+        free_1905_INTERFACE_INFO(x);
+
+        return 1;
+    }
+
+    interface = findLocalInterface(interface_name);
+    if (NULL == interface)
+    {
+        return 0;
+    }
+
+    memcpy(mac_address, interface->addr, 6);
+    *is_secured  = _interfaceIsSecured(interface);
+    *power_state = (uint8_t)interface->power_state;
+
+    return 1;
+}
+
 void free_1905_INTERFACE_INFO(struct interfaceInfo *x)
 {
     uint8_t i;
@@ -1134,27 +1774,29 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
         //
         if (strstr(local_interface_name, "wlan") != NULL)
         {
+            struct netlink_station station;
+
+            // All the statistics come from the nl80211 station information
+            // of 'neighbor_interface_address'. If it is not associated (any
+            // more), everything is reported as "0".
+            //
+            if (0 == _readWifiNeighborStation(local_interface_name, ret->neighbor_interface_address, &station))
+            {
+                memset(&station, 0, sizeof(station));
+            }
+
             // Obtain the amount of (correct and incorrect) packets transmitted
             // to 'neighbor_interface_address' in the last
             // 'ret->measures_window' seconds.
             //
-            // This is done by reading the response of the command
-            //
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep "tx packets"" and
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep "tx failed""
-            //
-            ret->tx_packet_ok     = (uint32_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx packets\"");
-            ret->tx_packet_errors = (uint32_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx failed\"");
+            ret->tx_packet_ok     = station.tx_packets;
+            ret->tx_packet_errors = station.tx_failed;
 
             // Obtain the estimated max MAC xput and PHY rate when transmitting
-            // data from "A" to "B".
-            //
-            // This is done by reading the response of the command
+            // data from "A" to "B" (the last TX bitrate).
             //
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep speed"
-            //
-            ret->tx_max_xput = (uint16_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx bitrate\"");
-            ret->tx_phy_rate = (uint16_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"tx bitrate\"");
+            ret->tx_max_xput = station.tx_bitrate;
+            ret->tx_phy_rate = station.tx_bitrate;
 
             // Obtain the estimated average percentage of time that the link is
             // available for transmission.
@@ -1167,15 +1809,11 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             // from 'neighbor_interface_address' in the last
             // 'ret->measures_window' seconds.
             //
-            // This is done by reading the response of the command
-            //
-            //   "iw dev $INTERFACE station get $NEIGHBOR_MAC | grep "rx packets""
-            //
-            //   TODO: rx errors can't be obtained from this console command.
-            //   Right now it's assigned a zero value. Investigate how to
-            //   obtain this value.
+            //   TODO: rx errors are not part of the nl80211 station
+            //   information. Right now it's assigned a zero value.
+            //   Investigate how to obtain this value.
             //
-            ret->rx_packet_ok     = (uint32_t)_readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"rx packets\"");
+            ret->rx_packet_ok     = station.rx_packets;
             ret->rx_packet_errors = 0;
 
 
@@ -1196,7 +1834,7 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             // Feel free to redefine this conversion formula. Maybe to a
             // logarithmical one.
             //
-            tmp = _readWifiNeighborParameter(local_interface_name, ret->neighbor_interface_address, "\"signal:\"");
+            tmp = station.signal;
 
             #define  SIGNAL_MAX  (-40)   // dBm
             #define  SIGNAL_MIN  (-70)
@@ -1216,6 +1854,8 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
         // Other interface types, probably ethernet
         else
         {
+            struct rtnl_link_stats64 stats;
+
             // Obtain the amount of (correct and incorrect) packets transmitted
             // to 'neighbor_interface_address' in the last
             // 'ret->measures_window' seconds.
@@ -1228,13 +1868,15 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             //   is connected to one single remote interface... however we
             //   better report this than nothing at all.
             //
-            // This is done by reading the contents of files
-            //
-            //   "/sys/class/net/<interface_name>/statistics/tx_packets" and
-            //   "/sys/class/net/<interface_name>/statistics/tx_errors"
+            // This is done by looking at the "tx_packets" and "tx_errors"
+            // counters of the interface (see "_readInterfaceStats()")
             //
-            ret->tx_packet_ok     = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/tx_packets");
-            ret->tx_packet_errors = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/tx_errors");
+            if (0 == _readInterfaceStats(local_interface_name, &stats))
+            {
+                memset(&stats, 0, sizeof(stats));
+            }
+            ret->tx_packet_ok     = (uint32_t)stats.tx_packets;
+            ret->tx_packet_errors = (uint32_t)stats.tx_errors;
 
             // Obtain the estimatid max MAC xput and PHY rate when transmitting
             // data from "A" to "B".
@@ -1250,7 +1892,7 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             // better way to do this?
             //
             ret->tx_max_xput = (uint16_t)_readInterfaceParameter(local_interface_name, "speed");
-            ret->tx_phy_rate = (uint16_t)_readInterfaceParameter(local_interface_name, "speed");
+            ret->tx_phy_rate = ret->tx_max_xput;
 
             // Obtain the estimated average percentage of time that the link is
             // available for transmission.
@@ -1270,13 +1912,11 @@ struct linkMetrics *PLATFORM_GET_LINK_METRICS(char *local_interface_name, uint8_
             //   connected to one single remote interface... however we better
             //   report this than nothing at all.
             //
-            // This is done by reading the contents of files
-            //
-            //   "/sys/class/net/<interface_name>/statistics/rx_packets" and
-            //   "/sys/class/net/<interface_name>/statistics/rx_errors"
+            // This is done by looking at the "rx_packets" and "rx_errors"
+            // counters of the interface (already obtained above)
             //
-            ret->rx_packet_ok     = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/rx_packets");
-            ret->rx_packet_errors = (uint32_t)_readInterfaceParameter(local_interface_name, "statistics/rx_errors");
+            ret->rx_packet_ok     = (uint32_t)stats.rx_packets;
+            ret->rx_packet_errors = (uint32_t)stats.rx_errors;
 
             // Obtain the estimated RX RSSI
             //
@@ -1324,139 +1964,78 @@ void free_LIST_OF_BRIDGES(struct bridge *x, uint8_t nr)
 uint8_t PLATFORM_SEND_RAW_PACKET(const char *interface_name, const uint8_t *dst_mac, const uint8_t *src_mac,
                                  uint16_t eth_type, const uint8_t *payload, uint16_t payload_len)
 {
-    int i, first_time;
-    char aux1[200];
-    char aux2[10];
+    struct rawPacket packet =
+    {
+        .interface_name = interface_name,
+        .dst_mac        = dst_mac,
+        .src_mac        = src_mac,
+        .eth_type       = eth_type,
+        .payload        = payload,
+        .payload_len    = payload_len,
+    };
+
+    return PLATFORM_SEND_RAW_PACKETS(&packet, 1);
+}
 
-    int                 s;
-    struct ifreq        ifr;
-    int                 ifindex;
-    struct sockaddr_ll  socket_address;
+uint8_t PLATFORM_SEND_RAW_PACKETS(const struct rawPacket *packets, unsigned packets_nr)
+{
+    struct _txSocketCacheEntry *e;
+    unsigned                    i, j;
+    uint8_t                     ret = 1;
 
-    uint8_t buffer[MAX_NETWORK_SEGMENT_SIZE];
-    struct ether_header *eh;
+    if (PLATFORM_PRINTF_DEBUG_ENABLED(PLATFORM_DEBUG_LEVEL_DETAIL))
+    {
+        for (i = 0; i < packets_nr; i++)
+        {
+            _printRawPacket(&packets[i]);
+        }
+    }
 
-    // Print packet (used for debug purposes)
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Preparing to send RAW packet:\n");
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Interface name = %s\n", interface_name);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - DST  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", dst_mac[0], dst_mac[1], dst_mac[2], dst_mac[3], dst_mac[4], dst_mac[5]);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - SRC  MAC       = 0x%02x:0x%02x:0x%02x:0x%02x:0x%02x:0x%02x\n", src_mac[0], src_mac[1], src_mac[2], src_mac[3], src_mac[4], src_mac[5]);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Ether type     = 0x%04x\n", eth_type);
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload length = %d\n", payload_len);
+    pthread_mutex_lock(&tx_socket_cache_mutex);
 
-    aux1[0]    = 0x0;
-    aux2[0]    = 0x0;
-    first_time = 1;
-    for (i=0; i<payload_len; i++)
+    for (i = 0; i < packets_nr; i = j)
     {
-        snprintf(aux2, 6, "0x%02x ", payload[i]);
-        strncat(aux1, aux2, 200-strlen(aux1)-1);
-
-        if (0 != i && 0 == (i+1)%8)
+        // Find the run of consecutive frames going out of the same interface
+        //
+        for (j = i + 1; j < packets_nr && j - i < TX_BATCH_MAX; j++)
         {
-            if (1 == first_time)
-            {
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
-                first_time = 0;
-            }
-            else
+            if (packets[j].interface_name != packets[i].interface_name &&
+                0 != strcmp(packets[j].interface_name, packets[i].interface_name))
             {
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
+                break;
             }
-            aux1[0] = 0x0;
         }
-    }
-    if (1 == first_time)
-    {
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]   - Payload        = %s\n", aux1);
-    }
-    else
-    {
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM]                      %s\n", aux1);
-    }
 
-    // Open RAW socket
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Opening RAW socket\n");
-    s = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
-    if (-1 == s)
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s') returned with errno=%d (%s) while opening a RAW socket\n", interface_name, errno, strerror(errno));
-        return 0;
-    }
+        // Retrieve the (cached) RAW socket and interface index
+        //
+        e = _txSocketCacheLookup(packets[i].interface_name);
+        if (-1 == e->fd)
+        {
+            /* The "fake" interfaces may not exist. Don't return an error; just drop the packets. */
+            continue;
+        }
 
-    // Retrieve ethernet interface index
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Retrieving interface index\n");
-    strncpy(ifr.ifr_name, interface_name, IFNAMSIZ);
-    if (ioctl(s, SIOCGIFINDEX, &ifr) == -1)
-    {
-        /* The "fake" interfaces may not exist, so this will fail. Don't print an error message, it is too verbose.
-           Also don't return an error; just drop the packet. */
-        // PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] ioctl('%s',SIOCGIFINDEX) returned with errno=%d (%s) while opening a RAW socket\n", interface_name, errno, strerror(errno));
-        close(s);
-        return 1;
+        if (0 != _sendRawPacketsBatch(e, &packets[i], j - i))
+        {
+            ret = 0;
+        }
     }
-    ifindex = ifr.ifr_ifindex;
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Successfully got interface index %d\n", ifindex);
 
-    // Empy buffer
-    //
-    memset(buffer, 0, MAX_NETWORK_SEGMENT_SIZE);
+    pthread_mutex_unlock(&tx_socket_cache_mutex);
 
-    // Fill ethernet header
-    //
-    eh                 = (struct ether_header *)buffer;
-    eh->ether_dhost[0] = dst_mac[0];
-    eh->ether_dhost[1] = dst_mac[1];
-    eh->ether_dhost[2] = dst_mac[2];
-    eh->ether_dhost[3] = dst_mac[3];
-    eh->ether_dhost[4] = dst_mac[4];
-    eh->ether_dhost[5] = dst_mac[5];
-    eh->ether_shost[0] = src_mac[0];
-    eh->ether_shost[1] = src_mac[1];
-    eh->ether_shost[2] = src_mac[2];
-    eh->ether_shost[3] = src_mac[3];
-    eh->ether_shost[4] = src_mac[4];
-    eh->ether_shost[5] = src_mac[5];
-    eh->ether_type     = htons(eth_type);
-
-    // Fill buffer
-    //
-    memcpy(buffer + sizeof(*eh), payload, payload_len);
+    return ret;
+}
 
-    // Prepare sockaddr_ll
-    //
-    memset(&socket_address, 0, sizeof(socket_address));
-    socket_address.sll_ifindex  = ifindex;
-    socket_address.sll_halen    = ETH_ALEN;
-    socket_address.sll_addr[0]  = dst_mac[0];
-    socket_address.sll_addr[1]  = dst_mac[1];
-    socket_address.sll_addr[2]  = dst_mac[2];
-    socket_address.sll_addr[3]  = dst_mac[3];
-    socket_address.sll_addr[4]  = dst_mac[4];
-    socket_address.sll_addr[5]  = dst_mac[5];
-    socket_address.sll_addr[6]  = 0x00;
-    socket_address.sll_addr[7]  = 0x00;
-
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Sending data to RAW socket\n");
-    if (-1 == sendto(s,
-                     buffer,
-                     sizeof(*eh) + payload_len >= 60 ? sizeof(*eh) + payload_len : 60, // 60 is the minimum ethernet frame length
-                     0,
-                     (struct sockaddr*)&socket_address,
-                     sizeof(socket_address))
-       )
-    {
-          PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] sendto('%s') returned with errno=%d (%s)\n", interface_name, errno, strerror(errno));
-          close(s);
-          return 0;
-    }
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Data sent!\n");
+void PLATFORM_DUMP_TX_SOCKET_CACHE_STATS(void (*write_function)(const char *fmt, ...))
+{
+    struct _txSocketCacheStats stats;
 
-    close(s);
-    return 1;
+    pthread_mutex_lock(&tx_socket_cache_mutex);
+    stats = tx_socket_cache_stats;
+    pthread_mutex_unlock(&tx_socket_cache_mutex);
+
+    write_function("  tx socket cache: hits %u, misses %u, invalidations %u\n",
+                   stats.hits, stats.misses, stats.invalidations);
 }
 
 uint8_t PLATFORM_START_PUSH_BUTTON_CONFIGURATION(char *interface_name, uint8_t queue_id, uint8_t *al_mac_address, uint16_t mid)
@@ -133,5 +133,22 @@ uint8_t registerInterfaceStub(char *interface_type, uint8_t stub_type, void *f);
 //
 void addInterface(char *long_interface_name);
 
+// Close the cached TX socket of 'interface_name' (or of all interfaces if
+// 'interface_name' is NULL) so that the next packet sent through it looks up
+// the interface index again.
+//
+// Call this whenever an interface is known to have been removed or re-created.
+//
+void txSocketCacheInvalidate(const char *interface_name);
+
+// Set for how long (in milliseconds) the interface packet counters used by
+// "PLATFORM_GET_LINK_METRICS()" are reused before asking the kernel again.
+// All the interfaces are refreshed at once, so this is also the maximum age of
+// the reported counters. "0" means "always ask the kernel".
+//
+// The default value is 1000 ms.
+//
+void interfaceStatsSetMaxAge(uint32_t max_age_ms);
+
 #endif
 
@@ -60,23 +60,36 @@
 #include "../platform_os.h"
 #include "platform_os_priv.h"
 #include "platform_alme_server_priv.h"
+#include "platform_interfaces_priv.h"
+#include "platform_event_loop_priv.h"
 #include <platform_linux.h>
 #include <utils.h>
+#include <dlist.h>
 #include <1905_l2.h>
 
 #include <stdlib.h>      // free(), malloc(), ...
 #include <stdio.h>       // fopen(), FILE, sprintf(), fwrite()
 #include <string.h>      // memcpy(), memcmp(), ...
-#include <pthread.h>     // threads and mutex functions
-#include <mqueue.h>      // mq_*() functions
+#include <stddef.h>      // offsetof()
+#include <pthread.h>     // mutex functions, pthread_self()
 #include <errno.h>       // errno
-#include <poll.h>        // poll()
+#include <limits.h>      // NAME_MAX
+#include <stdbool.h>     // bool
+#include <fcntl.h>       // open(), O_RDONLY
 #include <sys/inotify.h> // inotify_*()
-#include <unistd.h>      // read(), sleep()
-#include <signal.h>      // struct sigevent, SIGEV_*
+#include <sys/eventfd.h> // eventfd()
+#include <unistd.h>      // read(), write(), close()
 #include <sys/types.h>   // recv(), setsockopt()
 #include <sys/socket.h>  // recv(), setsockopt()
-#include <linux/if_packet.h> // packet_mreq
+#include <sys/mman.h>      // mmap(), munmap()
+#include <arpa/inet.h>    // htons()
+#include <linux/if_packet.h> // packet_mreq, tpacket_*
+#include <linux/filter.h>    // sock_filter, BPF_*
+#include <net/ethernet.h>    // ETH_P_ALL
+#include <net/if.h>          // IFF_UP, IFF_RUNNING
+#include <linux/if.h>        // IFF_LOWER_UP
+#include <linux/netlink.h>   // sockaddr_nl, NLMSG_*
+#include <linux/rtnetlink.h> // RTM_*, RTMGRP_*, ifinfomsg
 
 ////////////////////////////////////////////////////////////////////////////////
 // Private functions, structures and macros
@@ -84,50 +97,457 @@
 
 /** @brief Linux-specific per-interface data. */
 struct linux_interface_info {
+    /** @brief Membership of linux_interfaces. */
+    dlist_item l;
+
     struct interface *interface;
 
     /** @brief Index of the interface, to be used for sockaddr_ll::sll_ifindex. */
     int ifindex;
 
-    /** @brief File descriptor of the packet socket bound to the IEEE1905 protocol. */
+    /** @brief File descriptor of the packet socket bound to the IEEE1905 protocol.
+     *
+     * In RX ring mode, this is the only socket and it receives both IEEE1905 and LLDP frames.
+     */
     int sock_1905_fd;
 
-    /** @brief File descriptor of the packet socket bound to the LLDP protocol. */
+    /** @brief File descriptor of the packet socket bound to the LLDP protocol (-1 in RX ring mode). */
     int sock_lldp_fd;
 
+    /** @brief Memory mapped TPACKET_V3 RX ring of @a sock_1905_fd, or NULL if not in RX ring mode. */
+    uint8_t *ring;
+
+    /** @brief Index of the next RX ring block to be handed over by the kernel. */
+    unsigned ring_block;
+
+    /** @brief Event loop sources of @a sock_1905_fd and @a sock_lldp_fd. */
+    struct eventLoopSource *source_1905;
+    struct eventLoopSource *source_lldp;
+
+    /** @brief Timer to retry opening the interface. */
+    struct eventLoopTimer retry_timer;
+
     uint8_t     al_mac_address[6];
     uint8_t     queue_id;
 };
 
+/** @brief All the interfaces registered with PLATFORM_QUEUE_EVENT_NEW_1905_PACKET. */
+static DEFINE_DLIST_HEAD(linux_interfaces);
+
 // *********** IPC stuff *******************************************************
 
 // Queue related function in the PLATFORM API return queue IDs that are uint8_t
 // elements.
-// However, in POSIX all queue related functions deal with a 'mqd_t' type.
-// The following global arrays are used to store the association between a
-// "PLATFORM uint8_t ID" and a "POSIX mqd_t ID"
+//
+// Messages are stored in buffers taken from a pool that is preallocated when
+// the first queue is created, and queues themselves are bounded lock-free
+// rings that only carry pointers to those buffers ("descriptors"):
+//
+//   - Producers are the event loop callbacks (ie. the AL main thread itself)
+//     and, through "sendMessageToAlQueue()", other helper threads. Received
+//     frames are written only once, straight into a pool buffer, and the AL
+//     processes them in place (see "PLATFORM_READ_QUEUE_MESSAGE()").
+//
+//   - The only consumer of a queue is the thread that reads from it.
+//
+//   - Nobody ever blocks: if the pool is exhausted or the ring is full, the
+//     message is dropped and the queue drop counters are incremented (see
+//     "queueGetStats()"). Only received frames are dropped for lack of pool
+//     buffers; other (rare but important) events fall back to a heap buffer.
+//
+// Once the AL is done with a message (see "PLATFORM_RELEASE_QUEUE_MESSAGE()"),
+// its buffer goes back to the pool.
+//
+// Producers running in a thread other than the one running the event loop
+// wake it up through an eventfd so that a pending "PLATFORM_READ_QUEUE()" can
+// return the new message.
+
+#define MAX_QUEUE_IDS    256  // Number of values that fit in an uint8_t
+#define QUEUE_POOL_SIZE   64  // Message buffers shared by all queues
+#define QUEUE_RING_SIZE  128  // Descriptors per queue (must be a power of 2)
+
+// Size of the header that precedes the frame in a NEW_1905_PACKET message:
+// type (1 byte), length (2 bytes) and receiving interface
+//
+#define PACKET_MESSAGE_HEADER_LEN  (3 + sizeof(struct interface *))
+
+struct _queueBuffer
+{
+    bool        pooled;   // 'false' if allocated from the heap
+    uint16_t    len;
+    uint8_t     data[PACKET_MESSAGE_HEADER_LEN + MAX_NETWORK_SEGMENT_SIZE];
+                          // Large enough for any message, including a
+                          // full-size frame after its message header
+};
+
+// Maximum size of a frame received into a "struct _queueBuffer"
+//
+#define PACKET_MAX_LEN  (sizeof(((struct _queueBuffer *)NULL)->data) - PACKET_MESSAGE_HEADER_LEN)
+
+// Bounded multi-producer ring of pointers. Each slot carries a sequence number
+// that tells producers and consumers whether it is free or filled for the
+// current lap, so that no lock is needed (Vyukov's bounded queue).
+//
+struct _ringSlot
+{
+    uint32_t    seq;
+    void       *item;
+};
+
+struct _ring
+{
+    uint32_t          mask;
+    struct _ringSlot *slots;
+    uint32_t          head __attribute__((aligned(64)));  // Next slot to push
+    uint32_t          tail __attribute__((aligned(64)));  // Next slot to pop
+};
+
+struct _queue
+{
+    bool          used;
+    struct _ring  ring;
+
+    uint32_t      drops_ring_full;  // Accessed atomically
+    uint32_t      drops_no_buffer;  // Accessed atomically
+
+    // Running PLATFORM timers, indexed by token (allocated when the first one
+    // is registered). See "_timerHandler()".
+    //
+    dlist_head   *timers;
+};
+
+static struct _queue   queues[MAX_QUEUE_IDS];
+static pthread_mutex_t queues_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static struct _queueBuffer *queues_pool;       // QUEUE_POOL_SIZE buffers
+static struct _ring         queues_pool_free;  // Buffers not in use
+
+// eventfd used by other threads to wake up the event loop, and the thread that
+// runs the event loop (the one that called "PLATFORM_CREATE_QUEUE()")
+//
+static int       queues_wakeup_fd = -1;
+static pthread_t queues_loop_thread;
+
+static void _ringInit(struct _ring *r, uint32_t size)
+{
+    uint32_t i;
+
+    r->mask  = size - 1;
+    r->slots = (struct _ringSlot *)memalloc(size * sizeof(*r->slots));
+    for (i = 0; i < size; i++)
+    {
+        r->slots[i].seq  = i;
+        r->slots[i].item = NULL;
+    }
+    r->head = 0;
+    r->tail = 0;
+}
+
+// Return "false" if the ring is full
+//
+static bool _ringPush(struct _ring *r, void *item)
+{
+    struct _ringSlot *slot;
+    uint32_t          pos;
+
+    pos = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        int32_t diff;
+
+        slot = &r->slots[pos & r->mask];
+        diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (0 == diff)
+        {
+            // The slot is free for this lap: try to claim it
+            //
+            if (__atomic_compare_exchange_n(&r->head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The slot still holds an item from the previous lap
+            //
+            return false;
+        }
+        else
+        {
+            // Another producer claimed it first
+            //
+            pos = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->item = item;
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+// Return NULL if the ring is empty
+//
+static void *_ringPop(struct _ring *r)
+{
+    struct _ringSlot *slot;
+    uint32_t          pos;
+    void             *item;
+
+    pos = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        int32_t diff;
+
+        slot = &r->slots[pos & r->mask];
+        diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+        if (0 == diff)
+        {
+            if (__atomic_compare_exchange_n(&r->tail, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return NULL;
+        }
+        else
+        {
+            pos = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    item = slot->item;
+    __atomic_store_n(&slot->seq, pos + r->mask + 1, __ATOMIC_RELEASE);
+
+    return item;
+}
+
+static void _queueWakeupCallback(int fd, uint32_t events, void *data)
+{
+    uint64_t value;
+
+    (void) events;
+    (void) data;
+
+    // Just consume the counter. The new message(s) will be found by
+    // "PLATFORM_READ_QUEUE()" as soon as the event loop returns.
+    //
+    if (-1 == read(fd, &value, sizeof(value)) && EAGAIN != errno)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] read(eventfd) returned with errno=%d (%s)\n", errno, strerror(errno));
+    }
+}
+
+// Log a drop the 1st, 2nd, 4th, 8th, ... time it happens, so that a burst
+// does not flood the log.
+//
+static void _queueCountDrop(uint8_t queue_id, uint32_t *counter, const char *reason)
+{
+    uint32_t n;
+
+    n = __atomic_add_fetch(counter, 1, __ATOMIC_RELAXED);
+    if (0 == (n & (n - 1)))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Queue %d: message dropped (%s, %u times so far)\n", queue_id, reason, n);
+    }
+}
+
+// Get an empty buffer (with one reference) to build a queue message.
+//
+// If the pool is exhausted, a buffer is allocated from the heap when
+// 'heap_fallback' is "true". Otherwise NULL is returned.
+//
+static struct _queueBuffer *_queueBufferAlloc(bool heap_fallback)
+{
+    struct _queueBuffer *b;
+
+    b = (struct _queueBuffer *)_ringPop(&queues_pool_free);
+    if (NULL == b)
+    {
+        if (!heap_fallback)
+        {
+            return NULL;
+        }
+        b = (struct _queueBuffer *)memalloc(sizeof(*b));
+        b->pooled = false;
+    }
+
+    b->len = 0;
+
+    return b;
+}
+
+// Give 'b' back to the pool (or to the heap)
+//
+static void _queueBufferPut(struct _queueBuffer *b)
+{
+    if (!b->pooled)
+    {
+        free(b);
+    }
+    else if (!_ringPush(&queues_pool_free, b))
+    {
+        // Can't happen: the free ring has room for the whole pool
+        //
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Queue buffer pool corrupted\n");
+    }
+}
+
+static struct _queueBuffer *_queueBufferFromMessage(const uint8_t *message)
+{
+    return (struct _queueBuffer *)(message - offsetof(struct _queueBuffer, data));
+}
 
-#define MAX_QUEUE_IDS  256  // Number of values that fit in an uint8_t
+// Hand buffer 'b' (whose 'len' and 'data' have already been filled) over to
+// queue 'queue_id', waking up the event loop if needed.
+//
+// The reference to 'b' is transferred to the queue (or dropped right away if
+// there is a problem).
+//
+// Return "0" if there was a problem, "1" otherwise
+//
+static uint8_t _queueBufferPost(uint8_t queue_id, struct _queueBuffer *b)
+{
+    if (!queues[queue_id].used)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Invalid queue ID\n");
+        _queueBufferPut(b);
+        return 0;
+    }
 
-static mqd_t           queues_id[MAX_QUEUE_IDS] = {[ 0 ... MAX_QUEUE_IDS-1 ] = (mqd_t) -1};
-static pthread_mutex_t queues_id_mutex          = PTHREAD_MUTEX_INITIALIZER;
+    if (!_ringPush(&queues[queue_id].ring, b))
+    {
+        _queueCountDrop(queue_id, &queues[queue_id].drops_ring_full, "ring full");
+        _queueBufferPut(b);
+        return 0;
+    }
+
+    // If the message comes from a thread other than the one running the event
+    // loop, it might be blocked in "epoll_wait()": wake it up.
+    //
+    if (!pthread_equal(pthread_self(), queues_loop_thread))
+    {
+        uint64_t one = 1;
+
+        if (-1 == write(queues_wakeup_fd, &one, sizeof(one)))
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] write(eventfd) returned with errno=%d (%s)\n", errno, strerror(errno));
+        }
+    }
+
+    return 1;
+}
 
 
 // *********** Receiving packets ********************************************
+//
+// Two receive modes are supported:
+//
+//   - RX ring mode (preferred): a single packet socket per interface with a
+//     TPACKET_V3 memory mapped ring ("PACKET_RX_RING"). A classic BPF program
+//     attached to the socket makes the kernel drop everything but 1905 frames
+//     addressed to us and LLDP frames, and frames are queued to the AL
+//     straight out of the ring blocks, without any per-frame system call.
+//
+//   - Fallback mode: two packet sockets per interface (one per ethertype)
+//     read one frame at a time with "recv()". Used when the kernel does not
+//     support the RX ring.
+
+// Number of milliseconds to wait before trying to open again an interface that
+// could not be opened (or that failed while receiving).
+//
+#define INTERFACE_RETRY_MS  (24000)
+
+// Maximum number of packets read from a socket in a single event loop
+// iteration (fallback mode), so that a busy interface does not starve the
+// others.
+//
+#define RECV_BURST  (16)
+
+// RX ring geometry. Blocks are handed to user space when they are full or
+// when "RX_RING_BLOCK_TIMEOUT_MS" have elapsed since the first frame was
+// written to them. The whole ring takes RX_RING_BLOCK_SIZE*RX_RING_BLOCK_NR
+// bytes of (locked) kernel memory per interface.
+//
+#define RX_RING_BLOCK_SIZE        (1 << 15)
+#define RX_RING_BLOCK_NR          (8)
+#define RX_RING_FRAME_SIZE        (1 << 11)
+#define RX_RING_BLOCK_TIMEOUT_MS  (8)
+
+static void _openInterface(struct linux_interface_info *interface);
 
-static void handlePacket(struct linux_interface_info *interface, const uint8_t *packet, size_t packet_len)
+static void _closeInterface(struct linux_interface_info *interface)
 {
-    uint8_t   message[9+MAX_NETWORK_SEGMENT_SIZE];
-    uint16_t  message_len;
-    uint16_t  offset;
-    uint8_t   message_len_msb;
-    uint8_t   message_len_lsb;
+    eventLoopRemove(interface->source_1905);
+    eventLoopRemove(interface->source_lldp);
+    interface->source_1905 = NULL;
+    interface->source_lldp = NULL;
 
-    if (packet_len > MAX_NETWORK_SEGMENT_SIZE)
+    if (-1 != interface->sock_1905_fd)
+    {
+        close(interface->sock_1905_fd);
+        interface->sock_1905_fd = -1;
+    }
+    if (-1 != interface->sock_lldp_fd)
+    {
+        close(interface->sock_lldp_fd);
+        interface->sock_lldp_fd = -1;
+    }
+    if (NULL != interface->ring)
+    {
+        munmap(interface->ring, RX_RING_BLOCK_SIZE * RX_RING_BLOCK_NR);
+        interface->ring = NULL;
+    }
+}
+
+static void _retryInterfaceCallback(void *data)
+{
+    struct linux_interface_info *interface = (struct linux_interface_info *)data;
+
+    _openInterface(interface);
+}
+
+static void _scheduleInterfaceRetry(struct linux_interface_info *interface)
+{
+    _closeInterface(interface);
+
+    if (!eventLoopTimerIsRunning(&interface->retry_timer))
+    {
+        eventLoopTimerStart(&interface->retry_timer, INTERFACE_RETRY_MS, 0);
+    }
+}
+
+// Get a pool buffer to receive a frame from 'interface' into. The frame must
+// be written at offset "PACKET_MESSAGE_HEADER_LEN" and then passed to
+// "_packetBufferPost()".
+//
+// Return NULL (and count the drop) if the pool is exhausted.
+//
+static struct _queueBuffer *_packetBufferAlloc(struct linux_interface_info *interface)
+{
+    struct _queueBuffer *b;
+
+    b = _queueBufferAlloc(false);
+    if (NULL == b)
+    {
+        _queueCountDrop(interface->queue_id, &queues[interface->queue_id].drops_no_buffer, "no free buffer");
+    }
+
+    return b;
+}
+
+static void _packetBufferPost(struct linux_interface_info *interface, struct _queueBuffer *b, size_t packet_len)
+{
+    uint16_t message_len;
+
+    if (packet_len > PACKET_MAX_LEN)
     {
         // This should never happen
         //
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv thread* Captured packet too big\n");
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv* Captured packet too big\n");
+        _queueBufferPut(b);
         return;
     }
 
@@ -136,196 +556,405 @@ static void handlePacket(struct linux_interface_info *interface, const uint8_t *
     // function 'PLATFORM_REGISTER_QUEUE_EVENT()'
     //
     message_len = packet_len + sizeof (interface->interface);
-#if _HOST_IS_LITTLE_ENDIAN_ == 1
-    message_len_msb = *(((uint8_t *)&message_len)+1);
-    message_len_lsb = *(((uint8_t *)&message_len)+0);
-#else
-    message_len_msb = *(((uint8_t *)&message_len)+0);
-    message_len_lsb = *(((uint8_t *)&message_len)+1);
-#endif
 
-    message[0] = PLATFORM_QUEUE_EVENT_NEW_1905_PACKET;
-    message[1] = message_len_msb;
-    message[2] = message_len_lsb;
-    offset = 3;
-    memcpy(&message[offset], &interface->interface, sizeof(interface->interface));
-    offset += sizeof(interface->interface);
-    memcpy(&message[offset], packet, packet_len);
+    b->data[0] = PLATFORM_QUEUE_EVENT_NEW_1905_PACKET;
+    b->data[1] = message_len >> 8;
+    b->data[2] = message_len & 0xff;
+    memcpy(&b->data[3], &interface->interface, sizeof(interface->interface));
+    b->len = 3 + message_len;
 
-    // Now simply send the message.
-    //
-    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Recv thread* Sending %d bytes to queue (0x%02x, 0x%02x, 0x%02x, ...)\n", 3+message_len, message[0], message[1], message[2]);
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Recv* Sending %d bytes to queue (0x%02x, 0x%02x, 0x%02x, ...)\n", b->len, b->data[0], b->data[1], b->data[2]);
 
-    if (0 == sendMessageToAlQueue(interface->queue_id, message, 3 + message_len))
+    if (0 == _queueBufferPost(interface->queue_id, b))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Receive thread* Error sending message to queue\n");
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv* Error sending message to queue\n");
         return;
     }
 
     return;
 }
 
-static void *recvLoopThread(void *p)
+static void _recvCallback(int fd, uint32_t events, void *data)
 {
-    struct linux_interface_info *interface = (struct linux_interface_info *)p;
+    struct linux_interface_info *interface = (struct linux_interface_info *)data;
+    int                          i;
 
-    struct packet_mreq multicast_request;
+    (void) events;
 
-    if (NULL == p)
+    for (i = 0; i < RECV_BURST; i++)
     {
-        // 'p' must point to a valid 'struct linux_interface_info'
-        //
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv thread* Invalid arguments in recvLoopThread()\n");
+        struct _queueBuffer *b;
+        uint8_t              discard[MAX_NETWORK_SEGMENT_SIZE];
+        ssize_t              recv_length;
 
-        return NULL;
-    }
-
-    /* A STA interface may disappear, and fake interfaces for backhaul STAs may appear and disappear as well.
-     * Therefore, keep on retrying if the interface can't be opened. */
-    for (;; sleep(24))
-    {
-        /* After reconnecting, ifindex may have changed, so re-get it. */
-        interface->ifindex = getIfIndex(interface->interface->name);
-        if (-1 == interface->ifindex)
+        // Receive the frame directly into its final place in the queue
+        // message. If there is no free buffer, the frame must be read anyway
+        // (and discarded) so that the socket does not stay readable forever.
+        //
+        b = _packetBufferAlloc(interface);
+        if (NULL != b)
         {
-            continue;
+            recv_length = recv(fd, &b->data[PACKET_MESSAGE_HEADER_LEN], PACKET_MAX_LEN, MSG_DONTWAIT);
         }
-
-        memset(&multicast_request, 0, sizeof(multicast_request));
-        multicast_request.mr_ifindex = interface->ifindex;
-        multicast_request.mr_alen = 6;
-
-        interface->sock_1905_fd = openPacketSocket(interface->ifindex, ETHERTYPE_1905);
-        if (-1 == interface->sock_1905_fd)
+        else
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s' protocol 1905) returned with errno=%d (%s) while opening a RAW socket\n",
-                                        interface->interface->name, errno, strerror(errno));
-            continue;
+            recv_length = recv(fd, discard, sizeof(discard), MSG_DONTWAIT);
         }
 
-        /* Add the AL address to this interface */
-        multicast_request.mr_type = PACKET_MR_UNICAST;
-        memcpy(multicast_request.mr_address, interface->al_mac_address, 6);
-        if (-1 == setsockopt(interface->sock_1905_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &multicast_request, sizeof(multicast_request)))
+        if (recv_length < 0)
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Failed to add AL MAC address to interface '%s' with errno=%d (%s)\n",
-                                        interface->interface->name, errno, strerror(errno));
+            if (NULL != b)
+            {
+                _queueBufferPut(b);
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s* recv failed with errno=%d (%s) \n",
+                                            interface->interface->name, errno, strerror(errno));
+                /* Probably not recoverable. */
+                _scheduleInterfaceRetry(interface);
+            }
+            return;
         }
 
-        /* Add the 1905 multicast address to this interface */
-        multicast_request.mr_type = PACKET_MR_MULTICAST;
-        memcpy(multicast_request.mr_address, MCAST_1905, 6);
-        if (-1 == setsockopt(interface->sock_1905_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &multicast_request, sizeof(multicast_request)))
+        if (NULL != b)
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Failed to add 1905 multicast address to interface '%s' with errno=%d (%s)\n",
-                                        interface->interface->name, errno, strerror(errno));
+            _packetBufferPost(interface, b, (size_t)recv_length);
         }
+    }
+}
+
+static void _recvRingCallback(int fd, uint32_t events, void *data)
+{
+    struct linux_interface_info *interface = (struct linux_interface_info *)data;
+    struct tpacket_block_desc   *block;
 
-        /** @todo Make LLDP optional, for when lldpd is also running on the same device. */
-        interface->sock_lldp_fd = openPacketSocket(interface->ifindex, ETHERTYPE_LLDP);
-        if (-1 == interface->sock_lldp_fd)
+    if (events & EPOLLERR)
+    {
+        int       error;
+        socklen_t len = sizeof(error);
+
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len);
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s* RX ring failed with errno=%d (%s) \n",
+                                    interface->interface->name, error, strerror(error));
+        _scheduleInterfaceRetry(interface);
+        return;
+    }
+
+    // Process all the blocks that the kernel has already handed over to us,
+    // in ring order, and give them back once done.
+    //
+    for (;;)
+    {
+        struct tpacket3_hdr *frame;
+        uint32_t             i;
+
+        block = (struct tpacket_block_desc *)(interface->ring + interface->ring_block * RX_RING_BLOCK_SIZE);
+        if (0 == (__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s' protocol 1905) returned with errno=%d (%s) while opening a RAW socket\n",
-                                        interface->interface->name, errno, strerror(errno));
-            close(interface->sock_1905_fd);
-            continue;
+            break;
         }
 
-        /* Add the LLDP multicast address to this interface */
-        multicast_request.mr_type = PACKET_MR_MULTICAST;
-        memcpy(multicast_request.mr_address, MCAST_LLDP, 6);
-        if (-1 == setsockopt(interface->sock_lldp_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &multicast_request, sizeof(multicast_request)))
+        frame = (struct tpacket3_hdr *)((uint8_t *)block + block->hdr.bh1.offset_to_first_pkt);
+        for (i = 0; i < block->hdr.bh1.num_pkts; i++)
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Failed to add LLDP multicast address to interface '%s' with errno=%d (%s)\n",
-                                        interface->interface->name, errno, strerror(errno));
+            struct _queueBuffer *b;
+
+            // This is the only copy the frame goes through: the block must
+            // go back to the kernel as soon as possible, so the AL can't
+            // process the frame in place.
+            //
+            // Frames that don't fit are dropped before being copied
+            //
+            if (frame->tp_snaplen > PACKET_MAX_LEN)
+            {
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv* Captured packet too big (%u bytes)\n", frame->tp_snaplen);
+            }
+            else if (NULL != (b = _packetBufferAlloc(interface)))
+            {
+                memcpy(&b->data[PACKET_MESSAGE_HEADER_LEN], (uint8_t *)frame + frame->tp_mac, frame->tp_snaplen);
+                _packetBufferPost(interface, b, frame->tp_snaplen);
+            }
+            frame = (struct tpacket3_hdr *)((uint8_t *)frame + frame->tp_next_offset);
         }
 
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        interface->ring_block = (interface->ring_block + 1) % RX_RING_BLOCK_NR;
+    }
+}
 
-        PLATFORM_PRINTF_DEBUG_DETAIL("Starting recv on %s\n", interface->interface->name);
-        /** @todo move to libevent instead of threads + poll */
-        bool running = true;
-        while(running)
-        {
-            struct pollfd fdset[2];
-            size_t i;
+// Append to 'filter' the instructions that accept the frame if its destination
+// address is 'mac' and fall through otherwise. 'accept' is the index of the
+// "accept" instruction.
+//
+static void _bpfMatchDestination(struct sock_filter *filter, unsigned *n, const uint8_t *mac, unsigned accept)
+{
+    uint32_t mac_hi = (mac[0] << 24) | (mac[1] << 16) | (mac[2] << 8) | mac[3];
+    uint16_t mac_lo = (mac[4] << 8) | mac[5];
 
-            memset((void*)fdset, 0, sizeof(fdset));
+    // Jump offsets are relative to the next instruction
+    //
+    filter[*n] = (struct sock_filter)BPF_STMT(BPF_LD  | BPF_W   | BPF_ABS, 0);                                     (*n)++;
+    filter[*n] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   mac_hi, 0, 2);                          (*n)++;
+    filter[*n] = (struct sock_filter)BPF_STMT(BPF_LD  | BPF_H   | BPF_ABS, 4);                                     (*n)++;
+    filter[*n] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   mac_lo, accept - (*n + 1), 0);          (*n)++;
+}
 
-            fdset[0].fd = interface->sock_1905_fd;
-            fdset[0].events = POLLIN;
-            fdset[1].fd = interface->sock_lldp_fd;
-            fdset[1].events = POLLIN;
-            if (0 > poll(fdset, 2, -1))
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s receive thread* poll() returned with errno=%d (%s)\n",
-                                            interface->interface->name, errno, strerror(errno));
-                break;
-            }
+// Attach to socket 'fd' a classic BPF program that only accepts incoming
+// ETHERTYPE_1905 frames addressed to the AL MAC, to the interface MAC or to
+// MCAST_1905, and incoming ETHERTYPE_LLDP frames addressed to MCAST_LLDP.
+//
+static bool _attachRxFilter(struct linux_interface_info *interface, int fd)
+{
+    // Layout of the program:
+    //
+    //    0      : A = packet type
+    //    1      : if A == PACKET_OUTGOING goto drop
+    //    2      : A = ethertype
+    //    3      : if A != ETHERTYPE_1905 goto lldp
+    //    4..15  : if destination is one of our three 1905 addresses goto accept
+    //    16     : drop
+    //    17     : lldp: if A != ETHERTYPE_LLDP goto drop
+    //    18..21 : if destination == MCAST_LLDP goto accept
+    //    22     : drop: return 0
+    //    23     : accept: return everything
+    //
+    #define BPF_LLDP    (17)
+    #define BPF_DROP    (22)
+    #define BPF_ACCEPT  (23)
 
-            for (i = 0; i < ARRAY_SIZE(fdset); i++)
-            {
-                if (fdset[i].revents & (POLLIN|POLLERR))
-                {
-                    uint8_t packet[MAX_NETWORK_SEGMENT_SIZE];
-                    ssize_t recv_length;
+    struct sock_filter filter[BPF_ACCEPT + 1];
+    struct sock_fprog  program;
+    unsigned           n = 0;
 
-                    recv_length = recv(fdset[i].fd, packet, sizeof(packet), MSG_DONTWAIT);
-                    if (recv_length < 0)
-                    {
-                        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
-                        {
-                            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Interface %s receive thread* recv failed with errno=%d (%s) \n",
-                                                        interface->interface->name, errno, strerror(errno));
-                            /* Probably not recoverable. */
-                            running = false;
-                        }
-                    }
-                    else
-                    {
-                        handlePacket(interface, packet, (size_t)recv_length);
-                    }
-                }
-            }
+    filter[n] = (struct sock_filter)BPF_STMT(BPF_LD  | BPF_W   | BPF_ABS, SKF_AD_OFF + SKF_AD_PKTTYPE);        n++;
+    filter[n] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   PACKET_OUTGOING, BPF_DROP - (n + 1), 0); n++;
+    filter[n] = (struct sock_filter)BPF_STMT(BPF_LD  | BPF_H   | BPF_ABS, 12);                                  n++;
+    filter[n] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   ETHERTYPE_1905, 0, BPF_LLDP - (n + 1));  n++;
+
+    _bpfMatchDestination(filter, &n, interface->al_mac_address,   BPF_ACCEPT);
+    _bpfMatchDestination(filter, &n, interface->interface->addr,  BPF_ACCEPT);
+    _bpfMatchDestination(filter, &n, MCAST_1905_ADDR,             BPF_ACCEPT);
+
+    filter[n] = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, 0);                                               n++;
+    filter[n] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,   ETHERTYPE_LLDP, 0, BPF_DROP - (n + 1));  n++;
+
+    _bpfMatchDestination(filter, &n, MCAST_LLDP_ADDR,             BPF_ACCEPT);
+
+    filter[n] = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, 0);                                               n++;
+    filter[n] = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, 0xffffffff);                                      n++;
+
+    program.len    = n;
+    program.filter = filter;
+
+    if (-1 == setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Failed to attach BPF filter to interface '%s' with errno=%d (%s)\n",
+                                      interface->interface->name, errno, strerror(errno));
+        return false;
+    }
+
+    return true;
+
+    #undef BPF_LLDP
+    #undef BPF_DROP
+    #undef BPF_ACCEPT
+}
+
+// Open the RX ring socket of an interface whose ifindex is already known.
+//
+// Return -1 if there was a problem (and nothing is left open), the socket
+// file descriptor otherwise.
+//
+static int _openRxRing(struct linux_interface_info *interface)
+{
+    struct tpacket_req3 req;
+    struct sockaddr_ll  socket_address;
+    int                 version = TPACKET_V3;
+    int                 fd;
+
+    // Protocol "0": don't receive anything until the filter and the ring are
+    // in place and the socket is bound to the interface.
+    //
+    fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (-1 == fd)
+    {
+        return -1;
+    }
+
+    if (!_attachRxFilter(interface, fd))
+    {
+        close(fd);
+        return -1;
+    }
+
+    if (-1 == setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] TPACKET_V3 not supported on interface '%s' (errno=%d, %s)\n",
+                                      interface->interface->name, errno, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size       = RX_RING_BLOCK_SIZE;
+    req.tp_block_nr         = RX_RING_BLOCK_NR;
+    req.tp_frame_size       = RX_RING_FRAME_SIZE;
+    req.tp_frame_nr         = (RX_RING_BLOCK_SIZE / RX_RING_FRAME_SIZE) * RX_RING_BLOCK_NR;
+    req.tp_retire_blk_tov   = RX_RING_BLOCK_TIMEOUT_MS;
+
+    if (-1 == setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Failed to set up RX ring on interface '%s' with errno=%d (%s)\n",
+                                      interface->interface->name, errno, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    interface->ring = mmap(NULL, RX_RING_BLOCK_SIZE * RX_RING_BLOCK_NR, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == interface->ring)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Failed to map RX ring of interface '%s' with errno=%d (%s)\n",
+                                      interface->interface->name, errno, strerror(errno));
+        interface->ring = NULL;
+        close(fd);
+        return -1;
+    }
+    interface->ring_block = 0;
+
+    memset(&socket_address, 0, sizeof(socket_address));
+    socket_address.sll_family   = AF_PACKET;
+    socket_address.sll_protocol = htons(ETH_P_ALL);
+    socket_address.sll_ifindex  = interface->ifindex;
+
+    if (-1 == bind(fd, (struct sockaddr *)&socket_address, sizeof(socket_address)))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] Failed to bind RX ring to interface '%s' with errno=%d (%s)\n",
+                                      interface->interface->name, errno, strerror(errno));
+        munmap(interface->ring, RX_RING_BLOCK_SIZE * RX_RING_BLOCK_NR);
+        interface->ring = NULL;
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static void _addMembership(struct linux_interface_info *interface, int fd, unsigned short type, const uint8_t *addr, const char *what)
+{
+    struct packet_mreq multicast_request;
+
+    memset(&multicast_request, 0, sizeof(multicast_request));
+    multicast_request.mr_ifindex = interface->ifindex;
+    multicast_request.mr_alen    = 6;
+    multicast_request.mr_type    = type;
+    memcpy(multicast_request.mr_address, addr, 6);
+
+    if (-1 == setsockopt(fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &multicast_request, sizeof(multicast_request)))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Failed to add %s to interface '%s' with errno=%d (%s)\n",
+                                    what, interface->interface->name, errno, strerror(errno));
+    }
+}
+
+static void _openInterface(struct linux_interface_info *interface)
+{
+    /* A STA interface may disappear, and fake interfaces for backhaul STAs may appear and disappear as well.
+     * Therefore, keep on retrying (from a timer) if the interface can't be opened. */
+
+    /* After reconnecting, ifindex may have changed, so re-get it. */
+    interface->ifindex = getIfIndex(interface->interface->name);
+    if (-1 == interface->ifindex)
+    {
+        _scheduleInterfaceRetry(interface);
+        return;
+    }
+
+    // Preferred mode: a single filtered socket with an RX ring
+    //
+    interface->sock_1905_fd = _openRxRing(interface);
+    if (-1 != interface->sock_1905_fd)
+    {
+        _addMembership(interface, interface->sock_1905_fd, PACKET_MR_UNICAST,   interface->al_mac_address, "AL MAC address");
+        _addMembership(interface, interface->sock_1905_fd, PACKET_MR_MULTICAST, MCAST_1905_ADDR,           "1905 multicast address");
+        _addMembership(interface, interface->sock_1905_fd, PACKET_MR_MULTICAST, MCAST_LLDP_ADDR,           "LLDP multicast address");
+
+        interface->source_1905 = eventLoopAddFd(interface->sock_1905_fd, EPOLLIN, _recvRingCallback, interface);
+        if (NULL == interface->source_1905)
+        {
+            _scheduleInterfaceRetry(interface);
+            return;
         }
-        close(interface->sock_1905_fd);
-        close(interface->sock_lldp_fd);
+
+        PLATFORM_PRINTF_DEBUG_DETAIL("Starting recv on %s (RX ring)\n", interface->interface->name);
+        return;
+    }
+
+    // Fallback mode: one socket per ethertype
+    //
+    interface->sock_1905_fd = openPacketSocket(interface->ifindex, ETHERTYPE_1905);
+    if (-1 == interface->sock_1905_fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s' protocol 1905) returned with errno=%d (%s) while opening a RAW socket\n",
+                                    interface->interface->name, errno, strerror(errno));
+        _scheduleInterfaceRetry(interface);
+        return;
+    }
+
+    _addMembership(interface, interface->sock_1905_fd, PACKET_MR_UNICAST,   interface->al_mac_address, "AL MAC address");
+    _addMembership(interface, interface->sock_1905_fd, PACKET_MR_MULTICAST, MCAST_1905_ADDR,           "1905 multicast address");
+
+    /** @todo Make LLDP optional, for when lldpd is also running on the same device. */
+    interface->sock_lldp_fd = openPacketSocket(interface->ifindex, ETHERTYPE_LLDP);
+    if (-1 == interface->sock_lldp_fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] socket('%s' protocol 1905) returned with errno=%d (%s) while opening a RAW socket\n",
+                                    interface->interface->name, errno, strerror(errno));
+        _scheduleInterfaceRetry(interface);
+        return;
     }
 
-    // Unreachable
-    PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Recv thread* Exiting thread (interface %s)\n", interface->interface->name);
-    close(interface->sock_1905_fd);
-    close(interface->sock_lldp_fd);
-    free(interface);
-    return NULL;
+    _addMembership(interface, interface->sock_lldp_fd, PACKET_MR_MULTICAST, MCAST_LLDP_ADDR,           "LLDP multicast address");
+
+    interface->source_1905 = eventLoopAddFd(interface->sock_1905_fd, EPOLLIN, _recvCallback, interface);
+    interface->source_lldp = eventLoopAddFd(interface->sock_lldp_fd, EPOLLIN, _recvCallback, interface);
+    if (NULL == interface->source_1905 || NULL == interface->source_lldp)
+    {
+        _scheduleInterfaceRetry(interface);
+        return;
+    }
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("Starting recv on %s\n", interface->interface->name);
 }
 
 // *********** Timers stuff ****************************************************
-
-// We use the POSIX timers API to implement PLATFORM timers
-// It works like this:
+//
+// PLATFORM timers are event loop timers:
 //
 //   - When the PLATFORM API user calls "PLATFORM_REGISTER_QUEUE_EVENT()" with
-//     'PLATFORM_QUEUE_EVENT_TIMEOUT*', a new POSIX timer is created.
+//     'PLATFORM_QUEUE_EVENT_TIMEOUT*', a new event loop timer is started and
+//     linked to the list of timers of its queue with the same token.
 //
-//   - When the timer expires, the POSIX API creates a thread for us and makes
-//     it run function '_timerHandler()'
+//   - When the timer expires, the event loop runs '_timerHandler()', which
+//     simply posts a message to the queue so that the user can later be aware
+//     of the timer expiration with a call to "PLATFORM_QUEUE_READ()".
 //
-//   - '_timerHandler()' simply deletes (or reprograms, depending on the type
-//     of timer) the timer and sends a message to a queue so that the user can
-//     later be aware of the timer expiration with a call to
-//     "PLATFORM_QUEUE_READ()"
+//   - One-shot timers are freed right after expiring. Periodic ones, when
+//     their token is cancelled with "PLATFORM_CANCEL_QUEUE_EVENT_TIMEOUT()".
 
-struct _timerHandlerThreadData
+struct _timerHandlerData
 {
+    dlist_item             l;  // In 'queues[queue_id].timers[token]'
+    struct eventLoopTimer  timer;
+
     uint8_t    queue_id;
     uint32_t   token;
     uint8_t    periodic;
-    timer_t  timer_id;
 };
 
-static void _timerHandler(union sigval s)
+static void _timerHandler(void *data)
 {
-    struct _timerHandlerThreadData *aux;
+    struct _timerHandlerData *aux = (struct _timerHandlerData *)data;
 
     uint8_t   message[3+4];
     uint16_t  packet_len;
@@ -336,8 +965,6 @@ static void _timerHandler(union sigval s)
     uint8_t   token_3rd_msb;
     uint8_t   token_lsb;
 
-    aux = (struct _timerHandlerThreadData *)s.sival_ptr;
-
     // In order to build the message that will be inserted into the queue, we
     // need to follow the "message format" defines in the documentation of
     // function 'PLATFORM_REGISTER_QUEUE_EVENT()'
@@ -384,12 +1011,10 @@ static void _timerHandler(union sigval s)
     }
     else
     {
-        // Delete the asociater timer
-        //
-        timer_delete(aux->timer_id);
-
-        // Free 'struct _timerHandlerThreadData', as we don't need it any more
+        // The timer has already been stopped by the event loop. Free 'struct
+        // _timerHandlerData', as we don't need it any more
         //
+        dlist_remove(&aux->l);
         free(aux);
     }
 
@@ -417,15 +1042,70 @@ static void _timerHandler(union sigval s)
 #define PUSH_BUTTON_GPIO_DIRECTION_FILENAME  "/sys/class/gpio/gpio"PUSH_BUTTON_GPIO_NUMBER"/direction"
 #define PUSH_BUTTON_GPIO_VALUE_FILENAME      "/sys/class/gpio/gpio"PUSH_BUTTON_GPIO_NUMBER"/direction"
 
-// The only information that needs to be sent to the new thread is the "queue
-// id" to later post messages to the queue.
+// The only information that the event loop callbacks need is the "queue id"
+// to later post messages to the queue.
 //
-struct _pushButtonThreadData
+struct _pushButtonData
 {
     uint8_t     queue_id;
 };
 
-static void *_pushButtonThread(void *p)
+static void _pushButtonPressed(struct _pushButtonData *p)
+{
+    uint8_t   message[3];
+
+    message[0] = PLATFORM_QUEUE_EVENT_PUSH_BUTTON;
+    message[1] = 0x0;
+    message[2] = 0x0;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
+
+    if (0 == sendMessageToAlQueue(p->queue_id, message, 3))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error sending message to queue from _pushButtonPressed()\n");
+    }
+}
+
+static void _pushButtonVirtualCallback(int fd, uint32_t events, void *data)
+{
+    uint8_t buffer[sizeof(struct inotify_event) + NAME_MAX + 1];
+
+    (void) events;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button* Virtual button has been pressed!\n");
+
+    // We must "read()" from the "tmp" fd to "consume" the event, or else the
+    // event loop will keep on reporting it.
+    //
+    if (-1 == read(fd, buffer, sizeof(buffer)))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* read() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return;
+    }
+
+    _pushButtonPressed((struct _pushButtonData *)data);
+}
+
+static void _pushButtonGpioCallback(int fd, uint32_t events, void *data)
+{
+    char buf[3];
+
+    (void) events;
+
+    if (-1 == read(fd, buf, 3))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* read() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return;
+    }
+
+    if (buf[0] == '1')
+    {
+        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button* Physical button has been pressed!\n");
+        _pushButtonPressed((struct _pushButtonData *)data);
+    }
+}
+
+static uint8_t _pushButtonStart(struct _pushButtonData *p)
 {
     // In this implementation we will send the "push button" configuration
     // event message to the queue when either:
@@ -440,15 +1120,13 @@ static void *_pushButtonThread(void *p)
     //      This is useful for debugging and for supporting the "push button"
     //      mechanism in those platforms without a physical button.
     //
-    // This thread will simply wait for activity on any of those two file
-    // descriptors and then send the "push button" configuration event to the
-    // AL queue.
     // How is this done?
     //
     //   1. Configure the GPIO as input.
     //   2. Create an "inotify" watch on the tmp file.
-    //   3. Use "poll()" to wait for either changes in the value of the GPIO or
-    //      timestamp updates in the tmp file.
+    //   3. Add both file descriptors to the event loop, waiting for either
+    //      changes in the value of the GPIO or timestamp updates in the tmp
+    //      file.
 
     int    gpio_enabled;
 
@@ -458,12 +1136,6 @@ static void *_pushButtonThread(void *p)
     int  fdraw_gpio;
     int  fdraw_tmp;
 
-    struct pollfd fdset[2];
-
-    uint8_t queue_id;
-
-    queue_id = ((struct _pushButtonThreadData *)p)->queue_id;;
-
     if (0 != strcmp(PUSH_BUTTON_GPIO_NUMBER, "disable"))
     {
         gpio_enabled = 1;
@@ -486,14 +1158,14 @@ static void *_pushButtonThread(void *p)
         //
         if (NULL == (fd_gpio = fopen(PUSH_BUTTON_GPIO_EXPORT_FILENAME, "w")))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
-            return NULL;
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
+            return 0;
         }
         if (0 == fwrite(PUSH_BUTTON_GPIO_NUMBER, 1, strlen(PUSH_BUTTON_GPIO_NUMBER), fd_gpio))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error writing '"PUSH_BUTTON_GPIO_NUMBER"' to %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error writing '"PUSH_BUTTON_GPIO_NUMBER"' to %s\n", PUSH_BUTTON_GPIO_EXPORT_FILENAME);
             fclose(fd_gpio);
-            return NULL;
+            return 0;
         }
         fclose(fd_gpio);
 
@@ -503,262 +1175,461 @@ static void *_pushButtonThread(void *p)
 
         if (NULL == (fd_gpio = fopen(PUSH_BUTTON_GPIO_DIRECTION_FILENAME, "w")))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
-            return NULL;
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
+            return 0;
         }
         if (0 == fwrite("in", 1, strlen("in"), fd_gpio))
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error writing 'in' to %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error writing 'in' to %s\n", PUSH_BUTTON_GPIO_DIRECTION_FILENAME);
             fclose(fd_gpio);
-            return NULL;
+            return 0;
+        }
+        fclose(fd_gpio);
+
+        // ... and then re-open the GPIO file descriptor for reading in "raw"
+        // (ie "open" instead of "fopen") mode.
+        //
+        if (-1  == (fdraw_gpio = open(PUSH_BUTTON_GPIO_VALUE_FILENAME, O_RDONLY | O_NONBLOCK)))
+        {
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_VALUE_FILENAME);
+        }
+        else if (NULL == eventLoopAddFd(fdraw_gpio, EPOLLPRI, _pushButtonGpioCallback, p))
+        {
+            close(fdraw_gpio);
+        }
+    }
+
+    // Next, regarding the "virtual" button, first create the "tmp" file in
+    // case it does not already exist...
+    //
+    if (NULL == (fd_tmp = fopen(PUSH_BUTTON_VIRTUAL_FILENAME, "w+")))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* Could not create tmp file %s\n", PUSH_BUTTON_VIRTUAL_FILENAME);
+        return 0;
+    }
+    fclose(fd_tmp);
+
+    // ...and then add a "watch" that triggers when its timestamp changes (ie.
+    // when someone does a "touch" of the file or writes to it, for example).
+    //
+    if (-1 == (fdraw_tmp = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return 0;
+    }
+    if (-1 == inotify_add_watch(fdraw_tmp, PUSH_BUTTON_VIRTUAL_FILENAME, IN_ATTRIB))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
+        close(fdraw_tmp);
+        return 0;
+    }
+    if (NULL == eventLoopAddFd(fdraw_tmp, EPOLLIN, _pushButtonVirtualCallback, p))
+    {
+        close(fdraw_tmp);
+        return 0;
+    }
+
+    return 1;
+}
+
+// *********** Topology change notification stuff ******************************
+//
+// Topology changes are detected from two sources:
+//
+//   - An rtnetlink socket subscribed to link and address changes: interfaces
+//     that appear, disappear, go up or down, join or leave a bridge, or get
+//     their IP addresses changed. The same link events are used to (re)open
+//     the receive sockets of 1905 interfaces as soon as they (re)appear,
+//     instead of waiting for the next "INTERFACE_RETRY_MS" retry, which is
+//     now just a fallback.
+//
+//   - A "virtual" notification, activated by "touching" a tmp file (see
+//     below).
+//
+// A single change usually produces a burst of netlink messages (link down,
+// addresses removed, bridge port removed, ...), so events are coalesced: only
+// one message is posted to the queue, "TOPOLOGY_CHANGE_COALESCE_MS" after the
+// first one.
+
+// The platform notifies the 1905 that a topology change has just took place
+// by "touching" the following tmp file
+//
+#define TOPOLOGY_CHANGE_NOTIFICATION_FILENAME  "/tmp/topology_change"
+
+#define TOPOLOGY_CHANGE_COALESCE_MS  (100)
+
+// Size of the buffer used to read rtnetlink messages. Big enough for the
+// largest RTM_NEWLINK message.
+//
+#define LINK_MONITOR_BUFFER_SIZE     (16384)
+
+struct _topologyMonitorData
+{
+    uint8_t                queue_id;
+    struct eventLoopTimer  coalesce_timer;
+};
+
+// Queue that topology change events are sent to (NULL until the AL registers
+// the "PLATFORM_QUEUE_EVENT_TOPOLOGY_CHANGE_NOTIFICATION" event)
+//
+static struct _topologyMonitorData *topology_monitor;
+
+// Last known state of each link. The kernel sends RTM_NEWLINK for all sorts of
+// reasons (eg. wireless extension events), so this is used to only report
+// changes that matter for the topology.
+//
+struct _linkState
+{
+    dlist_item  l;
+    int         ifindex;
+    unsigned    flags;    // IFF_UP | IFF_RUNNING | IFF_LOWER_UP
+    uint32_t    master;   // ifindex of the bridge the link belongs to, or "0"
+};
+
+static DEFINE_DLIST_HEAD(link_states);
+static int link_monitor_fd = -1;
+
+static void _topologyChangeTimerCallback(void *data)
+{
+    struct _topologyMonitorData *p = (struct _topologyMonitorData *)data;
+
+    uint8_t message[3];
+
+    message[0] = PLATFORM_QUEUE_EVENT_TOPOLOGY_CHANGE_NOTIFICATION;
+    message[1] = 0x0;
+    message[2] = 0x0;
+
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
+
+    if (0 == sendMessageToAlQueue(p->queue_id, message, 3))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* Error sending message to queue from _topologyChangeTimerCallback()\n");
+    }
+}
+
+static void _topologyChanged(const char *what)
+{
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor* %s\n", what);
+
+    if (NULL != topology_monitor && !eventLoopTimerIsRunning(&topology_monitor->coalesce_timer))
+    {
+        eventLoopTimerStart(&topology_monitor->coalesce_timer, TOPOLOGY_CHANGE_COALESCE_MS, 0);
+    }
+}
+
+static void _topologyMonitorCallback(int fd, uint32_t events, void *data)
+{
+    uint8_t buffer[sizeof(struct inotify_event) + NAME_MAX + 1];
+
+    (void) events;
+    (void) data;
+
+    // We must "read()" from the "tmp" fd to "consume" the event, or else the
+    // event loop will keep on reporting it.
+    //
+    if (-1 == read(fd, buffer, sizeof(buffer)))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* read() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return;
+    }
+
+    _topologyChanged("Virtual notification has been activated!");
+}
+
+// Update the last known state of link 'ifindex' ('present' is "false" if it
+// has been deleted). Return "true" if anything relevant changed.
+//
+static bool _linkStateUpdate(int ifindex, bool present, unsigned flags, uint32_t master)
+{
+    struct _linkState *s;
+
+    flags &= IFF_UP | IFF_RUNNING | IFF_LOWER_UP;
+
+    dlist_for_each(s, link_states, l)
+    {
+        if (s->ifindex == ifindex)
+        {
+            break;
+        }
+    }
+
+    if (!present)
+    {
+        if (NULL == s)
+        {
+            return false;
+        }
+        dlist_remove(&s->l);
+        free(s);
+        return true;
+    }
+
+    if (NULL == s)
+    {
+        s = (struct _linkState *)zmemalloc(sizeof(*s));
+        s->ifindex = ifindex;
+        dlist_add_tail(&link_states, &s->l);
+    }
+    else if (s->flags == flags && s->master == master)
+    {
+        return false;
+    }
+
+    s->flags  = flags;
+    s->master = master;
+    return true;
+}
+
+// Link 'name' (whose index is 'ifindex') has been created, modified or (if
+// 'present' is "false") deleted: make sure the receive sockets of the matching
+// 1905 interface are bound to it.
+//
+static void _linkChanged(const char *name, int ifindex, bool present)
+{
+    struct linux_interface_info *interface;
+
+    dlist_for_each(interface, linux_interfaces, l)
+    {
+        if (0 != strcmp(interface->interface->name, name))
+        {
+            continue;
+        }
+
+        if (-1 != interface->sock_1905_fd && (!present || interface->ifindex != ifindex))
+        {
+            // The sockets are bound to an index that no longer exists
+            //
+            PLATFORM_PRINTF_DEBUG_INFO("[PLATFORM] Interface %s is gone\n", name);
+            _scheduleInterfaceRetry(interface);
         }
-        fclose(fd_gpio);
-    }
 
-    // ... and then re-open the GPIO file descriptors for reading in "raw"
-    // (ie "open" instead of "fopen") mode.
-    //
-    if (gpio_enabled)
-    {
-        if (-1  == (fdraw_gpio = open(PUSH_BUTTON_GPIO_VALUE_FILENAME, O_RDONLY | O_NONBLOCK)))
+        if (present && -1 == interface->sock_1905_fd)
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error opening GPIO fd %s\n", PUSH_BUTTON_GPIO_VALUE_FILENAME);
+            PLATFORM_PRINTF_DEBUG_INFO("[PLATFORM] Interface %s is back, reopening it\n", name);
+            eventLoopTimerStop(&interface->retry_timer);
+            _openInterface(interface);
         }
     }
 
-    // Next, regarding the "virtual" button, first create the "tmp" file in
-    // case it does not already exist...
-    //
-    if (NULL == (fd_tmp = fopen(PUSH_BUTTON_VIRTUAL_FILENAME, "w+")))
+    if (!present)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Could not create tmp file %s\n", PUSH_BUTTON_VIRTUAL_FILENAME);
-        return NULL;
+        txSocketCacheInvalidate(name);
     }
-    fclose(fd_tmp);
+}
 
-    // ...and then add a "watch" that triggers when its timestamp changes (ie.
-    // when someone does a "touch" of the file or writes to it, for example).
-    //
-    if (-1 == (fdraw_tmp = inotify_init()))
+static void _linkMonitorParseLink(const struct nlmsghdr *h)
+{
+    const struct ifinfomsg *ifi = (const struct ifinfomsg *)NLMSG_DATA(h);
+    const struct rtattr    *rta;
+    int                     rta_len;
+    const char             *name    = NULL;
+    uint32_t                master  = 0;
+    bool                    wireless = false;
+
+    if (h->nlmsg_len < NLMSG_LENGTH(sizeof(*ifi)))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        return;
     }
-    if (-1 == inotify_add_watch(fdraw_tmp, PUSH_BUTTON_VIRTUAL_FILENAME, IN_ATTRIB))
+
+    rta_len = IFLA_PAYLOAD(h);
+    for (rta = IFLA_RTA(ifi); RTA_OK(rta, rta_len); rta = RTA_NEXT(rta, rta_len))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        switch (rta->rta_type)
+        {
+            case IFLA_IFNAME:
+                name = (const char *)RTA_DATA(rta);
+                break;
+            case IFLA_MASTER:
+                memcpy(&master, RTA_DATA(rta), sizeof(master));
+                break;
+            case IFLA_WIRELESS:
+                wireless = true;
+                break;
+            default:
+                break;
+        }
     }
 
-    // At this point we have two file descriptors ("fdraw_gpio" and "fdraw_tmp")
-    // that we can monitor with a call to "poll()"
-    //
-    while(1)
+    if (AF_BRIDGE == ifi->ifi_family)
     {
-        int   nfds;
-        uint8_t button_pressed;
-
-        memset((void*)fdset, 0, sizeof(fdset));
+        // Sent by the bridge when a port is added, removed or changes its
+        // (STP) state
+        //
+        _topologyChanged("Bridge port changed");
+        return;
+    }
 
-        fdset[0].fd     = fdraw_tmp;
-        fdset[0].events = POLLIN;
-        nfds            = 1;
+    if (wireless)
+    {
+        // Wireless extension events (scan results, ...) are not topology
+        // changes
+        //
+        return;
+    }
 
-        if (gpio_enabled)
-        {
-            fdset[1].fd     = fdraw_gpio;
-            fdset[1].events = POLLPRI;
-            nfds            = 2;
-        }
+    if (NULL != name)
+    {
+        _linkChanged(name, ifi->ifi_index, RTM_NEWLINK == h->nlmsg_type);
+    }
 
-        // The thread will block here (forever, timeout = -1), until there is
-        // a change in one of the two file descriptors ("changes" in the "tmp"
-        // file fd are cause by "attribute" changes -such as the timestamp-,
-        // while "changes" in the GPIO fd are caused by a value change in the
-        // GPIO value).
-        //
-        if (0 > poll(fdset, nfds, -1))
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* poll() returned with errno=%d (%s)\n", errno, strerror(errno));
-            break;
-        }
+    if (_linkStateUpdate(ifi->ifi_index, RTM_NEWLINK == h->nlmsg_type, ifi->ifi_flags, master))
+    {
+        _topologyChanged("Link changed");
+    }
+}
 
-        button_pressed = 0;
+static void _linkMonitorCallback(int fd, uint32_t events, void *data)
+{
+    uint8_t  buffer[LINK_MONITOR_BUFFER_SIZE] __attribute__((aligned(NLMSG_ALIGNTO)));
+    ssize_t  len;
 
-        if (fdset[0].revents & POLLIN)
-        {
-            struct inotify_event event;
+    (void) events;
+    (void) data;
 
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button thread* Virtual button has been pressed!\n");
-            button_pressed = 1;
+    for (;;)
+    {
+        const struct nlmsghdr *h;
 
-            // We must "read()" from the "tmp" fd to "consume" the event, or
-            // else the next call to "poll() won't block.
-            //
-            read(fdraw_tmp, &event, sizeof(event));
-        }
-        else if (gpio_enabled && (fdset[1].revents & POLLPRI))
+        len = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (len < 0)
         {
-            char buf[3];
-
-            if (-1 == read(fdset[1].fd, buf, 3))
+            if (ENOBUFS == errno)
             {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* read() returned with errno=%d (%s)\n", errno, strerror(errno));
+                // Some messages were lost. Assume the worst: everything may
+                // have changed.
+                //
+                struct linux_interface_info *interface;
+
+                PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *Topology change monitor* rtnetlink overrun\n");
+                dlist_for_each(interface, linux_interfaces, l)
+                {
+                    if (-1 == interface->sock_1905_fd)
+                    {
+                        eventLoopTimerStop(&interface->retry_timer);
+                        _openInterface(interface);
+                    }
+                }
+                txSocketCacheInvalidate(NULL);
+                _topologyChanged("Unknown changes");
                 continue;
             }
-
-            if (buf[0] == '1')
+            if (EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)
             {
-                PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button thread* Physical button has been pressed!\n");
-                button_pressed = 1;
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* recv() returned with errno=%d (%s)\n", errno, strerror(errno));
             }
+            return;
         }
 
-        if (1 == button_pressed)
+        for (h = (const struct nlmsghdr *)buffer; NLMSG_OK(h, (size_t)len); h = NLMSG_NEXT(h, len))
         {
-            uint8_t   message[3];
-
-            message[0] = PLATFORM_QUEUE_EVENT_PUSH_BUTTON;
-            message[1] = 0x0;
-            message[2] = 0x0;
-
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Push button thread* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
-
-            if (0 == sendMessageToAlQueue(queue_id, message, 3))
+            switch (h->nlmsg_type)
             {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* Error sending message to queue from _pushButtonThread()\n");
+                case RTM_NEWLINK:
+                case RTM_DELLINK:
+                    _linkMonitorParseLink(h);
+                    break;
+
+                case RTM_NEWADDR:
+                case RTM_DELADDR:
+                    _topologyChanged("Address changed");
+                    break;
+
+                default:
+                    break;
             }
         }
     }
+}
 
-    // Close file descriptors and exit
-    //
-    if (gpio_enabled)
+// Open the rtnetlink socket (only once, no matter how many times this is
+// called)
+//
+static uint8_t _linkMonitorStart(void)
+{
+    struct sockaddr_nl addr;
+
+    if (-1 != link_monitor_fd)
     {
-        fclose(fd_gpio);
+        return 1;
     }
 
-    PLATFORM_PRINTF_DEBUG_INFO("[PLATFORM] *Push button thread* Exiting...\n");
+    link_monitor_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (-1 == link_monitor_fd)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* socket(NETLINK_ROUTE) returned with errno=%d (%s)\n", errno, strerror(errno));
+        return 0;
+    }
 
-    free(p);
-    return NULL;
-}
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
 
-// *********** Topology change notification stuff ******************************
+    if (-1 == bind(link_monitor_fd, (struct sockaddr *)&addr, sizeof(addr)))
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* bind(NETLINK_ROUTE) returned with errno=%d (%s)\n", errno, strerror(errno));
+        close(link_monitor_fd);
+        link_monitor_fd = -1;
+        return 0;
+    }
 
-// The platform notifies the 1905 that a topology change has just took place
-// by "touching" the following tmp file
-//
-#define TOPOLOGY_CHANGE_NOTIFICATION_FILENAME  "/tmp/topology_change"
+    if (NULL == eventLoopAddFd(link_monitor_fd, EPOLLIN, _linkMonitorCallback, NULL))
+    {
+        close(link_monitor_fd);
+        link_monitor_fd = -1;
+        return 0;
+    }
 
-// The only information that needs to be sent to the new thread is the "queue
-// id" to later post messages to the queue.
-//
-struct _topologyMonitorThreadData
-{
-    uint8_t     queue_id;
-};
+    return 1;
+}
 
-static void *_topologyMonitorThread(void *p)
+static uint8_t _topologyMonitorStart(struct _topologyMonitorData *p)
 {
     FILE  *fd_tmp;
 
     int  fdraw_tmp;
 
-    struct pollfd fdset[2];
+    eventLoopTimerInit(&p->coalesce_timer, _topologyChangeTimerCallback, p);
+    topology_monitor = p;
 
-    uint8_t  queue_id;
-
-    queue_id = ((struct _topologyMonitorThreadData *)p)->queue_id;
+    if (0 == _linkMonitorStart())
+    {
+        // Not fatal: there is still the "virtual" notification
+        //
+        PLATFORM_PRINTF_DEBUG_WARNING("[PLATFORM] *Topology change monitor* Link changes won't be detected\n");
+    }
 
     // Regarding the "virtual" notification system, first create the "tmp" file
     // in case it does not already exist...
     //
     if (NULL == (fd_tmp = fopen(TOPOLOGY_CHANGE_NOTIFICATION_FILENAME, "w+")))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor thread* Could not create tmp file %s\n", TOPOLOGY_CHANGE_NOTIFICATION_FILENAME);
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* Could not create tmp file %s\n", TOPOLOGY_CHANGE_NOTIFICATION_FILENAME);
+        return 0;
     }
     fclose(fd_tmp);
 
     // ...and then add a "watch" that triggers when its timestamp changes (ie.
     // when someone does a "touch" of the file or writes to it, for example).
     //
-    if (-1 == (fdraw_tmp = inotify_init()))
+    if (-1 == (fdraw_tmp = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* inotify_init() returned with errno=%d (%s)\n", errno, strerror(errno));
+        return 0;
     }
     if (-1 == inotify_add_watch(fdraw_tmp, TOPOLOGY_CHANGE_NOTIFICATION_FILENAME, IN_ATTRIB))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Push button thread* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return NULL;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor* inotify_add_watch() returned with errno=%d (%s)\n", errno, strerror(errno));
+        close(fdraw_tmp);
+        return 0;
     }
 
-    while (1)
+    if (NULL == eventLoopAddFd(fdraw_tmp, EPOLLIN, _topologyMonitorCallback, p))
     {
-        int   nfds;
-        uint8_t notification_activated;
-
-        memset((void*)fdset, 0, sizeof(fdset));
-
-        fdset[0].fd     = fdraw_tmp;
-        fdset[0].events = POLLIN;
-        nfds            = 1;
-
-        // TODO: Other fd's to detect topoly changes would be initialized here.
-        // One good idea would be to use a NETLINK socket that is notified by
-        // the Linux kernel when network "stuff" (routes, IPs, ...) change.
-        //
-        //fdset[0].fd     = ...;
-        //fdset[0].events = POLLIN;
-        //nfds            = 2;
-
-        // The thread will block here (forever, timeout = -1), until there is
-        // a change in one of the previous file descriptors .
-        //
-        if (0 > poll(fdset, nfds, -1))
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor thread* poll() returned with errno=%d (%s)\n", errno, strerror(errno));
-            break;
-        }
-
-        notification_activated = 0;
-
-        if (fdset[0].revents & POLLIN)
-        {
-            struct inotify_event event;
-
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor thread* Virtual notification has been activated!\n");
-            notification_activated = 1;
-
-            // We must "read()" from the "tmp" fd to "consume" the event, or
-            // else the next call to "poll() won't block.
-            //
-            read(fdraw_tmp, &event, sizeof(event));
-        }
-
-        if (1 == notification_activated)
-        {
-            uint8_t  message[3];
-
-            message[0] = PLATFORM_QUEUE_EVENT_TOPOLOGY_CHANGE_NOTIFICATION;
-            message[1] = 0x0;
-            message[2] = 0x0;
-
-            PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] *Topology change monitor thread* Sending 3 bytes to queue (0x%02x, 0x%02x, 0x%02x)\n", message[0], message[1], message[2]);
-
-            if (0 == sendMessageToAlQueue(queue_id, message, 3))
-            {
-                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] *Topology change monitor thread* Error sending message to queue from _pushButtonThread()\n");
-            }
-        }
+        close(fdraw_tmp);
+        return 0;
     }
 
-    PLATFORM_PRINTF_DEBUG_INFO("[PLATFORM] *Topology change monitor thread* Exiting...\n");
-
-    free(p);
-    return NULL;
+    return 1;
 }
 
 
@@ -769,14 +1640,7 @@ static void *_topologyMonitorThread(void *p)
 
 uint8_t sendMessageToAlQueue(uint8_t queue_id, uint8_t *message, uint16_t message_len)
 {
-    mqd_t   mqdes;
-
-    mqdes = queues_id[queue_id];
-    if ((mqd_t) -1 == mqdes)
-    {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Invalid queue ID\n");
-        return 0;
-    }
+    struct _queueBuffer *b;
 
     if (NULL == message)
     {
@@ -784,13 +1648,26 @@ uint8_t sendMessageToAlQueue(uint8_t queue_id, uint8_t *message, uint16_t messag
         return 0;
     }
 
-    if (0 !=  mq_send(mqdes, (const char *)message, message_len, 0))
+    // The AL reads messages into a buffer of this size (see the documentation
+    // of "PLATFORM_READ_QUEUE()")
+    //
+    if (message_len > MAX_NETWORK_SEGMENT_SIZE+3)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_send('%d') returned with errno=%d (%s)\n", queue_id, errno, strerror(errno));
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Message too long for queue %d (%d bytes)\n", queue_id, message_len);
         return 0;
     }
 
-    return 1;
+    b = _queueBufferAlloc(true);
+    memcpy(b->data, message, message_len);
+    b->len = message_len;
+
+    return _queueBufferPost(queue_id, b);
+}
+
+void queueGetStats(uint8_t queue_id, struct queueStats *stats)
+{
+    stats->drops_ring_full = __atomic_load_n(&queues[queue_id].drops_ring_full, __ATOMIC_RELAXED);
+    stats->drops_no_buffer = __atomic_load_n(&queues[queue_id].drops_no_buffer, __ATOMIC_RELAXED);
 }
 
 
@@ -823,16 +1700,19 @@ struct deviceInfo *PLATFORM_GET_DEVICE_INFO(void)
 
 uint8_t PLATFORM_CREATE_QUEUE(const char *name)
 {
-    mqd_t          mqdes;
-    struct mq_attr attr;
     int            i;
-    char           name_tmp[20];
+    int            j;
 
-    pthread_mutex_lock(&queues_id_mutex);
+    // 'name' was only needed by the old POSIX message queues implementation.
+    // Queues now live in the memory of this process and don't need a name.
+    //
+    (void) name;
+
+    pthread_mutex_lock(&queues_mutex);
 
     for (i=1; i<MAX_QUEUE_IDS; i++)  // Note: "0" is not a valid "queue_id"
     {                                // according to the documentation of
-        if (-1 == queues_id[i])      // "PLATFORM_CREATE_QUEUE()". That's why we
+        if (!queues[i].used)         // "PLATFORM_CREATE_QUEUE()". That's why we
         {                            // skip it
             // Empty slot found.
             //
@@ -843,48 +1723,47 @@ uint8_t PLATFORM_CREATE_QUEUE(const char *name)
     {
         // No more queue id slots available
         //
-        pthread_mutex_unlock(&queues_id_mutex);
+        pthread_mutex_unlock(&queues_mutex);
         return 0;
     }
 
-    if (!name)
-    {
-        name_tmp[0] = 0x0;
-        sprintf(name_tmp, "/queue_%03d", i);
-        name = name_tmp;
-    }
-    else if (name[0] != '/')
-    {
-        snprintf(name_tmp, 20, "/%s", name);
-        name = name_tmp;
-    }
-
-    // If a queue with this name already existed (maybe from a previous
-    // session), destroy and re-create it
+    // The thread that creates the queue is the one that will later read from
+    // it and, thus, the one that runs the event loop.
     //
-    mq_unlink(name);
+    if (-1 == queues_wakeup_fd)
+    {
+        queues_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (-1 == queues_wakeup_fd)
+        {
+            pthread_mutex_unlock(&queues_mutex);
+            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] eventfd() returned with errno=%d (%s)\n", errno, strerror(errno));
+            return 0;
+        }
+        if (NULL == eventLoopAddFd(queues_wakeup_fd, EPOLLIN, _queueWakeupCallback, NULL))
+        {
+            close(queues_wakeup_fd);
+            queues_wakeup_fd = -1;
+            pthread_mutex_unlock(&queues_mutex);
+            return 0;
+        }
+        queues_loop_thread = pthread_self();
 
-    attr.mq_flags   = 0;
-    attr.mq_maxmsg  = 100;
-    attr.mq_curmsgs = 0;
-    attr.mq_msgsize = MAX_NETWORK_SEGMENT_SIZE+3;
-      //
-      // NOTE: The biggest value in the queue is going to be a message from the
-      // "new packet" event, which is MAX_NETWORK_SEGMENT_SIZE+3 bytes long.
-      // The "PLATFORM_CREATE_QUEUE()" documentation mentions
+        queues_pool = (struct _queueBuffer *)memalloc(QUEUE_POOL_SIZE * sizeof(*queues_pool));
+        _ringInit(&queues_pool_free, QUEUE_POOL_SIZE);
+        for (j = 0; j < QUEUE_POOL_SIZE; j++)
+        {
+            queues_pool[j].pooled = true;
+            _ringPush(&queues_pool_free, &queues_pool[j]);
+        }
+    }
 
-    if ((mqd_t) -1 == (mqdes = mq_open(name, O_RDWR | O_CREAT, 0666, &attr)))
+    if (NULL == queues[i].ring.slots)
     {
-        // Could not create queue
-        //
-        pthread_mutex_unlock(&queues_id_mutex);
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_open('%s') returned with errno=%d (%s)\n", name, errno, strerror(errno));
-        return 0;
+        _ringInit(&queues[i].ring, QUEUE_RING_SIZE);
     }
+    queues[i].used = true;
 
-    queues_id[i] = mqdes;
-
-    pthread_mutex_unlock(&queues_id_mutex);
+    pthread_mutex_unlock(&queues_mutex);
     return i;
 }
 
@@ -894,7 +1773,6 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
     {
         case PLATFORM_QUEUE_EVENT_NEW_1905_PACKET:
         {
-            pthread_t                     thread;
             struct interface             *p1;
             struct linux_interface_info  *interface;
 
@@ -907,23 +1785,27 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
 
             p1 = (struct interface *)data;
 
-            interface = (struct linux_interface_info *)malloc(sizeof(struct linux_interface_info));
-            if (NULL == interface)
-            {
-                // Out of memory
-                //
-                return 0;
-            }
+            interface = (struct linux_interface_info *)zmemalloc(sizeof(struct linux_interface_info));
 
             interface->queue_id              = queue_id;
             interface->interface             = p1;
+            interface->sock_1905_fd          = -1;
+            interface->sock_lldp_fd          = -1;
             memcpy(interface->al_mac_address, p1->owner->al_mac_addr, 6);
+            eventLoopTimerInit(&interface->retry_timer, _retryInterfaceCallback, interface);
+            dlist_add_tail(&linux_interfaces, &interface->l);
 
-            pthread_create(&thread, NULL, recvLoopThread, (void *)interface);
+            // Watch for the interface (dis)appearing, so that it can be
+            // reopened right away
+            //
+            _linkMonitorStart();
 
-            /** @todo This is a horrible hack to make sure the addresses are configured on the interfaces before we
-             * start sending raw packets. */
-            usleep(30000);
+            // The sockets are opened (and the addresses configured on the
+            // interface) right now, so packets sent after this function
+            // returns already reach the interface. If the interface does not
+            // exist yet, a timer keeps on retrying.
+            //
+            _openInterface(interface);
 
             // NOTE:
             //   The memory allocated by "interface" will be lost forever at this
@@ -940,30 +1822,18 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
             // provided queue.
             //
             // In our platform-dependent implementation, we have decided that
-            // ALME messages are going to be received on a dedicated thread
-            // that runs a TCP server.
-            //
-            // What we are going to do now is:
-            //
-            //   1) Create that thread
+            // ALME messages are going to be received on a TCP server whose
+            // sockets are monitored by the event loop. Every time a new packet
+            // containing ALME commands arrives on its socket the payload is
+            // forwarded to this queue.
             //
-            //   2) Tell it that everytime a new packet containing ALME
-            //      commands arrives on its socket it should forward the
-            //      payload to this queue.
-            //
-            pthread_t                thread;
-            struct almeServerThreadData  *p;
-
-            p = (struct almeServerThreadData *)malloc(sizeof(struct almeServerThreadData));
-            if (NULL == p)
+            if (0 == almeServerStart(queue_id))
             {
-                // Out of memory
+                // As with the rest of "helper" event sources, the AL can keep
+                // on working without it.
                 //
-                return 0;
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Could not start the ALME server\n");
             }
-            p->queue_id = queue_id;
-
-            pthread_create(&thread, NULL, almeServerThread, (void *)p);
 
             break;
         }
@@ -971,12 +1841,8 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
         case PLATFORM_QUEUE_EVENT_TIMEOUT:
         case PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC:
         {
-            struct eventTimeOut             *p1;
-            struct _timerHandlerThreadData  *p2;
-
-            struct sigevent      se;
-            struct itimerspec    its;
-            timer_t              timer_id;
+            struct eventTimeOut       *p1;
+            struct _timerHandlerData  *p2;
 
             p1 = (struct eventTimeOut *)data;
 
@@ -987,50 +1853,31 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
                 return 0;
             }
 
-            p2 = (struct _timerHandlerThreadData *)malloc(sizeof(struct _timerHandlerThreadData));
-            if (NULL == p2)
-            {
-                // Out of memory
-                //
-                return 0;
-            }
+            p2 = (struct _timerHandlerData *)memalloc(sizeof(struct _timerHandlerData));
 
             p2->queue_id = queue_id;
             p2->token    = p1->token;
             p2->periodic = PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC == event_type ? 1 : 0;
 
-            // Next, create the timer. Note that it will be automatically
-            // destroyed (by us) in the callback function
+            // Arm the timer. One-shot timers free 'p2' from "_timerHandler()"
             //
-            memset(&se, 0, sizeof(se));
-            se.sigev_notify          = SIGEV_THREAD;
-            se.sigev_notify_function = _timerHandler;
-            se.sigev_value.sival_ptr = (void *)p2;
-
-            if (-1 == timer_create(CLOCK_REALTIME, &se, &timer_id))
+            eventLoopTimerInit(&p2->timer, _timerHandler, p2);
+            if (0 == eventLoopTimerStart(&p2->timer, p1->timeout_ms, 1 == p2->periodic ? p1->timeout_ms : 0))
             {
-                // Failed to create a new timer
-                //
                 free(p2);
                 return 0;
             }
-            p2->timer_id = timer_id;
-
-            // Finally, arm/start the timer
-            //
-            its.it_value.tv_sec     = p1->timeout_ms / 1000;
-            its.it_value.tv_nsec    = (p1->timeout_ms % 1000) * 1000000;
-            its.it_interval.tv_sec  = PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC == event_type ? its.it_value.tv_sec  : 0;
-            its.it_interval.tv_nsec = PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC == event_type ? its.it_value.tv_nsec : 0;
-
-            if (0 != timer_settime(timer_id, 0, &its, NULL))
+            if (NULL == queues[queue_id].timers)
             {
-                // Problems arming the timer
-                //
-                free(p2);
-                timer_delete(timer_id);
-                return 0;
+                unsigned i;
+
+                queues[queue_id].timers = (dlist_head *)memalloc((MAX_TIMER_TOKEN + 1) * sizeof(dlist_head));
+                for (i = 0; i <= MAX_TIMER_TOKEN; i++)
+                {
+                    dlist_head_init(&queues[queue_id].timers[i]);
+                }
             }
+            dlist_add_tail(&queues[queue_id].timers[p1->token], &p2->l);
 
             break;
         }
@@ -1040,22 +1887,19 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
             // The AL entity is telling us that it is capable of processing
             // "push button" configuration events.
             //
-            // Create the thread in charge of generating these events.
+            // Start monitoring the sources of these events.
             //
-            pthread_t                      thread;
-            struct _pushButtonThreadData  *p;
+            struct _pushButtonData  *p;
+
+            p = (struct _pushButtonData *)memalloc(sizeof(struct _pushButtonData));
+            p->queue_id = queue_id;
 
-            p = (struct _pushButtonThreadData *)malloc(sizeof(struct _pushButtonThreadData));
-            if (NULL == p)
+            if (0 == _pushButtonStart(p))
             {
-                // Out of memory
-                //
-                return 0;
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Could not start monitoring the push button\n");
+                free(p);
             }
 
-            p->queue_id = queue_id;
-            pthread_create(&thread, NULL, _pushButtonThread, (void *)p);
-
             break;
         }
 
@@ -1076,23 +1920,18 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
             // The AL entity is telling us that it is capable of processing
             // "topology change" events.
             //
-            // We will create a new thread in charge of monitoring the local
-            // topology to generate these events.
+            // Start monitoring the local topology to generate these events.
             //
-            pthread_t                           thread;
-            struct _topologyMonitorThreadData  *p;
-
-            p = (struct _topologyMonitorThreadData *)malloc(sizeof(struct _topologyMonitorThreadData));
-            if (NULL == p)
-            {
-                // Out of memory
-                //
-                return 0;
-            }
+            struct _topologyMonitorData  *p;
 
+            p = (struct _topologyMonitorData *)memalloc(sizeof(struct _topologyMonitorData));
             p->queue_id = queue_id;
 
-            pthread_create(&thread, NULL, _topologyMonitorThread, (void *)p);
+            if (0 == _topologyMonitorStart(p))
+            {
+                PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Could not start monitoring topology changes\n");
+                free(p);
+            }
 
             break;
         }
@@ -1108,50 +1947,112 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
     return 1;
 }
 
-uint8_t PLATFORM_READ_QUEUE(uint8_t queue_id, uint8_t *message_buffer)
+const uint8_t *PLATFORM_READ_QUEUE_MESSAGE(uint8_t queue_id)
 {
-    mqd_t    mqdes;
-    ssize_t  len;
+    struct _queueBuffer *b;
+    uint16_t             payload_len;
 
-    mqdes = queues_id[queue_id];
-    if ((mqd_t) -1 == mqdes)
+    if (!queues[queue_id].used)
     {
         // Invalid ID
-        return 1;
+        return NULL;
     }
 
-    len = mq_receive(mqdes, (char *)message_buffer, MAX_NETWORK_SEGMENT_SIZE+3, NULL);
-
-    if (-1 == len)
+    // Run the event loop until some event source (or another thread) posts a
+    // message to this queue
+    //
+    while (NULL == (b = (struct _queueBuffer *)_ringPop(&queues[queue_id].ring)))
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_receive() returned with errno=%d (%s)\n", errno, strerror(errno));
-        return 0;
+        if (-1 == eventLoopRun(-1))
+        {
+            return NULL;
+        }
     }
 
+    PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Receiving %d bytes from queue (%02x, %02x, %02x, ...)\n", b->len, b->data[0], b->data[1], b->data[2]);
+
     // All messages are TLVs where the second and third bytes indicate the
     // total length of the payload. This value *must* match "len-3"
     //
-    if ( len < 0 )
+    payload_len = b->data[1] * 256 + b->data[2];
+
+    if (b->len < 3 || payload_len != b->len-3)
     {
-        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_receive() returned than 3 bytes (minimum TLV size)\n");
-        return 0;
+        PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] Queue returned %d bytes, but the TLV is %d bytes\n", b->len, payload_len+3);
+        _queueBufferPut(b);
+        return NULL;
     }
-    else
+
+    return b->data;
+}
+
+void PLATFORM_RELEASE_QUEUE_MESSAGE(const uint8_t *message)
+{
+    if (NULL != message)
     {
-        uint16_t payload_len;
+        _queueBufferPut(_queueBufferFromMessage(message));
+    }
+}
 
-        PLATFORM_PRINTF_DEBUG_DETAIL("[PLATFORM] Receiving %d bytes from queue (%02x, %02x, %02x, ...)\n", (unsigned)len, message_buffer[0], message_buffer[1], message_buffer[2]);
+void PLATFORM_DUMP_QUEUE_STATS(void (*write_function)(const char *fmt, ...))
+{
+    struct queueStats stats;
+    int               i;
 
-        payload_len = *(((uint8_t *)message_buffer)+1) * 256 + *(((uint8_t *)message_buffer)+2);
+    pthread_mutex_lock(&queues_mutex);
 
-        if (payload_len != len-3)
+    for (i=1; i<MAX_QUEUE_IDS; i++)
+    {
+        if (!queues[i].used)
         {
-            PLATFORM_PRINTF_DEBUG_ERROR("[PLATFORM] mq_receive() returned %d bytes, but the TLV is %d bytes\n", (unsigned)len, payload_len+3);
-            return 0;
+            continue;
         }
+        queueGetStats(i, &stats);
+        write_function("  queue[%d]: drops (ring full) %u, drops (no buffer) %u\n",
+                       i, stats.drops_ring_full, stats.drops_no_buffer);
+    }
+
+    pthread_mutex_unlock(&queues_mutex);
+}
+
+uint8_t PLATFORM_CANCEL_QUEUE_EVENT_TIMEOUT(uint8_t queue_id, uint32_t token)
+{
+    struct _timerHandlerData *t;
+
+    if (!queues[queue_id].used || token > MAX_TIMER_TOKEN)
+    {
+        // Invalid arguments
+        //
+        return 0;
+    }
+    if (NULL == queues[queue_id].timers)
+    {
+        return 1;
+    }
+
+    while (!dlist_empty(&queues[queue_id].timers[token]))
+    {
+        t = container_of(dlist_get_first(&queues[queue_id].timers[token]), struct _timerHandlerData, l);
+        eventLoopTimerStop(&t->timer);
+        dlist_remove(&t->l);
+        free(t);
     }
 
     return 1;
 }
 
+uint8_t PLATFORM_READ_QUEUE(uint8_t queue_id, uint8_t *message_buffer)
+{
+    const uint8_t *message;
+
+    message = PLATFORM_READ_QUEUE_MESSAGE(queue_id);
+    if (NULL == message)
+    {
+        return 0;
+    }
+
+    memcpy(message_buffer, message, 3 + message[1] * 256 + message[2]);
+    PLATFORM_RELEASE_QUEUE_MESSAGE(message);
 
+    return 1;
+}
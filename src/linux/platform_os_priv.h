@@ -66,6 +66,17 @@
 //
 uint8_t sendMessageToAlQueue(uint8_t queue_id, uint8_t *message, uint16_t message_len);
 
+// Messages dropped by queue 'queue_id' so far, either because its ring was full
+// (the AL was not reading fast enough) or because there was no free buffer to
+// receive a frame into.
+//
+struct queueStats
+{
+    uint32_t drops_ring_full;
+    uint32_t drops_no_buffer;
+};
+void queueGetStats(uint8_t queue_id, struct queueStats *stats);
+
 #endif
 
 
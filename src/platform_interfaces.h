@@ -374,6 +374,19 @@ void free_LIST_OF_1905_INTERFACES(char **x, uint8_t nr);
 //
 struct interfaceInfo *PLATFORM_GET_1905_INTERFACE_INFO(const char *interface_name);
 
+// Lightweight version of "PLATFORM_GET_1905_INTERFACE_INFO()" that only
+// retrieves what is needed to decide whether a message can be sent on an
+// interface: its MAC address, its 'is_secured' flag and its 'power_state'
+// (same meaning as in "struct interfaceInfo").
+//
+// Nothing is allocated, so it is cheap enough to be called for every
+// interface on every forwarded message.
+//
+// Returns '1' on success, '0' if the interface does not exist.
+//
+uint8_t PLATFORM_GET_1905_INTERFACE_STATE(const char *interface_name, uint8_t *mac_address, uint8_t *is_secured,
+                                          uint8_t *power_state);
+
 // Free the memory used by a "struct interfaceInfo" structure previously
 // obtained by calling "PLATFORM_GET_1905_INTERFACE_INFO()"
 //
@@ -536,6 +549,39 @@ void free_LIST_OF_BRIDGES(struct bridge *x, uint8_t nr);
 uint8_t PLATFORM_SEND_RAW_PACKET(const char *interface_name, const uint8_t *dst_mac, const uint8_t *src_mac,
                                  uint16_t eth_type, const uint8_t *payload, uint16_t payload_len);
 
+// One RAW ethernet frame to be sent with "PLATFORM_SEND_RAW_PACKETS()". Each
+// field has the same meaning as the argument with the same name of
+// "PLATFORM_SEND_RAW_PACKET()".
+//
+struct rawPacket
+{
+    const char     *interface_name;
+    const uint8_t  *dst_mac;
+    const uint8_t  *src_mac;
+    uint16_t        eth_type;
+    const uint8_t  *payload;
+    uint16_t        payload_len;
+};
+
+// Send the 'packets_nr' RAW ethernet frames contained in 'packets'.
+//
+// This is equivalent to calling "PLATFORM_SEND_RAW_PACKET()" once for each of
+// them (in the same order) but lets the platform send several frames with a
+// single system call. Consecutive frames on the same interface are batched
+// together, so callers should group frames by interface.
+//
+// If there is a problem and any of the packets cannot be sent, this function
+// returns "0", otherwise it returns "1"
+//
+uint8_t PLATFORM_SEND_RAW_PACKETS(const struct rawPacket *packets, unsigned packets_nr);
+
+// Write, using 'write_function()', how many times the sockets used by
+// "PLATFORM_SEND_RAW_PACKET()" and "PLATFORM_SEND_RAW_PACKETS()" were reused
+// ("hits"), had to be opened ("misses") or were closed because their interface
+// went away ("invalidations")
+//
+void PLATFORM_DUMP_TX_SOCKET_CACHE_STATS(void (*write_function)(const char *fmt, ...));
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Push button configuration
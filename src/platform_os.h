@@ -233,6 +233,9 @@ uint8_t PLATFORM_CREATE_QUEUE(const char *name);
 //
 //       'id_token' is the same 'id_token' used when calling this function.
 //
+//       Registering several timers with the same token is allowed. All of
+//       them can be stopped at once with "PLATFORM_CANCEL_QUEUE_EVENT_TIMEOUT()".
+//
 //   - PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC:
 //
 //       Works in the same way as "PLATFORM_QUEUE_EVENT_TIMEOUT", except that
@@ -414,6 +417,17 @@ struct eventTimeOut
 };
 uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void *data);
 
+// Stop all the timers registered on queue 'queue_id' (with
+// "PLATFORM_REGISTER_QUEUE_EVENT()" and either "PLATFORM_QUEUE_EVENT_TIMEOUT"
+// or "PLATFORM_QUEUE_EVENT_TIMEOUT_PERIODIC") whose token is 'token'.
+//
+// Note that messages of timers that expired before this call may still be
+// waiting in the queue.
+//
+// If there is a problem this function returns "0", otherwise it returns "1"
+//
+uint8_t PLATFORM_CANCEL_QUEUE_EVENT_TIMEOUT(uint8_t queue_id, uint32_t token);
+
 // Wait until a new message is available in the queue represented by 'queue_id'
 // (which is the value obtained when calling "PLATFORM_CREATE_QUEUE()"), and
 // then copy it into the provided buffer 'message_buffer'
@@ -424,4 +438,27 @@ uint8_t PLATFORM_REGISTER_QUEUE_EVENT(uint8_t queue_id, uint8_t event_type, void
 //
 uint8_t PLATFORM_READ_QUEUE(uint8_t queue_id, uint8_t *message_buffer);
 
+// Same as "PLATFORM_READ_QUEUE()" but, instead of copying the message into a
+// caller provided buffer, return a pointer to the buffer where the platform
+// stored it (so that, for example, received packets can be processed in place
+// without any further copy).
+//
+// The message stays valid until "PLATFORM_RELEASE_QUEUE_MESSAGE()" is called
+// on it. As the number of such buffers is limited, this must be done as soon
+// as the message has been processed.
+//
+// If there is a problem this function returns NULL
+//
+const uint8_t *PLATFORM_READ_QUEUE_MESSAGE(uint8_t queue_id);
+
+// Give back a message obtained with "PLATFORM_READ_QUEUE_MESSAGE()". 'message'
+// can be NULL, in which case nothing is done.
+//
+void PLATFORM_RELEASE_QUEUE_MESSAGE(const uint8_t *message);
+
+// Write, using 'write_function()', the number of messages dropped so far by
+// each queue (see "PLATFORM_CREATE_QUEUE()")
+//
+void PLATFORM_DUMP_QUEUE_STATS(void (*write_function)(const char *fmt, ...));
+
 #endif
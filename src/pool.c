@@ -0,0 +1,316 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#include "pool.h"
+#include "utils.h" // memalloc(), memfree()
+
+#include <stdint.h>
+#include <stdio.h>  // fprintf()
+#include <stdlib.h> // aligned_alloc()
+#include <string.h> // memset()
+
+////////////////////////////////////////////////////////////////////////////////
+// Private data and functions
+////////////////////////////////////////////////////////////////////////////////
+
+#define POOL_ALIGN_UP(x, a) (((x) + (a) - 1) & ~((uintptr_t)(a) - 1))
+
+#define POOL_CLASSES (POOL_MAX_OBJECT / POOL_ALIGN)
+
+// Free objects are linked through their first bytes
+//
+struct _poolFree
+{
+    struct _poolFree *next;
+};
+
+struct _poolClass
+{
+    struct _poolFree *free;
+    size_t            slabs;
+    size_t            live;
+    size_t            peak;
+    size_t            allocs;
+};
+
+// Each slab starts with this header. Slabs are aligned to POOL_SLAB_SIZE, so
+// the slab containing an object is found by masking the object address.
+//
+struct _poolSlab
+{
+    struct _poolClass *pool_class;
+};
+
+__thread size_t pool_slabs_nr;
+
+static __thread struct _poolClass pool_classes[POOL_CLASSES];
+static __thread size_t            pool_live;
+static __thread size_t            pool_peak;
+static __thread size_t            pool_allocs;
+
+// Open addressing (linear probing) table of the slabs of this thread, indexed
+// by slab number (i.e. address / POOL_SLAB_SIZE), used by pool_slab_of() to
+// tell pool memory from any other memory. Slabs are never removed.
+//
+static __thread struct _poolSlab **slab_table;
+static __thread size_t             slab_table_size; // Always a power of 2
+
+static void _outOfMemory(void)
+{
+    fprintf(stderr, "ERROR: Out of memory!\n");
+    exit(1);
+}
+
+static size_t _slabSlot(uintptr_t address)
+{
+    return (address / POOL_SLAB_SIZE) & (slab_table_size - 1);
+}
+
+static void _slabTableInsert(struct _poolSlab *slab)
+{
+    size_t i;
+
+    if (2 * (pool_slabs_nr + 1) > slab_table_size)
+    {
+        struct _poolSlab **old_table = slab_table;
+        size_t             old_size  = slab_table_size;
+
+        slab_table_size = old_size ? 2 * old_size : 64;
+        slab_table      = calloc(slab_table_size, sizeof(*slab_table));
+        if (NULL == slab_table)
+        {
+            _outOfMemory();
+        }
+        for (i = 0; i < old_size; i++)
+        {
+            if (NULL != old_table[i])
+            {
+                size_t j = _slabSlot((uintptr_t)old_table[i]);
+
+                while (NULL != slab_table[j])
+                {
+                    j = (j + 1) & (slab_table_size - 1);
+                }
+                slab_table[j] = old_table[i];
+            }
+        }
+        free(old_table);
+    }
+
+    i = _slabSlot((uintptr_t)slab);
+    while (NULL != slab_table[i])
+    {
+        i = (i + 1) & (slab_table_size - 1);
+    }
+    slab_table[i] = slab;
+    pool_slabs_nr++;
+}
+
+// Add a new slab to 'pool_class', whose objects are 'size' bytes, and put all
+// its objects in the free list.
+//
+static void _slabNew(struct _poolClass *pool_class, size_t size)
+{
+    struct _poolSlab *slab;
+    uintptr_t         first;
+    size_t            i;
+
+    slab = aligned_alloc(POOL_SLAB_SIZE, POOL_SLAB_SIZE);
+    if (NULL == slab)
+    {
+        _outOfMemory();
+    }
+    slab->pool_class = pool_class;
+    _slabTableInsert(slab);
+    pool_class->slabs++;
+
+    // Push the objects backwards, so that they are handed out in address order
+    //
+    first = POOL_ALIGN_UP((uintptr_t)(slab + 1), POOL_ALIGN);
+    for (i = ((uintptr_t)slab + POOL_SLAB_SIZE - first) / size; i-- > 0; )
+    {
+        struct _poolFree *item = (struct _poolFree *)(first + i * size);
+
+        item->next       = pool_class->free;
+        pool_class->free = item;
+    }
+}
+
+static size_t _classSize(const struct _poolClass *pool_class)
+{
+    return (size_t)(pool_class - pool_classes + 1) * POOL_ALIGN;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Public API
+////////////////////////////////////////////////////////////////////////////////
+
+void *pool_zalloc(size_t size)
+{
+    struct _poolClass *pool_class;
+    struct _poolFree  *object;
+
+    if (NULL != arena_current || size > POOL_MAX_OBJECT)
+    {
+        return zmemalloc(size);
+    }
+
+    pool_class = &pool_classes[(0 == size ? 0 : size - 1) / POOL_ALIGN];
+    if (NULL == pool_class->free)
+    {
+        _slabNew(pool_class, _classSize(pool_class));
+    }
+
+    object           = pool_class->free;
+    pool_class->free = object->next;
+
+    pool_class->allocs++;
+    pool_class->live++;
+    if (pool_class->live > pool_class->peak)
+    {
+        pool_class->peak = pool_class->live;
+    }
+    pool_allocs++;
+    pool_live++;
+    if (pool_live > pool_peak)
+    {
+        pool_peak = pool_live;
+    }
+
+    return memset(object, 0, _classSize(pool_class));
+}
+
+void pool_free(void *ptr)
+{
+    struct _poolClass *pool_class;
+    struct _poolFree  *object;
+
+    if (!pool_owns(ptr))
+    {
+        memfree(ptr);
+        return;
+    }
+
+    pool_class = ((struct _poolSlab *)((uintptr_t)ptr & ~((uintptr_t)POOL_SLAB_SIZE - 1)))->pool_class;
+
+    object           = ptr;
+    object->next     = pool_class->free;
+    pool_class->free = object;
+
+    pool_class->live--;
+    pool_live--;
+}
+
+bool pool_slab_of(const void *ptr)
+{
+    uintptr_t base = (uintptr_t)ptr & ~((uintptr_t)POOL_SLAB_SIZE - 1);
+    size_t    i;
+
+    i = _slabSlot(base);
+    while (NULL != slab_table[i])
+    {
+        if ((uintptr_t)slab_table[i] == base)
+        {
+            return true;
+        }
+        i = (i + 1) & (slab_table_size - 1);
+    }
+
+    return false;
+}
+
+void pool_stats(size_t size, struct poolStats *stats)
+{
+    size_t i;
+
+    if (0 == size)
+    {
+        stats->live   = pool_live;
+        stats->peak   = pool_peak;
+        stats->bytes  = pool_slabs_nr * POOL_SLAB_SIZE;
+        stats->allocs = pool_allocs;
+    }
+    else if (size > POOL_MAX_OBJECT)
+    {
+        memset(stats, 0, sizeof(*stats));
+    }
+    else
+    {
+        i = (size - 1) / POOL_ALIGN;
+
+        stats->live   = pool_classes[i].live;
+        stats->peak   = pool_classes[i].peak;
+        stats->bytes  = pool_classes[i].slabs * POOL_SLAB_SIZE;
+        stats->allocs = pool_classes[i].allocs;
+    }
+}
+
+void pool_dump(void (*write_function)(const char *fmt, ...))
+{
+    size_t i;
+
+    write_function("  pools: live %zu, peak %zu, bytes %zu\n", pool_live, pool_peak, pool_slabs_nr * POOL_SLAB_SIZE);
+
+    for (i = 0; i < POOL_CLASSES; i++)
+    {
+        if (0 != pool_classes[i].slabs)
+        {
+            write_function("  pool[%zu bytes]: live %zu, peak %zu, bytes %zu\n", _classSize(&pool_classes[i]),
+                           pool_classes[i].live, pool_classes[i].peak, pool_classes[i].slabs * POOL_SLAB_SIZE);
+        }
+    }
+}
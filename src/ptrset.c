@@ -0,0 +1,194 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#include <ptrset.h>
+#include <stdint.h> /* uintptr_t */
+
+/* Marks the slots of removed keys, so that lookups continue past them. */
+static const char ptrset_deleted;
+#define PTRSET_DELETED ((const void *)&ptrset_deleted)
+
+#define PTRSET_INDEX_MIN_SIZE 32
+
+/* Home slot of @a key. Fibonacci hashing: the high bits of the product depend on all the bits of the key, whereas the
+ * low bits only depend on its low bits, which are all alike for pool allocated objects. */
+static unsigned ptrsetHash(const struct ptrsetIndex *index, const void *key)
+{
+    uint64_t k = (uintptr_t)key;
+
+    return (unsigned)((k * 0x9E3779B97F4A7C15ull) >> (64 - __builtin_ctz(index->size)));
+}
+
+static struct ptrsetIndexSlot *ptrsetIndexLookup(const struct ptrsetIndex *index, const void *key)
+{
+    unsigned i = ptrsetHash(index, key);
+
+    while (index->slots[i].key != NULL)
+    {
+        if (index->slots[i].key == key)
+        {
+            return &index->slots[i];
+        }
+        i = (i + 1) & (index->size - 1);
+    }
+    return NULL;
+}
+
+/* Rehash the live keys into a table where they take at most 1/4 of the slots. The table is not simply doubled because
+ * it may be mostly full of removed keys (ie. with clients that keep associating and leaving). */
+static void ptrsetIndexResize(struct ptrsetIndex *index)
+{
+    struct ptrsetIndexSlot *old_slots = index->slots;
+    unsigned old_size = index->size;
+    unsigned live = 0;
+    unsigned size = PTRSET_INDEX_MIN_SIZE;
+    unsigned i;
+
+    for (i = 0; i < old_size; i++)
+    {
+        if (old_slots[i].key != NULL && old_slots[i].key != PTRSET_DELETED)
+        {
+            live++;
+        }
+    }
+    while ((live + 1) * 4 > size)
+    {
+        size *= 2;
+    }
+
+    index->slots = zmemalloc(size * sizeof(*index->slots));
+    index->size = size;
+    index->used = 0;
+
+    for (i = 0; i < old_size; i++)
+    {
+        if (old_slots[i].key != NULL && old_slots[i].key != PTRSET_DELETED)
+        {
+            ptrsetIndexSet(index, old_slots[i].key, old_slots[i].pos);
+        }
+    }
+    memfree(old_slots);
+}
+
+void ptrsetIndexSet(struct ptrsetIndex *index, const void *key, unsigned pos)
+{
+    struct ptrsetIndexSlot *slot;
+    unsigned i;
+
+    if (index->size != 0)
+    {
+        slot = ptrsetIndexLookup(index, key);
+        if (slot != NULL)
+        {
+            slot->pos = pos;
+            return;
+        }
+    }
+
+    /* Keep the load factor (including removed keys) below 1/2. */
+    if ((index->used + 1) * 2 > index->size)
+    {
+        ptrsetIndexResize(index);
+    }
+
+    i = ptrsetHash(index, key);
+    while (index->slots[i].key != NULL && index->slots[i].key != PTRSET_DELETED)
+    {
+        i = (i + 1) & (index->size - 1);
+    }
+    if (index->slots[i].key == NULL)
+    {
+        index->used++;
+    }
+    index->slots[i].key = key;
+    index->slots[i].pos = pos;
+}
+
+unsigned ptrsetIndexGet(const struct ptrsetIndex *index, const void *key)
+{
+    struct ptrsetIndexSlot *slot;
+
+    if (index->size == 0)
+    {
+        return UINT_MAX;
+    }
+    slot = ptrsetIndexLookup(index, key);
+    return slot == NULL ? UINT_MAX : slot->pos;
+}
+
+void ptrsetIndexRemove(struct ptrsetIndex *index, const void *key)
+{
+    struct ptrsetIndexSlot *slot;
+
+    if (index->size == 0)
+    {
+        return;
+    }
+    slot = ptrsetIndexLookup(index, key);
+    if (slot != NULL)
+    {
+        slot->key = PTRSET_DELETED;
+    }
+}
+
+void ptrsetIndexClear(struct ptrsetIndex *index)
+{
+    memfree(index->slots);
+    index->slots = NULL;
+    index->size = 0;
+    index->used = 0;
+}
@@ -66,6 +66,12 @@
 #include <string.h> // memcpy, strerror
 #include <stdio.h>  // snprintf
 
+bool tlv_codegen_disabled = false;
+
+/* True if virtual function @a f of @a desc must be used instead of the default implementation. */
+#define TLV_STRUCT_VIRTUAL(desc, f) \
+    ((desc)->f != NULL && !(tlv_codegen_disabled && ((desc)->codegen & tlv_struct_codegen_##f)))
+
 const struct tlv_def *tlv_find_def(tlv_defs_t defs, uint8_t tlv_type)
 {
     return &defs[tlv_type];
@@ -93,7 +99,7 @@ static struct tlv_struct *tlv_struct_parse_single(const struct tlv_struct_descri
 {
     size_t i;
 
-    if (desc->parse != NULL)
+    if (TLV_STRUCT_VIRTUAL(desc, parse))
         return desc->parse(desc, parent, buffer, length);
 
     struct tlv_struct *item = container_of(hlist_alloc(desc->size, parent), struct tlv_struct, h);
@@ -105,11 +111,14 @@ static struct tlv_struct *tlv_struct_parse_single(const struct tlv_struct_descri
     }
     for (i = 0; i < ARRAY_SIZE(item->h.children) && item->desc->children[i] != NULL; i++)
     {
-        tlv_struct_parse_list(item->desc->children[i], &item->h.children[i], buffer, length);
+        if (!tlv_struct_parse_list(item->desc->children[i], &item->h.children[i], buffer, length))
+            goto err_out;
     }
     return item;
 
 err_out:
+    /* hlist_delete_item() only deletes items that are not in a list anymore. */
+    dlist_remove(&item->h.l);
     hlist_delete_item(&item->h);
     return NULL;
 }
@@ -120,7 +129,8 @@ bool tlv_struct_parse_list(const struct tlv_struct_description *desc, dlist_head
     uint8_t children_nr;
     uint8_t j;
 
-    _E1BL(buffer, &children_nr, length);
+    if (!_E1BL(buffer, &children_nr, length))
+        return false;
     for (j = 0; j < children_nr; j++)
     {
         const struct tlv_struct *child = tlv_struct_parse_single(desc, parent, buffer, length);
@@ -156,7 +166,7 @@ bool tlv_parse(tlv_defs_t defs, dlist_head *tlvs, const uint8_t *buffer, size_t
             struct tlv_unknown *tlv;
             PLATFORM_PRINTF_DEBUG_WARNING("Unknown TLV type %u of length %u\n",
                                           (unsigned)tlv_type, (unsigned)tlv_length);
-            tlv = memalloc(sizeof(struct tlv_unknown));
+            tlv = container_of(hlist_alloc(sizeof(struct tlv_unknown), NULL), struct tlv_unknown, tlv.s.h);
             tlv->value = memalloc(tlv_length);
             tlv->length = tlv_length_uint16;
             memcpy(tlv->value, buffer, tlv_length);
@@ -167,7 +177,8 @@ bool tlv_parse(tlv_defs_t defs, dlist_head *tlvs, const uint8_t *buffer, size_t
             /* Special case for 0-length TLVs */
             if (tlv_length == 0)
             {
-                tlv_new = memalloc(sizeof(struct tlv));
+                tlv_new = container_of(hlist_alloc(tlv_def->desc.size, NULL), struct tlv, s.h);
+                tlv_new->s.desc = &tlv_def->desc;
             }
             else
             {
@@ -229,7 +240,7 @@ bool tlv_struct_forge_field(const struct tlv_struct *item, const struct tlv_stru
 static bool tlv_struct_forge_single(const struct tlv_struct *item, uint8_t **buffer, size_t *length)
 {
     size_t i;
-    if (item->desc->forge != NULL)
+    if (TLV_STRUCT_VIRTUAL(item->desc, forge))
         return item->desc->forge(item, buffer, length);
 
     for (i = 0; i < ARRAY_SIZE(item->desc->fields) && item->desc->fields[i].name != NULL; i++)
@@ -269,7 +280,7 @@ static size_t tlv_length_single(const struct tlv_struct *item)
     size_t length = 0;
     size_t i;
 
-    if (item->desc->length != NULL)
+    if (TLV_STRUCT_VIRTUAL(item->desc, length))
         return item->desc->length(item);
 
     for (i = 0; i < ARRAY_SIZE(item->desc->fields) && item->desc->fields[i].name != NULL; i++)
@@ -300,6 +311,31 @@ size_t tlv_struct_length_list(const dlist_head *parent)
 }
 
 
+size_t tlv_forged_length(const struct tlv *tlv)
+{
+    /* Add 3 bytes for type + length */
+    return 3 + tlv_length_single(&tlv->s);
+}
+
+bool tlv_forge_into(const struct tlv *tlv, uint8_t **buffer, size_t *length)
+{
+    size_t tlv_length = tlv_length_single(&tlv->s);
+    uint16_t tlv_length_u16 = (uint16_t)tlv_length;
+
+    if (tlv_length > UINT16_MAX)
+    {
+        PLATFORM_PRINTF_DEBUG_ERROR("TLV length for %s to large: %llu\n",
+                                    tlv->s.desc->name, (unsigned long long) tlv_length);
+        return false;
+    }
+
+    if (!_I1BL(&tlv->type, buffer, length))
+        return false;
+    if (!_I2BL(&tlv_length_u16, buffer, length))
+        return false;
+    return tlv_struct_forge_single(&tlv->s, buffer, length);
+}
+
 bool tlv_forge(tlv_defs_t defs, const dlist_head *tlvs, size_t max_length, uint8_t **buffer, size_t *length)
 {
     size_t total_length;
@@ -317,9 +353,7 @@ bool tlv_forge(tlv_defs_t defs, const dlist_head *tlvs, size_t max_length, uint8
         }
         else
         {
-            /* Add 3 bytes for type + length */
-            total_length += 3;
-            total_length += tlv_length_single(&tlv->s);
+            total_length += tlv_forged_length(tlv);
         }
     }
 
@@ -337,21 +371,7 @@ bool tlv_forge(tlv_defs_t defs, const dlist_head *tlvs, size_t max_length, uint8
     p = *buffer;
     hlist_for_each(tlv, *tlvs, struct tlv, s.h)
     {
-        size_t tlv_length = tlv_length_single(&tlv->s);
-        uint16_t tlv_length_u16 = (uint16_t)tlv_length;
-
-        if (tlv_length > UINT16_MAX)
-        {
-            PLATFORM_PRINTF_DEBUG_ERROR("TLV length for %s to large: %llu\n",
-                                        tlv->s.desc->name, (unsigned long long) tlv_length);
-            goto err_out;
-        }
-
-        if (!_I1BL(&tlv->type, &p, &total_length))
-            goto err_out;
-        if (!_I2BL(&tlv_length_u16, &p, &total_length))
-            goto err_out;
-        if (!tlv_struct_forge_single(&tlv->s, &p, &total_length))
+        if (!tlv_forge_into(tlv, &p, &total_length))
             goto err_out;
     }
     if (total_length != 0)
@@ -360,7 +380,7 @@ bool tlv_forge(tlv_defs_t defs, const dlist_head *tlvs, size_t max_length, uint8
 
 err_out:
     PLATFORM_PRINTF_DEBUG_ERROR("TLV list forging implementation error.\n");
-    free(*buffer);
+    memfree(*buffer);
     return false;
 }
 
@@ -402,7 +422,7 @@ int tlv_struct_compare(const struct tlv_struct *item1, const struct tlv_struct *
     int ret;
     unsigned i;
 
-    if (item1->desc->compare != NULL)
+    if (TLV_STRUCT_VIRTUAL(item1->desc, compare))
         return item1->desc->compare(item1, item2);
 
     assert(item1->desc == item2->desc);
@@ -542,6 +562,11 @@ void tlv_struct_print_field(const struct tlv_struct *item, const struct tlv_stru
                            uvalue[15]);
             break;
 
+        case tlv_struct_print_format_string:
+            write_function("%s%s: ", prefix, field_desc->name);
+            write_function("%.*s", (int)strnlen(pvalue, field_desc->size), pvalue);
+            break;
+
         default:
             assert(0);
             break;
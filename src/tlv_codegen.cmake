@@ -0,0 +1,489 @@
+# Copyright (c) 2018, prpl Foundation
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# Subject to the terms and conditions of this license, each copyright
+# holder and contributor hereby grants to those receiving rights under
+# this license a perpetual, worldwide, non-exclusive, no-charge,
+# royalty-free, irrevocable (except for failure to satisfy the
+# conditions of this license) patent license to make, have made, use,
+# offer to sell, sell, import, and otherwise transfer this software,
+# where such license applies only to those patent claims, already
+# acquired or hereafter acquired, licensable by such copyright holder or
+# contributor that are necessarily infringed by:
+#
+# (a) their Contribution(s) (the licensed copyrights of copyright holders
+#     and non-copyrightable additions of contributors, in source or binary
+#     form) alone; or
+#
+# (b) combination of their Contribution(s) with the work of authorship to
+#     which such Contribution(s) was added by such copyright holder or
+#     contributor, if, at the time the Contribution is added, such addition
+#     causes such combination to be necessarily infringed. The patent
+#     license shall not apply to any other combinations which include the
+#     Contribution.
+#
+# Except as expressly stated above, no rights or licenses from any
+# copyright holder or contributor is granted under this license, whether
+# expressly, by implication, estoppel or otherwise.
+#
+# DISCLAIMER
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+# IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+# TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+# PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+# TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+# USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+# DAMAGE.
+
+# Generate specialized parse, length, forge and compare functions from the
+# TLV descriptions found in a C source file.
+#
+# Usage: cmake -DINPUT=<file.c> -DOUTPUT=<file.h> -P tlv_codegen.cmake
+#
+# Both "struct tlv_struct_description <name> = { ... };" definitions and
+# "TLV_DEF_ENTRY_<n>FIELDS(...)" entries are recognized. For each of them,
+# functions equivalent to the generic ones in tlv.c are generated, except for
+# the virtual functions that the description already overrides. Every field
+# becomes a fixed-size load or store (the field size is a compile time
+# constant) and children are handled by calling the generated functions of the
+# child description directly.
+#
+# The generated file must be included by <file.c> after the TLV structures are
+# declared and before the descriptions are defined. Each description picks up
+# its functions with "TLV_STRUCT_CODEGEN(<name>)" (TLV_DEF_ENTRY_<n>FIELDS
+# does that automatically).
+
+cmake_minimum_required(VERSION 3.4)
+
+if (NOT INPUT OR NOT OUTPUT)
+    message(FATAL_ERROR "Usage: cmake -DINPUT=<file.c> -DOUTPUT=<file.h> -P tlv_codegen.cmake")
+endif ()
+
+set(ws "[ \t\r\n]*")
+set(ops parse length forge compare)
+
+file(READ ${INPUT} src)
+string(REGEX REPLACE "/\\*([^*]|\\*+[^*/])*\\*+/" "" src "${src}")
+string(REGEX REPLACE "//[^\n]*" "" src "${src}")
+
+# Collect the descriptions. For each description <name>, the following
+# variables are set:
+#   <name>_type      C type of the structure
+#   <name>_fields    Names of the fields
+#   <name>_children  Names of the child descriptions
+#   <name>_<op>      TRUE if function <op> must be generated
+#
+set(names)
+
+macro(add_description name type fields children body)
+    list(FIND names ${name} found)
+    if (found EQUAL -1)
+        list(APPEND names ${name})
+        set(${name}_type "${type}")
+        set(${name}_fields ${fields})
+        set(${name}_children ${children})
+        foreach (op ${ops})
+            if ("${body}" MATCHES "\\.${op}${ws}=")
+                set(${name}_${op} FALSE)
+            else ()
+                set(${name}_${op} TRUE)
+            endif ()
+        endforeach ()
+    endif ()
+endmacro()
+
+string(REGEX MATCHALL "struct tlv_struct_description${ws}[A-Za-z0-9_]+${ws}=${ws}{[^;]*}${ws};" descs "${src}")
+foreach (desc ${descs})
+    string(REGEX REPLACE "^struct tlv_struct_description${ws}([A-Za-z0-9_]+).*" "\\1" name "${desc}")
+    string(REGEX REPLACE ".*\\.size${ws}=${ws}sizeof\\(([^)]*)\\).*" "\\1" type "${desc}")
+
+    set(fields)
+    string(REGEX MATCHALL "TLV_STRUCT_FIELD_DESCRIPTION\\([^,]*,${ws}[A-Za-z0-9_]+" field_descs "${desc}")
+    foreach (field_desc ${field_descs})
+        string(REGEX REPLACE ".*,${ws}" "" field "${field_desc}")
+        list(APPEND fields ${field})
+    endforeach ()
+
+    set(children)
+    if ("${desc}" MATCHES "\\.children${ws}=${ws}{([^}]*)}")
+        string(REGEX MATCHALL "&${ws}[A-Za-z0-9_]+" child_refs "${CMAKE_MATCH_1}")
+        foreach (child_ref ${child_refs})
+            string(REGEX REPLACE "&${ws}" "" child "${child_ref}")
+            list(APPEND children ${child})
+        endforeach ()
+    endif ()
+
+    add_description(${name} "${type}" "${fields}" "${children}" "${desc}")
+endforeach ()
+
+string(REGEX MATCHALL "TLV_DEF_ENTRY_[0-9]FIELDS\\([^()]*\\)" entries "${src}")
+foreach (entry ${entries})
+    string(REGEX REPLACE "^TLV_DEF_ENTRY_([0-9])FIELDS.*" "\\1" fields_nr "${entry}")
+    string(REGEX REPLACE "^TLV_DEF_ENTRY_[0-9]FIELDS\\((.*)\\)$" "\\1" args "${entry}")
+    string(REGEX REPLACE "[ \t\r\n]" "" args "${args}")
+    string(REPLACE "," ";" args "${args}")
+
+    list(GET args 0 name)
+    list(GET args 2 child)
+    set(children)
+    if (NOT child STREQUAL "NULL")
+        string(REPLACE "&" "" child "${child}")
+        list(APPEND children ${child})
+    endif ()
+
+    set(fields)
+    if (fields_nr GREATER 0)
+        math(EXPR last "${fields_nr} - 1")
+        foreach (i RANGE ${last})
+            math(EXPR arg "3 + 2 * ${i}")
+            list(GET args ${arg} field)
+            list(APPEND fields ${field})
+        endforeach ()
+    endif ()
+
+    add_description(${name} "struct ${name}TLV" "${fields}" "${children}" "${entry}")
+endforeach ()
+
+# The "_list" variants are only needed for child descriptions, and only for
+# the functions that are generated for their parent too (a hand-written parent
+# function doesn't call them)
+#
+foreach (op ${ops})
+    set(${op}_child_names)
+endforeach ()
+foreach (name ${names})
+    foreach (op ${ops})
+        if (${name}_${op})
+            list(APPEND ${op}_child_names ${${name}_children})
+        endif ()
+    endforeach ()
+endforeach ()
+
+# Generate the code
+#
+get_filename_component(input_name ${INPUT} NAME)
+set(prototypes "")
+set(functions "")
+set(macros "")
+
+foreach (name ${names})
+    set(type "${${name}_type}")
+    set(fields ${${name}_fields})
+    set(children ${${name}_children})
+
+    # Sum of the sizes of all fields, as a C expression
+    #
+    set(fixed_length "")
+    foreach (field ${fields})
+        if (fixed_length)
+            string(APPEND fixed_length " + ")
+        endif ()
+        string(APPEND fixed_length "sizeof(self->${field})")
+    endforeach ()
+
+    set(ops_initializer "")
+    set(codegen_flags "")
+
+    if (${name}_parse)
+        string(APPEND prototypes
+            "static struct tlv_struct *${name}_codegen_parse(const struct tlv_struct_description *desc, dlist_head *parent,\n"
+            "    const uint8_t **buffer, size_t *length);\n")
+        string(APPEND functions
+            "static struct tlv_struct *${name}_codegen_parse(const struct tlv_struct_description *desc, dlist_head *parent,\n"
+            "    const uint8_t **buffer, size_t *length)\n"
+            "{\n"
+            "    struct tlv_struct *item = container_of(hlist_alloc(sizeof(${type}), parent), struct tlv_struct, h);\n")
+        if (fields)
+            string(APPEND functions
+                "    ${type} *self = (${type} *)item;\n"
+                "\n"
+                "    item->desc = desc;\n"
+                "    if (*length < ${fixed_length})\n"
+                "        goto err_out;\n"
+                "    *length -= ${fixed_length};\n")
+            foreach (field ${fields})
+                string(APPEND functions "    _TLV_CODEGEN_LOAD(buffer, self->${field});\n")
+            endforeach ()
+        else ()
+            string(APPEND functions
+                "\n"
+                "    item->desc = desc;\n")
+        endif ()
+        set(i 0)
+        foreach (child ${children})
+            if (${child}_parse)
+                set(parse_list "${child}_codegen_parse_list")
+            else ()
+                set(parse_list "tlv_struct_parse_list")
+            endif ()
+            string(APPEND functions
+                "    if (!${parse_list}(desc->children[${i}], &item->h.children[${i}], buffer, length))\n"
+                "        goto err_out;\n")
+            math(EXPR i "${i} + 1")
+        endforeach ()
+        string(APPEND functions
+            "    return item;\n"
+            "\n"
+            "err_out:\n"
+            "    dlist_remove(&item->h.l);\n"
+            "    hlist_delete_item(&item->h);\n"
+            "    return NULL;\n"
+            "}\n"
+            "\n")
+        list(FIND parse_child_names ${name} is_child)
+        if (NOT is_child EQUAL -1)
+            string(APPEND prototypes
+                "static bool ${name}_codegen_parse_list(const struct tlv_struct_description *desc, dlist_head *parent,\n"
+                "    const uint8_t **buffer, size_t *length);\n")
+            string(APPEND functions
+                "static bool ${name}_codegen_parse_list(const struct tlv_struct_description *desc, dlist_head *parent,\n"
+                "    const uint8_t **buffer, size_t *length)\n"
+                "{\n"
+                "    uint8_t children_nr;\n"
+                "    uint8_t i;\n"
+                "\n"
+                "    if (!_E1BL(buffer, &children_nr, length))\n"
+                "        return false;\n"
+                "    for (i = 0; i < children_nr; i++)\n"
+                "    {\n"
+                "        if (${name}_codegen_parse(desc, parent, buffer, length) == NULL)\n"
+                "            return false;\n"
+                "    }\n"
+                "    return true;\n"
+                "}\n"
+                "\n")
+        endif ()
+        string(APPEND ops_initializer " .parse = ${name}_codegen_parse,")
+        list(APPEND codegen_flags tlv_struct_codegen_parse)
+    endif ()
+
+    if (${name}_length)
+        string(APPEND prototypes
+            "static size_t ${name}_codegen_length(const struct tlv_struct *item);\n")
+        string(APPEND functions
+            "static size_t ${name}_codegen_length(const struct tlv_struct *item)\n"
+            "{\n")
+        if (fields)
+            string(APPEND functions
+                "    const ${type} *self = (const ${type} *)item;\n"
+                "    size_t length = ${fixed_length};\n")
+        else ()
+            string(APPEND functions
+                "    size_t length = 0;\n")
+        endif ()
+        string(APPEND functions "\n")
+        if (NOT children)
+            string(APPEND functions "    (void)item;\n")
+        endif ()
+        set(i 0)
+        foreach (child ${children})
+            if (${child}_length)
+                set(length_list "${child}_codegen_length_list")
+            else ()
+                set(length_list "tlv_struct_length_list")
+            endif ()
+            string(APPEND functions "    length += ${length_list}(&item->h.children[${i}]);\n")
+            math(EXPR i "${i} + 1")
+        endforeach ()
+        string(APPEND functions
+            "    return length;\n"
+            "}\n"
+            "\n")
+        list(FIND length_child_names ${name} is_child)
+        if (NOT is_child EQUAL -1)
+            string(APPEND prototypes
+                "static size_t ${name}_codegen_length_list(const dlist_head *parent);\n")
+            string(APPEND functions
+                "static size_t ${name}_codegen_length_list(const dlist_head *parent)\n"
+                "{\n"
+                "    const struct tlv_struct *child;\n"
+                "    size_t length = 1;\n"
+                "\n"
+                "    hlist_for_each(child, *parent, const struct tlv_struct, h)\n"
+                "    {\n"
+                "        length += ${name}_codegen_length(child);\n"
+                "    }\n"
+                "    return length;\n"
+                "}\n"
+                "\n")
+        endif ()
+        string(APPEND ops_initializer " .length = ${name}_codegen_length,")
+        list(APPEND codegen_flags tlv_struct_codegen_length)
+    endif ()
+
+    if (${name}_forge)
+        string(APPEND prototypes
+            "static bool ${name}_codegen_forge(const struct tlv_struct *item, uint8_t **buffer, size_t *length);\n")
+        string(APPEND functions
+            "static bool ${name}_codegen_forge(const struct tlv_struct *item, uint8_t **buffer, size_t *length)\n"
+            "{\n")
+        if (fields)
+            string(APPEND functions
+                "    const ${type} *self = (const ${type} *)item;\n"
+                "\n"
+                "    if (*length < ${fixed_length})\n"
+                "        return false;\n"
+                "    *length -= ${fixed_length};\n")
+            foreach (field ${fields})
+                string(APPEND functions "    _TLV_CODEGEN_STORE(self->${field}, buffer);\n")
+            endforeach ()
+        elseif (NOT children)
+            string(APPEND functions "    (void)item;\n")
+        endif ()
+        set(i 0)
+        foreach (child ${children})
+            if (${child}_forge)
+                set(forge_list "${child}_codegen_forge_list")
+            else ()
+                set(forge_list "tlv_struct_forge_list")
+            endif ()
+            string(APPEND functions
+                "    if (!${forge_list}(&item->h.children[${i}], buffer, length))\n"
+                "        return false;\n")
+            math(EXPR i "${i} + 1")
+        endforeach ()
+        string(APPEND functions
+            "    return true;\n"
+            "}\n"
+            "\n")
+        list(FIND forge_child_names ${name} is_child)
+        if (NOT is_child EQUAL -1)
+            string(APPEND prototypes
+                "static bool ${name}_codegen_forge_list(const dlist_head *parent, uint8_t **buffer, size_t *length);\n")
+            string(APPEND functions
+                "static bool ${name}_codegen_forge_list(const dlist_head *parent, uint8_t **buffer, size_t *length)\n"
+                "{\n"
+                "    const struct tlv_struct *child;\n"
+                "    unsigned children_nr = dlist_count(parent);\n"
+                "    uint8_t children_nr_uint8 = (uint8_t)children_nr;\n"
+                "\n"
+                "    if (children_nr > UINT8_MAX)\n"
+                "    {\n"
+                "        PLATFORM_PRINTF_DEBUG_WARNING(\"TLV with more than 255 children.\\n\");\n"
+                "        return false;\n"
+                "    }\n"
+                "    if (!_I1BL(&children_nr_uint8, buffer, length))\n"
+                "        return false;\n"
+                "    hlist_for_each(child, *parent, const struct tlv_struct, h)\n"
+                "    {\n"
+                "        if (!${name}_codegen_forge(child, buffer, length))\n"
+                "            return false;\n"
+                "    }\n"
+                "    return true;\n"
+                "}\n"
+                "\n")
+        endif ()
+        string(APPEND ops_initializer " .forge = ${name}_codegen_forge,")
+        list(APPEND codegen_flags tlv_struct_codegen_forge)
+    endif ()
+
+    if (${name}_compare)
+        string(APPEND prototypes
+            "static int ${name}_codegen_compare(const struct tlv_struct *item1, const struct tlv_struct *item2);\n")
+        string(APPEND functions
+            "static int ${name}_codegen_compare(const struct tlv_struct *item1, const struct tlv_struct *item2)\n"
+            "{\n"
+            "    int ret;\n"
+            "\n"
+            "    ret = memcmp((const char *)item1 + sizeof(struct tlv_struct), (const char *)item2 + sizeof(struct tlv_struct),\n"
+            "                 sizeof(${type}) - sizeof(struct tlv_struct));\n")
+        set(i 0)
+        foreach (child ${children})
+            if (${child}_compare)
+                set(compare_list "${child}_codegen_compare_list")
+            else ()
+                set(compare_list "tlv_struct_compare_list")
+            endif ()
+            string(APPEND functions
+                "    if (ret == 0)\n"
+                "        ret = ${compare_list}(&item1->h.children[${i}], &item2->h.children[${i}]);\n")
+            math(EXPR i "${i} + 1")
+        endforeach ()
+        string(APPEND functions
+            "    return ret;\n"
+            "}\n"
+            "\n")
+        list(FIND compare_child_names ${name} is_child)
+        if (NOT is_child EQUAL -1)
+            string(APPEND prototypes
+                "static int ${name}_codegen_compare_list(const dlist_head *h1, const dlist_head *h2);\n")
+            string(APPEND functions
+                "static int ${name}_codegen_compare_list(const dlist_head *h1, const dlist_head *h2)\n"
+                "{\n"
+                "    const dlist_head *cur1;\n"
+                "    const dlist_head *cur2;\n"
+                "    int ret = 0;\n"
+                "\n"
+                "    for (cur1 = h1->next, cur2 = h2->next;\n"
+                "         ret == 0 && cur1 != h1 && cur2 != h2;\n"
+                "         cur1 = cur1->next, cur2 = cur2->next)\n"
+                "    {\n"
+                "        ret = ${name}_codegen_compare(container_of(cur1, struct tlv_struct, h.l),\n"
+                "                                      container_of(cur2, struct tlv_struct, h.l));\n"
+                "    }\n"
+                "    if (ret == 0)\n"
+                "        ret = (cur1 != h1) ? 1 : ((cur2 != h2) ? -1 : 0);\n"
+                "    return ret;\n"
+                "}\n"
+                "\n")
+        endif ()
+        string(APPEND ops_initializer " .compare = ${name}_codegen_compare,")
+        list(APPEND codegen_flags tlv_struct_codegen_compare)
+    endif ()
+
+    if (codegen_flags)
+        string(REPLACE ";" " | " codegen_flags "${codegen_flags}")
+        string(APPEND ops_initializer " .codegen = ${codegen_flags},")
+    endif ()
+    string(APPEND macros "#define TLV_CODEGEN_OPS_${name}${ops_initializer}\n")
+endforeach ()
+
+file(WRITE ${OUTPUT}
+    "/* Generated by tlv_codegen.cmake from ${input_name}. Do not edit. */\n"
+    "\n"
+    "/* Requires tlv.h, packet_tools.h and <string.h>, which the including file already uses. */\n"
+    "\n"
+    "/* The field size is a compile time constant, so only one of the cases remains. */\n"
+    "#define _TLV_CODEGEN_LOAD(buffer, field) \\\n"
+    "    do { \\\n"
+    "        switch (sizeof(field)) \\\n"
+    "        { \\\n"
+    "            case 1:  _E1B(buffer, (uint8_t *)&(field)); break; \\\n"
+    "            case 2:  _E2B(buffer, (uint16_t *)&(field)); break; \\\n"
+    "            case 4:  _E4B(buffer, (uint32_t *)&(field)); break; \\\n"
+    "            default: _EnB(buffer, &(field), sizeof(field)); break; \\\n"
+    "        } \\\n"
+    "    } while (0)\n"
+    "\n"
+    "#define _TLV_CODEGEN_STORE(field, buffer) \\\n"
+    "    do { \\\n"
+    "        switch (sizeof(field)) \\\n"
+    "        { \\\n"
+    "            case 1:  _I1B((const uint8_t *)&(field), buffer); break; \\\n"
+    "            case 2:  _I2B((const uint16_t *)&(field), buffer); break; \\\n"
+    "            case 4:  _I4B((const uint32_t *)&(field), buffer); break; \\\n"
+    "            default: _InB(&(field), buffer, sizeof(field)); break; \\\n"
+    "        } \\\n"
+    "    } while (0)\n"
+    "\n"
+    "${prototypes}\n"
+    "${functions}"
+    "${macros}\n"
+    "#undef TLV_STRUCT_CODEGEN\n"
+    "#define TLV_STRUCT_CODEGEN(name) TLV_CODEGEN_OPS_##name\n")
@@ -69,7 +69,8 @@
 #include <stdio.h>  // vsnprintf
 #include <stdarg.h> // va_start etc.
 
-uint8_t _check(const char *test_description, struct CMDU *input, uint8_t **expected_output, uint16_t *expected_output_lens)
+uint8_t _check(const char *test_description, struct CMDU *input, uint8_t **expected_output, uint16_t *expected_output_lens,
+               struct arena *arena)
 {
     uint8_t   result;
     uint8_t **real_output;
@@ -118,7 +119,14 @@ uint8_t _check(const char *test_description, struct CMDU *input, uint8_t **expec
 
     // Call the actual function under test
     //
-    real_output = forge_1905_CMDU_from_structure(input, &real_output_lens);
+    if (NULL != arena)
+    {
+        real_output = forge_1905_CMDU_from_structure_in_arena(input, &real_output_lens, arena);
+    }
+    else
+    {
+        real_output = forge_1905_CMDU_from_structure(input, &real_output_lens);
+    }
 
     // Check that "real_output" and "real_output_lens" have the same number of
     // elements
@@ -260,16 +268,34 @@ int main(void)
     init_1905_cmdu_test_vectors();
 
     #define x1905CMDUFORGE001 "x1905CMDUFORGE001 - Forge link metric query CMDU (x1905_cmdu_001)"
-    result += _check(x1905CMDUFORGE001, &x1905_cmdu_structure_001, x1905_cmdu_streams_001, x1905_cmdu_streams_len_001);
+    result += _check(x1905CMDUFORGE001, &x1905_cmdu_structure_001, x1905_cmdu_streams_001, x1905_cmdu_streams_len_001, NULL);
 
     #define x1905CMDUFORGE002 "x1905CMDUFORGE002 - Forge link metric query CMDU (x1905_cmdu_002)"
-    result += _check(x1905CMDUFORGE002, &x1905_cmdu_structure_002, x1905_cmdu_streams_002, x1905_cmdu_streams_len_002);
+    result += _check(x1905CMDUFORGE002, &x1905_cmdu_structure_002, x1905_cmdu_streams_002, x1905_cmdu_streams_len_002, NULL);
 
     #define x1905CMDUFORGE003 "x1905CMDUFORGE003 - Forge link metric query CMDU (x1905_cmdu_003)"
-    result += _check(x1905CMDUFORGE003, &x1905_cmdu_structure_003, x1905_cmdu_streams_003, x1905_cmdu_streams_len_003);
+    result += _check(x1905CMDUFORGE003, &x1905_cmdu_structure_003, x1905_cmdu_streams_003, x1905_cmdu_streams_len_003, NULL);
 
     #define x1905CMDUFORGE004 "x1905CMDUFORGE004 - Forge topology query CMDU (x1905_cmdu_005)"
-    result += _check(x1905CMDUFORGE004, &x1905_cmdu_structure_005, x1905_cmdu_streams_005, x1905_cmdu_streams_len_005);
+    result += _check(x1905CMDUFORGE004, &x1905_cmdu_structure_005, x1905_cmdu_streams_005, x1905_cmdu_streams_len_005, NULL);
+
+    {
+        struct arena *arena = arena_new();
+
+        #define x1905CMDUFORGE005 "x1905CMDUFORGE005 - Forge link metric query CMDU into an arena (x1905_cmdu_001)"
+        result += _check(x1905CMDUFORGE005, &x1905_cmdu_structure_001, x1905_cmdu_streams_001, x1905_cmdu_streams_len_001, arena);
+
+        arena_unref(arena);
+        if (0 != arena_chunks_nr)
+        {
+            PLATFORM_PRINTF("%-100s: KO !!!\n", "x1905CMDUFORGE006 - Arena released");
+            result++;
+        }
+        else
+        {
+            PLATFORM_PRINTF("%-100s: OK\n", "x1905CMDUFORGE006 - Arena released");
+        }
+    }
 
     x1905_cmdu_print_real[0] = '\0';
     visit_1905_CMDU_structure(&x1905_cmdu_structure_001, print_callback, check_print, "->");
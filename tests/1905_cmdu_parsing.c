@@ -94,6 +94,137 @@ static int check_parse_1905_cmdu(const char *test_description, uint8_t **input,
     return result;
 }
 
+static int check_parse_1905_cmdu_in_arena(const char *test_description, uint8_t **input, struct CMDU *expected_output)
+{
+    int result = 1;
+    struct CMDU *real_output;
+    struct tlv *kept_tlv;
+
+    real_output = parse_1905_CMDU_from_packets_in_arena(input);
+
+    if (NULL != real_output && NULL != expected_output->list_of_TLVs[0] &&
+        0 == compare_1905_CMDU_structures(real_output, expected_output))
+    {
+        // Take the first TLV out of the CMDU (as the datamodel does with the
+        // TLVs it keeps) and check that it survives the CMDU and that the
+        // arena is released together with it.
+        //
+        kept_tlv = real_output->list_of_TLVs[0];
+        memfree(real_output->list_of_TLVs);
+        real_output->list_of_TLVs = NULL;
+        free_1905_CMDU_structure(real_output);
+        real_output = NULL;
+
+        if (NULL != kept_tlv && 0 != arena_chunks_nr &&
+            0 == compare_1905_TLV_structures(kept_tlv, expected_output->list_of_TLVs[0]))
+        {
+            free_1905_TLV_structure(kept_tlv);
+            if (0 == arena_chunks_nr)
+            {
+                result = 0;
+            }
+        }
+    }
+
+    if (0 == result)
+    {
+        PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    }
+    else
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Expected output:\n");
+        visit_1905_CMDU_structure(expected_output, print_callback, PLATFORM_PRINTF, "");
+        PLATFORM_PRINTF("  Real output    :\n");
+        visit_1905_CMDU_structure(real_output, print_callback, PLATFORM_PRINTF, "");
+    }
+
+    return result;
+}
+
+// A single fragment whose only TLV claims to be 0xffff bytes long
+//
+static uint8_t *x1905_cmdu_streams_oversized_tlv[] =
+{
+    (uint8_t []){
+        0x00,
+        0x00,
+        0x00, 0x05,
+        0x00, 0x07,
+        0x00,
+        0x80,
+
+        0x08,
+        0xff, 0xff,
+        0x00,
+        0x02, 0x00,
+    },
+    NULL
+};
+
+static int check_parse_1905_cmdu_view(const char *test_description, uint8_t **input, const uint16_t *input_lens,
+                                      struct CMDU *expected_output)
+{
+    int result = 0;
+    struct CMDU_view view;
+    unsigned i;
+
+    if (!parse_1905_CMDU_view_from_packets(input, input_lens, &view))
+    {
+        if (NULL == expected_output)
+        {
+            // Expected to fail
+            //
+            PLATFORM_PRINTF("%-100s: OK\n", test_description);
+            return 0;
+        }
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  parse_1905_CMDU_view_from_packets() failed\n");
+        return 1;
+    }
+
+    if (NULL == expected_output)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  parse_1905_CMDU_view_from_packets() did not fail\n");
+        free_1905_CMDU_view(&view);
+        return 1;
+    }
+
+    if (view.message_version != expected_output->message_version ||
+        view.message_type    != expected_output->message_type    ||
+        view.message_id      != expected_output->message_id      ||
+        view.relay_indicator != expected_output->relay_indicator)
+    {
+        result = 1;
+    }
+
+    // Each indexed TLV must decode to the expected one
+    //
+    for (i = 0; 0 == result && i < view.tlvs_nr; i++)
+    {
+        struct tlv *tlv = parse_1905_CMDU_view_TLV(&view.tlvs[i]);
+
+        if (NULL == expected_output->list_of_TLVs[i] ||
+            get_1905_CMDU_view_TLV(&view, view.tlvs[i].type) > &view.tlvs[i] ||
+            0 != compare_1905_TLV_structures(tlv, expected_output->list_of_TLVs[i]))
+        {
+            result = 1;
+        }
+        free_1905_TLV_structure(tlv);
+    }
+    if (0 == result && NULL != expected_output->list_of_TLVs[i])
+    {
+        result = 1;
+    }
+
+    free_1905_CMDU_view(&view);
+
+    PLATFORM_PRINTF("%-100s: %s\n", test_description, 0 == result ? "OK" : "KO !!!");
+
+    return result;
+}
+
 static int check_parse_1905_cmdu_header(const char *test_description, uint8_t *input, size_t input_len,
                                         struct CMDU_header *expected_output)
 {
@@ -162,6 +293,32 @@ int main(void)
     #define x1905CMDUPARSE004 "x1905CMDUPARSE004 - Parse topology query CMDU (x1905_cmdu_streams_005)"
     result += check_parse_1905_cmdu(x1905CMDUPARSE004, x1905_cmdu_streams_005, &x1905_cmdu_structure_005);
 
+    #define x1905CMDUPARSE005 "x1905CMDUPARSE005 - Parse link metric query CMDU into an arena (x1905_cmdu_streams_001)"
+    result += check_parse_1905_cmdu_in_arena(x1905CMDUPARSE005, x1905_cmdu_streams_001, &x1905_cmdu_structure_001);
+
+    #define x1905CMDUPARSE006 "x1905CMDUPARSE006 - Parse link metric query CMDU into an arena (x1905_cmdu_streams_002)"
+    result += check_parse_1905_cmdu_in_arena(x1905CMDUPARSE006, x1905_cmdu_streams_002, &x1905_cmdu_structure_002);
+
+    #define x1905CMDUPARSE007 "x1905CMDUPARSE007 - View link metric query CMDU (x1905_cmdu_streams_001)"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSE007, x1905_cmdu_streams_001, NULL, &x1905_cmdu_structure_001);
+
+    #define x1905CMDUPARSE008 "x1905CMDUPARSE008 - View topology query CMDU (x1905_cmdu_streams_005)"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSE008, x1905_cmdu_streams_005, NULL, &x1905_cmdu_structure_005);
+
+    #define x1905CMDUPARSE009 "x1905CMDUPARSE009 - View link metric query CMDU with stream lengths (x1905_cmdu_streams_001)"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSE009, x1905_cmdu_streams_001, x1905_cmdu_streams_len_001,
+                                         &x1905_cmdu_structure_001);
+
+    #define x1905CMDUPARSE010 "x1905CMDUPARSE010 - View link metric query CMDU truncated inside a TLV"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSE010, x1905_cmdu_streams_001, (uint16_t []){18, 0}, NULL);
+
+    #define x1905CMDUPARSE011 "x1905CMDUPARSE011 - View CMDU with a TLV length past the end of the stream"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSE011, x1905_cmdu_streams_oversized_tlv,
+                                         (uint16_t []){14, 0}, NULL);
+
+    #define x1905CMDUPARSE012 "x1905CMDUPARSE012 - View CMDU with a stream shorter than the header"
+    result += check_parse_1905_cmdu_view(x1905CMDUPARSE012, x1905_cmdu_streams_001, (uint16_t []){6, 0}, NULL);
+
     result += check_parse_1905_cmdu_header("x1905CMDUPARSEHDR001 - Parse CMDU packet last fragment",
                                            x1905_cmdu_packet_001, x1905_cmdu_packet_len_001, &x1905_cmdu_header_001);
 
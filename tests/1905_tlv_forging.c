@@ -183,6 +183,29 @@ static int _check(const char *test_description, const struct tlv *input, const u
     }
     free_1905_TLV_packet(real_output);
 
+    // The length-only and forge-into-buffer variants must agree with it
+    //
+    if (0 == result)
+    {
+        uint8_t buffer[MAX_NETWORK_SEGMENT_SIZE + 1];
+
+        if (forge_1905_TLV_length(input) != expected_output_len)
+        {
+            result = 1;
+            PLATFORM_PRINTF("Length %-99s: KO !!!\n", test_description);
+            PLATFORM_PRINTF("  forge_1905_TLV_length() returned %u, expected %u\n",
+                            (unsigned)forge_1905_TLV_length(input), (unsigned)expected_output_len);
+        }
+        else if (expected_output_len <= MAX_NETWORK_SEGMENT_SIZE &&
+                 (forge_1905_TLV_into_buffer(input, buffer, expected_output_len) != expected_output_len ||
+                  0 != memcmp(expected_output, buffer, expected_output_len) ||
+                  0 != forge_1905_TLV_into_buffer(input, buffer, expected_output_len - 1)))
+        {
+            result = 1;
+            PLATFORM_PRINTF("Buffer %-99s: KO !!!\n", test_description);
+        }
+    }
+
     return result;
 }
 
@@ -249,6 +272,14 @@ int main(void)
     *(uint16_t*)&bss_info->bssid = 0xa599;
     result += check_print(&tlv1->tlv.s, "2x: ", "2x: associatedClients->bss[0]->bssid: 0xa599\n");
 
+    bssid_desc.fields[0].size = 6;
+    bssid_desc.fields[0].format = tlv_struct_print_format_string;
+    memcpy(bss_info->bssid, "ab\0cd", 6);
+    result += check_print(&tlv1->tlv.s, "6s: ", "6s: associatedClients->bss[0]->bssid: ab\n");
+
+    memcpy(bss_info->bssid, "abcdef", 6);
+    result += check_print(&tlv1->tlv.s, "6s: ", "6s: associatedClients->bss[0]->bssid: abcdef\n");
+
     /* @todo bssid is not big enough to store an IPv6 address so that is not tested. */
 
     /* Restore the original situation */
@@ -308,542 +308,6 @@ static uint8_t x1905_tlv_stream_007[] =
 static uint16_t x1905_tlv_stream_len_007 = 61;
 
 
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 010 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct deviceInformationTypeTLV x1905_tlv_structure_010 =
-{
-    .tlv.type                    = TLV_TYPE_DEVICE_INFORMATION_TYPE,
-    .al_mac_address              = {0x04, 0x02, 0xff, 0x01, 0x02, 0x03},
-    .local_interfaces_nr         = 2,
-    .local_interfaces            =
-        (struct _localInterfaceEntries[]){
-            {
-                .mac_address                                                       = {0x21, 0x22, 0x00, 0x24, 0x25, 0x26},
-                .media_type                                                        = MEDIA_TYPE_IEEE_802_11AF_GHZ,
-                .media_specific_data_size                                          = 10,
-                .media_specific_data.ieee80211.network_membership                  = {0x01, 0x01, 0x01, 0x02, 0x02, 0x02},
-                .media_specific_data.ieee80211.role                                = IEEE80211_SPECIFIC_INFO_ROLE_WIFI_P2P_CLIENT,
-                .media_specific_data.ieee80211.ap_channel_band                     = 0x05,
-                .media_specific_data.ieee80211.ap_channel_center_frequency_index_1 = 0x0a,
-                .media_specific_data.ieee80211.ap_channel_center_frequency_index_2 = 0x0b,
-            },
-            {
-                .mac_address                                     = {0x21, 0x22, 0x00, 0x24, 0x25, 0x27},
-                .media_type                                      = MEDIA_TYPE_IEEE_1901_WAVELET,
-                .media_specific_data_size                        = 7,
-                .media_specific_data.ieee1901.network_identifier = {0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0xff},
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_010[] =
-{
-    0x03,
-    0x00, 0x2a,
-    0x04, 0x02, 0xff, 0x01, 0x02, 0x03,
-    0x02,
-    0x21, 0x22, 0x00, 0x24, 0x25, 0x26,
-    0x01, 0x07,
-    0x0a,
-    0x01, 0x01, 0x01, 0x02, 0x02, 0x02,
-    0x80,
-    0x05,
-    0x0a,
-    0x0b,
-    0x21, 0x22, 0x00, 0x24, 0x25, 0x27,
-    0x02, 0x00,
-    0x07,
-    0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0xff,
-};
-
-static uint16_t x1905_tlv_stream_len_010 = 45;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 011 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct deviceBridgingCapabilityTLV x1905_tlv_structure_011 =
-{
-    .tlv.type                    = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES,
-    .bridging_tuples_nr          = 2,
-    .bridging_tuples             =
-        (struct _bridgingTupleEntries[]){
-            {
-                .bridging_tuple_macs_nr  = 2,
-                .bridging_tuple_macs     =
-                    (struct _bridgingTupleMacEntries[]){
-                        {
-                            .mac_address     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x01},
-                        },
-                        {
-                            .mac_address     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x02},
-                        },
-                    }
-            },
-            {
-                .bridging_tuple_macs_nr  = 3,
-                .bridging_tuple_macs     =
-                    (struct _bridgingTupleMacEntries[]){
-                        {
-                            .mac_address     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x11},
-                        },
-                        {
-                            .mac_address     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x12},
-                        },
-                        {
-                            .mac_address     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x13},
-                        },
-                    }
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_011[] =
-{
-    0x04,
-    0x00, 0x21,
-    0x02,
-    0x02,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
-    0x03,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x11,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x12,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x13,
-};
-
-static uint16_t x1905_tlv_stream_len_011 = 36;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 012 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct deviceBridgingCapabilityTLV x1905_tlv_structure_012 =
-{
-    .tlv.type                    = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES,
-    .bridging_tuples_nr          = 2,
-    .bridging_tuples             =
-        (struct _bridgingTupleEntries[]){
-            {
-                .bridging_tuple_macs_nr  = 2,
-                .bridging_tuple_macs     =
-                    (struct _bridgingTupleMacEntries[]){
-                        {
-                            .mac_address     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x01},
-                        },
-                        {
-                            .mac_address     = {0x00, 0x00, 0x00, 0x00, 0x00, 0x02},
-                        },
-                    }
-            },
-            {
-                .bridging_tuple_macs_nr  = 0,
-                .bridging_tuple_macs     = NULL,
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_012[] =
-{
-    0x04,
-    0x00, 0x0f,
-    0x02,
-    0x02,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_012 = 18;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 013 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct deviceBridgingCapabilityTLV x1905_tlv_structure_013 =
-{
-    .tlv.type                    = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES,
-    .bridging_tuples_nr          = 0,
-    .bridging_tuples             = NULL,
-};
-
-static uint8_t x1905_tlv_stream_013[] =
-{
-    0x04,
-    0x00, 0x01,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_013 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 014 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct non1905NeighborDeviceListTLV x1905_tlv_structure_014 =
-{
-    .tlv.type                    = TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST,
-    .local_mac_address           = {0x33, 0x34, 0x35, 0x36, 0x37, 0x38},
-    .non_1905_neighbors_nr       = 1,
-    .non_1905_neighbors          =
-        (struct _non1905neighborEntries[]){
-            {
-                .mac_address = {0x43, 0x44, 0x45, 0x46, 0x47, 0x48},
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_014[] =
-{
-    0x06,
-    0x00, 0x0c,
-    0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-    0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
-};
-
-static uint16_t x1905_tlv_stream_len_014 = 15;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 015 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct non1905NeighborDeviceListTLV x1905_tlv_structure_015 =
-{
-    .tlv.type                    = TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST,
-    .local_mac_address           = {0x33, 0x34, 0x35, 0x36, 0x37, 0x38},
-    .non_1905_neighbors_nr       = 2,
-    .non_1905_neighbors          =
-        (struct _non1905neighborEntries[]){
-            {
-                .mac_address = {0x43, 0x44, 0x45, 0x46, 0x47, 0x48},
-            },
-            {
-                .mac_address = {0x53, 0x54, 0x55, 0x56, 0x57, 0x58},
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_015[] =
-{
-    0x06,
-    0x00, 0x12,
-    0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-    0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
-    0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
-};
-
-static uint16_t x1905_tlv_stream_len_015 = 21;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 016 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct neighborDeviceListTLV x1905_tlv_structure_016 =
-{
-    .tlv.type                    = TLV_TYPE_NEIGHBOR_DEVICE_LIST,
-    .local_mac_address           = {0x33, 0x34, 0x35, 0x36, 0x37, 0x38},
-    .neighbors_nr                = 1,
-    .neighbors                   =
-        (struct _neighborEntries[]){
-            {
-                .mac_address = {0x43, 0x44, 0x45, 0x46, 0x47, 0x48},
-                .bridge_flag = 0,
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_016[] =
-{
-    0x07,
-    0x00, 0x0d,
-    0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-    0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_016 = 16;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 017 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct neighborDeviceListTLV x1905_tlv_structure_017 =
-{
-    .tlv.type                    = TLV_TYPE_NEIGHBOR_DEVICE_LIST,
-    .local_mac_address           = {0x33, 0x34, 0x35, 0x36, 0x37, 0x38},
-    .neighbors_nr                = 2,
-    .neighbors                   =
-        (struct _neighborEntries[]){
-            {
-                .mac_address = {0x43, 0x44, 0x45, 0x46, 0x47, 0x48},
-                .bridge_flag = 1,
-            },
-            {
-                .mac_address = {0x53, 0x54, 0x55, 0x56, 0x57, 0x58},
-                .bridge_flag = 0,
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_017[] =
-{
-    0x07,
-    0x00, 0x14,
-    0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-    0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
-    0x80,
-    0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_017 = 23;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 018 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct linkMetricResultCodeTLV x1905_tlv_structure_018 =
-{
-    .tlv.type                    = TLV_TYPE_LINK_METRIC_RESULT_CODE,
-    .result_code                 = LINK_METRIC_RESULT_CODE_TLV_INVALID_NEIGHBOR,
-};
-
-static uint8_t x1905_tlv_stream_018[] =
-{
-    0x0c,
-    0x00, 0x01,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_018 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 019 (TLV <-- packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct linkMetricResultCodeTLV x1905_tlv_structure_019 =
-{
-    .tlv.type                    = TLV_TYPE_LINK_METRIC_RESULT_CODE,
-    .result_code                 = 5,
-};
-
-static uint8_t x1905_tlv_stream_019[] =
-{
-    0x0c,
-    0x00, 0x01,
-    0x05,
-};
-
-static uint16_t x1905_tlv_stream_len_019 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 020 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct searchedRoleTLV x1905_tlv_structure_020 =
-{
-    .tlv.type                    = TLV_TYPE_SEARCHED_ROLE,
-    .role                        = IEEE80211_ROLE_REGISTRAR,
-};
-
-static uint8_t x1905_tlv_stream_020[] =
-{
-    0x0d,
-    0x00, 0x01,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_020 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 021 (TLV <-- packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct searchedRoleTLV x1905_tlv_structure_021 =
-{
-    .tlv.type                    = TLV_TYPE_SEARCHED_ROLE,
-    .role                        = 0xff,
-};
-
-static uint8_t x1905_tlv_stream_021[] =
-{
-    0x0d,
-    0x00, 0x01,
-    0xff,
-};
-
-static uint16_t x1905_tlv_stream_len_021 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 022 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct autoconfigFreqBandTLV x1905_tlv_structure_022 =
-{
-    .tlv.type                    = TLV_TYPE_AUTOCONFIG_FREQ_BAND,
-    .freq_band                   = IEEE80211_FREQUENCY_BAND_2_4_GHZ,
-};
-
-static uint8_t x1905_tlv_stream_022[] =
-{
-    0x0e,
-    0x00, 0x01,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_022 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 023 (TLV <-- packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct autoconfigFreqBandTLV x1905_tlv_structure_023 =
-{
-    .tlv.type                    = TLV_TYPE_AUTOCONFIG_FREQ_BAND,
-    .freq_band                   = 0x1a,
-};
-
-static uint8_t x1905_tlv_stream_023[] =
-{
-    0x0e,
-    0x00, 0x01,
-    0x1a,
-};
-
-static uint16_t x1905_tlv_stream_len_023 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 024 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct supportedRoleTLV x1905_tlv_structure_024 =
-{
-    .tlv.type                    = TLV_TYPE_SUPPORTED_ROLE,
-    .role                        = IEEE80211_ROLE_REGISTRAR,
-};
-
-static uint8_t x1905_tlv_stream_024[] =
-{
-    0x0f,
-    0x00, 0x01,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_024 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 025 (TLV <-- packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct supportedRoleTLV x1905_tlv_structure_025 =
-{
-    .tlv.type                    = TLV_TYPE_SUPPORTED_ROLE,
-    .role                        = 0x02,
-};
-
-static uint8_t x1905_tlv_stream_025[] =
-{
-    0x0f,
-    0x00, 0x01,
-    0x02,
-};
-
-static uint16_t x1905_tlv_stream_len_025 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 026 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct supportedFreqBandTLV x1905_tlv_structure_026 =
-{
-    .tlv.type                    = TLV_TYPE_SUPPORTED_FREQ_BAND,
-    .freq_band                   = IEEE80211_FREQUENCY_BAND_5_GHZ,
-};
-
-static uint8_t x1905_tlv_stream_026[] =
-{
-    0x10,
-    0x00, 0x01,
-    0x01,
-};
-
-static uint16_t x1905_tlv_stream_len_026 = 4;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 027 (TLV <-- packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct supportedFreqBandTLV x1905_tlv_structure_027 =
-{
-    .tlv.type                    = TLV_TYPE_SUPPORTED_FREQ_BAND,
-    .freq_band                   = 0x07,
-};
-
-static uint8_t x1905_tlv_stream_027[] =
-{
-    0x10,
-    0x00, 0x01,
-    0x07,
-};
-
-static uint16_t x1905_tlv_stream_len_027 = 4;
-
-
 ////////////////////////////////////////////////////////////////////////////////
 ////
 //// Test vector 028 (TLV <--> packet)
@@ -893,87 +357,6 @@ static uint8_t x1905_tlv_stream_028[] =
 static uint16_t x1905_tlv_stream_len_028 = 27;
 
 
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 029 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct powerOffInterfaceTLV x1905_tlv_structure_029 =
-{
-    .tlv.type                    = TLV_TYPE_POWER_OFF_INTERFACE,
-    .power_off_interfaces_nr     = 2,
-    .power_off_interfaces        =
-        (struct _powerOffInterfaceEntries[]){
-            {
-                .interface_address       = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05},
-                .media_type              = MEDIA_TYPE_IEEE_802_11G_2_4_GHZ,
-                .generic_phy_common_data =
-                    {
-                        .oui                     = {0x00, 0x00, 0x00},
-                        .variant_index           = 0,
-                        .media_specific_bytes_nr = 0,
-                        .media_specific_bytes    = NULL,
-                    },
-            },
-            {
-                .interface_address       = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15},
-                .media_type              = MEDIA_TYPE_UNKNOWN,
-                .generic_phy_common_data =
-                    {
-                        .oui                     = {0x00, 0x19, 0xa7},
-                        .variant_index           = 0,
-                        .media_specific_bytes_nr = 5,
-                        .media_specific_bytes    = (uint8_t []){0x01, 0x00, 0x02, 0xaf, 0xb5},
-                    },
-            },
-        },
-};
-
-static uint8_t x1905_tlv_stream_029[] =
-{
-    0x1b,
-    0x00, 0x20,
-    0x02,
-    0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
-    0x01, 0x01,
-    0x00, 0x00, 0x00,
-    0x00,
-    0x00,
-    0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
-    0xff, 0xff,
-    0x00, 0x19, 0xa7,
-    0x00,
-    0x05,
-    0x01, 0x00, 0x02, 0xaf, 0xb5,
-};
-
-static uint16_t x1905_tlv_stream_len_029 = 35;
-
-
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 030 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct powerOffInterfaceTLV x1905_tlv_structure_030 =
-{
-    .tlv.type                    = TLV_TYPE_POWER_OFF_INTERFACE,
-    .power_off_interfaces_nr     = 0,
-    .power_off_interfaces        = NULL,
-};
-
-static uint8_t x1905_tlv_stream_030[] =
-{
-    0x1b,
-    0x00, 0x01,
-    0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_030 = 4;
-
-
 ////////////////////////////////////////////////////////////////////////////////
 ////
 //// Test vector 031 (TLV <--> packet)
@@ -1057,33 +440,6 @@ static uint8_t x1905_tlv_stream_032[] =
 static uint16_t x1905_tlv_stream_len_032 = 14;
 
 
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 033 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct deviceIdentificationTypeTLV x1905_tlv_structure_033 =
-{
-    .tlv.type                    = TLV_TYPE_DEVICE_IDENTIFICATION,
-    .friendly_name               = "Tv in the kitchen\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0",
-    .manufacturer_name           = "Megacorp S.A.\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0",
-    .manufacturer_model          = "LED TVx2001xx\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0",
-
-};
-
-static uint8_t x1905_tlv_stream_033[] =
-{
-    0x15,
-    0x00, 0xc0,
-    0x54, 0x76, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6b, 0x69, 0x74, 0x63, 0x68, 0x65, 0x6e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x4d, 0x65, 0x67, 0x61, 0x63, 0x6f, 0x72, 0x70, 0x20, 0x53, 0x2e, 0x41, 0x2e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x4c, 0x45, 0x44, 0x20, 0x54, 0x56, 0x78, 0x32, 0x30, 0x30, 0x31, 0x78, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static uint16_t x1905_tlv_stream_len_033 = 195;
-
-
 ////////////////////////////////////////////////////////////////////////////////
 ////
 //// Test vector 034 (TLV <--> packet)
@@ -1226,28 +582,6 @@ static uint8_t x1905_tlv_stream_036[] =
 static uint16_t x1905_tlv_stream_len_036 = 93;
 
 
-////////////////////////////////////////////////////////////////////////////////
-////
-//// Test vector 037 (TLV <--> packet)
-////
-////////////////////////////////////////////////////////////////////////////////
-
-static struct x1905ProfileVersionTLV x1905_tlv_structure_037 =
-{
-    .tlv.type                    = TLV_TYPE_1905_PROFILE_VERSION,
-    .profile                     = PROFILE_1905_1A,
-};
-
-static uint8_t x1905_tlv_stream_037[] =
-{
-    0x1a,
-    0x00, 0x01,
-    0x01,
-};
-
-static uint16_t x1905_tlv_stream_len_037 = 4;
-
-
 ////////////////////////////////////////////////////////////////////////////////
 ////
 //// Test vector 038 (TLV <--> packet)
@@ -1495,39 +829,330 @@ void get_1905_tlv_test_vectors(dlist_head *test_vectors)
     mac_address local_mac_address = {0xff, 0xf2, 0x04, 0xfa, 0x00, 0xab};
     memcpy(mac_address_type->mac_address, local_mac_address, 6);
 
-    ADD_TEST_VECTOR(010, "device information type TLV");
-    ADD_TEST_VECTOR(011, "device bridging capability TLV");
-    ADD_TEST_VECTOR(012, "device bridging capability TLV");
-    ADD_TEST_VECTOR(013, "device bridging capability TLV");
-    ADD_TEST_VECTOR(014, "non 1905 neighbor device list TLV");
-    ADD_TEST_VECTOR(015, "non 1905 neighbor device list TLV");
-    ADD_TEST_VECTOR(016, "neighbor device list TLV");
-    ADD_TEST_VECTOR(017, "neighbor device list TLV");
-    ADD_TEST_VECTOR(018, "link metric result code TLV");
-    ADD_TEST_VECTOR(019, "link metric result code TLV");
+    INIT_TEST_VECTOR("device information type TLV",
+        0x03,
+        0x00, 0x2a,
+        0x04, 0x02, 0xff, 0x01, 0x02, 0x03,
+        0x02,
+        0x21, 0x22, 0x00, 0x24, 0x25, 0x26,
+        0x01, 0x07,
+        0x0a,
+        0x01, 0x01, 0x01, 0x02, 0x02, 0x02,
+        0x80,
+        0x05,
+        0x0a,
+        0x0b,
+        0x21, 0x22, 0x00, 0x24, 0x25, 0x27,
+        0x02, 0x00,
+        0x07,
+        0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0xff,
+    );
+    struct deviceInformationTypeTLV *device_information_type =
+            X1905_TLV_ALLOC(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, &v->h.children[0]);
+    mac_address device_al_mac_address = {0x04, 0x02, 0xff, 0x01, 0x02, 0x03};
+    memcpy(device_information_type->al_mac_address, device_al_mac_address, 6);
+    mac_address local_interface_mac_address_1 = {0x21, 0x22, 0x00, 0x24, 0x25, 0x26};
+    struct _localInterfaceEntries *local_interface = deviceInformationTypeTLVAddInterface(device_information_type,
+            local_interface_mac_address_1, MEDIA_TYPE_IEEE_802_11AF_GHZ);
+    mac_address network_membership = {0x01, 0x01, 0x01, 0x02, 0x02, 0x02};
+    memcpy(local_interface->media_specific_data.ieee80211.network_membership, network_membership, 6);
+    local_interface->media_specific_data.ieee80211.role = IEEE80211_SPECIFIC_INFO_ROLE_WIFI_P2P_CLIENT;
+    local_interface->media_specific_data.ieee80211.ap_channel_band = 0x05;
+    local_interface->media_specific_data.ieee80211.ap_channel_center_frequency_index_1 = 0x0a;
+    local_interface->media_specific_data.ieee80211.ap_channel_center_frequency_index_2 = 0x0b;
+    mac_address local_interface_mac_address_2 = {0x21, 0x22, 0x00, 0x24, 0x25, 0x27};
+    local_interface = deviceInformationTypeTLVAddInterface(device_information_type,
+            local_interface_mac_address_2, MEDIA_TYPE_IEEE_1901_WAVELET);
+    static const uint8_t network_identifier[7] = {0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0xff};
+    memcpy(local_interface->media_specific_data.ieee1901.network_identifier, network_identifier, 7);
+
+    INIT_TEST_VECTOR("device bridging capability TLV",
+        0x04,
+        0x00, 0x21,
+        0x02,
+        0x02,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+        0x03,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x11,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x12,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x13,
+    );
+    struct deviceBridgingCapabilityTLV *device_bridging_capability =
+            X1905_TLV_ALLOC(deviceBridgingCapability, TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES, &v->h.children[0]);
+    struct _bridgingTupleEntries *bridging_tuple = deviceBridgingCapabilityTLVAddTuple(device_bridging_capability);
+    mac_address bridged_mac_address = {0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
+    deviceBridgingCapabilityTupleAddMac(bridging_tuple, bridged_mac_address);
+    bridged_mac_address[5] = 0x02;
+    deviceBridgingCapabilityTupleAddMac(bridging_tuple, bridged_mac_address);
+    bridging_tuple = deviceBridgingCapabilityTLVAddTuple(device_bridging_capability);
+    bridged_mac_address[5] = 0x11;
+    deviceBridgingCapabilityTupleAddMac(bridging_tuple, bridged_mac_address);
+    bridged_mac_address[5] = 0x12;
+    deviceBridgingCapabilityTupleAddMac(bridging_tuple, bridged_mac_address);
+    bridged_mac_address[5] = 0x13;
+    deviceBridgingCapabilityTupleAddMac(bridging_tuple, bridged_mac_address);
+
+    INIT_TEST_VECTOR("device bridging capability TLV with an empty tuple",
+        0x04,
+        0x00, 0x0f,
+        0x02,
+        0x02,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+        0x00,
+    );
+    device_bridging_capability =
+            X1905_TLV_ALLOC(deviceBridgingCapability, TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES, &v->h.children[0]);
+    bridging_tuple = deviceBridgingCapabilityTLVAddTuple(device_bridging_capability);
+    bridged_mac_address[5] = 0x01;
+    deviceBridgingCapabilityTupleAddMac(bridging_tuple, bridged_mac_address);
+    bridged_mac_address[5] = 0x02;
+    deviceBridgingCapabilityTupleAddMac(bridging_tuple, bridged_mac_address);
+    deviceBridgingCapabilityTLVAddTuple(device_bridging_capability);
+
+    INIT_TEST_VECTOR("device bridging capability TLV without tuples",
+        0x04,
+        0x00, 0x01,
+        0x00,
+    );
+    X1905_TLV_ALLOC(deviceBridgingCapability, TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES, &v->h.children[0]);
+
+    INIT_TEST_VECTOR("non 1905 neighbor device list TLV",
+        0x06,
+        0x00, 0x0c,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+        0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    );
+    struct non1905NeighborDeviceListTLV *non_1905_neighbor_device_list =
+            X1905_TLV_ALLOC(non1905NeighborDeviceList, TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST, &v->h.children[0]);
+    mac_address neighbors_local_mac_address = {0x33, 0x34, 0x35, 0x36, 0x37, 0x38};
+    memcpy(non_1905_neighbor_device_list->local_mac_address, neighbors_local_mac_address, 6);
+    mac_address neighbor_mac_address_1 = {0x43, 0x44, 0x45, 0x46, 0x47, 0x48};
+    non1905NeighborDeviceListTLVAddNeighbor(non_1905_neighbor_device_list, neighbor_mac_address_1);
+
+    INIT_TEST_VECTOR("non 1905 neighbor device list TLV with two neighbors",
+        0x06,
+        0x00, 0x12,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+        0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+        0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+    );
+    non_1905_neighbor_device_list =
+            X1905_TLV_ALLOC(non1905NeighborDeviceList, TLV_TYPE_NON_1905_NEIGHBOR_DEVICE_LIST, &v->h.children[0]);
+    memcpy(non_1905_neighbor_device_list->local_mac_address, neighbors_local_mac_address, 6);
+    non1905NeighborDeviceListTLVAddNeighbor(non_1905_neighbor_device_list, neighbor_mac_address_1);
+    mac_address neighbor_mac_address_2 = {0x53, 0x54, 0x55, 0x56, 0x57, 0x58};
+    non1905NeighborDeviceListTLVAddNeighbor(non_1905_neighbor_device_list, neighbor_mac_address_2);
+
+    INIT_TEST_VECTOR("neighbor device list TLV",
+        0x07,
+        0x00, 0x0d,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+        0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+        0x00,
+    );
+    struct neighborDeviceListTLV *neighbor_device_list =
+            X1905_TLV_ALLOC(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, &v->h.children[0]);
+    memcpy(neighbor_device_list->local_mac_address, neighbors_local_mac_address, 6);
+    neighborDeviceListTLVAddNeighbor(neighbor_device_list, neighbor_mac_address_1, 0);
+
+    INIT_TEST_VECTOR("neighbor device list TLV with a bridged neighbor",
+        0x07,
+        0x00, 0x14,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+        0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+        0x80,
+        0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+        0x00,
+    );
+    neighbor_device_list = X1905_TLV_ALLOC(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, &v->h.children[0]);
+    memcpy(neighbor_device_list->local_mac_address, neighbors_local_mac_address, 6);
+    neighborDeviceListTLVAddNeighbor(neighbor_device_list, neighbor_mac_address_1, 1);
+    neighborDeviceListTLVAddNeighbor(neighbor_device_list, neighbor_mac_address_2, 0);
+
+    INIT_TEST_VECTOR("link metric result code TLV",
+        0x0c,
+        0x00, 0x01,
+        0x00,
+    );
+    struct linkMetricResultCodeTLV *link_metric_result_code =
+            X1905_TLV_ALLOC(linkMetricResultCode, TLV_TYPE_LINK_METRIC_RESULT_CODE, &v->h.children[0]);
+    link_metric_result_code->result_code = LINK_METRIC_RESULT_CODE_TLV_INVALID_NEIGHBOR;
+
+    INIT_TEST_VECTOR("link metric result code TLV with unknown result code",
+        0x0c,
+        0x00, 0x01,
+        0x05,
+    );
+    link_metric_result_code =
+            X1905_TLV_ALLOC(linkMetricResultCode, TLV_TYPE_LINK_METRIC_RESULT_CODE, &v->h.children[0]);
+    link_metric_result_code->result_code = 5;
     v->forge = false; /* Unknown result code, can't be forged. */
-    ADD_TEST_VECTOR(020, "searched role TLV");
-    ADD_TEST_VECTOR(021, "searched role TLV");
+
+    INIT_TEST_VECTOR("searched role TLV",
+        0x0d,
+        0x00, 0x01,
+        0x00,
+    );
+    struct searchedRoleTLV *searched_role =
+            X1905_TLV_ALLOC(searchedRole, TLV_TYPE_SEARCHED_ROLE, &v->h.children[0]);
+    searched_role->role = IEEE80211_ROLE_REGISTRAR;
+
+    INIT_TEST_VECTOR("searched role TLV with unknown role",
+        0x0d,
+        0x00, 0x01,
+        0xff,
+    );
+    searched_role = X1905_TLV_ALLOC(searchedRole, TLV_TYPE_SEARCHED_ROLE, &v->h.children[0]);
+    searched_role->role = 0xff;
     v->forge = false; /* Unknown role, can't be forged. */
-    ADD_TEST_VECTOR(022, "autoconfig freq band TLV");
-    ADD_TEST_VECTOR(023, "autoconfig freq band TLV");
+
+    INIT_TEST_VECTOR("autoconfig freq band TLV",
+        0x0e,
+        0x00, 0x01,
+        0x00,
+    );
+    struct autoconfigFreqBandTLV *autoconfig_freq_band =
+            X1905_TLV_ALLOC(autoconfigFreqBand, TLV_TYPE_AUTOCONFIG_FREQ_BAND, &v->h.children[0]);
+    autoconfig_freq_band->freq_band = IEEE80211_FREQUENCY_BAND_2_4_GHZ;
+
+    INIT_TEST_VECTOR("autoconfig freq band TLV with unknown freq band",
+        0x0e,
+        0x00, 0x01,
+        0x1a,
+    );
+    autoconfig_freq_band = X1905_TLV_ALLOC(autoconfigFreqBand, TLV_TYPE_AUTOCONFIG_FREQ_BAND, &v->h.children[0]);
+    autoconfig_freq_band->freq_band = 0x1a;
     v->forge = false; /* Unknown freq band, can't be forged. */
-    ADD_TEST_VECTOR(024, "supported role TLV");
-    ADD_TEST_VECTOR(025, "supported role TLV");
+
+    INIT_TEST_VECTOR("supported role TLV",
+        0x0f,
+        0x00, 0x01,
+        0x00,
+    );
+    struct supportedRoleTLV *supported_role =
+            X1905_TLV_ALLOC(supportedRole, TLV_TYPE_SUPPORTED_ROLE, &v->h.children[0]);
+    supported_role->role = IEEE80211_ROLE_REGISTRAR;
+
+    INIT_TEST_VECTOR("supported role TLV with unknown role",
+        0x0f,
+        0x00, 0x01,
+        0x02,
+    );
+    supported_role = X1905_TLV_ALLOC(supportedRole, TLV_TYPE_SUPPORTED_ROLE, &v->h.children[0]);
+    supported_role->role = 0x02;
     v->forge = false; /* Unknown role, can't be forged. */
-    ADD_TEST_VECTOR(026, "supported freq band TLV");
-    ADD_TEST_VECTOR(027, "supported freq band TLV");
+
+    INIT_TEST_VECTOR("supported freq band TLV",
+        0x10,
+        0x00, 0x01,
+        0x01,
+    );
+    struct supportedFreqBandTLV *supported_freq_band =
+            X1905_TLV_ALLOC(supportedFreqBand, TLV_TYPE_SUPPORTED_FREQ_BAND, &v->h.children[0]);
+    supported_freq_band->freq_band = IEEE80211_FREQUENCY_BAND_5_GHZ;
+
+    INIT_TEST_VECTOR("supported freq band TLV with unknown freq band",
+        0x10,
+        0x00, 0x01,
+        0x07,
+    );
+    supported_freq_band = X1905_TLV_ALLOC(supportedFreqBand, TLV_TYPE_SUPPORTED_FREQ_BAND, &v->h.children[0]);
+    supported_freq_band->freq_band = 0x07;
     v->forge = false; /* Unknown freq band, can't be forged. */
+
     ADD_TEST_VECTOR(028, "push button event notification TLV");
-    ADD_TEST_VECTOR(029, "power off interface TLV");
-    ADD_TEST_VECTOR(030, "power off interface TLV");
+
+    INIT_TEST_VECTOR("power off interface TLV",
+        0x1b,
+        0x00, 0x20,
+        0x02,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+        0x01, 0x01,
+        0x00, 0x00, 0x00,
+        0x00,
+        0x00,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+        0xff, 0xff,
+        0x00, 0x19, 0xa7,
+        0x00,
+        0x05,
+        0x01, 0x00, 0x02, 0xaf, 0xb5,
+    );
+    struct powerOffInterfaceTLV *power_off_interface =
+            X1905_TLV_ALLOC(powerOffInterface, TLV_TYPE_POWER_OFF_INTERFACE, &v->h.children[0]);
+    mac_address power_off_interface_address_1 = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05};
+    static const uint8_t power_off_oui_1[3] = {0x00, 0x00, 0x00};
+    powerOffInterfaceTLVAddInterface(power_off_interface, power_off_interface_address_1,
+                                     MEDIA_TYPE_IEEE_802_11G_2_4_GHZ, power_off_oui_1, 0, 0, NULL);
+    mac_address power_off_interface_address_2 = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15};
+    static const uint8_t power_off_oui_2[3] = {0x00, 0x19, 0xa7};
+    static const uint8_t power_off_media_specific_bytes[] = {0x01, 0x00, 0x02, 0xaf, 0xb5};
+    powerOffInterfaceTLVAddInterface(power_off_interface, power_off_interface_address_2,
+                                     MEDIA_TYPE_UNKNOWN, power_off_oui_2, 0,
+                                     sizeof(power_off_media_specific_bytes), power_off_media_specific_bytes);
+
+    INIT_TEST_VECTOR("power off interface TLV without interfaces",
+        0x1b,
+        0x00, 0x01,
+        0x00,
+    );
+    X1905_TLV_ALLOC(powerOffInterface, TLV_TYPE_POWER_OFF_INTERFACE, &v->h.children[0]);
+
     ADD_TEST_VECTOR(031, "generic PHY device information type TLV");
     ADD_TEST_VECTOR(032, "push button generic PHY event notification TLV");
-    ADD_TEST_VECTOR(033, "device identification type TLV");
+
+    INIT_TEST_VECTOR("device identification type TLV",
+        0x15,
+        0x00, 0xc0,
+        'T', 'v', ' ', 'i', 'n', ' ', 't', 'h', 'e', ' ', 'k', 'i', 't', 'c', 'h', 'e', 'n', 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        'M', 'e', 'g', 'a', 'c', 'o', 'r', 'p', ' ', 'S', '.', 'A', '.', 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        'L', 'E', 'D', ' ', 'T', 'V', 'x', '2', '0', '0', '1', 'x', 'x', 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    );
+    struct deviceIdentificationTypeTLV *device_identification =
+            X1905_TLV_ALLOC(deviceIdentificationType, TLV_TYPE_DEVICE_IDENTIFICATION, &v->h.children[0]);
+    strcpy(device_identification->friendly_name, "Tv in the kitchen");
+    strcpy(device_identification->manufacturer_name, "Megacorp S.A.");
+    strcpy(device_identification->manufacturer_model, "LED TVx2001xx");
+
     ADD_TEST_VECTOR(034, "control URL type TLV");
     ADD_TEST_VECTOR(035, "IPv4 type TLV");
     ADD_TEST_VECTOR(036, "IPv6 type TLV");
-    ADD_TEST_VECTOR(037, "1905 profile version TLV");
+
+    INIT_TEST_VECTOR("1905 profile version TLV",
+        0x1a,
+        0x00, 0x01,
+        0x01,
+    );
+    struct x1905ProfileVersionTLV *profile_version =
+            X1905_TLV_ALLOC(x1905ProfileVersion, TLV_TYPE_1905_PROFILE_VERSION, &v->h.children[0]);
+    profile_version->profile = PROFILE_1905_1A;
+
+    INIT_TEST_VECTOR("push button join notification TLV",
+        0x13,
+        0x00, 0x14,
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+        0x12, 0x34,
+        0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+        0x21, 0x22, 0x23, 0x24, 0x25, 0x26,
+    );
+    struct pushButtonJoinNotificationTLV *push_button_join =
+            X1905_TLV_ALLOC(pushButtonJoinNotification, TLV_TYPE_PUSH_BUTTON_JOIN_NOTIFICATION, &v->h.children[0]);
+    memcpy(push_button_join->al_mac_address, (mac_address){0x01, 0x02, 0x03, 0x04, 0x05, 0x06}, 6);
+    push_button_join->message_identifier = 0x1234;
+    memcpy(push_button_join->mac_address, (mac_address){0x11, 0x12, 0x13, 0x14, 0x15, 0x16}, 6);
+    memcpy(push_button_join->new_mac_address, (mac_address){0x21, 0x22, 0x23, 0x24, 0x25, 0x26}, 6);
+
     ADD_TEST_VECTOR(038, "interface power change information TLV");
     ADD_TEST_VECTOR(039, "interface power change status TLV");
     ADD_TEST_VECTOR(040, "L2 neighbor device TLV");
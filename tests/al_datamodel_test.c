@@ -0,0 +1,341 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+//
+// This file tests the network devices database ("al_datamodel.h")
+//
+
+#include "platform.h"
+#include "utils.h"
+
+#include "al_datamodel.h"
+#include "1905_cmdus.h"
+#include "1905_tlvs.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+static int check(const char *test_description, uint8_t real, uint8_t expected)
+{
+    if (real != expected)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Expected %d, got %d\n", expected, real);
+        return 1;
+    }
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    return 0;
+}
+
+// Fake clock (see "tests/CMakeLists.txt"). It starts close to the wrap
+// around, to check that deadlines are compared correctly.
+//
+static uint32_t now = 0xfffff000;
+
+uint32_t __wrap_PLATFORM_GET_TIMESTAMP(void)
+{
+    return now;
+}
+
+static uint8_t local_al_mac[6]    = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+static uint8_t neighbor_al_mac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02};
+
+// Forge the streams of a topology response sent by 'neighbor_al_mac', with one
+// interface that has 'neighbor' as its only 1905 neighbor.
+//
+static uint8_t **_forgeTopologyResponse(uint8_t neighbor)
+{
+    struct CMDU                      c;
+    struct tlv                      *tlvs[3];
+    struct deviceInformationTypeTLV *info;
+    struct neighborDeviceListTLV    *neighbors;
+    mac_address                      neighbor_mac;
+    uint8_t                        **streams;
+    uint16_t                        *lens;
+
+    info = X1905_TLV_ALLOC(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, NULL);
+    memcpy(info->al_mac_address, neighbor_al_mac, 6);
+    deviceInformationTypeTLVAddInterface(info, neighbor_al_mac, MEDIA_TYPE_IEEE_802_3AB_GIGABIT_ETHERNET);
+
+    memcpy(neighbor_mac, local_al_mac, 6);
+    neighbor_mac[5] = neighbor;
+
+    neighbors = X1905_TLV_ALLOC(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, NULL);
+    memcpy(neighbors->local_mac_address, neighbor_al_mac, 6);
+    neighborDeviceListTLVAddNeighbor(neighbors, neighbor_mac, 0);
+
+    tlvs[0] = &info->tlv;
+    tlvs[1] = &neighbors->tlv;
+    tlvs[2] = NULL;
+
+    c.message_version = CMDU_MESSAGE_VERSION_1905_1_2013;
+    c.message_type    = CMDU_TYPE_TOPOLOGY_RESPONSE;
+    c.message_id      = 0x1234;
+    c.relay_indicator = 0;
+    c.list_of_TLVs    = tlvs;
+
+    streams = forge_1905_CMDU_from_structure(&c, &lens);
+    memfree(lens);
+    free_1905_TLV_structure(&info->tlv);
+    free_1905_TLV_structure(&neighbors->tlv);
+
+    return streams;
+}
+
+// Process a received topology response the way the AL entity does: first
+// check whether anything changed and, if so, decode it and update the data
+// model.
+//
+// Returns the value of "DMnetworkDeviceInfoUnchanged()".
+//
+static uint8_t _receiveTopologyResponse(uint8_t **streams)
+{
+    struct CMDU_view                  view;
+    struct CMDU                      *c;
+    struct deviceInformationTypeTLV  *info = NULL;
+    struct neighborDeviceListTLV    **z;
+    uint8_t                           z_nr = 0;
+    uint8_t                           unchanged;
+    unsigned                          i;
+
+    if (!parse_1905_CMDU_view_from_packets(streams, NULL, &view))
+    {
+        return 0xff;
+    }
+
+    unchanged = DMnetworkDeviceInfoUnchanged(&view);
+    if (0 == unchanged)
+    {
+        c = parse_1905_CMDU_from_view(&view);
+        z = (struct neighborDeviceListTLV **)memalloc(sizeof(struct neighborDeviceListTLV *));
+        for (i = 0; NULL != c->list_of_TLVs[i]; i++)
+        {
+            if (TLV_TYPE_DEVICE_INFORMATION_TYPE == c->list_of_TLVs[i]->type)
+            {
+                info = (struct deviceInformationTypeTLV *)c->list_of_TLVs[i];
+            }
+            else
+            {
+                z[z_nr++] = (struct neighborDeviceListTLV *)c->list_of_TLVs[i];
+            }
+        }
+        memfree(c->list_of_TLVs);
+        c->list_of_TLVs = NULL;
+        free_1905_CMDU_structure(c);
+
+        DMupdateNetworkDeviceInfo(info->al_mac_address,
+                                  1, info,
+                                  1, NULL, 0,
+                                  1, NULL, 0,
+                                  1, z,    z_nr,
+                                  1, NULL, 0,
+                                  1, NULL, 0,
+                                  1, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL);
+    }
+    DMnetworkDeviceInfoDone();
+
+    free_1905_CMDU_view(&view);
+
+    return unchanged;
+}
+
+// Add 'devices_nr' devices (with AL MAC addresses 02:00:00:01:xx:xx) to the
+// data model, each one with just an "info" TLV.
+//
+static void _addDevices(unsigned devices_nr)
+{
+    struct deviceInformationTypeTLV *info;
+    unsigned                         i;
+
+    for (i = 0; i < devices_nr; i++)
+    {
+        info = X1905_TLV_ALLOC(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, NULL);
+        info->al_mac_address[0] = 0x02;
+        info->al_mac_address[3] = 0x01;
+        info->al_mac_address[4] = (uint8_t)(i >> 8);
+        info->al_mac_address[5] = (uint8_t)i;
+
+        DMupdateNetworkDeviceInfo(info->al_mac_address,
+                                  1, info,
+                                  0, NULL, 0,
+                                  0, NULL, 0,
+                                  0, NULL, 0,
+                                  0, NULL, 0,
+                                  0, NULL, 0,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL,
+                                  0, NULL);
+    }
+}
+
+int main(void)
+{
+    int       result = 0;
+    uint8_t **first;
+    uint8_t **second;
+    uint8_t   mac[6] = {0x02, 0x00, 0x00, 0x01, 0x00, 0x00};
+    uint8_t  *extensions_nr;
+    unsigned  removed;
+    uint8_t   n;
+    struct CMDU_view view;
+
+    DMinit();
+    DMalMacSet(local_al_mac);
+
+    first  = _forgeTopologyResponse(1);
+    second = _forgeTopologyResponse(2);
+
+    result += check("DATAMODEL001 - Unknown device",                _receiveTopologyResponse(first), 0);
+    result += check("DATAMODEL001 - Device changed",                DMnetworkDeviceChanged(neighbor_al_mac), 1);
+    result += check("DATAMODEL002 - Same topology response",        _receiveTopologyResponse(first), 1);
+    result += check("DATAMODEL002 - Device not changed",            DMnetworkDeviceChanged(neighbor_al_mac), 0);
+    result += check("DATAMODEL002 - Device refreshed",              DMnetworkDeviceInfoNeedsUpdate(neighbor_al_mac), 0);
+    result += check("DATAMODEL003 - Different neighbors",           _receiveTopologyResponse(second), 0);
+    result += check("DATAMODEL003 - Device changed",                DMnetworkDeviceChanged(neighbor_al_mac), 1);
+    result += check("DATAMODEL003 - Same topology response",        _receiveTopologyResponse(second), 1);
+
+    // Updates that don't come from a checked CMDU are always a change, and
+    // the next CMDU must be decoded again
+    //
+    DMupdateNetworkDeviceInfo(neighbor_al_mac,
+                              0, NULL,
+                              0, NULL, 0,
+                              0, NULL, 0,
+                              1, NULL, 0,
+                              0, NULL, 0,
+                              0, NULL, 0,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL);
+    result += check("DATAMODEL004 - Direct update",                 DMnetworkDeviceChanged(neighbor_al_mac), 1);
+    result += check("DATAMODEL004 - Topology response decoded",     _receiveTopologyResponse(second), 0);
+    result += check("DATAMODEL004 - Same topology response",        _receiveTopologyResponse(second), 1);
+
+    // More devices than fit in an 8-bit counter
+    //
+    _addDevices(600);
+    result += check("DATAMODEL005 - First device known",            DMnetworkDeviceInfoNeedsUpdate(mac), 0);
+    mac[4] = 0x01; mac[5] = 0x2c;
+    result += check("DATAMODEL005 - Device 300 known",              DMnetworkDeviceInfoNeedsUpdate(mac), 0);
+    result += check("DATAMODEL005 - Device 300 extensions",         NULL != DMextensionsGet(mac, &extensions_nr), 1);
+    mac[4] = 0x02; mac[5] = 0x57;
+    result += check("DATAMODEL005 - Device 599 known",              DMnetworkDeviceInfoNeedsUpdate(mac), 0);
+    mac[4] = 0x02; mac[5] = 0x58;
+    result += check("DATAMODEL005 - Device 600 unknown",            DMnetworkDeviceInfoNeedsUpdate(mac), 1);
+    result += check("DATAMODEL005 - Earlier devices still known",   DMnetworkDeviceInfoNeedsUpdate(neighbor_al_mac), 0);
+
+    // Only expired devices are removed, a few of them at a time
+    //
+    result += check("DATAMODEL006 - Nothing expired",               DMrunGarbageCollector(), 0);
+    now += GC_MAX_AGE * 1000 / 2;
+    result += check("DATAMODEL006 - Neighbor refreshed",            _receiveTopologyResponse(second), 1);
+    now += GC_MAX_AGE * 1000 / 2 + 1;
+    result += check("DATAMODEL006 - Removal is capped",             removed = DMrunGarbageCollector(), GC_MAX_WORK);
+    result += check("DATAMODEL006 - More expired devices pending",  DMgarbageCollectorPending(), 1);
+    while (0 != (n = DMrunGarbageCollector()))
+    {
+        removed += n;
+    }
+    result += check("DATAMODEL006 - All expired devices removed",   600 == removed, 1);
+    result += check("DATAMODEL006 - Nothing else pending",          DMgarbageCollectorPending(), 0);
+    mac[4] = 0x00; mac[5] = 0x00;
+    result += check("DATAMODEL006 - Expired devices removed",       DMnetworkDeviceInfoNeedsUpdate(mac), 1);
+    result += check("DATAMODEL006 - Refreshed device kept",         DMnetworkDeviceInfoNeedsUpdate(neighbor_al_mac), 0);
+
+    // A changed CMDU that is then not stored (e.g. because it cannot be
+    // decoded) must not leave its hashes behind for the next update
+    //
+    parse_1905_CMDU_view_from_packets(first, NULL, &view);
+    result += check("DATAMODEL007 - Changed topology response",     DMnetworkDeviceInfoUnchanged(&view), 0);
+    free_1905_CMDU_view(&view);
+    DMnetworkDeviceInfoDone();
+    DMupdateNetworkDeviceInfo(neighbor_al_mac,
+                              0, NULL,
+                              0, NULL, 0,
+                              0, NULL, 0,
+                              1, NULL, 0,
+                              0, NULL, 0,
+                              0, NULL, 0,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL,
+                              0, NULL);
+    result += check("DATAMODEL007 - Topology response decoded",     _receiveTopologyResponse(first), 0);
+    result += check("DATAMODEL007 - Same topology response",        _receiveTopologyResponse(first), 1);
+
+    free_1905_CMDU_packets(first);
+    free_1905_CMDU_packets(second);
+
+    return result;
+}
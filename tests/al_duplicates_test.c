@@ -0,0 +1,140 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+//
+// This file tests the duplicated CMDUs detection ("al_duplicates.h")
+//
+
+#include "platform.h"
+#include "utils.h"
+
+#include "al_duplicates.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+static int check(const char *test_description, uint8_t real, uint8_t expected)
+{
+    if (real != expected)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Expected %d, got %d\n", expected, real);
+        return 1;
+    }
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    return 0;
+}
+
+int main(void)
+{
+    int                     result = 0;
+    struct duplicatesStats  stats;
+    uint8_t                 mac[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x00};
+    uint8_t                 dups;
+    unsigned                i;
+
+    result += check("DUPLICATES001 - New message",         duplicatesCheck(mac, 10), 0);
+    result += check("DUPLICATES001 - Duplicated message",  duplicatesCheck(mac, 10), 1);
+    result += check("DUPLICATES002 - Newer message",       duplicatesCheck(mac, 12), 0);
+    result += check("DUPLICATES002 - Out of order message", duplicatesCheck(mac, 11), 0);
+    result += check("DUPLICATES002 - Duplicated message",  duplicatesCheck(mac, 11), 1);
+    result += check("DUPLICATES002 - Suppressed counter",  duplicatesGetSuppressed(mac), 2);
+
+    // Message ids wrap around
+    //
+    result += check("DUPLICATES003 - Wrap around",         duplicatesCheck(mac, 0xfffe), 0);
+    result += check("DUPLICATES003 - Wrap around",         duplicatesCheck(mac, 0x0001), 0);
+    result += check("DUPLICATES003 - Wrap around",         duplicatesCheck(mac, 0xfffe), 1);
+    result += check("DUPLICATES003 - Wrap around",         duplicatesCheck(mac, 0xffff), 0);
+
+    // Once the window has moved past a message id, it is accepted again
+    //
+    result += check("DUPLICATES004 - Window slides",       duplicatesCheck(mac, 0x0001 + DUPLICATES_WINDOW), 0);
+    result += check("DUPLICATES004 - Window slides",       duplicatesCheck(mac, 0x0001), 0);
+    result += check("DUPLICATES004 - Window slides",       duplicatesCheck(mac, 0x0001), 1);
+
+    // Many sources talking at the same time: all duplicates are detected
+    //
+    dups = 0;
+    for (i = 0; i < 200; i++)
+    {
+        mac[5] = i + 1;
+        dups  += duplicatesCheck(mac, 100);
+    }
+    for (i = 0; i < 200; i++)
+    {
+        mac[5] = i + 1;
+        dups  += duplicatesCheck(mac, 100);
+    }
+    result += check("DUPLICATES005 - 200 sources", dups, 200);
+
+    // Cap the number of sources: the least recently heard ones are forgotten
+    //
+    duplicatesSetLimits(16);
+    mac[5] = 200;
+    result += check("DUPLICATES006 - Recent source kept",  duplicatesCheck(mac, 100), 1);
+    mac[5] = 1;
+    result += check("DUPLICATES006 - Old source forgotten", duplicatesCheck(mac, 100), 0);
+
+    duplicatesGetStats(&stats);
+    result += check("DUPLICATES007 - Counters",
+                    stats.suppressed == 4 + 200 + 1 && stats.sources == 16 && stats.evictions == 201 + 1 - 16, 1);
+
+    duplicatesFlush();
+
+    return result;
+}
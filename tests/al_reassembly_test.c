@@ -0,0 +1,281 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+//
+// This file tests the CMDU fragments reassembly engine ("al_reassembly.h")
+//
+
+#include "platform.h"
+#include "utils.h"
+
+#include "al_reassembly.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+static const uint8_t src1[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55};
+static const uint8_t src2[6] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x66};
+static const uint8_t dst[6]  = {0x01, 0x80, 0xc2, 0x00, 0x00, 0x13};
+
+// Build an ETH frame containing fragment 'fragment_id' of a CMDU. The payload
+// is 'payload_len' bytes, all of them set to 'fragment_id'.
+//
+static uint16_t build_fragment(uint8_t *frame, const uint8_t *src, uint16_t mid, uint8_t fragment_id,
+                               uint8_t last, uint16_t payload_len)
+{
+    memcpy(frame,     dst, 6);
+    memcpy(frame + 6, src, 6);
+    frame[12] = 0x89;              // ETHERTYPE_1905
+    frame[13] = 0x3a;
+    frame[14] = 0x00;              // message_version
+    frame[15] = 0x00;              // reserved
+    frame[16] = 0x00;              // message_type
+    frame[17] = 0x02;
+    frame[18] = mid >> 8;
+    frame[19] = mid & 0xff;
+    frame[20] = fragment_id;
+    frame[21] = last ? 0x80 : 0x00;
+    memset(frame + 22, fragment_id, payload_len);
+
+    return 22 + payload_len;
+}
+
+static struct reassembledCMDU *add(const uint8_t *src, uint16_t mid, uint8_t fragment_id, uint8_t last,
+                                   uint16_t payload_len, uint32_t now)
+{
+    uint8_t  frame[1500];
+    uint16_t len;
+
+    len = build_fragment(frame, src, mid, fragment_id, last, payload_len);
+
+    return reassemblyAddFragment(frame, len, now);
+}
+
+// Check that 'r' contains 'nr' fragments, in order, each one with 'payload_len'
+// bytes of payload
+//
+static int check_cmdu(const char *test_description, struct reassembledCMDU *r, unsigned nr, uint16_t payload_len)
+{
+    unsigned i, j;
+    int      ok = 1;
+
+    if (NULL == r)
+    {
+        ok = 0;
+    }
+    for (i = 0; ok && i < nr; i++)
+    {
+        if (NULL == r->streams[i] || r->streams_lens[i] != 8 + payload_len || r->streams[i][6] != i)
+        {
+            ok = 0;
+        }
+        for (j = 0; ok && j < payload_len; j++)
+        {
+            if (r->streams[i][8 + j] != i)
+            {
+                ok = 0;
+            }
+        }
+    }
+    if (ok && (NULL != r->streams[nr] || 0 != r->streams_lens[nr]))
+    {
+        ok = 0;
+    }
+
+    reassemblyFree(r);
+
+    PLATFORM_PRINTF("%-100s: %s\n", test_description, ok ? "OK" : "KO !!!");
+    return ok ? 0 : 1;
+}
+
+static int check_null(const char *test_description, struct reassembledCMDU *r)
+{
+    if (NULL != r)
+    {
+        reassemblyFree(r);
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        return 1;
+    }
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    return 0;
+}
+
+static int check_stats(const char *test_description, const struct reassemblyStats *expected)
+{
+    struct reassemblyStats real;
+
+    reassemblyGetStats(&real);
+
+    if (real.completions != expected->completions || real.timeouts  != expected->timeouts   ||
+        real.evictions   != expected->evictions   || real.duplicates != expected->duplicates ||
+        real.errors      != expected->errors      || real.in_flight  != expected->in_flight)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  completions=%u timeouts=%u evictions=%u duplicates=%u errors=%u in_flight=%u\n",
+                        real.completions, real.timeouts, real.evictions, real.duplicates, real.errors, real.in_flight);
+        return 1;
+    }
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    return 0;
+}
+
+static int check_bytes(const char *test_description, size_t max_bytes)
+{
+    struct reassemblyStats real;
+
+    reassemblyGetStats(&real);
+
+    if (real.bytes > max_bytes)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  bytes=%zu max_bytes=%zu\n", real.bytes, max_bytes);
+        return 1;
+    }
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    return 0;
+}
+
+int main(void)
+{
+    int                     result = 0;
+    struct reassemblyStats  expected;
+    unsigned                i;
+
+    memset(&expected, 0, sizeof(expected));
+
+    result += check_cmdu("REASSEMBLY001 - Non fragmented CMDU",
+                         add(src1, 1, 0, 1, 100, 0), 1, 100);
+    expected.completions++;
+
+    result += check_null("REASSEMBLY002 - Out of order fragments (#2)", add(src1, 2, 2, 1, 1000, 0));
+    result += check_null("REASSEMBLY002 - Out of order fragments (#0)", add(src1, 2, 0, 0, 1000, 0));
+    result += check_cmdu("REASSEMBLY002 - Out of order fragments (#1)",
+                         add(src1, 2, 1, 0, 1000, 0), 3, 1000);
+    expected.completions++;
+
+    for (i = 0; i < 9; i++)
+    {
+        result += check_null("REASSEMBLY003 - Ten fragments", add(src1, 3, i, 0, 1400, 0));
+    }
+    result += check_cmdu("REASSEMBLY003 - Ten fragments (last)", add(src1, 3, 9, 1, 1400, 0), 10, 1400);
+    expected.completions++;
+
+    // Same MID, different source: two different CMDUs
+    //
+    result += check_null("REASSEMBLY004 - Interleaved sources", add(src1, 4, 0, 0, 500, 0));
+    result += check_null("REASSEMBLY004 - Interleaved sources", add(src2, 4, 0, 0, 600, 0));
+    result += check_null("REASSEMBLY004 - Duplicated fragment", add(src1, 4, 0, 0, 500, 0));
+    expected.duplicates++;
+    result += check_cmdu("REASSEMBLY004 - Interleaved sources (src2)", add(src2, 4, 1, 1, 600, 0), 2, 600);
+    result += check_cmdu("REASSEMBLY004 - Interleaved sources (src1)", add(src1, 4, 1, 1, 500, 0), 2, 500);
+    expected.completions += 2;
+
+    result += check_null("REASSEMBLY005 - Fragment after the last one", add(src1, 5, 1, 1, 100, 0));
+    result += check_null("REASSEMBLY005 - Fragment after the last one", add(src1, 5, 2, 0, 100, 0));
+    expected.errors++;
+
+    result += check_stats("REASSEMBLY006 - Counters", &expected);
+
+    // Timeout
+    //
+    result += check_null("REASSEMBLY007 - Timeout", add(src1, 7, 0, 0, 100, 1000));
+    result += check_null("REASSEMBLY007 - Timeout", add(src1, 7, 1, 1, 100, 1000 + REASSEMBLY_DEFAULT_TIMEOUT_MS));
+    expected.timeouts++;
+    expected.in_flight = 1;
+    result += check_stats("REASSEMBLY007 - Counters", &expected);
+    reassemblyExpire(1000 + 2 * REASSEMBLY_DEFAULT_TIMEOUT_MS);
+    expected.timeouts++;
+    expected.in_flight = 0;
+
+    // Eviction: only room for about three fragments
+    //
+    reassemblySetLimits(REASSEMBLY_DEFAULT_TIMEOUT_MS, 4096);
+    result += check_null("REASSEMBLY008 - Eviction", add(src1, 8, 0, 0, 1400, 0));
+    result += check_null("REASSEMBLY008 - Eviction", add(src1, 9, 0, 0, 1400, 0));
+    result += check_null("REASSEMBLY008 - Eviction", add(src1, 10, 0, 0, 1400, 0));
+    expected.evictions++;
+
+    // Completing CMDU #10 requires its buffer to grow, which evicts #9
+    //
+    result += check_cmdu("REASSEMBLY008 - Eviction", add(src1, 10, 1, 1, 1400, 0), 2, 1400);
+    expected.evictions++;
+    expected.completions++;
+
+    // CMDU #8 was evicted, so its last fragment starts a new one
+    //
+    result += check_null("REASSEMBLY008 - Evicted CMDU", add(src1, 8, 1, 1, 1400, 0));
+    expected.in_flight = 1;
+    result += check_stats("REASSEMBLY008 - Counters", &expected);
+
+    reassemblyFlush();
+    expected.in_flight = 0;
+
+    // A small fragment still doubles the buffer of CMDU #11, and that growth
+    // (not just the fragment) must fit
+    //
+    result += check_null("REASSEMBLY009 - Buffer growth", add(src1, 11, 0, 0, 1400, 0));
+    result += check_null("REASSEMBLY009 - Buffer growth", add(src1, 12, 0, 0, 1400, 0));
+    result += check_null("REASSEMBLY009 - Buffer growth", add(src1, 11, 1, 0, 10, 0));
+    expected.evictions++;
+    expected.in_flight = 1;
+    result += check_bytes("REASSEMBLY009 - Buffer growth within limits", 4096);
+    result += check_stats("REASSEMBLY009 - Counters", &expected);
+
+    reassemblyFlush();
+
+    return result;
+}
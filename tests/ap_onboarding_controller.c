@@ -78,18 +78,8 @@ static struct CMDU aletest_send_cmdu_autoconfig_search = {
     .list_of_TLVs    =
         (struct tlv *[]){
             NULL, // alMacAddressTypeTLV
-            (struct tlv *)(struct searchedRoleTLV[]){
-                {
-                    .tlv.type          = TLV_TYPE_SEARCHED_ROLE,
-                    .role              = IEEE80211_ROLE_REGISTRAR,
-                }
-            },
-            (struct tlv *)(struct autoconfigFreqBandTLV[]){
-                {
-                    .tlv.type          = TLV_TYPE_AUTOCONFIG_FREQ_BAND,
-                    .freq_band         = IEEE80211_FREQUENCY_BAND_2_4_GHZ,
-                }
-            },
+            NULL, // searchedRoleTLV
+            NULL, // autoconfigFreqBandTLV
             NULL, /* multiApAgentService */
             NULL, /* multiApControllerSearchedService */
             NULL,
@@ -103,18 +93,8 @@ static struct CMDU aletest_expect_cmdu_autoconfig_response = {
     .message_id      = 0x1010,
     .list_of_TLVs    =
         (struct tlv *[]){
-            (struct tlv *)(struct supportedRoleTLV[]){
-                {
-                    .tlv.type          = TLV_TYPE_SUPPORTED_ROLE,
-                    .role              = IEEE80211_ROLE_REGISTRAR,
-                }
-            },
-            (struct tlv *)(struct supportedFreqBandTLV[]){
-                {
-                    .tlv.type          = TLV_TYPE_SUPPORTED_FREQ_BAND,
-                    .freq_band         = IEEE80211_FREQUENCY_BAND_2_4_GHZ,
-                }
-            },
+            NULL, // supportedRoleTLV
+            NULL, // supportedFreqBandTLV
             NULL, /* multiApControllerService */
             NULL,
         },
@@ -165,9 +145,23 @@ void initExpected()
     struct alMacAddressTypeTLV *alMacAddressType =
             X1905_TLV_ALLOC(alMacAddressType, TLV_TYPE_AL_MAC_ADDRESS_TYPE, NULL);
     memcpy(alMacAddressType->al_mac_address, ADDR_AL_PEER0, 6);
+    struct searchedRoleTLV *searchedRole = X1905_TLV_ALLOC(searchedRole, TLV_TYPE_SEARCHED_ROLE, NULL);
+    searchedRole->role = IEEE80211_ROLE_REGISTRAR;
+    struct autoconfigFreqBandTLV *autoconfigFreqBand =
+            X1905_TLV_ALLOC(autoconfigFreqBand, TLV_TYPE_AUTOCONFIG_FREQ_BAND, NULL);
+    autoconfigFreqBand->freq_band = IEEE80211_FREQUENCY_BAND_2_4_GHZ;
+    struct supportedRoleTLV *supportedRole = X1905_TLV_ALLOC(supportedRole, TLV_TYPE_SUPPORTED_ROLE, NULL);
+    supportedRole->role = IEEE80211_ROLE_REGISTRAR;
+    struct supportedFreqBandTLV *supportedFreqBand =
+            X1905_TLV_ALLOC(supportedFreqBand, TLV_TYPE_SUPPORTED_FREQ_BAND, NULL);
+    supportedFreqBand->freq_band = IEEE80211_FREQUENCY_BAND_2_4_GHZ;
 
+    aletest_expect_cmdu_autoconfig_response.list_of_TLVs[0] = &supportedRole->tlv;
+    aletest_expect_cmdu_autoconfig_response.list_of_TLVs[1] = &supportedFreqBand->tlv;
     aletest_expect_cmdu_autoconfig_response.list_of_TLVs[2] = &multiApControllerService->tlv;
     aletest_send_cmdu_autoconfig_search.list_of_TLVs[0] = &alMacAddressType->tlv;
+    aletest_send_cmdu_autoconfig_search.list_of_TLVs[1] = &searchedRole->tlv;
+    aletest_send_cmdu_autoconfig_search.list_of_TLVs[2] = &autoconfigFreqBand->tlv;
     aletest_send_cmdu_autoconfig_search.list_of_TLVs[3] = &multiApAgentService->tlv;
     aletest_send_cmdu_autoconfig_search.list_of_TLVs[4] = &multiApControllerSearchedService->tlv;
 
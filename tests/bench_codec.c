@@ -0,0 +1,503 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+
+//
+// Throughput benchmark of the 1905 codec.
+//
+// Every TLV and CMDU test vector, plus a few synthetic large messages, is
+// parsed, forged, compared and freed in a loop. For each of these operations
+// the time per operation, the number of heap allocations per operation and
+// the throughput (in bytes of the forged stream) are written to STDOUT as
+// JSON, so that results of different builds can be compared by a script.
+//
+// Usage: bench_codec [iterations]
+//
+// Heap allocations are counted by wrapping malloc(), calloc() and realloc()
+// at link time (see "-Wl,--wrap" in CMakeLists.txt). Objects handed out by
+// pool_zalloc() from its slabs never reach malloc(), so they are added from
+// the pool statistics.
+//
+
+#include "platform.h"
+#include "pool.h"
+#include "utils.h"
+
+#include "1905_tlvs.h"
+#include "1905_cmdus.h"
+#include "1905_tlv_test_vectors.h"
+#include "1905_cmdu_test_vectors.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> // memcpy(), memset(), ...
+#include <time.h>   // clock_gettime()
+
+#define BENCH_DEFAULT_ITERATIONS  10000
+
+// Parsed structures are kept around (so that parsing and freeing can be timed
+// separately) in batches of this size.
+//
+#define BENCH_BATCH  64
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Allocation counting
+////////////////////////////////////////////////////////////////////////////////
+
+static unsigned long allocs;
+
+// Number of heap and pool allocations done so far
+//
+static unsigned long _allocs(void)
+{
+    struct poolStats stats;
+
+    pool_stats(0, &stats);
+    return allocs + stats.allocs;
+}
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocs++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    allocs++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocs++;
+    return __real_realloc(ptr, size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Measurements and reporting
+////////////////////////////////////////////////////////////////////////////////
+
+struct measurement
+{
+    uint64_t       ns;
+    unsigned long  allocs;
+    unsigned long  ops;
+};
+
+static uint64_t _now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void _start(uint64_t *t0, unsigned long *a0)
+{
+    *a0 = _allocs();
+    *t0 = _now();
+}
+
+static void _stop(struct measurement *m, uint64_t t0, unsigned long a0, unsigned long ops)
+{
+    m->ns     += _now() - t0;
+    m->allocs += _allocs() - a0;
+    m->ops    += ops;
+}
+
+static unsigned results_nr;
+
+static void _printJsonString(const char *s)
+{
+    putchar('"');
+    for (; *s != '\0'; s++)
+    {
+        if ('"' == *s || '\\' == *s)
+        {
+            putchar('\\');
+        }
+        putchar(*s);
+    }
+    putchar('"');
+}
+
+static void _report(const char *kind, const char *name, const char *op, size_t bytes, const struct measurement *m)
+{
+    double ns_per_op;
+    double allocs_per_op;
+    double mb_per_s;
+
+    if (0 == m->ops)
+    {
+        return;
+    }
+
+    ns_per_op     = (double)m->ns / m->ops;
+    allocs_per_op = (double)m->allocs / m->ops;
+    mb_per_s      = ns_per_op > 0 ? (bytes * 1000.0) / ns_per_op : 0;
+
+    printf("%s\n    {\"kind\": \"%s\", \"name\": ", results_nr++ ? "," : "", kind);
+    _printJsonString(name);
+    printf(", \"op\": \"%s\", \"bytes\": %zu, \"iterations\": %lu, "
+           "\"ns_per_op\": %.1f, \"allocs_per_op\": %.2f, \"mb_per_s\": %.2f}",
+           op, bytes, m->ops, ns_per_op, allocs_per_op, mb_per_s);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// TLVs
+////////////////////////////////////////////////////////////////////////////////
+
+static void _benchTLV(const char *name, const uint8_t *stream, size_t stream_len, struct tlv *expected,
+                      bool parse, bool forge, unsigned long iterations)
+{
+    struct measurement parse_m   = {0, 0, 0};
+    struct measurement compare_m = {0, 0, 0};
+    struct measurement free_m    = {0, 0, 0};
+    struct measurement forge_m   = {0, 0, 0};
+    struct tlv        *batch[BENCH_BATCH];
+    unsigned long      done;
+    unsigned long      a0;
+    uint64_t           t0;
+    unsigned           i;
+
+    for (done = 0; parse && done < iterations; done += BENCH_BATCH)
+    {
+        unsigned n = iterations - done < BENCH_BATCH ? iterations - done : BENCH_BATCH;
+
+        _start(&t0, &a0);
+        for (i = 0; i < n; i++)
+        {
+            batch[i] = parse_1905_TLV_from_packet(stream);
+        }
+        _stop(&parse_m, t0, a0, n);
+
+        _start(&t0, &a0);
+        for (i = 0; i < n; i++)
+        {
+            compare_1905_TLV_structures(batch[i], expected);
+        }
+        _stop(&compare_m, t0, a0, n);
+
+        _start(&t0, &a0);
+        for (i = 0; i < n; i++)
+        {
+            free_1905_TLV_structure(batch[i]);
+        }
+        _stop(&free_m, t0, a0, n);
+    }
+
+    if (forge)
+    {
+        uint8_t *buffer = memalloc(stream_len);
+
+        _start(&t0, &a0);
+        for (done = 0; done < iterations; done++)
+        {
+            forge_1905_TLV_into_buffer(expected, buffer, stream_len);
+        }
+        _stop(&forge_m, t0, a0, iterations);
+
+        memfree(buffer);
+    }
+
+    _report("tlv", name, "parse",   stream_len, &parse_m);
+    _report("tlv", name, "compare", stream_len, &compare_m);
+    _report("tlv", name, "free",    stream_len, &free_m);
+    _report("tlv", name, "forge",   stream_len, &forge_m);
+}
+
+static void _benchTLVVectors(unsigned long iterations)
+{
+    struct x1905_tlv_test_vector *t;
+    dlist_head                    test_vectors;
+
+    dlist_head_init(&test_vectors);
+    get_1905_tlv_test_vectors(&test_vectors);
+
+    hlist_for_each(t, test_vectors, struct x1905_tlv_test_vector, h)
+    {
+        _benchTLV(t->description, t->stream, t->stream_len, container_of(t->h.children[0].next, struct tlv, s.h.l),
+                  t->parse, t->forge, iterations);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// CMDUs
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t _streamsLength(uint8_t **streams, const uint16_t *lens)
+{
+    size_t total = 0;
+    unsigned i;
+
+    for (i = 0; NULL != streams[i]; i++)
+    {
+        total += lens[i];
+    }
+    return total;
+}
+
+static void _benchCMDU(const char *name, uint8_t **streams, size_t bytes, struct CMDU *expected,
+                       bool parse, bool forge, unsigned long iterations)
+{
+    struct measurement parse_m   = {0, 0, 0};
+    struct measurement compare_m = {0, 0, 0};
+    struct measurement free_m    = {0, 0, 0};
+    struct measurement forge_m   = {0, 0, 0};
+    struct CMDU       *batch[BENCH_BATCH];
+    unsigned long      done;
+    unsigned long      a0;
+    uint64_t           t0;
+    unsigned           i;
+
+    for (done = 0; parse && done < iterations; done += BENCH_BATCH)
+    {
+        unsigned n = iterations - done < BENCH_BATCH ? iterations - done : BENCH_BATCH;
+
+        _start(&t0, &a0);
+        for (i = 0; i < n; i++)
+        {
+            batch[i] = parse_1905_CMDU_from_packets(streams);
+        }
+        _stop(&parse_m, t0, a0, n);
+
+        _start(&t0, &a0);
+        for (i = 0; i < n; i++)
+        {
+            compare_1905_CMDU_structures(batch[i], expected);
+        }
+        _stop(&compare_m, t0, a0, n);
+
+        _start(&t0, &a0);
+        for (i = 0; i < n; i++)
+        {
+            free_1905_CMDU_structure(batch[i]);
+        }
+        _stop(&free_m, t0, a0, n);
+    }
+
+    for (done = 0; forge && done < iterations; done++)
+    {
+        uint8_t  **forged;
+        uint16_t  *lens;
+
+        _start(&t0, &a0);
+        forged = forge_1905_CMDU_from_structure(expected, &lens);
+        free_1905_CMDU_packets(forged);
+        memfree(lens);
+        _stop(&forge_m, t0, a0, 1);
+    }
+
+    _report("cmdu", name, "parse",   bytes, &parse_m);
+    _report("cmdu", name, "compare", bytes, &compare_m);
+    _report("cmdu", name, "free",    bytes, &free_m);
+    _report("cmdu", name, "forge",   bytes, &forge_m);
+}
+
+static void _benchCMDUVectors(unsigned long iterations)
+{
+    static const struct
+    {
+        const char   *name;
+        struct CMDU  *cmdu;
+        uint8_t     **streams;
+        uint16_t     *lens;
+        bool          parse;
+        bool          forge;
+    } vectors[] = {
+        {"link metric query CMDU (001)", &x1905_cmdu_structure_001, x1905_cmdu_streams_001, x1905_cmdu_streams_len_001,
+         true, true},
+        {"link metric query CMDU (002)", &x1905_cmdu_structure_002, x1905_cmdu_streams_002, x1905_cmdu_streams_len_002,
+         true, true},
+        {"link metric query CMDU (003)", &x1905_cmdu_structure_003, x1905_cmdu_streams_003, x1905_cmdu_streams_len_003,
+         false, true},
+        {"link metric query CMDU (004)", &x1905_cmdu_structure_004, x1905_cmdu_streams_004, x1905_cmdu_streams_len_004,
+         true, false},
+        {"topology query CMDU (005)",    &x1905_cmdu_structure_005, x1905_cmdu_streams_005, x1905_cmdu_streams_len_005,
+         true, true},
+    };
+    unsigned i;
+
+    init_1905_cmdu_test_vectors();
+
+    for (i = 0; i < ARRAY_SIZE(vectors); i++)
+    {
+        _benchCMDU(vectors[i].name, vectors[i].streams, _streamsLength(vectors[i].streams, vectors[i].lens),
+                   vectors[i].cmdu, vectors[i].parse, vectors[i].forge, iterations);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Synthetic messages
+////////////////////////////////////////////////////////////////////////////////
+
+// Build a topology response of a device with 'interfaces_nr' interfaces (every
+// other one a Wi-Fi interface) and 'neighbors_per_interface' 1905 neighbors
+// behind each of them.
+//
+static struct CMDU *_buildTopologyResponse(uint8_t interfaces_nr, uint8_t neighbors_per_interface)
+{
+    struct CMDU                     *c;
+    struct deviceInformationTypeTLV *info;
+    unsigned                         i, j;
+
+    c = zmemalloc(sizeof(struct CMDU));
+    c->message_version = CMDU_MESSAGE_VERSION_1905_1_2013;
+    c->message_type    = CMDU_TYPE_TOPOLOGY_RESPONSE;
+    c->message_id      = 0x4242;
+    c->relay_indicator = 0;
+    c->list_of_TLVs    = zmemalloc(sizeof(struct tlv *) * (interfaces_nr + 2));
+
+    info = X1905_TLV_ALLOC(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, NULL);
+    info->al_mac_address[0] = 0x02;
+    for (i = 0; i < interfaces_nr; i++)
+    {
+        struct _localInterfaceEntries *e;
+        mac_address                    mac = {0x02, 0x00, 0x00, 0x00, 0x00, i};
+
+        if (i % 2)
+        {
+            e = deviceInformationTypeTLVAddInterface(info, mac, MEDIA_TYPE_IEEE_802_11AC_5_GHZ);
+            memcpy(e->media_specific_data.ieee80211.network_membership, mac, 6);
+            e->media_specific_data.ieee80211.role = IEEE80211_SPECIFIC_INFO_ROLE_AP;
+        }
+        else
+        {
+            deviceInformationTypeTLVAddInterface(info, mac, MEDIA_TYPE_IEEE_802_3AB_GIGABIT_ETHERNET);
+        }
+    }
+    c->list_of_TLVs[0] = &info->tlv;
+
+    for (i = 0; i < interfaces_nr; i++)
+    {
+        struct neighborDeviceListTLV *n = X1905_TLV_ALLOC(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, NULL);
+
+        n->local_mac_address[0] = 0x02;
+        n->local_mac_address[5] = i;
+        for (j = 0; j < neighbors_per_interface; j++)
+        {
+            mac_address mac = {0x06, 0x00, 0x00, 0x00, i, j};
+
+            neighborDeviceListTLVAddNeighbor(n, mac, j % 2);
+        }
+        c->list_of_TLVs[i + 1] = &n->tlv;
+    }
+
+    return c;
+}
+
+static void _benchSyntheticCMDU(const char *name, struct CMDU *c, unsigned long iterations)
+{
+    uint8_t  **streams;
+    uint16_t  *lens;
+
+    streams = forge_1905_CMDU_from_structure(c, &lens);
+    if (NULL == streams)
+    {
+        fprintf(stderr, "Could not forge synthetic CMDU '%s'\n", name);
+        exit(1);
+    }
+
+    _benchCMDU(name, streams, _streamsLength(streams, lens), c, true, true, iterations);
+
+    free_1905_CMDU_packets(streams);
+    memfree(lens);
+    free_1905_CMDU_structure(c);
+}
+
+
+int main(int argc, char *argv[])
+{
+    unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+
+    if (argc > 2 || (2 == argc && 0 == (iterations = strtoul(argv[1], NULL, 0))))
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    // Errors would end up in the middle of the JSON output
+    //
+    PLATFORM_PRINTF_DEBUG_SET_VERBOSITY_LEVEL(PLATFORM_DEBUG_LEVEL_ERROR);
+
+    printf("{\n  \"benchmark\": \"bench_codec\",\n  \"iterations\": %lu,\n  \"results\": [", iterations);
+
+    _benchTLVVectors(iterations);
+    _benchCMDUVectors(iterations);
+
+    // Scaled down so that the synthetic messages don't dominate the run time
+    //
+    _benchSyntheticCMDU("topology response, 64 interfaces, 256 neighbors", _buildTopologyResponse(64, 4),
+                        iterations / 10 + 1);
+    _benchSyntheticCMDU("topology response, 8 interfaces, 16 neighbors", _buildTopologyResponse(8, 2),
+                        iterations);
+
+    printf("\n  ]\n}\n");
+
+    return 0;
+}
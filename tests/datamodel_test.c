@@ -0,0 +1,205 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+//
+// This file tests the lookup functions of the data model ("datamodel.h")
+//
+
+#include "platform.h"
+#include "utils.h"
+
+#include <datamodel.h>
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+static int check(const char *test_description, bool ok)
+{
+    if (!ok)
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        return 1;
+    }
+    PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    return 0;
+}
+
+#define DEVICES_NR     600
+#define INTERFACES_NR  4
+
+static void _deviceMac(mac_address mac, unsigned device)
+{
+    mac[0] = 0x02;
+    mac[1] = 0x00;
+    mac[2] = 0x00;
+    mac[3] = 0x00;
+    mac[4] = device >> 8;
+    mac[5] = device & 0xff;
+}
+
+static void _interfaceMac(mac_address mac, unsigned device, unsigned interface)
+{
+    _deviceMac(mac, device);
+    mac[0] = 0x06;
+    mac[3] = interface + 1;
+}
+
+int main(void)
+{
+    int               result = 0;
+    struct alDevice  *devices[DEVICES_NR];
+    struct interface *interfaces[DEVICES_NR][INTERFACES_NR];
+    struct interface *shared[2];
+    mac_address       mac;
+    bool              ok;
+    unsigned          i, j;
+
+    datamodelInit();
+
+    for (i = 0; i < DEVICES_NR; i++)
+    {
+        _deviceMac(mac, i);
+        devices[i] = alDeviceAlloc(mac);
+        for (j = 0; j < INTERFACES_NR; j++)
+        {
+            _interfaceMac(mac, i, j);
+            interfaces[i][j] = interfaceAlloc(mac, devices[i]);
+        }
+    }
+
+    ok = true;
+    for (i = 0; i < DEVICES_NR; i++)
+    {
+        _deviceMac(mac, i);
+        ok = ok && alDeviceFind(mac) == devices[i] && alDeviceFindFromAnyAddress(mac) == devices[i];
+    }
+    result += check("DATAMODEL001 - Find devices by AL MAC", ok);
+
+    ok = true;
+    for (i = 0; i < DEVICES_NR; i++)
+    {
+        for (j = 0; j < INTERFACES_NR; j++)
+        {
+            _interfaceMac(mac, i, j);
+            ok = ok && findDeviceInterface(mac) == interfaces[i][j];
+            ok = ok && alDeviceFindInterface(devices[i], mac) == interfaces[i][j];
+            ok = ok && alDeviceFindInterface(devices[(i + 1) % DEVICES_NR], mac) == NULL;
+            ok = ok && alDeviceFindFromAnyAddress(mac) == devices[i];
+        }
+    }
+    result += check("DATAMODEL002 - Find interfaces by address", ok);
+
+    // Interfaces without owner are not indexed
+    //
+    _interfaceMac(mac, DEVICES_NR, 0);
+    shared[0] = interfaceAlloc(mac, NULL);
+    interfaceAddNeighbor(interfaces[0][0], shared[0]);
+    result += check("DATAMODEL003 - Non-1905 interface not found", findDeviceInterface(mac) == NULL);
+    result += check("DATAMODEL003 - Unknown address",              alDeviceFindFromAnyAddress(mac) == NULL);
+
+    // The same interface address on two devices
+    //
+    _interfaceMac(mac, DEVICES_NR, 1);
+    shared[0] = interfaceAlloc(mac, devices[1]);
+    shared[1] = interfaceAlloc(mac, devices[2]);
+    result += check("DATAMODEL004 - Same address, first device",  alDeviceFindInterface(devices[1], mac) == shared[0]);
+    result += check("DATAMODEL004 - Same address, second device", alDeviceFindInterface(devices[2], mac) == shared[1]);
+    interfaceDelete(shared[0]);
+    result += check("DATAMODEL004 - Same address, deleted",       alDeviceFindInterface(devices[1], mac) == NULL);
+    result += check("DATAMODEL004 - Same address, remaining",     findDeviceInterface(mac) == shared[1]);
+
+    // Delete every other device, with its interfaces
+    //
+    for (i = 0; i < DEVICES_NR; i += 2)
+    {
+        alDeviceDelete(devices[i]);
+    }
+    ok = true;
+    for (i = 0; i < DEVICES_NR; i++)
+    {
+        _deviceMac(mac, i);
+        ok = ok && alDeviceFind(mac) == (i % 2 ? devices[i] : NULL);
+        for (j = 0; j < INTERFACES_NR; j++)
+        {
+            _interfaceMac(mac, i, j);
+            ok = ok && findDeviceInterface(mac) == (i % 2 ? interfaces[i][j] : NULL);
+        }
+    }
+    result += check("DATAMODEL005 - Deleted devices not found", ok);
+
+    // Re-create them: deleted slots are reused
+    //
+    for (i = 0; i < DEVICES_NR; i += 2)
+    {
+        _deviceMac(mac, i);
+        devices[i] = alDeviceAlloc(mac);
+    }
+    ok = true;
+    for (i = 0; i < DEVICES_NR; i++)
+    {
+        _deviceMac(mac, i);
+        ok = ok && alDeviceFind(mac) == devices[i];
+    }
+    result += check("DATAMODEL006 - Re-created devices found", ok);
+
+    for (i = 0; i < DEVICES_NR; i++)
+    {
+        alDeviceDelete(devices[i]);
+    }
+
+    return result;
+}
@@ -0,0 +1,317 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+//
+// This file tests the timers of the event loop
+// ("linux/platform_event_loop_priv.h") against a fake clock
+//
+
+#include "platform.h"
+#include "utils.h"
+
+#include "linux/platform_event_loop_priv.h"
+
+#include <stdbool.h>      // bool
+#include <string.h>       // memset(), strlen()
+#include <time.h>         // clock_gettime()
+#include <unistd.h>       // write()
+#include <sys/eventfd.h>  // eventfd()
+#include <sys/timerfd.h>  // struct itimerspec
+
+// Fake clock (see "tests/CMakeLists.txt"): "CLOCK_MONOTONIC" returns 'now_ms'
+// and the timerfd of the wheel is replaced by an eventfd, which is made
+// readable by "_advance()" when the time it was armed for is reached.
+//
+static uint64_t now_ms   = 1000000;
+static uint64_t armed_ms = 0;        // "0" if disarmed
+static int      timer_fd = -1;
+
+int __real_clock_gettime(clockid_t clock_id, struct timespec *ts);
+
+int __wrap_clock_gettime(clockid_t clock_id, struct timespec *ts)
+{
+    if (CLOCK_MONOTONIC != clock_id)
+    {
+        return __real_clock_gettime(clock_id, ts);
+    }
+    ts->tv_sec  = now_ms / 1000;
+    ts->tv_nsec = (now_ms % 1000) * 1000000;
+    return 0;
+}
+
+int __wrap_timerfd_create(int clock_id, int flags)
+{
+    (void) clock_id;
+    (void) flags;
+
+    timer_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return timer_fd;
+}
+
+int __wrap_timerfd_settime(int fd, int flags, const struct itimerspec *new_value, struct itimerspec *old_value)
+{
+    (void) fd;
+    (void) flags;
+    (void) old_value;
+
+    armed_ms = (uint64_t)new_value->it_value.tv_sec * 1000 + new_value->it_value.tv_nsec / 1000000;
+    return 0;
+}
+
+// Move the fake clock forward to 'until', letting the timerfd expire (and the
+// event loop process it) every time the time it is armed for is reached.
+//
+static void _advance(uint64_t until)
+{
+    uint64_t one = 1;
+
+    while (0 != armed_ms && armed_ms <= until)
+    {
+        if (armed_ms > now_ms)
+        {
+            now_ms = armed_ms;
+        }
+
+        // Absolute one-shot timerfds are disarmed when they expire
+        //
+        armed_ms = 0;
+        if (sizeof(one) != write(timer_fd, &one, sizeof(one)))
+        {
+            PLATFORM_PRINTF("write(eventfd) failed\n");
+            return;
+        }
+        eventLoopRun(0);
+    }
+    now_ms = until;
+}
+
+// Every expiration is logged, with the (fake) time it happened at
+//
+struct testTimer
+{
+    struct eventLoopTimer  timer;
+    char                   name;
+
+    unsigned               expirations;
+    unsigned               stop_after;   // Stop itself after this many, if not "0"
+    struct testTimer      *cancel[2];    // Stopped from the callback
+};
+
+static struct
+{
+    char     name;
+    uint64_t at;
+} expirations[32];
+static unsigned expirations_nr;
+
+static void _timerCallback(void *data)
+{
+    struct testTimer *t = data;
+    unsigned          i;
+
+    if (expirations_nr < ARRAY_SIZE(expirations))
+    {
+        expirations[expirations_nr].name = t->name;
+        expirations[expirations_nr].at   = now_ms;
+    }
+    expirations_nr++;
+
+    t->expirations++;
+    if (t->expirations == t->stop_after)
+    {
+        eventLoopTimerStop(&t->timer);
+    }
+    for (i = 0; i < ARRAY_SIZE(t->cancel); i++)
+    {
+        if (NULL != t->cancel[i])
+        {
+            eventLoopTimerStop(&t->cancel[i]->timer);
+        }
+    }
+}
+
+static void _timerInit(struct testTimer *t, char name)
+{
+    memset(t, 0, sizeof(*t));
+    t->name = name;
+    eventLoopTimerInit(&t->timer, _timerCallback, t);
+}
+
+// Check that the timers expired in the order given by 'names' ("name" of each
+// expiration), at the times given by 'offsets' (relative to 'start'), and that
+// no timer is left running.
+//
+static int check(const char *test_description, uint64_t start, const char *names, const uint64_t *offsets)
+{
+    unsigned i;
+    int      result = 0;
+
+    if (expirations_nr != strlen(names) || 0 != armed_ms)
+    {
+        result = 1;
+    }
+    for (i = 0; 0 == result && i < expirations_nr; i++)
+    {
+        if (expirations[i].name != names[i] || expirations[i].at != start + offsets[i])
+        {
+            result = 1;
+        }
+    }
+
+    if (0 == result)
+    {
+        PLATFORM_PRINTF("%-100s: OK\n", test_description);
+    }
+    else
+    {
+        PLATFORM_PRINTF("%-100s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Expected %s, got (timerfd armed for %llu):\n", names, (unsigned long long)armed_ms);
+        for (i = 0; i < expirations_nr && i < ARRAY_SIZE(expirations); i++)
+        {
+            PLATFORM_PRINTF("    %c at +%lld\n", expirations[i].name, (long long)(expirations[i].at - start));
+        }
+    }
+
+    expirations_nr = 0;
+
+    return result;
+}
+
+int main(void)
+{
+    int              result = 0;
+    struct testTimer a, b, c, d, e;
+    uint64_t         start;
+
+    #define EVLOOP001 "EVLOOP001 - Timers in all levels expire in order, on time"
+    _timerInit(&a, 'a');
+    _timerInit(&b, 'b');
+    _timerInit(&c, 'c');
+    _timerInit(&d, 'd');
+    _timerInit(&e, 'e');
+    start = now_ms;
+    eventLoopTimerStart(&d.timer, 3000000, 0); // Level 3
+    eventLoopTimerStart(&a.timer, 30,      0); // Level 0
+    eventLoopTimerStart(&c.timer, 50000,   0); // Level 2
+    eventLoopTimerStart(&b.timer, 700,     0); // Level 1
+    eventLoopTimerStart(&e.timer, 40,      0);
+    _advance(start + 4000000);
+    result += check(EVLOOP001, start, "aebcd", (uint64_t []){30, 40, 700, 50000, 3000000});
+
+    #define EVLOOP002 "EVLOOP002 - Timers expire on time across level 0, 1 and 2 wrap arounds"
+    // Start three ticks before levels 0, 1 and 2 wrap around at the same time
+    //
+    now_ms = ((now_ms / 10 + (1ULL << 18)) & ~((1ULL << 18) - 1)) * 10 - 30;
+    start  = now_ms;
+    eventLoopTimerStart(&a.timer, 20,    0);   // Before the wrap around
+    eventLoopTimerStart(&b.timer, 30,    0);   // Right at the wrap around
+    eventLoopTimerStart(&c.timer, 40,    0);   // Just after it
+    eventLoopTimerStart(&d.timer, 670,   0);   // At the next level 0 wrap around
+    eventLoopTimerStart(&e.timer, 40990, 0);   // At the next level 1 wrap around
+    _advance(start + 100000);
+    result += check(EVLOOP002, start, "abcde", (uint64_t []){20, 30, 40, 670, 40990});
+
+    #define EVLOOP003 "EVLOOP003 - Timers beyond the wheel range are re-linked until they expire"
+    start = now_ms;
+    eventLoopTimerStart(&a.timer, 50 * 3600 * 1000, 0);
+    eventLoopTimerStart(&b.timer, 10,               0);
+    _advance(start + 51 * 3600 * 1000);
+    result += check(EVLOOP003, start, "ba", (uint64_t []){10, 50 * 3600 * 1000});
+
+    #define EVLOOP004 "EVLOOP004 - Periodic timers are re-armed on their original schedule until stopped"
+    // 'a' stops itself from its fourth callback and 'b' is stopped from
+    // outside
+    //
+    _timerInit(&a, 'a');
+    _timerInit(&b, 'b');
+    a.stop_after = 4;
+    start = now_ms;
+    eventLoopTimerStart(&a.timer, 100, 250);
+    eventLoopTimerStart(&b.timer, 10,  330);
+    _advance(start + 900);
+    eventLoopTimerStop(&b.timer);
+    _advance(start + 3000);
+    result += check(EVLOOP004, start, "babaaba", (uint64_t []){10, 100, 340, 350, 600, 670, 850});
+
+    #define EVLOOP005 "EVLOOP005 - Timers stopped from a callback don't expire, even in the same tick"
+    // 'a', 'b' and 'd' expire in the same tick, 'c' later. 'a' runs first and
+    // stops 'b' (already taken out of the wheel) and 'c'.
+    //
+    _timerInit(&a, 'a');
+    _timerInit(&b, 'b');
+    _timerInit(&c, 'c');
+    _timerInit(&d, 'd');
+    a.cancel[0] = &b;
+    a.cancel[1] = &c;
+    start = now_ms;
+    eventLoopTimerStart(&a.timer, 200, 0);
+    eventLoopTimerStart(&b.timer, 200, 0);
+    eventLoopTimerStart(&d.timer, 200, 0);
+    eventLoopTimerStart(&c.timer, 300, 0);
+    _advance(start + 1000);
+    result += check(EVLOOP005, start, "ad", (uint64_t []){200, 200});
+
+    #define EVLOOP006 "EVLOOP006 - A periodic timer stopped from its own callback doesn't expire again"
+    _timerInit(&a, 'a');
+    a.cancel[0] = &a;
+    start = now_ms;
+    eventLoopTimerStart(&a.timer, 10, 10);
+    _advance(start + 1000);
+    result += check(EVLOOP006, start, "a", (uint64_t []){10});
+
+    return result;
+}
@@ -0,0 +1,190 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#include <pool.h>
+#include <utils.h> /* memfree() */
+#include "platform.h"
+#include <stdarg.h>
+#include <string.h>
+
+#define OBJECTS_NR 1000
+
+static void *objects[OBJECTS_NR];
+
+static int check_stats(const char *description, size_t size, size_t live, size_t peak)
+{
+    struct poolStats stats;
+
+    pool_stats(size, &stats);
+    if (stats.live != live || stats.peak != peak)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("%s: live %zu peak %zu but expected %zu %zu\n",
+                                      description, stats.live, stats.peak, live, peak);
+        return 1;
+    }
+    return 0;
+}
+
+int main()
+{
+    int ret = 0;
+    unsigned i;
+    struct poolStats stats;
+    struct arena *arena;
+    struct arena *previous;
+    void *large;
+    void *in_arena;
+    void *first;
+
+    ret += check_stats("Empty", 0, 0, 0);
+
+    for (i = 0; i < OBJECTS_NR; i++)
+    {
+        objects[i] = pool_zalloc(100);
+        memset(objects[i], 0xff, 100);
+    }
+    ret += check_stats("Allocated", 100, OBJECTS_NR, OBJECTS_NR);
+    ret += check_stats("Allocated (same class)", 112, OBJECTS_NR, OBJECTS_NR);
+    ret += check_stats("Allocated (other class)", 200, 0, 0);
+    if (!pool_owns(objects[0]) || !pool_owns(objects[OBJECTS_NR - 1]))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Pool objects not recognized\n");
+        ret++;
+    }
+
+    pool_stats(0, &stats);
+    if (stats.bytes < OBJECTS_NR * 112 || stats.bytes > 2 * OBJECTS_NR * 112)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Unexpected pool size %zu\n", stats.bytes);
+        ret++;
+    }
+
+    /* Both pool_free() and memfree() release pool objects, which are then reused. */
+    first = objects[0];
+    for (i = 0; i < OBJECTS_NR; i++)
+    {
+        if (i % 2)
+        {
+            pool_free(objects[i]);
+        }
+        else
+        {
+            memfree(objects[i]);
+        }
+    }
+    ret += check_stats("Freed", 0, 0, OBJECTS_NR);
+
+    for (i = 0; i < OBJECTS_NR; i++)
+    {
+        objects[i] = pool_zalloc(100);
+        if (*(unsigned char *)objects[i] != 0)
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("Reused object not zeroed\n");
+            ret++;
+            break;
+        }
+    }
+    ret += check_stats("Reallocated", 100, OBJECTS_NR, OBJECTS_NR);
+    pool_stats(0, &stats);
+    if (stats.bytes > 2 * OBJECTS_NR * 112)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Pool grew to %zu instead of reusing objects\n", stats.bytes);
+        ret++;
+    }
+    if (objects[OBJECTS_NR - 1] != first && objects[0] != first)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Freed objects not reused\n");
+        ret++;
+    }
+    for (i = 0; i < OBJECTS_NR; i++)
+    {
+        pool_free(objects[i]);
+    }
+
+    /* Large objects come from the heap. */
+    large = pool_zalloc(POOL_MAX_OBJECT + 1);
+    if (pool_owns(large))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Large object allocated from a pool\n");
+        ret++;
+    }
+    pool_free(large);
+
+    /* While an arena is entered, objects come from the arena. */
+    arena = arena_new();
+    previous = arena_enter(arena);
+    in_arena = pool_zalloc(100);
+    arena_leave(previous);
+    if (pool_owns(in_arena) || !arena_owns(in_arena))
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Object not allocated from the arena\n");
+        ret++;
+    }
+    pool_free(in_arena);
+    arena_unref(arena);
+    ret += check_stats("All freed", 0, 0, OBJECTS_NR);
+
+    /* Only the objects handed out from the slabs are counted, not the large nor the arena ones. */
+    pool_stats(0, &stats);
+    if (stats.allocs != 2 * OBJECTS_NR)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("%zu allocations counted but expected %u\n", stats.allocs, 2 * OBJECTS_NR);
+        ret++;
+    }
+
+    return ret;
+}
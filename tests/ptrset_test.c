@@ -0,0 +1,218 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+#include <ptrset.h>
+#include "platform.h"
+#include <stdarg.h>
+#include <string.h>
+
+#define ITEMS_NR 200
+
+static unsigned items[ITEMS_NR];
+static PTRSET(unsigned *) ptrset;
+
+static int check_count(unsigned expected_count)
+{
+    if (ptrset.length != expected_count)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("ptrset length %u but expected %u\n", ptrset.length, expected_count);
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/* Check that exactly the items for which 'expected' returns true are in the set, and that each one is found at its
+ * position. */
+static int check_members(bool (*expected)(unsigned item))
+{
+    unsigned i;
+    unsigned members = 0;
+    for (i = 0; i < ITEMS_NR; i++)
+    {
+        unsigned pos = PTRSET_FIND(ptrset, &items[i]);
+        if (expected(i))
+        {
+            members++;
+            if (pos >= ptrset.length || ptrset.data[pos] != &items[i])
+            {
+                PLATFORM_PRINTF_DEBUG_WARNING("ptrset doesn't include element %u\n", i);
+                return 1;
+            }
+        }
+        else if (pos != ptrset.length)
+        {
+            PLATFORM_PRINTF_DEBUG_WARNING("ptrset includes unexpected element %u\n", i);
+            return 1;
+        }
+    }
+    return check_count(members);
+}
+
+static bool first_three(unsigned item)
+{
+    return item < 3;
+}
+
+static bool second_and_third(unsigned item)
+{
+    return item == 1 || item == 2;
+}
+
+static bool all(unsigned item)
+{
+    (void) item;
+    return true;
+}
+
+static bool odd(unsigned item)
+{
+    return item % 2 == 1;
+}
+
+static bool none(unsigned item)
+{
+    (void) item;
+    return false;
+}
+
+int main()
+{
+    int ret = 0;
+    unsigned i;
+    unsigned round;
+
+    ret += check_count(0);
+
+    /* Small sets, without index. */
+    PTRSET_ADD(ptrset, &items[0]);
+    PTRSET_ADD(ptrset, &items[1]);
+    PTRSET_ADD(ptrset, &items[2]);
+    ret += check_members(first_three);
+
+    /* Elements are only added once. */
+    PTRSET_ADD(ptrset, &items[1]);
+    ret += check_members(first_three);
+
+    /* The last element takes the place of the removed one. */
+    PTRSET_REMOVE(ptrset, 0);
+    ret += check_members(second_and_third);
+    if (ptrset.data[0] != &items[2])
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Last element not moved to the removed position\n");
+        ret++;
+    }
+
+    /* Element not in set => nothing changed */
+    PTRSET_REMOVE_ELEMENT(ptrset, &items[0]);
+    ret += check_members(second_and_third);
+
+    PTRSET_CLEAR(ptrset);
+    ret += check_count(0);
+
+    /* Large sets, with index. */
+    for (i = 0; i < ITEMS_NR; i++)
+    {
+        PTRSET_ADD(ptrset, &items[i]);
+    }
+    ret += check_members(all);
+    if (ptrset.index.size == 0)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Large ptrset has no index\n");
+        ret++;
+    }
+
+    for (i = 0; i < ITEMS_NR; i += 2)
+    {
+        PTRSET_REMOVE_ELEMENT(ptrset, &items[i]);
+    }
+    ret += check_members(odd);
+
+    /* Churn: the index must not keep growing with removed elements. */
+    for (round = 0; round < 100; round++)
+    {
+        for (i = 0; i < ITEMS_NR; i += 2)
+        {
+            PTRSET_ADD(ptrset, &items[i]);
+        }
+        for (i = 0; i < ITEMS_NR; i += 2)
+        {
+            PTRSET_REMOVE_ELEMENT(ptrset, &items[i]);
+        }
+    }
+    ret += check_members(odd);
+    if (ptrset.index.size > 4 * ITEMS_NR)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("ptrset index grew to %u slots\n", ptrset.index.size);
+        ret++;
+    }
+
+    for (i = 1; i < ITEMS_NR; i += 2)
+    {
+        PTRSET_REMOVE_ELEMENT(ptrset, &items[i]);
+    }
+    ret += check_members(none);
+    if (ptrset.data != NULL || ptrset.index.size != 0)
+    {
+        PLATFORM_PRINTF_DEBUG_WARNING("Empty ptrset still has memory\n");
+        ret++;
+    }
+
+    return ret;
+}
@@ -0,0 +1,198 @@
+/*
+ *  prplMesh Wi-Fi Multi-AP
+ *
+ *  Copyright (c) 2018, prpl Foundation
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are
+ *  met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ *  Subject to the terms and conditions of this license, each copyright
+ *  holder and contributor hereby grants to those receiving rights under
+ *  this license a perpetual, worldwide, non-exclusive, no-charge,
+ *  royalty-free, irrevocable (except for failure to satisfy the
+ *  conditions of this license) patent license to make, have made, use,
+ *  offer to sell, sell, import, and otherwise transfer this software,
+ *  where such license applies only to those patent claims, already
+ *  acquired or hereafter acquired, licensable by such copyright holder or
+ *  contributor that are necessarily infringed by:
+ *
+ *  (a) their Contribution(s) (the licensed copyrights of copyright holders
+ *      and non-copyrightable additions of contributors, in source or binary
+ *      form) alone; or
+ *
+ *  (b) combination of their Contribution(s) with the work of authorship to
+ *      which such Contribution(s) was added by such copyright holder or
+ *      contributor, if, at the time the Contribution is added, such addition
+ *      causes such combination to be necessarily infringed. The patent
+ *      license shall not apply to any other combinations which include the
+ *      Contribution.
+ *
+ *  Except as expressly stated above, no rights or licenses from any
+ *  copyright holder or contributor is granted under this license, whether
+ *  expressly, by implication, estoppel or otherwise.
+ *
+ *  DISCLAIMER
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ *  OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR
+ *  TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ *  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+ *  DAMAGE.
+ */
+
+
+//
+// This file checks that the TLV functions generated by "tlv_codegen.cmake"
+// behave exactly like the generic ones in "tlv.c", by parsing, comparing and
+// forging the TLV test vectors with both.
+//
+
+#include "platform.h"
+#include "utils.h"
+
+#include "1905_tlvs.h"
+#include "1905_tlv_test_vectors.h"
+
+#include <string.h> // memcmp(), memcpy(), ...
+
+// Parse 'stream' with both the generated and the generic functions and check
+// that both give the same structure
+//
+static int _checkParse(const char *test_description, const uint8_t *stream)
+{
+    int          result = 1;
+    struct tlv  *generated;
+    struct tlv  *interpreted;
+    int          generated_cmp;
+    int          interpreted_cmp;
+
+    tlv_codegen_disabled = false;
+    generated   = parse_1905_TLV_from_packet(stream);
+    tlv_codegen_disabled = true;
+    interpreted = parse_1905_TLV_from_packet(stream);
+
+    if (NULL == generated || NULL == interpreted)
+    {
+        PLATFORM_PRINTF("Codegen parse %-92s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Parse failure (generated %s, interpreted %s)\n",
+                        NULL == generated ? "KO" : "OK", NULL == interpreted ? "KO" : "OK");
+        goto out;
+    }
+
+    tlv_codegen_disabled = false;
+    generated_cmp   = tlv_struct_compare(&generated->s, &interpreted->s);
+    tlv_codegen_disabled = true;
+    interpreted_cmp = tlv_struct_compare(&generated->s, &interpreted->s);
+
+    if (0 != generated_cmp || 0 != interpreted_cmp)
+    {
+        PLATFORM_PRINTF("Codegen parse %-92s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Parsed structures differ (%d, %d)\n", generated_cmp, interpreted_cmp);
+    }
+    else
+    {
+        PLATFORM_PRINTF("Codegen parse %-92s: OK\n", test_description);
+        result = 0;
+    }
+
+out:
+    tlv_codegen_disabled = false;
+    free_1905_TLV_structure(generated);
+    free_1905_TLV_structure(interpreted);
+
+    return result;
+}
+
+// Forge 'input' with both the generated and the generic functions and check
+// that both give 'stream'
+//
+static int _checkForge(const char *test_description, const struct tlv *input, const uint8_t *stream, uint16_t stream_len)
+{
+    uint8_t      generated_stream[MAX_NETWORK_SEGMENT_SIZE];
+    uint8_t      interpreted_stream[MAX_NETWORK_SEGMENT_SIZE];
+    size_t       generated_len;
+    size_t       interpreted_len;
+
+    tlv_codegen_disabled = false;
+    generated_len   = forge_1905_TLV_into_buffer(input, generated_stream, sizeof(generated_stream));
+    tlv_codegen_disabled = true;
+    interpreted_len = forge_1905_TLV_into_buffer(input, interpreted_stream, sizeof(interpreted_stream));
+    tlv_codegen_disabled = false;
+
+    if (generated_len != stream_len || interpreted_len != stream_len ||
+        0 != memcmp(generated_stream, stream, stream_len) || 0 != memcmp(interpreted_stream, stream, stream_len))
+    {
+        PLATFORM_PRINTF("Codegen forge %-92s: KO !!!\n", test_description);
+        PLATFORM_PRINTF("  Forged streams differ (%u, %u bytes, expected %u)\n",
+                        (unsigned)generated_len, (unsigned)interpreted_len, (unsigned)stream_len);
+        return 1;
+    }
+
+    PLATFORM_PRINTF("Codegen forge %-92s: OK\n", test_description);
+    return 0;
+}
+
+int main(void)
+{
+    int result = 0;
+    int generated_nr = 0;
+    struct x1905_tlv_test_vector *t;
+    dlist_head test_vectors;
+
+    dlist_head_init(&test_vectors);
+    get_1905_tlv_test_vectors(&test_vectors);
+
+    hlist_for_each(t, test_vectors, struct x1905_tlv_test_vector, h)
+    {
+        const struct tlv_def *def = x1905TLVFindDef(t->stream[0]);
+
+        // Only TLVs handled through "tlv.h" can have generated functions
+        //
+        if (NULL == def->desc.name)
+        {
+            continue;
+        }
+        if (t->parse)
+        {
+            result += _checkParse(t->description, t->stream);
+        }
+        if (t->forge)
+        {
+            result += _checkForge(t->description, container_of(t->h.children[0].next, struct tlv, s.h.l),
+                                  t->stream, t->stream_len);
+        }
+        if (0 != def->desc.codegen)
+        {
+            generated_nr++;
+        }
+    }
+    // @todo currently the test vectors still point to statically allocated TLVs
+    // hlist_delete(&test_vectors);
+
+#ifdef TLV_CODEGEN
+    // Make sure the generated functions are actually being used
+    //
+    if (0 == generated_nr)
+    {
+        PLATFORM_PRINTF("Codegen %-98s: KO !!!\n", "generated functions in use");
+        result++;
+    }
+#endif
+
+    return result;
+}
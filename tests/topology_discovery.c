@@ -152,39 +152,10 @@ static struct CMDU aletest_expect_cmdu_topology_response =
     .relay_indicator = 0,
     .list_of_TLVs    =
         (struct tlv *[]){
-            (struct tlv *)(struct deviceInformationTypeTLV[]){
-                {
-                    .tlv.type            = TLV_TYPE_DEVICE_INFORMATION_TYPE,
-                    .al_mac_address      = ADDR_AL,
-                    .local_interfaces_nr = 4,
-                    .local_interfaces    = aletest_local_interfaces,
-                }
-            },
-            (struct tlv *)(struct deviceBridgingCapabilityTLV[]){
-                {
-                    .tlv.type            = TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES,
-                    .bridging_tuples_nr  = 0,
-                },
-            },
-            (struct tlv *)(struct neighborDeviceListTLV[]){
-                {
-                    .tlv.type            = TLV_TYPE_NEIGHBOR_DEVICE_LIST,
-                    .local_mac_address   = ADDR_MAC0,
-                    .neighbors_nr        = 1,
-                    .neighbors           = (struct _neighborEntries[]) {
-                        {
-                            .mac_address = ADDR_AL_PEER0,
-                            .bridge_flag = 0,
-                        },
-                    },
-                }
-            },
-            (struct tlv *)(struct powerOffInterfaceTLV[]){
-                {
-                    .tlv.type                 = TLV_TYPE_POWER_OFF_INTERFACE,
-                    .power_off_interfaces_nr  = 0,
-                },
-            },
+            NULL, /* deviceInformationType */
+            NULL, /* deviceBridgingCapability */
+            NULL, /* neighborDeviceList */
+            NULL, /* powerOffInterface */
             (struct tlv *)(struct l2NeighborDeviceTLV[]){
                 {
                     .tlv.type            = TLV_TYPE_L2_NEIGHBOR_DEVICE,
@@ -231,20 +202,7 @@ static struct CMDU aletest_send_cmdu_topology_response2 = {
     .relay_indicator = 0,
     .list_of_TLVs    =
         (struct tlv *[]){
-            (struct tlv *)(struct deviceInformationTypeTLV[]){
-                {
-                    .tlv.type            = TLV_TYPE_DEVICE_INFORMATION_TYPE,
-                    .al_mac_address      = ADDR_AL_PEER1,
-                    .local_interfaces_nr = 1,
-                    .local_interfaces    = (struct _localInterfaceEntries[]){
-                        {
-                            .mac_address = ADDR_MAC_PEER1,
-                            .media_type  = MEDIA_TYPE_IEEE_802_3AB_GIGABIT_ETHERNET,
-                            .media_specific_data_size = 0,
-                        }
-                    },
-                }
-            },
+            NULL, /* deviceInformationType */
             /* No device bridging capability */
             /* No Non-1905 neighbors */
             /* No 1905 neighbors */
@@ -285,6 +243,29 @@ static void initExpected()
     memcpy(send_mac_tlv->mac_address, ADDR_MAC_PEER0, 6);
     aletest_send_cmdu_topology_discovery.list_of_TLVs[1] = &send_mac_tlv->tlv;
 
+    struct deviceInformationTypeTLV *expect_device_info =
+            X1905_TLV_ALLOC(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, NULL);
+    memcpy(expect_device_info->al_mac_address, ADDR_AL, 6);
+    size_t i;
+    for (i = 0; i < ARRAY_SIZE(aletest_local_interfaces); i++)
+    {
+        struct _localInterfaceEntries *local_interface = deviceInformationTypeTLVAddInterface(expect_device_info,
+                aletest_local_interfaces[i].mac_address, aletest_local_interfaces[i].media_type);
+        local_interface->media_specific_data = aletest_local_interfaces[i].media_specific_data;
+    }
+    aletest_expect_cmdu_topology_response.list_of_TLVs[0] = &expect_device_info->tlv;
+    struct deviceBridgingCapabilityTLV *expect_bridging =
+            X1905_TLV_ALLOC(deviceBridgingCapability, TLV_TYPE_DEVICE_BRIDGING_CAPABILITIES, NULL);
+    aletest_expect_cmdu_topology_response.list_of_TLVs[1] = &expect_bridging->tlv;
+    struct neighborDeviceListTLV *expect_neighbors =
+            X1905_TLV_ALLOC(neighborDeviceList, TLV_TYPE_NEIGHBOR_DEVICE_LIST, NULL);
+    memcpy(expect_neighbors->local_mac_address, ADDR_MAC0, 6);
+    neighborDeviceListTLVAddNeighbor(expect_neighbors, (uint8_t *)ADDR_AL_PEER0, 0);
+    aletest_expect_cmdu_topology_response.list_of_TLVs[2] = &expect_neighbors->tlv;
+    struct powerOffInterfaceTLV *expect_power_off =
+            X1905_TLV_ALLOC(powerOffInterface, TLV_TYPE_POWER_OFF_INTERFACE, NULL);
+    aletest_expect_cmdu_topology_response.list_of_TLVs[3] = &expect_power_off->tlv;
+
     struct supportedServiceTLV *multiApControllerService = supportedServiceTLVAlloc(NULL, true, true);
     aletest_expect_cmdu_topology_response.list_of_TLVs[5] = &multiApControllerService->tlv;
 
@@ -313,6 +294,13 @@ static void initExpected()
     memcpy(send_mac_tlv2->mac_address, ADDR_MAC_PEER1, 6);
     aletest_send_cmdu_topology_discovery2.list_of_TLVs[1] = &send_mac_tlv2->tlv;
 
+    struct deviceInformationTypeTLV *send_device_info2 =
+            X1905_TLV_ALLOC(deviceInformationType, TLV_TYPE_DEVICE_INFORMATION_TYPE, NULL);
+    memcpy(send_device_info2->al_mac_address, ADDR_AL_PEER1, 6);
+    deviceInformationTypeTLVAddInterface(send_device_info2, (uint8_t *)ADDR_MAC_PEER1,
+                                         MEDIA_TYPE_IEEE_802_3AB_GIGABIT_ETHERNET);
+    aletest_send_cmdu_topology_response2.list_of_TLVs[0] = &send_device_info2->tlv;
+
     struct supportedServiceTLV *multiApAgentService = supportedServiceTLVAlloc(NULL, false, true);
     aletest_send_cmdu_topology_response2.list_of_TLVs[1] = &multiApAgentService->tlv;
 